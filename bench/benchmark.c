@@ -0,0 +1,1203 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headers/modules.h"
+#include "../headers/errors.h"
+#include "../headers/parsetree.h"
+#include "../headers/lineindex.h"
+#include "../headers/stats.h"
+#include "../headers/json.h"
+#include "../headers/benchmark.h"
+#include "../headers/compiler.h"
+#include "../headers/vm.h"
+
+/**
+ * The subprogram {@code SPACE/bench/benchmark.c} was created
+ * to measure how the compiler phases scale with the input.
+ *
+ * Every workload is generated (see generators.c) and written into
+ * a temporary file. Each phase is then measured in isolation: the
+ * phases in front of it run untimed, only the measured phase is
+ * timed. This is repeated and the median is reported as throughput
+ * (MB/s, tokens/s, nodes/s) together with the allocated bytes.
+ *
+ * The results can be stored as baseline (--save-baseline) and later
+ * runs compared against it (--baseline), phases that got slower than
+ * the threshold are reported as regression.
+ *
+ * With --vm small programs are executed by the virtual machine instead,
+ * the startup latency (compilation into bytecode) and the executed
+ * instructions per second are reported (--jit compiles the hot
+ * functions, then only the interpreted instructions are counted).
+ * With --gc binary trees are allocated on the heap of the VM and the
+ * pauses of the garbage collector are reported.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//The workloads use classes and arrays, which the IR can't lower yet, so the IR isn't measured
+#define BM_PHASES (STATS_SEMANTIC + 1)
+
+//Globals of the compiler pipeline (defined in compiler.c)
+extern char *FILE_NAME;
+extern char **BUFFER;
+extern size_t BUFFER_LENGTH;
+extern size_t TOKEN_LENGTH;
+extern struct LineIndex *LINE_INDEX;
+
+struct BenchmarkOptions {
+	size_t repetitions;
+	size_t scale;
+	char *workload;
+	enum StatsFormat format;
+	char *output;
+	char *saveBaseline;
+	char *baseline;
+	double threshold;
+	char *corpus;
+	int vm;
+	int jit;
+	int gc;
+};
+
+struct PhaseSample {
+	double wallTime;
+	double cpuTime;
+	size_t allocated;
+};
+
+struct PhaseResult {
+	double median;
+	double minimum;
+	double cpuMedian;
+	size_t allocated;
+};
+
+struct VMWorkloadResult {
+	struct Workload *workload;
+	double startupMedian;
+	double runMedian;
+	double runMinimum;
+	size_t instructions;
+};
+
+struct GCResult {
+	double runMedian;
+	size_t allocatedBytes;
+	size_t promotedBytes;
+	size_t minorCollections;
+	size_t majorCollections;
+	double pauseTime;
+	double maxPause;
+	size_t heapSize;
+};
+
+struct WorkloadResult {
+	struct Workload *workload;
+	size_t sourceBytes;
+	size_t tokens;
+	size_t nodes;
+	struct PhaseResult phases[STATS_PHASES];
+};
+
+/**
+ * <p>
+ * Outputs of the phases, that are handed to the next phase.
+ * </p>
+ */
+struct PipelineState {
+	char *path;
+	struct InputReaderResults input;
+	TOKEN *tokens;
+	struct Node *root;
+};
+
+int BM_parse_options(int argc, char **argv, struct BenchmarkOptions *options);
+int BM_is_selected(struct Workload *workload, struct BenchmarkOptions *options);
+int BM_write_source(struct Workload *workload, size_t scale, char *path);
+int BM_write_corpus(struct BenchmarkOptions *options);
+void BM_get_source_path(struct Workload *workload, char *path, size_t size);
+int BM_run_workload(struct Workload *workload, struct BenchmarkOptions *options, struct DiagnosticSink *sink, struct WorkloadResult *result);
+int BM_run_pipeline(char *path, enum StatsPhase measured, struct DiagnosticSink *sink, struct PhaseSample *sample);
+int BM_run_phase(enum StatsPhase phase, struct PipelineState *state);
+int BM_compare_doubles(const void *first, const void *second);
+void BM_write_results(FILE *output, struct WorkloadResult *results, size_t count, struct BenchmarkOptions *options);
+double BM_get_throughput(size_t amount, double seconds);
+int BM_compare_with_baseline(FILE *output, struct WorkloadResult *results, size_t count, struct BenchmarkOptions *options);
+struct JsonValue *BM_find_baseline_result(struct JsonValue *baseline, char *workload, const char *phase);
+char *BM_read_file(char *path, size_t *length);
+int BM_run_vm_workloads(struct BenchmarkOptions *options);
+int BM_run_vm_workload(struct Workload *workload, struct BenchmarkOptions *options, struct VMWorkloadResult *result);
+int BM_check_vm_result(struct Workload *workload, struct BenchmarkOptions *options, struct VirtualMachine *machine);
+void BM_write_vm_results(FILE *output, struct VMWorkloadResult *results, size_t count, struct BenchmarkOptions *options);
+int BM_run_gc_benchmark(struct BenchmarkOptions *options);
+int BM_run_gc_trees(size_t scale, struct GCResult *result);
+struct VMObject *BM_make_tree(struct VMHeap *heap, int depth);
+int BM_populate_tree(struct VMHeap *heap, union VMValue *node, int depth);
+size_t BM_count_tree(struct VMObject *node);
+void BM_write_gc_results(FILE *output, struct GCResult *result, struct BenchmarkOptions *options);
+
+int main(int argc, char **argv) {
+	struct BenchmarkOptions options = {5, 1, NULL, STATS_FORMAT_TABLE, NULL, NULL, NULL, 10.0, NULL, false, false};
+
+	if ((int)BM_parse_options(argc, argv, &options) == false) {
+		return 2;
+	}
+
+	if (options.corpus != NULL) {
+		return BM_write_corpus(&options) == true ? 0 : 2;
+	} else if (options.vm == true) {
+		return BM_run_vm_workloads(&options);
+	} else if (options.gc == true) {
+		return BM_run_gc_benchmark(&options);
+	}
+
+	if (SPACE_DEBUG_OUTPUT == 1) {
+		(void)fprintf(stderr, "Note: This is a debug build, the debug output of the phases is measured as well (build with -DSPACE_RELEASE).\n");
+	}
+
+	struct DiagnosticSink *sink = CreateNewDiagnosticSink(DIAGNOSTIC_DEFAULT_MAX_ENTRIES);
+	struct WorkloadResult *results = (struct WorkloadResult*)calloc(WORKLOAD_COUNT, sizeof(struct WorkloadResult));
+	size_t count = 0;
+
+	if (sink == NULL || results == NULL) {
+		(void)printf("Couldn't reserve the memory for the benchmark.\n");
+		return 2;
+	}
+
+	(void)_init_error_diagnostic_sink_(sink);
+
+	for (size_t i = 0; i < WORKLOAD_COUNT; i++) {
+		if ((int)BM_is_selected(&WORKLOADS[i], &options) == false) {
+			continue;
+		}
+
+		if ((int)BM_run_workload(&WORKLOADS[i], &options, sink, &results[count]) == false) {
+			(void)_init_error_diagnostic_sink_(NULL);
+			(void)FREE_DIAGNOSTIC_SINK(sink);
+			(void)free(results);
+			return 2;
+		}
+
+		count++;
+	}
+
+	(void)_init_error_diagnostic_sink_(NULL);
+	(void)FREE_DIAGNOSTIC_SINK(sink);
+
+	FILE *output = options.output == NULL ? stdout : fopen(options.output, "w");
+	int status = 0;
+
+	if (output == NULL) {
+		(void)printf("Can't open \"%s\" for the results.\n", options.output);
+		(void)free(results);
+		return 2;
+	}
+
+	(void)BM_write_results(output, results, count, &options);
+
+	if (options.saveBaseline != NULL) {
+		FILE *baseline = fopen(options.saveBaseline, "w");
+
+		if (baseline == NULL) {
+			(void)printf("Can't open \"%s\" for the baseline.\n", options.saveBaseline);
+			status = 2;
+		} else {
+			struct BenchmarkOptions jsonOptions = options;
+			jsonOptions.format = STATS_FORMAT_JSON;
+			(void)BM_write_results(baseline, results, count, &jsonOptions);
+			(void)fclose(baseline);
+		}
+	}
+
+	if (options.baseline != NULL && status == 0) {
+		//The comparison is no JSON, so it doesn't go into a JSON output
+		FILE *comparisonOutput = options.format == STATS_FORMAT_JSON ? stderr : output;
+		status = BM_compare_with_baseline(comparisonOutput, results, count, &options);
+	}
+
+	if (output != stdout) {
+		(void)fclose(output);
+	}
+
+	(void)free(results);
+	return status;
+}
+
+/**
+ * <p>
+ * Reads the options of the benchmark.
+ * </p>
+ * 
+ * @returns True if all options are valid, else false
+ * 
+ * @param argc      Number of arguments
+ * @param **argv    Arguments
+ * @param *options  Options to fill
+ */
+int BM_parse_options(int argc, char **argv, struct BenchmarkOptions *options) {
+	for (int i = 1; i < argc; i++) {
+		char *argument = argv[i];
+
+		if (strncmp(argument, "--reps=", 7) == 0) {
+			options->repetitions = (size_t)strtoul(argument + 7, NULL, 10);
+		} else if (strncmp(argument, "--scale=", 8) == 0) {
+			options->scale = (size_t)strtoul(argument + 8, NULL, 10);
+		} else if (strncmp(argument, "--workload=", 11) == 0) {
+			options->workload = argument + 11;
+		} else if (strncmp(argument, "--format=", 9) == 0) {
+			if (ST_parse_format(argument + 9, &options->format) == false) {
+				(void)printf("Unknown format \"%s\" (table or json).\n", argument + 9);
+				return false;
+			}
+		} else if (strncmp(argument, "--output=", 9) == 0) {
+			options->output = argument + 9;
+		} else if (strncmp(argument, "--save-baseline=", 16) == 0) {
+			options->saveBaseline = argument + 16;
+		} else if (strncmp(argument, "--baseline=", 11) == 0) {
+			options->baseline = argument + 11;
+		} else if (strncmp(argument, "--threshold=", 12) == 0) {
+			options->threshold = strtod(argument + 12, NULL);
+		} else if (strncmp(argument, "--write-corpus=", 15) == 0) {
+			options->corpus = argument + 15;
+		} else if (strcmp(argument, "--vm") == 0) {
+			options->vm = true;
+		} else if (strcmp(argument, "--jit") == 0) {
+			options->jit = true;
+		} else if (strcmp(argument, "--gc") == 0) {
+			options->gc = true;
+		} else {
+			(void)printf("Unknown option \"%s\".\n", argument);
+			(void)printf("Usage: space_bench [--reps=<n>] [--scale=<n>] [--workload=<name>] [--format=<table|json>] [--output=<path>]\n");
+			(void)printf("                   [--save-baseline=<path>] [--baseline=<path>] [--threshold=<percent>] [--write-corpus=<dir>] [--vm] [--jit] [--gc]\n");
+			return false;
+		}
+	}
+
+	if (options->repetitions == 0 || options->scale == 0) {
+		(void)printf("The repetitions and the scale have to be at least 1.\n");
+		return false;
+	}
+
+	if (options->workload == NULL) {
+		return true;
+	}
+
+	struct Workload *workloads = options->vm == true ? VM_WORKLOADS : WORKLOADS;
+	size_t workloadCount = options->vm == true ? VM_WORKLOAD_COUNT : WORKLOAD_COUNT;
+
+	for (size_t i = 0; i < workloadCount; i++) {
+		if (strcmp(workloads[i].name, options->workload) == 0) {
+			return true;
+		}
+	}
+
+	(void)printf("Unknown workload \"%s\", available are:\n", options->workload);
+
+	for (size_t i = 0; i < workloadCount; i++) {
+		(void)printf("    %-12s %s\n", workloads[i].name, workloads[i].description);
+	}
+
+	return false;
+}
+
+int BM_is_selected(struct Workload *workload, struct BenchmarkOptions *options) {
+	return options->workload == NULL || strcmp(options->workload, workload->name) == 0 ? true : false;
+}
+
+/**
+ * <p>
+ * Generates the source of a workload and writes it into a file.
+ * </p>
+ * 
+ * @returns True if the file was written, else false
+ * 
+ * @param *workload     Workload to generate
+ * @param scale         Multiplier of the workload's count
+ * @param *path         Path of the file
+ */
+int BM_write_source(struct Workload *workload, size_t scale, char *path) {
+	struct JsonBuffer *source = CreateNewJsonBuffer(64 * 1024);
+
+	if (source == NULL) {
+		return false;
+	}
+
+	(void)workload->generate(source, workload->count * scale, workload->size);
+	FILE *file = fopen(path, "w");
+	int written = false;
+
+	if (file != NULL) {
+		written = fwrite(source->data, sizeof(char), source->length, file) == source->length ? true : false;
+		written = fclose(file) == 0 ? written : false;
+	}
+
+	if (written == false) {
+		(void)printf("Can't write the source of \"%s\" into \"%s\".\n", workload->name, path);
+	}
+
+	(void)JSON_free_buffer(source);
+	return written;
+}
+
+/**
+ * <p>
+ * Writes the sources of the selected workloads into a directory
+ * (e.g. as training set for profile guided optimization).
+ * </p>
+ * 
+ * @returns True if all sources were written, else false
+ * 
+ * @param *options  Options with the directory, scale and workload
+ */
+int BM_write_corpus(struct BenchmarkOptions *options) {
+	for (size_t i = 0; i < WORKLOAD_COUNT; i++) {
+		if ((int)BM_is_selected(&WORKLOADS[i], options) == false) {
+			continue;
+		}
+
+		char path[1024];
+		(void)snprintf(path, sizeof(path), "%s/%s.sp", options->corpus, WORKLOADS[i].name);
+
+		if ((int)BM_write_source(&WORKLOADS[i], options->scale, path) == false) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void BM_get_source_path(struct Workload *workload, char *path, size_t size) {
+	char *directory = getenv("TMPDIR");
+
+	if (directory == NULL) {
+		directory = getenv("TEMP");
+	}
+
+	if (directory == NULL) {
+#ifdef _WIN32
+		directory = ".";
+#else
+		directory = "/tmp";
+#endif
+	}
+
+	(void)snprintf(path, size, "%s/space_bench_%s.sp", directory, workload->name);
+}
+
+/**
+ * <p>
+ * Benchmarks all phases on a workload.
+ * </p>
+ * 
+ * <p>
+ * A first run validates the generated source and counts its tokens and
+ * nodes. Then every phase is measured `repetitions` times.
+ * </p>
+ * 
+ * @returns True if the workload passed all phases, else false
+ * 
+ * @param *workload     Workload to benchmark
+ * @param *options      Options with the repetitions and the scale
+ * @param *sink         Sink, that collects the diagnostics
+ * @param *result       Receives the results
+ */
+int BM_run_workload(struct Workload *workload, struct BenchmarkOptions *options, struct DiagnosticSink *sink, struct WorkloadResult *result) {
+	char path[1024];
+	(void)BM_get_source_path(workload, path, sizeof(path));
+
+	if ((int)BM_write_source(workload, options->scale, path) == false) {
+		return false;
+	}
+
+	struct PhaseSample sample = {0};
+	result->workload = workload;
+
+	if ((int)BM_run_pipeline(path, STATS_SEMANTIC, sink, &sample) == false) {
+		(void)printf("The workload \"%s\" doesn't compile without diagnostics (%s).\n", workload->name, path);
+		return false;
+	}
+
+	result->sourceBytes = STATS.counters[COUNTER_SOURCE_BYTES];
+	result->tokens = STATS.counters[COUNTER_TOKENS];
+	result->nodes = STATS.counters[COUNTER_NODES];
+
+	double *wallTimes = (double*)calloc(options->repetitions, sizeof(double));
+	double *cpuTimes = (double*)calloc(options->repetitions, sizeof(double));
+
+	if (wallTimes == NULL || cpuTimes == NULL) {
+		(void)free(wallTimes);
+		(void)free(cpuTimes);
+		return false;
+	}
+
+	for (int phase = STATS_INPUT; phase < BM_PHASES; phase++) {
+		struct PhaseResult *phaseResult = &result->phases[phase];
+
+		for (size_t i = 0; i < options->repetitions; i++) {
+			(void)BM_run_pipeline(path, (enum StatsPhase)phase, sink, &sample);
+			wallTimes[i] = sample.wallTime;
+			cpuTimes[i] = sample.cpuTime;
+			phaseResult->allocated = sample.allocated;
+		}
+
+		(void)qsort(wallTimes, options->repetitions, sizeof(double), BM_compare_doubles);
+		(void)qsort(cpuTimes, options->repetitions, sizeof(double), BM_compare_doubles);
+		phaseResult->median = wallTimes[options->repetitions / 2];
+		phaseResult->minimum = wallTimes[0];
+		phaseResult->cpuMedian = cpuTimes[options->repetitions / 2];
+	}
+
+	(void)free(wallTimes);
+	(void)free(cpuTimes);
+	(void)remove(path);
+	return true;
+}
+
+/**
+ * <p>
+ * Runs the phases up to the measured phase on a file, only the
+ * measured phase is timed.
+ * </p>
+ * 
+ * <p>
+ * All memory of the run is freed afterwards, so every repetition
+ * starts with the same state.
+ * </p>
+ * 
+ * @returns True if all phases succeeded without a diagnostic, else false
+ * 
+ * @param *path         Path to the source
+ * @param measured      Last phase, which is timed
+ * @param *sink         Sink, that collects the diagnostics
+ * @param *sample       Receives the time and allocations of the measured phase
+ */
+int BM_run_pipeline(char *path, enum StatsPhase measured, struct DiagnosticSink *sink, struct PhaseSample *sample) {
+	struct PipelineState state = {path, {NULL, NULL, 0, 0}, NULL, NULL};
+	int status = PHASE_SUCCESS;
+
+	FILE_NAME = path;
+	BUFFER = NULL;
+	BUFFER_LENGTH = 0;
+	TOKEN_LENGTH = 0;
+	LINE_INDEX = NULL;
+	(void)ST_reset();
+
+	for (int phase = STATS_INPUT; phase <= (int)measured && status == PHASE_SUCCESS; phase++) {
+		size_t allocated = STATS.counters[COUNTER_BYTES_ALLOCATED];
+
+		if (phase == (int)measured) {
+			(void)ST_start_phase(measured);
+		}
+
+		status = BM_run_phase((enum StatsPhase)phase, &state);
+
+		if (phase == (int)measured) {
+			(void)ST_end_phase(measured);
+			sample->allocated = STATS.counters[COUNTER_BYTES_ALLOCATED] - allocated;
+		}
+	}
+
+	sample->wallTime = STATS.phases[measured].wallTime;
+	sample->cpuTime = STATS.phases[measured].cpuTime;
+
+	if (state.root != NULL) {
+		(void)FREE_NODE(state.root);
+	}
+
+	(void)FREE_LINE_INDEX(LINE_INDEX);
+	LINE_INDEX = NULL;
+	(void)FREE_MEMORY();
+
+	int clean = status == PHASE_SUCCESS && sink->count + sink->dropped == 0 ? true : false;
+	(void)DG_clear(sink);
+	return clean;
+}
+
+/**
+ * <p>
+ * Runs a single phase on the outputs of the previous phases.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the phase
+ * 
+ * @param phase     Phase to run
+ * @param *state    Outputs of the previous phases, receives the output of the phase
+ */
+int BM_run_phase(enum StatsPhase phase, struct PipelineState *state) {
+	switch (phase) {
+	case STATS_INPUT:
+		state->input = ProcessInput(state->path);
+
+		if (state->input.buffer == NULL) {
+			return PHASE_ABORTED;
+		}
+
+		BUFFER = &state->input.buffer;
+		BUFFER_LENGTH = state->input.fileLength;
+		TOKEN_LENGTH = state->input.requiredTokenNumber;
+		(void)ST_count(COUNTER_SOURCE_BYTES, state->input.fileLength);
+		return PHASE_SUCCESS;
+	case STATS_LEXER: {
+		int *arrayOfIndividualTokenSizes = state->input.arrayOfIndividualTokenSizes;
+		state->tokens = Tokenize(&arrayOfIndividualTokenSizes);
+		return state->tokens == NULL ? PHASE_ABORTED : PHASE_SUCCESS;
+	}
+	case STATS_SYNTAX:
+		return CheckInput(&state->tokens);
+	case STATS_PARSETREE:
+		state->root = GenerateParsetree(&state->tokens);
+		return state->root == NULL ? PHASE_ABORTED : PHASE_SUCCESS;
+	case STATS_SEMANTIC:
+		return CheckSemantic(state->root, NULL);
+	default:
+		return PHASE_ABORTED;
+	}
+}
+
+int BM_compare_doubles(const void *first, const void *second) {
+	double a = *(const double*)first;
+	double b = *(const double*)second;
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+double BM_get_throughput(size_t amount, double seconds) {
+	return seconds > 0 ? (double)amount / seconds : 0;
+}
+
+/**
+ * <p>
+ * Writes the results as table or JSON (same layout as the baseline).
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *results  Results of the workloads
+ * @param count     Number of results
+ * @param *options  Options with the format, scale and repetitions
+ */
+void BM_write_results(FILE *output, struct WorkloadResult *results, size_t count, struct BenchmarkOptions *options) {
+	if (options->format == STATS_FORMAT_JSON) {
+		(void)fprintf(output, "{\"version\":1,\"scale\":%lu,\"repetitions\":%lu,\"debugBuild\":%s,\"results\":[",
+			(unsigned long)options->scale, (unsigned long)options->repetitions, SPACE_DEBUG_OUTPUT == 1 ? "true" : "false");
+
+		for (size_t i = 0; i < count; i++) {
+			struct WorkloadResult *result = &results[i];
+
+			for (int phase = STATS_INPUT; phase < BM_PHASES; phase++) {
+				struct PhaseResult *phaseResult = &result->phases[phase];
+				(void)fprintf(output, "%s\n{\"workload\":\"%s\",\"phase\":\"%s\",\"sourceBytes\":%lu,\"tokens\":%lu,\"nodes\":%lu,",
+					i + phase == 0 ? "" : ",", result->workload->name, STATS_PHASE_NAMES[phase],
+					(unsigned long)result->sourceBytes, (unsigned long)result->tokens, (unsigned long)result->nodes);
+				(void)fprintf(output, "\"medianSeconds\":%.9f,\"minSeconds\":%.9f,\"cpuSeconds\":%.9f,\"bytesAllocated\":%lu,",
+					phaseResult->median, phaseResult->minimum, phaseResult->cpuMedian, (unsigned long)phaseResult->allocated);
+				(void)fprintf(output, "\"mbPerSecond\":%.3f,\"tokensPerSecond\":%.0f,\"nodesPerSecond\":%.0f}",
+					BM_get_throughput(result->sourceBytes, phaseResult->median) / 1e6,
+					BM_get_throughput(result->tokens, phaseResult->median),
+					BM_get_throughput(result->nodes, phaseResult->median));
+			}
+		}
+
+		(void)fprintf(output, "\n],\"peakRssBytes\":%lu}\n", (unsigned long)ST_get_peak_rss());
+		return;
+	}
+
+	(void)fprintf(output, "\n%-12s|%-10s|%11s|%11s|%9s|%10s|%10s|%11s|\n", "Workload", "Phase", "Median(ms)", "Min(ms)", "MB/s", "Mtokens/s", "Mnodes/s", "Alloc(KB)");
+	(void)fprintf(output, "------------+----------+-----------+-----------+---------+----------+----------+-----------+\n");
+
+	for (size_t i = 0; i < count; i++) {
+		struct WorkloadResult *result = &results[i];
+
+		for (int phase = STATS_INPUT; phase < BM_PHASES; phase++) {
+			struct PhaseResult *phaseResult = &result->phases[phase];
+			char tokens[16] = "-";
+			char nodes[16] = "-";
+
+			//Tokens exist after the lexer, nodes after the parsetree generation
+			if (phase >= STATS_LEXER) {
+				(void)snprintf(tokens, sizeof(tokens), "%.2f", BM_get_throughput(result->tokens, phaseResult->median) / 1e6);
+			}
+
+			if (phase >= STATS_PARSETREE) {
+				(void)snprintf(nodes, sizeof(nodes), "%.2f", BM_get_throughput(result->nodes, phaseResult->median) / 1e6);
+			}
+
+			(void)fprintf(output, "%-12s|%-10s|%11.3f|%11.3f|%9.2f|%10s|%10s|%11.1f|\n", phase == STATS_INPUT ? result->workload->name : "",
+				STATS_PHASE_NAMES[phase], phaseResult->median * 1000, phaseResult->minimum * 1000,
+				BM_get_throughput(result->sourceBytes, phaseResult->median) / 1e6, tokens, nodes, phaseResult->allocated / 1024.0);
+		}
+
+		(void)fprintf(output, "%-12s  %lu bytes, %lu tokens, %lu nodes\n", "", (unsigned long)result->sourceBytes,
+			(unsigned long)result->tokens, (unsigned long)result->nodes);
+	}
+
+	(void)fprintf(output, "\n%lu repetition(s), scale %lu, peak RSS %.1f MB\n", (unsigned long)options->repetitions,
+		(unsigned long)options->scale, ST_get_peak_rss() / (1024.0 * 1024.0));
+}
+
+/**
+ * <p>
+ * Compares the median times with a stored baseline.
+ * </p>
+ * 
+ * <p>
+ * A phase, that got slower than the threshold (in percent), counts
+ * as regression. Phases without a baseline entry are skipped.
+ * </p>
+ * 
+ * @returns 0 if there is no regression, 1 on regressions and 2 if the baseline can't be used
+ * 
+ * @param *output   Stream to write the comparison to
+ * @param *results  Results of the workloads
+ * @param count     Number of results
+ * @param *options  Options with the baseline path and the threshold
+ */
+int BM_compare_with_baseline(FILE *output, struct WorkloadResult *results, size_t count, struct BenchmarkOptions *options) {
+	size_t length = 0;
+	char *text = BM_read_file(options->baseline, &length);
+	struct JsonValue *baseline = text == NULL ? NULL : JSON_parse(text, length);
+	(void)free(text);
+
+	if (baseline == NULL || JSON_get_member(baseline, "results") == NULL) {
+		(void)printf("Can't read the baseline \"%s\".\n", options->baseline);
+		(void)JSON_free_value(baseline);
+		return 2;
+	}
+
+	if ((size_t)JSON_get_number(baseline, "scale", 0) != options->scale) {
+		(void)printf("The baseline was measured with scale %lu, not %lu.\n",
+			(unsigned long)JSON_get_number(baseline, "scale", 0), (unsigned long)options->scale);
+		(void)JSON_free_value(baseline);
+		return 2;
+	}
+
+	size_t regressions = 0;
+	(void)fprintf(output, "\n%-12s|%-10s|%13s|%13s|%9s|\n", "Workload", "Phase", "Baseline(ms)", "Current(ms)", "Change");
+	(void)fprintf(output, "------------+----------+-------------+-------------+---------+\n");
+
+	for (size_t i = 0; i < count; i++) {
+		for (int phase = STATS_INPUT; phase < BM_PHASES; phase++) {
+			struct JsonValue *entry = BM_find_baseline_result(baseline, results[i].workload->name, STATS_PHASE_NAMES[phase]);
+			double base = entry == NULL ? 0 : JSON_get_number(entry, "medianSeconds", 0);
+
+			if (base <= 0) {
+				continue;
+			}
+
+			double current = results[i].phases[phase].median;
+			double change = (current - base) / base * 100;
+			int regression = change > options->threshold ? true : false;
+			regressions += regression;
+
+			(void)fprintf(output, "%-12s|%-10s|%13.3f|%13.3f|%+8.1f%%|%s\n", results[i].workload->name, STATS_PHASE_NAMES[phase],
+				base * 1000, current * 1000, change, regression == true ? " REGRESSION" : "");
+		}
+	}
+
+	(void)fprintf(output, "\n%lu regression(s) (threshold %.1f%%)\n", (unsigned long)regressions, options->threshold);
+	(void)JSON_free_value(baseline);
+	return regressions > 0 ? 1 : 0;
+}
+
+struct JsonValue *BM_find_baseline_result(struct JsonValue *baseline, char *workload, const char *phase) {
+	struct JsonValue *entries = JSON_get_member(baseline, "results");
+
+	if (entries == NULL || entries->type != JSON_ARRAY) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < entries->count; i++) {
+		char *entryWorkload = JSON_get_string(entries->items[i], "workload");
+		char *entryPhase = JSON_get_string(entries->items[i], "phase");
+
+		if (entryWorkload != NULL && entryPhase != NULL
+			&& strcmp(entryWorkload, workload) == 0 && strcmp(entryPhase, phase) == 0) {
+			return entries->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Reads a whole file into a heap buffer.
+ * </p>
+ * 
+ * @returns The '\0' terminated content or NULL, if the file can't be read
+ * 
+ * @param *path     Path to the file
+ * @param *length   Receives the length of the content
+ */
+char *BM_read_file(char *path, size_t *length) {
+	FILE *file = fopen(path, "rb");
+
+	if (file == NULL) {
+		return NULL;
+	}
+
+	(void)fseek(file, 0L, SEEK_END);
+	long size = ftell(file);
+	(void)rewind(file);
+	char *text = size < 0 ? NULL : (char*)calloc((size_t)size + 1, sizeof(char));
+
+	if (text != NULL) {
+		*length = fread(text, sizeof(char), (size_t)size, file);
+	}
+
+	(void)fclose(file);
+	return text;
+}
+
+/**
+ * <p>
+ * Runs the selected VM workloads and writes their results.
+ * </p>
+ * 
+ * @returns 0 if all workloads ran, else 2
+ * 
+ * @param *options  Options with the repetitions, scale, workload and output
+ */
+int BM_run_vm_workloads(struct BenchmarkOptions *options) {
+	struct VMWorkloadResult *results = (struct VMWorkloadResult*)calloc(VM_WORKLOAD_COUNT, sizeof(struct VMWorkloadResult));
+	size_t count = 0;
+
+	if (results == NULL) {
+		(void)printf("Couldn't reserve the memory for the benchmark.\n");
+		return 2;
+	}
+
+	for (size_t i = 0; i < VM_WORKLOAD_COUNT; i++) {
+		if ((int)BM_is_selected(&VM_WORKLOADS[i], options) == false) {
+			continue;
+		}
+
+		if ((int)BM_run_vm_workload(&VM_WORKLOADS[i], options, &results[count]) == false) {
+			(void)free(results);
+			return 2;
+		}
+
+		count++;
+	}
+
+	FILE *output = options->output == NULL ? stdout : fopen(options->output, "w");
+
+	if (output == NULL) {
+		(void)printf("Can't open \"%s\" for the results.\n", options->output);
+		(void)free(results);
+		return 2;
+	}
+
+	(void)BM_write_vm_results(output, results, count, options);
+
+	if (output != stdout) {
+		(void)fclose(output);
+	}
+
+	(void)free(results);
+	return 0;
+}
+
+/**
+ * <p>
+ * Compiles a VM workload into bytecode and executes it.
+ * </p>
+ * 
+ * <p>
+ * The startup covers the whole compilation of the source in memory
+ * and the creation of the virtual machine, the run only the execution.
+ * Both are repeated and the median is reported.
+ * </p>
+ * 
+ * @returns True if the workload compiled and ran without an error, else false
+ * 
+ * @param *workload     Workload to benchmark
+ * @param *options      Options with the repetitions and the scale
+ * @param *result       Receives the results
+ */
+int BM_run_vm_workload(struct Workload *workload, struct BenchmarkOptions *options, struct VMWorkloadResult *result) {
+	struct JsonBuffer *source = CreateNewJsonBuffer(4096);
+	double *startupTimes = (double*)calloc(options->repetitions, sizeof(double));
+	double *runTimes = (double*)calloc(options->repetitions, sizeof(double));
+	int valid = source != NULL && startupTimes != NULL && runTimes != NULL ? true : false;
+	struct CompilerOptions compilerOptions;
+
+	(void)CP_get_default_options(&compilerOptions);
+	compilerOptions.lastStage = COMPILE_UNTIL_BYTECODE;
+	result->workload = workload;
+
+	if (valid == true) {
+		(void)workload->generate(source, workload->count * options->scale, workload->size);
+	}
+
+	for (size_t i = 0; i < options->repetitions && valid == true; i++) {
+		double start = ST_get_wall_time();
+		struct CompileResult *compiled = CompileBuffer(NULL, workload->name, source->data, source->length, &compilerOptions);
+		struct VirtualMachine *machine = compiled == NULL || compiled->program == NULL ? NULL : CreateNewVirtualMachine(compiled->program);
+		double ready = ST_get_wall_time();
+
+		if (machine != NULL) {
+			compiled->program->jit = options->jit == true ? compiled->program->jit : false;
+		}
+
+		if (machine == NULL || VM_run(machine, NULL) != PHASE_SUCCESS) {
+			(void)printf("The VM workload \"%s\" doesn't compile or run without an error.\n", workload->name);
+			valid = false;
+		} else if ((int)BM_check_vm_result(workload, options, machine) == false) {
+			(void)printf("The VM workload \"%s\" computed a wrong result.\n", workload->name);
+			valid = false;
+		} else {
+			runTimes[i] = ST_get_wall_time() - ready;
+			startupTimes[i] = ready - start;
+			result->instructions = machine->executedInstructions;
+		}
+
+		(void)FREE_VIRTUAL_MACHINE(machine);
+		(void)FREE_COMPILE_RESULT(compiled);
+	}
+
+	if (valid == true) {
+		(void)qsort(startupTimes, options->repetitions, sizeof(double), BM_compare_doubles);
+		(void)qsort(runTimes, options->repetitions, sizeof(double), BM_compare_doubles);
+		result->startupMedian = startupTimes[options->repetitions / 2];
+		result->runMedian = runTimes[options->repetitions / 2];
+		result->runMinimum = runTimes[0];
+	}
+
+	(void)JSON_free_buffer(source);
+	(void)free(startupTimes);
+	(void)free(runTimes);
+	return valid;
+}
+
+/**
+ * <p>
+ * Checks the globals of a VM workload after its run against the
+ * expected line of the workload (see Workload).
+ * </p>
+ * 
+ * @returns True if the globals contain the expected line (or the workload isn't checked), else false
+ * 
+ * @param *workload     Workload, that ran
+ * @param *options      Options with the scale
+ * @param *machine      Virtual machine, that ran the workload
+ */
+int BM_check_vm_result(struct Workload *workload, struct BenchmarkOptions *options, struct VirtualMachine *machine) {
+	if (workload->expect == NULL) {
+		return true;
+	}
+
+	struct JsonBuffer *expected = CreateNewJsonBuffer(256);
+	FILE *dump = tmpfile();
+	int matches = false;
+
+	if (expected != NULL && dump != NULL) {
+		(void)workload->expect(expected, workload->count * options->scale, workload->size);
+		(void)VM_dump_globals(dump, machine);
+		long length = ftell(dump);
+		char *globals = length < 0 ? NULL : (char*)calloc((size_t)length + 1, sizeof(char));
+
+		if (globals != NULL) {
+			(void)rewind(dump);
+			size_t read = fread(globals, sizeof(char), (size_t)length, dump);
+			globals[read] = '\0';
+			matches = strstr(globals, expected->data) != NULL ? true : false;
+		}
+
+		(void)free(globals);
+	}
+
+	if (dump != NULL) {
+		(void)fclose(dump);
+	}
+
+	(void)JSON_free_buffer(expected);
+	return matches;
+}
+
+/**
+ * <p>
+ * Writes the results of the VM workloads as table or JSON.
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *results  Results of the workloads
+ * @param count     Number of results
+ * @param *options  Options with the format, scale and repetitions
+ */
+void BM_write_vm_results(FILE *output, struct VMWorkloadResult *results, size_t count, struct BenchmarkOptions *options) {
+	if (options->format == STATS_FORMAT_JSON) {
+		(void)fprintf(output, "{\"version\":1,\"scale\":%lu,\"repetitions\":%lu,\"debugBuild\":%s,\"threaded\":%s,\"vmResults\":[",
+			(unsigned long)options->scale, (unsigned long)options->repetitions, SPACE_DEBUG_OUTPUT == 1 ? "true" : "false",
+			VM_THREADED_DISPATCH == 1 ? "true" : "false");
+
+		for (size_t i = 0; i < count; i++) {
+			struct VMWorkloadResult *result = &results[i];
+			(void)fprintf(output, "%s\n{\"workload\":\"%s\",\"startupSeconds\":%.9f,\"medianSeconds\":%.9f,\"minSeconds\":%.9f,",
+				i == 0 ? "" : ",", result->workload->name, result->startupMedian, result->runMedian, result->runMinimum);
+			(void)fprintf(output, "\"instructions\":%lu,\"instructionsPerSecond\":%.0f}",
+				(unsigned long)result->instructions, BM_get_throughput(result->instructions, result->runMedian));
+		}
+
+		(void)fprintf(output, "\n],\"peakRssBytes\":%lu}\n", (unsigned long)ST_get_peak_rss());
+		return;
+	}
+
+	(void)fprintf(output, "\n%-12s|%12s|%11s|%11s|%14s|%10s|\n", "Workload", "Startup(ms)", "Median(ms)", "Min(ms)", "Instructions", "Mops/s");
+	(void)fprintf(output, "------------+------------+-----------+-----------+--------------+----------+\n");
+
+	for (size_t i = 0; i < count; i++) {
+		struct VMWorkloadResult *result = &results[i];
+		(void)fprintf(output, "%-12s|%12.3f|%11.3f|%11.3f|%14lu|%10.1f|\n", result->workload->name, result->startupMedian * 1000,
+			result->runMedian * 1000, result->runMinimum * 1000, (unsigned long)result->instructions,
+			BM_get_throughput(result->instructions, result->runMedian) / 1e6);
+	}
+
+	(void)fprintf(output, "\n%lu repetition(s), scale %lu, %s dispatch, peak RSS %.1f MB\n", (unsigned long)options->repetitions,
+		(unsigned long)options->scale, VM_THREADED_DISPATCH == 1 ? "threaded" : "switch", ST_get_peak_rss() / (1024.0 * 1024.0));
+}
+
+/**
+ * <p>
+ * Runs the allocation benchmark of the garbage collector and writes
+ * its results.
+ * </p>
+ * 
+ * @returns 0 if all trees were built and kept intact, else 2
+ * 
+ * @param *options  Options with the repetitions, scale and output
+ */
+int BM_run_gc_benchmark(struct BenchmarkOptions *options) {
+	double *runTimes = (double*)calloc(options->repetitions, sizeof(double));
+	struct GCResult result = {0};
+
+	if (runTimes == NULL) {
+		(void)printf("Couldn't reserve the memory for the benchmark.\n");
+		return 2;
+	}
+
+	for (size_t i = 0; i < options->repetitions; i++) {
+		double maxPause = result.maxPause;
+		double start = ST_get_wall_time();
+
+		if ((int)BM_run_gc_trees(options->scale, &result) == false) {
+			(void)printf("The trees of the GC benchmark ran out of memory or were corrupted.\n");
+			(void)free(runTimes);
+			return 2;
+		}
+
+		runTimes[i] = ST_get_wall_time() - start;
+		result.maxPause = result.maxPause > maxPause ? result.maxPause : maxPause;
+	}
+
+	(void)qsort(runTimes, options->repetitions, sizeof(double), BM_compare_doubles);
+	result.runMedian = runTimes[options->repetitions / 2];
+	(void)free(runTimes);
+
+	FILE *output = options->output == NULL ? stdout : fopen(options->output, "w");
+
+	if (output == NULL) {
+		(void)printf("Can't open \"%s\" for the results.\n", options->output);
+		return 2;
+	}
+
+	(void)BM_write_gc_results(output, &result, options);
+
+	if (output != stdout) {
+		(void)fclose(output);
+	}
+
+	return 0;
+}
+
+/**
+ * <p>
+ * Allocates binary trees on a new heap: a long-lived tree, that is built
+ * top-down (the old nodes get references to new ones), and many
+ * short-lived trees of growing depth, that are built bottom-up.
+ * </p>
+ * 
+ * <p>
+ * The long-lived tree is counted at the end, so a collection, that lost
+ * or broke an object, is noticed.
+ * </p>
+ * 
+ * @returns True if all trees were built and the long-lived tree is complete, else false
+ * 
+ * @param scale     Multiplier of the short-lived trees
+ * @param *result   Receives the statistics of the heap (the last run)
+ */
+int BM_run_gc_trees(size_t scale, struct GCResult *result) {
+	const int longLivedDepth = 16;
+	const int maxDepth = 14;
+	struct VMHeap *heap = CreateNewVMHeap(VM_MAX_HEAP_SIZE);
+	union VMValue longLived = {0};
+	union VMValue values = {0};
+	union VMValue temporary = {0};
+	int valid = heap != NULL ? true : false;
+
+	if (valid == true) {
+		(void)VM_heap_push_root(heap, &longLived);
+		(void)VM_heap_push_root(heap, &values);
+		(void)VM_heap_push_root(heap, &temporary);
+		longLived.object = VM_heap_allocate(heap, 3, 2);
+		valid = longLived.object != NULL && BM_populate_tree(heap, &longLived, longLivedDepth) == true ? true : false;
+	}
+
+	//A large object without references goes into the old generation directly
+	if (valid == true) {
+		values.object = VM_heap_allocate(heap, 100000, 0);
+		valid = values.object != NULL ? true : false;
+	}
+
+	for (int depth = 4; depth <= maxDepth && valid == true; depth += 2) {
+		size_t iterations = ((size_t)1 << (maxDepth - depth + 4)) * scale;
+
+		for (size_t i = 0; i < iterations && valid == true; i++) {
+			temporary.object = BM_make_tree(heap, depth);
+			valid = temporary.object != NULL ? true : false;
+		}
+	}
+
+	if (valid == true) {
+		valid = BM_count_tree(longLived.object) == ((size_t)1 << (longLivedDepth + 1)) - 1 ? true : false;
+	}
+
+	if (heap != NULL) {
+		result->allocatedBytes = heap->allocatedBytes;
+		result->promotedBytes = heap->promotedBytes;
+		result->minorCollections = heap->minorCollections;
+		result->majorCollections = heap->majorCollections;
+		result->pauseTime = heap->pauseTime;
+		result->maxPause = heap->maxPause;
+		result->heapSize = heap->nurserySize + heap->oldSize;
+	}
+
+	(void)FREE_VM_HEAP(heap);
+	return valid;
+}
+
+/*
+Purpose: Build a complete binary tree bottom-up, the children are registered as roots while their parent is allocated
+Return Type: struct VMObject * => Root of the tree, NULL if the heap is full
+Params: struct VMHeap *heap => Heap to allocate in;
+		int depth => Depth of the tree
+*/
+struct VMObject *BM_make_tree(struct VMHeap *heap, int depth) {
+	union VMValue left = {0};
+	union VMValue right = {0};
+
+	if (depth > 0) {
+		(void)VM_heap_push_root(heap, &left);
+		(void)VM_heap_push_root(heap, &right);
+		left.object = BM_make_tree(heap, depth - 1);
+		right.object = left.object == NULL ? NULL : BM_make_tree(heap, depth - 1);
+	}
+
+	struct VMObject *node = depth == 0 || right.object != NULL ? VM_heap_allocate(heap, 3, 2) : NULL;
+	(void)VM_heap_pop_roots(heap, depth > 0 ? 2 : 0);
+
+	if (node != NULL) {
+		node->slots[0] = left;
+		node->slots[1] = right;
+		node->slots[2].integer = depth;
+	}
+
+	return node;
+}
+
+/*
+Purpose: Build a complete binary tree top-down, the parent can already be old, so the children are written with the write barrier
+Return Type: int => true if the tree was built, false if the heap is full
+Params: struct VMHeap *heap => Heap to allocate in;
+		union VMValue *node => Registered root with the parent;
+		int depth => Depth of the tree below the parent
+*/
+int BM_populate_tree(struct VMHeap *heap, union VMValue *node, int depth) {
+	union VMValue child = {0};
+	int valid = true;
+
+	if (depth <= 0) {
+		return true;
+	}
+
+	(void)VM_heap_push_root(heap, &child);
+
+	for (size_t side = 0; side < 2 && valid == true; side++) {
+		child.object = VM_heap_allocate(heap, 3, 2);
+		valid = child.object != NULL && VM_heap_write(heap, node->object, side, child) == true ? true : false;
+		valid = valid == true ? BM_populate_tree(heap, &child, depth - 1) : false;
+	}
+
+	(void)VM_heap_pop_roots(heap, 1);
+	return valid;
+}
+
+size_t BM_count_tree(struct VMObject *node) {
+	if (node == NULL) {
+		return 0;
+	}
+
+	return 1 + BM_count_tree(node->slots[0].object) + BM_count_tree(node->slots[1].object);
+}
+
+/**
+ * <p>
+ * Writes the results of the GC benchmark as table or JSON.
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *result   Results of the benchmark
+ * @param *options  Options with the format, scale and repetitions
+ */
+void BM_write_gc_results(FILE *output, struct GCResult *result, struct BenchmarkOptions *options) {
+	size_t collections = result->minorCollections + result->majorCollections;
+	double meanPause = collections > 0 ? result->pauseTime / collections : 0;
+
+	if (options->format == STATS_FORMAT_JSON) {
+		(void)fprintf(output, "{\"version\":1,\"scale\":%lu,\"repetitions\":%lu,\"gcResults\":[\n", (unsigned long)options->scale,
+			(unsigned long)options->repetitions);
+		(void)fprintf(output, "{\"workload\":\"trees\",\"medianSeconds\":%.9f,\"allocatedBytes\":%lu,\"promotedBytes\":%lu,",
+			result->runMedian, (unsigned long)result->allocatedBytes, (unsigned long)result->promotedBytes);
+		(void)fprintf(output, "\"minorCollections\":%lu,\"majorCollections\":%lu,\"pauseSeconds\":%.9f,\"maxPauseSeconds\":%.9f,",
+			(unsigned long)result->minorCollections, (unsigned long)result->majorCollections, result->pauseTime, result->maxPause);
+		(void)fprintf(output, "\"meanPauseSeconds\":%.9f,\"heapBytes\":%lu}\n],\"peakRssBytes\":%lu}\n", meanPause,
+			(unsigned long)result->heapSize, (unsigned long)ST_get_peak_rss());
+		return;
+	}
+
+	(void)fprintf(output, "\n%-12s|%11s|%11s|%11s|%7s|%7s|%11s|%11s|%11s|%10s|\n", "Workload", "Median(ms)", "Alloc(MB)", "Promot(MB)",
+		"Minor", "Major", "GC(ms)", "Max(ms)", "Mean(ms)", "Heap(MB)");
+	(void)fprintf(output, "------------+-----------+-----------+-----------+-------+-------+-----------+-----------+-----------+----------+\n");
+	(void)fprintf(output, "%-12s|%11.3f|%11.1f|%11.1f|%7lu|%7lu|%11.3f|%11.3f|%11.3f|%10.1f|\n", "trees", result->runMedian * 1000,
+		result->allocatedBytes / (1024.0 * 1024.0), result->promotedBytes / (1024.0 * 1024.0), (unsigned long)result->minorCollections,
+		(unsigned long)result->majorCollections, result->pauseTime * 1000, result->maxPause * 1000, meanPause * 1000,
+		result->heapSize / (1024.0 * 1024.0));
+	(void)fprintf(output, "\n%lu repetition(s), scale %lu, peak RSS %.1f MB\n", (unsigned long)options->repetitions,
+		(unsigned long)options->scale, ST_get_peak_rss() / (1024.0 * 1024.0));
+}
@@ -0,0 +1,433 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../headers/benchmark.h"
+
+/**
+ * The subprogram {@code SPACE/bench/generators.c} was created
+ * to generate synthetic SPACE sources for the benchmark.
+ *
+ * Every generator stresses another part of the compiler (many
+ * scopes, deep nesting, long terms, wide enums, big arrays and
+ * many symbols). All generated sources pass every phase without
+ * a diagnostic.
+ *
+ * The VM workloads are small programs, that are executed by the
+ * virtual machine (calls, loops, floating point math, branches,
+ * string concatenations, chars and overflowing fields).
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+struct Workload WORKLOADS[] = {
+	{"classes", "N classes with M methods each", BM_generate_classes, 40, 25},
+	{"nesting", "N if / else chains, M levels deep", BM_generate_nesting, 40, 64},
+	{"expressions", "N variables with M terms each", BM_generate_expressions, 200, 200},
+	{"enums", "N enums with M enumerators each", BM_generate_enums, 20, 500},
+	{"arrays", "N array initializers with M elements each", BM_generate_arrays, 20, 2000},
+	{"includes", "N includes, M modules per library", BM_generate_includes, 2000, 1}
+};
+
+const size_t WORKLOAD_COUNT = sizeof(WORKLOADS) / sizeof(WORKLOADS[0]);
+
+//Small programs, that are executed by the virtual machine (--vm)
+struct Workload VM_WORKLOADS[] = {
+	{"fibonacci", "N calls of a recursive fib(M)", BM_generate_fibonacci, 5, 22},
+	{"loops", "N calls of two nested loops with M iterations", BM_generate_loops, 20, 300},
+	{"floats", "N calls of a floating point loop with M iterations", BM_generate_floats, 20, 50000},
+	{"collatz", "N calls of the collatz sequences up to M", BM_generate_collatz, 5, 10000},
+	{"strings", "N calls of a loop, that concatenates M times", BM_generate_strings, 20, 2000, BM_expect_strings},
+	{"chars", "N calls of a loop, that steps M times through the alphabet", BM_generate_chars, 20, 5000, BM_expect_chars},
+	{"overflow", "N calls of a loop, that overflows an int local and an int field M times", BM_generate_overflow, 20, 5000, BM_expect_overflow}
+};
+
+const size_t VM_WORKLOAD_COUNT = sizeof(VM_WORKLOADS) / sizeof(VM_WORKLOADS[0]);
+
+void BM_append_indentation(struct JsonBuffer *output, size_t depth);
+void BM_append_driver(struct JsonBuffer *output, const char *function, const char *type, size_t count, size_t size);
+
+/**
+ * <p>
+ * Generates classes with methods, each method declares typed
+ * variables and contains a condition.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of classes
+ * @param size      Number of methods per class
+ */
+void BM_generate_classes(struct JsonBuffer *output, size_t count, size_t size) {
+	for (size_t i = 0; i < count; i++) {
+		(void)JSON_append_format(output, "class Class%lu => {\n", (unsigned long)i);
+		(void)JSON_append_format(output, "    var field%lu = 0;\n\n", (unsigned long)i);
+
+		for (size_t n = 0; n < size; n++) {
+			(void)JSON_append_format(output, "    fn method%lu(a:int, b:int) {\n", (unsigned long)n);
+			(void)JSON_append_format(output, "        var:int sum = a + b * %lu;\n", (unsigned long)n + 1);
+			(void)JSON_append_format(output, "        var:int diff = a - b;\n");
+			(void)JSON_append_format(output, "        if (diff < %lu) {\n", (unsigned long)n);
+			(void)JSON_append_format(output, "            diff = sum - diff;\n");
+			(void)JSON_append_format(output, "        }\n");
+			(void)JSON_append_format(output, "        return sum;\n");
+			(void)JSON_append_format(output, "    }\n\n");
+		}
+
+		(void)JSON_append_format(output, "}\n\n");
+	}
+}
+
+/**
+ * <p>
+ * Generates deeply nested if / else chains.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of chains
+ * @param size      Nesting depth of a chain
+ */
+void BM_generate_nesting(struct JsonBuffer *output, size_t count, size_t size) {
+	for (size_t i = 0; i < count; i++) {
+		(void)JSON_append_format(output, "var:int level%lu = 0;\n\n", (unsigned long)i);
+
+		for (size_t n = 0; n < size; n++) {
+			(void)BM_append_indentation(output, n);
+			(void)JSON_append_format(output, "if (level%lu < %lu) {\n", (unsigned long)i, (unsigned long)n);
+		}
+
+		(void)BM_append_indentation(output, size);
+		(void)JSON_append_format(output, "level%lu = level%lu + 1;\n", (unsigned long)i, (unsigned long)i);
+
+		for (size_t n = size; n > 0; n--) {
+			(void)BM_append_indentation(output, n - 1);
+			(void)JSON_append_format(output, "} else {\n");
+			(void)BM_append_indentation(output, n);
+			(void)JSON_append_format(output, "level%lu = level%lu - 1;\n", (unsigned long)i, (unsigned long)i);
+			(void)BM_append_indentation(output, n - 1);
+			(void)JSON_append_format(output, "}\n");
+		}
+
+		(void)JSON_append_format(output, "\n");
+	}
+}
+
+void BM_append_indentation(struct JsonBuffer *output, size_t depth) {
+	for (size_t i = 0; i < depth; i++) {
+		(void)JSON_append_raw(output, "\t", 1);
+	}
+}
+
+/**
+ * <p>
+ * Generates variables, that are initialized with long arithmetic terms
+ * (mixed operators and parentheses).
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of variables
+ * @param size      Number of terms per variable
+ */
+void BM_generate_expressions(struct JsonBuffer *output, size_t count, size_t size) {
+	const char *operators[] = {"+", "-", "*", "/", "%"};
+
+	(void)JSON_append_format(output, "var:int base = 7;\n\n");
+
+	for (size_t i = 0; i < count; i++) {
+		(void)JSON_append_format(output, "var:int term%lu = base", (unsigned long)i);
+
+		for (size_t n = 1; n < size; n++) {
+			const char *operator = operators[(i + n) % 5];
+
+			if (n % 8 == 0) {
+				(void)JSON_append_format(output, " %s (base + %lu)", operator, (unsigned long)n);
+			} else {
+				(void)JSON_append_format(output, " %s %lu", operator, (unsigned long)n);
+			}
+		}
+
+		(void)JSON_append_format(output, ";\n");
+	}
+}
+
+/**
+ * <p>
+ * Generates enums with many enumerators, every 16th enumerator
+ * gets an explicit value.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of enums
+ * @param size      Number of enumerators per enum
+ */
+void BM_generate_enums(struct JsonBuffer *output, size_t count, size_t size) {
+	for (size_t i = 0; i < count; i++) {
+		(void)JSON_append_format(output, "enum Enum%lu {\n", (unsigned long)i);
+
+		for (size_t n = 0; n < size; n++) {
+			char *separator = n + 1 < size ? "," : "";
+
+			if (n % 16 == 0) {
+				(void)JSON_append_format(output, "    E%lu_%lu : %lu%s\n", (unsigned long)i, (unsigned long)n, (unsigned long)n, separator);
+			} else {
+				(void)JSON_append_format(output, "    E%lu_%lu%s\n", (unsigned long)i, (unsigned long)n, separator);
+			}
+		}
+
+		(void)JSON_append_format(output, "}\n\n");
+	}
+}
+
+/**
+ * <p>
+ * Generates arrays with big initializers.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of arrays
+ * @param size      Number of elements per array
+ */
+void BM_generate_arrays(struct JsonBuffer *output, size_t count, size_t size) {
+	for (size_t i = 0; i < count; i++) {
+		(void)JSON_append_format(output, "var array%lu[%lu] = {", (unsigned long)i, (unsigned long)size);
+
+		for (size_t n = 0; n < size; n++) {
+			(void)JSON_append_format(output, "%s%s%lu", n == 0 ? "" : ",", n % 16 == 0 ? "\n    " : " ", (unsigned long)((n * 31 + i) % 1000));
+		}
+
+		(void)JSON_append_format(output, "\n};\n\n");
+	}
+}
+
+/**
+ * <p>
+ * Generates many includes, which fill the symbol table of the
+ * main scope.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of includes
+ * @param size      Number of included modules per library
+ */
+void BM_generate_includes(struct JsonBuffer *output, size_t count, size_t size) {
+	size_t perLibrary = size == 0 ? 1 : size;
+
+	for (size_t i = 0; i < count; i++) {
+		(void)JSON_append_format(output, "include library%lu.module%lu;\n", (unsigned long)(i / perLibrary), (unsigned long)i);
+	}
+}
+
+/**
+ * <p>
+ * Generates the driver of a VM workload, that calls the function
+ * of the workload `count` times with the argument `size`.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param *function Name of the called function
+ * @param type      Type of the result
+ * @param count     Number of calls
+ * @param size      Argument of the calls
+ */
+void BM_append_driver(struct JsonBuffer *output, const char *function, const char *type, size_t count, size_t size) {
+	(void)JSON_append_format(output, "var:%s result;\n\n", type);
+	(void)JSON_append_format(output, "for (var:int i = 0; i < %lu; i++) {\n", (unsigned long)count);
+	(void)JSON_append_format(output, "    result = %s(%lu);\n", function, (unsigned long)size);
+	(void)JSON_append_format(output, "}\n");
+}
+
+/**
+ * <p>
+ * Generates a recursive fibonacci function (calls and returns).
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Fibonacci number to compute
+ */
+void BM_generate_fibonacci(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "fn fib(n:int)->int {\n");
+	(void)JSON_append_format(output, "    if (n < 2) {\n        return n;\n    }\n\n");
+	(void)JSON_append_format(output, "    return fib(n - 1) + fib(n - 2);\n}\n\n");
+	(void)BM_append_driver(output, "fib", "int", count, size);
+}
+
+/**
+ * <p>
+ * Generates nested counted loops with integer arithmetic.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Iterations of both loops
+ */
+void BM_generate_loops(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "fn sum(n:int)->int {\n    var:int s = 0;\n\n");
+	(void)JSON_append_format(output, "    for (var:int i = 0; i < n; i++) {\n");
+	(void)JSON_append_format(output, "        for (var:int j = 0; j < n; j++) {\n");
+	(void)JSON_append_format(output, "            s += i * j %% 7;\n        }\n    }\n\n");
+	(void)JSON_append_format(output, "    return s;\n}\n\n");
+	(void)BM_append_driver(output, "sum", "int", count, size);
+}
+
+/**
+ * <p>
+ * Generates a while loop with floating point arithmetic.
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Iterations of the loop
+ */
+void BM_generate_floats(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "fn decay(n:int)->double {\n    var:double x = 1.0;\n    var:int i = 0;\n\n");
+	(void)JSON_append_format(output, "    while (i < n) {\n        x = x * 0.999 + 0.5;\n        i++;\n    }\n\n");
+	(void)JSON_append_format(output, "    return x;\n}\n\n");
+	(void)BM_append_driver(output, "decay", "double", count, size);
+}
+
+/**
+ * <p>
+ * Generates the collatz sequences of the numbers up to `size`
+ * (unpredictable branches).
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Highest start value
+ */
+void BM_generate_collatz(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "fn collatz(n:int)->int {\n    var:int steps = 0;\n\n");
+	(void)JSON_append_format(output, "    for (var:int i = 1; i < n; i++) {\n        var:int v = i;\n\n");
+	(void)JSON_append_format(output, "        while (v != 1) {\n");
+	(void)JSON_append_format(output, "            if (v %% 2 == 0) {\n                v = v / 2;\n");
+	(void)JSON_append_format(output, "            } else {\n                v = 3 * v + 1;\n            }\n\n");
+	(void)JSON_append_format(output, "            steps++;\n        }\n    }\n\n");
+	(void)JSON_append_format(output, "    return steps;\n}\n\n");
+	(void)BM_append_driver(output, "collatz", "int", count, size);
+}
+
+/**
+ * <p>
+ * Generates chains of string concatenations with literals and
+ * variables (more than two operands in a single term).
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Concatenations of the loop
+ */
+void BM_generate_strings(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "fn label(n:int)->String {\n    var:String key = \"id\";\n");
+	(void)JSON_append_format(output, "    var:String s = \"[[\" + key + \"::\" + key + \"]]\";\n\n");
+	(void)JSON_append_format(output, "    for (var:int i = 0; i < n; i++) {\n        s = s + \"ab\" + key + \"cd\";\n    }\n\n");
+	(void)JSON_append_format(output, "    return \"<<\" + s + \">>\";\n}\n\n");
+	(void)BM_append_driver(output, "label", "String", count, size);
+}
+
+/**
+ * <p>
+ * Writes the result of the strings workload, as the VM prints it.
+ * </p>
+ *
+ * @param *output   Buffer to write the line into
+ * @param count     Number of calls
+ * @param size      Concatenations of the loop
+ */
+void BM_expect_strings(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "result:String = \"<<[[id::id]]");
+
+	for (size_t i = 0; i < size; i++) {
+		(void)JSON_append_format(output, "abidcd");
+	}
+
+	(void)JSON_append_format(output, ">>\"\n");
+}
+
+/**
+ * <p>
+ * Generates a loop, that steps a char through the alphabet (char
+ * literals and comparisons of chars).
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Steps of the loop
+ */
+void BM_generate_chars(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "fn shift(n:int)->char {\n    var:char c = 'a';\n    var:char last = \"z\";\n\n");
+	(void)JSON_append_format(output, "    for (var:int i = 0; i < n; i++) {\n");
+	(void)JSON_append_format(output, "        if (c == last) {\n            c = 'a';\n        } else {\n            c++;\n        }\n    }\n\n");
+	(void)JSON_append_format(output, "    return c;\n}\n\n");
+	(void)BM_append_driver(output, "shift", "char", count, size);
+}
+
+/**
+ * <p>
+ * Writes the result of the chars workload, as the VM prints it.
+ * </p>
+ *
+ * @param *output   Buffer to write the line into
+ * @param count     Number of calls
+ * @param size      Steps of the loop
+ */
+void BM_expect_chars(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "result:char = '%c'\n", (char)('a' + size % 26));
+}
+
+/**
+ * <p>
+ * Generates a loop, that lets an int local and an int field of an
+ * object overflow by the same additions. Both wrap around at 32 bits,
+ * so the function returns the local (the difference is 0).
+ * </p>
+ *
+ * @param *output   Buffer to write the source into
+ * @param count     Number of calls
+ * @param size      Additions of the loop
+ */
+void BM_generate_overflow(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "class Box => {\n    var:int v = 0;\n\n");
+	(void)JSON_append_format(output, "    this::constructor(x:int) {\n        v = x;\n    }\n}\n\n");
+	(void)JSON_append_format(output, "fn overflow(n:int)->int {\n    var:int local = 0;\n    var:Box box = new Box(0);\n\n");
+	(void)JSON_append_format(output, "    for (var:int i = 0; i < n; i++) {\n        local = local + 2000000000;\n");
+	(void)JSON_append_format(output, "        var:int field = box->v;\n        box->v = field + 2000000000;\n    }\n\n");
+	(void)JSON_append_format(output, "    var:int stored = box->v;\n    return local + (local - stored);\n}\n\n");
+	(void)BM_append_driver(output, "overflow", "int", count, size);
+}
+
+/**
+ * <p>
+ * Writes the result of the overflow workload, as the VM prints it.
+ * </p>
+ *
+ * @param *output   Buffer to write the line into
+ * @param count     Number of calls
+ * @param size      Additions of the loop
+ */
+void BM_expect_overflow(struct JsonBuffer *output, size_t count, size_t size) {
+	(void)JSON_append_format(output, "result:int = %i\n", (int)(unsigned int)((unsigned long long)size * 2000000000ULL));
+}
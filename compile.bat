@@ -1,11 +1,24 @@
 echo off
 SET PROFILE_MODE=0
+SET RELEASE_MODE=0
+SET BENCHMARK_MODE=0
+SET FLAGS=
+
+IF %RELEASE_MODE% == 1 (
+    SET FLAGS=-O2 -DSPACE_RELEASE
+)
 
 IF %PROFILE_MODE% == 0 (
-    gcc -Wall -Werror -Wpedantic main/input.c src/Lexer/lexer.c src/Parser/syntaxAnalyzer.c src/Parser/parsetreeGenerator.c src/errorHandler.c src/Utils/modules.c src/Utils/hashmap.c src/Utils/list.c src/SemanticAnalysis/semanticAnalyzer.c main/main.c -o space.exe
+    gcc -Wall -Werror -Wpedantic %FLAGS% main/input.c src/Lexer/lexer.c src/Parser/syntaxAnalyzer.c src/Parser/parsetreeGenerator.c src/errorHandler.c src/Utils/modules.c src/Utils/hashmap.c src/Utils/list.c src/SemanticAnalysis/semanticAnalyzer.c src/SemanticAnalysis/classLayout.c src/Utils/json.c src/Utils/diagnostics.c src/Utils/lineindex.c src/Utils/stats.c src/IR/ir.c src/IR/irGenerator.c src/IR/irOptimizer.c src/IR/constantFolding.c src/IR/inlining.c src/IR/scalarReplacement.c src/IR/loopOptimizer.c src/IR/blockLayout.c src/VM/bytecode.c src/VM/vm.c src/VM/heap.c src/VM/strings.c src/VM/objects.c src/VM/jit.c src/CodeGen/asmGenerator.c src/Compiler/compiler.c src/Server/languageServer.c main/main.c -pthread -o space.exe
 )
 IF %PROFILE_MODE% == 1 (
-    gcc -Wall -Werror -Wpedantic -pg main/input.c src/Lexer/lexer.c src/Parser/syntaxAnalyzer.c src/Parser/parsetreeGenerator.c src/errorHandler.c src/Utils/modules.c src/Utils/hashmap.c src/Utils/list.c src/SemanticAnalysis/semanticAnalyzer.c main/main.c -o space.exe
+    gcc -Wall -Werror -Wpedantic %FLAGS% -pg main/input.c src/Lexer/lexer.c src/Parser/syntaxAnalyzer.c src/Parser/parsetreeGenerator.c src/errorHandler.c src/Utils/modules.c src/Utils/hashmap.c src/Utils/list.c src/SemanticAnalysis/semanticAnalyzer.c src/SemanticAnalysis/classLayout.c src/Utils/json.c src/Utils/diagnostics.c src/Utils/lineindex.c src/Utils/stats.c src/IR/ir.c src/IR/irGenerator.c src/IR/irOptimizer.c src/IR/constantFolding.c src/IR/inlining.c src/IR/scalarReplacement.c src/IR/loopOptimizer.c src/IR/blockLayout.c src/VM/bytecode.c src/VM/vm.c src/VM/heap.c src/VM/strings.c src/VM/objects.c src/VM/jit.c src/CodeGen/asmGenerator.c src/Compiler/compiler.c src/Server/languageServer.c main/main.c -pthread -o space.exe
+)
+
+IF %BENCHMARK_MODE% == 1 (
+    gcc -Wall -Werror -Wpedantic -O2 -DSPACE_RELEASE main/input.c src/Lexer/lexer.c src/Parser/syntaxAnalyzer.c src/Parser/parsetreeGenerator.c src/errorHandler.c src/Utils/modules.c src/Utils/hashmap.c src/Utils/list.c src/SemanticAnalysis/semanticAnalyzer.c src/SemanticAnalysis/classLayout.c src/Utils/json.c src/Utils/diagnostics.c src/Utils/lineindex.c src/Utils/stats.c src/IR/ir.c src/IR/irGenerator.c src/IR/irOptimizer.c src/IR/constantFolding.c src/IR/inlining.c src/IR/scalarReplacement.c src/IR/loopOptimizer.c src/IR/blockLayout.c src/VM/bytecode.c src/VM/vm.c src/VM/heap.c src/VM/strings.c src/VM/objects.c src/VM/jit.c src/CodeGen/asmGenerator.c src/Compiler/compiler.c src/Server/languageServer.c bench/generators.c bench/benchmark.c -pthread -o space_bench.exe
+    space_bench.exe
+    del space_bench.exe
 )
 
 space.exe
@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_BENCHMARK_H_
+#define SPACE_BENCHMARK_H_
+
+#include <stddef.h>
+#include "../headers/json.h"
+
+/**
+ * <p>
+ * Generator of a synthetic SPACE source.
+ * </p>
+ *
+ * <p>
+ * `count` scales the amount of top level constructs (multiplied with
+ * --scale), `size` is the size of a single construct.
+ * </p>
+ */
+typedef void (*SourceGenerator)(struct JsonBuffer *output, size_t count, size_t size);
+
+struct Workload {
+    char *name;
+    char *description;
+    SourceGenerator generate;
+    size_t count;
+    size_t size;
+    //Writes a line of the globals, that a VM workload has to print after its run (NULL = not checked)
+    SourceGenerator expect;
+};
+
+extern struct Workload WORKLOADS[];
+extern const size_t WORKLOAD_COUNT;
+
+//Programs for the virtual machine, `count` is the number of calls and `size` the argument
+extern struct Workload VM_WORKLOADS[];
+extern const size_t VM_WORKLOAD_COUNT;
+
+void BM_generate_classes(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_nesting(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_expressions(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_enums(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_arrays(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_includes(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_fibonacci(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_loops(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_floats(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_collatz(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_strings(struct JsonBuffer *output, size_t count, size_t size);
+void BM_expect_strings(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_chars(struct JsonBuffer *output, size_t count, size_t size);
+void BM_expect_chars(struct JsonBuffer *output, size_t count, size_t size);
+void BM_generate_overflow(struct JsonBuffer *output, size_t count, size_t size);
+void BM_expect_overflow(struct JsonBuffer *output, size_t count, size_t size);
+
+#endif  // SPACE_BENCHMARK_H_
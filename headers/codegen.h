@@ -0,0 +1,72 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+
+#ifndef SPACE_CODEGEN_H_
+#define SPACE_CODEGEN_H_
+
+#include <stddef.h>
+#include <stdio.h>
+#include "../headers/ir.h"
+
+//Used as location, if a virtual register has no physical register (spilled or unused)
+#define CG_NO_REGISTER -1
+
+//Allocatable general purpose registers (the first CG_CALLEE_SAVED_REGISTERS survive calls)
+#define CG_INTEGER_REGISTERS 10
+#define CG_CALLEE_SAVED_REGISTERS 5
+
+//Allocatable SSE registers (xmm8 - xmm14, none of them survives a call)
+#define CG_FLOATING_REGISTERS 7
+
+/**
+ * <p>
+ * Kinds of the globals in the table of the generated assembly
+ * ({@code space_globals}), that is read by the runtime.
+ * </p>
+ */
+enum CGValueKind {
+    CG_KIND_INTEGER,
+    CG_KIND_FLOATING,
+    CG_KIND_BOOLEAN,
+    CG_KIND_CHAR,
+    CG_KIND_STRING
+};
+
+/**
+ * <p>
+ * Entry of the global table ({@code space_globals}), the generated
+ * assembly emits one entry per global of the module.
+ * </p>
+ */
+struct CGGlobalEntry {
+    const char *name;
+    const char *type;
+    long long kind;
+    void *value;
+};
+
+//Assembly generator, writes GNU assembler (AT&T syntax) for x86-64 System V
+int GenerateAssembly(struct IRModule *module, const char *source, FILE *output);
+
+#endif  // SPACE_CODEGEN_H_
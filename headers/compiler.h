@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_COMPILER_H_
+#define SPACE_COMPILER_H_
+
+#include <stddef.h>
+#include "../headers/modules.h"
+#include "../headers/diagnostics.h"
+#include "../headers/lineindex.h"
+
+/**
+ * <p>
+ * Last stage, that is run by CompileBuffer().
+ * </p>
+ */
+enum CompileStage {
+    COMPILE_UNTIL_LEXER,
+    COMPILE_UNTIL_SYNTAX,
+    COMPILE_UNTIL_PARSETREE,
+    COMPILE_UNTIL_SEMANTIC,
+    COMPILE_UNTIL_IR,
+    COMPILE_UNTIL_BYTECODE
+};
+
+struct CompilerOptions {
+    enum CompileStage lastStage;
+    size_t maxDiagnostics;
+
+    //Whether the IR is optimized (see OptimizeIR())
+    int optimize;
+};
+
+/**
+ * <p>
+ * Context of the library, holds the default options and counts the
+ * compilations.
+ * </p>
+ *
+ * <p>
+ * The phases share global state, so all compilations of a process are
+ * serialized (a context can be used from multiple threads).
+ * </p>
+ */
+struct CompilerContext {
+    struct CompilerOptions defaults;
+    size_t compilations;
+    size_t failedCompilations;
+};
+
+/**
+ * <p>
+ * Result of CompileBuffer(), that owns all produced data.
+ * </p>
+ *
+ * <p>
+ * Phases, that didn't run, leave their handles at NULL. The `source` is a
+ * private copy of the input, the positions of the tokens, nodes and
+ * diagnostics refer to it.
+ * </p>
+ */
+struct CompileResult {
+    int status;
+    char *name;
+    char *source;
+    size_t length;
+
+    TOKEN *tokens;
+    size_t tokenCount;
+    struct Node *root;
+    struct SemanticTable *table;
+    struct IRModule *module;
+    struct VMProgram *program;
+
+    struct LineIndex *lines;
+    struct DiagnosticSink *diagnostics;
+};
+
+void CP_get_default_options(struct CompilerOptions *options);
+struct CompilerContext *CreateNewCompilerContext(struct CompilerOptions *defaults);
+struct CompileResult *CompileBuffer(struct CompilerContext *context, const char *name, const char *data, size_t length, struct CompilerOptions *options);
+void CP_render_diagnostics(struct CompileResult *result, struct DiagnosticRenderer *renderer);
+void FREE_COMPILE_RESULT(struct CompileResult *result);
+void FREE_COMPILER_CONTEXT(struct CompilerContext *context);
+
+#endif  // SPACE_COMPILER_H_
@@ -0,0 +1,204 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_DIAGNOSTICS_H_
+#define SPACE_DIAGNOSTICS_H_
+
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include "../headers/lineindex.h"
+#include "../headers/json.h"
+
+/**
+ * <p>
+ * Upper bounds of the diagnostics sink. Diagnostics that don't fit
+ * are only counted, messages are cut at the maximum length.
+ * </p>
+ */
+#define DIAGNOSTIC_DEFAULT_MAX_ENTRIES 1024
+#define DIAGNOSTIC_MAX_MESSAGE_LENGTH 256
+#define DIAGNOSTIC_MAX_NOTE_LENGTH 192
+
+//Used as position if a diagnostic has no source span (e.g. IO errors)
+#define DIAGNOSTIC_NO_POSITION ((size_t)-1)
+
+enum DiagnosticSeverity {
+    SEVERITY_ERROR,
+    SEVERITY_WARNING,
+    SEVERITY_NOTE
+};
+
+/**
+ * <p>
+ * Error codes of all diagnostics, grouped by the phase
+ * that reports them (the hundreds digit).
+ * </p>
+ */
+enum DiagnosticCode {
+    //Input
+    DIAG_IO_FILE = 100,
+    DIAG_IO_BUFFER,
+    DIAG_IO_BUFFER_RESERVATION,
+    DIAG_IO_FILE_CLOSING,
+
+    //Lexer
+    DIAG_LEXER_UNEXPECTED_SYMBOL = 200,
+    DIAG_LEXER_NULL_TOKEN,
+    DIAG_LEXER_UNFINISHED_POINTER,
+    DIAG_LEXER_UNFINISHED_STRING,
+    DIAG_LEXER_NULL_TOKEN_VALUE,
+    DIAG_LEXER_TOKEN_ERROR,
+
+    //Syntax analysis
+    DIAG_SYNTAX_UNEXPECTED_TOKEN = 300,
+    DIAG_SYNTAX_MISMATCH,
+    DIAG_SYNTAX_TOKEN_NULL,
+    DIAG_PARSER_TOKEN_TRANSMISSION,
+    DIAG_PARSER_RULE_RESERVATION,
+    DIAG_PARSER_RULE_FILE_CORRUPTION,
+    DIAG_PARSER_RULE_TRANSMISSION,
+
+    //Parsetree generation
+    DIAG_PARSETREE_NODE_RESERVATION = 400,
+    DIAG_PARSETREE_INVALID_NODE,
+
+    //Semantic analysis (the semantic error type is added to the base)
+    DIAG_SEMANTIC = 500,
+
+    //Semantic warnings (dead code, array indices)
+    DIAG_SEMANTIC_UNREACHABLE_CODE = 580,
+    DIAG_SEMANTIC_CONSTANT_CONDITION,
+    DIAG_SEMANTIC_UNUSED_DECLARATION,
+    DIAG_SEMANTIC_INDEX_OUT_OF_BOUNDS,
+
+    //IR generation
+    DIAG_IR_UNSUPPORTED = 600,
+    DIAG_IR_UNRESOLVED,
+    DIAG_IR_VERIFICATION,
+
+    //Virtual machine (runtime errors)
+    DIAG_VM_DIVISION_BY_ZERO = 700,
+    DIAG_VM_STACK_OVERFLOW,
+    DIAG_VM_OUT_OF_MEMORY,
+    DIAG_VM_NULL_REFERENCE,
+    DIAG_VM_INDEX_OUT_OF_BOUNDS,
+    DIAG_VM_NEGATIVE_ARRAY_LENGTH,
+
+    //Internal structures
+    DIAG_LIST_OVERFLOW = 900,
+    DIAG_LIST_UNDERFLOW
+};
+
+/**
+ * <p>
+ * A single reported problem.
+ * </p>
+ *
+ * <p>
+ * The position is the offset in the source buffer, the line is 0-based.
+ * The file name isn't copied, so it has to outlive the sink.
+ * </p>
+ */
+struct Diagnostic {
+    enum DiagnosticCode code;
+    enum DiagnosticSeverity severity;
+    const char *file;
+    size_t line;
+    size_t position;
+    size_t length;
+    char message[DIAGNOSTIC_MAX_MESSAGE_LENGTH];
+    char explanation[DIAGNOSTIC_MAX_NOTE_LENGTH];
+    char suggestion[DIAGNOSTIC_MAX_NOTE_LENGTH];
+};
+
+/**
+ * <p>
+ * Collects the diagnostics of one or more compile runs with bounded memory.
+ * </p>
+ */
+struct DiagnosticSink {
+    struct Diagnostic *entries;
+    size_t count;
+    size_t capacity;
+    size_t maxEntries;
+
+    /**
+     * <p>
+     * Counts all reported diagnostics, including the dropped ones.
+     * </p>
+     */
+    size_t errors;
+    size_t warnings;
+    size_t dropped;
+
+    /**
+     * <p>
+     * Set if the last reported diagnostic was stored (not dropped),
+     * details are only attached in that case.
+     * </p>
+     */
+    int lastStored;
+};
+
+enum DiagnosticFormat {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_SARIF
+};
+
+/**
+ * <p>
+ * Renders the diagnostics of a sink into one buffered stream.
+ * </p>
+ *
+ * <p>
+ * Text is written after every rendered sink, JSON and SARIF
+ * form a single document, which is written on DG_finish_rendering().
+ * </p>
+ */
+struct DiagnosticRenderer {
+    enum DiagnosticFormat format;
+    FILE *output;
+    struct JsonBuffer *buffer;
+    int colors;
+    size_t results;
+    size_t errors;
+    size_t warnings;
+    size_t dropped;
+};
+
+struct DiagnosticSink *CreateNewDiagnosticSink(size_t maxEntries);
+void DG_report(struct DiagnosticSink *sink, enum DiagnosticCode code, enum DiagnosticSeverity severity, const char *file, size_t line, size_t position, size_t length, const char *format, ...);
+void DG_vreport(struct DiagnosticSink *sink, enum DiagnosticCode code, enum DiagnosticSeverity severity, const char *file, size_t line, size_t position, size_t length, const char *format, va_list args);
+void DG_set_details(struct DiagnosticSink *sink, const char *explanation, const char *suggestion);
+int DG_has_errors(struct DiagnosticSink *sink);
+void DG_clear(struct DiagnosticSink *sink);
+void FREE_DIAGNOSTIC_SINK(struct DiagnosticSink *sink);
+
+struct DiagnosticRenderer *CreateNewDiagnosticRenderer(enum DiagnosticFormat format, FILE *output);
+int DG_parse_format(const char *name, enum DiagnosticFormat *format);
+void DG_render(struct DiagnosticRenderer *renderer, struct DiagnosticSink *sink, struct LineIndex *lineIndex, const char *source);
+void DG_finish_rendering(struct DiagnosticRenderer *renderer);
+void FREE_DIAGNOSTIC_RENDERER(struct DiagnosticRenderer *renderer);
+
+#endif  // SPACE_DIAGNOSTICS_H_
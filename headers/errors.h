@@ -24,6 +24,9 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "../headers/modules.h"
 #include "../headers/list.h"
+#include "../headers/diagnostics.h"
+
+#include <setjmp.h>
 
 //////////////////////////////////////////////////////////////
 ///////////////////     ERROR HANDLING     ///////////////////
@@ -36,6 +39,12 @@ void _init_error_buffer_cache_(char **buffer);
 void _init_error_token_size_cache_(int **arrayOfIndividualTokenSizes);
 void _init_error_tree_cache_(struct Node **root);
 void _init_error_external_list_cache(struct List *list);
+void _init_error_diagnostic_sink_(struct DiagnosticSink *sink);
+void _init_error_recovery_point_(jmp_buf *recoveryPoint);
+
+void REPORT_DIAGNOSTIC(enum DiagnosticCode code, enum DiagnosticSeverity severity, size_t line, size_t position, size_t length, const char *format, ...);
+void REPORT_DIAGNOSTIC_DETAILS(const char *explanation, const char *suggestion);
+void ABORT_COMPILATION();
 
 void IO_FILE_EXCEPTION(char *Source, char *file);
 void IO_BUFFER_EXCEPTION(char *Step);
@@ -52,6 +61,7 @@ void LEXER_TOKEN_ERROR_EXCEPTION();
 void PARSER_TOKEN_TRANSMISSION_EXCEPTION();
 
 void PARSE_TREE_NODE_RESERVATION_EXCEPTION();
+void PARSE_TREE_INVALID_NODE_EXCEPTION(char *problem);
 
 void SYNTAX_MISMATCH_EXCEPTION(char *value, char *awaited);
 
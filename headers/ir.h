@@ -0,0 +1,389 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef SPACE_IR_H_
+#define SPACE_IR_H_
+
+#include <stddef.h>
+#include <stdio.h>
+#include "../headers/parsetree.h"
+#include "../headers/semantic.h"
+
+//Used as register, if an instruction has no result or operand
+#define IR_NO_REGISTER -1
+
+/**
+ * <p>
+ * Opcodes of the intermediate representation.
+ * </p>
+ *
+ * <p>
+ * <strong>Operands</strong> (`dest`, `a`, `b`, `c` are the fields of the instruction):
+ * ```
+ * CONST_INT        dest = value.integer
+ * CONST_FLOAT      dest = value.floating
+ * CONST_STRING     dest = strings[a]
+ * MOVE             dest = a
+ * LOAD_GLOBAL      dest = globals[a]
+ * STORE_GLOBAL     globals[a] = b
+ * ADD ... GE       dest = a (op) b
+ * NEG, NOT         dest = (op) a
+ * CONVERT          dest = (type) a
+ * CALL             dest = functions[a](arguments[b] ... arguments[b + c - 1])
+ * CONCAT           dest = a + b (strings)
+ * BUILDER          dest = new builder with a copy of the string a
+ * APPEND           dest = a + b, appends b to the builder a in place (dest is a)
+ * NEW              dest = new object of classes[a]
+ * NEW_ARRAY        dest = new array with the lengths arguments[b] ... arguments[b + c - 1] (outermost first)
+ * LOAD_FIELD       dest = a.fields[b] (fields of classes[value.integer])
+ * STORE_FIELD      a.fields[b] = c (fields of classes[value.integer])
+ * LOAD_ELEMENT     dest = a[b] (value.integer is true, if b is proven to lie within a)
+ * STORE_ELEMENT    a[b] = c (value.integer as LOAD_ELEMENT)
+ * CALL_VIRTUAL     dest = method a of classes[value.integer], called on the object arguments[b] with
+ *                  arguments[b] ... arguments[b + c - 1] (the object is the first argument)
+ * CHECK_NULL       raise a null reference error, if a is null (the receiver of a devirtualized call)
+ * JUMP             goto block a
+ * BRANCH           if a goto block b else goto block c
+ * SWITCH           goto block cases[b + 1 + (a - value.integer)], if that is one of the c entries of the table,
+ *                  else goto block cases[b]
+ * RETURN           return a (IR_NO_REGISTER for void)
+ * RESUME           continue the unwinding of the caught runtime error
+ * ```
+ * </p>
+ *
+ * <p>
+ * Integer divisions (and modulo) and calls can raise a runtime error,
+ * the error continues in the landing pad of the block (see IRBlock).
+ * The string operations allocate, so they raise an error, once the
+ * memory is used up.
+ * </p>
+ *
+ * <p>
+ * The object and array instructions raise an error on a null reference,
+ * an index outside of the array or a negative array length, CHECK_NULL
+ * only on a null reference. The new
+ * objects and arrays start with the default values (0, 0.0, false, ""
+ * and null).
+ * </p>
+ *
+ * <p>
+ * The method of a virtual call is a vtable slot, if the static class is
+ * a class, and the index of the method in the interface, if it is an
+ * interface (see IRClass).
+ * </p>
+ *
+ * <p>
+ * A builder is a string, that is only held by a single register, so
+ * APPEND can change it without a copy. The builders are created by the
+ * loop optimizer for {@code s = s + x} in loops (see OPT_build_strings).
+ * </p>
+ */
+enum IROpcode {
+    IR_NOP,
+    IR_CONST_INT, IR_CONST_FLOAT, IR_CONST_STRING,
+    IR_MOVE, IR_LOAD_GLOBAL, IR_STORE_GLOBAL,
+    IR_ADD, IR_SUB, IR_MUL, IR_DIV, IR_MOD, IR_NEG,
+    IR_SHL, IR_SHR, IR_BIT_AND, IR_BIT_OR, IR_BIT_XOR, IR_NOT,
+    IR_EQ, IR_NE, IR_LT, IR_LE, IR_GT, IR_GE,
+    IR_CONVERT, IR_CALL, IR_CONCAT, IR_BUILDER, IR_APPEND,
+    IR_NEW, IR_NEW_ARRAY, IR_LOAD_FIELD, IR_STORE_FIELD,
+    IR_LOAD_ELEMENT, IR_STORE_ELEMENT, IR_CALL_VIRTUAL, IR_CHECK_NULL,
+
+    //Terminators, every block ends with exactly one of them
+    IR_JUMP, IR_BRANCH, IR_SWITCH, IR_RETURN, IR_RESUME,
+    IR_OPCODES
+};
+
+/**
+ * <p>
+ * A single three-address instruction.
+ * </p>
+ *
+ * <p>
+ * The type is the type of the result (or of the stored / returned
+ * value), the line refers to the source line of the lowered node.
+ * </p>
+ *
+ * <p>
+ * `origin` is the function, whose body the instruction was inlined
+ * from (-1 for the own instructions), so a runtime error still reports
+ * the function, that raised it.
+ * </p>
+ */
+struct IRInstruction {
+    enum IROpcode opcode;
+    enum VarType type;
+    int dest;
+    int a;
+    int b;
+    int c;
+
+    union {
+        long long integer;
+        double floating;
+    } value;
+
+    size_t line;
+    int origin;
+};
+
+/**
+ * <p>
+ * A basic block, that covers the instructions from `firstInstruction`
+ * up to `firstInstruction + instructionCount - 1`.
+ * </p>
+ *
+ * <p>
+ * The blocks of a function are stored in layout order, block 0 is the
+ * entry of the function.
+ * </p>
+ *
+ * <p>
+ * A runtime error in the block continues in the block `handler` (the
+ * landing pad of a try statement), with -1 it leaves the function.
+ * There are no instructions on the normal path, the landing pads are
+ * only reached by the exception tables of the bytecode.
+ * </p>
+ *
+ * <p>
+ * `frequency` is the number of executions in the profile run (see
+ * ProfileIR), 0 if the function wasn't profiled.
+ * </p>
+ */
+struct IRBlock {
+    size_t firstInstruction;
+    size_t instructionCount;
+    int handler;
+    size_t frequency;
+};
+
+/**
+ * <p>
+ * Describes the value of a reference (type CLASS_REF): an object or an
+ * array.
+ * </p>
+ *
+ * <p>
+ * An object has the dimension 0 and the index of its class in the
+ * module. An array has the type of its innermost elements and the
+ * number of dimensions (the elements of a 2D array are arrays), the
+ * class is the class of the innermost elements, if they are objects.
+ * The null constant has no class and no dimensions, it fits every
+ * reference (see IR_NO_REFERENCE).
+ * </p>
+ */
+struct IRReference {
+    enum VarType elementType;
+    int classIndex;
+    int dimension;
+};
+
+#define IR_NO_REFERENCE ((struct IRReference){null, -1, 0})
+
+/**
+ * <p>
+ * A virtual register. Variables keep their name, temporaries have
+ * no name (NULL).
+ * </p>
+ */
+struct IRRegister {
+    enum VarType type;
+    char *name;
+    struct IRReference reference;
+};
+
+/**
+ * <p>
+ * A lowered function.
+ * </p>
+ *
+ * <p>
+ * The parameters are the registers 0 up to `paramCount - 1`. All
+ * parts are flat arrays, that are indexed by the operands of the
+ * instructions.
+ * </p>
+ */
+struct IRFunction {
+    char *name;
+    enum VarType returnType;
+    struct IRReference returnReference;
+    int paramCount;
+    size_t line;
+
+    //Block, that receives the emitted instructions (while lowering)
+    int currentBlock;
+
+    //Landing pad of the blocks, that are started (while lowering)
+    int handler;
+
+    struct IRInstruction *instructions;
+    size_t instructionCount;
+    size_t instructionCapacity;
+
+    struct IRBlock *blocks;
+    size_t blockCount;
+    size_t blockCapacity;
+
+    struct IRRegister *registers;
+    size_t registerCount;
+    size_t registerCapacity;
+
+    //Registers of the call arguments and array lengths (see IR_CALL, IR_NEW_ARRAY)
+    int *arguments;
+    size_t argumentCount;
+    size_t argumentCapacity;
+
+    //Blocks of the switches, the default block followed by the table (see IR_SWITCH)
+    int *cases;
+    size_t caseCount;
+    size_t caseCapacity;
+};
+
+/**
+ * <p>
+ * A variable of the top level scope.
+ * </p>
+ */
+struct IRGlobal {
+    char *name;
+    enum VarType type;
+    struct IRReference reference;
+    int constant;
+};
+
+/**
+ * <p>
+ * A field of an object, `owner` is the class, that declares it.
+ * </p>
+ *
+ * <p>
+ * `offset` and `size` are the bytes of the field in the layout of the
+ * class (see ClassLayout), the pointer to the vtable is at offset 0.
+ * </p>
+ */
+struct IRField {
+    char *name;
+    enum VarType type;
+    struct IRReference reference;
+    int owner;
+    size_t offset;
+    size_t size;
+};
+
+/**
+ * <p>
+ * A class or an interface.
+ * </p>
+ *
+ * <p>
+ * The fields and the vtable follow the layout of the semantic analysis
+ * (see ClassLayout): the inherited fields come first, an override keeps
+ * the slot of the overridden method. `methods` holds the function of
+ * every vtable slot (-1 for an interface). The interface methods are
+ * numbered in one flat space, the methods of an interface start at
+ * `interfaceBase`; `interfaceSlots[n]` is the vtable slot of the
+ * interface method n (-1, if the class doesn't implement it).
+ * `size` is the size of an object in bytes (including the pointer to
+ * the vtable).
+ * </p>
+ */
+struct IRClass {
+    char *name;
+    int parent;
+    int isInterface;
+    size_t size;
+
+    struct IRField *fields;
+    size_t fieldCount;
+
+    int *methods;
+    size_t methodCount;
+
+    int *interfaces;
+    size_t interfaceCount;
+
+    int *interfaceSlots;
+    size_t interfaceSlotCount;
+    size_t interfaceBase;
+};
+
+/**
+ * <p>
+ * The lowered program.
+ * </p>
+ *
+ * <p>
+ * The statements of the top level scope are lowered into the function
+ * `<main>` (see `entryFunction`), which also initializes the globals.
+ * </p>
+ */
+struct IRModule {
+    struct IRFunction **functions;
+    size_t functionCount;
+    size_t functionCapacity;
+    int entryFunction;
+
+    struct IRGlobal *globals;
+    size_t globalCount;
+    size_t globalCapacity;
+
+    char **strings;
+    size_t stringCount;
+    size_t stringCapacity;
+
+    struct IRClass *classes;
+    size_t classCount;
+    size_t classCapacity;
+};
+
+extern const char *IR_OPCODE_NAMES[IR_OPCODES];
+
+struct IRModule *CreateNewIRModule();
+struct IRFunction *CreateNewIRFunction(struct IRModule *module, const char *name, enum VarType returnType, size_t line);
+int IR_add_global(struct IRModule *module, const char *name, enum VarType type, int constant);
+int IR_add_string(struct IRModule *module, const char *value);
+int IR_add_class(struct IRModule *module, const char *name, int isInterface);
+int IR_add_field(struct IRModule *module, int classIndex, const char *name, enum VarType type, struct IRReference reference, int owner, size_t offset, size_t size);
+int IR_is_subclass(struct IRModule *module, int classIndex, int baseIndex);
+int IR_add_register(struct IRFunction *function, enum VarType type, const char *name);
+int IR_add_block(struct IRFunction *function);
+void IR_start_block(struct IRFunction *function, int block);
+struct IRInstruction *IR_emit(struct IRFunction *function, enum IROpcode opcode, enum VarType type, int dest, int a, int b, int c, size_t line);
+int IR_add_arguments(struct IRFunction *function, int *registers, int count);
+int IR_add_cases(struct IRFunction *function, int *blocks, int count);
+int IR_is_terminator(enum IROpcode opcode);
+int IR_get_targets(struct IRFunction *function, struct IRInstruction *instruction, int **targets, int *buffer);
+int IR_can_raise(struct IRInstruction *instruction);
+int IR_is_block_terminated(struct IRFunction *function);
+void IR_finish_function(struct IRFunction *function);
+int IR_verify_module(struct IRModule *module);
+const char *IR_get_type_name(enum VarType type);
+void IR_dump_type(FILE *output, struct IRModule *module, enum VarType type, struct IRReference reference);
+void IR_dump_module(FILE *output, struct IRModule *module);
+size_t IR_count_instructions(struct IRModule *module);
+void FREE_IR_MODULE(struct IRModule *module);
+
+//IR generator, returns a PhaseStatus (the module is NULL, if the lowering failed)
+int GenerateIR(struct Node *root, struct SemanticTable *table, struct IRModule **module);
+
+#endif  // SPACE_IR_H_
@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPACE_JSON_H_
+#define SPACE_JSON_H_
+
+#include <stddef.h>
+
+enum JsonType {
+    JSON_NULL,
+    JSON_BOOLEAN,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+};
+
+/**
+ * <p>
+ * A parsed JSON value.
+ * </p>
+ *
+ * <p>
+ * Arrays and objects store their children in `items`, objects
+ * additionally hold the member names in `keys` (same index).
+ * </p>
+ */
+struct JsonValue {
+    enum JsonType type;
+    int boolean;
+    double number;
+    char *string;
+    size_t count;
+    char **keys;
+    struct JsonValue **items;
+};
+
+/**
+ * <p>
+ * Growable character buffer used to write JSON text.
+ * </p>
+ */
+struct JsonBuffer {
+    char *data;
+    size_t length;
+    size_t capacity;
+};
+
+struct JsonValue *JSON_parse(const char *text, size_t length);
+struct JsonValue *JSON_get_member(struct JsonValue *object, const char *key);
+char *JSON_get_string(struct JsonValue *object, const char *key);
+double JSON_get_number(struct JsonValue *object, const char *key, double fallback);
+void JSON_free_value(struct JsonValue *value);
+
+struct JsonBuffer *CreateNewJsonBuffer(size_t initialCapacity);
+void JSON_append_raw(struct JsonBuffer *buffer, const char *text, size_t length);
+void JSON_append_format(struct JsonBuffer *buffer, const char *format, ...);
+void JSON_append_string(struct JsonBuffer *buffer, const char *text);
+void JSON_append_value(struct JsonBuffer *buffer, struct JsonValue *value);
+void JSON_clear_buffer(struct JsonBuffer *buffer);
+void JSON_free_buffer(struct JsonBuffer *buffer);
+
+#endif  // SPACE_JSON_H_
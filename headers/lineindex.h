@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_LINE_INDEX_H_
+#define SPACE_LINE_INDEX_H_
+
+#include <stddef.h>
+
+/**
+ * <p>
+ * Holds the offsets of all line starts of a source buffer.
+ * </p>
+ *
+ * <p>
+ * The first entry is always 0, so a buffer without any newline
+ * has exactly one line.
+ * </p>
+ *
+ * <p>
+ * The lexer builds the index of the current file while counting
+ * the newlines (see {@code LINE_INDEX}), so the source doesn't
+ * have to be scanned again.
+ * </p>
+ */
+struct LineIndex {
+    size_t *starts;
+    size_t count;
+    size_t capacity;
+
+    /**
+     * <p>
+     * Length of the indexed buffer.
+     * </p>
+     */
+    size_t length;
+};
+
+/**
+ * <p>
+ * Position of an offset in the source, all values are 0-based.
+ * lineStart and lineEnd are the offsets of the line slice
+ * (lineEnd points to the newline or the end of the buffer).
+ * </p>
+ */
+struct SourceLocation {
+    size_t line;
+    size_t column;
+    size_t lineStart;
+    size_t lineEnd;
+};
+
+struct LineIndex *CreateNewLineIndex(const char *buffer, size_t length);
+void LI_add_line_start(struct LineIndex *index, size_t offset);
+struct SourceLocation LI_locate(struct LineIndex *index, size_t offset);
+size_t LI_get_line(struct LineIndex *index, size_t offset);
+size_t LI_get_line_start(struct LineIndex *index, size_t line);
+void FREE_LINE_INDEX(struct LineIndex *index);
+
+#endif  // SPACE_LINE_INDEX_H_
@@ -24,15 +24,23 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "../headers/Token.h"
 
+// A release build (-DSPACE_RELEASE) compiles the debug output of all phases out.
+// The dumps (--dump-tokens, --dump-ast, --dump-symbols, --dump-layout, --dump-ir, --dump-bytecode) and --emit-asm are selected at runtime.
+// Phase times are measured with --stats / --time-report (stats.h).
+#ifdef SPACE_RELEASE
+#define SPACE_DEBUG_OUTPUT 0
+#else
+#define SPACE_DEBUG_OUTPUT 1
+#endif
+
 // 1 = true; 0 = false
-#define LEXER_DEBUG_MODE 1
-#define LEXER_DISPLAY_USED_TIME 1
+#define LEXER_DEBUG_MODE SPACE_DEBUG_OUTPUT
 
-#define SYNTAX_ANALYZER_DEBUG_MODE 1
-#define SYNTAX_ANALYZER_DISPLAY_USED_TIME 1
+#define SYNTAX_ANALYZER_DEBUG_MODE SPACE_DEBUG_OUTPUT
 
-#define PARSETREE_GENERATOR_DEBUG_MODE 1
-#define PARSETREE_GENERATOR_DISPLAY_USED_TIME 1
+#define PARSETREE_GENERATOR_DEBUG_MODE SPACE_DEBUG_OUTPUT
+
+#define SEMANTIC_ANALYZER_DEBUG_MODE SPACE_DEBUG_OUTPUT
 
 //TERMINAL COLORS
 #define TEXT_COLOR_RED          "\033[38;2;230;70;70m"
@@ -55,6 +63,17 @@ int is_end_indicator(const TOKEN *token);
 int is_keyword(TOKEN *token);
 int predict_is_conditional_assignment_type(TOKEN **tokens, size_t startPos, int maxToks);
 
+/**
+ * <p>
+ * Status codes returned by the compiler phases.
+ * </p>
+ */
+enum PhaseStatus {
+    PHASE_SUCCESS = 0,      //No errors were found
+    PHASE_ERRORS = 1,       //Errors were reported, but the phase ran through
+    PHASE_ABORTED = 2       //A fatal error stopped the phase
+};
+
 //Input reader
 struct InputReaderResults {
     char *buffer;
@@ -64,16 +83,24 @@ struct InputReaderResults {
 };
 
 struct InputReaderResults ProcessInput(char *path);
+struct InputReaderResults ProcessBuffer(char *buffer, const size_t bufferLength);
 
-//Lexer
+//Lexer (NULL on fatal errors)
 TOKEN *Tokenize(int **arrayOfIndividualTokenSizes);
 
-//Parse
+//Parse (NULL on fatal errors)
 struct Node *GenerateParsetree(TOKEN **tokens);
 
 //int Check_syntax(TOKEN **tokens, size_t tokenArrayLength, char **buffer, size_t bufferSize);
 
+//Returns a PhaseStatus
 int CheckInput(TOKEN **tokens);
-int CheckSemantic(struct Node *root);
+
+//Semantic analysis, returns a PhaseStatus (if mainTable is NULL the symbol tables are freed after the check)
+struct SemanticTable;
+int CheckSemantic(struct Node *root, struct SemanticTable **mainTable);
+
+//Language server
+int RunLanguageServer();
 
 #endif
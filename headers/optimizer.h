@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+
+#ifndef SPACE_OPTIMIZER_H_
+#define SPACE_OPTIMIZER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../headers/ir.h"
+
+//Runs the passes on the verified module, returns a PhaseStatus (see docs/optimizer.md)
+int OptimizeIR(struct IRModule *module);
+
+//Passes, each one returns the number of changed instructions
+size_t OPT_devirtualize_calls(struct IRModule *module);
+size_t OPT_inline_functions(struct IRModule *module);
+size_t OPT_replace_objects(struct IRModule *module);
+size_t OPT_fold_constants(struct IRModule *module);
+size_t OPT_optimize_loops(struct IRModule *module);
+size_t OPT_layout_blocks(struct IRFunction *function);
+
+//Helpers of the passes
+int OPT_get_defined_register(struct IRInstruction *instruction);
+int OPT_is_pure(struct IRInstruction *instruction);
+int OPT_get_uses(struct IRFunction *function, struct IRInstruction *instruction, int **uses, int *buffer);
+size_t OPT_remove_dead_definitions(struct IRFunction *function);
+void OPT_compute_liveness(struct IRFunction *function, uint64_t *liveIn, uint64_t *liveOut, size_t words);
+int OPT_get_successors(struct IRFunction *function, size_t block, int *successors);
+int OPT_copy_cases(struct IRFunction *function, struct IRFunction *source, struct IRInstruction *instruction, int *map);
+void OPT_compact_function(struct IRFunction *function);
+void OPT_merge_blocks(struct IRFunction *function);
+long long OPT_wrap_integer(enum VarType type, long long value);
+
+#endif  // SPACE_OPTIMIZER_H_
@@ -129,6 +129,14 @@ typedef struct Node {
     struct Node *rightNode;
 
     int reservedValue;
+
+    /**
+     * <p>
+     * Set by the semantic analysis on an array access, whose index always
+     * lies within the array (the lowering leaves out the bounds check)
+     * </p>
+     */
+    int provenIndex;
 } Node;
 
 int FREE_NODE(Node *node);
@@ -64,8 +64,84 @@ typedef struct SemanticEntry {
     void *reference;
     size_t line;
     size_t position;
+    size_t uses;
+    //Set for class instances, that never leave the runnable of their declaration
+    int scoped;
 } SemanticEntry;
 
+/**
+ * <p>
+ * Field of an object at a fixed offset (in bytes) from the start of
+ * the object (see ClassLayout).
+ * </p>
+ */
+struct LayoutField {
+    SemanticEntry *entry;
+    //Class, that declares the field
+    struct SemanticTable *owner;
+    size_t offset;
+    size_t size;
+    //Objects, strings and arrays (pointers for the garbage collector)
+    int reference;
+};
+
+/**
+ * <p>
+ * Method in a slot of a vtable or an interface.
+ * </p>
+ */
+struct LayoutMethod {
+    SemanticEntry *entry;
+    //Class (or interface), that declares the method
+    struct SemanticTable *owner;
+};
+
+/**
+ * <p>
+ * Runtime layout of a class or interface (see classLayout.c).
+ * </p>
+ *
+ * <p>
+ * An object starts with the pointer to the vtable of its class,
+ * followed by the fields. The inherited fields keep the offsets of the
+ * parent class, so an object can always be used as its parent. A
+ * virtual call loads the method from a fixed slot of the vtable.
+ * </p>
+ *
+ * <p>
+ * The interface slots are placed in front of the vtable, interface slot
+ * {@code i} is at {@code vtable[-1 - i]}. Every interface gets a fixed
+ * range of slots ({@code interfaceBase}), that doesn't overlap with
+ * other interfaces of the same class, so a call through an interface is
+ * a single load as well. Interfaces only use {@code methods} and
+ * {@code interfaceBase}.
+ * </p>
+ */
+struct ClassLayout {
+    struct SemanticTable *parent;
+    struct LayoutField *fields;
+    size_t fieldCount;
+    size_t size;
+    size_t alignment;
+    //End of the last field (the fields of a subclass can start in the padding)
+    size_t dataSize;
+    //Size with the fields in the order of their declaration
+    size_t declaredSize;
+
+    //Slots of the vtable
+    struct LayoutMethod *methods;
+    size_t methodCount;
+
+    //Implemented interfaces (including the ones of the parents)
+    struct SemanticTable **interfaces;
+    size_t interfaceCount;
+
+    //Slot of the vtable for every interface slot (-1 = not used)
+    int *interfaceSlots;
+    size_t interfaceSlotCount;
+    size_t interfaceBase;
+};
+
 typedef struct SemanticTable {
     struct List *paramList;
     struct HashMap *symbolTable;
@@ -74,6 +150,8 @@ typedef struct SemanticTable {
     char *name;
     size_t line;
     size_t position;
+    //Layout of classes and interfaces, NULL for all other tables or if the analysis failed
+    struct ClassLayout *layout;
 } SemanticTable;
 
 typedef struct ExternalEntry {
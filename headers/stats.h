@@ -0,0 +1,143 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_STATS_H_
+#define SPACE_STATS_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * <p>
+ * Measured phases of the compiler.
+ * </p>
+ *
+ * <p>
+ * STATS_OPTIMIZE covers the passes on the IR (skipped with
+ * {@code --no-optimize}), STATS_PROFILE is the counted run, that orders
+ * the blocks ({@code --profile}), STATS_CODEGEN is the generation of the
+ * assembly ({@code --emit-asm}), STATS_RUN is the execution of the program in the virtual machine
+ * ({@code --run}).
+ * </p>
+ */
+enum StatsPhase {
+    STATS_INPUT,
+    STATS_LEXER,
+    STATS_SYNTAX,
+    STATS_PARSETREE,
+    STATS_SEMANTIC,
+    STATS_IR,
+    STATS_OPTIMIZE,
+    STATS_PROFILE,
+    STATS_BYTECODE,
+    STATS_CODEGEN,
+    STATS_RUN,
+    STATS_PHASES
+};
+
+/**
+ * <p>
+ * Counters, that are collected while compiling.
+ * </p>
+ *
+ * <p>
+ * COUNTER_BYTES_ALLOCATED covers the compiler's own data structures
+ * (buffer, tokens, nodes, hash maps, lists and symbol tables).
+ * </p>
+ */
+enum StatsCounter {
+    COUNTER_FILES,
+    COUNTER_SOURCE_BYTES,
+    COUNTER_LINES,
+    COUNTER_TOKENS,
+    COUNTER_NODES,
+    COUNTER_HASHMAP_LOOKUPS,
+    COUNTER_HASHMAP_COLLISIONS,
+    COUNTER_HASHMAP_RESIZES,
+    COUNTER_SCOPE_TABLES,
+    COUNTER_DEAD_STATEMENTS,
+    COUNTER_PROVEN_INDICES,
+    COUNTER_SCOPED_INSTANCES,
+    COUNTER_SAVED_PADDING,
+    COUNTER_IR_INSTRUCTIONS,
+    COUNTER_JUMP_TABLES,
+    COUNTER_DEVIRTUALIZED_CALLS,
+    COUNTER_INLINED_CALLS,
+    COUNTER_REPLACED_OBJECTS,
+    COUNTER_FOLDED_CONSTANTS,
+    COUNTER_LOOP_OPTIMIZATIONS,
+    COUNTER_MOVED_BLOCKS,
+    COUNTER_VM_INSTRUCTIONS,
+    COUNTER_JIT_FUNCTIONS,
+    COUNTER_DEOPTIMIZATIONS,
+    COUNTER_COLLECTIONS,
+    COUNTER_ASM_INSTRUCTIONS,
+    COUNTER_SPILLS,
+    COUNTER_BYTES_ALLOCATED,
+    STATS_COUNTERS
+};
+
+enum StatsFormat {
+    STATS_FORMAT_TABLE,
+    STATS_FORMAT_JSON
+};
+
+struct PhaseTime {
+    double wallTime;
+    double cpuTime;
+    size_t runs;
+
+    //Start of the running measurement
+    double wallStart;
+    double cpuStart;
+};
+
+/**
+ * <p>
+ * Times and counters of all compiled files.
+ * </p>
+ *
+ * <p>
+ * Every thread has its own stats (the reader thread of the language
+ * server uses hash maps, while the worker compiles), so counting
+ * doesn't need any synchronization. The report covers the calling thread.
+ * </p>
+ */
+struct CompilerStats {
+    struct PhaseTime phases[STATS_PHASES];
+    size_t counters[STATS_COUNTERS];
+};
+
+extern _Thread_local struct CompilerStats STATS;
+extern const char *STATS_PHASE_NAMES[STATS_PHASES];
+extern const char *STATS_COUNTER_NAMES[STATS_COUNTERS];
+
+void ST_reset();
+void ST_start_phase(enum StatsPhase phase);
+void ST_end_phase(enum StatsPhase phase);
+void ST_count(enum StatsCounter counter, size_t amount);
+size_t ST_get_peak_rss();
+double ST_get_wall_time();
+int ST_parse_format(const char *name, enum StatsFormat *format);
+void ST_write_report(FILE *output, enum StatsFormat format, int withCounters);
+
+#endif  // SPACE_STATS_H_
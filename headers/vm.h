@@ -0,0 +1,562 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SPACE_VM_H_
+#define SPACE_VM_H_
+
+#include <stddef.h>
+#include <stdio.h>
+#include "../headers/parsetree.h"
+#include "../headers/semantic.h"
+#include "../headers/ir.h"
+
+//Registers of all active frames (in values)
+#define VM_STACK_SIZE (256 * 1024)
+
+//Maximum call depth
+#define VM_MAX_FRAMES 8192
+
+/**
+ * <p>
+ * The interpreter is direct-threaded (computed goto), if the compiler
+ * supports it, otherwise it dispatches with a switch.
+ * Define SPACE_VM_SWITCH to force the switch dispatch.
+ * </p>
+ */
+#if defined(__GNUC__) && !defined(SPACE_VM_SWITCH)
+#define VM_THREADED_DISPATCH 1
+#else
+#define VM_THREADED_DISPATCH 0
+#endif
+
+/**
+ * <p>
+ * Hot functions are compiled into x86-64 machine code (see jit.c), if the
+ * VM runs on x86-64 Linux or macOS. Define SPACE_NO_JIT to only interpret.
+ * </p>
+ *
+ * <p>
+ * A function is compiled after `VM_JIT_CALL_THRESHOLD` calls or
+ * `VM_JIT_BACK_EDGE_THRESHOLD` jumps backwards (iterations of its loops).
+ * After `VM_JIT_MAX_DEOPTIMIZATIONS` failed guards its code is dropped.
+ * </p>
+ */
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__)) && !defined(SPACE_NO_JIT)
+#define VM_JIT_SUPPORTED 1
+#else
+#define VM_JIT_SUPPORTED 0
+#endif
+
+#define VM_JIT_CALL_THRESHOLD 100
+#define VM_JIT_BACK_EDGE_THRESHOLD 1000
+#define VM_JIT_MAX_DEOPTIMIZATIONS 16
+
+/**
+ * <p>
+ * Opcodes of the bytecode.
+ * </p>
+ *
+ * <p>
+ * <strong>Operands</strong> (`dest`, `a`, `b`, `c` are the fields of the instruction,
+ * R[x] is a register of the frame):
+ * ```
+ * LOAD_INT             R[dest] = a
+ * LOAD_CONST           R[dest] = constants[a]
+ * MOVE                 R[dest] = R[a]
+ * LOAD_GLOBAL          R[dest] = globals[a]
+ * STORE_GLOBAL         globals[a] = R[b]
+ * ADD_INT ... GE_DOUBLE    R[dest] = R[a] (op) R[b]
+ * ADD_INT32 ... MUL_INT32  R[dest] = R[a] (op) R[b], cut to 32 bits
+ * NEG_*, NOT, TO_*     R[dest] = (op) R[a]
+ * CONCAT               R[dest] = R[a] + R[b] (strings)
+ * BUILDER              R[dest] = new builder with a copy of R[a]
+ * APPEND               R[dest] += R[b], in place, if R[dest] is a builder with enough space
+ * NEW                  R[dest] = new object of classes[a]
+ * NEW_ARRAY            R[dest] = new array with the lengths R[arguments[b]] ... R[arguments[b + c - 1]],
+ *                      the innermost elements have the type a
+ * LOAD_FIELD(_*)       R[dest] = the field at the byte b of R[a] (8 bytes, _INT, _FLOAT 4, _SHORT 2, _CHAR 1)
+ * STORE_FIELD(_*)      the field at the byte b of R[a] = R[c] (_REF for a reference, it runs the write barrier)
+ * LOAD_ELEMENT(_U)     R[dest] = R[a][R[b]] (_U without the bounds check, the index is proven)
+ * STORE_ELEMENT(_U)    R[a][R[b]] = R[c]
+ * CHECK_NULL           raise a null reference error, if R[a] is null
+ * CALL                 R[dest] = functions[a](R[arguments[b]] ... R[arguments[b + c - 1]])
+ * CALL_VIRTUAL         R[dest] = vtable[a] of the class of R[arguments[b]] (same arguments as CALL)
+ * CALL_INTERFACE       R[dest] = vtable[interfaceSlots[a]] of the class of R[arguments[b]]
+ * JUMP                 goto a
+ * JUMP_IF_TRUE/FALSE   if (R[a] == true/false) goto b
+ * BRANCH               if R[a] goto b else goto c
+ * SWITCH               goto cases[b + 1 + (R[a] - constants[dest])], if that is one of the c entries
+ *                      of the table, else goto cases[b]
+ * RETURN               return R[a]
+ * RETURN_VOID          return
+ * RESUME               raise the caught runtime error again
+ * COUNT                blockCounts[a]++ (only in profiled programs, see ProfileIR)
+ * ```
+ * Jump targets are indices into the code of the function.
+ * </p>
+ *
+ * <p>
+ * Integral values (int, long, short, char, boolean) are held as long long,
+ * floating values (double, float) as double. Conversions into a smaller
+ * type (TO_INT, TO_SHORT, TO_CHAR, TO_FLOAT) cut the value to that type.
+ * The results of the arithmetic on int, short and char are cut as well
+ * (by the _INT32 instructions or a TO_* behind the operation), so they
+ * wrap around at the width of their type.
+ * Strings are references (see strings.c), the string operations allocate
+ * and raise an error, if the heap is full.
+ * </p>
+ *
+ * <p>
+ * Objects and arrays are references as well (see VMClass). The object
+ * and array instructions raise an error on a null reference, an index
+ * outside of the array and a negative array length. A field keeps the
+ * size of its type, a stored value is cut to it like by TO_*.
+ * </p>
+ */
+enum VMOpcode {
+    VM_LOAD_INT, VM_LOAD_CONST, VM_MOVE, VM_LOAD_GLOBAL, VM_STORE_GLOBAL,
+    VM_ADD_INT, VM_SUB_INT, VM_MUL_INT, VM_DIV_INT, VM_MOD_INT, VM_NEG_INT,
+    VM_ADD_INT32, VM_SUB_INT32, VM_MUL_INT32,
+    VM_SHL, VM_SHR, VM_BIT_AND, VM_BIT_OR, VM_BIT_XOR, VM_NOT,
+    VM_ADD_DOUBLE, VM_SUB_DOUBLE, VM_MUL_DOUBLE, VM_DIV_DOUBLE, VM_MOD_DOUBLE, VM_NEG_DOUBLE,
+    VM_EQ_INT, VM_NE_INT, VM_LT_INT, VM_LE_INT, VM_GT_INT, VM_GE_INT,
+    VM_EQ_DOUBLE, VM_NE_DOUBLE, VM_LT_DOUBLE, VM_LE_DOUBLE, VM_GT_DOUBLE, VM_GE_DOUBLE,
+    VM_INT_TO_DOUBLE, VM_DOUBLE_TO_INT, VM_TO_INT, VM_TO_SHORT, VM_TO_CHAR, VM_TO_FLOAT,
+    VM_CONCAT, VM_BUILDER, VM_APPEND,
+    VM_NEW, VM_NEW_ARRAY,
+    VM_LOAD_FIELD, VM_LOAD_FIELD_INT, VM_LOAD_FIELD_SHORT, VM_LOAD_FIELD_CHAR, VM_LOAD_FIELD_FLOAT,
+    VM_STORE_FIELD, VM_STORE_FIELD_INT, VM_STORE_FIELD_SHORT, VM_STORE_FIELD_CHAR, VM_STORE_FIELD_FLOAT, VM_STORE_FIELD_REF,
+    VM_LOAD_ELEMENT, VM_LOAD_ELEMENT_UNCHECKED, VM_STORE_ELEMENT, VM_STORE_ELEMENT_UNCHECKED, VM_CHECK_NULL,
+    VM_CALL, VM_CALL_VIRTUAL, VM_CALL_INTERFACE, VM_JUMP, VM_JUMP_IF_TRUE, VM_JUMP_IF_FALSE, VM_BRANCH, VM_SWITCH, VM_RETURN, VM_RETURN_VOID,
+    VM_RESUME, VM_COUNT, VM_OPCODES
+};
+
+struct VMObject;
+
+union VMValue {
+    long long integer;
+    double floating;
+    struct VMObject *object;
+};
+
+/**
+ * <p>
+ * A single register instruction.
+ * </p>
+ *
+ * <p>
+ * The `handler` is the address of the opcode's implementation in the
+ * interpreter, it is set by the VM before the first run (threaded code).
+ * </p>
+ */
+struct VMInstruction {
+    const void *handler;
+    enum VMOpcode opcode;
+    int dest;
+    int a;
+    int b;
+    int c;
+};
+
+/**
+ * <p>
+ * Entry of the exception table of a function: a runtime error of an
+ * instruction in the range [start, end) continues at the landing pad.
+ * </p>
+ */
+struct VMExceptionRange {
+    size_t start;
+    size_t end;
+    size_t landingPad;
+};
+
+/**
+ * <p>
+ * Tier of a function: interpreted until it gets hot, then compiled.
+ * A function, that couldn't be compiled or whose code was dropped, is
+ * interpreted for the rest of the run.
+ * </p>
+ */
+enum VMJitState {
+    VM_JIT_INTERPRETED,
+    VM_JIT_COMPILED,
+    VM_JIT_FAILED,
+    VM_JIT_INVALIDATED
+};
+
+/**
+ * <p>
+ * A function of the bytecode with its own constant pool.
+ * </p>
+ *
+ * <p>
+ * The parameters are the registers 0 up to paramCount - 1, the frame of
+ * the function holds `registerCount` registers.
+ * </p>
+ */
+struct VMFunction {
+    char *name;
+    enum VarType returnType;
+    int paramCount;
+    int registerCount;
+
+    struct VMInstruction *code;
+    size_t codeLength;
+    size_t codeCapacity;
+
+    //Source line of every instruction and the IR function, that it was inlined from (-1 = none, for the runtime errors)
+    size_t *lines;
+    int *origins;
+
+    union VMValue *constants;
+    enum VarType *constantTypes;
+    size_t constantCount;
+    size_t constantCapacity;
+
+    //Registers of the call arguments (see VM_CALL)
+    int *arguments;
+    size_t argumentCount;
+
+    //Targets of the switches, the default followed by the table (see VM_SWITCH)
+    int *cases;
+    size_t caseCount;
+    size_t caseCapacity;
+
+    //Registers, that hold references (the stack map of every safepoint)
+    int *references;
+    int referenceCount;
+
+    //Ranges of the try statements (in the order of the code)
+    struct VMExceptionRange *exceptionRanges;
+    size_t exceptionRangeCount;
+
+    //Executions of every IR block (see VM_COUNT), NULL if the program isn't profiled
+    size_t *blockCounts;
+    size_t blockCount;
+
+    //Counters of the tiering and the compiled code (see jit.c), the entries are the offsets of the
+    //instructions (0, if the code would leave again after a few instructions)
+    size_t calls;
+    size_t backEdges;
+    size_t deoptimizations;
+    enum VMJitState jitState;
+    unsigned char *nativeCode;
+    size_t nativeSize;
+    size_t *nativeEntries;
+};
+
+struct VMGlobal {
+    char *name;
+    enum VarType type;
+};
+
+//The layouts start with the pointer to the vtable, the VM keeps the class in the header of the object instead
+#define VM_LAYOUT_HEADER_SIZE 8
+
+/**
+ * <p>
+ * A field of a class: its byte in the slots of the object, its size
+ * and its type.
+ * </p>
+ */
+struct VMField {
+    size_t offset;
+    size_t size;
+    enum VarType type;
+};
+
+/**
+ * <p>
+ * A class of the program (see IRClass).
+ * </p>
+ *
+ * <p>
+ * The fields are packed like in the layout of the semantic analysis
+ * (see ClassLayout), without the pointer to the vtable, so the slots
+ * of an object hold the bytes of the layout from
+ * `VM_LAYOUT_HEADER_SIZE` on. `fields` is indexed by the field index
+ * of the IRClass, the inherited fields keep the offsets of the parent.
+ * The references are aligned to 8 bytes, so every reference fills a
+ * slot. They can lie between the other fields, the collections visit
+ * the slots in `referenceSlots` (instead of the leading slots).
+ * `interfaceSlots[n]` is the vtable slot of the interface method n, the
+ * methods of an interface start at `interfaceBase`.
+ * </p>
+ */
+struct VMClass {
+    char *name;
+    int isInterface;
+    size_t interfaceBase;
+    size_t slotCount;
+
+    struct VMField *fields;
+    size_t fieldCount;
+
+    int *referenceSlots;
+    size_t referenceCount;
+
+    int *vtable;
+    size_t methodCount;
+
+    int *interfaceSlots;
+    size_t interfaceSlotCount;
+};
+
+/**
+ * <p>
+ * A whole program, that was translated from an IRModule.
+ * </p>
+ *
+ * <p>
+ * The strings are the values of the string literals: short ones are
+ * small strings, the others point into the string segment, which holds
+ * them as flat strings (see strings.c). The segment is owned by the
+ * program and never written while running.
+ * </p>
+ */
+struct VMProgram {
+    struct VMFunction *functions;
+    size_t functionCount;
+    int entryFunction;
+
+    struct VMGlobal *globals;
+    size_t globalCount;
+
+    struct VMClass *classes;
+    size_t classCount;
+
+    union VMValue *strings;
+    size_t stringCount;
+    unsigned char *stringSegment;
+    size_t stringSegmentSize;
+
+    //Whether the handlers of the instructions are set
+    int threaded;
+
+    //Whether hot functions are compiled into machine code (see jit.c)
+    int jit;
+};
+
+/**
+ * <p>
+ * Frame of an active call.
+ * </p>
+ *
+ * <p>
+ * The registers of the frames lie directly behind each other on the
+ * stack of the VM, so a call doesn't allocate any memory.
+ * </p>
+ */
+struct VMFrame {
+    struct VMFunction *function;
+    struct VMInstruction *returnAddress;
+    union VMValue *registers;
+
+    //Register of the caller, that receives the return value
+    int result;
+};
+
+/**
+ * <p>
+ * Sizes of the garbage collected heap (in bytes). The old generation
+ * starts with `VM_OLD_GENERATION_SIZE` and grows, until the nursery and
+ * the old generation reach the maximum size of the heap.
+ * </p>
+ */
+#define VM_NURSERY_SIZE (512 * 1024)
+#define VM_OLD_GENERATION_SIZE (1024 * 1024)
+#define VM_MAX_HEAP_SIZE ((size_t)256 * 1024 * 1024)
+
+//Objects larger than this are allocated in the old generation directly
+#define VM_LARGE_OBJECT_SIZE (VM_NURSERY_SIZE / 8)
+
+#define VM_OBJECT_MARKED 1
+#define VM_OBJECT_REMEMBERED 2
+
+//A flat string, that may be appended in place (kept by the collections)
+#define VM_OBJECT_BUILDER 4
+
+#define VM_OBJECT_SIZE(slotCount) (sizeof(struct VMObject) + (size_t)(slotCount) * sizeof(union VMValue))
+
+/**
+ * <p>
+ * Header of an object on the heap, followed by its slots.
+ * </p>
+ *
+ * <p>
+ * The first `referenceCount` slots hold references (objects or NULL),
+ * the others plain values. An instance of a class has the index of its
+ * class in `classId` and its references in the slots of the class (see
+ * VMClass), strings and arrays have the class -1. The length of an
+ * array is its number of slots. `forward` is the new address of the
+ * object, while it's moved by a collection.
+ * </p>
+ */
+struct VMObject {
+    struct VMObject *forward;
+    unsigned int slotCount;
+    unsigned int referenceCount;
+    int flags;
+    int classId;
+    union VMValue slots[];
+};
+
+/**
+ * <p>
+ * Generational heap of the VM.
+ * </p>
+ *
+ * <p>
+ * New objects are bump-allocated in the nursery. A minor collection
+ * copies the reachable objects of the nursery into the old generation,
+ * which is collected by mark-compact, once it's full. The roots are the
+ * reference registers of the frames (see VMFunction), the reference
+ * globals, the registered roots and the remembered old objects, which
+ * point into the nursery (see VM_heap_write).
+ * </p>
+ */
+struct VMHeap {
+    unsigned char *nursery;
+    size_t nurseryTop;
+    size_t nurserySize;
+
+    unsigned char *old;
+    size_t oldTop;
+    size_t oldSize;
+    size_t maxSize;
+
+    struct VMObject **remembered;
+    size_t rememberedCount;
+    size_t rememberedCapacity;
+
+    //Roots outside of the VM (e.g. objects of native code)
+    union VMValue **roots;
+    size_t rootCount;
+    size_t rootCapacity;
+
+    //Marked objects, whose references aren't visited yet
+    struct VMObject **markStack;
+    size_t markCount;
+    size_t markCapacity;
+
+    //Machine, whose frames and globals are roots (can be NULL)
+    struct VirtualMachine *machine;
+
+    size_t minorCollections;
+    size_t majorCollections;
+    size_t allocatedBytes;
+    size_t promotedBytes;
+    double pauseTime;
+    double maxPause;
+};
+
+struct VirtualMachine {
+    struct VMProgram *program;
+    union VMValue *globals;
+
+    union VMValue *stack;
+    size_t stackSize;
+
+    struct VMFrame *frames;
+    size_t maxFrames;
+
+    //Created by the first allocation
+    struct VMHeap *heap;
+
+    //Innermost frame, set by the interpreter before it enters the heap (safepoint)
+    struct VMFrame *activeFrame;
+
+    //Instructions executed by all runs
+    size_t executedInstructions;
+};
+
+extern const char *VM_OPCODE_NAMES[VM_OPCODES];
+
+//Bytecode generator, returns a PhaseStatus (the program is NULL, if the translation failed)
+int GenerateBytecode(struct IRModule *module, struct VMProgram **program);
+int VM_generate_program(struct IRModule *module, struct VMProgram **program, int profiled);
+void VM_dump_program(FILE *output, struct VMProgram *program);
+int VM_is_reference_type(enum VarType type);
+size_t VM_count_instructions(struct VMProgram *program);
+void FREE_VM_PROGRAM(struct VMProgram *program);
+
+struct VirtualMachine *CreateNewVirtualMachine(struct VMProgram *program);
+int VM_run(struct VirtualMachine *machine, union VMValue *result);
+void VM_dump_globals(FILE *output, struct VirtualMachine *machine);
+void FREE_VIRTUAL_MACHINE(struct VirtualMachine *machine);
+
+struct VMHeap *CreateNewVMHeap(size_t maxSize);
+struct VMObject *VM_heap_allocate(struct VMHeap *heap, size_t slotCount, size_t referenceCount);
+struct VMObject *VM_allocate_object(struct VirtualMachine *machine, size_t slotCount, size_t referenceCount);
+int VM_heap_write(struct VMHeap *heap, struct VMObject *object, size_t slot, union VMValue value);
+int VM_write_barrier(struct VMHeap *heap, struct VMObject *object, struct VMObject *value);
+int VM_heap_push_root(struct VMHeap *heap, union VMValue *root);
+void VM_heap_pop_roots(struct VMHeap *heap, size_t count);
+int VM_collect_garbage(struct VMHeap *heap, int full);
+void FREE_VM_HEAP(struct VMHeap *heap);
+
+/**
+ * <p>
+ * Strings of the VM (see strings.c).
+ * </p>
+ *
+ * <p>
+ * Strings up to `VM_SMALL_STRING_LENGTH` chars are held in the value
+ * itself (small strings, the lowest bit is set), longer ones are
+ * objects: a flat string holds its length and its chars, a rope the two
+ * concatenated strings. Concatenations of at least `VM_ROPE_MIN_LENGTH`
+ * chars become ropes, a rope deeper than `VM_MAX_ROPE_DEPTH` is flattened.
+ * </p>
+ */
+#define VM_SMALL_STRING_LENGTH 7
+#define VM_ROPE_MIN_LENGTH 64
+#define VM_MAX_ROPE_DEPTH 48
+
+//Slots of a flat string with `length` chars (the length and the chars with the terminating 0)
+#define VM_FLAT_STRING_SLOTS(length) (1 + ((size_t)(length) + sizeof(union VMValue)) / sizeof(union VMValue))
+
+union VMValue VM_create_small_string(const char *chars, size_t length);
+void VM_init_flat_string(struct VMObject *object, const char *chars, size_t length);
+int VM_is_small_string(union VMValue value);
+size_t VM_string_length(union VMValue value);
+size_t VM_copy_string(union VMValue value, char *buffer);
+void VM_write_string(FILE *output, union VMValue value);
+int VM_concat_strings(struct VirtualMachine *machine, union VMValue *a, union VMValue *b, union VMValue *result);
+int VM_create_builder(struct VirtualMachine *machine, union VMValue *a, union VMValue *result);
+int VM_append_string(struct VirtualMachine *machine, union VMValue *builder, union VMValue *b);
+
+//Objects and arrays (see objects.c)
+int VM_create_object(struct VirtualMachine *machine, int classId, union VMValue *result);
+int VM_create_array(struct VirtualMachine *machine, union VMValue *registers, int *lengths, int count, enum VarType elementType, union VMValue *result);
+
+//Baseline JIT (see jit.c)
+int VM_jit_compile(struct VMFunction *function);
+size_t VM_jit_execute(struct VMFunction *function, union VMValue *registers, union VMValue *globals, size_t index);
+void VM_jit_invalidate(struct VMFunction *function);
+
+//Runs the entry function of a program and writes the globals afterwards (NULL = no output), returns a PhaseStatus
+int RunProgram(struct VMProgram *program, FILE *output);
+
+//Runs the module once and orders its blocks by the counted executions, returns a PhaseStatus
+int ProfileIR(struct IRModule *module);
+
+#endif  // SPACE_VM_H_
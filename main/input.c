@@ -25,6 +25,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <ctype.h>
 #include "../headers/modules.h"
 #include "../headers/errors.h"
+#include "../headers/stats.h"
 
 #define true 1
 #define false 0
@@ -45,17 +46,35 @@ int check_double_operator(char currentInputChar, char NextInputChar);
 int is_correct_pointer(char **buffer, size_t currentBufferCharPos, const size_t maxSize);
 int skip_buffer_comment(char **buffer, size_t currentPos, size_t bufferLength, char crucialChar);
 
+extern int alreadyFreedBuffer;
+extern int alreadyFreedTokenSizes;
+
 /*
 Purpose: Read in the source files to compile, then read in the grammar file and tokenize the whole input
-Return Type: int
-Params: NULL
+Return Type: struct InputReaderResults => Buffer, predicted token sizes and token count (buffer is NULL on IO errors)
+Params: char *path => Path to the source file
 */
 char *INPUT_BUFFER = NULL;
 int *ARRAY_OF_INDIVIDUAL_TOKEN_SIZES = NULL;
 
 struct InputReaderResults ProcessInput(char *path) {
+	struct InputReaderResults failed = {NULL, NULL, 0, 0};
+	FILE *volatile filePointer = NULL;
+	jmp_buf recoveryPoint;
+
+	//IO errors return here, the result has no buffer then
+	if (setjmp(recoveryPoint) != 0) {
+		if (filePointer != NULL) {
+			(void)fclose(filePointer);
+		}
+
+		return failed;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+
 	//File to read
-	FILE *filePointer = (FILE*)fopen(path, "r");
+	filePointer = (FILE*)fopen(path, "r");
 
 	(void)check_file_pointer(filePointer, path);
 	
@@ -64,29 +83,61 @@ struct InputReaderResults ProcessInput(char *path) {
 	(void)check_file_length(fileLength, path);
 
 	//Character buffer for all input symbols
-	(void)reserve_buffer(fileLength, &INPUT_BUFFER);
-	(void)reserve_token_lengths(fileLength, &ARRAY_OF_INDIVIDUAL_TOKEN_SIZES);
-	(void)_init_error_buffer_cache_(&INPUT_BUFFER);
-	(void)_init_error_token_size_cache_(&ARRAY_OF_INDIVIDUAL_TOKEN_SIZES);
+	char *buffer = NULL;
+	(void)reserve_buffer(fileLength, &buffer);
 
 	//Go back to the start of the file
 	(void)rewind(filePointer);
 
 	//Read the contents of the file into the buffer
-	(void)fread(INPUT_BUFFER, sizeof(char), fileLength, filePointer);
-	int requiredTokenLength = (int)get_minimum_token_number(&INPUT_BUFFER, &ARRAY_OF_INDIVIDUAL_TOKEN_SIZES, fileLength);
+	(void)fread(buffer, sizeof(char), fileLength, filePointer);
+
+	FILE *closingPointer = filePointer;
+	filePointer = NULL;
 
-	if (fclose(filePointer) == EOF) {
+	if (fclose(closingPointer) == EOF) {
+		(void)free(buffer);
 		(void)IO_FILE_CLOSING_EXCEPTION();
 	}
 
+	(void)_init_error_recovery_point_(NULL);
+	return ProcessBuffer(buffer, fileLength);
+}
+
+/*
+Purpose: Prepare an already loaded source for the lexer (used for files and in-memory documents)
+Return Type: struct InputReaderResults => Buffer, predicted token sizes and token count (buffer is NULL on errors)
+Params: char *buffer => Heap buffer with the source, terminated with '\0' (ownership is taken);
+		const size_t bufferLength => Length of the source without the terminator
+*/
+struct InputReaderResults ProcessBuffer(char *buffer, const size_t bufferLength) {
+	struct InputReaderResults failed = {NULL, NULL, 0, 0};
+	jmp_buf recoveryPoint;
+
+	if (setjmp(recoveryPoint) != 0) {
+		return failed;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	INPUT_BUFFER = buffer;
+	ARRAY_OF_INDIVIDUAL_TOKEN_SIZES = NULL;
+	alreadyFreedBuffer = false;
+	alreadyFreedTokenSizes = false;
+
+	(void)reserve_token_lengths(bufferLength, &ARRAY_OF_INDIVIDUAL_TOKEN_SIZES);
+	(void)_init_error_buffer_cache_(&INPUT_BUFFER);
+	(void)_init_error_token_size_cache_(&ARRAY_OF_INDIVIDUAL_TOKEN_SIZES);
+
+	int requiredTokenLength = (int)get_minimum_token_number(&INPUT_BUFFER, &ARRAY_OF_INDIVIDUAL_TOKEN_SIZES, bufferLength);
+
 	//Create and return the results
 	struct InputReaderResults result;
 	result.buffer = INPUT_BUFFER;
 	result.arrayOfIndividualTokenSizes = ARRAY_OF_INDIVIDUAL_TOKEN_SIZES;
 	result.requiredTokenNumber = requiredTokenLength;
-	result.fileLength = fileLength;
+	result.fileLength = bufferLength;
 
+	(void)_init_error_recovery_point_(NULL);
 	return result;
 }
 
@@ -129,6 +180,7 @@ void reserve_buffer(const size_t fileLength, char **buffer) {
 		}
 
 		(*buffer)[fileLength] = '\0';
+		(void)ST_count(COUNTER_BYTES_ALLOCATED, fileLength + 1);
 	}
 }
 
@@ -145,6 +197,8 @@ void reserve_token_lengths(const size_t fileLength, int **arrayOfIndividualToken
 		if (*arrayOfIndividualTokenSizes == NULL) {
 			(void)IO_BUFFER_RESERVATION_EXCEPTION();
 		}
+
+		(void)ST_count(COUNTER_BYTES_ALLOCATED, fileLength * sizeof(int));
 	}
 }
 
@@ -378,7 +432,7 @@ int skip_string(char **buffer, size_t bufferLength, size_t currentBufferCharacte
 	size_t lengthOfString = 1;
 
 	// Skip the whole string till the end
-	while (currentTokenNumber + lengthOfString < bufferLength 
+	while (currentBufferCharacterPosition + lengthOfString < bufferLength 
 			&& ((*buffer)[currentBufferCharacterPosition + lengthOfString] != '\"'
 			|| (*buffer)[currentBufferCharacterPosition + lengthOfString - 1] == '\\')) {
 		lengthOfString++;
@@ -22,63 +22,574 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "../headers/modules.h"
 #include "../headers/hashmap.h"
 #include "../headers/errors.h"
+#include "../headers/stats.h"
+#include "../headers/ir.h"
+#include "../headers/optimizer.h"
+#include "../headers/vm.h"
+#include "../headers/codegen.h"
 
 #include <time.h>
 #include <stdlib.h>
+#include <string.h>
 
-char *FILE_NAME = NULL;
-char **BUFFER = NULL;
-size_t BUFFER_LENGTH = 0;
-size_t TOKEN_LENGTH = 0;
+//Globals of the compiler pipeline (defined in compiler.c)
+extern char *FILE_NAME;
+extern char **BUFFER;
+extern size_t BUFFER_LENGTH;
+extern size_t TOKEN_LENGTH;
+extern struct LineIndex *LINE_INDEX;
 
-int main() {
-    (void)printf("SPACE-Language compiler [Version 0.0.1 - Alpha]\n");
-    (void)printf("Copyright (C) 2024 Lukas Nian En Lampl\n");
-    (void)printf("_________________________________________________\n\n");
-    
+//Streams of the dumps (NULL = no dump)
+extern FILE *TOKEN_DUMP;
+extern FILE *AST_DUMP;
+extern FILE *SYMBOL_DUMP;
+extern FILE *LAYOUT_DUMP;
+extern FILE *IR_DUMP;
+extern FILE *BYTECODE_DUMP;
+
+//Whether the compiled program is executed (--run)
+int RUN_PROGRAM = 0;
+
+//Whether the IR is optimized (--no-optimize turns it off)
+int OPTIMIZE_PROGRAM = 1;
+
+//Whether the blocks are ordered by a counted run of the program (--profile)
+int PROFILE_PROGRAM = 0;
+
+//Whether hot functions are compiled into machine code while running (--no-jit turns it off)
+int JIT_PROGRAM = 1;
+
+//Path of the generated assembly (--emit-asm), "" writes <file>.s
+char *EMIT_ASSEMBLY = NULL;
+
+void FREE_TABLE(struct SemanticTable *rootTable);
+
+enum DumpKind {
+    DUMP_TOKENS,
+    DUMP_AST,
+    DUMP_SYMBOLS,
+    DUMP_LAYOUT,
+    DUMP_IR,
+    DUMP_BYTECODE,
+    DUMP_KINDS
+};
+
+struct CompileOptions {
+    enum DiagnosticFormat diagnosticsFormat;
+    char *diagnosticsOutput;
+
+    //"-" dumps into stdout, NULL disables the dump
+    char *dumpPaths[DUMP_KINDS];
+
+    //0 = no report, 1 = phase times only (--time-report), 2 = times and counters (--stats)
+    int statsLevel;
+    enum StatsFormat statsFormat;
+    char *statsOutput;
+};
+
+int parse_options(int argc, char **argv, struct CompileOptions *options);
+int open_dumps(struct CompileOptions *options, FILE **streams);
+void close_dumps(FILE **streams);
+int compile_file(char *path, char *fileName, struct DiagnosticRenderer *renderer, struct DiagnosticSink *sink);
+int run_phases(char *path, struct InputReaderResults *inputReaderResults);
+int write_stats(struct CompileOptions *options);
+int write_assembly(char *path, struct IRModule *module);
+
+int main(int argc, char **argv) {
+    //The language server speaks over stdin / stdout, so no banner is printed
+    if (argc > 1 && strcmp(argv[1], "--lsp") == 0) {
+        return RunLanguageServer();
+    }
+
+    struct CompileOptions options = {FORMAT_TEXT, NULL, {NULL, NULL, NULL, NULL, NULL, NULL}, 0, STATS_FORMAT_TABLE, NULL};
+    FILE *dumps[DUMP_KINDS] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    int firstFile = parse_options(argc, argv, &options);
+
+    if (firstFile < 0 || (int)open_dumps(&options, dumps) == 0) {
+        return PHASE_ABORTED;
+    }
+
+    FILE *output = stdout;
+
+    if (options.diagnosticsOutput != NULL) {
+        output = fopen(options.diagnosticsOutput, "w");
+
+        if (output == NULL) {
+            (void)printf("Can't open \"%s\" for the diagnostics.\n", options.diagnosticsOutput);
+            (void)close_dumps(dumps);
+            return PHASE_ABORTED;
+        }
+    }
+
+    //Machine readable diagnostics shouldn't be mixed with the banner
+    if (options.diagnosticsFormat == FORMAT_TEXT) {
+        (void)printf("SPACE-Language compiler [Version 0.0.1 - Alpha]\n");
+        (void)printf("Copyright (C) 2024 Lukas Nian En Lampl\n");
+        (void)printf("_________________________________________________\n\n");
+    }
+
+    struct DiagnosticSink *sink = CreateNewDiagnosticSink(DIAGNOSTIC_DEFAULT_MAX_ENTRIES);
+    struct DiagnosticRenderer *renderer = CreateNewDiagnosticRenderer(options.diagnosticsFormat, output);
+    (void)_init_error_diagnostic_sink_(sink);
+    (void)ST_reset();
+    int status = PHASE_SUCCESS;
+
+    //A failing file doesn't stop the remaining files from being compiled
+    if (firstFile >= argc) {
+        status = compile_file("../SPACE/prgm.txt", "prgm.txt", renderer, sink);
+    } else {
+        for (int i = firstFile; i < argc; i++) {
+            int fileStatus = compile_file(argv[i], argv[i], renderer, sink);
+            status = fileStatus > status ? fileStatus : status;
+        }
+    }
+
+    (void)DG_finish_rendering(renderer);
+
+    if (renderer != NULL && renderer->errors > 0 && options.diagnosticsFormat == FORMAT_TEXT) {
+        (void)printf(">>>>> Compilation failed with %lu error(s). <<<<<\n", (unsigned long)renderer->errors);
+    }
+
+    (void)_init_error_diagnostic_sink_(NULL);
+    (void)FREE_DIAGNOSTIC_RENDERER(renderer);
+    (void)FREE_DIAGNOSTIC_SINK(sink);
+
+    if (output != stdout) {
+        (void)fclose(output);
+    }
+
+    (void)close_dumps(dumps);
+
+    if (options.statsLevel > 0 && (int)write_stats(&options) == 0) {
+        status = PHASE_ABORTED;
+    }
+
+    return status;
+}
+
+/**
+ * <p>
+ * Reads the options in front of the files.
+ * </p>
+ * 
+ * @returns The index of the first file in argv or -1 on an invalid option
+ * 
+ * @param argc      Number of arguments
+ * @param **argv    Arguments
+ * @param *options  Options to fill
+ */
+int parse_options(int argc, char **argv, struct CompileOptions *options) {
+    int i = 1;
+
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i++) {
+        if (strncmp(argv[i], "--diagnostics-format=", 21) == 0) {
+            if (DG_parse_format(argv[i] + 21, &options->diagnosticsFormat) == 0) {
+                (void)printf("Unknown diagnostics format \"%s\" (text, json or sarif).\n", argv[i] + 21);
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--diagnostics-output=", 21) == 0) {
+            options->diagnosticsOutput = argv[i] + 21;
+        } else if (strncmp(argv[i], "--dump-tokens", 13) == 0 && (argv[i][13] == '\0' || argv[i][13] == '=')) {
+            options->dumpPaths[DUMP_TOKENS] = argv[i][13] == '=' ? argv[i] + 14 : "-";
+        } else if (strncmp(argv[i], "--dump-ast", 10) == 0 && (argv[i][10] == '\0' || argv[i][10] == '=')) {
+            options->dumpPaths[DUMP_AST] = argv[i][10] == '=' ? argv[i] + 11 : "-";
+        } else if (strncmp(argv[i], "--dump-symbols", 14) == 0 && (argv[i][14] == '\0' || argv[i][14] == '=')) {
+            options->dumpPaths[DUMP_SYMBOLS] = argv[i][14] == '=' ? argv[i] + 15 : "-";
+        } else if (strncmp(argv[i], "--dump-layout", 13) == 0 && (argv[i][13] == '\0' || argv[i][13] == '=')) {
+            options->dumpPaths[DUMP_LAYOUT] = argv[i][13] == '=' ? argv[i] + 14 : "-";
+        } else if (strncmp(argv[i], "--dump-ir", 9) == 0 && (argv[i][9] == '\0' || argv[i][9] == '=')) {
+            options->dumpPaths[DUMP_IR] = argv[i][9] == '=' ? argv[i] + 10 : "-";
+        } else if (strncmp(argv[i], "--dump-bytecode", 15) == 0 && (argv[i][15] == '\0' || argv[i][15] == '=')) {
+            options->dumpPaths[DUMP_BYTECODE] = argv[i][15] == '=' ? argv[i] + 16 : "-";
+        } else if (strcmp(argv[i], "--run") == 0) {
+            RUN_PROGRAM = 1;
+        } else if (strcmp(argv[i], "--no-optimize") == 0) {
+            OPTIMIZE_PROGRAM = 0;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            PROFILE_PROGRAM = 1;
+        } else if (strcmp(argv[i], "--no-jit") == 0) {
+            JIT_PROGRAM = 0;
+        } else if (strncmp(argv[i], "--emit-asm", 10) == 0 && (argv[i][10] == '\0' || argv[i][10] == '=')) {
+            EMIT_ASSEMBLY = argv[i][10] == '=' ? argv[i] + 11 : "";
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            options->statsLevel = 2;
+        } else if (strncmp(argv[i], "--stats=", 8) == 0) {
+            options->statsLevel = 2;
+
+            if (ST_parse_format(argv[i] + 8, &options->statsFormat) == 0) {
+                (void)printf("Unknown stats format \"%s\" (table or json).\n", argv[i] + 8);
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--stats-output=", 15) == 0) {
+            options->statsOutput = argv[i] + 15;
+        } else if (strcmp(argv[i], "--time-report") == 0) {
+            options->statsLevel = options->statsLevel > 1 ? options->statsLevel : 1;
+        } else {
+            (void)printf("Unknown option \"%s\".\n", argv[i]);
+            return -1;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * <p>
+ * Opens the streams of the requested dumps. Dumps with the same
+ * path share one stream.
+ * </p>
+ * 
+ * @returns 1 if all streams could be opened, else 0
+ * 
+ * @param *options  Options with the dump paths
+ * @param **streams Receives the streams (indexed by DumpKind)
+ */
+int open_dumps(struct CompileOptions *options, FILE **streams) {
+    for (int i = 0; i < DUMP_KINDS; i++) {
+        char *path = options->dumpPaths[i];
+
+        if (path == NULL) {
+            continue;
+        } else if (strcmp(path, "-") == 0) {
+            streams[i] = stdout;
+            continue;
+        }
+
+        for (int n = 0; n < i && streams[i] == NULL; n++) {
+            if (options->dumpPaths[n] != NULL && strcmp(options->dumpPaths[n], path) == 0) {
+                streams[i] = streams[n];
+            }
+        }
+
+        if (streams[i] == NULL) {
+            streams[i] = fopen(path, "w");
+        }
+
+        if (streams[i] == NULL) {
+            (void)printf("Can't open \"%s\" for the dump.\n", path);
+            (void)close_dumps(streams);
+            return 0;
+        }
+    }
+
+    TOKEN_DUMP = streams[DUMP_TOKENS];
+    AST_DUMP = streams[DUMP_AST];
+    SYMBOL_DUMP = streams[DUMP_SYMBOLS];
+    LAYOUT_DUMP = streams[DUMP_LAYOUT];
+    IR_DUMP = streams[DUMP_IR];
+    BYTECODE_DUMP = streams[DUMP_BYTECODE];
+    return 1;
+}
+
+void close_dumps(FILE **streams) {
+    for (int i = 0; i < DUMP_KINDS; i++) {
+        int shared = 0;
+
+        for (int n = 0; n < i; n++) {
+            shared = streams[n] == streams[i] ? 1 : shared;
+        }
+
+        if (streams[i] != NULL && streams[i] != stdout && shared == 0) {
+            (void)fclose(streams[i]);
+        }
+    }
+
+    for (int i = 0; i < DUMP_KINDS; i++) {
+        streams[i] = NULL;
+    }
+
+    TOKEN_DUMP = NULL;
+    AST_DUMP = NULL;
+    SYMBOL_DUMP = NULL;
+    LAYOUT_DUMP = NULL;
+    IR_DUMP = NULL;
+    BYTECODE_DUMP = NULL;
+}
+
+/**
+ * <p>
+ * Writes the collected phase times (and counters) of all files.
+ * </p>
+ * 
+ * <p>
+ * The report goes to stderr by default, so it doesn't interfere with
+ * machine readable diagnostics on stdout.
+ * </p>
+ * 
+ * @returns 1 if the report was written, else 0
+ * 
+ * @param *options  Options with the stats format and output
+ */
+int write_stats(struct CompileOptions *options) {
+    FILE *output = stderr;
+
+    if (options->statsOutput != NULL) {
+        output = fopen(options->statsOutput, "w");
+
+        if (output == NULL) {
+            (void)printf("Can't open \"%s\" for the stats.\n", options->statsOutput);
+            return 0;
+        }
+    }
+
+    (void)ST_write_report(output, options->statsFormat, options->statsLevel > 1 ? 1 : 0);
+
+    if (output != stderr) {
+        (void)fclose(output);
+    }
+
+    return 1;
+}
+
+/**
+ * <p>
+ * Runs all phases on a single file and renders its diagnostics.
+ * </p>
+ * 
+ * <p>
+ * The diagnostics are rendered before the buffer is freed, so the
+ * renderer can show the affected source lines.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the first phase, that didn't succeed (or PHASE_SUCCESS)
+ * 
+ * @param *path         Path to the file
+ * @param *fileName     Name of the file used in the error messages
+ * @param *renderer     Renderer for the diagnostics of the file
+ * @param *sink         Sink, that collects the diagnostics
+ */
+int compile_file(char *path, char *fileName, struct DiagnosticRenderer *renderer, struct DiagnosticSink *sink) {
+    FILE_NAME = fileName;
+    BUFFER = NULL;
+    BUFFER_LENGTH = 0;
+    LINE_INDEX = NULL;
+
+    struct InputReaderResults inputReaderResults = {0};
+    int status = run_phases(path, &inputReaderResults);
+
+    if (sink != NULL && sink->count + sink->dropped > 0) {
+        char *source = inputReaderResults.buffer;
+
+        //The lexer didn't run, if the file couldn't be read completely
+        if (LINE_INDEX == NULL && source != NULL) {
+            LINE_INDEX = CreateNewLineIndex(source, BUFFER_LENGTH);
+        }
+
+        (void)DG_render(renderer, sink, LINE_INDEX, source);
+        (void)DG_clear(sink);
+    }
+
+    (void)FREE_LINE_INDEX(LINE_INDEX);
+    LINE_INDEX = NULL;
+    (void)FREE_MEMORY();
+
+    if (status == PHASE_SUCCESS && renderer != NULL && renderer->format == FORMAT_TEXT) {
+        (void)printf("\n>>>>> %s has been successfully compiled. <<<<<\n", path);
+    }
+
+    return status;
+}
+
+/**
+ * <p>
+ * Runs the input reader, lexer, syntax analysis, parsetree generator and
+ * semantic analysis on a file.
+ * </p>
+ * 
+ * <p>
+ * The IR is only generated, if it should be dumped ({@code --dump-ir}),
+ * translated into assembly ({@code --emit-asm}) or into bytecode, it is
+ * optimized unless {@code --no-optimize} is given. With
+ * {@code --profile} the blocks are ordered by a counted run. The
+ * bytecode is only generated, if it should be dumped
+ * ({@code --dump-bytecode}) or the program should be executed
+ * ({@code --run}), hot functions are compiled into machine code while
+ * it runs unless {@code --no-jit} is given.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the first phase, that didn't succeed (or PHASE_SUCCESS)
+ * 
+ * @param *path                 Path to the file
+ * @param *inputReaderResults   Receives the buffer of the file
+ */
+int run_phases(char *path, struct InputReaderResults *inputReaderResults) {
     /////////////////////////////////////////
     //////////     INPUT READER    //////////
     /////////////////////////////////////////
-    char *path = "../SPACE/prgm.txt";
-    FILE_NAME = "prgm.txt";
+    (void)ST_start_phase(STATS_INPUT);
+    *inputReaderResults = ProcessInput(path);
+    (void)ST_end_phase(STATS_INPUT);
+    (void)ST_count(COUNTER_FILES, 1);
 
-    struct InputReaderResults inputReaderResults = ProcessInput(path);
-    int *arrayOfIndividualTokenSizes = inputReaderResults.arrayOfIndividualTokenSizes;
-    BUFFER = &inputReaderResults.buffer;
-    BUFFER_LENGTH = inputReaderResults.fileLength;
-    TOKEN_LENGTH = inputReaderResults.requiredTokenNumber;
+    if (inputReaderResults->buffer == NULL) {
+        return PHASE_ABORTED;
+    }
+
+    (void)ST_count(COUNTER_SOURCE_BYTES, inputReaderResults->fileLength);
+
+    int *arrayOfIndividualTokenSizes = inputReaderResults->arrayOfIndividualTokenSizes;
+    BUFFER = &inputReaderResults->buffer;
+    BUFFER_LENGTH = inputReaderResults->fileLength;
+    TOKEN_LENGTH = inputReaderResults->requiredTokenNumber;
 
     //////////////////////////////////
     //////////     LEXER    //////////
     //////////////////////////////////
-    printf("Tokenize\n");
+    (void)ST_start_phase(STATS_LEXER);
     TOKEN *tokens = Tokenize(&arrayOfIndividualTokenSizes);
-    (void)FREE_TOKEN_LENGTHS(inputReaderResults.arrayOfIndividualTokenSizes);
+    (void)ST_end_phase(STATS_LEXER);
+    (void)FREE_TOKEN_LENGTHS(inputReaderResults->arrayOfIndividualTokenSizes);
+
+    if (tokens == NULL) {
+        return PHASE_ABORTED;
+    }
 
     ////////////////////////////////////////
     /////     CHECK SYNTAX FUNCTION     ////
     ////////////////////////////////////////
-
-    //0 = no errors, 1 = with errors
-    int containsSyntaxErrors = (int)CheckInput(&tokens);
+    (void)ST_start_phase(STATS_SYNTAX);
+    int syntaxStatus = (int)CheckInput(&tokens);
+    (void)ST_end_phase(STATS_SYNTAX);
 
     /////////////////////////////////////////
     ///////     GENERATE PARSETREE     //////
     /////////////////////////////////////////
-    if (containsSyntaxErrors != 0) {
-        (void)FREE_MEMORY();
-        return -1;
+    if (syntaxStatus != PHASE_SUCCESS) {
+        return syntaxStatus;
     }
 
+    (void)ST_start_phase(STATS_PARSETREE);
     struct Node *root = GenerateParsetree(&tokens);
+    (void)ST_end_phase(STATS_PARSETREE);
 
-    int containsSemanticErrors = (int)CheckSemantic(root);
+    if (root == NULL) {
+        return PHASE_ABORTED;
+    }
 
-    if (containsSemanticErrors != 0) {
-        (void)FREE_MEMORY();
-        return -1;
+    //The symbol tables are only needed for the IR
+    int lowerProgram = IR_DUMP != NULL || BYTECODE_DUMP != NULL || RUN_PROGRAM == 1 || EMIT_ASSEMBLY != NULL ? 1 : 0;
+    struct SemanticTable *table = NULL;
+    (void)ST_start_phase(STATS_SEMANTIC);
+    int status = (int)CheckSemantic(root, lowerProgram == 1 ? &table : NULL);
+    (void)ST_end_phase(STATS_SEMANTIC);
+
+    if (status == PHASE_SUCCESS && table != NULL) {
+        struct IRModule *module = NULL;
+        (void)ST_start_phase(STATS_IR);
+        status = (int)GenerateIR(root, table, &module);
+        (void)ST_end_phase(STATS_IR);
+
+        if (status == PHASE_SUCCESS && OPTIMIZE_PROGRAM == 1) {
+            (void)ST_start_phase(STATS_OPTIMIZE);
+            status = (int)OptimizeIR(module);
+            (void)ST_end_phase(STATS_OPTIMIZE);
+        }
+
+        if (status == PHASE_SUCCESS && PROFILE_PROGRAM == 1) {
+            (void)ST_start_phase(STATS_PROFILE);
+            status = (int)ProfileIR(module);
+            (void)ST_end_phase(STATS_PROFILE);
+        }
+
+        if (status == PHASE_SUCCESS && EMIT_ASSEMBLY != NULL) {
+            (void)ST_start_phase(STATS_CODEGEN);
+            status = (int)write_assembly(path, module);
+            (void)ST_end_phase(STATS_CODEGEN);
+        }
+
+        if (status == PHASE_SUCCESS && (BYTECODE_DUMP != NULL || RUN_PROGRAM == 1)) {
+            struct VMProgram *program = NULL;
+            (void)ST_start_phase(STATS_BYTECODE);
+            status = (int)GenerateBytecode(module, &program);
+            (void)ST_end_phase(STATS_BYTECODE);
+
+            if (status == PHASE_SUCCESS && RUN_PROGRAM == 1) {
+                program->jit = JIT_PROGRAM == 1 ? program->jit : 0;
+                (void)printf("\n>>>>>>>>>>>>>>>>>>>>    RUN (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", path);
+                (void)ST_start_phase(STATS_RUN);
+                status = (int)RunProgram(program, stdout);
+                (void)ST_end_phase(STATS_RUN);
+            }
+
+            (void)FREE_VM_PROGRAM(program);
+        }
+
+        (void)FREE_IR_MODULE(module);
     }
 
-    (void)FREE_MEMORY();
-    (void)printf("\n>>>>> %s has been successfully compiled. <<<<<\n", path);
-}
\ No newline at end of file
+    if (table != NULL) {
+        (void)FREE_TABLE(table);
+        (void)free(table);
+    }
+
+    (void)FREE_NODE(root);
+    return status;
+}
+
+/**
+ * <p>
+ * Writes the assembly of a file ({@code --emit-asm}).
+ * </p>
+ * 
+ * <p>
+ * Without a path the assembly is written next to the file
+ * ({@code <file>.s}).
+ * </p>
+ * 
+ * <p>
+ * The assembly is written into {@code <output>.tmp} first, which
+ * replaces the output only if the generation succeeded. So a failed
+ * generation never leaves a truncated output behind (an older output
+ * is removed, since it doesn't belong to the file anymore).
+ * </p>
+ * 
+ * @returns The PhaseStatus of the assembly generation
+ * 
+ * @param *path     Path to the compiled file
+ * @param *module   Verified IR of the file
+ */
+int write_assembly(char *path, struct IRModule *module) {
+    char *outputPath = EMIT_ASSEMBLY;
+
+    if (EMIT_ASSEMBLY[0] == '\0') {
+        outputPath = (char*)calloc(strlen(path) + 3, sizeof(char));
+
+        if (outputPath == NULL) {
+            return PHASE_ABORTED;
+        }
+
+        (void)sprintf(outputPath, "%s.s", path);
+    }
+
+    char *tempPath = (char*)calloc(strlen(outputPath) + 5, sizeof(char));
+    FILE *output = tempPath == NULL ? NULL : fopen(strcat(strcpy(tempPath, outputPath), ".tmp"), "w");
+    int status = PHASE_ABORTED;
+
+    if (output == NULL) {
+        (void)printf("Can't open \"%s\" for the assembly.\n", tempPath == NULL ? outputPath : tempPath);
+    } else {
+        status = (int)GenerateAssembly(module, path, output);
+
+        if (ferror(output) != 0 || fclose(output) != 0) {
+            (void)printf("Can't write the assembly into \"%s\".\n", tempPath);
+            status = PHASE_ABORTED;
+        }
+
+        //rename() doesn't replace an existing file on Windows
+        (void)remove(outputPath);
+
+        if (status == PHASE_SUCCESS && rename(tempPath, outputPath) != 0) {
+            (void)printf("Can't move the assembly into \"%s\".\n", outputPath);
+            status = PHASE_ABORTED;
+        }
+
+        (void)remove(tempPath);
+    }
+
+    if (outputPath != EMIT_ASSEMBLY) {
+        (void)free(outputPath);
+    }
+
+    (void)free(tempPath);
+    return status;
+}
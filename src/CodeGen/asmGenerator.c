@@ -0,0 +1,1815 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/stats.h"
+#include "../../headers/ir.h"
+#include "../../headers/codegen.h"
+
+/**
+ * The subprogram {@code SPACE/src/CodeGen/asmGenerator.c} was created
+ * to translate the IR into x86-64 assembly (GNU assembler, System V ABI).
+ *
+ * The virtual registers of every function are mapped onto the physical
+ * registers by a linear scan over their live intervals, registers, that
+ * don't fit, are spilled onto the stack. Intervals, that contain a call,
+ * only get callee-saved registers. The generated file is linked with the
+ * runtime ({@code SPACE/src/Runtime/runtime.c}), which calls the entry
+ * function and prints the globals afterwards.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Positions of unused registers
+#define CG_NO_POSITION ((size_t)-1)
+
+struct CGInterval {
+	int reg;
+	size_t start;
+	size_t end;
+	int floating;
+
+	//The interval contains a call, so it can't live in a caller-saved register
+	int crossesCall;
+
+	//Operand of the defining instruction at the start, that should share the register
+	int hint;
+	size_t hintPosition;
+
+	//Argument register, the value is passed in or received from
+	int preferred;
+};
+
+/**
+ * <p>
+ * State of the generator, the arrays belong to the function, that is
+ * translated at the moment.
+ * </p>
+ *
+ * <p>
+ * Every virtual register either lives in a physical register
+ * (`physical`, index into the register table of its class) or in a
+ * spill slot on the stack (`slot`). The staging slots hold the arguments
+ * of a call and the incoming parameters, while they are moved into their
+ * registers, the outgoing slots are the stack arguments of a call.
+ * </p>
+ */
+struct CGGenerator {
+	FILE *output;
+	struct IRModule *module;
+	struct IRFunction *function;
+	size_t functionIndex;
+	size_t labels;
+
+	struct CGInterval *intervals;
+	int *useCounts;
+	int *physical;
+	int *slot;
+	char (*operands)[24];
+
+	int spillSlots;
+	int stagingSlots;
+	int outgoingSlots;
+	int usedCalleeSaved[CG_CALLEE_SAVED_REGISTERS];
+	int savedRegisters;
+};
+
+//The callee-saved registers come first
+const char *CG_INTEGER_REGISTER_NAMES[CG_INTEGER_REGISTERS] = {
+	"%rbx", "%r12", "%r13", "%r14", "%r15", "%rsi", "%rdi", "%r8", "%r9", "%r10"
+};
+
+const char *CG_FLOATING_REGISTER_NAMES[CG_FLOATING_REGISTERS] = {
+	"%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14"
+};
+
+//Argument registers of the System V ABI
+const char *CG_INTEGER_ARGUMENTS[6] = {"%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9"};
+
+//Allocatable register of every integer argument (%rdx and %rcx are scratch registers)
+const int CG_ARGUMENT_REGISTERS[6] = {6, 5, CG_NO_REGISTER, CG_NO_REGISTER, 7, 8};
+const char *CG_FLOATING_ARGUMENTS[8] = {"%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7"};
+
+int CG_check_supported(struct IRModule *module);
+int CG_uses_references(struct IRFunction *function);
+int CG_generate_function(struct CGGenerator *generator, size_t index);
+void CG_compute_intervals(struct CGGenerator *generator, size_t positionCount);
+void CG_compute_liveness(struct IRFunction *function, uint64_t *liveIn, uint64_t *liveOut, size_t words);
+void CG_allocate_registers(struct CGGenerator *generator);
+int CG_find_free_register(int *owners, int floating, int crossesCall);
+int CG_take_hinted_register(struct CGGenerator *generator, struct CGInterval *current, int *active, int *activeCount);
+void CG_spill(struct CGGenerator *generator, int reg);
+void CG_compute_frame(struct CGGenerator *generator);
+void CG_write_prologue(struct CGGenerator *generator);
+void CG_write_parameters(struct CGGenerator *generator);
+void CG_write_moves(struct CGGenerator *generator, char (*sources)[24], char (*targets)[24], int count);
+void CG_write_epilogue(struct CGGenerator *generator);
+void CG_write_instruction(struct CGGenerator *generator, struct IRInstruction *instruction, int nextBlock);
+void CG_write_arithmetic(struct CGGenerator *generator, struct IRInstruction *instruction);
+void CG_write_division(struct CGGenerator *generator, struct IRInstruction *instruction);
+const char *CG_get_wrap(enum VarType type);
+void CG_write_wrap(struct CGGenerator *generator, enum VarType type);
+void CG_write_floating_arithmetic(struct CGGenerator *generator, struct IRInstruction *instruction);
+void CG_write_comparison(struct CGGenerator *generator, struct IRInstruction *instruction, struct IRInstruction *branch, int nextBlock);
+void CG_write_branch(struct CGGenerator *generator, const char *condition, const char *inverse, struct IRInstruction *branch, int nextBlock);
+void CG_write_switch(struct CGGenerator *generator, struct IRInstruction *instruction);
+void CG_write_conversion(struct CGGenerator *generator, struct IRInstruction *instruction);
+void CG_write_call(struct CGGenerator *generator, struct IRInstruction *instruction);
+void CG_write_string_operation(struct CGGenerator *generator, struct IRInstruction *instruction);
+void CG_write_data(struct CGGenerator *generator);
+void CG_write_symbol(struct CGGenerator *generator, char *buffer, size_t index);
+void CG_move(struct CGGenerator *generator, const char *source, const char *dest);
+void CG_emit(struct CGGenerator *generator, const char *format, ...);
+int CG_get_uses(struct IRFunction *function, struct IRInstruction *instruction, int **uses, int *buffer);
+int CG_get_definition(struct IRInstruction *instruction);
+int CG_get_hint(struct IRInstruction *instruction);
+int CG_is_call(struct IRInstruction *instruction);
+int CG_is_floating_type(enum VarType type);
+int CG_is_memory(const char *operand);
+enum CGValueKind CG_get_value_kind(enum VarType type);
+int CG_compare_intervals(const void *first, const void *second);
+void *CG_allocate(size_t count, size_t size);
+void CG_free_function_data(struct CGGenerator *generator);
+
+/**
+ * <p>
+ * This is the entrypoint of the assembly generation.
+ * </p>
+ *
+ * <p>
+ * The module has to be verified (see IR_verify_module). The generated
+ * assembly exports the entry function as {@code space_main} and the
+ * table of the globals as {@code space_globals}. The runtime has no
+ * unwinder and no heap for objects, so functions with landing pads
+ * (try statements) and functions with objects or arrays are reported
+ * as DIAG_IR_UNSUPPORTED.
+ * </p>
+ *
+ * @returns The PhaseStatus of the generation
+ *
+ * @param *module   Verified IR of the program
+ * @param *source   Name of the source file (for the header comment)
+ * @param *output   Stream, that receives the assembly
+ */
+int GenerateAssembly(struct IRModule *module, const char *source, FILE *output) {
+	if (module == NULL || module->entryFunction < 0 || output == NULL) {
+		return PHASE_ABORTED;
+	}
+
+	struct CGGenerator generator;
+	jmp_buf recoveryPoint;
+	(void)memset(&generator, 0, sizeof(struct CGGenerator));
+	generator.output = output;
+	generator.module = module;
+
+	if (setjmp(recoveryPoint) != 0) {
+		(void)CG_free_function_data(&generator);
+		return PHASE_ABORTED;
+	}
+
+	if ((int)CG_check_supported(module) == false) {
+		return PHASE_ERRORS;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	(void)fprintf(output, "# Generated by the SPACE compiler from \"%s\"\n", source);
+	(void)fprintf(output, "\t.text\n");
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		(void)CG_generate_function(&generator, i);
+	}
+
+	(void)CG_write_data(&generator);
+	(void)_init_error_recovery_point_(NULL);
+	return PHASE_SUCCESS;
+}
+
+/*
+Purpose: Report the blocks with a landing pad and the functions with references, that can't be translated
+Return Type: int => true if the module can be translated, else false
+Params: struct IRModule *module => Module to check
+*/
+int CG_check_supported(struct IRModule *module) {
+	int supported = true;
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		struct IRFunction *function = module->functions[i];
+
+		if ((int)CG_uses_references(function) == true) {
+			(void)REPORT_DIAGNOSTIC(DIAG_IR_UNSUPPORTED, SEVERITY_ERROR, function->line, DIAGNOSTIC_NO_POSITION, 0,
+				"CodeGenUnsupportedException: Objects and arrays can't be translated into assembly yet (function \"%s\")", function->name);
+			(void)REPORT_DIAGNOSTIC_DETAILS("The runtime of the assembly has no heap for objects and arrays.", "Run the program with \"--run\" instead.");
+			supported = false;
+			continue;
+		}
+
+		for (size_t n = 0; n < function->blockCount; n++) {
+			struct IRBlock *block = &function->blocks[n];
+
+			if (block->handler >= 0) {
+				(void)REPORT_DIAGNOSTIC(DIAG_IR_UNSUPPORTED, SEVERITY_ERROR, function->instructions[block->firstInstruction].line, DIAGNOSTIC_NO_POSITION, 0,
+					"CodeGenUnsupportedException: Try statements can't be translated into assembly yet (function \"%s\")", function->name);
+				(void)REPORT_DIAGNOSTIC_DETAILS("The runtime of the assembly can't unwind a runtime error into a catch statement.", "Run the program with \"--run\" instead.");
+				supported = false;
+				break;
+			}
+		}
+	}
+
+	return supported;
+}
+
+/*
+Purpose: Check if a function holds an object or an array in a register
+Return Type: int => true if a register is a reference, else false
+Params: struct IRFunction *function => Function to check
+*/
+int CG_uses_references(struct IRFunction *function) {
+	for (size_t i = 0; i < function->registerCount; i++) {
+		if (function->registers[i].type == CLASS_REF) {
+			return true;
+		}
+	}
+
+	return function->returnType == CLASS_REF ? true : false;
+}
+
+/**
+ * <p>
+ * Allocates the registers of a function and writes its code.
+ * </p>
+ *
+ * <p>
+ * The blocks are written in their layout order, so jumps into the
+ * following block are dropped.
+ * </p>
+ *
+ * @returns True, if the function was written
+ *
+ * @param *generator    Generator with the module
+ * @param index         Index of the function in the module
+ */
+int CG_generate_function(struct CGGenerator *generator, size_t index) {
+	struct IRFunction *function = generator->module->functions[index];
+	char symbol[256];
+	generator->function = function;
+	generator->functionIndex = index;
+	generator->spillSlots = 0;
+	generator->savedRegisters = 0;
+	(void)memset(generator->usedCalleeSaved, 0, sizeof(generator->usedCalleeSaved));
+
+	size_t positionCount = 1;
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		positionCount += function->blocks[i].instructionCount;
+	}
+
+	(void)CG_compute_intervals(generator, positionCount);
+	(void)CG_allocate_registers(generator);
+	(void)CG_compute_frame(generator);
+	(void)CG_write_symbol(generator, symbol, index);
+
+	(void)fprintf(generator->output, "\n\t.globl %s\n\t.type %s, @function\n%s:\n", symbol, symbol, symbol);
+	(void)CG_write_prologue(generator);
+	(void)CG_write_parameters(generator);
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		int nextBlock = i + 1 < function->blockCount ? (int)(i + 1) : IR_NO_REGISTER;
+
+		if (i > 0) {
+			(void)fprintf(generator->output, ".Lspace_%lu_%lu:\n", (unsigned long)index, (unsigned long)i);
+		}
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[block->firstInstruction + n];
+			struct IRInstruction *following = n + 1 < block->instructionCount ? instruction + 1 : NULL;
+
+			//A comparison, that is only read by the following branch, jumps directly
+			if (instruction->opcode >= IR_EQ && instruction->opcode <= IR_GE && following != NULL && following->opcode == IR_BRANCH
+				&& following->a == instruction->dest && generator->useCounts[instruction->dest] == 1) {
+				(void)CG_write_comparison(generator, instruction, following, nextBlock);
+				n++;
+				continue;
+			}
+
+			(void)CG_write_instruction(generator, instruction, nextBlock);
+		}
+	}
+
+	(void)CG_write_epilogue(generator);
+	(void)fprintf(generator->output, "\t.size %s, .-%s\n", symbol, symbol);
+	(void)CG_free_function_data(generator);
+	return true;
+}
+
+/**
+ * <p>
+ * Computes the live interval of every virtual register.
+ * </p>
+ *
+ * <p>
+ * The registers aren't in SSA form, so the interval is the hull of all
+ * positions, where the register is live: its definitions and uses and
+ * the bounds of all blocks, where it is live on entry or exit.
+ * </p>
+ *
+ * @param *generator        Generator with the function
+ * @param positionCount     Number of positions (instructions + entry)
+ */
+void CG_compute_intervals(struct CGGenerator *generator, size_t positionCount) {
+	struct IRFunction *function = generator->function;
+	size_t words = (function->registerCount + 63) / 64;
+	size_t blockCount = function->blockCount;
+	uint64_t *liveIn = (uint64_t*)CG_allocate(blockCount * words, sizeof(uint64_t));
+	uint64_t *liveOut = (uint64_t*)CG_allocate(blockCount * words, sizeof(uint64_t));
+	size_t *callsBefore = (size_t*)CG_allocate(positionCount + 1, sizeof(size_t));
+	int buffer[3];
+	int *uses = NULL;
+
+	generator->intervals = (struct CGInterval*)CG_allocate(function->registerCount, sizeof(struct CGInterval));
+	generator->useCounts = (int*)CG_allocate(function->registerCount, sizeof(int));
+
+	for (size_t i = 0; i < function->registerCount; i++) {
+		generator->intervals[i].reg = (int)i;
+		generator->intervals[i].start = i < (size_t)function->paramCount ? 0 : CG_NO_POSITION;
+		generator->intervals[i].end = 0;
+		generator->intervals[i].floating = (int)CG_is_floating_type(function->registers[i].type);
+		generator->intervals[i].hint = IR_NO_REGISTER;
+		generator->intervals[i].preferred = CG_NO_REGISTER;
+	}
+
+	for (int i = 0, integers = 0; i < function->paramCount; i++) {
+		if (generator->intervals[i].floating == false && integers < 6) {
+			generator->intervals[i].preferred = CG_ARGUMENT_REGISTERS[integers++];
+		}
+	}
+
+	(void)CG_compute_liveness(function, liveIn, liveOut, words);
+	size_t position = 1;
+
+	for (size_t i = 0; i < blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		size_t blockStart = position;
+		size_t blockEnd = position + block->instructionCount - 1;
+
+		for (size_t n = 0; n < block->instructionCount; n++, position++) {
+			struct IRInstruction *instruction = &function->instructions[block->firstInstruction + n];
+			int useCount = (int)CG_get_uses(function, instruction, &uses, buffer);
+			int definition = (int)CG_get_definition(instruction);
+			callsBefore[position + 1] = callsBefore[position] + (CG_is_call(instruction) == true ? 1 : 0);
+
+			for (int u = 0, integers = 0; u < useCount; u++) {
+				struct CGInterval *interval = &generator->intervals[uses[u]];
+				generator->useCounts[uses[u]]++;
+
+				if (instruction->opcode == IR_CALL && interval->floating == false && integers < 6) {
+					interval->preferred = interval->preferred == CG_NO_REGISTER ? CG_ARGUMENT_REGISTERS[integers] : interval->preferred;
+					integers++;
+				}
+			}
+
+			if (definition >= 0 && generator->intervals[definition].hint == IR_NO_REGISTER) {
+				generator->intervals[definition].hint = (int)CG_get_hint(instruction);
+				generator->intervals[definition].hintPosition = position;
+			}
+
+			for (int u = 0; u < useCount + 1; u++) {
+				int reg = u < useCount ? uses[u] : definition;
+
+				if (reg < 0) {
+					continue;
+				}
+
+				struct CGInterval *interval = &generator->intervals[reg];
+				interval->start = interval->start == CG_NO_POSITION || position < interval->start ? position : interval->start;
+				interval->end = position > interval->end ? position : interval->end;
+			}
+		}
+
+		for (size_t reg = 0; reg < function->registerCount; reg++) {
+			uint64_t mask = (uint64_t)1 << (reg % 64);
+			struct CGInterval *interval = &generator->intervals[reg];
+
+			if ((liveIn[i * words + reg / 64] & mask) != 0) {
+				interval->start = interval->start == CG_NO_POSITION || blockStart < interval->start ? blockStart : interval->start;
+			}
+
+			if ((liveOut[i * words + reg / 64] & mask) != 0) {
+				interval->end = blockEnd > interval->end ? blockEnd : interval->end;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < function->registerCount; i++) {
+		struct CGInterval *interval = &generator->intervals[i];
+
+		if (interval->start != CG_NO_POSITION && interval->end > interval->start) {
+			interval->crossesCall = callsBefore[interval->end] > callsBefore[interval->start + 1] ? true : false;
+		}
+	}
+
+	(void)free(liveIn);
+	(void)free(liveOut);
+	(void)free(callsBefore);
+}
+
+/*
+Purpose: Compute the registers, that are live on entry and exit of every block (backwards dataflow)
+Return Type: void
+Params: struct IRFunction *function => Function to analyze;
+		uint64_t *liveIn => Receives the bitsets of the live registers on entry (words per block);
+		uint64_t *liveOut => Receives the bitsets of the live registers on exit;
+		size_t words => Number of words of a bitset
+*/
+void CG_compute_liveness(struct IRFunction *function, uint64_t *liveIn, uint64_t *liveOut, size_t words) {
+	size_t blockCount = function->blockCount;
+	uint64_t *used = (uint64_t*)CG_allocate(blockCount * words, sizeof(uint64_t));
+	uint64_t *defined = (uint64_t*)CG_allocate(blockCount * words, sizeof(uint64_t));
+	int buffer[3];
+	int *uses = NULL;
+
+	for (size_t i = 0; i < blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		uint64_t *blockUsed = &used[i * words];
+		uint64_t *blockDefined = &defined[i * words];
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[block->firstInstruction + n];
+			int useCount = (int)CG_get_uses(function, instruction, &uses, buffer);
+			int definition = (int)CG_get_definition(instruction);
+
+			for (int u = 0; u < useCount; u++) {
+				if ((blockDefined[uses[u] / 64] & ((uint64_t)1 << (uses[u] % 64))) == 0) {
+					blockUsed[uses[u] / 64] |= (uint64_t)1 << (uses[u] % 64);
+				}
+			}
+
+			if (definition >= 0) {
+				blockDefined[definition / 64] |= (uint64_t)1 << (definition % 64);
+			}
+		}
+	}
+
+	int changed = true;
+
+	while (changed == true) {
+		changed = false;
+
+		for (size_t i = blockCount; i-- > 0;) {
+			struct IRBlock *block = &function->blocks[i];
+			struct IRInstruction *terminator = &function->instructions[block->firstInstruction + block->instructionCount - 1];
+			int targets[2];
+			int *successors = NULL;
+			int successorCount = (int)IR_get_targets(function, terminator, &successors, targets);
+
+			for (size_t w = 0; w < words; w++) {
+				uint64_t out = 0;
+
+				for (int s = 0; s < successorCount; s++) {
+					out |= liveIn[(size_t)successors[s] * words + w];
+				}
+
+				uint64_t in = used[i * words + w] | (out & ~defined[i * words + w]);
+
+				if (out != liveOut[i * words + w] || in != liveIn[i * words + w]) {
+					liveOut[i * words + w] = out;
+					liveIn[i * words + w] = in;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	(void)free(used);
+	(void)free(defined);
+}
+
+/**
+ * <p>
+ * Maps the virtual registers onto physical registers (linear scan).
+ * </p>
+ *
+ * <p>
+ * The intervals are visited in the order of their start, intervals,
+ * that ended before, free their registers. If no register is free, the
+ * interval, that ends last, is spilled (the current or an active one).
+ * </p>
+ *
+ * @param *generator    Generator with the computed intervals
+ */
+void CG_allocate_registers(struct CGGenerator *generator) {
+	struct IRFunction *function = generator->function;
+	struct CGInterval *sorted = (struct CGInterval*)CG_allocate(function->registerCount, sizeof(struct CGInterval));
+	int integerOwners[CG_INTEGER_REGISTERS];
+	int floatingOwners[CG_FLOATING_REGISTERS];
+	int active[CG_INTEGER_REGISTERS + CG_FLOATING_REGISTERS];
+	int activeCount = 0;
+	size_t count = 0;
+
+	generator->physical = (int*)CG_allocate(function->registerCount, sizeof(int));
+	generator->slot = (int*)CG_allocate(function->registerCount, sizeof(int));
+
+	for (size_t i = 0; i < function->registerCount; i++) {
+		generator->physical[i] = CG_NO_REGISTER;
+		generator->slot[i] = CG_NO_REGISTER;
+
+		if (generator->intervals[i].start != CG_NO_POSITION) {
+			sorted[count++] = generator->intervals[i];
+		}
+	}
+
+	(void)memset(integerOwners, -1, sizeof(integerOwners));
+	(void)memset(floatingOwners, -1, sizeof(floatingOwners));
+	(void)qsort(sorted, count, sizeof(struct CGInterval), CG_compare_intervals);
+
+	for (size_t i = 0; i < count; i++) {
+		struct CGInterval *current = &sorted[i];
+
+		for (int n = activeCount - 1; n >= 0; n--) {
+			struct CGInterval *interval = &generator->intervals[active[n]];
+
+			if (interval->end < current->start) {
+				int *owners = interval->floating == true ? floatingOwners : integerOwners;
+				owners[generator->physical[interval->reg]] = -1;
+				active[n] = active[--activeCount];
+			}
+		}
+
+		int *owners = current->floating == true ? floatingOwners : integerOwners;
+		int physical = (int)CG_take_hinted_register(generator, current, active, &activeCount);
+
+		if (physical == CG_NO_REGISTER && current->preferred != CG_NO_REGISTER && current->crossesCall == false && owners[current->preferred] < 0) {
+			physical = current->preferred;
+		}
+
+		physical = physical == CG_NO_REGISTER ? (int)CG_find_free_register(owners, current->floating, current->crossesCall) : physical;
+
+		if (physical == CG_NO_REGISTER) {
+			int victim = -1;
+
+			for (int n = 0; n < activeCount; n++) {
+				struct CGInterval *interval = &generator->intervals[active[n]];
+				int candidate = generator->physical[interval->reg];
+
+				if (interval->floating != current->floating || interval->end <= current->end
+					|| (current->crossesCall == true && (current->floating == true || candidate >= CG_CALLEE_SAVED_REGISTERS))) {
+					continue;
+				}
+
+				if (victim < 0 || interval->end > generator->intervals[active[victim]].end) {
+					victim = n;
+				}
+			}
+
+			if (victim < 0) {
+				(void)CG_spill(generator, current->reg);
+				continue;
+			}
+
+			physical = generator->physical[active[victim]];
+			generator->physical[active[victim]] = CG_NO_REGISTER;
+			(void)CG_spill(generator, active[victim]);
+			active[victim] = active[--activeCount];
+		}
+
+		owners[physical] = current->reg;
+		generator->physical[current->reg] = physical;
+		active[activeCount++] = current->reg;
+
+		if (current->floating == false && physical < CG_CALLEE_SAVED_REGISTERS) {
+			generator->usedCalleeSaved[physical] = true;
+		}
+	}
+
+	(void)free(sorted);
+}
+
+/*
+Purpose: Find a free physical register for an interval
+Return Type: int => Index of the register or CG_NO_REGISTER
+Params: int *owners => Owners of the registers of the class (-1 = free);
+		int floating => Whether the interval is floating;
+		int crossesCall => Whether the interval contains a call
+*/
+int CG_find_free_register(int *owners, int floating, int crossesCall) {
+	if (floating == true) {
+		for (int i = 0; i < CG_FLOATING_REGISTERS && crossesCall == false; i++) {
+			if (owners[i] < 0) {
+				return i;
+			}
+		}
+
+		return CG_NO_REGISTER;
+	}
+
+	//Caller-saved registers first, so short intervals don't need a saved register
+	for (int i = CG_CALLEE_SAVED_REGISTERS; i < CG_INTEGER_REGISTERS && crossesCall == false; i++) {
+		if (owners[i] < 0) {
+			return i;
+		}
+	}
+
+	for (int i = 0; i < CG_CALLEE_SAVED_REGISTERS; i++) {
+		if (owners[i] < 0) {
+			return i;
+		}
+	}
+
+	return CG_NO_REGISTER;
+}
+
+/**
+ * <p>
+ * Hands the register of the hinted operand over to the interval, if
+ * the operand dies at the start of the interval (e.g. the source of a
+ * move), so the move disappears.
+ * </p>
+ *
+ * @returns The taken register or CG_NO_REGISTER
+ *
+ * @param *generator    Generator with the intervals
+ * @param *current      Interval, that is allocated
+ * @param *active       Registers of the active intervals
+ * @param *activeCount  Number of active intervals
+ */
+int CG_take_hinted_register(struct CGGenerator *generator, struct CGInterval *current, int *active, int *activeCount) {
+	int hint = current->hint;
+
+	if (hint == IR_NO_REGISTER || current->hintPosition != current->start || generator->physical[hint] == CG_NO_REGISTER) {
+		return CG_NO_REGISTER;
+	}
+
+	struct CGInterval *hinted = &generator->intervals[hint];
+	int physical = generator->physical[hint];
+
+	if (hinted->end != current->start || hinted->floating != current->floating
+		|| (current->crossesCall == true && (current->floating == true || physical >= CG_CALLEE_SAVED_REGISTERS))) {
+		return CG_NO_REGISTER;
+	}
+
+	for (int i = 0; i < *activeCount; i++) {
+		if (active[i] == hint) {
+			active[i] = active[--(*activeCount)];
+			return physical;
+		}
+	}
+
+	return CG_NO_REGISTER;
+}
+
+void CG_spill(struct CGGenerator *generator, int reg) {
+	generator->slot[reg] = generator->spillSlots++;
+	(void)ST_count(COUNTER_SPILLS, 1);
+}
+
+/**
+ * <p>
+ * Computes the layout of the stack frame and the operands of all
+ * virtual registers.
+ * </p>
+ *
+ * <p>
+ * The frame (below the saved {@code %rbp}) holds the saved registers,
+ * the spill slots, the staging slots and the outgoing stack arguments,
+ * its size keeps {@code %rsp} aligned to 16 bytes.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ */
+void CG_compute_frame(struct CGGenerator *generator) {
+	struct IRFunction *function = generator->function;
+	generator->stagingSlots = function->paramCount;
+	generator->outgoingSlots = 0;
+
+	for (int i = 0; i < CG_CALLEE_SAVED_REGISTERS; i++) {
+		generator->savedRegisters += generator->usedCalleeSaved[i] == true ? 1 : 0;
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+
+		if (instruction->opcode != IR_CALL) {
+			continue;
+		}
+
+		int integers = 0;
+		int floatings = 0;
+		int stackArguments = 0;
+
+		for (int n = 0; n < instruction->c; n++) {
+			int floating = (int)CG_is_floating_type(function->registers[function->arguments[instruction->b + n]].type);
+			int *used = floating == true ? &floatings : &integers;
+			stackArguments += *used >= (floating == true ? 8 : 6) ? 1 : 0;
+			(*used)++;
+		}
+
+		generator->stagingSlots = instruction->c > generator->stagingSlots ? instruction->c : generator->stagingSlots;
+		generator->outgoingSlots = stackArguments > generator->outgoingSlots ? stackArguments : generator->outgoingSlots;
+	}
+
+	generator->operands = (char(*)[24])CG_allocate(function->registerCount, sizeof(char[24]));
+
+	for (size_t i = 0; i < function->registerCount; i++) {
+		if (generator->physical[i] != CG_NO_REGISTER) {
+			const char **names = generator->intervals[i].floating == true ? CG_FLOATING_REGISTER_NAMES : CG_INTEGER_REGISTER_NAMES;
+			(void)snprintf(generator->operands[i], sizeof(generator->operands[i]), "%s", names[generator->physical[i]]);
+		} else if (generator->slot[i] != CG_NO_REGISTER) {
+			int offset = 8 * (generator->savedRegisters + generator->slot[i] + 1);
+			(void)snprintf(generator->operands[i], sizeof(generator->operands[i]), "-%i(%%rbp)", offset);
+		}
+	}
+}
+
+/*
+Purpose: Write the prologue, that saves the used callee-saved registers and reserves the frame
+Return Type: void
+Params: struct CGGenerator *generator => Generator with the computed frame
+*/
+void CG_write_prologue(struct CGGenerator *generator) {
+	int size = 8 * (generator->savedRegisters + generator->spillSlots + generator->stagingSlots + generator->outgoingSlots);
+	size = (size + 15) & ~15;
+
+	(void)CG_emit(generator, "pushq %%rbp");
+	(void)CG_emit(generator, "movq %%rsp, %%rbp");
+
+	for (int i = 0; i < CG_CALLEE_SAVED_REGISTERS; i++) {
+		if (generator->usedCalleeSaved[i] == true) {
+			(void)CG_emit(generator, "pushq %s", CG_INTEGER_REGISTER_NAMES[i]);
+		}
+	}
+
+	if (size > 8 * generator->savedRegisters) {
+		(void)CG_emit(generator, "subq $%i, %%rsp", size - 8 * generator->savedRegisters);
+	}
+}
+
+/*
+Purpose: Move the incoming parameters into their allocated locations
+Return Type: void
+Params: struct CGGenerator *generator => Generator with the allocated registers
+*/
+void CG_write_parameters(struct CGGenerator *generator) {
+	struct IRFunction *function = generator->function;
+	char (*sources)[24] = (char(*)[24])CG_allocate((size_t)function->paramCount, sizeof(char[24]));
+	int integers = 0;
+	int floatings = 0;
+	int stackArguments = 0;
+
+	for (int i = 0; i < function->paramCount; i++) {
+		int floating = generator->intervals[i].floating;
+		int *used = floating == true ? &floatings : &integers;
+
+		if (*used < (floating == true ? 8 : 6)) {
+			const char *name = floating == true ? CG_FLOATING_ARGUMENTS[*used] : CG_INTEGER_ARGUMENTS[*used];
+			(void)snprintf(sources[i], sizeof(sources[i]), "%s", name);
+		} else {
+			(void)snprintf(sources[i], sizeof(sources[i]), "%i(%%rbp)", 16 + 8 * stackArguments++);
+		}
+
+		(*used)++;
+	}
+
+	(void)CG_write_moves(generator, sources, generator->operands, function->paramCount);
+	(void)free(sources);
+}
+
+/**
+ * <p>
+ * Writes moves, that happen at the same time (parameters and arguments).
+ * </p>
+ *
+ * <p>
+ * If a move would overwrite the source of a later move, all register
+ * sources are copied into the staging slots first. Empty targets are
+ * skipped.
+ * </p>
+ *
+ * @param *generator    Generator with the computed frame
+ * @param *sources      Operands to read
+ * @param *targets      Operands to write
+ * @param count         Number of moves
+ */
+void CG_write_moves(struct CGGenerator *generator, char (*sources)[24], char (*targets)[24], int count) {
+	int staged = false;
+
+	for (int i = 0; i < count && staged == false; i++) {
+		for (int n = 0; n < i; n++) {
+			staged = strcmp(targets[n], sources[i]) == 0 ? true : staged;
+		}
+	}
+
+	for (int i = 0; i < count && staged == true; i++) {
+		if (CG_is_memory(sources[i]) == false && targets[i][0] != '\0') {
+			char staging[24];
+			(void)snprintf(staging, sizeof(staging), "-%i(%%rbp)", 8 * (generator->savedRegisters + generator->spillSlots + i + 1));
+			(void)CG_move(generator, sources[i], staging);
+			(void)snprintf(sources[i], sizeof(sources[i]), "%s", staging);
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (targets[i][0] != '\0') {
+			(void)CG_move(generator, sources[i], targets[i]);
+		}
+	}
+}
+
+void CG_write_epilogue(struct CGGenerator *generator) {
+	(void)fprintf(generator->output, ".Lspace_return_%lu:\n", (unsigned long)generator->functionIndex);
+
+	if (generator->savedRegisters == 0) {
+		(void)CG_emit(generator, "leave");
+		(void)CG_emit(generator, "ret");
+		return;
+	}
+
+	(void)CG_emit(generator, "leaq -%i(%%rbp), %%rsp", 8 * generator->savedRegisters);
+
+	for (int i = CG_CALLEE_SAVED_REGISTERS - 1; i >= 0; i--) {
+		if (generator->usedCalleeSaved[i] == true) {
+			(void)CG_emit(generator, "popq %s", CG_INTEGER_REGISTER_NAMES[i]);
+		}
+	}
+
+	(void)CG_emit(generator, "popq %%rbp");
+	(void)CG_emit(generator, "ret");
+}
+
+/*
+Purpose: Write the assembly of a single IR instruction
+Return Type: void
+Params: struct CGGenerator *generator => Generator with the allocated registers;
+		struct IRInstruction *instruction => Instruction to translate;
+		int nextBlock => Block, that follows the block of the instruction
+*/
+void CG_write_instruction(struct CGGenerator *generator, struct IRInstruction *instruction, int nextBlock) {
+	char (*operands)[24] = generator->operands;
+	unsigned long index = (unsigned long)generator->functionIndex;
+	int floating = (int)CG_is_floating_type(instruction->type);
+	int a = instruction->a;
+	int b = instruction->b;
+
+	switch (instruction->opcode) {
+	case IR_NOP:
+		break;
+	case IR_CONST_INT:
+		if (instruction->value.integer >= INT32_MIN && instruction->value.integer <= INT32_MAX) {
+			(void)CG_emit(generator, "movq $%lld, %s", instruction->value.integer, operands[instruction->dest]);
+			break;
+		}
+
+		(void)CG_emit(generator, "movabsq $%lld, %%rax", instruction->value.integer);
+		(void)CG_move(generator, "%rax", operands[instruction->dest]);
+		break;
+	case IR_CONST_FLOAT: {
+		double value = instruction->type == FLOAT ? (double)(float)instruction->value.floating : instruction->value.floating;
+		long long bits = 0;
+		(void)memcpy(&bits, &value, sizeof(double));
+		(void)CG_emit(generator, "movabsq $%lld, %%rax", bits);
+		(void)CG_move(generator, "%rax", operands[instruction->dest]);
+		break;
+	}
+	case IR_CONST_STRING:
+		(void)CG_emit(generator, "leaq .Lspace_string_%i(%%rip), %%rax", a);
+		(void)CG_move(generator, "%rax", operands[instruction->dest]);
+		break;
+	case IR_MOVE:
+		(void)CG_move(generator, operands[a], operands[instruction->dest]);
+		break;
+	case IR_LOAD_GLOBAL: {
+		char global[48];
+		(void)snprintf(global, sizeof(global), ".Lspace_global_%i(%%rip)", a);
+		(void)CG_move(generator, global, operands[instruction->dest]);
+		break;
+	}
+	case IR_STORE_GLOBAL: {
+		char global[48];
+		(void)snprintf(global, sizeof(global), ".Lspace_global_%i(%%rip)", a);
+		(void)CG_move(generator, operands[b], global);
+		break;
+	}
+	case IR_ADD:
+	case IR_SUB:
+	case IR_MUL:
+	case IR_SHL:
+	case IR_SHR:
+	case IR_BIT_AND:
+	case IR_BIT_OR:
+	case IR_BIT_XOR:
+		if (floating == true) {
+			(void)CG_write_floating_arithmetic(generator, instruction);
+		} else {
+			(void)CG_write_arithmetic(generator, instruction);
+		}
+
+		break;
+	case IR_DIV:
+	case IR_MOD:
+		if (floating == true) {
+			(void)CG_write_floating_arithmetic(generator, instruction);
+		} else {
+			(void)CG_write_division(generator, instruction);
+		}
+
+		break;
+	case IR_NEG:
+		//Floating values are negated by flipping the sign bit
+		(void)CG_move(generator, operands[a], "%rax");
+		(void)CG_emit(generator, floating == true ? "btcq $63, %%rax" : "negq %%rax");
+		(void)CG_write_wrap(generator, floating == true ? DOUBLE : instruction->type);
+		(void)CG_move(generator, "%rax", operands[instruction->dest]);
+		break;
+	case IR_NOT:
+		(void)CG_emit(generator, "cmpq $0, %s", operands[a]);
+		(void)CG_emit(generator, "sete %%al");
+		(void)CG_emit(generator, "movzbl %%al, %%eax");
+		(void)CG_move(generator, "%rax", operands[instruction->dest]);
+		break;
+	case IR_EQ:
+	case IR_NE:
+	case IR_LT:
+	case IR_LE:
+	case IR_GT:
+	case IR_GE:
+		(void)CG_write_comparison(generator, instruction, NULL, nextBlock);
+		break;
+	case IR_CONVERT:
+		(void)CG_write_conversion(generator, instruction);
+		break;
+	case IR_CALL:
+		(void)CG_write_call(generator, instruction);
+		break;
+	case IR_CONCAT:
+	case IR_BUILDER:
+	case IR_APPEND:
+		(void)CG_write_string_operation(generator, instruction);
+		break;
+	case IR_JUMP:
+		if (a != nextBlock) {
+			(void)CG_emit(generator, "jmp .Lspace_%lu_%i", index, a);
+		}
+
+		break;
+	case IR_BRANCH:
+		(void)CG_emit(generator, "cmpq $0, %s", operands[a]);
+		(void)CG_write_branch(generator, "ne", "e", instruction, nextBlock);
+		break;
+	case IR_SWITCH:
+		(void)CG_write_switch(generator, instruction);
+		break;
+	case IR_RETURN:
+		if (a != IR_NO_REGISTER) {
+			int returnsFloating = (int)CG_is_floating_type(generator->function->registers[a].type);
+			(void)CG_move(generator, operands[a], returnsFloating == true ? "%xmm0" : "%rax");
+		}
+
+		//The epilogue follows the last block
+		if (nextBlock != IR_NO_REGISTER) {
+			(void)CG_emit(generator, "jmp .Lspace_return_%lu", index);
+		}
+
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * <p>
+ * Writes an integer operation with two operands.
+ * </p>
+ *
+ * <p>
+ * If the result lives in a register, that isn't the second operand,
+ * the operation is computed in place, otherwise in {@code %rax}. The
+ * values are 64 bit wide, results of the type int, short and char are
+ * computed in {@code %rax} and cut to their width, so the operations
+ * wrap around like in the virtual machine.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Instruction to write
+ */
+void CG_write_arithmetic(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	char (*operands)[24] = generator->operands;
+	const char *dest = operands[instruction->dest];
+	const char *second = operands[instruction->b];
+	const char *target = "%rax";
+	const char *mnemonic = "addq";
+
+	switch (instruction->opcode) {
+	case IR_SUB:
+		mnemonic = "subq";
+		break;
+	case IR_MUL:
+		mnemonic = "imulq";
+		break;
+	case IR_SHL:
+		mnemonic = "shlq";
+		break;
+	case IR_SHR:
+		mnemonic = "sarq";
+		break;
+	case IR_BIT_AND:
+		mnemonic = "andq";
+		break;
+	case IR_BIT_OR:
+		mnemonic = "orq";
+		break;
+	case IR_BIT_XOR:
+		mnemonic = "xorq";
+		break;
+	default:
+		break;
+	}
+
+	//The shift count has to be in %cl (masked to 63 by the processor)
+	if (instruction->opcode == IR_SHL || instruction->opcode == IR_SHR) {
+		(void)CG_move(generator, second, "%rcx");
+		second = "%cl";
+	}
+
+	//Only the results of the bitwise operations and the right shift always fit into their type
+	int wraps = (instruction->opcode == IR_ADD || instruction->opcode == IR_SUB || instruction->opcode == IR_MUL || instruction->opcode == IR_SHL)
+		&& CG_get_wrap(instruction->type) != NULL ? true : false;
+
+	if (wraps == false && CG_is_memory(dest) == false && strcmp(dest, second) != 0) {
+		target = dest;
+	}
+
+	(void)CG_move(generator, operands[instruction->a], target);
+	(void)CG_emit(generator, "%s %s, %s", mnemonic, second, target);
+
+	if (wraps == true) {
+		(void)CG_write_wrap(generator, instruction->type);
+	}
+
+	(void)CG_move(generator, target, dest);
+}
+
+/*
+Purpose: Get the sign extension, that cuts %rax to an integral type
+Return Type: const char* => The instruction or NULL, if the type keeps all 64 bits
+Params: enum VarType type => Type of the value in %rax
+*/
+const char *CG_get_wrap(enum VarType type) {
+	switch (type) {
+	case INTEGER:
+		return "movslq %%eax, %%rax";
+	case SHORT:
+		return "movswq %%ax, %%rax";
+	case CHAR:
+		return "movsbq %%al, %%rax";
+	default:
+		return NULL;
+	}
+}
+
+/*
+Purpose: Cut the result in %rax to its type, so int, short and char wrap around at their width
+Return Type: void
+Params: struct CGGenerator *generator => Generator to write with;
+		enum VarType type => Type of the result
+*/
+void CG_write_wrap(struct CGGenerator *generator, enum VarType type) {
+	const char *extension = CG_get_wrap(type);
+
+	if (extension != NULL) {
+		(void)CG_emit(generator, extension);
+	}
+}
+
+/**
+ * <p>
+ * Writes an integer division or modulo.
+ * </p>
+ *
+ * <p>
+ * A divisor of 0 calls the runtime, which stops the program (an
+ * inlined division names the function, that it was inlined from). A
+ * divisor of -1 is handled separately, because {@code idiv} traps on
+ * the overflow of the smallest value.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Division to write
+ */
+void CG_write_division(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	char (*operands)[24] = generator->operands;
+	size_t divisorChecked = generator->labels++;
+	size_t divide = generator->labels++;
+	size_t done = generator->labels++;
+
+	(void)CG_move(generator, operands[instruction->b], "%rcx");
+	(void)CG_emit(generator, "testq %%rcx, %%rcx");
+	(void)CG_emit(generator, "jne .Lspace_local_%lu", (unsigned long)divisorChecked);
+	(void)CG_emit(generator, "leaq .Lspace_name_%lu(%%rip), %%rdi", (unsigned long)(instruction->origin >= 0 ? (size_t)instruction->origin : generator->functionIndex));
+	(void)CG_emit(generator, "movq $%lu, %%rsi", (unsigned long)instruction->line);
+	(void)CG_emit(generator, "call space_division_by_zero@PLT");
+	(void)fprintf(generator->output, ".Lspace_local_%lu:\n", (unsigned long)divisorChecked);
+	(void)CG_move(generator, operands[instruction->a], "%rax");
+	(void)CG_emit(generator, "cmpq $-1, %%rcx");
+	(void)CG_emit(generator, "jne .Lspace_local_%lu", (unsigned long)divide);
+	(void)CG_emit(generator, instruction->opcode == IR_DIV ? "negq %%rax" : "xorl %%edx, %%edx");
+	(void)CG_emit(generator, "jmp .Lspace_local_%lu", (unsigned long)done);
+	(void)fprintf(generator->output, ".Lspace_local_%lu:\n", (unsigned long)divide);
+	(void)CG_emit(generator, "cqto");
+	(void)CG_emit(generator, "idivq %%rcx");
+	(void)fprintf(generator->output, ".Lspace_local_%lu:\n", (unsigned long)done);
+
+	//Only the quotient of the smallest value and -1 overflows, the remainder is always smaller than the divisor
+	if (instruction->opcode == IR_DIV) {
+		(void)CG_write_wrap(generator, instruction->type);
+	}
+
+	(void)CG_move(generator, instruction->opcode == IR_DIV ? "%rax" : "%rdx", operands[instruction->dest]);
+}
+
+/**
+ * <p>
+ * Writes a floating operation with two operands.
+ * </p>
+ *
+ * <p>
+ * The modulo calls {@code fmod()} (see CG_is_call), results of the
+ * type {@code float} are rounded to single precision.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Instruction to write
+ */
+void CG_write_floating_arithmetic(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	char (*operands)[24] = generator->operands;
+	const char *dest = operands[instruction->dest];
+	const char *second = operands[instruction->b];
+	const char *target = "%xmm0";
+	const char *mnemonic = "addsd";
+
+	switch (instruction->opcode) {
+	case IR_SUB:
+		mnemonic = "subsd";
+		break;
+	case IR_MUL:
+		mnemonic = "mulsd";
+		break;
+	case IR_DIV:
+		mnemonic = "divsd";
+		break;
+	default:
+		break;
+	}
+
+	if (instruction->opcode == IR_MOD) {
+		(void)CG_move(generator, operands[instruction->a], "%xmm0");
+		(void)CG_move(generator, second, "%xmm1");
+		(void)CG_emit(generator, "call fmod@PLT");
+	} else {
+		if (CG_is_memory(dest) == false && strcmp(dest, second) != 0 && instruction->type != FLOAT) {
+			target = dest;
+		}
+
+		(void)CG_move(generator, operands[instruction->a], target);
+		(void)CG_emit(generator, "%s %s, %s", mnemonic, second, target);
+	}
+
+	if (instruction->type == FLOAT) {
+		(void)CG_emit(generator, "cvtsd2ss %%xmm0, %%xmm0");
+		(void)CG_emit(generator, "cvtss2sd %%xmm0, %%xmm0");
+	}
+
+	(void)CG_move(generator, target, dest);
+}
+
+/**
+ * <p>
+ * Writes a comparison, the result is 0 or 1. If the comparison is
+ * only read by the following branch, the branch jumps on the flags
+ * directly.
+ * </p>
+ *
+ * <p>
+ * Floating comparisons are ordered, so every comparison with NaN is
+ * false (except of {@code !=}). {@code a < b} is written as
+ * {@code b > a}, because {@code seta} / {@code setae} are false for
+ * unordered operands.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Comparison to write
+ * @param *branch       Branch on the result or NULL
+ * @param nextBlock     Block, that follows the block of the comparison
+ */
+void CG_write_comparison(struct CGGenerator *generator, struct IRInstruction *instruction, struct IRInstruction *branch, int nextBlock) {
+	const char *integerConditions[] = {"e", "ne", "l", "le", "g", "ge"};
+	const char *integerInverses[] = {"ne", "e", "ge", "g", "le", "l"};
+	char (*operands)[24] = generator->operands;
+	const char *first = operands[instruction->a];
+	const char *second = operands[instruction->b];
+	int floating = generator->intervals[instruction->a].floating;
+	int index = instruction->opcode - IR_EQ;
+
+	if (floating == true) {
+		if (instruction->opcode == IR_LT || instruction->opcode == IR_LE) {
+			first = operands[instruction->b];
+			second = operands[instruction->a];
+		}
+
+		if (CG_is_memory(first) == true) {
+			(void)CG_move(generator, first, "%xmm0");
+			first = "%xmm0";
+		}
+
+		(void)CG_emit(generator, "ucomisd %s, %s", second, first);
+
+		switch (instruction->opcode) {
+		case IR_EQ:
+			(void)CG_emit(generator, "sete %%al");
+			(void)CG_emit(generator, "setnp %%cl");
+			(void)CG_emit(generator, "andb %%cl, %%al");
+			break;
+		case IR_NE:
+			(void)CG_emit(generator, "setne %%al");
+			(void)CG_emit(generator, "setp %%cl");
+			(void)CG_emit(generator, "orb %%cl, %%al");
+			break;
+		case IR_LT:
+		case IR_GT:
+			if (branch != NULL) {
+				(void)CG_write_branch(generator, "a", "be", branch, nextBlock);
+				return;
+			}
+
+			(void)CG_emit(generator, "seta %%al");
+			break;
+		default:
+			if (branch != NULL) {
+				(void)CG_write_branch(generator, "ae", "b", branch, nextBlock);
+				return;
+			}
+
+			(void)CG_emit(generator, "setae %%al");
+			break;
+		}
+
+		//The flags of == and != need two conditions, so the branch tests the result
+		if (branch != NULL) {
+			(void)CG_emit(generator, "testb %%al, %%al");
+			(void)CG_write_branch(generator, "ne", "e", branch, nextBlock);
+			return;
+		}
+	} else {
+		if (CG_is_memory(first) == true && CG_is_memory(second) == true) {
+			(void)CG_move(generator, first, "%rax");
+			first = "%rax";
+		}
+
+		(void)CG_emit(generator, "cmpq %s, %s", second, first);
+
+		if (branch != NULL) {
+			(void)CG_write_branch(generator, integerConditions[index], integerInverses[index], branch, nextBlock);
+			return;
+		}
+
+		(void)CG_emit(generator, "set%s %%al", integerConditions[index]);
+	}
+
+	(void)CG_emit(generator, "movzbl %%al, %%eax");
+	(void)CG_move(generator, "%rax", operands[instruction->dest]);
+}
+
+/*
+Purpose: Write the jumps of a branch, that tests the flags
+Return Type: void
+Params: struct CGGenerator *generator => Generator, that receives the assembly;
+		const char *condition => Condition code of the true target;
+		const char *inverse => Condition code of the false target;
+		struct IRInstruction *branch => Branch to write;
+		int nextBlock => Block, that follows the block of the branch
+*/
+void CG_write_branch(struct CGGenerator *generator, const char *condition, const char *inverse, struct IRInstruction *branch, int nextBlock) {
+	unsigned long index = (unsigned long)generator->functionIndex;
+
+	if (branch->b == nextBlock) {
+		(void)CG_emit(generator, "j%s .Lspace_%lu_%i", inverse, index, branch->c);
+	} else if (branch->c == nextBlock) {
+		(void)CG_emit(generator, "j%s .Lspace_%lu_%i", condition, index, branch->b);
+	} else {
+		(void)CG_emit(generator, "j%s .Lspace_%lu_%i", condition, index, branch->b);
+		(void)CG_emit(generator, "jmp .Lspace_%lu_%i", index, branch->c);
+	}
+}
+
+/**
+ * <p>
+ * Writes a switch as a jump table.
+ * </p>
+ *
+ * <p>
+ * The value is moved to the first entry of the table, a value outside of
+ * the table becomes a large unsigned number and goes to the default block
+ * with a single comparison. The entries are the offsets of the blocks from
+ * the table, so the table doesn't need relocations.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Switch to write
+ */
+void CG_write_switch(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	unsigned long index = (unsigned long)generator->functionIndex;
+	unsigned long table = (unsigned long)generator->labels++;
+	int *cases = &generator->function->cases[instruction->b];
+	long long low = instruction->value.integer;
+
+	(void)CG_move(generator, generator->operands[instruction->a], "%rax");
+
+	if (low >= INT32_MIN && low <= INT32_MAX) {
+		if (low != 0) {
+			(void)CG_emit(generator, "subq $%lld, %%rax", low);
+		}
+	} else {
+		(void)CG_emit(generator, "movabsq $%lld, %%rcx", low);
+		(void)CG_emit(generator, "subq %%rcx, %%rax");
+	}
+
+	(void)CG_emit(generator, "cmpq $%i, %%rax", instruction->c);
+	(void)CG_emit(generator, "jae .Lspace_%lu_%i", index, cases[0]);
+	(void)CG_emit(generator, "leaq .Lspace_local_%lu(%%rip), %%rcx", table);
+	(void)CG_emit(generator, "movslq (%%rcx,%%rax,4), %%rax");
+	(void)CG_emit(generator, "addq %%rcx, %%rax");
+	(void)CG_emit(generator, "jmp *%%rax");
+
+	(void)fprintf(generator->output, "\t.pushsection .rodata\n\t.align 4\n.Lspace_local_%lu:\n", table);
+
+	for (int i = 1; i <= instruction->c; i++) {
+		(void)fprintf(generator->output, "\t.long .Lspace_%lu_%i - .Lspace_local_%lu\n", index, cases[i], table);
+	}
+
+	(void)fprintf(generator->output, "\t.popsection\n");
+}
+
+/**
+ * <p>
+ * Writes the conversion of a number into another numeric type.
+ * </p>
+ *
+ * <p>
+ * The conversions behave like the ones of the virtual machine:
+ * floating values are saturated, when converted into an integer
+ * (NaN becomes 0), smaller integers are sign extended.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Conversion to write
+ */
+void CG_write_conversion(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	char (*operands)[24] = generator->operands;
+	const char *source = operands[instruction->a];
+	const char *dest = operands[instruction->dest];
+	enum VarType from = generator->function->registers[instruction->a].type;
+	enum VarType to = instruction->type;
+
+	if ((int)CG_is_floating_type(to) == true) {
+		if ((int)CG_is_floating_type(from) == false) {
+			(void)CG_emit(generator, "pxor %%xmm0, %%xmm0");
+			(void)CG_emit(generator, "cvtsi2sdq %s, %%xmm0", source);
+			source = "%xmm0";
+			from = DOUBLE;
+		}
+
+		if (to == FLOAT && from == DOUBLE) {
+			(void)CG_move(generator, source, "%xmm0");
+			(void)CG_emit(generator, "cvtsd2ss %%xmm0, %%xmm0");
+			(void)CG_emit(generator, "cvtss2sd %%xmm0, %%xmm0");
+			source = "%xmm0";
+		}
+
+		(void)CG_move(generator, source, dest);
+		return;
+	}
+
+	if ((int)CG_is_floating_type(from) == true) {
+		size_t done = generator->labels++;
+		(void)CG_move(generator, source, "%xmm0");
+		(void)CG_emit(generator, "xorl %%eax, %%eax");
+		(void)CG_emit(generator, "ucomisd %%xmm0, %%xmm0");
+		(void)CG_emit(generator, "jp .Lspace_local_%lu", (unsigned long)done);
+		(void)CG_emit(generator, "movabsq $9223372036854775807, %%rax");
+		(void)CG_emit(generator, "movabsq $4890909195324358656, %%rcx");
+		(void)CG_emit(generator, "movq %%rcx, %%xmm1");
+		(void)CG_emit(generator, "ucomisd %%xmm1, %%xmm0");
+		(void)CG_emit(generator, "jae .Lspace_local_%lu", (unsigned long)done);
+		(void)CG_emit(generator, "cvttsd2siq %%xmm0, %%rax");
+		(void)fprintf(generator->output, ".Lspace_local_%lu:\n", (unsigned long)done);
+		source = "%rax";
+		from = LONG;
+	}
+
+	const char *extension = NULL;
+
+	switch (to) {
+	case INTEGER:
+		extension = from == LONG ? "movslq %%eax, %%rax" : NULL;
+		break;
+	case SHORT:
+		extension = from == LONG || from == INTEGER ? "movswq %%ax, %%rax" : NULL;
+		break;
+	case CHAR:
+		extension = from != CHAR ? "movsbq %%al, %%rax" : NULL;
+		break;
+	default:
+		break;
+	}
+
+	if (extension != NULL) {
+		(void)CG_move(generator, source, "%rax");
+		(void)CG_emit(generator, extension);
+		source = "%rax";
+	}
+
+	(void)CG_move(generator, source, dest);
+}
+
+/**
+ * <p>
+ * Writes a call of a SPACE function.
+ * </p>
+ *
+ * <p>
+ * The arguments are passed like in the System V ABI, the stack
+ * arguments are written into the outgoing slots at {@code %rsp}.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Call to write
+ */
+void CG_write_call(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	struct IRFunction *function = generator->function;
+	int *arguments = &function->arguments[instruction->b];
+	char (*sources)[24] = (char(*)[24])CG_allocate((size_t)instruction->c, sizeof(char[24]));
+	char (*targets)[24] = (char(*)[24])CG_allocate((size_t)instruction->c, sizeof(char[24]));
+	char symbol[256];
+	int integers = 0;
+	int floatings = 0;
+	int stackArguments = 0;
+
+	for (int i = 0; i < instruction->c; i++) {
+		int floating = generator->intervals[arguments[i]].floating;
+		int *used = floating == true ? &floatings : &integers;
+		(void)snprintf(sources[i], sizeof(sources[i]), "%s", generator->operands[arguments[i]]);
+
+		if (*used < (floating == true ? 8 : 6)) {
+			(void)snprintf(targets[i], sizeof(targets[i]), "%s", floating == true ? CG_FLOATING_ARGUMENTS[*used] : CG_INTEGER_ARGUMENTS[*used]);
+		} else {
+			(void)snprintf(targets[i], sizeof(targets[i]), "%i(%%rsp)", 8 * stackArguments++);
+		}
+
+		(*used)++;
+	}
+
+	(void)CG_write_moves(generator, sources, targets, instruction->c);
+	(void)free(sources);
+	(void)free(targets);
+	(void)CG_write_symbol(generator, symbol, (size_t)instruction->a);
+	(void)CG_emit(generator, "call %s", symbol);
+
+	if (instruction->dest != IR_NO_REGISTER) {
+		int floating = generator->intervals[instruction->dest].floating;
+		(void)CG_move(generator, floating == true ? "%xmm0" : "%rax", generator->operands[instruction->dest]);
+	}
+}
+
+/**
+ * <p>
+ * Writes a string operation, it calls the runtime (see CG_is_call).
+ * </p>
+ *
+ * <p>
+ * The operands pass through the scratch registers, since they can live
+ * in the argument registers.
+ * </p>
+ *
+ * @param *generator    Generator with the allocated registers
+ * @param *instruction  Concatenation, builder or append to write
+ */
+void CG_write_string_operation(struct CGGenerator *generator, struct IRInstruction *instruction) {
+	char (*operands)[24] = generator->operands;
+	const char *function = "space_string_concat";
+
+	switch (instruction->opcode) {
+	case IR_BUILDER:
+		function = "space_string_builder";
+		break;
+	case IR_APPEND:
+		function = "space_string_append";
+		break;
+	default:
+		break;
+	}
+
+	(void)CG_move(generator, operands[instruction->a], "%rax");
+
+	if (instruction->opcode != IR_BUILDER) {
+		(void)CG_move(generator, operands[instruction->b], "%rcx");
+		(void)CG_emit(generator, "movq %%rcx, %%rsi");
+	}
+
+	(void)CG_emit(generator, "movq %%rax, %%rdi");
+	(void)CG_emit(generator, "call %s@PLT", function);
+	(void)CG_move(generator, "%rax", operands[instruction->dest]);
+}
+
+/**
+ * <p>
+ * Writes the globals, the strings and the table of the globals,
+ * that is read by the runtime.
+ * </p>
+ *
+ * @param *generator    Generator with the module
+ */
+void CG_write_data(struct CGGenerator *generator) {
+	struct IRModule *module = generator->module;
+	FILE *output = generator->output;
+
+	if (module->globalCount > 0) {
+		(void)fprintf(output, "\n\t.bss\n\t.align 8\n");
+	}
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		(void)fprintf(output, ".Lspace_global_%lu:\n\t.zero 8\n", (unsigned long)i);
+	}
+
+	(void)fprintf(output, "\n\t.section .rodata\n");
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		(void)fprintf(output, ".Lspace_name_%lu:\n\t.string \"%s\"\n", (unsigned long)i, module->functions[i]->name);
+	}
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		(void)fprintf(output, ".Lspace_global_name_%lu:\n\t.string \"%s\"\n", (unsigned long)i, module->globals[i].name);
+		(void)fprintf(output, ".Lspace_global_type_%lu:\n\t.string \"%s\"\n", (unsigned long)i, IR_get_type_name(module->globals[i].type));
+	}
+
+	for (size_t i = 0; i < module->stringCount; i++) {
+		(void)fprintf(output, ".Lspace_string_%lu:\n\t.string \"", (unsigned long)i);
+
+		for (char *character = module->strings[i]; *character != '\0'; character++) {
+			unsigned char value = (unsigned char)*character;
+
+			if (value == '"' || value == '\\') {
+				(void)fprintf(output, "\\%c", value);
+			} else if (value < 32 || value > 126) {
+				(void)fprintf(output, "\\%03o", value);
+			} else {
+				(void)fputc(value, output);
+			}
+		}
+
+		(void)fprintf(output, "\"\n");
+	}
+
+	(void)fprintf(output, "\n\t.section .data.rel.ro, \"aw\"\n\t.align 8\n");
+	(void)fprintf(output, "\t.globl space_globals\nspace_globals:\n");
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		unsigned long index = (unsigned long)i;
+		(void)fprintf(output, "\t.quad .Lspace_global_name_%lu, .Lspace_global_type_%lu, %i, .Lspace_global_%lu\n",
+			index, index, (int)CG_get_value_kind(module->globals[i].type), index);
+	}
+
+	(void)fprintf(output, "\t.globl space_global_count\nspace_global_count:\n\t.quad %lu\n", (unsigned long)module->globalCount);
+	(void)fprintf(output, "\n\t.section .note.GNU-stack, \"\", @progbits\n");
+}
+
+/*
+Purpose: Write the assembly symbol of a function into the buffer (256 characters)
+Return Type: void
+Params: struct CGGenerator *generator => Generator with the module;
+		char *buffer => Buffer, that receives the symbol;
+		size_t index => Index of the function
+*/
+void CG_write_symbol(struct CGGenerator *generator, char *buffer, size_t index) {
+	if ((int)index == generator->module->entryFunction) {
+		(void)snprintf(buffer, 256, "space_main");
+		return;
+	}
+
+	(void)snprintf(buffer, 256, "space_fn_%s", generator->module->functions[index]->name);
+}
+
+/*
+Purpose: Copy 64 bits between two operands (registers of both classes or memory)
+Return Type: void
+Params: struct CGGenerator *generator => Generator, that receives the assembly;
+		const char *source => Operand to read;
+		const char *dest => Operand to write
+*/
+void CG_move(struct CGGenerator *generator, const char *source, const char *dest) {
+	if (strcmp(source, dest) == 0) {
+		return;
+	} else if (CG_is_memory(source) == true && CG_is_memory(dest) == true) {
+		(void)CG_emit(generator, "movq %s, %%rax", source);
+		(void)CG_emit(generator, "movq %%rax, %s", dest);
+	} else if (strncmp(source, "%xmm", 4) == 0 && strncmp(dest, "%xmm", 4) == 0) {
+		(void)CG_emit(generator, "movapd %s, %s", source, dest);
+	} else {
+		(void)CG_emit(generator, "movq %s, %s", source, dest);
+	}
+}
+
+void CG_emit(struct CGGenerator *generator, const char *format, ...) {
+	va_list arguments;
+	va_start(arguments, format);
+	(void)fputc('\t', generator->output);
+	(void)vfprintf(generator->output, format, arguments);
+	(void)fputc('\n', generator->output);
+	va_end(arguments);
+	(void)ST_count(COUNTER_ASM_INSTRUCTIONS, 1);
+}
+
+/*
+Purpose: Get the registers, that are read by an instruction
+Return Type: int => Number of read registers
+Params: struct IRFunction *function => Function of the instruction;
+		struct IRInstruction *instruction => Instruction to check;
+		int **uses => Receives the registers (the buffer or the arguments of a call);
+		int *buffer => Buffer for up to two registers
+*/
+int CG_get_uses(struct IRFunction *function, struct IRInstruction *instruction, int **uses, int *buffer) {
+	*uses = buffer;
+
+	switch (instruction->opcode) {
+	case IR_MOVE:
+	case IR_NEG:
+	case IR_NOT:
+	case IR_CONVERT:
+	case IR_BRANCH:
+	case IR_SWITCH:
+	case IR_BUILDER:
+		buffer[0] = instruction->a;
+		return 1;
+	case IR_CONCAT:
+	case IR_APPEND:
+		buffer[0] = instruction->a;
+		buffer[1] = instruction->b;
+		return 2;
+	case IR_STORE_GLOBAL:
+		buffer[0] = instruction->b;
+		return 1;
+	case IR_RETURN:
+		buffer[0] = instruction->a;
+		return instruction->a != IR_NO_REGISTER ? 1 : 0;
+	case IR_CALL:
+		*uses = &function->arguments[instruction->b];
+		return instruction->c;
+	default:
+		if (instruction->opcode >= IR_ADD && instruction->opcode <= IR_GE) {
+			buffer[0] = instruction->a;
+			buffer[1] = instruction->b;
+			return 2;
+		}
+
+		return 0;
+	}
+}
+
+/*
+Purpose: Get the operand, whose register should be reused for the result
+Return Type: int => Register of the operand or IR_NO_REGISTER
+Params: struct IRInstruction *instruction => Instruction, that defines the result
+*/
+int CG_get_hint(struct IRInstruction *instruction) {
+	switch (instruction->opcode) {
+	case IR_MOVE:
+	case IR_NEG:
+	case IR_CONVERT:
+	case IR_ADD:
+	case IR_SUB:
+	case IR_MUL:
+	case IR_SHL:
+	case IR_SHR:
+	case IR_BIT_AND:
+	case IR_BIT_OR:
+	case IR_BIT_XOR:
+		return instruction->a;
+	default:
+		return IR_NO_REGISTER;
+	}
+}
+
+int CG_get_definition(struct IRInstruction *instruction) {
+	switch (instruction->opcode) {
+	case IR_NOP:
+	case IR_STORE_GLOBAL:
+	case IR_JUMP:
+	case IR_BRANCH:
+	case IR_SWITCH:
+	case IR_RETURN:
+	case IR_RESUME:
+		return IR_NO_REGISTER;
+	default:
+		return instruction->dest;
+	}
+}
+
+/*
+Purpose: Check whether an instruction calls a function (and clobbers the caller-saved registers)
+Return Type: int => true = is a call; false = no call
+Params: struct IRInstruction *instruction => Instruction to check
+*/
+int CG_is_call(struct IRInstruction *instruction) {
+	if (instruction->opcode == IR_CALL || instruction->opcode == IR_CONCAT || instruction->opcode == IR_BUILDER || instruction->opcode == IR_APPEND) {
+		return true;
+	}
+
+	return instruction->opcode == IR_MOD && (int)CG_is_floating_type(instruction->type) == true ? true : false;
+}
+
+int CG_is_floating_type(enum VarType type) {
+	return type == DOUBLE || type == FLOAT ? true : false;
+}
+
+int CG_is_memory(const char *operand) {
+	return operand[0] != '%' ? true : false;
+}
+
+enum CGValueKind CG_get_value_kind(enum VarType type) {
+	switch (type) {
+	case DOUBLE:
+	case FLOAT:
+		return CG_KIND_FLOATING;
+	case BOOLEAN:
+		return CG_KIND_BOOLEAN;
+	case CHAR:
+		return CG_KIND_CHAR;
+	case STRING:
+		return CG_KIND_STRING;
+	default:
+		return CG_KIND_INTEGER;
+	}
+}
+
+int CG_compare_intervals(const void *first, const void *second) {
+	const struct CGInterval *firstInterval = (const struct CGInterval*)first;
+	const struct CGInterval *secondInterval = (const struct CGInterval*)second;
+
+	if (firstInterval->start != secondInterval->start) {
+		return firstInterval->start < secondInterval->start ? -1 : 1;
+	}
+
+	return firstInterval->reg - secondInterval->reg;
+}
+
+void *CG_allocate(size_t count, size_t size) {
+	void *memory = calloc(count == 0 ? 1 : count, size);
+
+	if (memory == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return NULL;
+	}
+
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, count * size);
+	return memory;
+}
+
+void CG_free_function_data(struct CGGenerator *generator) {
+	(void)free(generator->intervals);
+	(void)free(generator->useCounts);
+	(void)free(generator->physical);
+	(void)free(generator->slot);
+	(void)free(generator->operands);
+	generator->intervals = NULL;
+	generator->useCounts = NULL;
+	generator->physical = NULL;
+	generator->slot = NULL;
+	generator->operands = NULL;
+}
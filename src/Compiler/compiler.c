@@ -0,0 +1,317 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/parsetree.h"
+#include "../../headers/semantic.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+#include "../../headers/vm.h"
+#include "../../headers/compiler.h"
+
+/**
+ * The subprogram {@code SPACE/src/Compiler/compiler.c} was created
+ * to run the compiler as library on a source in memory.
+ *
+ * The caller hands in a name and the source (which stays owned by the
+ * caller) and gets a CompileResult with the diagnostics, tokens,
+ * parsetree, symbol tables, IR and bytecode. No file is touched.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Globals of the compiler pipeline, shared by all phases
+char *FILE_NAME = NULL;
+char **BUFFER = NULL;
+size_t BUFFER_LENGTH = 0;
+size_t TOKEN_LENGTH = 0;
+struct LineIndex *LINE_INDEX = NULL;
+
+//Streams of the dumps (NULL = no dump)
+FILE *TOKEN_DUMP = NULL;
+FILE *AST_DUMP = NULL;
+FILE *SYMBOL_DUMP = NULL;
+FILE *LAYOUT_DUMP = NULL;
+FILE *IR_DUMP = NULL;
+FILE *BYTECODE_DUMP = NULL;
+
+extern size_t maxTokensLength;
+
+void FREE_TABLE(SemanticTable *rootTable);
+
+/**
+ * The phases work on globals, so only one compilation can run at a time.
+ */
+pthread_mutex_t COMPILER_LOCK = PTHREAD_MUTEX_INITIALIZER;
+
+void CP_run_phases(struct CompileResult *result, struct CompilerOptions *options);
+char *CP_copy_source(const char *data, size_t length);
+
+void CP_get_default_options(struct CompilerOptions *options) {
+	options->lastStage = COMPILE_UNTIL_SEMANTIC;
+	options->maxDiagnostics = DIAGNOSTIC_DEFAULT_MAX_ENTRIES;
+	options->optimize = true;
+}
+
+/**
+ * <p>
+ * Creates a new context for the compilations.
+ * </p>
+ * 
+ * @returns A pointer to the context or NULL if it couldn't be allocated
+ * 
+ * @param *defaults     Options for compilations without own options (NULL = CP_get_default_options())
+ */
+struct CompilerContext *CreateNewCompilerContext(struct CompilerOptions *defaults) {
+	struct CompilerContext *context = (struct CompilerContext*)calloc(1, sizeof(struct CompilerContext));
+
+	if (context == NULL) {
+		return NULL;
+	}
+
+	if (defaults != NULL) {
+		context->defaults = *defaults;
+	} else {
+		(void)CP_get_default_options(&context->defaults);
+	}
+
+	return context;
+}
+
+/**
+ * <p>
+ * Compiles a source, that is already in memory.
+ * </p>
+ * 
+ * <p>
+ * The source is copied, so `data` can be freed or reused right after
+ * the call. The diagnostics are collected in the result and never
+ * printed. Fatal errors only end the compilation of this source.
+ * </p>
+ * 
+ * @returns The result (free with FREE_COMPILE_RESULT()) or NULL if no memory is left
+ * 
+ * @param *context  Context of the compilation
+ * @param *name     Name of the source used in the diagnostics
+ * @param *data     The source (doesn't need a '\0')
+ * @param length    Length of the source
+ * @param *options  Options of the compilation (NULL = defaults of the context)
+ */
+struct CompileResult *CompileBuffer(struct CompilerContext *context, const char *name, const char *data, size_t length, struct CompilerOptions *options) {
+	struct CompilerOptions compilerOptions;
+
+	if (options != NULL) {
+		compilerOptions = *options;
+	} else if (context != NULL) {
+		compilerOptions = context->defaults;
+	} else {
+		(void)CP_get_default_options(&compilerOptions);
+	}
+
+	struct CompileResult *result = (struct CompileResult*)calloc(1, sizeof(struct CompileResult));
+
+	if (result == NULL) {
+		return NULL;
+	}
+
+	result->name = CP_copy_source(name == NULL ? "<buffer>" : name, strlen(name == NULL ? "<buffer>" : name));
+	result->source = CP_copy_source(data == NULL ? "" : data, data == NULL ? 0 : length);
+	result->length = data == NULL ? 0 : length;
+	result->diagnostics = CreateNewDiagnosticSink(compilerOptions.maxDiagnostics);
+
+	if (result->name == NULL || result->source == NULL || result->diagnostics == NULL) {
+		(void)FREE_COMPILE_RESULT(result);
+		return NULL;
+	}
+
+	(void)pthread_mutex_lock(&COMPILER_LOCK);
+	(void)CP_run_phases(result, &compilerOptions);
+
+	if (context != NULL) {
+		context->compilations++;
+		context->failedCompilations += result->status == PHASE_SUCCESS ? 0 : 1;
+	}
+
+	(void)pthread_mutex_unlock(&COMPILER_LOCK);
+	return result;
+}
+
+/**
+ * <p>
+ * Runs the phases on the source of the result.
+ * </p>
+ * 
+ * <p>
+ * The tokens and the buffer are removed from the caches of the error
+ * handler afterwards, they belong to the result and mustn't be freed
+ * by a FREE_MEMORY() of a later compilation.
+ * </p>
+ * 
+ * @param *result   Result with the source, receives the outputs of the phases
+ * @param *options  Options of the compilation
+ */
+void CP_run_phases(struct CompileResult *result, struct CompilerOptions *options) {
+	(void)_init_error_diagnostic_sink_(result->diagnostics);
+	FILE_NAME = result->name;
+
+	struct InputReaderResults input = ProcessBuffer(result->source, result->length);
+	BUFFER = &result->source;
+	BUFFER_LENGTH = result->length;
+	TOKEN_LENGTH = input.requiredTokenNumber;
+	result->status = input.buffer == NULL ? PHASE_ABORTED : PHASE_SUCCESS;
+
+	//Sources without any tokens (e.g. only comments) have nothing to check
+	if (input.buffer == NULL || TOKEN_LENGTH == 0) {
+		(void)FREE_TOKEN_LENGTHS(input.arrayOfIndividualTokenSizes);
+		result->lines = CreateNewLineIndex(result->source, result->length);
+	} else {
+		//The line index is built by the lexer
+		int *arrayOfIndividualTokenSizes = input.arrayOfIndividualTokenSizes;
+		LINE_INDEX = NULL;
+		result->tokens = Tokenize(&arrayOfIndividualTokenSizes);
+		result->tokenCount = maxTokensLength;
+		result->lines = LINE_INDEX;
+		LINE_INDEX = NULL;
+		(void)FREE_TOKEN_LENGTHS(input.arrayOfIndividualTokenSizes);
+		result->status = result->tokens == NULL ? PHASE_ABORTED : PHASE_SUCCESS;
+	}
+
+	if (result->status == PHASE_SUCCESS && result->tokens != NULL && options->lastStage >= COMPILE_UNTIL_SYNTAX) {
+		result->status = CheckInput(&result->tokens);
+	}
+
+	if (result->status == PHASE_SUCCESS && result->tokens != NULL && options->lastStage >= COMPILE_UNTIL_PARSETREE) {
+		result->root = GenerateParsetree(&result->tokens);
+		result->status = result->root == NULL ? PHASE_ABORTED : PHASE_SUCCESS;
+	}
+
+	if (result->status == PHASE_SUCCESS && result->root != NULL && options->lastStage >= COMPILE_UNTIL_SEMANTIC) {
+		result->status = CheckSemantic(result->root, &result->table);
+	}
+
+	if (result->status == PHASE_SUCCESS && result->table != NULL && options->lastStage >= COMPILE_UNTIL_IR) {
+		result->status = GenerateIR(result->root, result->table, &result->module);
+	}
+
+	if (result->status == PHASE_SUCCESS && result->module != NULL && options->optimize == true) {
+		result->status = OptimizeIR(result->module);
+	}
+
+	if (result->status == PHASE_SUCCESS && result->module != NULL && options->lastStage >= COMPILE_UNTIL_BYTECODE) {
+		result->status = GenerateBytecode(result->module, &result->program);
+	}
+
+	//Errors, that were reported without aborting a phase
+	if (result->status == PHASE_SUCCESS && (int)DG_has_errors(result->diagnostics) == true) {
+		result->status = PHASE_ERRORS;
+	}
+
+	TOKEN *noTokens = NULL;
+	char *noBuffer = NULL;
+	(void)_init_error_token_cache_(&noTokens);
+	(void)_init_error_buffer_cache_(&noBuffer);
+	(void)_init_error_diagnostic_sink_(NULL);
+	BUFFER = NULL;
+	BUFFER_LENGTH = 0;
+}
+
+/**
+ * <p>
+ * Renders the diagnostics of a result (with the affected source lines).
+ * </p>
+ * 
+ * @param *result       Result of CompileBuffer()
+ * @param *renderer     Renderer to write the diagnostics with
+ */
+void CP_render_diagnostics(struct CompileResult *result, struct DiagnosticRenderer *renderer) {
+	if (result == NULL || result->diagnostics == NULL) {
+		return;
+	}
+
+	(void)DG_render(renderer, result->diagnostics, result->lines, result->source);
+}
+
+char *CP_copy_source(const char *data, size_t length) {
+	char *copy = (char*)malloc(length + 1);
+
+	if (copy == NULL) {
+		return NULL;
+	}
+
+	(void)memcpy(copy, data, length);
+	copy[length] = '\0';
+	return copy;
+}
+
+/**
+ * <p>
+ * Frees a result with all tokens, nodes, symbol tables, IR, bytecode and diagnostics.
+ * </p>
+ * 
+ * @param *result   Result to free
+ */
+void FREE_COMPILE_RESULT(struct CompileResult *result) {
+	if (result == NULL) {
+		return;
+	}
+
+	if (result->tokens != NULL) {
+		for (size_t i = 0; i < result->tokenCount; i++) {
+			if (result->tokens[i].value != NULL) {
+				(void)free(result->tokens[i].value);
+			}
+		}
+
+		(void)free(result->tokens);
+	}
+
+	if (result->root != NULL) {
+		(void)FREE_NODE(result->root);
+	}
+
+	if (result->table != NULL) {
+		(void)FREE_TABLE(result->table);
+		(void)free(result->table);
+	}
+
+	(void)FREE_IR_MODULE(result->module);
+	(void)FREE_VM_PROGRAM(result->program);
+
+	(void)FREE_LINE_INDEX(result->lines);
+	(void)FREE_DIAGNOSTIC_SINK(result->diagnostics);
+	(void)free(result->source);
+	(void)free(result->name);
+	(void)free(result);
+}
+
+void FREE_COMPILER_CONTEXT(struct CompilerContext *context) {
+	(void)free(context);
+}
@@ -0,0 +1,326 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/blockLayout.c} was created
+ * to order the blocks of the IR, so the likely paths fall through.
+ *
+ * Every block picks the successor, that should follow it directly.
+ * Blocks and their picked successors are linked into chains, the
+ * heaviest edges first, and the chains are placed in the order of
+ * their first block (with a profile the most executed chains come
+ * first, so the cold blocks end up behind the hot code). Without a
+ * profile (see ProfileIR) the order of the lowering is kept, only the
+ * loops are rotated: the condition moves behind the body, so every
+ * iteration ends with a single conditional jump back.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * A fall-through, that a block would like to have.
+ * </p>
+ *
+ * <p>
+ * {@code weight} is the number of executions of the edge (at most the
+ * executions of both blocks) or 1 without a profile. The {@code rank}
+ * decides between edges of the same weight: the jump of a latch to the
+ * header of a rotated loop comes first (2), then the blocks, that
+ * already follow each other (1).
+ * </p>
+ */
+struct OPTEdge {
+	int from;
+	int to;
+	size_t weight;
+	int rank;
+};
+
+int OPT_get_fallthrough(struct IRFunction *function, int block, int *latches, int profiled);
+int OPT_is_rotated(struct IRFunction *function, int header, int *latches);
+int OPT_is_in_loop(int block, int header, int latch);
+int OPT_compare_edges(const void *first, const void *second);
+
+/**
+ * <p>
+ * Orders the blocks of a function, so the likely successor of every
+ * block follows it directly (see docs/optimizer.md).
+ * </p>
+ *
+ * <p>
+ * A loop, whose header ends with a branch out of the loop and is
+ * reached by a jump from the end of the body (the latch), is rotated:
+ * the header is placed behind the latch and falls through into the
+ * exit of the loop. With a profile the more frequent target of a
+ * branch follows it, the other blocks keep their order. The entry
+ * block stays the first block.
+ * </p>
+ *
+ * @returns The number of blocks, that were moved
+ *
+ * @param *function     Function with the blocks (without unreachable blocks)
+ */
+size_t OPT_layout_blocks(struct IRFunction *function) {
+	size_t count = function->blockCount;
+
+	if (count < 3) {
+		return 0;
+	}
+
+	int *latches = (int*)malloc(count * sizeof(int));
+	int *next = (int*)malloc(count * sizeof(int));
+	int *previous = (int*)malloc(count * sizeof(int));
+	int *chains = (int*)malloc(count * sizeof(int));
+	int *order = (int*)malloc(count * sizeof(int));
+	struct OPTEdge *edges = (struct OPTEdge*)malloc(count * sizeof(struct OPTEdge));
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((function->instructionCount + 1) * sizeof(struct IRInstruction));
+
+	if (latches == NULL || next == NULL || previous == NULL || chains == NULL || order == NULL || edges == NULL || instructions == NULL) {
+		(void)free(latches);
+		(void)free(next);
+		(void)free(previous);
+		(void)free(chains);
+		(void)free(order);
+		(void)free(edges);
+		(void)free(instructions);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	int profiled = false;
+
+	for (size_t i = 0; i < count; i++) {
+		latches[i] = -1;
+		next[i] = -1;
+		previous[i] = -1;
+		chains[i] = (int)i;
+		profiled = function->blocks[i].frequency > 0 ? true : profiled;
+	}
+
+	//The last block, that jumps back to a header (the blocks are in the order of the lowering)
+	for (size_t i = 0; i < count; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		struct IRInstruction *last = &function->instructions[block->firstInstruction + block->instructionCount - 1];
+
+		if (last->opcode == IR_JUMP && last->a > 0 && (size_t)last->a < i) {
+			latches[last->a] = (int)i;
+		}
+	}
+
+	size_t edgeCount = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		int target = OPT_get_fallthrough(function, (int)i, latches, profiled);
+
+		//The entry can't follow another block
+		if (target <= 0 || (size_t)target == i) {
+			continue;
+		}
+
+		size_t weight = 1;
+
+		if (profiled == true) {
+			size_t source = function->blocks[i].frequency;
+			size_t destination = function->blocks[target].frequency;
+			weight = source < destination ? source : destination;
+		}
+
+		edges[edgeCount].from = (int)i;
+		edges[edgeCount].to = target;
+		edges[edgeCount].weight = weight;
+		edges[edgeCount].rank = (size_t)target == i + 1 ? 1 : 0;
+
+		if (latches[target] == (int)i && (int)OPT_is_rotated(function, target, latches) == true) {
+			edges[edgeCount].rank = 2;
+		}
+
+		edgeCount++;
+	}
+
+	(void)qsort(edges, edgeCount, sizeof(struct OPTEdge), OPT_compare_edges);
+
+	for (size_t i = 0; i < edgeCount; i++) {
+		int from = edges[i].from;
+		int to = edges[i].to;
+
+		if (next[from] >= 0 || previous[to] >= 0 || chains[from] == chains[to]) {
+			continue;
+		}
+
+		next[from] = to;
+		previous[to] = from;
+
+		for (int block = to; block >= 0; block = next[block]) {
+			chains[block] = chains[from];
+		}
+	}
+
+	//The chains are placed in the order of their first block (with a profile the hot chains first), the entry comes first
+	size_t headCount = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (previous[i] >= 0) {
+			continue;
+		}
+
+		size_t position = headCount++;
+
+		while (profiled == true && position > 1 && function->blocks[chains[position - 1]].frequency < function->blocks[i].frequency) {
+			chains[position] = chains[position - 1];
+			position--;
+		}
+
+		chains[position] = (int)i;
+	}
+
+	size_t placed = 0;
+	size_t moved = 0;
+
+	for (size_t i = 0; i < headCount; i++) {
+		for (int block = chains[i]; block >= 0; block = next[block]) {
+			moved += (size_t)block != placed ? 1 : 0;
+			order[placed++] = block;
+		}
+	}
+
+	//IR_finish_function() renumbers the blocks in the order of their instructions
+	if (moved > 0) {
+		size_t instructionCount = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			struct IRBlock *block = &function->blocks[order[i]];
+			(void)memcpy(&instructions[instructionCount], &function->instructions[block->firstInstruction], block->instructionCount * sizeof(struct IRInstruction));
+			block->firstInstruction = instructionCount;
+			instructionCount += block->instructionCount;
+		}
+
+		(void)memcpy(function->instructions, instructions, instructionCount * sizeof(struct IRInstruction));
+		(void)IR_finish_function(function);
+	}
+
+	(void)free(latches);
+	(void)free(next);
+	(void)free(previous);
+	(void)free(chains);
+	(void)free(order);
+	(void)free(edges);
+	(void)free(instructions);
+	return moved;
+}
+
+/*
+Purpose: Get the successor, that should directly follow a block
+Return Type: int => The successor or -1, if no successor should follow
+Params: struct IRFunction *function => Function of the block;
+		int block => Block to check;
+		int *latches => Latch of every loop header (-1 = no loop header);
+		int profiled => Whether the blocks have their frequencies
+*/
+int OPT_get_fallthrough(struct IRFunction *function, int block, int *latches, int profiled) {
+	struct IRBlock *current = &function->blocks[block];
+	struct IRInstruction *last = &function->instructions[current->firstInstruction + current->instructionCount - 1];
+
+	if (last->opcode == IR_JUMP) {
+		return last->a;
+	} else if (last->opcode != IR_BRANCH) {
+		return -1;
+	}
+
+	//A rotated header falls through into the exit of its loop
+	if ((int)OPT_is_rotated(function, block, latches) == true) {
+		return (int)OPT_is_in_loop(last->b, block, latches[block]) == true ? last->c : last->b;
+	}
+
+	size_t taken = function->blocks[last->b].frequency;
+	size_t notTaken = function->blocks[last->c].frequency;
+
+	if (profiled == true && taken != notTaken) {
+		return taken > notTaken ? last->b : last->c;
+	}
+
+	return last->c == block + 1 ? last->c : last->b;
+}
+
+/*
+Purpose: Check, if a loop header branches into its body and out of the loop
+Return Type: int => true if the header is rotated, else false
+Params: struct IRFunction *function => Function of the header;
+		int header => Block to check;
+		int *latches => Latch of every loop header (-1 = no loop header)
+*/
+int OPT_is_rotated(struct IRFunction *function, int header, int *latches) {
+	int latch = latches[header];
+
+	if (latch < 0) {
+		return false;
+	}
+
+	struct IRBlock *block = &function->blocks[header];
+	struct IRInstruction *last = &function->instructions[block->firstInstruction + block->instructionCount - 1];
+
+	if (last->opcode != IR_BRANCH) {
+		return false;
+	}
+
+	return (int)OPT_is_in_loop(last->b, header, latch) != (int)OPT_is_in_loop(last->c, header, latch) ? true : false;
+}
+
+/*
+Purpose: Check, if a block lies between the header and the latch of a loop
+Return Type: int => true if the block is part of the loop body, else false
+Params: int block => Block to check;
+		int header => Header of the loop;
+		int latch => Last block, that jumps back to the header
+*/
+int OPT_is_in_loop(int block, int header, int latch) {
+	return block > header && block <= latch ? true : false;
+}
+
+int OPT_compare_edges(const void *first, const void *second) {
+	const struct OPTEdge *left = (const struct OPTEdge*)first;
+	const struct OPTEdge *right = (const struct OPTEdge*)second;
+
+	if (left->weight != right->weight) {
+		return left->weight > right->weight ? -1 : 1;
+	} else if (left->rank != right->rank) {
+		return left->rank > right->rank ? -1 : 1;
+	}
+
+	//The last latch of a loop (the end of the body) is preferred over a continue
+	if (left->rank == 2) {
+		return left->from > right->from ? -1 : left->from < right->from ? 1 : 0;
+	}
+
+	return left->from < right->from ? -1 : left->from > right->from ? 1 : 0;
+}
@@ -0,0 +1,859 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/constantFolding.c} was created
+ * to fold and propagate the constants of the IR.
+ *
+ * Every register gets a value of a small lattice (not written yet,
+ * constant or unknown), that is propagated through the blocks, that
+ * can be reached. Registers, that are written once (the temporaries),
+ * have a single value, variables have a value per block. Branches on a
+ * constant only reach one target, so conditions like {@code if (DEBUG)}
+ * drop the dead branch. Operations on constants are computed with the
+ * semantics of the virtual machine, so the results don't change.
+ * String constants are the index of the string in the module, so the
+ * concatenation of two constants becomes a new string of the module.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Position of the store of a global, that can't be propagated
+#define OPT_NO_STORE ((size_t)-1)
+
+//Longest string, that is computed by a folded concatenation (the result is stored in the program)
+#define OPT_MAX_FOLDED_STRING 256
+
+enum OPTLatticeState {
+	OPT_UNDEFINED,
+	OPT_CONSTANT,
+	OPT_VARYING
+};
+
+union OPTNumber {
+	long long integer;
+	double floating;
+};
+
+struct OPTValue {
+	enum OPTLatticeState state;
+	union OPTNumber number;
+};
+
+/**
+ * <p>
+ * State of the folding of a module.
+ * </p>
+ *
+ * <p>
+ * Constant globals, that are stored exactly once in the entry block of
+ * {@code <main>} (before any call), are propagated into all functions.
+ * Registers with more than one definition get a slot in the states of
+ * the blocks, the others only have an entry in {@code values}.
+ * </p>
+ */
+struct OPTFoldContext {
+	struct IRModule *module;
+	struct IRFunction *function;
+	int isEntryFunction;
+
+	struct OPTValue *globals;
+	size_t *globalStores;
+
+	int *slots;
+	size_t slotCount;
+	struct OPTValue *values;
+	struct OPTValue *states;
+	struct OPTValue *current;
+	int *executable;
+	int changed;
+};
+
+void OPT_find_constant_globals(struct OPTFoldContext *context);
+size_t OPT_fold_function(struct OPTFoldContext *context, struct IRFunction *function);
+size_t OPT_visit_block(struct OPTFoldContext *context, size_t block, int rewrite);
+void OPT_reach_block(struct OPTFoldContext *context, int block);
+struct OPTValue OPT_evaluate(struct OPTFoldContext *context, struct IRInstruction *instruction, size_t index);
+struct OPTValue OPT_get_value(struct OPTFoldContext *context, int reg);
+void OPT_set_value(struct OPTFoldContext *context, int reg, struct OPTValue value);
+int OPT_merge_value(struct OPTValue *target, struct OPTValue value);
+int OPT_compute(struct IRInstruction *instruction, enum VarType operandType, union OPTNumber x, union OPTNumber y, union OPTNumber *result);
+int OPT_convert(enum VarType from, enum VarType to, union OPTNumber x, union OPTNumber *result);
+struct OPTValue OPT_concat_constants(struct OPTFoldContext *context, struct OPTValue x, struct OPTValue y);
+void OPT_drop_folded_strings(struct IRModule *module, size_t firstFolded);
+int OPT_is_floating_type(enum VarType type);
+long long OPT_double_to_integer(double value);
+
+/**
+ * <p>
+ * Folds the constant operations and branches of all functions.
+ * </p>
+ * 
+ * <p>
+ * {@code <main>} is folded first, it stores the values of the constant
+ * globals, that are used by the other functions afterwards. Folded
+ * instructions become constants, folded branches become jumps, the old
+ * operands are removed by the cleanup of the optimizer.
+ * </p>
+ * 
+ * @returns The number of folded instructions
+ * 
+ * @param *module   Module to fold
+ */
+size_t OPT_fold_constants(struct IRModule *module) {
+	struct OPTFoldContext context;
+	size_t folded = 0;
+	size_t stringCount = module->stringCount;
+
+	(void)memset(&context, 0, sizeof(struct OPTFoldContext));
+	context.module = module;
+	context.globals = (struct OPTValue*)calloc(module->globalCount + 1, sizeof(struct OPTValue));
+	context.globalStores = (size_t*)calloc(module->globalCount + 1, sizeof(size_t));
+
+	if (context.globals == NULL || context.globalStores == NULL) {
+		(void)free(context.globals);
+		(void)free(context.globalStores);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	(void)OPT_find_constant_globals(&context);
+
+	if (module->entryFunction >= 0 && (size_t)module->entryFunction < module->functionCount) {
+		folded += OPT_fold_function(&context, module->functions[module->entryFunction]);
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		if ((int)i != module->entryFunction) {
+			folded += OPT_fold_function(&context, module->functions[i]);
+		}
+	}
+
+	(void)OPT_drop_folded_strings(module, stringCount);
+	(void)free(context.globals);
+	(void)free(context.globalStores);
+	return folded;
+}
+
+/*
+Purpose: Remove the strings, that were only folded on the way to an unknown value (e.g. the first iteration of a loop)
+Return Type: void
+Params: struct IRModule *module => Module with the strings;
+		size_t firstFolded => Number of strings before the folding
+*/
+void OPT_drop_folded_strings(struct IRModule *module, size_t firstFolded) {
+	if (module->stringCount <= firstFolded) {
+		return;
+	}
+
+	int *indices = (int*)calloc(module->stringCount, sizeof(int));
+
+	if (indices == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		struct IRFunction *function = module->functions[i];
+
+		for (size_t n = 0; n < function->instructionCount; n++) {
+			if (function->instructions[n].opcode == IR_CONST_STRING) {
+				indices[function->instructions[n].a] = 1;
+			}
+		}
+	}
+
+	size_t stringCount = firstFolded;
+
+	for (size_t i = firstFolded; i < module->stringCount; i++) {
+		if (indices[i] == 0) {
+			(void)free(module->strings[i]);
+			continue;
+		}
+
+		indices[i] = (int)stringCount;
+		module->strings[stringCount++] = module->strings[i];
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		struct IRFunction *function = module->functions[i];
+
+		for (size_t n = 0; n < function->instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[n];
+
+			if (instruction->opcode == IR_CONST_STRING && (size_t)instruction->a >= firstFolded) {
+				instruction->a = indices[instruction->a];
+			}
+		}
+	}
+
+	module->stringCount = stringCount;
+	(void)free(indices);
+}
+
+/*
+Purpose: Find the constant globals, that are stored once in the entry block of <main> before any call
+Return Type: void
+Params: struct OPTFoldContext *context => Context with the module, receives the positions of the stores
+*/
+void OPT_find_constant_globals(struct OPTFoldContext *context) {
+	struct IRModule *module = context->module;
+
+	//The lattice state counts the stores for now
+	for (size_t i = 0; i < module->globalCount; i++) {
+		context->globalStores[i] = OPT_NO_STORE;
+		context->globals[i].number.integer = 0;
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		struct IRFunction *function = module->functions[i];
+		size_t entryEnd = (int)i == module->entryFunction && function->blockCount > 0 ? function->blocks[0].instructionCount : 0;
+
+		for (size_t n = 0; n < function->instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[n];
+
+			if ((instruction->opcode == IR_CALL || instruction->opcode == IR_CALL_VIRTUAL) && n < entryEnd) {
+				entryEnd = n;
+			} else if (instruction->opcode == IR_STORE_GLOBAL && instruction->a >= 0 && (size_t)instruction->a < module->globalCount) {
+				context->globals[instruction->a].number.integer++;
+				context->globalStores[instruction->a] = n < entryEnd ? n : OPT_NO_STORE;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		if (module->globals[i].constant == false || context->globals[i].number.integer != 1) {
+			context->globalStores[i] = OPT_NO_STORE;
+		}
+
+		context->globals[i].state = context->globalStores[i] == OPT_NO_STORE ? OPT_VARYING : OPT_UNDEFINED;
+		context->globals[i].number.integer = 0;
+	}
+}
+
+/**
+ * <p>
+ * Folds a single function.
+ * </p>
+ * 
+ * <p>
+ * The blocks, that can be reached, are visited until the values don't
+ * change anymore (the lattice only has three levels, so this ends
+ * quickly). Afterwards the blocks are visited once more to rewrite
+ * the instructions with constant results.
+ * </p>
+ * 
+ * @returns The number of folded instructions
+ * 
+ * @param *context      Context of the folding
+ * @param *function     Function to fold
+ */
+size_t OPT_fold_function(struct OPTFoldContext *context, struct IRFunction *function) {
+	size_t registerCount = function->registerCount;
+	size_t blockCount = function->blockCount;
+	size_t folded = 0;
+
+	context->function = function;
+	context->isEntryFunction = context->module->entryFunction >= 0 && context->module->functions[context->module->entryFunction] == function ? true : false;
+	context->slots = (int*)calloc(registerCount + 1, sizeof(int));
+	context->values = (struct OPTValue*)calloc(registerCount + 1, sizeof(struct OPTValue));
+	context->executable = (int*)calloc(blockCount + 1, sizeof(int));
+
+	if (context->slots == NULL || context->values == NULL || context->executable == NULL) {
+		(void)free(context->slots);
+		(void)free(context->values);
+		(void)free(context->executable);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	//Count the definitions, the parameters are defined on entry
+	for (size_t i = 0; i < registerCount; i++) {
+		context->slots[i] = (int)i < function->paramCount ? 1 : 0;
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		int dest = OPT_get_defined_register(&function->instructions[i]);
+
+		if (dest >= 0 && (size_t)dest < registerCount) {
+			context->slots[dest]++;
+		}
+	}
+
+	context->slotCount = 0;
+
+	for (size_t i = 0; i < registerCount; i++) {
+		context->slots[i] = context->slots[i] > 1 ? (int)context->slotCount++ : -1;
+		context->values[i].state = (int)i < function->paramCount ? OPT_VARYING : OPT_UNDEFINED;
+	}
+
+	context->states = (struct OPTValue*)calloc(blockCount * context->slotCount + 1, sizeof(struct OPTValue));
+	context->current = (struct OPTValue*)calloc(context->slotCount + 1, sizeof(struct OPTValue));
+
+	if (context->states == NULL || context->current == NULL) {
+		(void)free(context->slots);
+		(void)free(context->values);
+		(void)free(context->executable);
+		(void)free(context->states);
+		(void)free(context->current);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	for (int i = 0; i < function->paramCount && (size_t)i < registerCount; i++) {
+		if (context->slots[i] >= 0) {
+			context->states[context->slots[i]].state = OPT_VARYING;
+		}
+	}
+
+	context->executable[0] = blockCount > 0 ? true : false;
+	context->changed = true;
+
+	while (context->changed == true) {
+		context->changed = false;
+
+		for (size_t i = 0; i < blockCount; i++) {
+			if (context->executable[i] == true) {
+				(void)OPT_visit_block(context, i, false);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < blockCount; i++) {
+		if (context->executable[i] == true) {
+			folded += OPT_visit_block(context, i, true);
+		}
+	}
+
+	(void)free(context->slots);
+	(void)free(context->values);
+	(void)free(context->executable);
+	(void)free(context->states);
+	(void)free(context->current);
+	context->function = NULL;
+	return folded;
+}
+
+/*
+Purpose: Evaluate the instructions of a block and pass its values on to the reached blocks (and the landing pad)
+Return Type: size_t => Number of rewritten instructions (0 if rewrite is false)
+Params: struct OPTFoldContext *context => Context of the folding;
+		size_t block => Block to visit;
+		int rewrite => Whether constant results and branches should be rewritten
+*/
+size_t OPT_visit_block(struct OPTFoldContext *context, size_t block, int rewrite) {
+	struct IRFunction *function = context->function;
+	struct IRBlock *irBlock = &function->blocks[block];
+	size_t folded = 0;
+
+	if (context->slotCount > 0) {
+		(void)memcpy(context->current, &context->states[block * context->slotCount], context->slotCount * sizeof(struct OPTValue));
+	}
+
+	for (size_t n = 0; n < irBlock->instructionCount; n++) {
+		size_t index = irBlock->firstInstruction + n;
+		struct IRInstruction *instruction = &function->instructions[index];
+
+		//A runtime error enters the landing pad with the values before the instruction
+		if (irBlock->handler >= 0 && (int)IR_can_raise(instruction) == true) {
+			(void)OPT_reach_block(context, irBlock->handler);
+		}
+
+		if (instruction->opcode == IR_JUMP) {
+			(void)OPT_reach_block(context, instruction->a);
+			continue;
+		} else if (instruction->opcode == IR_BRANCH) {
+			struct OPTValue condition = OPT_get_value(context, instruction->a);
+
+			if (condition.state != OPT_CONSTANT) {
+				(void)OPT_reach_block(context, instruction->b);
+				(void)OPT_reach_block(context, instruction->c);
+				continue;
+			}
+
+			int target = condition.number.integer != 0 ? instruction->b : instruction->c;
+			(void)OPT_reach_block(context, target);
+
+			if (rewrite == true) {
+				instruction->opcode = IR_JUMP;
+				instruction->a = target;
+				instruction->b = IR_NO_REGISTER;
+				instruction->c = IR_NO_REGISTER;
+				folded++;
+			}
+
+			continue;
+		} else if (instruction->opcode == IR_SWITCH) {
+			struct OPTValue value = OPT_get_value(context, instruction->a);
+			int *cases = &function->cases[instruction->b];
+
+			if (value.state != OPT_CONSTANT) {
+				for (int i = 0; i <= instruction->c; i++) {
+					(void)OPT_reach_block(context, cases[i]);
+				}
+
+				continue;
+			}
+
+			//Same wraparound as the table lookup of the virtual machine
+			unsigned long long offset = (unsigned long long)value.number.integer - (unsigned long long)instruction->value.integer;
+			int target = offset < (unsigned long long)instruction->c ? cases[offset + 1] : cases[0];
+			(void)OPT_reach_block(context, target);
+
+			if (rewrite == true) {
+				instruction->opcode = IR_JUMP;
+				instruction->a = target;
+				instruction->b = IR_NO_REGISTER;
+				instruction->c = IR_NO_REGISTER;
+				folded++;
+			}
+
+			continue;
+		} else if (instruction->opcode == IR_STORE_GLOBAL) {
+			if (context->isEntryFunction == true && context->globalStores[instruction->a] == index) {
+				context->changed |= OPT_merge_value(&context->globals[instruction->a], OPT_get_value(context, instruction->b));
+			}
+
+			continue;
+		}
+
+		int dest = OPT_get_defined_register(instruction);
+
+		if (dest < 0 || (size_t)dest >= function->registerCount) {
+			continue;
+		}
+
+		(void)OPT_set_value(context, dest, OPT_evaluate(context, instruction, index));
+		struct OPTValue value = OPT_get_value(context, dest);
+
+		if (rewrite == false || value.state != OPT_CONSTANT || instruction->opcode == IR_CONST_INT
+			|| instruction->opcode == IR_CONST_FLOAT || instruction->opcode == IR_CONST_STRING) {
+			continue;
+		}
+
+		if ((int)OPT_is_floating_type(instruction->type) == true) {
+			instruction->opcode = IR_CONST_FLOAT;
+			instruction->value.floating = value.number.floating;
+		} else if (instruction->type == STRING) {
+			instruction->opcode = IR_CONST_STRING;
+		} else {
+			instruction->opcode = IR_CONST_INT;
+			instruction->value.integer = value.number.integer;
+		}
+
+		instruction->a = instruction->type == STRING ? (int)value.number.integer : IR_NO_REGISTER;
+		instruction->b = IR_NO_REGISTER;
+		instruction->c = IR_NO_REGISTER;
+		folded++;
+	}
+
+	return folded;
+}
+
+/*
+Purpose: Mark a block as reachable and merge the current values into its state
+Return Type: void
+Params: struct OPTFoldContext *context => Context of the folding;
+		int block => Block, that is reached
+*/
+void OPT_reach_block(struct OPTFoldContext *context, int block) {
+	if (block < 0 || (size_t)block >= context->function->blockCount) {
+		return;
+	}
+
+	if (context->executable[block] == false) {
+		context->executable[block] = true;
+		context->changed = true;
+	}
+
+	struct OPTValue *state = &context->states[block * context->slotCount];
+
+	for (size_t i = 0; i < context->slotCount; i++) {
+		context->changed |= OPT_merge_value(&state[i], context->current[i]);
+	}
+}
+
+/*
+Purpose: Compute the value of an instruction's result from the values of its operands
+Return Type: struct OPTValue => The value of the result
+Params: struct OPTFoldContext *context => Context of the folding;
+		struct IRInstruction *instruction => Instruction to evaluate;
+		size_t index => Index of the instruction in the function
+*/
+struct OPTValue OPT_evaluate(struct OPTFoldContext *context, struct IRInstruction *instruction, size_t index) {
+	struct OPTValue result = {OPT_VARYING, {0}};
+	struct OPTValue x = OPT_get_value(context, instruction->a);
+	struct OPTValue y = {OPT_CONSTANT, {0}};
+	enum VarType operandType = instruction->type;
+
+	switch (instruction->opcode) {
+	case IR_CONST_INT:
+		result.state = OPT_CONSTANT;
+		result.number.integer = instruction->value.integer;
+		return result;
+	case IR_CONST_FLOAT:
+		result.state = OPT_CONSTANT;
+		result.number.floating = instruction->type == FLOAT ? (double)(float)instruction->value.floating : instruction->value.floating;
+		return result;
+	case IR_CONST_STRING:
+		result.state = OPT_CONSTANT;
+		result.number.integer = instruction->a;
+		return result;
+	case IR_MOVE:
+		return x;
+	case IR_CONCAT:
+		return OPT_concat_constants(context, x, OPT_get_value(context, instruction->b));
+	case IR_LOAD_GLOBAL: {
+		size_t store = context->globalStores[instruction->a];
+
+		//Loads in front of the store still read the old value
+		if (store == OPT_NO_STORE || (context->isEntryFunction == true && index < store)
+			|| context->globals[instruction->a].state != OPT_CONSTANT) {
+			return result;
+		}
+
+		return context->globals[instruction->a];
+	}
+	case IR_ADD:
+	case IR_SUB:
+	case IR_MUL:
+	case IR_DIV:
+	case IR_MOD:
+	case IR_SHL:
+	case IR_SHR:
+	case IR_BIT_AND:
+	case IR_BIT_OR:
+	case IR_BIT_XOR:
+	case IR_EQ:
+	case IR_NE:
+	case IR_LT:
+	case IR_LE:
+	case IR_GT:
+	case IR_GE:
+		y = OPT_get_value(context, instruction->b);
+		//Fall through
+	case IR_NEG:
+	case IR_NOT:
+	case IR_CONVERT:
+		if (instruction->a >= 0 && (size_t)instruction->a < context->function->registerCount) {
+			operandType = context->function->registers[instruction->a].type;
+		}
+
+		break;
+	default:
+		return result;
+	}
+
+	if (x.state == OPT_VARYING || y.state == OPT_VARYING) {
+		return result;
+	} else if (x.state == OPT_UNDEFINED || y.state == OPT_UNDEFINED) {
+		result.state = OPT_UNDEFINED;
+		return result;
+	}
+
+	result.state = (int)OPT_compute(instruction, operandType, x.number, y.number, &result.number) == true ? OPT_CONSTANT : OPT_VARYING;
+	return result;
+}
+
+struct OPTValue OPT_get_value(struct OPTFoldContext *context, int reg) {
+	struct OPTValue unknown = {OPT_VARYING, {0}};
+
+	if (reg < 0 || (size_t)reg >= context->function->registerCount) {
+		return unknown;
+	}
+
+	return context->slots[reg] >= 0 ? context->current[context->slots[reg]] : context->values[reg];
+}
+
+void OPT_set_value(struct OPTFoldContext *context, int reg, struct OPTValue value) {
+	if (context->slots[reg] >= 0) {
+		context->current[context->slots[reg]] = value;
+	} else {
+		context->changed |= OPT_merge_value(&context->values[reg], value);
+	}
+}
+
+/*
+Purpose: Merge a value into a lattice value (two different constants become unknown)
+Return Type: int => 1 if the target changed, else 0
+Params: struct OPTValue *target => Value to merge into;
+		struct OPTValue value => Value to merge
+*/
+int OPT_merge_value(struct OPTValue *target, struct OPTValue value) {
+	if (value.state == OPT_UNDEFINED || target->state == OPT_VARYING) {
+		return false;
+	} else if (target->state == OPT_UNDEFINED) {
+		*target = value;
+		return true;
+	} else if (value.state == OPT_VARYING || memcmp(&target->number, &value.number, sizeof(union OPTNumber)) != 0) {
+		target->state = OPT_VARYING;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+Purpose: Concatenate two string constants into a string of the module
+Return Type: struct OPTValue => Index of the concatenated string or an unknown value, if it's too long
+Params: struct OPTFoldContext *context => Context with the module;
+		struct OPTValue x => Index of the first string;
+		struct OPTValue y => Index of the second string
+*/
+struct OPTValue OPT_concat_constants(struct OPTFoldContext *context, struct OPTValue x, struct OPTValue y) {
+	struct OPTValue result = {OPT_VARYING, {0}};
+
+	if (x.state == OPT_VARYING || y.state == OPT_VARYING) {
+		return result;
+	} else if (x.state == OPT_UNDEFINED || y.state == OPT_UNDEFINED) {
+		result.state = OPT_UNDEFINED;
+		return result;
+	}
+
+	const char *first = context->module->strings[x.number.integer];
+	const char *second = context->module->strings[y.number.integer];
+	size_t length = strlen(first);
+	char buffer[OPT_MAX_FOLDED_STRING + 1];
+
+	if (length + strlen(second) > OPT_MAX_FOLDED_STRING) {
+		return result;
+	}
+
+	(void)memcpy(buffer, first, length);
+	(void)strcpy(buffer + length, second);
+
+	//Equal strings share their index, so the lattice compares them by the index
+	result.number.integer = IR_add_string(context->module, buffer);
+	result.state = result.number.integer >= 0 ? OPT_CONSTANT : OPT_VARYING;
+	return result;
+}
+
+/*
+Purpose: Compute an operation on constants like the virtual machine
+Return Type: int => 1 if the result could be computed, 0 if the operation has to stay (e.g. division by zero)
+Params: struct IRInstruction *instruction => The operation;
+		enum VarType operandType => Type of the operands;
+		union OPTNumber x => First operand;
+		union OPTNumber y => Second operand (binary operations only);
+		union OPTNumber *result => Receives the result
+*/
+int OPT_compute(struct IRInstruction *instruction, enum VarType operandType, union OPTNumber x, union OPTNumber y, union OPTNumber *result) {
+	int floating = (int)OPT_is_floating_type(operandType);
+	unsigned long long a = (unsigned long long)x.integer;
+	unsigned long long b = (unsigned long long)y.integer;
+
+	switch (instruction->opcode) {
+	case IR_ADD:
+		if (floating == true) {
+			result->floating = x.floating + y.floating;
+		} else {
+			result->integer = (long long)(a + b);
+		}
+
+		break;
+	case IR_SUB:
+		if (floating == true) {
+			result->floating = x.floating - y.floating;
+		} else {
+			result->integer = (long long)(a - b);
+		}
+
+		break;
+	case IR_MUL:
+		if (floating == true) {
+			result->floating = x.floating * y.floating;
+		} else {
+			result->integer = (long long)(a * b);
+		}
+
+		break;
+	case IR_DIV:
+		if (floating == true) {
+			result->floating = x.floating / y.floating;
+		} else if (y.integer == 0) {
+			return false;
+		} else {
+			result->integer = y.integer == -1 ? (long long)(0 - a) : x.integer / y.integer;
+		}
+
+		break;
+	case IR_MOD:
+		if (floating == true) {
+			result->floating = fmod(x.floating, y.floating);
+		} else if (y.integer == 0) {
+			return false;
+		} else {
+			result->integer = y.integer == -1 ? 0 : x.integer % y.integer;
+		}
+
+		break;
+	case IR_NEG:
+		if (floating == true) {
+			result->floating = -x.floating;
+		} else {
+			result->integer = (long long)(0 - a);
+		}
+
+		break;
+	case IR_SHL:
+		result->integer = (long long)(a << (y.integer & 63));
+		break;
+	case IR_SHR:
+		result->integer = x.integer >> (y.integer & 63);
+		return true;
+	case IR_BIT_AND:
+		result->integer = x.integer & y.integer;
+		return true;
+	case IR_BIT_OR:
+		result->integer = x.integer | y.integer;
+		return true;
+	case IR_BIT_XOR:
+		result->integer = x.integer ^ y.integer;
+		return true;
+	case IR_NOT:
+		result->integer = x.integer == 0;
+		return true;
+	case IR_EQ:
+		result->integer = floating == true ? x.floating == y.floating : x.integer == y.integer;
+		return true;
+	case IR_NE:
+		result->integer = floating == true ? x.floating != y.floating : x.integer != y.integer;
+		return true;
+	case IR_LT:
+		result->integer = floating == true ? x.floating < y.floating : x.integer < y.integer;
+		return true;
+	case IR_LE:
+		result->integer = floating == true ? x.floating <= y.floating : x.integer <= y.integer;
+		return true;
+	case IR_GT:
+		result->integer = floating == true ? x.floating > y.floating : x.integer > y.integer;
+		return true;
+	case IR_GE:
+		result->integer = floating == true ? x.floating >= y.floating : x.integer >= y.integer;
+		return true;
+	case IR_CONVERT:
+		return (int)OPT_convert(operandType, instruction->type, x, result);
+	default:
+		return false;
+	}
+
+	//Results of the arithmetic on float are rounded, int, short and char wrap around
+	if (instruction->type == FLOAT) {
+		result->floating = (double)(float)result->floating;
+	} else if (floating == false) {
+		result->integer = OPT_wrap_integer(instruction->type, result->integer);
+	}
+
+	return true;
+}
+
+/*
+Purpose: Cut an integer to the width of its type like the virtual machine (int, short and char wrap around)
+Return Type: long long => The cut value
+Params: enum VarType type => Type of the value;
+		long long value => Value to cut
+*/
+long long OPT_wrap_integer(enum VarType type, long long value) {
+	switch (type) {
+	case INTEGER:
+		return (long long)(int)value;
+	case SHORT:
+		return (long long)(short)value;
+	case CHAR:
+		return (long long)(char)value;
+	default:
+		return value;
+	}
+}
+
+/*
+Purpose: Convert a constant like the conversions of the virtual machine
+Return Type: int => 1 if the value could be converted, else 0
+Params: enum VarType from => Type of the value;
+		enum VarType to => Type to convert to;
+		union OPTNumber x => The value;
+		union OPTNumber *result => Receives the converted value
+*/
+int OPT_convert(enum VarType from, enum VarType to, union OPTNumber x, union OPTNumber *result) {
+	if ((int)OPT_is_floating_type(to) == true) {
+		result->floating = (int)OPT_is_floating_type(from) == true ? x.floating : (double)x.integer;
+		result->floating = to == FLOAT ? (double)(float)result->floating : result->floating;
+		return true;
+	}
+
+	long long value = x.integer;
+
+	if ((int)OPT_is_floating_type(from) == true) {
+		value = OPT_double_to_integer(x.floating);
+		from = LONG;
+	}
+
+	switch (to) {
+	case INTEGER:
+		result->integer = from == LONG ? (long long)(int)value : value;
+		return true;
+	case SHORT:
+		result->integer = from == LONG || from == INTEGER ? (long long)(short)value : value;
+		return true;
+	case CHAR:
+		result->integer = from != CHAR ? (long long)(char)value : value;
+		return true;
+	case LONG:
+		result->integer = value;
+		return true;
+	default:
+		return false;
+	}
+}
+
+int OPT_is_floating_type(enum VarType type) {
+	return type == DOUBLE || type == FLOAT ? true : false;
+}
+
+/*
+Purpose: Convert a floating value into an integer like the virtual machine (saturated, NaN becomes 0)
+Return Type: long long => The converted value
+Params: double value => Value to convert
+*/
+long long OPT_double_to_integer(double value) {
+	if (value != value) {
+		return 0;
+	} else if (value >= 9223372036854775807.0) {
+		return 9223372036854775807LL;
+	} else if (value <= -9223372036854775808.0) {
+		return -9223372036854775807LL - 1;
+	}
+
+	return (long long)value;
+}
@@ -0,0 +1,596 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/inlining.c} was created
+ * to replace the calls of small functions with their bodies.
+ *
+ * The callee gets fresh registers in the caller, its parameters are
+ * copied from the arguments and its returns jump to the instructions
+ * after the call. Only functions without calls are inlined, so a
+ * recursion can't be inlined endlessly. After a function inlined its
+ * callees it can become such a function itself, so the module is
+ * visited again, until nothing changes (at most OPT_INLINE_ROUNDS times).
+ *
+ * Before that the virtual calls, that can only reach a single method,
+ * become direct calls (see OPT_devirtualize_calls), so small methods
+ * are inlined as well.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Maximum number of instructions of a function, that is inlined
+#define OPT_INLINE_BUDGET 32
+
+//A caller doesn't grow beyond this number of instructions by inlining
+#define OPT_INLINE_FUNCTION_LIMIT 4096
+
+#define OPT_INLINE_ROUNDS 4
+
+int OPT_resolve_virtual_call(struct IRModule *module, struct IRInstruction *call, int *instantiated);
+size_t OPT_devirtualize_function(struct IRModule *module, struct IRFunction *function, int *instantiated);
+int OPT_is_this_checked(struct IRFunction *function);
+size_t OPT_inline_calls(struct IRModule *module, struct IRFunction *function);
+int OPT_is_inlinable(struct IRModule *module, struct IRFunction *caller, int callee);
+void OPT_inline_call(struct IRModule *module, struct IRFunction *function, struct IRInstruction *call);
+void OPT_copy_inlined_instruction(struct IRFunction *function, struct IRFunction *callee, struct IRInstruction *instruction, int *registers, int *blocks, struct IRInstruction *call, int continuation);
+int OPT_copy_inlined_arguments(struct IRFunction *function, struct IRFunction *callee, struct IRInstruction *instruction, int *registers);
+
+/**
+ * <p>
+ * Inlines the calls of small functions in all functions of the module.
+ * </p>
+ * 
+ * <p>
+ * The inlined functions stay in the module, since they can still be
+ * called from the other functions (and are exported by the assembly).
+ * The copied instructions are cleaned up by the following passes
+ * (e.g. the copies of constant arguments are folded).
+ * </p>
+ * 
+ * @returns The number of inlined calls
+ * 
+ * @param *module   Module to optimize
+ */
+size_t OPT_inline_functions(struct IRModule *module) {
+	size_t inlined = 0;
+
+	for (int round = 0; round < OPT_INLINE_ROUNDS; round++) {
+		size_t roundInlined = 0;
+
+		for (size_t i = 0; i < module->functionCount; i++) {
+			roundInlined += OPT_inline_calls(module, module->functions[i]);
+		}
+
+		inlined += roundInlined;
+
+		if (roundInlined == 0) {
+			break;
+		}
+	}
+
+	return inlined;
+}
+
+/**
+ * <p>
+ * Replaces the virtual calls, that can only reach a single method, by
+ * direct calls of that method.
+ * </p>
+ * 
+ * <p>
+ * The module holds the whole program, so the class hierarchy can't
+ * change anymore. Only the classes, that are created somewhere with
+ * {@code new}, can be the class of a receiver. If all of them, that
+ * extend the static class of the call (or implement its interface),
+ * use the same method in the slot of the call, the call is direct.
+ * The receiver is checked for null in front of the call, like the
+ * virtual call does, unless it's the {@code this} of a method.
+ * </p>
+ * 
+ * @returns The number of devirtualized calls
+ * 
+ * @param *module   Module to optimize
+ */
+size_t OPT_devirtualize_calls(struct IRModule *module) {
+	size_t devirtualized = 0;
+	int *instantiated = (int*)calloc(module->classCount + 1, sizeof(int));
+
+	if (instantiated == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		struct IRFunction *function = module->functions[i];
+
+		for (size_t n = 0; n < function->instructionCount; n++) {
+			if (function->instructions[n].opcode == IR_NEW) {
+				instantiated[function->instructions[n].a] = true;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		devirtualized += OPT_devirtualize_function(module, module->functions[i], instantiated);
+	}
+
+	(void)free(instantiated);
+	return devirtualized;
+}
+
+/*
+Purpose: Find the only method, that a virtual call can reach
+Return Type: int => Index of the function or -1, if the call can reach several (or no) methods
+Params: struct IRModule *module => Module with the classes;
+		struct IRInstruction *call => The virtual call;
+		int *instantiated => Marks the classes, that are created by new
+*/
+int OPT_resolve_virtual_call(struct IRModule *module, struct IRInstruction *call, int *instantiated) {
+	int staticClass = (int)call->value.integer;
+	struct IRClass *base = &module->classes[staticClass];
+	int target = -1;
+
+	for (size_t i = 0; i < module->classCount; i++) {
+		struct IRClass *irClass = &module->classes[i];
+
+		if (instantiated[i] == false || (int)IR_is_subclass(module, (int)i, staticClass) == false) {
+			continue;
+		}
+
+		//The methods of an interface are mapped to the vtable by every class
+		size_t interfaceSlot = base->interfaceBase + (size_t)call->a;
+		int slot = base->isInterface == false ? call->a : interfaceSlot < irClass->interfaceSlotCount ? irClass->interfaceSlots[interfaceSlot] : -1;
+		int method = slot >= 0 && (size_t)slot < irClass->methodCount ? irClass->methods[slot] : -1;
+
+		if (method < 0 || (target >= 0 && method != target)) {
+			return -1;
+		}
+
+		target = method;
+	}
+
+	return target;
+}
+
+/*
+Purpose: Replace the virtual calls of a function, that reach a single method, by null checks and direct calls
+Return Type: size_t => Number of devirtualized calls
+Params: struct IRModule *module => Module of the function;
+		struct IRFunction *function => Function, that holds the calls;
+		int *instantiated => Marks the classes, that are created by new
+*/
+size_t OPT_devirtualize_function(struct IRModule *module, struct IRFunction *function, int *instantiated) {
+	size_t instructionCount = function->instructionCount;
+	size_t blockCount = function->blockCount;
+	size_t devirtualized = 0;
+	int *targets = (int*)malloc((instructionCount + 1) * sizeof(int));
+
+	if (targets == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	for (size_t i = 0; i < instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+		targets[i] = instruction->opcode == IR_CALL_VIRTUAL ? OPT_resolve_virtual_call(module, instruction, instantiated) : -1;
+		devirtualized += targets[i] >= 0 ? 1 : 0;
+	}
+
+	if (devirtualized == 0) {
+		(void)free(targets);
+		return 0;
+	}
+
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((instructionCount + 1) * sizeof(struct IRInstruction));
+	struct IRBlock *blocks = (struct IRBlock*)malloc((blockCount + 1) * sizeof(struct IRBlock));
+
+	if (instructions == NULL || blocks == NULL) {
+		(void)free(targets);
+		(void)free(instructions);
+		(void)free(blocks);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	int thisChecked = OPT_is_this_checked(function);
+	(void)memcpy(instructions, function->instructions, instructionCount * sizeof(struct IRInstruction));
+	(void)memcpy(blocks, function->blocks, blockCount * sizeof(struct IRBlock));
+	function->instructionCount = 0;
+	function->currentBlock = -1;
+
+	for (size_t i = 0; i < blockCount; i++) {
+		function->handler = blocks[i].handler;
+		(void)IR_start_block(function, (int)i);
+
+		for (size_t n = 0; n < blocks[i].instructionCount; n++) {
+			size_t index = blocks[i].firstInstruction + n;
+			struct IRInstruction *instruction = &instructions[index];
+			enum IROpcode opcode = instruction->opcode;
+
+			if (targets[index] >= 0) {
+				int receiver = function->arguments[instruction->b];
+
+				if (receiver != 0 || thisChecked == false) {
+					struct IRInstruction *check = IR_emit(function, IR_CHECK_NULL, VOID, IR_NO_REGISTER, receiver, IR_NO_REGISTER, IR_NO_REGISTER, instruction->line);
+
+					if (check != NULL) {
+						check->origin = instruction->origin;
+					}
+				}
+
+				opcode = IR_CALL;
+				instruction->a = targets[index];
+				instruction->value.integer = 0;
+			}
+
+			struct IRInstruction *copy = IR_emit(function, opcode, instruction->type, instruction->dest, instruction->a, instruction->b, instruction->c, instruction->line);
+
+			if (copy != NULL) {
+				copy->value = instruction->value;
+				copy->origin = instruction->origin;
+			}
+		}
+	}
+
+	function->handler = -1;
+	(void)free(targets);
+	(void)free(instructions);
+	(void)free(blocks);
+
+	(void)IR_finish_function(function);
+	return devirtualized;
+}
+
+/*
+Purpose: Check if the register 0 is the this of a method, that is never changed (the call of the method checked it for null)
+Return Type: int => True if the register 0 can't be null, else false
+Params: struct IRFunction *function => Function to check
+*/
+int OPT_is_this_checked(struct IRFunction *function) {
+	if (function->paramCount < 1 || function->registers[0].name == NULL || strcmp(function->registers[0].name, "this") != 0) {
+		return false;
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		if ((int)OPT_get_defined_register(&function->instructions[i]) == 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Inlines the calls of a single function.
+ * </p>
+ * 
+ * <p>
+ * The function is emitted again block by block, a call, that is inlined,
+ * ends its block with a jump into the copied blocks of the callee, the
+ * instructions after the call continue in a new block. The copied blocks
+ * keep the landing pad of the call. The layout is fixed by
+ * {@code IR_finish_function()} afterwards.
+ * </p>
+ * 
+ * @returns The number of inlined calls
+ * 
+ * @param *module       Module of the function
+ * @param *function     Function, that holds the calls
+ */
+size_t OPT_inline_calls(struct IRModule *module, struct IRFunction *function) {
+	size_t instructionCount = function->instructionCount;
+	size_t blockCount = function->blockCount;
+	size_t size = instructionCount;
+	size_t inlined = 0;
+	int *inlineAt = (int*)calloc(instructionCount + 1, sizeof(int));
+
+	if (inlineAt == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	for (size_t i = 0; i < instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+
+		if (instruction->opcode != IR_CALL || (int)OPT_is_inlinable(module, function, instruction->a) == false) {
+			continue;
+		} else if (size + module->functions[instruction->a]->instructionCount > OPT_INLINE_FUNCTION_LIMIT) {
+			break;
+		}
+
+		size += module->functions[instruction->a]->instructionCount;
+		inlineAt[i] = true;
+		inlined++;
+	}
+
+	if (inlined == 0) {
+		(void)free(inlineAt);
+		return 0;
+	}
+
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((instructionCount + 1) * sizeof(struct IRInstruction));
+	struct IRBlock *blocks = (struct IRBlock*)malloc((blockCount + 1) * sizeof(struct IRBlock));
+
+	if (instructions == NULL || blocks == NULL) {
+		(void)free(inlineAt);
+		(void)free(instructions);
+		(void)free(blocks);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	(void)memcpy(instructions, function->instructions, instructionCount * sizeof(struct IRInstruction));
+	(void)memcpy(blocks, function->blocks, blockCount * sizeof(struct IRBlock));
+	function->instructionCount = 0;
+	function->currentBlock = -1;
+
+	//All blocks are reachable and terminated, so no jumps are added between them
+	for (size_t i = 0; i < blockCount; i++) {
+		function->handler = blocks[i].handler;
+		(void)IR_start_block(function, (int)i);
+
+		for (size_t n = 0; n < blocks[i].instructionCount; n++) {
+			size_t index = blocks[i].firstInstruction + n;
+			struct IRInstruction *instruction = &instructions[index];
+
+			if (inlineAt[index] == true) {
+				(void)OPT_inline_call(module, function, instruction);
+				continue;
+			}
+
+			struct IRInstruction *copy = IR_emit(function, instruction->opcode, instruction->type, instruction->dest, instruction->a, instruction->b, instruction->c, instruction->line);
+
+			if (copy != NULL) {
+				copy->value = instruction->value;
+				copy->origin = instruction->origin;
+			}
+		}
+	}
+
+	function->handler = -1;
+	(void)free(inlineAt);
+	(void)free(instructions);
+	(void)free(blocks);
+
+	(void)IR_finish_function(function);
+
+	//Merges the jumps into and out of the inlined blocks, so the function can be inlined itself
+	(void)OPT_compact_function(function);
+	return inlined;
+}
+
+/**
+ * <p>
+ * Checks if a call of the function can be inlined.
+ * </p>
+ * 
+ * <p>
+ * The callee has to be small and mustn't call any function (so
+ * recursions are never inlined). The other instructions, that can
+ * raise a runtime error (e.g. an integer division), keep the callee as
+ * their origin, so the error still names it.
+ * </p>
+ * 
+ * @returns True if the callee can be inlined, else false
+ * 
+ * @param *module   Module of the functions
+ * @param *caller   Function, that holds the call
+ * @param callee    Index of the called function
+ */
+int OPT_is_inlinable(struct IRModule *module, struct IRFunction *caller, int callee) {
+	if (callee < 0 || (size_t)callee >= module->functionCount || callee == module->entryFunction) {
+		return false;
+	}
+
+	struct IRFunction *function = module->functions[callee];
+
+	if (function == caller || function->instructionCount > OPT_INLINE_BUDGET) {
+		return false;
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+
+		if (instruction->opcode == IR_CALL || instruction->opcode == IR_CALL_VIRTUAL) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Copy the body of the called function into the current block of the function (the blocks without a landing pad get the one of the call)
+Return Type: void
+Params: struct IRModule *module => Module of the functions;
+		struct IRFunction *function => Function, that is emitted again;
+		struct IRInstruction *call => Call to inline
+*/
+void OPT_inline_call(struct IRModule *module, struct IRFunction *function, struct IRInstruction *call) {
+	struct IRFunction *callee = module->functions[call->a];
+	int *registers = (int*)malloc((callee->registerCount + 1) * sizeof(int));
+	int *blocks = (int*)malloc((callee->blockCount + 1) * sizeof(int));
+
+	if (registers == NULL || blocks == NULL) {
+		(void)free(registers);
+		(void)free(blocks);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < callee->registerCount; i++) {
+		registers[i] = IR_add_register(function, callee->registers[i].type, callee->registers[i].name);
+
+		if (registers[i] != IR_NO_REGISTER) {
+			function->registers[registers[i]].reference = callee->registers[i].reference;
+		}
+	}
+
+	for (int i = 0; i < callee->paramCount && i < call->c; i++) {
+		(void)IR_emit(function, IR_MOVE, callee->registers[i].type, registers[i], function->arguments[call->b + i], IR_NO_REGISTER, IR_NO_REGISTER, call->line);
+	}
+
+	for (size_t i = 0; i < callee->blockCount; i++) {
+		blocks[i] = IR_add_block(function);
+	}
+
+	int continuation = IR_add_block(function);
+	int handler = function->handler;
+
+	//The blocks of the callee are in layout order, the first one is entered by a jump
+	for (size_t i = 0; i < callee->blockCount; i++) {
+		struct IRBlock *block = &callee->blocks[i];
+		function->handler = block->handler >= 0 ? blocks[block->handler] : handler;
+		(void)IR_start_block(function, blocks[i]);
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			(void)OPT_copy_inlined_instruction(function, callee, &callee->instructions[block->firstInstruction + n], registers, blocks, call, continuation);
+		}
+	}
+
+	function->handler = handler;
+	(void)IR_start_block(function, continuation);
+	(void)free(registers);
+	(void)free(blocks);
+}
+
+/*
+Purpose: Copy an instruction of the inlined function with the registers and blocks of the caller
+Return Type: void
+Params: struct IRFunction *function => Function, that receives the instruction;
+		struct IRFunction *callee => Inlined function (holds the blocks of its switches);
+		struct IRInstruction *instruction => Instruction of the callee;
+		int *registers => Registers of the caller for the registers of the callee;
+		int *blocks => Blocks of the caller for the blocks of the callee;
+		struct IRInstruction *call => Inlined call (receives the returned value);
+		int continuation => Block after the call
+*/
+void OPT_copy_inlined_instruction(struct IRFunction *function, struct IRFunction *callee, struct IRInstruction *instruction, int *registers, int *blocks, struct IRInstruction *call, int continuation) {
+	int dest = instruction->dest >= 0 ? registers[instruction->dest] : IR_NO_REGISTER;
+	int a = instruction->a;
+	int b = instruction->b;
+	int c = instruction->c;
+
+	switch (instruction->opcode) {
+	case IR_CONST_INT:
+	case IR_CONST_FLOAT:
+	case IR_CONST_STRING:
+	case IR_LOAD_GLOBAL:
+		break;
+	case IR_STORE_GLOBAL:
+		b = registers[b];
+		break;
+	case IR_JUMP:
+		a = blocks[a];
+		break;
+	case IR_BRANCH:
+		a = registers[a];
+		b = blocks[b];
+		c = blocks[c];
+		break;
+	case IR_SWITCH:
+		a = registers[a];
+		b = (int)OPT_copy_cases(function, callee, instruction, blocks);
+		break;
+	case IR_RETURN:
+		if (call->dest != IR_NO_REGISTER && a != IR_NO_REGISTER) {
+			(void)IR_emit(function, IR_MOVE, call->type, call->dest, registers[a], IR_NO_REGISTER, IR_NO_REGISTER, instruction->line);
+		}
+
+		(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, continuation, IR_NO_REGISTER, IR_NO_REGISTER, instruction->line);
+		return;
+	case IR_MOVE:
+	case IR_NEG:
+	case IR_NOT:
+	case IR_CONVERT:
+	case IR_BUILDER:
+	case IR_LOAD_FIELD:
+	case IR_CHECK_NULL:
+		a = registers[a];
+		break;
+	case IR_STORE_FIELD:
+		a = registers[a];
+		c = registers[c];
+		break;
+	case IR_STORE_ELEMENT:
+		a = registers[a];
+		b = registers[b];
+		c = registers[c];
+		break;
+	case IR_NEW_ARRAY:
+		b = (int)OPT_copy_inlined_arguments(function, callee, instruction, registers);
+		break;
+	case IR_NEW:
+	case IR_NOP:
+	case IR_RESUME:
+		break;
+	default:
+		a = registers[a];
+		b = registers[b];
+		break;
+	}
+
+	struct IRInstruction *copy = IR_emit(function, instruction->opcode, instruction->type, dest, a, b, c, instruction->line);
+
+	if (copy != NULL) {
+		copy->value = instruction->value;
+		copy->origin = instruction->origin >= 0 ? instruction->origin : call->a;
+	}
+}
+
+/*
+Purpose: Copy the argument registers of an inlined instruction (the lengths of a new array) into the caller
+Return Type: int => Index of the first copied argument
+Params: struct IRFunction *function => Function, that receives the arguments;
+		struct IRFunction *callee => Inlined function;
+		struct IRInstruction *instruction => Instruction of the callee;
+		int *registers => Registers of the caller for the registers of the callee
+*/
+int OPT_copy_inlined_arguments(struct IRFunction *function, struct IRFunction *callee, struct IRInstruction *instruction, int *registers) {
+	int *arguments = (int*)malloc((instruction->c + 1) * sizeof(int));
+
+	if (arguments == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	for (int i = 0; i < instruction->c; i++) {
+		arguments[i] = registers[callee->arguments[instruction->b + i]];
+	}
+
+	int first = IR_add_arguments(function, arguments, instruction->c);
+	(void)free(arguments);
+	return first;
+}
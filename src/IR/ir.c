@@ -0,0 +1,1598 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/stats.h"
+#include "../../headers/ir.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/ir.c} was created
+ * to hold the intermediate representation (IR) of a program.
+ *
+ * A function is a list of basic blocks with three-address instructions
+ * on virtual registers. Instructions, blocks, registers and call
+ * arguments are flat arrays, that are indexed by the operands, so the
+ * later passes can walk them without chasing pointers.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Marks a block, that was added but not started yet
+#define IR_UNSTARTED_BLOCK ((size_t)-1)
+
+const char *IR_OPCODE_NAMES[IR_OPCODES] = {
+	"nop",
+	"const", "const", "string",
+	"move", "load", "store",
+	"add", "sub", "mul", "div", "mod", "neg",
+	"shl", "shr", "and", "or", "xor", "not",
+	"eq", "ne", "lt", "le", "gt", "ge",
+	"convert", "call", "concat", "builder", "append",
+	"new", "newarray", "getfield", "putfield",
+	"getelement", "putelement", "callvirtual", "checknull",
+	"jump", "br", "switch", "ret", "resume"
+};
+
+int IR_grow(void **array, size_t *capacity, size_t count, size_t size);
+int IR_is_integral_type(enum VarType type);
+int IR_is_numeric_type(enum VarType type);
+void IR_report_problem(struct IRFunction *function, size_t index, const char *problem);
+int IR_verify_function(struct IRModule *module, struct IRFunction *function);
+int IR_verify_instruction(struct IRModule *module, struct IRFunction *function, size_t index);
+int IR_verify_arguments(struct IRFunction *function, size_t index, struct IRFunction *callee);
+int IR_is_register(struct IRFunction *function, int reg);
+enum VarType IR_get_register_type(struct IRFunction *function, int reg);
+void IR_dump_class(FILE *output, struct IRModule *module, size_t index);
+void IR_dump_function(FILE *output, struct IRModule *module, struct IRFunction *function);
+void IR_dump_instruction(FILE *output, struct IRModule *module, struct IRFunction *function, struct IRInstruction *instruction);
+void FREE_IR_FUNCTION(struct IRFunction *function);
+
+struct IRModule *CreateNewIRModule() {
+	struct IRModule *module = (struct IRModule*)calloc(1, sizeof(struct IRModule));
+
+	if (module == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return NULL;
+	}
+
+	module->entryFunction = -1;
+	return module;
+}
+
+/**
+ * <p>
+ * Adds a new function to the module.
+ * </p>
+ * 
+ * <p>
+ * The entry block (block 0) is added and started right away.
+ * </p>
+ * 
+ * @returns The new function or NULL if it couldn't be allocated
+ * 
+ * @param *module       Module to add the function to
+ * @param *name         Name of the function (gets copied)
+ * @param returnType    Return type of the function
+ * @param line          Line of the declaration
+ */
+struct IRFunction *CreateNewIRFunction(struct IRModule *module, const char *name, enum VarType returnType, size_t line) {
+	if ((int)IR_grow((void**)&module->functions, &module->functionCapacity, module->functionCount, sizeof(struct IRFunction*)) == false) {
+		return NULL;
+	}
+
+	struct IRFunction *function = (struct IRFunction*)calloc(1, sizeof(struct IRFunction));
+
+	if (function == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return NULL;
+	}
+
+	function->name = (char*)malloc(strlen(name) + 1);
+
+	if (function->name == NULL) {
+		(void)free(function);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return NULL;
+	}
+
+	(void)strcpy(function->name, name);
+	function->returnType = returnType;
+	function->returnReference = IR_NO_REFERENCE;
+	function->line = line;
+	function->currentBlock = -1;
+	function->handler = -1;
+	module->functions[module->functionCount++] = function;
+	(void)IR_start_block(function, IR_add_block(function));
+	return function;
+}
+
+/**
+ * <p>
+ * Adds a global to the module.
+ * </p>
+ * 
+ * @returns The index of the global or -1 if no memory is left
+ * 
+ * @param *module   Module to add the global to
+ * @param *name     Name of the global (gets copied)
+ * @param type      Type of the global
+ * @param constant  Whether the global is a constant
+ */
+int IR_add_global(struct IRModule *module, const char *name, enum VarType type, int constant) {
+	if ((int)IR_grow((void**)&module->globals, &module->globalCapacity, module->globalCount, sizeof(struct IRGlobal)) == false) {
+		return -1;
+	}
+
+	struct IRGlobal *global = &module->globals[module->globalCount];
+	global->name = (char*)malloc(strlen(name) + 1);
+
+	if (global->name == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	(void)strcpy(global->name, name);
+	global->type = type;
+	global->reference = IR_NO_REFERENCE;
+	global->constant = constant;
+	return (int)module->globalCount++;
+}
+
+/**
+ * <p>
+ * Adds a string to the string pool of the module, equal strings
+ * share one entry.
+ * </p>
+ * 
+ * @returns The index of the string or -1 if no memory is left
+ * 
+ * @param *module   Module with the string pool
+ * @param *value    The string (gets copied)
+ */
+int IR_add_string(struct IRModule *module, const char *value) {
+	for (size_t i = 0; i < module->stringCount; i++) {
+		if (strcmp(module->strings[i], value) == 0) {
+			return (int)i;
+		}
+	}
+
+	if ((int)IR_grow((void**)&module->strings, &module->stringCapacity, module->stringCount, sizeof(char*)) == false) {
+		return -1;
+	}
+
+	char *copy = (char*)malloc(strlen(value) + 1);
+
+	if (copy == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	(void)strcpy(copy, value);
+	module->strings[module->stringCount] = copy;
+	return (int)module->stringCount++;
+}
+
+/**
+ * <p>
+ * Adds a class or an interface without fields and methods to the
+ * module.
+ * </p>
+ * 
+ * @returns The index of the class or -1 if no memory is left
+ * 
+ * @param *module       Module to add the class to
+ * @param *name         Name of the class (gets copied)
+ * @param isInterface   Whether the class is an interface
+ */
+int IR_add_class(struct IRModule *module, const char *name, int isInterface) {
+	if ((int)IR_grow((void**)&module->classes, &module->classCapacity, module->classCount, sizeof(struct IRClass)) == false) {
+		return -1;
+	}
+
+	struct IRClass *irClass = &module->classes[module->classCount];
+	(void)memset(irClass, 0, sizeof(struct IRClass));
+	irClass->name = (char*)malloc(strlen(name) + 1);
+
+	if (irClass->name == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	(void)strcpy(irClass->name, name);
+	irClass->parent = -1;
+	irClass->isInterface = isInterface;
+	return (int)module->classCount++;
+}
+
+/**
+ * <p>
+ * Appends a field to a class.
+ * </p>
+ * 
+ * @returns The index of the field or -1 if no memory is left
+ * 
+ * @param *module       Module with the class
+ * @param classIndex    Class, that receives the field
+ * @param *name         Name of the field (gets copied)
+ * @param type          Type of the field
+ * @param reference     Object or array of a reference field
+ * @param owner         Class, that declares the field
+ * @param offset        Offset of the field in the layout (bytes)
+ * @param size          Size of the field in the layout (bytes)
+ */
+int IR_add_field(struct IRModule *module, int classIndex, const char *name, enum VarType type, struct IRReference reference, int owner, size_t offset, size_t size) {
+	struct IRClass *irClass = &module->classes[classIndex];
+	size_t capacity = irClass->fieldCount;
+	struct IRField *fields = (struct IRField*)realloc(irClass->fields, (capacity + 1) * sizeof(struct IRField));
+
+	if (fields == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	irClass->fields = fields;
+	struct IRField *field = &fields[irClass->fieldCount];
+	field->name = (char*)malloc(strlen(name) + 1);
+
+	if (field->name == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	(void)strcpy(field->name, name);
+	field->type = type;
+	field->reference = reference;
+	field->owner = owner;
+	field->offset = offset;
+	field->size = size;
+	return (int)irClass->fieldCount++;
+}
+
+/**
+ * <p>
+ * Checks, if an object of a class can be used as an object of the base,
+ * so if the base is the class, one of its parents or an interface, that
+ * the class or one of its parents implements.
+ * </p>
+ * 
+ * @returns 1 if the class is a subclass of the base, else 0
+ * 
+ * @param *module       Module with the classes
+ * @param classIndex    Class to check
+ * @param baseIndex     The expected base
+ */
+int IR_is_subclass(struct IRModule *module, int classIndex, int baseIndex) {
+	for (int current = classIndex; current >= 0 && (size_t)current < module->classCount; current = module->classes[current].parent) {
+		if (current == baseIndex) {
+			return true;
+		}
+
+		struct IRClass *irClass = &module->classes[current];
+
+		for (size_t i = 0; i < irClass->interfaceCount; i++) {
+			if (irClass->interfaces[i] == baseIndex) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * <p>
+ * Adds a new virtual register to the function.
+ * </p>
+ * 
+ * @returns The index of the register or IR_NO_REGISTER if no memory is left
+ * 
+ * @param *function Function to add the register to
+ * @param type      Type of the register
+ * @param *name     Name of the variable (gets copied) or NULL for temporaries
+ */
+int IR_add_register(struct IRFunction *function, enum VarType type, const char *name) {
+	if ((int)IR_grow((void**)&function->registers, &function->registerCapacity, function->registerCount, sizeof(struct IRRegister)) == false) {
+		return IR_NO_REGISTER;
+	}
+
+	struct IRRegister *reg = &function->registers[function->registerCount];
+	reg->type = type;
+	reg->name = NULL;
+	reg->reference = IR_NO_REFERENCE;
+
+	if (name != NULL) {
+		reg->name = (char*)malloc(strlen(name) + 1);
+
+		if (reg->name == NULL) {
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			return IR_NO_REGISTER;
+		}
+
+		(void)strcpy(reg->name, name);
+	}
+
+	return (int)function->registerCount++;
+}
+
+/**
+ * <p>
+ * Adds a new block to the function. The block receives instructions
+ * after it got started with {@code IR_start_block()}.
+ * </p>
+ * 
+ * @returns The index of the block or -1 if no memory is left
+ * 
+ * @param *function Function to add the block to
+ */
+int IR_add_block(struct IRFunction *function) {
+	if ((int)IR_grow((void**)&function->blocks, &function->blockCapacity, function->blockCount, sizeof(struct IRBlock)) == false) {
+		return -1;
+	}
+
+	function->blocks[function->blockCount].firstInstruction = IR_UNSTARTED_BLOCK;
+	function->blocks[function->blockCount].instructionCount = 0;
+	function->blocks[function->blockCount].handler = -1;
+	function->blocks[function->blockCount].frequency = 0;
+	return (int)function->blockCount++;
+}
+
+/**
+ * <p>
+ * Starts a block, all following instructions are appended to it.
+ * </p>
+ * 
+ * <p>
+ * If the current block isn't terminated yet, it falls through into
+ * the new block (a jump is added). The blocks are laid out in the
+ * order they are started and get the landing pad, that is set in the
+ * function ({@code handler}) at this point.
+ * </p>
+ * 
+ * @param *function Function of the block
+ * @param block     Block to start
+ */
+void IR_start_block(struct IRFunction *function, int block) {
+	if (block < 0 || (size_t)block >= function->blockCount) {
+		return;
+	}
+
+	if (function->currentBlock >= 0 && (int)IR_is_block_terminated(function) == false) {
+		(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, block, IR_NO_REGISTER, IR_NO_REGISTER, 0);
+	}
+
+	function->blocks[block].firstInstruction = function->instructionCount;
+	function->blocks[block].handler = function->handler;
+	function->currentBlock = block;
+}
+
+/**
+ * <p>
+ * Appends an instruction to the current block.
+ * </p>
+ * 
+ * @returns The instruction (valid until the next emit) or NULL if no memory is left
+ * 
+ * @param *function Function to emit into
+ * @param opcode    Opcode of the instruction
+ * @param type      Type of the result (or of the used value)
+ * @param dest      Register that receives the result
+ * @param a         First operand
+ * @param b         Second operand
+ * @param c         Third operand
+ * @param line      Source line of the instruction
+ */
+struct IRInstruction *IR_emit(struct IRFunction *function, enum IROpcode opcode, enum VarType type, int dest, int a, int b, int c, size_t line) {
+	if ((int)IR_grow((void**)&function->instructions, &function->instructionCapacity, function->instructionCount, sizeof(struct IRInstruction)) == false) {
+		return NULL;
+	}
+
+	struct IRInstruction *instruction = &function->instructions[function->instructionCount++];
+	instruction->opcode = opcode;
+	instruction->type = type;
+	instruction->dest = dest;
+	instruction->a = a;
+	instruction->b = b;
+	instruction->c = c;
+	instruction->value.integer = 0;
+	instruction->line = line;
+	instruction->origin = -1;
+	return instruction;
+}
+
+/**
+ * <p>
+ * Stores the argument registers of a call.
+ * </p>
+ * 
+ * @returns The index of the first argument (operand b of IR_CALL) or -1 if no memory is left
+ * 
+ * @param *function     Function of the call
+ * @param *registers    Registers of the arguments
+ * @param count         Number of arguments
+ */
+int IR_add_arguments(struct IRFunction *function, int *registers, int count) {
+	size_t first = function->argumentCount;
+
+	for (int i = 0; i < count; i++) {
+		if ((int)IR_grow((void**)&function->arguments, &function->argumentCapacity, function->argumentCount, sizeof(int)) == false) {
+			return -1;
+		}
+
+		function->arguments[function->argumentCount++] = registers[i];
+	}
+
+	return (int)first;
+}
+
+/**
+ * <p>
+ * Stores the blocks of a switch, the default block has to be the first.
+ * </p>
+ * 
+ * @returns The index of the default block (operand b of IR_SWITCH) or -1 if no memory is left
+ * 
+ * @param *function     Function of the switch
+ * @param *blocks       Default block followed by the blocks of the table
+ * @param count         Number of blocks (including the default block)
+ */
+int IR_add_cases(struct IRFunction *function, int *blocks, int count) {
+	size_t first = function->caseCount;
+
+	for (int i = 0; i < count; i++) {
+		if ((int)IR_grow((void**)&function->cases, &function->caseCapacity, function->caseCount, sizeof(int)) == false) {
+			return -1;
+		}
+
+		function->cases[function->caseCount++] = blocks[i];
+	}
+
+	return (int)first;
+}
+
+int IR_is_terminator(enum IROpcode opcode) {
+	return opcode == IR_JUMP || opcode == IR_BRANCH || opcode == IR_SWITCH || opcode == IR_RETURN || opcode == IR_RESUME ? true : false;
+}
+
+/*
+Purpose: Get the blocks, that a terminator jumps to (the landing pad of the block isn't included)
+Return Type: int => Number of targets (a block can occur several times)
+Params: struct IRFunction *function => Function of the instruction (holds the blocks of the switches);
+		struct IRInstruction *instruction => Instruction to check;
+		int **targets => Receives the array of the targets;
+		int *buffer => Storage for up to two targets, if the instruction has no own array
+*/
+int IR_get_targets(struct IRFunction *function, struct IRInstruction *instruction, int **targets, int *buffer) {
+	*targets = buffer;
+
+	switch (instruction->opcode) {
+	case IR_JUMP:
+		buffer[0] = instruction->a;
+		return 1;
+	case IR_BRANCH:
+		buffer[0] = instruction->b;
+		buffer[1] = instruction->c;
+		return 2;
+	case IR_SWITCH:
+		*targets = &function->cases[instruction->b];
+		return instruction->c + 1;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * <p>
+ * Checks whether an instruction can raise a runtime error, so it
+ * continues in the landing pad of its block.
+ * </p>
+ * 
+ * <p>
+ * Integer divisions can divide by zero, calls can overflow the stack
+ * or pass on the error of the callee, resume raises the caught error
+ * again. The string operations fail, if no memory is left, the object
+ * and array instructions also fail on null references, indices out of
+ * bounds and negative lengths.
+ * </p>
+ * 
+ * @param *instruction  Instruction to check
+ */
+int IR_can_raise(struct IRInstruction *instruction) {
+	switch (instruction->opcode) {
+	case IR_CALL:
+	case IR_RESUME:
+	case IR_CONCAT:
+	case IR_BUILDER:
+	case IR_APPEND:
+	case IR_NEW:
+	case IR_NEW_ARRAY:
+	case IR_LOAD_FIELD:
+	case IR_STORE_FIELD:
+	case IR_LOAD_ELEMENT:
+	case IR_STORE_ELEMENT:
+	case IR_CALL_VIRTUAL:
+	case IR_CHECK_NULL:
+		return true;
+	case IR_DIV:
+	case IR_MOD:
+		return instruction->type != DOUBLE && instruction->type != FLOAT ? true : false;
+	default:
+		return false;
+	}
+}
+
+/**
+ * <p>
+ * Checks whether the current block already ends with a terminator.
+ * </p>
+ * 
+ * @param *function Function to check
+ */
+int IR_is_block_terminated(struct IRFunction *function) {
+	if (function->currentBlock < 0) {
+		return true;
+	}
+
+	struct IRBlock *block = &function->blocks[function->currentBlock];
+
+	if (function->instructionCount == 0 || block->firstInstruction >= function->instructionCount) {
+		return false;
+	}
+
+	return (int)IR_is_terminator(function->instructions[function->instructionCount - 1].opcode);
+}
+
+/**
+ * <p>
+ * Finishes the lowering of a function.
+ * </p>
+ * 
+ * <p>
+ * Blocks, that can't be reached from the entry block (e.g. code after
+ * a return) are removed and the remaining blocks are renumbered in
+ * layout order, so block `n + 1` directly follows block `n`. A landing
+ * pad is reached from the blocks, that use it, blocks without an
+ * instruction, that can raise a runtime error, don't need their pad.
+ * </p>
+ * 
+ * @param *function Function to finish
+ */
+void IR_finish_function(struct IRFunction *function) {
+	if ((int)IR_is_block_terminated(function) == false) {
+		(void)IR_emit(function, IR_RETURN, function->returnType, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, 0);
+	}
+
+	function->currentBlock = -1;
+	size_t count = function->blockCount;
+	int *layout = (int*)malloc((count + 1) * sizeof(int));
+	int *blockAt = (int*)malloc((function->instructionCount + 1) * sizeof(int));
+	int *newIndex = (int*)malloc((count + 1) * sizeof(int));
+	int *worklist = (int*)malloc((count + 1) * sizeof(int));
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((function->instructionCount + 1) * sizeof(struct IRInstruction));
+
+	if (layout == NULL || blockAt == NULL || newIndex == NULL || worklist == NULL || instructions == NULL) {
+		(void)free(layout);
+		(void)free(blockAt);
+		(void)free(newIndex);
+		(void)free(worklist);
+		(void)free(instructions);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	//Started blocks in layout order with their sizes
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		blockAt[i] = -1;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		newIndex[i] = -1;
+
+		if (function->blocks[i].firstInstruction < function->instructionCount) {
+			blockAt[function->blocks[i].firstInstruction] = (int)i;
+		}
+	}
+
+	size_t started = 0;
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		if (blockAt[i] >= 0) {
+			layout[started++] = blockAt[i];
+		}
+	}
+
+	for (size_t i = 0; i < started; i++) {
+		struct IRBlock *block = &function->blocks[layout[i]];
+		size_t end = i + 1 < started ? function->blocks[layout[i + 1]].firstInstruction : function->instructionCount;
+		int raises = false;
+		block->instructionCount = end - block->firstInstruction;
+
+		for (size_t n = block->firstInstruction; n < end && raises == false; n++) {
+			raises = (int)IR_can_raise(&function->instructions[n]);
+		}
+
+		block->handler = raises == true ? block->handler : -1;
+	}
+
+	//Reachability from the entry block (newIndex is used as mark)
+	size_t pending = 0;
+
+	if (started > 0) {
+		newIndex[layout[0]] = 0;
+		worklist[pending++] = layout[0];
+	}
+
+	while (pending > 0) {
+		struct IRBlock *block = &function->blocks[worklist[--pending]];
+		struct IRInstruction *last = &function->instructions[block->firstInstruction + block->instructionCount - 1];
+		int buffer[2];
+		int *targets = NULL;
+		int targetCount = (int)IR_get_targets(function, last, &targets, buffer);
+
+		//The landing pad is visited after the targets
+		for (int n = 0; n <= targetCount; n++) {
+			int target = n < targetCount ? targets[n] : block->handler;
+
+			if (target >= 0 && (size_t)target < count && newIndex[target] < 0
+				&& function->blocks[target].firstInstruction != IR_UNSTARTED_BLOCK) {
+				newIndex[target] = 0;
+				worklist[pending++] = target;
+			}
+		}
+	}
+
+	//Copy the reachable blocks in layout order
+	struct IRBlock *blocks = (struct IRBlock*)malloc((started + 1) * sizeof(struct IRBlock));
+	size_t blockCount = 0;
+	size_t instructionCount = 0;
+
+	if (blocks == NULL) {
+		(void)free(layout);
+		(void)free(blockAt);
+		(void)free(newIndex);
+		(void)free(worklist);
+		(void)free(instructions);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < started; i++) {
+		if (newIndex[layout[i]] < 0) {
+			continue;
+		}
+
+		struct IRBlock *block = &function->blocks[layout[i]];
+		newIndex[layout[i]] = (int)blockCount;
+		blocks[blockCount].firstInstruction = instructionCount;
+		blocks[blockCount].instructionCount = block->instructionCount;
+		blocks[blockCount].handler = block->handler;
+		blocks[blockCount].frequency = block->frequency;
+		(void)memcpy(&instructions[instructionCount], &function->instructions[block->firstInstruction], block->instructionCount * sizeof(struct IRInstruction));
+		instructionCount += block->instructionCount;
+		blockCount++;
+	}
+
+	for (size_t i = 0; i < instructionCount; i++) {
+		struct IRInstruction *instruction = &instructions[i];
+
+		if (instruction->opcode == IR_JUMP) {
+			instruction->a = instruction->a >= 0 && (size_t)instruction->a < count ? newIndex[instruction->a] : -1;
+		} else if (instruction->opcode == IR_BRANCH) {
+			instruction->b = instruction->b >= 0 && (size_t)instruction->b < count ? newIndex[instruction->b] : -1;
+			instruction->c = instruction->c >= 0 && (size_t)instruction->c < count ? newIndex[instruction->c] : -1;
+		} else if (instruction->opcode == IR_SWITCH) {
+			for (int n = 0; n <= instruction->c; n++) {
+				int *target = &function->cases[instruction->b + n];
+				*target = *target >= 0 && (size_t)*target < count ? newIndex[*target] : -1;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < blockCount; i++) {
+		blocks[i].handler = blocks[i].handler >= 0 && (size_t)blocks[i].handler < count ? newIndex[blocks[i].handler] : -1;
+	}
+
+	(void)free(function->instructions);
+	(void)free(function->blocks);
+	function->instructions = instructions;
+	function->instructionCount = instructionCount;
+	function->instructionCapacity = function->instructionCount + 1;
+	function->blocks = blocks;
+	function->blockCount = blockCount;
+	function->blockCapacity = started + 1;
+
+	(void)free(layout);
+	(void)free(blockAt);
+	(void)free(newIndex);
+	(void)free(worklist);
+}
+
+/**
+ * <p>
+ * Grows an array, if it is full.
+ * </p>
+ * 
+ * @returns 1 if the array has space for another entry, else 0
+ * 
+ * @param **array       Pointer to the array
+ * @param *capacity     Capacity of the array
+ * @param count         Number of used entries
+ * @param size          Size of an entry
+ */
+int IR_grow(void **array, size_t *capacity, size_t count, size_t size) {
+	if (count < *capacity) {
+		return true;
+	}
+
+	size_t newCapacity = *capacity < 8 ? 8 : *capacity * 2;
+	void *grown = realloc(*array, newCapacity * size);
+
+	if (grown == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return false;
+	}
+
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, (newCapacity - *capacity) * size);
+	*array = grown;
+	*capacity = newCapacity;
+	return true;
+}
+
+int IR_is_integral_type(enum VarType type) {
+	return type == INTEGER || type == LONG || type == SHORT || type == CHAR ? true : false;
+}
+
+int IR_is_numeric_type(enum VarType type) {
+	return (int)IR_is_integral_type(type) == true || type == DOUBLE || type == FLOAT ? true : false;
+}
+
+int IR_is_register(struct IRFunction *function, int reg) {
+	return reg >= 0 && (size_t)reg < function->registerCount ? true : false;
+}
+
+enum VarType IR_get_register_type(struct IRFunction *function, int reg) {
+	return (int)IR_is_register(function, reg) == true ? function->registers[reg].type : null;
+}
+
+/**
+ * <p>
+ * Checks the structure and the types of all functions.
+ * </p>
+ * 
+ * <p>
+ * Every block has to end with exactly one terminator, all operands
+ * have to refer to existing registers, blocks, globals, strings or
+ * functions and the types of the operands have to match the
+ * instruction. Each problem is reported as DIAG_IR_VERIFICATION.
+ * </p>
+ * 
+ * @returns The number of problems (0 = the module is valid)
+ * 
+ * @param *module   Module to verify
+ */
+int IR_verify_module(struct IRModule *module) {
+	if (module == NULL) {
+		return 0;
+	}
+
+	int problems = 0;
+
+	if (module->entryFunction < 0 || (size_t)module->entryFunction >= module->functionCount) {
+		(void)REPORT_DIAGNOSTIC(DIAG_IR_VERIFICATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "IRVerificationException: The module has no entry function.");
+		problems++;
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		problems += (int)IR_verify_function(module, module->functions[i]);
+	}
+
+	return problems;
+}
+
+int IR_verify_function(struct IRModule *module, struct IRFunction *function) {
+	int problems = 0;
+	size_t expectedStart = 0;
+
+	if (function->blockCount == 0) {
+		(void)IR_report_problem(function, 0, "function without blocks");
+		return 1;
+	}
+
+	if (function->paramCount < 0 || (size_t)function->paramCount > function->registerCount) {
+		(void)IR_report_problem(function, 0, "more parameters than registers");
+		problems++;
+	}
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+
+		if (block->firstInstruction != expectedStart || block->instructionCount == 0) {
+			(void)IR_report_problem(function, expectedStart, "blocks aren't contiguous");
+			return problems + 1;
+		}
+
+		if (block->handler < -1 || block->handler >= (int)function->blockCount || block->handler == (int)i) {
+			(void)IR_report_problem(function, expectedStart, "invalid landing pad");
+			problems++;
+		}
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			size_t index = block->firstInstruction + n;
+			int isLast = n + 1 == block->instructionCount ? true : false;
+
+			if ((int)IR_is_terminator(function->instructions[index].opcode) != isLast) {
+				(void)IR_report_problem(function, index, isLast == true ? "block doesn't end with a terminator" : "terminator in the middle of a block");
+				problems++;
+			}
+
+			problems += (int)IR_verify_instruction(module, function, index);
+		}
+
+		expectedStart += block->instructionCount;
+	}
+
+	if (expectedStart != function->instructionCount) {
+		(void)IR_report_problem(function, expectedStart, "instructions outside of the blocks");
+		problems++;
+	}
+
+	return problems;
+}
+
+/*
+Purpose: Verify the operands and types of a single instruction
+Return Type: int => Number of problems
+Params: struct IRModule *module => Module of the function;
+		struct IRFunction *function => Function of the instruction;
+		size_t index => Index of the instruction
+*/
+int IR_verify_instruction(struct IRModule *module, struct IRFunction *function, size_t index) {
+	struct IRInstruction *instruction = &function->instructions[index];
+	enum VarType type = instruction->type;
+	enum VarType destType = IR_get_register_type(function, instruction->dest);
+	enum VarType aType = IR_get_register_type(function, instruction->a);
+	enum VarType bType = IR_get_register_type(function, instruction->b);
+	int problems = 0;
+
+	//Instructions with a result have to write a register of the result type
+	switch (instruction->opcode) {
+	case IR_NOP:
+	case IR_STORE_GLOBAL:
+	case IR_STORE_FIELD:
+	case IR_STORE_ELEMENT:
+	case IR_CHECK_NULL:
+	case IR_JUMP:
+	case IR_BRANCH:
+	case IR_SWITCH:
+	case IR_RETURN:
+	case IR_RESUME:
+		break;
+	case IR_CALL:
+	case IR_CALL_VIRTUAL:
+		if (instruction->dest == IR_NO_REGISTER) {
+			break;
+		}
+		//Fall through
+	default:
+		if ((int)IR_is_register(function, instruction->dest) == false || destType != type) {
+			(void)IR_report_problem(function, index, "invalid result register");
+			problems++;
+		}
+
+		break;
+	}
+
+	switch (instruction->opcode) {
+	case IR_NOP:
+		break;
+	case IR_CONST_INT:
+		//A reference constant is null
+		if (type == CLASS_REF && instruction->value.integer != 0) {
+			(void)IR_report_problem(function, index, "reference constant, that isn't null");
+			problems++;
+		} else if ((int)IR_is_integral_type(type) == false && type != BOOLEAN && type != CLASS_REF) {
+			(void)IR_report_problem(function, index, "integer constant of a non integral type");
+			problems++;
+		}
+
+		break;
+	case IR_CONST_FLOAT:
+		if (type != DOUBLE && type != FLOAT) {
+			(void)IR_report_problem(function, index, "floating point constant of a non floating point type");
+			problems++;
+		}
+
+		break;
+	case IR_CONST_STRING:
+		if (type != STRING || instruction->a < 0 || (size_t)instruction->a >= module->stringCount) {
+			(void)IR_report_problem(function, index, "invalid string constant");
+			problems++;
+		}
+
+		break;
+	case IR_MOVE:
+		if (aType != type) {
+			(void)IR_report_problem(function, index, "move between different types");
+			problems++;
+		}
+
+		break;
+	case IR_LOAD_GLOBAL:
+	case IR_STORE_GLOBAL:
+		if (instruction->a < 0 || (size_t)instruction->a >= module->globalCount || module->globals[instruction->a].type != type) {
+			(void)IR_report_problem(function, index, "invalid global");
+			problems++;
+		} else if (instruction->opcode == IR_STORE_GLOBAL && bType != type) {
+			(void)IR_report_problem(function, index, "stored value doesn't match the type of the global");
+			problems++;
+		}
+
+		break;
+	case IR_ADD:
+	case IR_SUB:
+	case IR_MUL:
+	case IR_DIV:
+	case IR_MOD:
+		if ((int)IR_is_numeric_type(type) == false || aType != type || bType != type) {
+			(void)IR_report_problem(function, index, "arithmetic operands don't match the result type");
+			problems++;
+		}
+
+		break;
+	case IR_SHL:
+	case IR_SHR:
+	case IR_BIT_AND:
+	case IR_BIT_OR:
+	case IR_BIT_XOR:
+		if ((int)IR_is_integral_type(type) == false || aType != type || bType != type) {
+			(void)IR_report_problem(function, index, "bitwise operands don't match the integral result type");
+			problems++;
+		}
+
+		break;
+	case IR_NEG:
+		if ((int)IR_is_numeric_type(type) == false || aType != type) {
+			(void)IR_report_problem(function, index, "negated operand doesn't match the result type");
+			problems++;
+		}
+
+		break;
+	case IR_NOT:
+		if (type != BOOLEAN || aType != BOOLEAN) {
+			(void)IR_report_problem(function, index, "not on a non boolean");
+			problems++;
+		}
+
+		break;
+	case IR_EQ:
+	case IR_NE:
+	case IR_LT:
+	case IR_LE:
+	case IR_GT:
+	case IR_GE:
+		if (type != BOOLEAN || aType != bType || aType == null
+			|| ((int)IR_is_numeric_type(aType) == false && (instruction->opcode != IR_EQ && instruction->opcode != IR_NE))) {
+			(void)IR_report_problem(function, index, "comparison of incompatible operands");
+			problems++;
+		}
+
+		break;
+	case IR_CONVERT:
+		if ((int)IR_is_numeric_type(type) == false || (int)IR_is_numeric_type(aType) == false) {
+			(void)IR_report_problem(function, index, "conversion between non numeric types");
+			problems++;
+		}
+
+		break;
+	case IR_CONCAT:
+	case IR_APPEND:
+		if (type != STRING || aType != STRING || bType != STRING) {
+			(void)IR_report_problem(function, index, "concatenation of non strings");
+			problems++;
+		} else if (instruction->opcode == IR_APPEND && instruction->dest != instruction->a) {
+			(void)IR_report_problem(function, index, "append into another register than the builder");
+			problems++;
+		}
+
+		break;
+	case IR_BUILDER:
+		if (type != STRING || aType != STRING) {
+			(void)IR_report_problem(function, index, "builder of a non string");
+			problems++;
+		}
+
+		break;
+	case IR_CALL:
+		if (instruction->a < 0 || (size_t)instruction->a >= module->functionCount) {
+			(void)IR_report_problem(function, index, "call of an unknown function");
+			problems++;
+			break;
+		}
+
+		problems += (int)IR_verify_arguments(function, index, module->functions[instruction->a]);
+		break;
+	case IR_NEW:
+		if (type != CLASS_REF || instruction->a < 0 || (size_t)instruction->a >= module->classCount
+			|| module->classes[instruction->a].isInterface == true) {
+			(void)IR_report_problem(function, index, "new of an unknown class");
+			problems++;
+		}
+
+		break;
+	case IR_NEW_ARRAY:
+		if (type != CLASS_REF || instruction->c < 1 || instruction->b < 0 || (size_t)(instruction->b + instruction->c) > function->argumentCount
+			|| (int)IR_is_register(function, instruction->dest) == false || function->registers[instruction->dest].reference.dimension < instruction->c) {
+			(void)IR_report_problem(function, index, "array with more lengths than dimensions");
+			problems++;
+			break;
+		}
+
+		for (int i = 0; i < instruction->c; i++) {
+			if (IR_get_register_type(function, function->arguments[instruction->b + i]) != INTEGER) {
+				(void)IR_report_problem(function, index, "array length isn't an int");
+				problems++;
+			}
+		}
+
+		break;
+	case IR_LOAD_FIELD:
+	case IR_STORE_FIELD: {
+		long long classIndex = instruction->value.integer;
+
+		if (aType != CLASS_REF || classIndex < 0 || (size_t)classIndex >= module->classCount
+			|| instruction->b < 0 || (size_t)instruction->b >= module->classes[classIndex].fieldCount) {
+			(void)IR_report_problem(function, index, "access of an unknown field");
+			problems++;
+		} else if (module->classes[classIndex].fields[instruction->b].type != type
+			|| (instruction->opcode == IR_STORE_FIELD && IR_get_register_type(function, instruction->c) != type)) {
+			(void)IR_report_problem(function, index, "field access doesn't match the type of the field");
+			problems++;
+		}
+
+		break;
+	}
+	case IR_LOAD_ELEMENT:
+	case IR_STORE_ELEMENT: {
+		struct IRReference reference = (int)IR_is_register(function, instruction->a) == true ? function->registers[instruction->a].reference : IR_NO_REFERENCE;
+		enum VarType elementType = reference.dimension > 1 ? CLASS_REF : reference.elementType;
+
+		if (aType != CLASS_REF || reference.dimension < 1 || bType != INTEGER) {
+			(void)IR_report_problem(function, index, "element access on a non array");
+			problems++;
+		} else if (elementType != type || (instruction->opcode == IR_STORE_ELEMENT && IR_get_register_type(function, instruction->c) != type)) {
+			(void)IR_report_problem(function, index, "element access doesn't match the type of the elements");
+			problems++;
+		}
+
+		break;
+	}
+	case IR_CALL_VIRTUAL: {
+		long long classIndex = instruction->value.integer;
+
+		if (classIndex < 0 || (size_t)classIndex >= module->classCount || instruction->a < 0
+			|| (size_t)instruction->a >= module->classes[classIndex].methodCount) {
+			(void)IR_report_problem(function, index, "virtual call of an unknown method");
+			problems++;
+			break;
+		}
+
+		struct IRClass *irClass = &module->classes[classIndex];
+
+		if (instruction->c < 1 || instruction->b < 0 || (size_t)(instruction->b + instruction->c) > function->argumentCount
+			|| IR_get_register_type(function, function->arguments[instruction->b]) != CLASS_REF) {
+			(void)IR_report_problem(function, index, "virtual call without an object");
+			problems++;
+		} else if (irClass->isInterface == false && irClass->methods[instruction->a] >= 0) {
+			//The methods of an interface have no function, the implementations are checked by their classes
+			problems += (int)IR_verify_arguments(function, index, module->functions[irClass->methods[instruction->a]]);
+		}
+
+		break;
+	}
+	case IR_CHECK_NULL:
+		if (aType != CLASS_REF) {
+			(void)IR_report_problem(function, index, "null check of a non reference");
+			problems++;
+		}
+
+		break;
+	case IR_JUMP:
+		if (instruction->a < 0 || (size_t)instruction->a >= function->blockCount) {
+			(void)IR_report_problem(function, index, "jump to an unknown block");
+			problems++;
+		}
+
+		break;
+	case IR_BRANCH:
+		if (aType != BOOLEAN) {
+			(void)IR_report_problem(function, index, "branch on a non boolean");
+			problems++;
+		}
+
+		if (instruction->b < 0 || (size_t)instruction->b >= function->blockCount
+			|| instruction->c < 0 || (size_t)instruction->c >= function->blockCount) {
+			(void)IR_report_problem(function, index, "branch to an unknown block");
+			problems++;
+		}
+
+		break;
+	case IR_SWITCH:
+		if ((int)IR_is_integral_type(aType) == false && aType != BOOLEAN) {
+			(void)IR_report_problem(function, index, "switch on a non integral value");
+			problems++;
+		}
+
+		if (instruction->c < 1 || instruction->b < 0 || (size_t)instruction->b + (size_t)instruction->c >= function->caseCount) {
+			(void)IR_report_problem(function, index, "switch without a table");
+			problems++;
+			break;
+		}
+
+		for (int i = 0; i <= instruction->c; i++) {
+			int target = function->cases[instruction->b + i];
+
+			if (target < 0 || (size_t)target >= function->blockCount) {
+				(void)IR_report_problem(function, index, "switch to an unknown block");
+				problems++;
+				break;
+			}
+		}
+
+		break;
+	case IR_RETURN:
+		if ((function->returnType == VOID) != (instruction->a == IR_NO_REGISTER)
+			|| (instruction->a != IR_NO_REGISTER && aType != function->returnType)) {
+			(void)IR_report_problem(function, index, "returned value doesn't match the return type");
+			problems++;
+		}
+
+		break;
+	case IR_RESUME:
+		break;
+	default:
+		(void)IR_report_problem(function, index, "unknown opcode");
+		problems++;
+		break;
+	}
+
+	return problems;
+}
+
+/*
+Purpose: Verify the arguments and the result of a call against the callee
+Return Type: int => Number of problems
+Params: struct IRFunction *function => Function of the call;
+		size_t index => Index of the call;
+		struct IRFunction *callee => The called function
+*/
+int IR_verify_arguments(struct IRFunction *function, size_t index, struct IRFunction *callee) {
+	struct IRInstruction *instruction = &function->instructions[index];
+	int problems = 0;
+
+	if (instruction->c != callee->paramCount || instruction->b < 0
+		|| (size_t)(instruction->b + instruction->c) > function->argumentCount) {
+		(void)IR_report_problem(function, index, "argument count doesn't match the callee");
+		return 1;
+	}
+
+	for (int i = 0; i < instruction->c; i++) {
+		int argument = function->arguments[instruction->b + i];
+
+		if ((size_t)i >= callee->registerCount || IR_get_register_type(function, argument) != callee->registers[i].type) {
+			(void)IR_report_problem(function, index, "argument type doesn't match the parameter");
+			problems++;
+		}
+	}
+
+	if (instruction->type != callee->returnType) {
+		(void)IR_report_problem(function, index, "call type doesn't match the return type of the callee");
+		problems++;
+	}
+
+	return problems;
+}
+
+void IR_report_problem(struct IRFunction *function, size_t index, const char *problem) {
+	size_t line = index < function->instructionCount ? function->instructions[index].line : function->line;
+	(void)REPORT_DIAGNOSTIC(DIAG_IR_VERIFICATION, SEVERITY_ERROR, line, DIAGNOSTIC_NO_POSITION, 0,
+		"IRVerificationException: %s (function \"%s\", instruction %lu)", problem, function->name, (unsigned long)index);
+	(void)REPORT_DIAGNOSTIC_DETAILS("The generated IR is invalid.", "This error is an internal issue, please report it with the source.");
+}
+
+/**
+ * <p>
+ * Returns the name of a type, as it is written in the source.
+ * </p>
+ * 
+ * @param type  Type to get the name of
+ */
+const char *IR_get_type_name(enum VarType type) {
+	switch (type) {
+	case INTEGER:
+		return "int";
+	case LONG:
+		return "long";
+	case SHORT:
+		return "short";
+	case DOUBLE:
+		return "double";
+	case FLOAT:
+		return "float";
+	case CHAR:
+		return "char";
+	case BOOLEAN:
+		return "boolean";
+	case STRING:
+		return "String";
+	case VOID:
+		return "void";
+	case CLASS_REF:
+		return "ref";
+	default:
+		return "?";
+	}
+}
+
+/**
+ * <p>
+ * Writes a type, a reference is written as its class or array type
+ * ({@code Node}, {@code int[][]}), the null constant as {@code null}.
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *module   Module with the classes
+ * @param type      Type to write
+ * @param reference Object or array of a reference
+ */
+void IR_dump_type(FILE *output, struct IRModule *module, enum VarType type, struct IRReference reference) {
+	if (type != CLASS_REF) {
+		(void)fprintf(output, "%s", IR_get_type_name(type));
+		return;
+	}
+
+	int hasClass = reference.classIndex >= 0 && (size_t)reference.classIndex < module->classCount ? true : false;
+
+	if (reference.dimension == 0) {
+		(void)fprintf(output, "%s", hasClass == true ? module->classes[reference.classIndex].name : "null");
+		return;
+	}
+
+	(void)fprintf(output, "%s", hasClass == true ? module->classes[reference.classIndex].name : IR_get_type_name(reference.elementType));
+
+	for (int i = 0; i < reference.dimension; i++) {
+		(void)fprintf(output, "[]");
+	}
+}
+
+/**
+ * <p>
+ * Writes the module in a readable form (see docs/ir.md).
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *module   Module to dump
+ */
+void IR_dump_module(FILE *output, struct IRModule *module) {
+	if (output == NULL || module == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < module->classCount; i++) {
+		(void)IR_dump_class(output, module, i);
+	}
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		struct IRGlobal *global = &module->globals[i];
+		(void)fprintf(output, "%s @%lu:", global->constant == true ? "const" : "global", (unsigned long)i);
+		(void)IR_dump_type(output, module, global->type, global->reference);
+		(void)fprintf(output, " %s\n", global->name);
+	}
+
+	for (size_t i = 0; i < module->stringCount; i++) {
+		(void)fprintf(output, "string $%lu \"%s\"\n", (unsigned long)i, module->strings[i]);
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		(void)fprintf(output, "\n");
+		(void)IR_dump_function(output, module, module->functions[i]);
+	}
+}
+
+void IR_dump_class(FILE *output, struct IRModule *module, size_t index) {
+	struct IRClass *irClass = &module->classes[index];
+	(void)fprintf(output, "%s #%lu %s", irClass->isInterface == true ? "interface" : "class", (unsigned long)index, irClass->name);
+
+	if (irClass->isInterface == false) {
+		(void)fprintf(output, " (%lu bytes)", (unsigned long)irClass->size);
+	}
+
+	if (irClass->parent >= 0) {
+		(void)fprintf(output, " : %s", module->classes[irClass->parent].name);
+	}
+
+	for (size_t i = 0; i < irClass->interfaceCount; i++) {
+		(void)fprintf(output, "%s%s", i == 0 ? " implements " : ", ", module->classes[irClass->interfaces[i]].name);
+	}
+
+	(void)fprintf(output, "\n");
+
+	for (size_t i = 0; i < irClass->fieldCount; i++) {
+		struct IRField *field = &irClass->fields[i];
+		(void)fprintf(output, "    field .%lu @%lu:", (unsigned long)i, (unsigned long)field->offset);
+		(void)IR_dump_type(output, module, field->type, field->reference);
+		(void)fprintf(output, " %s\n", field->name);
+	}
+
+	for (size_t i = 0; i < irClass->methodCount && irClass->isInterface == false; i++) {
+		int method = irClass->methods[i];
+		(void)fprintf(output, "    method [%lu] %s\n", (unsigned long)i, method >= 0 ? module->functions[method]->name : "?");
+	}
+
+	if (irClass->isInterface == true) {
+		(void)fprintf(output, "    methods [%lu] ... [%lu]\n", (unsigned long)irClass->interfaceBase,
+			(unsigned long)(irClass->interfaceBase + irClass->methodCount - 1));
+	}
+
+	for (size_t i = 0; i < irClass->interfaceSlotCount && irClass->isInterface == false; i++) {
+		if (irClass->interfaceSlots[i] >= 0) {
+			(void)fprintf(output, "    interface [%lu] -> [%i]\n", (unsigned long)i, irClass->interfaceSlots[i]);
+		}
+	}
+}
+
+void IR_dump_function(FILE *output, struct IRModule *module, struct IRFunction *function) {
+	(void)fprintf(output, "fn %s(", function->name);
+
+	for (int i = 0; i < function->paramCount && (size_t)i < function->registerCount; i++) {
+		struct IRRegister *reg = &function->registers[i];
+		(void)fprintf(output, "%s%%%i:", i == 0 ? "" : ", ", i);
+		(void)IR_dump_type(output, module, reg->type, reg->reference);
+		(void)fprintf(output, " %s", reg->name == NULL ? "" : reg->name);
+	}
+
+	(void)fprintf(output, ") -> ");
+	(void)IR_dump_type(output, module, function->returnType, function->returnReference);
+	(void)fprintf(output, " {\n");
+
+	for (size_t i = function->paramCount > 0 ? function->paramCount : 0; i < function->registerCount; i++) {
+		if (function->registers[i].name != NULL) {
+			(void)fprintf(output, "    ; %%%lu:", (unsigned long)i);
+			(void)IR_dump_type(output, module, function->registers[i].type, function->registers[i].reference);
+			(void)fprintf(output, " %s\n", function->registers[i].name);
+		}
+	}
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		if (block->handler >= 0) {
+			(void)fprintf(output, "b%lu:    ; landing pad b%i\n", (unsigned long)i, block->handler);
+		} else {
+			(void)fprintf(output, "b%lu:\n", (unsigned long)i);
+		}
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			(void)IR_dump_instruction(output, module, function, &function->instructions[block->firstInstruction + n]);
+		}
+	}
+
+	(void)fprintf(output, "}\n");
+}
+
+void IR_dump_instruction(FILE *output, struct IRModule *module, struct IRFunction *function, struct IRInstruction *instruction) {
+	const char *name = IR_OPCODE_NAMES[instruction->opcode];
+	(void)fprintf(output, "    ");
+
+	if (instruction->dest != IR_NO_REGISTER && instruction->opcode != IR_STORE_GLOBAL && (int)IR_is_terminator(instruction->opcode) == false) {
+		struct IRReference reference = (int)IR_is_register(function, instruction->dest) == true ? function->registers[instruction->dest].reference : IR_NO_REFERENCE;
+		(void)fprintf(output, "%%%i:", instruction->dest);
+		(void)IR_dump_type(output, module, instruction->type, reference);
+		(void)fprintf(output, " = ");
+	}
+
+	switch (instruction->opcode) {
+	case IR_CONST_INT:
+		(void)fprintf(output, "%s %lli\n", name, instruction->value.integer);
+		break;
+	case IR_CONST_FLOAT:
+		(void)fprintf(output, "%s %g\n", name, instruction->value.floating);
+		break;
+	case IR_CONST_STRING:
+		(void)fprintf(output, "%s $%i\n", name, instruction->a);
+		break;
+	case IR_LOAD_GLOBAL:
+		(void)fprintf(output, "%s @%i\n", name, instruction->a);
+		break;
+	case IR_STORE_GLOBAL:
+		(void)fprintf(output, "%s @%i, %%%i\n", name, instruction->a, instruction->b);
+		break;
+	case IR_CALL: {
+		const char *callee = instruction->a >= 0 && (size_t)instruction->a < module->functionCount ? module->functions[instruction->a]->name : "?";
+		(void)fprintf(output, "%s %s(", name, callee);
+
+		for (int i = 0; i < instruction->c && instruction->b >= 0 && (size_t)(instruction->b + i) < function->argumentCount; i++) {
+			(void)fprintf(output, "%s%%%i", i == 0 ? "" : ", ", function->arguments[instruction->b + i]);
+		}
+
+		(void)fprintf(output, ")\n");
+		break;
+	}
+	case IR_NEW:
+		(void)fprintf(output, "%s %s\n", name, module->classes[instruction->a].name);
+		break;
+	case IR_NEW_ARRAY:
+		(void)fprintf(output, "%s", name);
+
+		for (int i = 0; i < instruction->c; i++) {
+			(void)fprintf(output, " [%%%i]", function->arguments[instruction->b + i]);
+		}
+
+		(void)fprintf(output, "\n");
+		break;
+	case IR_LOAD_FIELD:
+	case IR_STORE_FIELD: {
+		struct IRClass *irClass = &module->classes[instruction->value.integer];
+		(void)fprintf(output, "%s %%%i, %s.%s", name, instruction->a, irClass->name, irClass->fields[instruction->b].name);
+
+		if (instruction->opcode == IR_STORE_FIELD) {
+			(void)fprintf(output, ", %%%i", instruction->c);
+		}
+
+		(void)fprintf(output, "\n");
+		break;
+	}
+	case IR_LOAD_ELEMENT:
+		(void)fprintf(output, "%s %%%i[%%%i]%s\n", name, instruction->a, instruction->b, instruction->value.integer == true ? "    ; in bounds" : "");
+		break;
+	case IR_STORE_ELEMENT:
+		(void)fprintf(output, "%s %%%i[%%%i], %%%i%s\n", name, instruction->a, instruction->b, instruction->c, instruction->value.integer == true ? "    ; in bounds" : "");
+		break;
+	case IR_CALL_VIRTUAL: {
+		struct IRClass *irClass = &module->classes[instruction->value.integer];
+		(void)fprintf(output, "%s %s[%i](", name, irClass->name, instruction->a);
+
+		for (int i = 0; i < instruction->c; i++) {
+			(void)fprintf(output, "%s%%%i", i == 0 ? "" : ", ", function->arguments[instruction->b + i]);
+		}
+
+		(void)fprintf(output, ")\n");
+		break;
+	}
+	case IR_JUMP:
+		(void)fprintf(output, "%s b%i\n", name, instruction->a);
+		break;
+	case IR_BRANCH:
+		(void)fprintf(output, "%s %%%i, b%i, b%i\n", name, instruction->a, instruction->b, instruction->c);
+		break;
+	case IR_SWITCH:
+		(void)fprintf(output, "%s %%%i, b%i, %lli [", name, instruction->a, function->cases[instruction->b], instruction->value.integer);
+
+		for (int i = 1; i <= instruction->c; i++) {
+			(void)fprintf(output, "%sb%i", i == 1 ? "" : ", ", function->cases[instruction->b + i]);
+		}
+
+		(void)fprintf(output, "]\n");
+		break;
+	case IR_RETURN:
+		if (instruction->a == IR_NO_REGISTER) {
+			(void)fprintf(output, "%s\n", name);
+		} else {
+			(void)fprintf(output, "%s %%%i\n", name, instruction->a);
+		}
+
+		break;
+	case IR_MOVE:
+	case IR_NEG:
+	case IR_NOT:
+	case IR_CONVERT:
+	case IR_BUILDER:
+	case IR_CHECK_NULL:
+		(void)fprintf(output, "%s %%%i\n", name, instruction->a);
+		break;
+	case IR_NOP:
+	case IR_RESUME:
+		(void)fprintf(output, "%s\n", name);
+		break;
+	default:
+		(void)fprintf(output, "%s %%%i, %%%i\n", name, instruction->a, instruction->b);
+		break;
+	}
+}
+
+size_t IR_count_instructions(struct IRModule *module) {
+	size_t count = 0;
+
+	for (size_t i = 0; module != NULL && i < module->functionCount; i++) {
+		count += module->functions[i]->instructionCount;
+	}
+
+	return count;
+}
+
+void FREE_IR_FUNCTION(struct IRFunction *function) {
+	if (function == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < function->registerCount; i++) {
+		(void)free(function->registers[i].name);
+	}
+
+	(void)free(function->registers);
+	(void)free(function->instructions);
+	(void)free(function->blocks);
+	(void)free(function->arguments);
+	(void)free(function->cases);
+	(void)free(function->name);
+	(void)free(function);
+}
+
+/**
+ * <p>
+ * Frees a module with all functions, globals, strings and classes.
+ * </p>
+ * 
+ * @param *module   Module to free
+ */
+void FREE_IR_MODULE(struct IRModule *module) {
+	if (module == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		(void)FREE_IR_FUNCTION(module->functions[i]);
+	}
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		(void)free(module->globals[i].name);
+	}
+
+	for (size_t i = 0; i < module->stringCount; i++) {
+		(void)free(module->strings[i]);
+	}
+
+	for (size_t i = 0; i < module->classCount; i++) {
+		struct IRClass *irClass = &module->classes[i];
+
+		for (size_t n = 0; n < irClass->fieldCount; n++) {
+			(void)free(irClass->fields[n].name);
+		}
+
+		(void)free(irClass->fields);
+		(void)free(irClass->methods);
+		(void)free(irClass->interfaces);
+		(void)free(irClass->interfaceSlots);
+		(void)free(irClass->name);
+	}
+
+	(void)free(module->classes);
+	(void)free(module->functions);
+	(void)free(module->globals);
+	(void)free(module->strings);
+	(void)free(module);
+}
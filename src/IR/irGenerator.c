@@ -0,0 +1,3629 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <setjmp.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/hashmap.h"
+#include "../../headers/parsetree.h"
+#include "../../headers/semantic.h"
+#include "../../headers/stats.h"
+#include "../../headers/ir.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/irGenerator.c} was created
+ * to lower the checked parsetree into the intermediate representation.
+ *
+ * Every function becomes an IRFunction, the statements of the top level
+ * scope are lowered into the function "<main>". Variables live in
+ * virtual registers, that are reassigned (the IR isn't in SSA form),
+ * the variables of the top level scope are globals.
+ *
+ * The methods and constructors of a class become the functions
+ * "Class.method" and "Class.constructor", that get the object as the
+ * first parameter ("this"). The field initializers of a class run in
+ * "Class.<init>" right after the object was created.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define IR_MAIN_FUNCTION_NAME "<main>"
+
+/**
+ * <p>
+ * Limits of the jump tables of check statements. A range of cases
+ * becomes a table, if it has at least IR_MIN_SWITCH_CASES cases and
+ * at most IR_SWITCH_DENSITY entries per case (up to IR_MAX_SWITCH_TABLE
+ * entries), smaller ranges compare the cases one after the other.
+ * </p>
+ */
+#define IR_MIN_SWITCH_CASES 4
+#define IR_MAX_LINEAR_CASES 3
+#define IR_SWITCH_DENSITY 3
+#define IR_MAX_SWITCH_TABLE 256
+
+enum IRSymbolKind {
+	IR_SYMBOL_GLOBAL,
+	IR_SYMBOL_FUNCTION,
+	IR_SYMBOL_ENUM,
+	IR_SYMBOL_CLASS
+};
+
+/**
+ * <p>
+ * Entry of the global symbols (globals, functions, enums and classes).
+ * </p>
+ */
+struct IRSymbol {
+	enum IRSymbolKind kind;
+	int index;
+};
+
+enum IRLoweringState {
+	IR_NOT_LOWERED,
+	IR_LOWERING,
+	IR_LOWERED
+};
+
+enum IRFunctionKind {
+	IR_PLAIN_FUNCTION,
+	IR_METHOD,
+	IR_CONSTRUCTOR,
+	IR_INITIALIZER
+};
+
+/**
+ * <p>
+ * Declaration of a function of the module. The node of an initializer
+ * is its class, `classIndex` is -1 for the functions of the top level
+ * scope.
+ * </p>
+ */
+struct IRFunctionInfo {
+	Node *node;
+	enum IRLoweringState state;
+	enum IRFunctionKind kind;
+	int classIndex;
+};
+
+/**
+ * <p>
+ * Declaration of a class or interface, the entries have the indices of
+ * the classes of the module.
+ * </p>
+ */
+struct IRClassInfo {
+	Node *node;
+	SemanticTable *table;
+
+	//Function with the field initializers ("Class.<init>"), -1 if the class has none
+	int initializer;
+
+	int *constructors;
+	size_t constructorCount;
+};
+
+enum IRLocationKind {
+	IR_LOCATION_LOCAL,
+	IR_LOCATION_GLOBAL,
+	IR_LOCATION_FIELD,
+	IR_LOCATION_ELEMENT,
+	IR_LOCATION_VALUE
+};
+
+/**
+ * <p>
+ * Target of a read or write, that was resolved once (see
+ * IR_resolve_location), so the object and the index of a compound
+ * assignment aren't lowered twice.
+ * </p>
+ *
+ * <p>
+ * `reg` is the register of a local, the object of a field, the array
+ * of an element or the value itself. `index` is the global, the field
+ * (of the class `classIndex`) or the register with the index of the
+ * element. `proven` is true for an element, whose index the semantic
+ * analysis proved to lie within the array.
+ * </p>
+ */
+struct IRLocation {
+	enum IRLocationKind kind;
+	enum VarType type;
+	struct IRReference reference;
+	int reg;
+	int index;
+	int classIndex;
+	int proven;
+};
+
+struct IRLocal {
+	char *name;
+	int reg;
+};
+
+struct IRLoop {
+	int continueBlock;
+	int breakBlock;
+
+	//Number of the pending finally runnables outside of the loop
+	size_t finallyCount;
+};
+
+/**
+ * <p>
+ * A finally runnable, that has to run before a return, break or
+ * continue leaves its try statement. It runs with the landing pad
+ * outside of the try statement.
+ * </p>
+ */
+struct IRFinally {
+	Node *runnable;
+	int handler;
+};
+
+/**
+ * <p>
+ * An {@code is} statement of a check statement with a constant value.
+ * The order of the statement decides, which of two equal values wins.
+ * </p>
+ */
+struct IRCase {
+	long long value;
+	int block;
+	size_t order;
+};
+
+/**
+ * <p>
+ * State of the lowering.
+ * </p>
+ *
+ * <p>
+ * Functions without a declared return type are lowered on their first
+ * call, so the locals, loops and finally runnables of the caller stay
+ * on the stacks and the callee only sees the entries above its base.
+ * </p>
+ */
+struct IRContext {
+	struct IRModule *module;
+	SemanticTable *table;
+	struct HashMap *symbols;
+	struct IRFunctionInfo *functions;
+	size_t functionCapacity;
+
+	//Declarations of the enums (see IR_SYMBOL_ENUM)
+	Node **enums;
+	size_t enumCount;
+	size_t enumCapacity;
+
+	//Declarations of the classes and interfaces (see IR_SYMBOL_CLASS)
+	struct IRClassInfo *classes;
+	size_t classCount;
+	size_t classCapacity;
+
+	//Function, that is lowered right now, and its class (-1 outside of classes)
+	struct IRFunction *function;
+	int classIndex;
+	int inferReturnType;
+	int scopeDepth;
+
+	struct IRLocal *locals;
+	size_t localCount;
+	size_t localCapacity;
+	size_t localBase;
+
+	struct IRLoop *loops;
+	size_t loopCount;
+	size_t loopCapacity;
+	size_t loopBase;
+
+	struct IRFinally *finallies;
+	size_t finallyCount;
+	size_t finallyCapacity;
+	size_t finallyBase;
+
+	int errors;
+};
+
+/**
+ * <p>
+ * Stream for the IR dump ({@code --dump-ir}), NULL if the IR
+ * shouldn't be dumped.
+ * </p>
+ */
+extern FILE *IR_DUMP;
+extern char *FILE_NAME;
+
+struct VarDec SA_get_VarType(Node *node, int constant, SemanticTable *table);
+SemanticTable *SA_get_layout_table(SemanticTable *mainTable, char *name, enum ScopeType type);
+
+void IR_collect_declarations(struct IRContext *context, Node *root);
+void IR_collect_global(struct IRContext *context, Node *node);
+int IR_collect_function(struct IRContext *context, Node *functionNode, int classIndex);
+void IR_collect_class(struct IRContext *context, Node *node);
+void IR_collect_class_members(struct IRContext *context, int classIndex);
+void IR_collect_class_layout(struct IRContext *context, int classIndex);
+int IR_find_method_function(struct IRContext *context, struct LayoutMethod *method);
+Node *IR_find_member_declaration(Node *classNode, char *name);
+int IR_get_class_index(struct IRContext *context, char *name);
+void IR_add_symbol(struct IRContext *context, char *name, enum IRSymbolKind kind, int index);
+struct IRSymbol *IR_get_symbol(struct IRContext *context, char *name);
+void IR_lower_main(struct IRContext *context, Node *root);
+void IR_lower_function(struct IRContext *context, int index);
+void IR_finish_lowering(struct IRContext *context, size_t line);
+void IR_lower_statements(struct IRContext *context, Node *runnable);
+void IR_lower_scope(struct IRContext *context, Node *runnable);
+size_t IR_lower_statement(struct IRContext *context, Node **statements, size_t index, size_t count);
+void IR_lower_variable(struct IRContext *context, Node *node);
+int IR_lower_initial_value(struct IRContext *context, Node *node, enum VarType *type, struct IRReference *reference);
+void IR_lower_initializers(struct IRContext *context, Node *classNode);
+int IR_is_variable_declaration(Node *node);
+int IR_count_array_lengths(Node *node);
+void IR_lower_assignment(struct IRContext *context, Node *node, enum IROpcode opcode);
+void IR_lower_inc_dec_assignment(struct IRContext *context, Node *node);
+int IR_count_inc_dec(Node *node);
+size_t IR_lower_if_chain(struct IRContext *context, Node **statements, size_t index, size_t count);
+size_t IR_lower_try(struct IRContext *context, Node **statements, size_t index, size_t count);
+void IR_lower_check(struct IRContext *context, Node *node);
+void IR_lower_case_range(struct IRContext *context, int value, struct IRCase *cases, size_t count, int defaultBlock, size_t line);
+void IR_lower_case_chain(struct IRContext *context, Node *node, int value, Node **values, int *blocks, size_t count, int endBlock);
+int IR_get_case_value(struct IRContext *context, Node *node, enum VarType type, long long *value);
+int IR_compare_cases(const void *first, const void *second);
+int IR_fits_type(enum VarType type, long long value);
+void IR_lower_finally(struct IRContext *context, Node *runnable, int handler);
+void IR_lower_while(struct IRContext *context, Node *node);
+void IR_lower_do(struct IRContext *context, Node *node);
+void IR_lower_for(struct IRContext *context, Node *node);
+void IR_lower_return(struct IRContext *context, Node *node);
+void IR_lower_loop_exit(struct IRContext *context, Node *node);
+void IR_lower_pending_finallies(struct IRContext *context, size_t base);
+void IR_push_loop(struct IRContext *context, int continueBlock, int breakBlock);
+void IR_push_finally(struct IRContext *context, Node *runnable, int handler);
+int IR_lower_expression(struct IRContext *context, Node *node);
+int IR_lower_value(struct IRContext *context, Node *node, enum VarType type);
+int IR_lower_condition(struct IRContext *context, Node *node);
+void IR_lower_branch(struct IRContext *context, Node *node, int trueBlock, int falseBlock);
+int IR_lower_constant(struct IRContext *context, Node *node);
+int IR_lower_string(struct IRContext *context, Node *node);
+int IR_is_char_literal(Node *node);
+int IR_lower_binary(struct IRContext *context, Node *node, enum IROpcode opcode);
+int IR_lower_comparison(struct IRContext *context, Node *node, enum IROpcode opcode);
+int IR_emit_comparison(struct IRContext *context, enum IROpcode opcode, int left, int right, Node *node);
+int IR_get_enumerator(struct IRContext *context, Node *node, long long *value);
+int IR_lower_not(struct IRContext *context, Node *node);
+int IR_lower_logical(struct IRContext *context, Node *node, int isAnd);
+int IR_lower_function_call(struct IRContext *context, Node *node, int asStatement);
+int IR_lower_arguments(struct IRContext *context, Node *node, int receiver, struct IRFunction *callee, SemanticEntry *method);
+int IR_emit_call(struct IRContext *context, struct IRFunction *callee, int index, int first, int count, Node *node);
+int IR_lower_method_call(struct IRContext *context, int object, Node *node, int asStatement);
+int IR_find_method_slot(struct ClassLayout *layout, char *name, size_t argumentCount);
+int IR_lower_new(struct IRContext *context, Node *node);
+int IR_find_initializer(struct IRContext *context, int classIndex);
+int IR_find_constructor(struct IRContext *context, int classIndex, size_t argumentCount);
+void IR_lower_super_call(struct IRContext *context, Node *node);
+int IR_lower_new_array(struct IRContext *context, Node *node);
+int IR_emit_new_array(struct IRContext *context, int *lengths, int count, struct IRReference reference, Node *node);
+int IR_lower_array_init(struct IRContext *context, Node *node, struct IRReference reference);
+int IR_lower_member_access(struct IRContext *context, Node *node, int asStatement);
+int IR_resolve_location(struct IRContext *context, Node *node, struct IRLocation *location);
+int IR_resolve_variable(struct IRContext *context, Node *node, struct IRLocation *location);
+int IR_resolve_elements(struct IRContext *context, Node *access, struct IRLocation *location, Node *node);
+int IR_resolve_member(struct IRContext *context, Node *node, struct IRLocation *location, int asStatement);
+int IR_load_location(struct IRContext *context, struct IRLocation *location, Node *node);
+void IR_store_location(struct IRContext *context, struct IRLocation *location, int value, Node *node);
+int IR_find_field(struct IRContext *context, int classIndex, char *name);
+int IR_emit_binary(struct IRContext *context, enum IROpcode opcode, int left, int right, Node *node);
+int IR_emit_integer(struct IRContext *context, enum VarType type, long long value, size_t line);
+int IR_emit_default_value(struct IRContext *context, enum VarType type, size_t line);
+int IR_convert(struct IRContext *context, int reg, enum VarType type, Node *node);
+int IR_find_local(struct IRContext *context, char *name);
+void IR_push_local(struct IRContext *context, char *name, int reg);
+int IR_is_global_scope(struct IRContext *context);
+enum VarType IR_get_declared_type(struct IRContext *context, Node *typeNode, int allowVoid, struct IRReference *reference);
+enum VarType IR_get_dec_type(struct IRContext *context, Node *node, struct VarDec dec, int allowVoid, struct IRReference *reference);
+enum VarType IR_get_variable_type(struct IRContext *context, Node *node, struct IRReference *reference);
+enum VarType IR_get_element_type(struct IRReference array, struct IRReference *element);
+int IR_add_typed_register(struct IRFunction *function, enum VarType type, char *name, struct IRReference reference);
+struct IRReference IR_reference_of(struct IRContext *context, int reg);
+enum VarType IR_get_common_type(enum VarType first, enum VarType second);
+int IR_get_type_rank(enum VarType type);
+enum VarType IR_type_of(struct IRContext *context, int reg);
+int IR_is_simple_identifier(Node *node);
+void IR_start_dead_block(struct IRContext *context);
+void IR_report_unsupported(struct IRContext *context, Node *node, const char *construct);
+void IR_report_unresolved(struct IRContext *context, Node *node);
+void IR_report_type_problem(struct IRContext *context, Node *node, const char *problem);
+const char *IR_get_construct_name(enum NodeType type);
+void *IR_reserve(void *array, size_t *capacity, size_t count, size_t size);
+void FREE_IR_CONTEXT(struct IRContext *context);
+
+/**
+ * <p>
+ * This is the entrypoint of the IR generation.
+ * </p>
+ * 
+ * <p>
+ * The parsetree has to be checked by the semantic analysis before,
+ * only the main table of the analysis is used to resolve the declared
+ * types. Constructs, that can't be lowered yet (e.g. classes of included files) are
+ * reported as DIAG_IR_UNSUPPORTED. After the lowering the module is
+ * verified and dumped ({@code --dump-ir}).
+ * </p>
+ * 
+ * @returns The PhaseStatus of the generation
+ * 
+ * @param *root     Root node of the checked parsetree
+ * @param *table    Main table of the semantic analysis
+ * @param **module  Receives the module (NULL if the lowering failed)
+ */
+int GenerateIR(Node *root, SemanticTable *table, struct IRModule **module) {
+	*module = NULL;
+
+	if (root == NULL) {
+		return PHASE_ABORTED;
+	}
+
+	struct IRContext *context = (struct IRContext*)calloc(1, sizeof(struct IRContext));
+	jmp_buf recoveryPoint;
+
+	if (context == NULL) {
+		(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "An error occured while trying to allocate memory.");
+		return PHASE_ABORTED;
+	}
+
+	if (setjmp(recoveryPoint) != 0) {
+		(void)FREE_IR_CONTEXT(context);
+		return PHASE_ABORTED;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	context->table = table;
+	context->module = CreateNewIRModule();
+	context->symbols = CreateNewHashMap(64);
+
+	(void)IR_collect_declarations(context, root);
+	(void)IR_lower_main(context, root);
+
+	for (size_t i = 0; i < context->module->functionCount; i++) {
+		(void)IR_lower_function(context, (int)i);
+	}
+
+	(void)_init_error_recovery_point_(NULL);
+
+	if (context->errors > 0) {
+		(void)FREE_IR_CONTEXT(context);
+		return PHASE_ERRORS;
+	}
+
+	*module = context->module;
+	context->module = NULL;
+	(void)FREE_IR_CONTEXT(context);
+	(void)ST_count(COUNTER_IR_INSTRUCTIONS, IR_count_instructions(*module));
+
+	if (IR_DUMP != NULL) {
+		(void)fprintf(IR_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    IR (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+		(void)IR_dump_module(IR_DUMP, *module);
+	}
+
+	return (int)IR_verify_module(*module) == 0 ? PHASE_SUCCESS : PHASE_ERRORS;
+}
+
+/**
+ * <p>
+ * Adds the function "<main>", the globals, the functions, the enums and
+ * the classes of the top level scope, so they can be used before their
+ * declaration.
+ * </p>
+ * 
+ * <p>
+ * Globals without a declared type get their type, when "<main>"
+ * lowers their declaration. The classes are added first, since the
+ * types of the globals and parameters refer to them, their fields and
+ * vtables are taken from the layouts of the semantic analysis, once
+ * all methods were added.
+ * </p>
+ * 
+ * @param *context  Context of the lowering
+ * @param *root     Root node of the parsetree
+ */
+void IR_collect_declarations(struct IRContext *context, Node *root) {
+	struct IRModule *module = context->module;
+	context->functions = (struct IRFunctionInfo*)IR_reserve(context->functions, &context->functionCapacity, 0, sizeof(struct IRFunctionInfo));
+	(void)CreateNewIRFunction(module, IR_MAIN_FUNCTION_NAME, VOID, 0);
+	module->entryFunction = 0;
+	context->functions[0].node = root;
+	context->functions[0].state = IR_LOWERING;
+	context->functions[0].kind = IR_PLAIN_FUNCTION;
+	context->functions[0].classIndex = -1;
+	context->classIndex = -1;
+
+	for (size_t i = 0; i < root->detailsCount; i++) {
+		Node *node = root->details[i];
+
+		if (node == NULL) {
+			continue;
+		}
+
+		switch (node->type) {
+		case _CLASS_NODE_:
+		case _INTERFACE_STMT_NODE_:
+			(void)IR_collect_class(context, node);
+			break;
+		case _ENUM_NODE_:
+			context->enums = (Node**)IR_reserve(context->enums, &context->enumCapacity, context->enumCount, sizeof(Node*));
+			context->enums[context->enumCount] = node;
+			(void)IR_add_symbol(context, node->value, IR_SYMBOL_ENUM, (int)context->enumCount++);
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < root->detailsCount; i++) {
+		Node *node = root->details[i];
+
+		if (node == NULL) {
+			continue;
+		} else if ((int)IR_is_variable_declaration(node) == true) {
+			(void)IR_collect_global(context, node);
+		} else if (node->type == _FUNCTION_NODE_) {
+			(void)IR_collect_function(context, node, -1);
+		}
+	}
+
+	for (size_t i = 0; i < context->classCount; i++) {
+		(void)IR_collect_class_members(context, (int)i);
+	}
+
+	for (size_t i = 0; i < context->classCount; i++) {
+		(void)IR_collect_class_layout(context, (int)i);
+	}
+}
+
+/*
+Purpose: Add a global of the top level scope (variables, arrays and class instances)
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the declaration
+*/
+void IR_collect_global(struct IRContext *context, Node *node) {
+	struct IRReference reference = IR_NO_REFERENCE;
+	enum VarType type = IR_get_variable_type(context, node, &reference);
+	int constant = node->type == _CONST_NODE_ || node->type == _ARRAY_CONST_NODE_ || node->type == _CONST_CLASS_INSTANCE_NODE_ ? true : false;
+	int index = (int)IR_add_global(context->module, node->value, type, constant);
+
+	context->module->globals[index].reference = reference;
+	(void)IR_add_symbol(context, node->value, IR_SYMBOL_GLOBAL, index);
+}
+
+/**
+ * <p>
+ * Adds a function with its parameters to the module, the body is
+ * lowered later.
+ * </p>
+ * 
+ * <p>
+ * Methods and constructors get the object as the first parameter
+ * ("this"), only the functions of the top level scope get a symbol.
+ * A constructor has its parameters in the details and its body in the
+ * right node.
+ * </p>
+ * 
+ * @returns The index of the function in the module
+ * 
+ * @param *context      Context of the lowering
+ * @param *functionNode Node of the function or constructor declaration
+ * @param classIndex    Class of a method or constructor, -1 for the functions of the top level scope
+ */
+int IR_collect_function(struct IRContext *context, Node *functionNode, int classIndex) {
+	//details: [return type or NULL] [params...] [runnable], constructors: [params...]
+	int isConstructor = functionNode->type == _CLASS_CONSTRUCTOR_NODE_ ? true : false;
+	Node *typeNode = isConstructor == false && functionNode->detailsCount > 0 ? functionNode->details[0] : NULL;
+	struct IRReference returnReference = IR_NO_REFERENCE;
+	enum VarType returnType = isConstructor == true ? VOID : (typeNode == NULL ? null : IR_get_declared_type(context, typeNode, true, &returnReference));
+	char *name = functionNode->value;
+
+	if (classIndex >= 0) {
+		char *className = context->module->classes[classIndex].name;
+		char *memberName = isConstructor == true ? "constructor" : functionNode->value;
+		name = (char*)calloc(strlen(className) + strlen(memberName) + 2, sizeof(char));
+
+		if (name == NULL) {
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			return -1;
+		}
+
+		(void)sprintf(name, "%s.%s", className, memberName);
+	}
+
+	struct IRFunction *function = CreateNewIRFunction(context->module, name, returnType, functionNode->line);
+	int index = (int)context->module->functionCount - 1;
+
+	if (classIndex >= 0) {
+		(void)free(name);
+	}
+
+	context->functions = (struct IRFunctionInfo*)IR_reserve(context->functions, &context->functionCapacity, (size_t)index, sizeof(struct IRFunctionInfo));
+	context->functions[index].node = functionNode;
+	context->functions[index].state = IR_NOT_LOWERED;
+	context->functions[index].kind = classIndex < 0 ? IR_PLAIN_FUNCTION : (isConstructor == true ? IR_CONSTRUCTOR : IR_METHOD);
+	context->functions[index].classIndex = classIndex;
+	function->returnReference = returnReference;
+
+	if (typeNode != NULL && returnType == null) {
+		//The problem was reported, the function is still added, so its calls are resolved
+		function->returnType = VOID;
+	}
+
+	if (classIndex >= 0) {
+		(void)IR_add_typed_register(function, CLASS_REF, "this", (struct IRReference){CLASS_REF, classIndex, 0});
+		function->paramCount++;
+	}
+
+	size_t firstParam = isConstructor == true ? 0 : 1;
+	size_t paramEnd = isConstructor == true ? functionNode->detailsCount : (functionNode->detailsCount > 0 ? functionNode->detailsCount - 1 : 0);
+
+	for (size_t i = firstParam; i < paramEnd; i++) {
+		Node *param = functionNode->details[i];
+		Node *paramType = param != NULL && param->detailsCount > 0 ? param->details[0] : NULL;
+		struct IRReference reference = IR_NO_REFERENCE;
+
+		if (param == NULL) {
+			continue;
+		} else if (paramType == NULL) {
+			(void)IR_report_unsupported(context, param, "Parameters without a type");
+		}
+
+		enum VarType type = paramType == NULL ? null : IR_get_declared_type(context, paramType, false, &reference);
+		(void)IR_add_typed_register(function, type, param->value, reference);
+		function->paramCount++;
+	}
+
+	if (classIndex < 0) {
+		(void)IR_add_symbol(context, functionNode->value, IR_SYMBOL_FUNCTION, index);
+	}
+
+	return index;
+}
+
+/*
+Purpose: Add a class or interface of the top level scope to the module (the members are added later)
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the class or interface declaration
+*/
+void IR_collect_class(struct IRContext *context, Node *node) {
+	int isInterface = node->type == _INTERFACE_STMT_NODE_ ? true : false;
+	int index = (int)IR_add_class(context->module, node->value, isInterface);
+
+	context->classes = (struct IRClassInfo*)IR_reserve(context->classes, &context->classCapacity, (size_t)index, sizeof(struct IRClassInfo));
+	context->classes[index].node = node;
+	context->classes[index].table = SA_get_layout_table(context->table, node->value, isInterface == true ? INTERFACE : CLASS);
+	context->classes[index].initializer = -1;
+	context->classes[index].constructors = NULL;
+	context->classes[index].constructorCount = 0;
+	context->classCount = (size_t)index + 1;
+	(void)IR_add_symbol(context, node->value, IR_SYMBOL_CLASS, index);
+}
+
+/**
+ * <p>
+ * Adds the methods and constructors of a class as functions.
+ * </p>
+ * 
+ * <p>
+ * If a field has an initial value (or an array field has lengths),
+ * the class gets the function "Class.<init>", that initializes the
+ * fields of a new object before its constructor runs.
+ * </p>
+ * 
+ * @param *context      Context of the lowering
+ * @param classIndex    Index of the class
+ */
+void IR_collect_class_members(struct IRContext *context, int classIndex) {
+	struct IRClassInfo *info = &context->classes[classIndex];
+	Node *runnable = info->node->rightNode;
+	int needsInitializer = false;
+
+	if (context->module->classes[classIndex].isInterface == true) {
+		return;
+	} else if (info->table == NULL || info->table->layout == NULL) {
+		(void)IR_report_unsupported(context, info->node, "Classes with a parent or an interface of another file");
+		return;
+	}
+
+	for (size_t i = 0; runnable != NULL && i < runnable->detailsCount; i++) {
+		Node *member = runnable->details[i];
+
+		if (member == NULL) {
+			continue;
+		} else if (member->type == _FUNCTION_NODE_) {
+			(void)IR_collect_function(context, member, classIndex);
+		} else if (member->type == _CLASS_CONSTRUCTOR_NODE_) {
+			int index = IR_collect_function(context, member, classIndex);
+			info->constructors = (int*)realloc(info->constructors, (info->constructorCount + 1) * sizeof(int));
+
+			if (info->constructors == NULL) {
+				(void)IO_BUFFER_RESERVATION_EXCEPTION();
+				return;
+			}
+
+			info->constructors[info->constructorCount++] = index;
+		} else if ((int)IR_is_variable_declaration(member) == true && (member->rightNode != NULL || (int)IR_count_array_lengths(member) > 0)) {
+			needsInitializer = true;
+		}
+	}
+
+	if (needsInitializer == false) {
+		return;
+	}
+
+	char *className = context->module->classes[classIndex].name;
+	char *name = (char*)calloc(strlen(className) + strlen(".<init>") + 1, sizeof(char));
+
+	if (name == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	(void)sprintf(name, "%s.<init>", className);
+	struct IRFunction *function = CreateNewIRFunction(context->module, name, VOID, info->node->line);
+	int index = (int)context->module->functionCount - 1;
+	(void)free(name);
+
+	context->functions = (struct IRFunctionInfo*)IR_reserve(context->functions, &context->functionCapacity, (size_t)index, sizeof(struct IRFunctionInfo));
+	context->functions[index].node = info->node;
+	context->functions[index].state = IR_NOT_LOWERED;
+	context->functions[index].kind = IR_INITIALIZER;
+	context->functions[index].classIndex = classIndex;
+	(void)IR_add_typed_register(function, CLASS_REF, "this", (struct IRReference){CLASS_REF, classIndex, 0});
+	function->paramCount = 1;
+	info->initializer = index;
+}
+
+/**
+ * <p>
+ * Fills the parent, the interfaces, the fields and the vtable of a
+ * class from its layout (see ClassLayout).
+ * </p>
+ * 
+ * <p>
+ * The fields are in the order of their offsets, the inherited fields
+ * keep their owner and every field keeps its offset in the layout. An interface only gets the number of its methods
+ * and the first of its interface slots.
+ * </p>
+ * 
+ * @param *context      Context of the lowering
+ * @param classIndex    Index of the class
+ */
+void IR_collect_class_layout(struct IRContext *context, int classIndex) {
+	struct IRClassInfo *info = &context->classes[classIndex];
+	struct IRClass *irClass = &context->module->classes[classIndex];
+	struct ClassLayout *layout = info->table == NULL ? NULL : info->table->layout;
+
+	if (layout == NULL) {
+		return;
+	}
+
+	irClass->methods = (int*)malloc((layout->methodCount + 1) * sizeof(int));
+	irClass->methodCount = layout->methodCount;
+
+	if (irClass->methods == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	if (irClass->isInterface == true) {
+		for (size_t i = 0; i < layout->methodCount; i++) {
+			irClass->methods[i] = -1;
+		}
+
+		irClass->interfaceBase = layout->interfaceBase;
+		return;
+	}
+
+	irClass->parent = layout->parent == NULL ? -1 : IR_get_class_index(context, layout->parent->name);
+	irClass->size = layout->size;
+	irClass->interfaces = (int*)malloc((layout->interfaceCount + 1) * sizeof(int));
+	irClass->interfaceSlots = (int*)malloc((layout->interfaceSlotCount + 1) * sizeof(int));
+
+	if (irClass->interfaces == NULL || irClass->interfaceSlots == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < layout->interfaceCount; i++) {
+		irClass->interfaces[irClass->interfaceCount++] = IR_get_class_index(context, layout->interfaces[i]->name);
+	}
+
+	for (size_t i = 0; i < layout->interfaceSlotCount; i++) {
+		irClass->interfaceSlots[irClass->interfaceSlotCount++] = layout->interfaceSlots[i];
+	}
+
+	for (size_t i = 0; i < layout->methodCount; i++) {
+		irClass->methods[i] = IR_find_method_function(context, &layout->methods[i]);
+	}
+
+	for (size_t i = 0; i < layout->fieldCount; i++) {
+		SemanticEntry *entry = layout->fields[i].entry;
+		int owner = IR_get_class_index(context, layout->fields[i].owner->name);
+		Node *declaration = owner < 0 ? NULL : IR_find_member_declaration(context->classes[owner].node, entry->name);
+		struct IRReference reference = IR_NO_REFERENCE;
+		enum VarType type = declaration == NULL ? null : IR_get_variable_type(context, declaration, &reference);
+
+		if (declaration != NULL && type == null && declaration->detailsCount == 0) {
+			(void)IR_report_unsupported(context, declaration, "Fields without a type");
+		}
+
+		(void)IR_add_field(context->module, classIndex, entry->name, type, reference, owner, layout->fields[i].offset, layout->fields[i].size);
+	}
+}
+
+/*
+Purpose: Find the function of a method in the vtable of a layout (by its class, name and position)
+Return Type: int => Index of the function or -1 if it wasn't added
+Params: struct IRContext *context => Context of the lowering;
+		struct LayoutMethod *method => The method of the layout
+*/
+int IR_find_method_function(struct IRContext *context, struct LayoutMethod *method) {
+	int owner = IR_get_class_index(context, method->owner->name);
+
+	for (size_t i = 0; owner >= 0 && i < context->module->functionCount; i++) {
+		struct IRFunctionInfo *info = &context->functions[i];
+
+		if (info->classIndex == owner && info->kind == IR_METHOD && info->node->line == method->entry->line
+			&& info->node->position == method->entry->position && strcmp(info->node->value, method->entry->name) == 0) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+Purpose: Find the declaration of a field in the body of its class
+Return Type: Node * => Node of the declaration or NULL
+Params: Node *classNode => Node of the class;
+		char *name => Name of the field
+*/
+Node *IR_find_member_declaration(Node *classNode, char *name) {
+	Node *runnable = classNode->rightNode;
+
+	for (size_t i = 0; runnable != NULL && i < runnable->detailsCount; i++) {
+		Node *member = runnable->details[i];
+
+		if (member != NULL && (int)IR_is_variable_declaration(member) == true && strcmp(member->value, name) == 0) {
+			return member;
+		}
+	}
+
+	return NULL;
+}
+
+int IR_get_class_index(struct IRContext *context, char *name) {
+	struct IRSymbol *symbol = name == NULL ? NULL : IR_get_symbol(context, name);
+	return symbol == NULL || symbol->kind != IR_SYMBOL_CLASS ? -1 : symbol->index;
+}
+
+void IR_add_symbol(struct IRContext *context, char *name, enum IRSymbolKind kind, int index) {
+	struct IRSymbol *symbol = (struct IRSymbol*)malloc(sizeof(struct IRSymbol));
+
+	if (symbol == NULL || name == NULL) {
+		(void)free(symbol);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	symbol->kind = kind;
+	symbol->index = index;
+	(void)HM_add_entry(name, symbol, context->symbols);
+}
+
+struct IRSymbol *IR_get_symbol(struct IRContext *context, char *name) {
+	struct HashMapEntry *entry = HM_get_entry(name, context->symbols);
+	return entry == NULL ? NULL : (struct IRSymbol*)entry->value;
+}
+
+/**
+ * <p>
+ * Lowers the statements of the top level scope into "<main>".
+ * </p>
+ * 
+ * @param *context  Context of the lowering
+ * @param *root     Root node of the parsetree
+ */
+void IR_lower_main(struct IRContext *context, Node *root) {
+	context->function = context->module->functions[context->module->entryFunction];
+	context->inferReturnType = false;
+	context->scopeDepth = 0;
+	context->localBase = 0;
+	context->loopBase = 0;
+	context->finallyBase = 0;
+
+	(void)IR_lower_statements(context, root);
+	(void)IR_finish_lowering(context, root->line);
+	context->functions[context->module->entryFunction].state = IR_LOWERED;
+	context->function = NULL;
+}
+
+/**
+ * <p>
+ * Lowers the body of a function, if it wasn't lowered yet.
+ * </p>
+ * 
+ * <p>
+ * The state of the caller (current function, locals, loops and finally
+ * runnables) is saved, so this can be called while another function is
+ * lowered.
+ * </p>
+ * 
+ * @param *context  Context of the lowering
+ * @param index     Index of the function in the module
+ */
+void IR_lower_function(struct IRContext *context, int index) {
+	struct IRFunctionInfo *info = &context->functions[index];
+
+	if (info->state != IR_NOT_LOWERED) {
+		return;
+	}
+
+	struct IRFunction *caller = context->function;
+	int callerClassIndex = context->classIndex;
+	int callerInfersReturnType = context->inferReturnType;
+	int callerScopeDepth = context->scopeDepth;
+	size_t callerLocalBase = context->localBase;
+	size_t callerLocalCount = context->localCount;
+	size_t callerLoopBase = context->loopBase;
+	size_t callerLoopCount = context->loopCount;
+	size_t callerFinallyBase = context->finallyBase;
+	size_t callerFinallyCount = context->finallyCount;
+	Node *functionNode = info->node;
+
+	info->state = IR_LOWERING;
+	context->function = context->module->functions[index];
+	context->classIndex = info->classIndex;
+	context->inferReturnType = context->function->returnType == null ? true : false;
+	context->scopeDepth = 1;
+	context->localBase = context->localCount;
+	context->loopBase = context->loopCount;
+	context->finallyBase = context->finallyCount;
+
+	for (int i = 0; i < context->function->paramCount; i++) {
+		(void)IR_push_local(context, context->function->registers[i].name, i);
+	}
+
+	if (info->kind == IR_INITIALIZER) {
+		(void)IR_lower_initializers(context, functionNode);
+	} else if (info->kind == IR_CONSTRUCTOR) {
+		(void)IR_lower_scope(context, functionNode->rightNode);
+	} else if (functionNode->detailsCount > 0) {
+		(void)IR_lower_scope(context, functionNode->details[functionNode->detailsCount - 1]);
+	}
+
+	//A function without any return value returns nothing
+	if (context->function->returnType == null) {
+		context->function->returnType = VOID;
+	}
+
+	(void)IR_finish_lowering(context, functionNode->line);
+	info->state = IR_LOWERED;
+
+	context->function = caller;
+	context->classIndex = callerClassIndex;
+	context->inferReturnType = callerInfersReturnType;
+	context->scopeDepth = callerScopeDepth;
+	context->localBase = callerLocalBase;
+	context->localCount = callerLocalCount;
+	context->loopBase = callerLoopBase;
+	context->loopCount = callerLoopCount;
+	context->finallyBase = callerFinallyBase;
+	context->finallyCount = callerFinallyCount;
+}
+
+/*
+Purpose: Terminate the last block of the current function and finish the function
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		size_t line => Line of the function declaration
+*/
+void IR_finish_lowering(struct IRContext *context, size_t line) {
+	struct IRFunction *function = context->function;
+
+	//Reaching the end of a function with a return type returns the default value
+	if ((int)IR_is_block_terminated(function) == false) {
+		int value = function->returnType == VOID ? IR_NO_REGISTER : IR_emit_default_value(context, function->returnType, line);
+		(void)IR_emit(function, IR_RETURN, function->returnType, IR_NO_REGISTER, value, IR_NO_REGISTER, IR_NO_REGISTER, line);
+	}
+
+	(void)IR_finish_function(function);
+}
+
+void IR_lower_statements(struct IRContext *context, Node *runnable) {
+	if (runnable == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < runnable->detailsCount; i++) {
+		i += (size_t)IR_lower_statement(context, runnable->details, i, runnable->detailsCount);
+	}
+}
+
+/*
+Purpose: Lower a runnable in its own scope (the declared locals are removed afterwards)
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *runnable => Runnable to lower
+*/
+void IR_lower_scope(struct IRContext *context, Node *runnable) {
+	size_t localCount = context->localCount;
+	context->scopeDepth++;
+	(void)IR_lower_statements(context, runnable);
+	context->scopeDepth--;
+	context->localCount = localCount;
+}
+
+/**
+ * <p>
+ * Lowers a single statement.
+ * </p>
+ * 
+ * @returns The number of following statements, that were lowered as well (else-if, else, catch and finally)
+ * 
+ * @param *context      Context of the lowering
+ * @param **statements  Statements of the runnable
+ * @param index         Index of the statement
+ * @param count         Number of statements in the runnable
+ */
+size_t IR_lower_statement(struct IRContext *context, Node **statements, size_t index, size_t count) {
+	Node *node = statements[index];
+
+	//Dead code is dropped by the semantic analysis
+	if (node == NULL || node->type == _NULL_) {
+		return 0;
+	}
+
+	switch (node->type) {
+	case _VAR_NODE_:
+	case _CONST_NODE_:
+	case _ARRAY_VAR_NODE_:
+	case _ARRAY_CONST_NODE_:
+	case _VAR_CLASS_INSTANCE_NODE_:
+	case _CONST_CLASS_INSTANCE_NODE_:
+		(void)IR_lower_variable(context, node);
+		break;
+	case _FUNCTION_CALL_NODE_:
+		(void)IR_lower_function_call(context, node, true);
+		break;
+	case _MEM_CLASS_ACC_NODE_:
+		(void)IR_lower_member_access(context, node, true);
+		break;
+	case _SUPER_STMT_NODE_:
+		(void)IR_lower_super_call(context, node);
+		break;
+	case _EQUALS_NODE_:
+		(void)IR_lower_assignment(context, node, IR_NOP);
+		break;
+	case _PLUS_EQUALS_NODE_:
+		(void)IR_lower_assignment(context, node, IR_ADD);
+		break;
+	case _MINUS_EQUALS_NODE_:
+		(void)IR_lower_assignment(context, node, IR_SUB);
+		break;
+	case _MULTIPLY_EQUALS_NODE_:
+		(void)IR_lower_assignment(context, node, IR_MUL);
+		break;
+	case _DIVIDE_EQUALS_NODE_:
+		(void)IR_lower_assignment(context, node, IR_DIV);
+		break;
+	case _SIMPLE_INC_DEC_ASS_NODE_:
+		(void)IR_lower_inc_dec_assignment(context, node);
+		break;
+	case _IF_STMT_NODE_:
+		return IR_lower_if_chain(context, statements, index, count);
+	case _TRY_NODE_:
+		return IR_lower_try(context, statements, index, count);
+	case _CHECK_STMT_NODE_:
+		(void)IR_lower_check(context, node);
+		break;
+	case _WHILE_STMT_NODE_:
+		(void)IR_lower_while(context, node);
+		break;
+	case _DO_STMT_NODE_:
+		(void)IR_lower_do(context, node);
+		break;
+	case _FOR_STMT_NODE_:
+		(void)IR_lower_for(context, node);
+		break;
+	case _RETURN_STMT_NODE_:
+		(void)IR_lower_return(context, node);
+		break;
+	case _BREAK_STMT_NODE_:
+	case _CONTINUE_STMT_NODE_:
+		(void)IR_lower_loop_exit(context, node);
+		break;
+	case _RUNNABLE_NODE_:
+		(void)IR_lower_scope(context, node);
+		break;
+	case _FUNCTION_NODE_:
+		//Functions of the top level scope are lowered on their own
+		if ((int)IR_is_global_scope(context) == false) {
+			(void)IR_report_unsupported(context, node, "Nested functions");
+		}
+
+		break;
+	case _CLASS_NODE_:
+	case _INTERFACE_STMT_NODE_:
+		//Classes of the top level scope are lowered with their methods
+		if ((int)IR_is_global_scope(context) == false) {
+			(void)IR_report_unsupported(context, node, "Nested classes");
+		}
+
+		break;
+	case _INCLUDE_NODE_:
+	case _ENUM_NODE_:
+		//Declarations without runtime code, the enumerators are constants
+		break;
+	default:
+		(void)IR_report_unsupported(context, node, IR_get_construct_name(node->type));
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * <p>
+ * Lowers a variable declaration (also arrays and class instances).
+ * </p>
+ * 
+ * <p>
+ * Variables of the top level scope are stored into their global, all
+ * other variables get a new register. A variable without a value is
+ * initialized with the default value of its type.
+ * </p>
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the declaration
+ */
+void IR_lower_variable(struct IRContext *context, Node *node) {
+	int errors = context->errors;
+	struct IRReference reference = IR_NO_REFERENCE;
+	enum VarType type = IR_get_variable_type(context, node, &reference);
+
+	if (type == null && context->errors > errors) {
+		return;
+	}
+
+	int value = IR_lower_initial_value(context, node, &type, &reference);
+
+	if (value == IR_NO_REGISTER) {
+		return;
+	}
+
+	if ((int)IR_is_global_scope(context) == true) {
+		struct IRSymbol *symbol = IR_get_symbol(context, node->value);
+
+		if (symbol == NULL || symbol->kind != IR_SYMBOL_GLOBAL) {
+			(void)IR_report_unresolved(context, node);
+			return;
+		}
+
+		context->module->globals[symbol->index].type = type;
+		context->module->globals[symbol->index].reference = reference;
+		(void)IR_emit(context->function, IR_STORE_GLOBAL, type, IR_NO_REGISTER, symbol->index, value, IR_NO_REGISTER, node->line);
+		return;
+	}
+
+	int reg = IR_add_typed_register(context->function, type, node->value, reference);
+	(void)IR_emit(context->function, IR_MOVE, type, reg, value, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	(void)IR_push_local(context, node->value, reg);
+}
+
+/**
+ * <p>
+ * Lowers the initial value of a variable or field, converted to its
+ * type.
+ * </p>
+ * 
+ * <p>
+ * An initializer list ({@code {1, 2}}) creates the array with its
+ * elements, an array with lengths ({@code arr[3]}) and without a value
+ * gets a new array with default elements. A variable without a type
+ * gets the type (and reference) of its value.
+ * </p>
+ * 
+ * @returns The register with the value or IR_NO_REGISTER
+ * 
+ * @param *context      Context of the lowering
+ * @param *node         Node of the declaration
+ * @param *type         Type of the variable (null, if it has none), receives the type of the value
+ * @param *reference    Object or array of the variable, receives the reference of the value
+ */
+int IR_lower_initial_value(struct IRContext *context, Node *node, enum VarType *type, struct IRReference *reference) {
+	Node *valueNode = node->rightNode;
+	int value = IR_NO_REGISTER;
+
+	if (valueNode != NULL && valueNode->type == _ARRAY_ASSIGNMENT_NODE_) {
+		value = IR_lower_array_init(context, valueNode, *reference);
+	} else if (valueNode != NULL) {
+		value = IR_lower_value(context, valueNode, *type);
+	} else if (*type == null) {
+		(void)IR_report_unsupported(context, node, "Variables without a type and value");
+		return IR_NO_REGISTER;
+	} else if ((int)IR_count_array_lengths(node) > 0) {
+		int count = IR_count_array_lengths(node);
+		int *lengths = (int*)calloc((size_t)count, sizeof(int));
+
+		if (lengths == NULL) {
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			return IR_NO_REGISTER;
+		}
+
+		for (size_t i = 1, n = 0; i < node->detailsCount; i++) {
+			if (node->details[i] != NULL && node->details[i]->type == _ARRAY_DIM_NODE_) {
+				lengths[n++] = IR_emit_integer(context, INTEGER, strtoll(node->details[i]->value, NULL, 10), node->line);
+			}
+		}
+
+		value = IR_emit_new_array(context, lengths, count, *reference, node);
+		(void)free(lengths);
+		return value;
+	} else {
+		return IR_emit_default_value(context, *type, node->line);
+	}
+
+	if (value == IR_NO_REGISTER) {
+		return IR_NO_REGISTER;
+	} else if (*type == null) {
+		*type = IR_type_of(context, value);
+		*reference = IR_reference_of(context, value);
+	}
+
+	return IR_convert(context, value, *type, node);
+}
+
+/**
+ * <p>
+ * Lowers the initial values of the fields of a class into its
+ * initializer ("Class.<init>").
+ * </p>
+ * 
+ * <p>
+ * The initializer of the parent runs first, so every field of the
+ * object is initialized before the first constructor runs.
+ * </p>
+ * 
+ * @param *context      Context of the lowering
+ * @param *classNode    Node of the class
+ */
+void IR_lower_initializers(struct IRContext *context, Node *classNode) {
+	struct IRClass *irClass = &context->module->classes[context->classIndex];
+	int parentInitializer = irClass->parent < 0 ? -1 : IR_find_initializer(context, irClass->parent);
+	Node *runnable = classNode->rightNode;
+
+	if (parentInitializer >= 0) {
+		int object = 0;
+		int first = IR_add_arguments(context->function, &object, 1);
+		(void)IR_emit_call(context, context->module->functions[parentInitializer], parentInitializer, first, 1, classNode);
+	}
+
+	for (size_t i = 0; runnable != NULL && i < runnable->detailsCount; i++) {
+		Node *member = runnable->details[i];
+
+		if (member == NULL || (int)IR_is_variable_declaration(member) == false
+			|| (member->rightNode == NULL && (int)IR_count_array_lengths(member) == 0)) {
+			continue;
+		}
+
+		int field = IR_find_field(context, context->classIndex, member->value);
+
+		if (field < 0 || irClass->fields[field].type == null) {
+			continue;
+		}
+
+		enum VarType type = irClass->fields[field].type;
+		struct IRReference reference = irClass->fields[field].reference;
+		int value = IR_lower_initial_value(context, member, &type, &reference);
+
+		if (value != IR_NO_REGISTER) {
+			struct IRInstruction *instruction = IR_emit(context->function, IR_STORE_FIELD, type, IR_NO_REGISTER, 0, field, value, member->line);
+			instruction->value.integer = context->classIndex;
+		}
+	}
+}
+
+int IR_is_variable_declaration(Node *node) {
+	switch (node->type) {
+	case _VAR_NODE_:
+	case _CONST_NODE_:
+	case _ARRAY_VAR_NODE_:
+	case _ARRAY_CONST_NODE_:
+	case _VAR_CLASS_INSTANCE_NODE_:
+	case _CONST_CLASS_INSTANCE_NODE_:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+Purpose: Count the lengths of an array declaration ('arr[2][3]')
+Return Type: int => Number of lengths, 0 if the array has no lengths or one of them is open ('arr[]')
+Params: Node *node => Node of the declaration
+*/
+int IR_count_array_lengths(Node *node) {
+	int count = 0;
+
+	for (size_t i = 1; i < node->detailsCount; i++) {
+		Node *dimension = node->details[i];
+
+		if (dimension == NULL || dimension->type != _ARRAY_DIM_NODE_) {
+			continue;
+		} else if (dimension->value == NULL || dimension->value[0] < '0' || dimension->value[0] > '9') {
+			return 0;
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+/*
+Purpose: Lower an assignment to a variable, field or array element ('=', '+=', '-=', '*=' and '/=')
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the assignment;
+		enum IROpcode opcode => Operation of the compound assignment (IR_NOP for '=')
+*/
+void IR_lower_assignment(struct IRContext *context, Node *node, enum IROpcode opcode) {
+	Node *target = node->leftNode;
+	struct IRLocation location;
+
+	if (target == NULL) {
+		(void)IR_report_unsupported(context, node, IR_get_construct_name(node->type));
+		return;
+	} else if ((int)IR_resolve_location(context, target, &location) == false) {
+		return;
+	}
+
+	int value = IR_lower_value(context, node->rightNode, location.type);
+
+	if (value == IR_NO_REGISTER) {
+		return;
+	}
+
+	if (opcode != IR_NOP) {
+		int current = IR_load_location(context, &location, target);
+
+		if (current == IR_NO_REGISTER) {
+			return;
+		}
+
+		value = IR_emit_binary(context, opcode, current, value, node);
+	}
+
+	(void)IR_store_location(context, &location, value, target);
+}
+
+/*
+Purpose: Lower increments and decrements of a variable, field or array element ('i++', '--i')
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the assignment (details[0] is the variable)
+*/
+void IR_lower_inc_dec_assignment(struct IRContext *context, Node *node) {
+	Node *target = node->detailsCount > 0 ? node->details[0] : NULL;
+	struct IRLocation location;
+
+	if (target == NULL) {
+		(void)IR_report_unsupported(context, node, IR_get_construct_name(node->type));
+		return;
+	} else if ((int)IR_resolve_location(context, target, &location) == false) {
+		return;
+	}
+
+	int current = IR_load_location(context, &location, target);
+	int steps = IR_count_inc_dec(node->leftNode) + IR_count_inc_dec(node->rightNode);
+
+	if (current == IR_NO_REGISTER || steps == 0) {
+		return;
+	}
+
+	enum VarType type = IR_type_of(context, current);
+	int step = IR_NO_REGISTER;
+
+	if (type == DOUBLE || type == FLOAT) {
+		step = IR_add_register(context->function, type, NULL);
+		struct IRInstruction *instruction = IR_emit(context->function, IR_CONST_FLOAT, type, step, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+		instruction->value.floating = steps < 0 ? -steps : steps;
+	} else {
+		step = IR_emit_integer(context, INTEGER, steps < 0 ? -steps : steps, node->line);
+	}
+
+	(void)IR_store_location(context, &location, IR_emit_binary(context, steps < 0 ? IR_SUB : IR_ADD, current, step, node), target);
+}
+
+int IR_count_inc_dec(Node *node) {
+	if (node == NULL) {
+		return 0;
+	}
+
+	int step = node->type == _INCREMENT_ONE_NODE_ ? 1 : (node->type == _DECREMENT_ONE_NODE_ ? -1 : 0);
+	return step + IR_count_inc_dec(node->leftNode) + IR_count_inc_dec(node->rightNode);
+}
+
+/**
+ * <p>
+ * Lowers an if statement together with the following else-if and
+ * else statements.
+ * </p>
+ * 
+ * <p>
+ * <strong>Layout:</strong>
+ * ```
+ *     br cond1, then1, next1
+ * then1:  ...     jump end
+ * next1:  br cond2, then2, else
+ * then2:  ...     jump end
+ * else:   ...     jump end
+ * end:
+ * ```
+ * </p>
+ * 
+ * @returns The number of else-if and else statements, that were lowered
+ * 
+ * @param *context      Context of the lowering
+ * @param **statements  Statements of the runnable
+ * @param index         Index of the if statement
+ * @param count         Number of statements in the runnable
+ */
+size_t IR_lower_if_chain(struct IRContext *context, Node **statements, size_t index, size_t count) {
+	struct IRFunction *function = context->function;
+	int endBlock = IR_add_block(function);
+	size_t consumed = 0;
+
+	for (size_t i = index; i < count && statements[i] != NULL; i++) {
+		Node *node = statements[i];
+
+		if (i > index && node->type != _ELSE_IF_STMT_NODE_ && node->type != _ELSE_STMT_NODE_) {
+			break;
+		}
+
+		consumed = i - index;
+
+		if (node->type == _ELSE_STMT_NODE_) {
+			(void)IR_lower_scope(context, node->rightNode);
+			(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, endBlock, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+			break;
+		}
+
+		int thenBlock = IR_add_block(function);
+		int nextBlock = IR_add_block(function);
+
+		(void)IR_lower_branch(context, node->leftNode, thenBlock, nextBlock);
+		(void)IR_start_block(function, thenBlock);
+		(void)IR_lower_scope(context, node->rightNode);
+
+		if ((int)IR_is_block_terminated(function) == false) {
+			(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, endBlock, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+		}
+
+		(void)IR_start_block(function, nextBlock);
+	}
+
+	(void)IR_start_block(function, endBlock);
+	return consumed;
+}
+
+/**
+ * <p>
+ * Lowers a try statement together with its catch and finally statement.
+ * </p>
+ * 
+ * <p>
+ * The blocks of the try runnable get the landing pad, which holds the
+ * catch runnable, so the normal path doesn't execute any additional
+ * instruction. The finally runnable is copied onto every path, that
+ * leaves the statement. A runtime error in the catch runnable enters a
+ * second landing pad, which runs the finally runnable and resumes the
+ * error. Every runtime error is caught, the variable of the catch
+ * statement can't be used yet.
+ * </p>
+ * 
+ * <p>
+ * <strong>Layout:</strong>
+ * ```
+ * try:     ...                 (landing pad: catch)
+ *          finally ...     jump end
+ * catch:   ...                 (landing pad: rethrow)
+ *          finally ...     jump end
+ * rethrow: finally ...     resume
+ * end:
+ * ```
+ * </p>
+ * 
+ * @returns The number of catch and finally statements, that were lowered
+ * 
+ * @param *context      Context of the lowering
+ * @param **statements  Statements of the runnable
+ * @param index         Index of the try statement
+ * @param count         Number of statements in the runnable
+ */
+size_t IR_lower_try(struct IRContext *context, Node **statements, size_t index, size_t count) {
+	struct IRFunction *function = context->function;
+	Node *tryNode = statements[index];
+	Node *catchNode = index + 1 < count ? statements[index + 1] : NULL;
+	Node *finallyNode = index + 2 < count ? statements[index + 2] : NULL;
+
+	if (catchNode == NULL || catchNode->type != _CATCH_NODE_) {
+		(void)IR_report_unsupported(context, tryNode, "Try statements without catch");
+		return 0;
+	}
+
+	Node *finallyRunnable = finallyNode != NULL && finallyNode->type == _FINALLY_STMT_NODE_ ? finallyNode->rightNode : NULL;
+	int outerHandler = function->handler;
+	int catchBlock = IR_add_block(function);
+	int rethrowBlock = finallyRunnable != NULL ? IR_add_block(function) : -1;
+	int endBlock = IR_add_block(function);
+
+	if (finallyRunnable != NULL) {
+		(void)IR_push_finally(context, finallyRunnable, outerHandler);
+	}
+
+	function->handler = catchBlock;
+	(void)IR_start_block(function, IR_add_block(function));
+	(void)IR_lower_scope(context, tryNode);
+	context->finallyCount -= finallyRunnable != NULL ? 1 : 0;
+
+	if (finallyRunnable != NULL && (int)IR_is_block_terminated(function) == false) {
+		(void)IR_lower_finally(context, finallyRunnable, outerHandler);
+	}
+
+	if ((int)IR_is_block_terminated(function) == false) {
+		(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, endBlock, IR_NO_REGISTER, IR_NO_REGISTER, tryNode->line);
+	}
+
+	if (finallyRunnable != NULL) {
+		(void)IR_push_finally(context, finallyRunnable, outerHandler);
+	}
+
+	function->handler = finallyRunnable != NULL ? rethrowBlock : outerHandler;
+	(void)IR_start_block(function, catchBlock);
+	(void)IR_lower_scope(context, catchNode->rightNode);
+	context->finallyCount -= finallyRunnable != NULL ? 1 : 0;
+
+	if (finallyRunnable != NULL && (int)IR_is_block_terminated(function) == false) {
+		(void)IR_lower_finally(context, finallyRunnable, outerHandler);
+	}
+
+	if ((int)IR_is_block_terminated(function) == false) {
+		(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, endBlock, IR_NO_REGISTER, IR_NO_REGISTER, catchNode->line);
+	}
+
+	function->handler = outerHandler;
+
+	if (finallyRunnable != NULL) {
+		(void)IR_start_block(function, rethrowBlock);
+		(void)IR_lower_scope(context, finallyRunnable);
+
+		if ((int)IR_is_block_terminated(function) == false) {
+			(void)IR_emit(function, IR_RESUME, VOID, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, finallyNode->line);
+		}
+	}
+
+	(void)IR_start_block(function, endBlock);
+	return finallyRunnable != NULL ? 2 : 1;
+}
+
+/*
+Purpose: Lower a copy of a finally runnable in a new block with the landing pad outside of its try statement
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *runnable => Finally runnable;
+		int handler => Landing pad outside of the try statement
+*/
+void IR_lower_finally(struct IRContext *context, Node *runnable, int handler) {
+	context->function->handler = handler;
+	(void)IR_start_block(context->function, IR_add_block(context->function));
+	(void)IR_lower_scope(context, runnable);
+}
+
+/**
+ * <p>
+ * Lowers a check statement with its {@code is} statements.
+ * </p>
+ * 
+ * <p>
+ * The checked value is evaluated once. If it is integral (or an enum)
+ * and all cases are number literals, booleans or enumerators, the cases
+ * are sorted by their value and dispatched by IR_lower_case_range:
+ * dense ranges become a jump table ({@code switch}), the others are
+ * split in halves by a comparison (binary search), so a case is found
+ * with O(log n) branches. Otherwise the cases are compared one after the
+ * other. If two cases have the same value, the first one wins.
+ * </p>
+ * 
+ * <p>
+ * <strong>Layout:</strong>
+ * ```
+ *         switch %value, end, 1 [is1, is2, end, is4]
+ * is1:    ...     jump end
+ * is2:    ...     jump end
+ * is4:    ...     jump end
+ * end:
+ * ```
+ * </p>
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the check statement
+ */
+void IR_lower_check(struct IRContext *context, Node *node) {
+	struct IRFunction *function = context->function;
+	Node *runnable = node->rightNode;
+	int value = IR_lower_expression(context, node->leftNode);
+
+	if (value == IR_NO_REGISTER || runnable == NULL) {
+		return;
+	}
+
+	enum VarType type = IR_type_of(context, value);
+	size_t count = runnable->detailsCount;
+	struct IRCase *cases = (struct IRCase*)calloc(count + 1, sizeof(struct IRCase));
+	Node **values = (Node**)calloc(count + 1, sizeof(Node*));
+	int *blocks = (int*)calloc(count + 1, sizeof(int));
+	int constant = type == BOOLEAN || (type != FLOAT && type != DOUBLE && (int)IR_get_type_rank(type) > 0) ? true : false;
+	size_t caseCount = 0;
+	size_t valueCount = 0;
+
+	if (cases == NULL || values == NULL || blocks == NULL) {
+		(void)free(cases);
+		(void)free(values);
+		(void)free(blocks);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	int endBlock = IR_add_block(function);
+
+	for (size_t i = 0; i < count; i++) {
+		Node *isNode = runnable->details[i];
+
+		if (isNode == NULL || isNode->type != _IS_STMT_NODE_) {
+			continue;
+		}
+
+		values[valueCount] = isNode->leftNode;
+		blocks[valueCount] = IR_add_block(function);
+
+		//A value, that the checked type can't hold, never matches
+		if (constant == true && isNode->leftNode != NULL && (int)IR_get_case_value(context, isNode->leftNode, type, &cases[caseCount].value) == true) {
+			cases[caseCount].block = blocks[valueCount];
+			cases[caseCount].order = valueCount;
+			caseCount += (int)IR_fits_type(type, cases[caseCount].value);
+		} else {
+			constant = false;
+		}
+
+		valueCount++;
+	}
+
+	if (constant == true) {
+		size_t unique = 0;
+		(void)qsort(cases, caseCount, sizeof(struct IRCase), IR_compare_cases);
+
+		for (size_t i = 0; i < caseCount; i++) {
+			if (unique == 0 || cases[unique - 1].value != cases[i].value) {
+				cases[unique++] = cases[i];
+			}
+		}
+
+		(void)IR_lower_case_range(context, value, cases, unique, endBlock, node->line);
+	} else {
+		(void)IR_lower_case_chain(context, node, value, values, blocks, valueCount, endBlock);
+	}
+
+	for (size_t i = 0, n = 0; i < count; i++) {
+		Node *isNode = runnable->details[i];
+
+		if (isNode == NULL || isNode->type != _IS_STMT_NODE_) {
+			continue;
+		}
+
+		//Cases, that can't be reached, are removed with the other unreachable blocks
+		(void)IR_start_block(function, blocks[n++]);
+		(void)IR_lower_scope(context, isNode->rightNode);
+
+		if ((int)IR_is_block_terminated(function) == false) {
+			(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, endBlock, IR_NO_REGISTER, IR_NO_REGISTER, isNode->line);
+		}
+	}
+
+	(void)IR_start_block(function, endBlock);
+	(void)free(cases);
+	(void)free(values);
+	(void)free(blocks);
+}
+
+/**
+ * <p>
+ * Dispatches a value to the blocks of sorted cases with distinct values.
+ * </p>
+ * 
+ * <p>
+ * A range with enough cases, whose values are close together, becomes a
+ * single {@code switch} (the gaps go to the default block). Up to
+ * IR_MAX_LINEAR_CASES cases are compared one after the other, all other
+ * ranges are split at the middle case by {@code lt} and both halves are
+ * dispatched on their own.
+ * </p>
+ * 
+ * @param *context      Context of the lowering
+ * @param value         Register of the checked value
+ * @param *cases        Cases of the range (sorted by their value)
+ * @param count         Number of cases in the range
+ * @param defaultBlock  Block for values without a case
+ * @param line          Line of the check statement
+ */
+void IR_lower_case_range(struct IRContext *context, int value, struct IRCase *cases, size_t count, int defaultBlock, size_t line) {
+	struct IRFunction *function = context->function;
+	enum VarType type = IR_type_of(context, value);
+	unsigned long long span = count == 0 ? 0 : (unsigned long long)cases[count - 1].value - (unsigned long long)cases[0].value + 1;
+
+	if (count >= IR_MIN_SWITCH_CASES && span <= IR_MAX_SWITCH_TABLE && span <= (unsigned long long)count * IR_SWITCH_DENSITY) {
+		int table[IR_MAX_SWITCH_TABLE + 1];
+		table[0] = defaultBlock;
+
+		for (unsigned long long i = 0; i < span; i++) {
+			table[i + 1] = defaultBlock;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			table[(unsigned long long)cases[i].value - (unsigned long long)cases[0].value + 1] = cases[i].block;
+		}
+
+		int first = IR_add_cases(function, table, (int)span + 1);
+		struct IRInstruction *instruction = IR_emit(function, IR_SWITCH, VOID, IR_NO_REGISTER, value, first, (int)span, line);
+		instruction->value.integer = cases[0].value;
+		(void)ST_count(COUNTER_JUMP_TABLES, 1);
+		return;
+	} else if (count <= IR_MAX_LINEAR_CASES) {
+		for (size_t i = 0; i < count; i++) {
+			int nextBlock = IR_add_block(function);
+			int condition = IR_add_register(function, BOOLEAN, NULL);
+			int constant = IR_emit_integer(context, type, cases[i].value, line);
+
+			(void)IR_emit(function, IR_EQ, BOOLEAN, condition, value, constant, IR_NO_REGISTER, line);
+			(void)IR_emit(function, IR_BRANCH, VOID, IR_NO_REGISTER, condition, cases[i].block, nextBlock, line);
+			(void)IR_start_block(function, nextBlock);
+		}
+
+		(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, defaultBlock, IR_NO_REGISTER, IR_NO_REGISTER, line);
+		return;
+	}
+
+	size_t middle = count / 2;
+	int lowerBlock = IR_add_block(function);
+	int upperBlock = IR_add_block(function);
+	int condition = IR_add_register(function, BOOLEAN, NULL);
+	int constant = IR_emit_integer(context, type, cases[middle].value, line);
+
+	(void)IR_emit(function, IR_LT, BOOLEAN, condition, value, constant, IR_NO_REGISTER, line);
+	(void)IR_emit(function, IR_BRANCH, VOID, IR_NO_REGISTER, condition, lowerBlock, upperBlock, line);
+	(void)IR_start_block(function, lowerBlock);
+	(void)IR_lower_case_range(context, value, cases, middle, defaultBlock, line);
+	(void)IR_start_block(function, upperBlock);
+	(void)IR_lower_case_range(context, value, &cases[middle], count - middle, defaultBlock, line);
+}
+
+/*
+Purpose: Compare the checked value with the cases one after the other (values, that aren't constant, and floating values)
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the check statement;
+		int value => Register of the checked value;
+		Node **values => Values of the is statements;
+		int *blocks => Blocks of the is statements;
+		size_t count => Number of is statements;
+		int endBlock => Block after the check statement
+*/
+void IR_lower_case_chain(struct IRContext *context, Node *node, int value, Node **values, int *blocks, size_t count, int endBlock) {
+	struct IRFunction *function = context->function;
+
+	for (size_t i = 0; i < count; i++) {
+		int caseValue = IR_lower_expression(context, values[i]);
+		int condition = caseValue == IR_NO_REGISTER ? IR_NO_REGISTER : IR_emit_comparison(context, IR_EQ, value, caseValue, values[i]);
+
+		if (condition == IR_NO_REGISTER) {
+			continue;
+		}
+
+		int nextBlock = IR_add_block(function);
+		(void)IR_emit(function, IR_BRANCH, VOID, IR_NO_REGISTER, condition, blocks[i], nextBlock, values[i]->line);
+		(void)IR_start_block(function, nextBlock);
+	}
+
+	(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, endBlock, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+}
+
+/*
+Purpose: Get the value of a case, that is known at compile time (number literals and enumerators)
+Return Type: int => true = constant value; false = has to be computed
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Value of the is statement;
+		enum VarType type => Type of the checked value;
+		long long *value => Receives the value
+*/
+int IR_get_case_value(struct IRContext *context, Node *node, enum VarType type, long long *value) {
+	switch (node->type) {
+	case _NUMBER_NODE_:
+		*value = strtoll(node->value, NULL, 10);
+		return type != BOOLEAN ? true : false;
+	case _MEM_CLASS_ACC_NODE_:
+		return type != BOOLEAN ? IR_get_enumerator(context, node, value) : false;
+	default:
+		return false;
+	}
+}
+
+int IR_compare_cases(const void *first, const void *second) {
+	const struct IRCase *firstCase = (const struct IRCase*)first;
+	const struct IRCase *secondCase = (const struct IRCase*)second;
+
+	if (firstCase->value != secondCase->value) {
+		return firstCase->value < secondCase->value ? -1 : 1;
+	}
+
+	return firstCase->order < secondCase->order ? -1 : (firstCase->order > secondCase->order ? 1 : 0);
+}
+
+/*
+Purpose: Lower a while loop (cond: br cond, body, end; body: ... jump cond; end:)
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the loop
+*/
+void IR_lower_while(struct IRContext *context, Node *node) {
+	struct IRFunction *function = context->function;
+	int conditionBlock = IR_add_block(function);
+	int bodyBlock = IR_add_block(function);
+	int endBlock = IR_add_block(function);
+
+	(void)IR_start_block(function, conditionBlock);
+	(void)IR_lower_branch(context, node->leftNode, bodyBlock, endBlock);
+
+	(void)IR_start_block(function, bodyBlock);
+	(void)IR_push_loop(context, conditionBlock, endBlock);
+	(void)IR_lower_scope(context, node->rightNode);
+	context->loopCount--;
+
+	if ((int)IR_is_block_terminated(function) == false) {
+		(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, conditionBlock, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	}
+
+	(void)IR_start_block(function, endBlock);
+}
+
+/*
+Purpose: Lower a do-while loop (body: ...; cond: br cond, body, end; end:)
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the loop
+*/
+void IR_lower_do(struct IRContext *context, Node *node) {
+	struct IRFunction *function = context->function;
+	int bodyBlock = IR_add_block(function);
+	int conditionBlock = IR_add_block(function);
+	int endBlock = IR_add_block(function);
+
+	(void)IR_start_block(function, bodyBlock);
+	(void)IR_push_loop(context, conditionBlock, endBlock);
+	(void)IR_lower_scope(context, node->rightNode);
+	context->loopCount--;
+
+	(void)IR_start_block(function, conditionBlock);
+	(void)IR_lower_branch(context, node->leftNode, bodyBlock, endBlock);
+	(void)IR_start_block(function, endBlock);
+}
+
+/*
+Purpose: Lower a for loop, the variable of the loop lives in its own scope
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the loop (leftNode = variable, details[0] = condition, details[1] = step)
+*/
+void IR_lower_for(struct IRContext *context, Node *node) {
+	struct IRFunction *function = context->function;
+	size_t localCount = context->localCount;
+	context->scopeDepth++;
+
+	if (node->leftNode != NULL) {
+		(void)IR_lower_variable(context, node->leftNode);
+	}
+
+	int conditionBlock = IR_add_block(function);
+	int bodyBlock = IR_add_block(function);
+	int stepBlock = IR_add_block(function);
+	int endBlock = IR_add_block(function);
+
+	(void)IR_start_block(function, conditionBlock);
+
+	if (node->detailsCount > 0 && node->details[0] != NULL) {
+		(void)IR_lower_branch(context, node->details[0], bodyBlock, endBlock);
+	}
+
+	(void)IR_start_block(function, bodyBlock);
+	(void)IR_push_loop(context, stepBlock, endBlock);
+	(void)IR_lower_scope(context, node->rightNode);
+	context->loopCount--;
+
+	(void)IR_start_block(function, stepBlock);
+
+	if (node->detailsCount > 1 && node->details[1] != NULL) {
+		(void)IR_lower_statement(context, node->details, 1, node->detailsCount);
+	}
+
+	(void)IR_emit(function, IR_JUMP, VOID, IR_NO_REGISTER, conditionBlock, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	(void)IR_start_block(function, endBlock);
+	context->scopeDepth--;
+	context->localCount = localCount;
+}
+
+/**
+ * <p>
+ * Lowers a return statement.
+ * </p>
+ * 
+ * <p>
+ * If the function has no declared return type, the first returned
+ * value defines it and all following returns are converted to it.
+ * The pending finally runnables run after the value was computed.
+ * </p>
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the return statement
+ */
+void IR_lower_return(struct IRContext *context, Node *node) {
+	struct IRFunction *function = context->function;
+
+	if (function == context->module->functions[context->module->entryFunction]) {
+		(void)IR_report_unsupported(context, node, "Return statements outside of functions");
+		return;
+	}
+
+	int value = IR_NO_REGISTER;
+
+	if (node->leftNode != NULL) {
+		value = IR_lower_value(context, node->leftNode, function->returnType);
+
+		if (value == IR_NO_REGISTER) {
+			return;
+		}
+	}
+
+	if (function->returnType == null && context->inferReturnType == true) {
+		function->returnType = value == IR_NO_REGISTER ? VOID : IR_type_of(context, value);
+		function->returnReference = IR_reference_of(context, value);
+	}
+
+	if ((function->returnType == VOID) != (value == IR_NO_REGISTER)) {
+		(void)IR_report_type_problem(context, node, function->returnType == VOID ? "The function doesn't return a value" : "The function has to return a value");
+		return;
+	}
+
+	value = value == IR_NO_REGISTER ? value : IR_convert(context, value, function->returnType, node->leftNode);
+
+	//The finally runnables could change the returned variable
+	if (context->finallyCount > context->finallyBase) {
+		if (value != IR_NO_REGISTER) {
+			int saved = IR_add_typed_register(function, function->returnType, NULL, function->returnReference);
+			(void)IR_emit(function, IR_MOVE, function->returnType, saved, value, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+			value = saved;
+		}
+
+		(void)IR_lower_pending_finallies(context, context->finallyBase);
+	}
+
+	if ((int)IR_is_block_terminated(function) == false) {
+		(void)IR_emit(function, IR_RETURN, function->returnType, IR_NO_REGISTER, value, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	}
+
+	(void)IR_start_dead_block(context);
+}
+
+/*
+Purpose: Lower a break or continue statement into a jump out of the innermost loop
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the statement
+*/
+void IR_lower_loop_exit(struct IRContext *context, Node *node) {
+	if (context->loopCount <= context->loopBase) {
+		(void)IR_report_unsupported(context, node, node->type == _BREAK_STMT_NODE_ ? "Break statements outside of loops" : "Continue statements outside of loops");
+		return;
+	}
+
+	struct IRLoop *loop = &context->loops[context->loopCount - 1];
+	int target = node->type == _BREAK_STMT_NODE_ ? loop->breakBlock : loop->continueBlock;
+	(void)IR_lower_pending_finallies(context, loop->finallyCount);
+
+	if ((int)IR_is_block_terminated(context->function) == false) {
+		(void)IR_emit(context->function, IR_JUMP, VOID, IR_NO_REGISTER, target, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	}
+
+	(void)IR_start_dead_block(context);
+}
+
+/*
+Purpose: Lower the finally runnables above the base (innermost first), before a return, break or continue leaves their try statements
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		size_t base => Number of finally runnables, that stay pending
+*/
+void IR_lower_pending_finallies(struct IRContext *context, size_t base) {
+	struct IRFunction *function = context->function;
+	size_t finallyCount = context->finallyCount;
+	int handler = function->handler;
+
+	//A finally runnable only sees the try statements outside of it
+	for (size_t i = finallyCount; i-- > base && (int)IR_is_block_terminated(function) == false;) {
+		context->finallyCount = i;
+		(void)IR_lower_finally(context, context->finallies[i].runnable, context->finallies[i].handler);
+	}
+
+	context->finallyCount = finallyCount;
+	function->handler = handler;
+}
+
+void IR_push_loop(struct IRContext *context, int continueBlock, int breakBlock) {
+	context->loops = (struct IRLoop*)IR_reserve(context->loops, &context->loopCapacity, context->loopCount, sizeof(struct IRLoop));
+	context->loops[context->loopCount].continueBlock = continueBlock;
+	context->loops[context->loopCount].breakBlock = breakBlock;
+	context->loops[context->loopCount].finallyCount = context->finallyCount;
+	context->loopCount++;
+}
+
+void IR_push_finally(struct IRContext *context, Node *runnable, int handler) {
+	context->finallies = (struct IRFinally*)IR_reserve(context->finallies, &context->finallyCapacity, context->finallyCount, sizeof(struct IRFinally));
+	context->finallies[context->finallyCount].runnable = runnable;
+	context->finallies[context->finallyCount].handler = handler;
+	context->finallyCount++;
+}
+
+/*
+Purpose: Start a block after a return, break or continue, that gets removed by IR_finish_function()
+Return Type: void
+Params: struct IRContext *context => Context of the lowering
+*/
+void IR_start_dead_block(struct IRContext *context) {
+	(void)IR_start_block(context->function, IR_add_block(context->function));
+}
+
+/**
+ * <p>
+ * Lowers an expression.
+ * </p>
+ * 
+ * @returns The register with the value or IR_NO_REGISTER, if the expression couldn't be lowered (the problem is reported)
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the expression
+ */
+int IR_lower_expression(struct IRContext *context, Node *node) {
+	if (node == NULL) {
+		return IR_NO_REGISTER;
+	}
+
+	switch (node->type) {
+	case _NUMBER_NODE_:
+	case _FLOAT_NODE_:
+	case _BOOL_NODE_:
+	case _STRING_NODE_:
+		return IR_lower_constant(context, node);
+	case _IDEN_NODE_: {
+		struct IRLocation location;
+		return (int)IR_resolve_location(context, node, &location) == true ? IR_load_location(context, &location, node) : IR_NO_REGISTER;
+	}
+	case _THIS_NODE_:
+		if (context->classIndex < 0) {
+			(void)IR_report_unsupported(context, node, "'this' outside of classes");
+			return IR_NO_REGISTER;
+		}
+
+		return 0;
+	case _NULL_NODE_:
+		return IR_emit_integer(context, CLASS_REF, 0, node->line);
+	case _FUNCTION_CALL_NODE_:
+		return IR_lower_function_call(context, node, false);
+	case _MEM_CLASS_ACC_NODE_:
+		return IR_lower_member_access(context, node, false);
+	case _INHERITED_CLASS_NODE_:
+		return IR_lower_new(context, node);
+	case _ARRAY_CREATION_NODE_:
+		return IR_lower_new_array(context, node);
+	case _PLUS_NODE_:
+		return IR_lower_binary(context, node, IR_ADD);
+	case _MINUS_NODE_:
+		return IR_lower_binary(context, node, IR_SUB);
+	case _MULTIPLY_NODE_:
+		return IR_lower_binary(context, node, IR_MUL);
+	case _DIVIDE_NODE_:
+		return IR_lower_binary(context, node, IR_DIV);
+	case _MODULO_NODE_:
+		return IR_lower_binary(context, node, IR_MOD);
+	case _LEFT_BITSHIFT_NODE_:
+		return IR_lower_binary(context, node, IR_SHL);
+	case _RIGHT_BITSHIFT_NODE_:
+		return IR_lower_binary(context, node, IR_SHR);
+	case _LOGICAL_AND_NODE_:
+		return IR_lower_binary(context, node, IR_BIT_AND);
+	case _LOGICAL_OR_NODE_:
+		return IR_lower_binary(context, node, IR_BIT_OR);
+	case _XOR_NODE_:
+		return IR_lower_binary(context, node, IR_BIT_XOR);
+	case _NOT_NODE_:
+		return IR_lower_not(context, node);
+	case _EQUALS_CONDITION_NODE_:
+		return IR_lower_comparison(context, node, IR_EQ);
+	case _NOT_EQUALS_CONDITION_NODE_:
+		return IR_lower_comparison(context, node, IR_NE);
+	case _GREATER_CONDITION_NODE_:
+		return IR_lower_comparison(context, node, IR_GT);
+	case _SMALLER_CONDITION_NODE_:
+		return IR_lower_comparison(context, node, IR_LT);
+	case _GREATER_OR_EQUAL_CONDITION_NODE_:
+		return IR_lower_comparison(context, node, IR_GE);
+	case _SMALLER_OR_EQUAL_CONDITION_NODE_:
+		return IR_lower_comparison(context, node, IR_LE);
+	case _AND_NODE_:
+		return IR_lower_logical(context, node, true);
+	case _OR_NODE_:
+		return IR_lower_logical(context, node, false);
+	default:
+		(void)IR_report_unsupported(context, node, IR_get_construct_name(node->type));
+		return IR_NO_REGISTER;
+	}
+}
+
+int IR_lower_condition(struct IRContext *context, Node *node) {
+	int condition = IR_lower_expression(context, node);
+
+	if (condition != IR_NO_REGISTER && IR_type_of(context, condition) != BOOLEAN) {
+		(void)IR_report_type_problem(context, node, "The condition isn't a boolean");
+		return IR_NO_REGISTER;
+	}
+
+	return condition;
+}
+
+/**
+ * <p>
+ * Lowers the condition of a statement directly into branches to the
+ * two blocks.
+ * </p>
+ * 
+ * <p>
+ * 'and', 'or' and '!' don't compute a boolean, every operand branches
+ * on its own: the right side of an 'and' is only reached, if the left
+ * side is true, the right side of an 'or' only, if the left side is
+ * false, and '!' swaps the targets. The block of the right side is
+ * started directly after the branch of the left side, so it falls
+ * through.
+ * </p>
+ * 
+ * <p>
+ * <strong>Layout ('a and b or c'):</strong>
+ * ```
+ *        br %a, right, or
+ * right: br %b, true, or
+ * or:    br %c, true, false
+ * ```
+ * </p>
+ * 
+ * @param *context      Context of the lowering
+ * @param *node         Node of the condition
+ * @param trueBlock     Block, that is entered, if the condition is true
+ * @param falseBlock    Block, that is entered, if the condition is false
+ */
+void IR_lower_branch(struct IRContext *context, Node *node, int trueBlock, int falseBlock) {
+	struct IRFunction *function = context->function;
+
+	if (node->type == _AND_NODE_ || node->type == _OR_NODE_) {
+		int rightBlock = IR_add_block(function);
+
+		if (node->type == _AND_NODE_) {
+			(void)IR_lower_branch(context, node->leftNode, rightBlock, falseBlock);
+		} else {
+			(void)IR_lower_branch(context, node->leftNode, trueBlock, rightBlock);
+		}
+
+		(void)IR_start_block(function, rightBlock);
+		(void)IR_lower_branch(context, node->rightNode, trueBlock, falseBlock);
+		return;
+	} else if (node->type == _NOT_NODE_) {
+		(void)IR_lower_branch(context, node->rightNode != NULL ? node->rightNode : node->leftNode, falseBlock, trueBlock);
+		return;
+	}
+
+	int condition = IR_lower_condition(context, node);
+	(void)IR_emit(function, IR_BRANCH, VOID, IR_NO_REGISTER, condition, trueBlock, falseBlock, node->line);
+}
+
+/*
+Purpose: Lower a literal into a constant (numbers, that don't fit into an int, are longs; literals with one letter are chars)
+Return Type: int => Register with the constant
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the literal
+*/
+int IR_lower_constant(struct IRContext *context, Node *node) {
+	struct IRFunction *function = context->function;
+
+	switch (node->type) {
+	case _NUMBER_NODE_: {
+		long long value = strtoll(node->value, NULL, 10);
+		return IR_emit_integer(context, value > INT_MAX ? LONG : INTEGER, value, node->line);
+	}
+	case _BOOL_NODE_:
+		return IR_emit_integer(context, BOOLEAN, strcmp(node->value, "true") == 0 ? 1 : 0, node->line);
+	case _FLOAT_NODE_: {
+		int reg = IR_add_register(function, DOUBLE, NULL);
+		struct IRInstruction *instruction = IR_emit(function, IR_CONST_FLOAT, DOUBLE, reg, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+		instruction->value.floating = strtod(node->value, NULL);
+		return reg;
+	}
+	default:
+		if ((int)IR_is_char_literal(node) == true) {
+			//An empty literal is the character 0
+			return IR_emit_integer(context, CHAR, strlen(node->value) == 2 ? 0 : (long long)node->value[1], node->line);
+		}
+
+		return IR_lower_string(context, node);
+	}
+}
+
+/*
+Purpose: Lower a literal into a string constant, also if it has only one letter
+Return Type: int => Register with the string
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the literal
+*/
+int IR_lower_string(struct IRContext *context, Node *node) {
+	//Strings keep their quotes in the node
+	size_t length = strlen(node->value);
+	char *value = (char*)calloc(length + 1, sizeof(char));
+
+	if (value == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return IR_NO_REGISTER;
+	}
+
+	int quoted = length >= 2 && (node->value[0] == '"' || node->value[0] == '\'') ? true : false;
+	(void)strncpy(value, quoted == true ? node->value + 1 : node->value, length);
+	length = strlen(value);
+
+	if (quoted == true && length > 0 && value[length - 1] == node->value[0]) {
+		value[length - 1] = '\0';
+	}
+
+	int string = IR_add_string(context->module, value);
+	(void)free(value);
+
+	int reg = IR_add_register(context->function, STRING, NULL);
+	(void)IR_emit(context->function, IR_CONST_STRING, STRING, reg, string, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	return reg;
+}
+
+/*
+Purpose: Check whether a literal is a char, the semantic analysis types literals with up to one letter as chars
+Return Type: int => true = is a char; false = other node
+Params: Node *node => Node to check
+*/
+int IR_is_char_literal(Node *node) {
+	if (node == NULL || (node->type != _STRING_NODE_ && node->type != _CHAR_ARRAY_NODE_) || node->value == NULL) {
+		return false;
+	}
+
+	size_t length = strlen(node->value);
+	return length >= 2 && length <= 3 && (node->value[0] == '"' || node->value[0] == '\'') && node->value[length - 1] == node->value[0] ? true : false;
+}
+
+/*
+Purpose: Lower an expression, that is converted into a type (a literal with one letter stays a string, if a string is expected)
+Return Type: int => The register with the value or IR_NO_REGISTER
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the expression;
+		enum VarType type => Expected type (null = unknown)
+*/
+int IR_lower_value(struct IRContext *context, Node *node, enum VarType type) {
+	if (type == STRING && (int)IR_is_char_literal(node) == true) {
+		return IR_lower_string(context, node);
+	}
+
+	return IR_lower_expression(context, node);
+}
+
+int IR_lower_binary(struct IRContext *context, Node *node, enum IROpcode opcode) {
+	int left = IR_lower_expression(context, node->leftNode);
+	int right = IR_lower_value(context, node->rightNode, IR_type_of(context, left));
+
+	//A letter in front of a string is concatenated ('a' + "bc")
+	if (IR_type_of(context, right) == STRING && (int)IR_is_char_literal(node->leftNode) == true) {
+		left = IR_lower_string(context, node->leftNode);
+	}
+
+	if (left == IR_NO_REGISTER || right == IR_NO_REGISTER) {
+		return IR_NO_REGISTER;
+	}
+
+	return IR_emit_binary(context, opcode, left, right, node);
+}
+
+/**
+ * <p>
+ * Emits an arithmetic or bitwise operation, both operands are
+ * converted to the larger type first.
+ * </p>
+ * 
+ * <p>
+ * {@code +} on two strings is a concatenation, it's the only operation
+ * on strings.
+ * </p>
+ * 
+ * @returns The register of the result or IR_NO_REGISTER
+ * 
+ * @param *context  Context of the lowering
+ * @param opcode    Operation
+ * @param left      Register of the left operand
+ * @param right     Register of the right operand
+ * @param *node     Node of the operation (for the line and the errors)
+ */
+int IR_emit_binary(struct IRContext *context, enum IROpcode opcode, int left, int right, Node *node) {
+	enum VarType leftType = IR_type_of(context, left);
+	enum VarType rightType = IR_type_of(context, right);
+
+	if (leftType == STRING && rightType == STRING && opcode == IR_ADD) {
+		int dest = IR_add_register(context->function, STRING, NULL);
+		(void)IR_emit(context->function, IR_CONCAT, STRING, dest, left, right, IR_NO_REGISTER, node->line);
+		return dest;
+	} else if (leftType == STRING || rightType == STRING) {
+		(void)IR_report_unsupported(context, node, "String operations other than the concatenation");
+		return IR_NO_REGISTER;
+	}
+
+	enum VarType type = IR_get_common_type(leftType, rightType);
+	int integral = type == INTEGER || type == LONG || type == SHORT || type == CHAR ? true : false;
+	int bitwise = opcode == IR_SHL || opcode == IR_SHR || opcode == IR_BIT_AND || opcode == IR_BIT_OR || opcode == IR_BIT_XOR ? true : false;
+
+	if (type == null || (bitwise == true && integral == false)) {
+		(void)IR_report_type_problem(context, node, "The operands of the operation aren't numbers");
+		return IR_NO_REGISTER;
+	}
+
+	left = IR_convert(context, left, type, node);
+	right = IR_convert(context, right, type, node);
+	int dest = IR_add_register(context->function, type, NULL);
+	(void)IR_emit(context->function, opcode, type, dest, left, right, IR_NO_REGISTER, node->line);
+	return dest;
+}
+
+/*
+Purpose: Lower a comparison into a boolean (numbers are converted to the larger type first)
+Return Type: int => Register of the result or IR_NO_REGISTER
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the comparison;
+		enum IROpcode opcode => Comparison to emit
+*/
+int IR_lower_comparison(struct IRContext *context, Node *node, enum IROpcode opcode) {
+	int left = IR_lower_expression(context, node->leftNode);
+	int right = IR_lower_expression(context, node->rightNode);
+
+	if (left == IR_NO_REGISTER || right == IR_NO_REGISTER) {
+		return IR_NO_REGISTER;
+	}
+
+	return IR_emit_comparison(context, opcode, left, right, node);
+}
+
+/*
+Purpose: Emit a comparison of two registers (numbers are converted to the larger type first)
+Return Type: int => Register of the result or IR_NO_REGISTER
+Params: struct IRContext *context => Context of the lowering;
+		enum IROpcode opcode => Comparison to emit;
+		int left => Register of the left operand;
+		int right => Register of the right operand;
+		Node *node => Node of the comparison (for the line and the errors)
+*/
+int IR_emit_comparison(struct IRContext *context, enum IROpcode opcode, int left, int right, Node *node) {
+	enum VarType leftType = IR_type_of(context, left);
+	enum VarType rightType = IR_type_of(context, right);
+	enum VarType type = IR_get_common_type(leftType, rightType);
+
+	if (leftType == BOOLEAN && rightType == BOOLEAN && (opcode == IR_EQ || opcode == IR_NE)) {
+		type = BOOLEAN;
+	} else if (leftType == CLASS_REF && rightType == CLASS_REF && (opcode == IR_EQ || opcode == IR_NE)) {
+		//References are compared by identity
+		type = CLASS_REF;
+	} else if (leftType == STRING || rightType == STRING) {
+		(void)IR_report_unsupported(context, node, "String comparisons");
+		return IR_NO_REGISTER;
+	} else if (type == null) {
+		(void)IR_report_type_problem(context, node, "The compared values aren't comparable");
+		return IR_NO_REGISTER;
+	}
+
+	left = IR_convert(context, left, type, node);
+	right = IR_convert(context, right, type, node);
+	int dest = IR_add_register(context->function, BOOLEAN, NULL);
+	(void)IR_emit(context->function, opcode, BOOLEAN, dest, left, right, IR_NO_REGISTER, node->line);
+	return dest;
+}
+
+/*
+Purpose: Get the value of an enumerator of an enum in the top level scope
+Return Type: int => true = is an enumerator; false = other member access
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the member access ('Color->RED');
+		long long *value => Receives the value of the enumerator
+*/
+int IR_get_enumerator(struct IRContext *context, Node *node, long long *value) {
+	//Layout: MEMCLASSACC [left: enum name] [right: '->' [left: enumerator]]
+	Node *accessNode = node->rightNode;
+
+	if (node->type != _MEM_CLASS_ACC_NODE_ || node->leftNode == NULL || accessNode == NULL
+		|| accessNode->type != _CLASS_ACCESS_NODE_ || accessNode->rightNode != NULL
+		|| (int)IR_is_simple_identifier(accessNode->leftNode) == false) {
+		return false;
+	}
+
+	struct IRSymbol *symbol = node->leftNode->value == NULL ? NULL : IR_get_symbol(context, node->leftNode->value);
+
+	if (symbol == NULL || symbol->kind != IR_SYMBOL_ENUM) {
+		return false;
+	}
+
+	Node *enumNode = context->enums[symbol->index];
+
+	for (size_t i = 0; i < enumNode->detailsCount; i++) {
+		Node *enumerator = enumNode->details[i];
+
+		if (enumerator != NULL && enumerator->rightNode != NULL && strcmp(enumerator->value, accessNode->leftNode->value) == 0) {
+			*value = strtoll(enumerator->rightNode->value, NULL, 10);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int IR_lower_not(struct IRContext *context, Node *node) {
+	int operand = IR_lower_condition(context, node->rightNode != NULL ? node->rightNode : node->leftNode);
+
+	if (operand == IR_NO_REGISTER) {
+		return IR_NO_REGISTER;
+	}
+
+	int dest = IR_add_register(context->function, BOOLEAN, NULL);
+	(void)IR_emit(context->function, IR_NOT, BOOLEAN, dest, operand, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	return dest;
+}
+
+/**
+ * <p>
+ * Lowers 'and' / 'or' with short-circuit evaluation, the right side
+ * only runs if the left side doesn't decide the result.
+ * </p>
+ * 
+ * <p>
+ * <strong>Layout ('and'):</strong>
+ * ```
+ *        %r = move %left
+ *        br %left, right, end
+ * right: %r = move %right
+ *        jump end
+ * end:
+ * ```
+ * </p>
+ * 
+ * @returns The register of the result or IR_NO_REGISTER
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the condition
+ * @param isAnd     Whether the condition is an 'and' (else 'or')
+ */
+int IR_lower_logical(struct IRContext *context, Node *node, int isAnd) {
+	struct IRFunction *function = context->function;
+	int left = IR_lower_condition(context, node->leftNode);
+
+	if (left == IR_NO_REGISTER) {
+		return IR_NO_REGISTER;
+	}
+
+	int result = IR_add_register(function, BOOLEAN, NULL);
+	int rightBlock = IR_add_block(function);
+	int endBlock = IR_add_block(function);
+
+	(void)IR_emit(function, IR_MOVE, BOOLEAN, result, left, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	(void)IR_emit(function, IR_BRANCH, VOID, IR_NO_REGISTER, left, isAnd == true ? rightBlock : endBlock, isAnd == true ? endBlock : rightBlock, node->line);
+	(void)IR_start_block(function, rightBlock);
+
+	int right = IR_lower_condition(context, node->rightNode);
+
+	if (right != IR_NO_REGISTER) {
+		(void)IR_emit(function, IR_MOVE, BOOLEAN, result, right, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	}
+
+	(void)IR_start_block(function, endBlock);
+	return right == IR_NO_REGISTER ? IR_NO_REGISTER : result;
+}
+
+/**
+ * <p>
+ * Lowers a call of a function of the top level scope.
+ * </p>
+ * 
+ * <p>
+ * The arguments are converted to the types of the parameters. If the
+ * return type of the callee isn't known yet, the callee is lowered first.
+ * A call without an object in a method calls the method of the class,
+ * if it has one with the name.
+ * </p>
+ * 
+ * @returns The register of the result or IR_NO_REGISTER (also for void calls)
+ * 
+ * @param *context      Context of the lowering
+ * @param *node         Node of the call (the arguments are in the details)
+ * @param asStatement   Whether the result is unused
+ */
+int IR_lower_function_call(struct IRContext *context, Node *node, int asStatement) {
+	if (context->classIndex >= 0) {
+		SemanticTable *classTable = context->classes[context->classIndex].table;
+
+		if (classTable != NULL && classTable->layout != NULL && (int)IR_find_method_slot(classTable->layout, node->value, node->detailsCount) >= 0) {
+			return IR_lower_method_call(context, 0, node, asStatement);
+		}
+	}
+
+	struct IRSymbol *symbol = IR_get_symbol(context, node->value);
+
+	if (symbol == NULL || symbol->kind != IR_SYMBOL_FUNCTION) {
+		(void)IR_report_unresolved(context, node);
+		return IR_NO_REGISTER;
+	}
+
+	(void)IR_lower_function(context, symbol->index);
+	struct IRFunction *callee = context->module->functions[symbol->index];
+
+	if (callee->returnType == null) {
+		(void)IR_report_unsupported(context, node, "Recursive functions without a return type ('->type')");
+		return IR_NO_REGISTER;
+	} else if (callee->returnType == VOID && asStatement == false) {
+		(void)IR_report_type_problem(context, node, "The function doesn't return a value");
+		return IR_NO_REGISTER;
+	} else if ((int)node->detailsCount != callee->paramCount) {
+		(void)IR_report_type_problem(context, node, "The number of arguments doesn't match the function");
+		return IR_NO_REGISTER;
+	}
+
+	int first = IR_lower_arguments(context, node, IR_NO_REGISTER, callee, NULL);
+	return first < 0 ? IR_NO_REGISTER : IR_emit_call(context, callee, symbol->index, first, (int)node->detailsCount, node);
+}
+
+/*
+Purpose: Lower the arguments of a call, converted to the types of the parameters
+Return Type: int => Index of the first argument (see IR_add_arguments) or -1, if an argument couldn't be lowered
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the call (the arguments are in the details);
+		int receiver => Register of the object, that is passed first (IR_NO_REGISTER for functions);
+		struct IRFunction *callee => The called function (NULL for the methods of interfaces);
+		SemanticEntry *method => Entry of the interface method (the parameter types are taken from it without a callee)
+*/
+int IR_lower_arguments(struct IRContext *context, Node *node, int receiver, struct IRFunction *callee, SemanticEntry *method) {
+	int offset = receiver == IR_NO_REGISTER ? 0 : 1;
+	int *arguments = (int*)calloc(node->detailsCount + 2, sizeof(int));
+
+	if (arguments == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	arguments[0] = receiver;
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		enum VarType type = null;
+
+		if (callee != NULL) {
+			type = callee->registers[i + (size_t)offset].type;
+		} else {
+			SemanticEntry *param = (SemanticEntry*)L_get_item(((SemanticTable*)method->reference)->paramList, (int)i);
+			struct IRReference reference = IR_NO_REFERENCE;
+			type = param == NULL ? null : IR_get_dec_type(context, node->details[i], param->dec, false, &reference);
+		}
+
+		int argument = type == null ? IR_NO_REGISTER : IR_lower_value(context, node->details[i], type);
+		arguments[i + (size_t)offset] = argument == IR_NO_REGISTER ? argument : IR_convert(context, argument, type, node->details[i]);
+
+		if (arguments[i + (size_t)offset] == IR_NO_REGISTER) {
+			(void)free(arguments);
+			return -1;
+		}
+	}
+
+	int first = IR_add_arguments(context->function, arguments, (int)node->detailsCount + offset);
+	(void)free(arguments);
+	return first;
+}
+
+/*
+Purpose: Emit a direct call of a function, the result gets the return type and reference of the callee
+Return Type: int => Register of the result or IR_NO_REGISTER for void functions
+Params: struct IRContext *context => Context of the lowering;
+		struct IRFunction *callee => The called function;
+		int index => Index of the called function;
+		int first => Index of the first argument;
+		int count => Number of arguments;
+		Node *node => Node of the call (for the line)
+*/
+int IR_emit_call(struct IRContext *context, struct IRFunction *callee, int index, int first, int count, Node *node) {
+	int dest = callee->returnType == VOID ? IR_NO_REGISTER : IR_add_typed_register(context->function, callee->returnType, NULL, callee->returnReference);
+	(void)IR_emit(context->function, IR_CALL, callee->returnType, dest, index, first, count, node->line);
+	return dest;
+}
+
+/**
+ * <p>
+ * Lowers the call of a method on an object into a virtual call.
+ * </p>
+ * 
+ * <p>
+ * The method is searched in the vtable of the static class of the
+ * object by its name and number of parameters, for an interface in its
+ * methods. The types of the parameters and the result are taken from
+ * the function of the slot (the method of the static class or the one,
+ * that it inherits), for an interface from its declaration.
+ * </p>
+ * 
+ * @returns The register of the result or IR_NO_REGISTER (also for void calls)
+ * 
+ * @param *context      Context of the lowering
+ * @param object        Register of the object
+ * @param *node         Node of the call (the arguments are in the details)
+ * @param asStatement   Whether the result is unused
+ */
+int IR_lower_method_call(struct IRContext *context, int object, Node *node, int asStatement) {
+	struct IRReference reference = IR_reference_of(context, object);
+
+	if (IR_type_of(context, object) != CLASS_REF || reference.dimension != 0 || reference.classIndex < 0) {
+		(void)IR_report_type_problem(context, node, "The method is called on a value, that isn't an object");
+		return IR_NO_REGISTER;
+	}
+
+	struct IRClassInfo *info = &context->classes[reference.classIndex];
+	struct ClassLayout *layout = info->table == NULL ? NULL : info->table->layout;
+	int slot = layout == NULL ? -1 : IR_find_method_slot(layout, node->value, node->detailsCount);
+
+	if (slot < 0) {
+		(void)IR_report_unresolved(context, node);
+		return IR_NO_REGISTER;
+	}
+
+	struct IRClass *irClass = &context->module->classes[reference.classIndex];
+	struct IRFunction *callee = NULL;
+	enum VarType returnType = null;
+	struct IRReference returnReference = IR_NO_REFERENCE;
+
+	if (irClass->isInterface == false) {
+		if (irClass->methods[slot] < 0) {
+			(void)IR_report_unresolved(context, node);
+			return IR_NO_REGISTER;
+		}
+
+		(void)IR_lower_function(context, irClass->methods[slot]);
+		callee = context->module->functions[irClass->methods[slot]];
+		returnType = callee->returnType;
+		returnReference = callee->returnReference;
+
+		if (returnType == null) {
+			(void)IR_report_unsupported(context, node, "Recursive methods without a return type ('->type')");
+			return IR_NO_REGISTER;
+		}
+	} else {
+		returnType = IR_get_dec_type(context, node, layout->methods[slot].entry->dec, true, &returnReference);
+
+		if (returnType == null) {
+			return IR_NO_REGISTER;
+		}
+	}
+
+	if (returnType == VOID && asStatement == false) {
+		(void)IR_report_type_problem(context, node, "The method doesn't return a value");
+		return IR_NO_REGISTER;
+	}
+
+	int first = IR_lower_arguments(context, node, object, callee, layout->methods[slot].entry);
+
+	if (first < 0) {
+		return IR_NO_REGISTER;
+	}
+
+	int dest = returnType == VOID ? IR_NO_REGISTER : IR_add_typed_register(context->function, returnType, NULL, returnReference);
+	struct IRInstruction *instruction = IR_emit(context->function, IR_CALL_VIRTUAL, returnType, dest, slot, first, (int)node->detailsCount + 1, node->line);
+	instruction->value.integer = reference.classIndex;
+	return dest;
+}
+
+/*
+Purpose: Find the slot of a method in a vtable by its name and number of parameters
+Return Type: int => The slot or -1, if the class has no such method
+Params: struct ClassLayout *layout => Layout with the vtable (the methods of an interface);
+		char *name => Name of the method;
+		size_t argumentCount => Number of arguments of the call
+*/
+int IR_find_method_slot(struct ClassLayout *layout, char *name, size_t argumentCount) {
+	for (size_t i = 0; i < layout->methodCount; i++) {
+		SemanticEntry *entry = layout->methods[i].entry;
+		SemanticTable *methodTable = (SemanticTable*)entry->reference;
+
+		if (strcmp(entry->name, name) == 0 && methodTable != NULL && (size_t)methodTable->paramList->load == argumentCount) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * <p>
+ * Lowers the creation of an object ({@code new Point(1, 2)}).
+ * </p>
+ * 
+ * <p>
+ * The new object runs the nearest initializer of its class chain
+ * (see IR_lower_initializers) and then the constructor, that takes the
+ * number of arguments. Without arguments the constructor is optional.
+ * </p>
+ * 
+ * @returns The register of the object or IR_NO_REGISTER
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the creation (the arguments are in the details)
+ */
+int IR_lower_new(struct IRContext *context, Node *node) {
+	int classIndex = IR_get_class_index(context, node->value);
+
+	if (classIndex < 0) {
+		(void)IR_report_unsupported(context, node, "Classes of included files");
+		return IR_NO_REGISTER;
+	} else if (context->module->classes[classIndex].isInterface == true) {
+		(void)IR_report_type_problem(context, node, "An interface can't be created");
+		return IR_NO_REGISTER;
+	}
+
+	struct IRFunction *function = context->function;
+	int object = IR_add_typed_register(function, CLASS_REF, NULL, (struct IRReference){CLASS_REF, classIndex, 0});
+	int initializer = IR_find_initializer(context, classIndex);
+	int constructor = IR_find_constructor(context, classIndex, node->detailsCount);
+	(void)IR_emit(function, IR_NEW, CLASS_REF, object, classIndex, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+
+	if (initializer >= 0) {
+		int first = IR_add_arguments(function, &object, 1);
+		(void)IR_emit_call(context, context->module->functions[initializer], initializer, first, 1, node);
+	}
+
+	if (constructor < 0 && node->detailsCount > 0) {
+		(void)IR_report_type_problem(context, node, "No constructor of the class takes the arguments");
+		return IR_NO_REGISTER;
+	} else if (constructor >= 0) {
+		int first = IR_lower_arguments(context, node, object, context->module->functions[constructor], NULL);
+
+		if (first < 0) {
+			return IR_NO_REGISTER;
+		}
+
+		(void)IR_emit_call(context, context->module->functions[constructor], constructor, first, (int)node->detailsCount + 1, node);
+	}
+
+	return object;
+}
+
+/*
+Purpose: Find the initializer of a class, that is the one of the nearest parent, if the class has none
+Return Type: int => Index of the initializer or -1, if no class of the chain has one
+Params: struct IRContext *context => Context of the lowering;
+		int classIndex => The class
+*/
+int IR_find_initializer(struct IRContext *context, int classIndex) {
+	for (int current = classIndex; current >= 0; current = context->module->classes[current].parent) {
+		if (context->classes[current].initializer >= 0) {
+			return context->classes[current].initializer;
+		}
+	}
+
+	return -1;
+}
+
+/*
+Purpose: Find the constructor of a class, that takes a number of arguments (constructors aren't inherited)
+Return Type: int => Index of the constructor or -1
+Params: struct IRContext *context => Context of the lowering;
+		int classIndex => The class;
+		size_t argumentCount => Number of arguments (without the object)
+*/
+int IR_find_constructor(struct IRContext *context, int classIndex, size_t argumentCount) {
+	struct IRClassInfo *info = &context->classes[classIndex];
+
+	for (size_t i = 0; i < info->constructorCount; i++) {
+		if (context->module->functions[info->constructors[i]]->paramCount == (int)argumentCount + 1) {
+			return info->constructors[i];
+		}
+	}
+
+	return -1;
+}
+
+/*
+Purpose: Lower the call of the constructor of the parent ('super(args)') into a direct call on the object
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the super statement
+*/
+void IR_lower_super_call(struct IRContext *context, Node *node) {
+	Node *callNode = node->rightNode;
+	int parent = context->classIndex < 0 ? -1 : context->module->classes[context->classIndex].parent;
+
+	if (callNode == NULL || callNode->type != _SUPER_CONSRTUCTOR_CALL_NODE_ || parent < 0) {
+		(void)IR_report_unsupported(context, node, "Super accesses other than the constructor call");
+		return;
+	}
+
+	int constructor = IR_find_constructor(context, parent, callNode->detailsCount);
+
+	if (constructor < 0) {
+		if (callNode->detailsCount > 0) {
+			(void)IR_report_type_problem(context, node, "No constructor of the parent takes the arguments");
+		}
+
+		return;
+	}
+
+	int first = IR_lower_arguments(context, callNode, 0, context->module->functions[constructor], NULL);
+
+	if (first >= 0) {
+		(void)IR_emit_call(context, context->module->functions[constructor], constructor, first, (int)callNode->detailsCount + 1, node);
+	}
+}
+
+/*
+Purpose: Lower the creation of an array ('new int[n][m]'), the arrays of the inner dimensions without a length stay null
+Return Type: int => Register of the array or IR_NO_REGISTER
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the creation (the lengths are in the details)
+*/
+int IR_lower_new_array(struct IRContext *context, Node *node) {
+	struct IRReference reference = IR_NO_REFERENCE;
+	struct VarDec dec = SA_get_VarType(node, false, context->table);
+	dec.dimension = (int)node->detailsCount;
+
+	if (dec.dimension < 1 || IR_get_dec_type(context, node, dec, false, &reference) == null) {
+		if (dec.dimension < 1) {
+			(void)IR_report_unsupported(context, node, "Arrays without a length");
+		}
+
+		return IR_NO_REGISTER;
+	}
+
+	int *lengths = (int*)calloc(node->detailsCount, sizeof(int));
+
+	if (lengths == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return IR_NO_REGISTER;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		int length = IR_lower_expression(context, node->details[i]);
+		lengths[i] = length == IR_NO_REGISTER ? length : IR_convert(context, length, INTEGER, node->details[i]);
+
+		if (lengths[i] == IR_NO_REGISTER) {
+			(void)free(lengths);
+			return IR_NO_REGISTER;
+		}
+	}
+
+	int array = IR_emit_new_array(context, lengths, (int)node->detailsCount, reference, node);
+	(void)free(lengths);
+	return array;
+}
+
+int IR_emit_new_array(struct IRContext *context, int *lengths, int count, struct IRReference reference, Node *node) {
+	int first = IR_add_arguments(context->function, lengths, count);
+	int array = IR_add_typed_register(context->function, CLASS_REF, NULL, reference);
+	(void)IR_emit(context->function, IR_NEW_ARRAY, CLASS_REF, array, IR_NO_REGISTER, first, count, node->line);
+	return array;
+}
+
+/**
+ * <p>
+ * Lowers an initializer list ({@code {{1, 2}, {3, 4}}}) into a new
+ * array, that gets the elements one after the other. The nested lists
+ * become the arrays of the inner dimension.
+ * </p>
+ * 
+ * @returns The register of the array or IR_NO_REGISTER
+ * 
+ * @param *context      Context of the lowering
+ * @param *node         Node of the list (the elements are in the details)
+ * @param reference     Array type of the list
+ */
+int IR_lower_array_init(struct IRContext *context, Node *node, struct IRReference reference) {
+	if (reference.dimension < 1) {
+		(void)IR_report_type_problem(context, node, "The initializer list doesn't match the array");
+		return IR_NO_REGISTER;
+	}
+
+	struct IRReference elementReference = IR_NO_REFERENCE;
+	enum VarType elementType = IR_get_element_type(reference, &elementReference);
+	int length = IR_emit_integer(context, INTEGER, (long long)node->detailsCount, node->line);
+	int array = IR_emit_new_array(context, &length, 1, reference, node);
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		Node *elementNode = node->details[i];
+		int element = IR_NO_REGISTER;
+
+		if (elementNode != NULL && elementNode->type == _ARRAY_ASSIGNMENT_NODE_) {
+			element = IR_lower_array_init(context, elementNode, elementReference);
+		} else {
+			element = IR_lower_value(context, elementNode, elementType);
+			element = element == IR_NO_REGISTER ? element : IR_convert(context, element, elementType, elementNode);
+		}
+
+		if (element == IR_NO_REGISTER) {
+			return IR_NO_REGISTER;
+		}
+
+		//The index lies within the new array
+		int index = IR_emit_integer(context, INTEGER, (long long)i, node->line);
+		struct IRInstruction *instruction = IR_emit(context->function, IR_STORE_ELEMENT, elementType, IR_NO_REGISTER, array, index, element, node->line);
+		instruction->value.integer = true;
+	}
+
+	return array;
+}
+
+/*
+Purpose: Lower a member access ('obj->field', 'obj->method()', 'Color->RED') into its value
+Return Type: int => Register with the value or IR_NO_REGISTER (also for void method calls)
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the member access;
+		int asStatement => Whether the value is unused
+*/
+int IR_lower_member_access(struct IRContext *context, Node *node, int asStatement) {
+	struct IRLocation location;
+
+	if ((int)IR_resolve_member(context, node, &location, asStatement) == false) {
+		return IR_NO_REGISTER;
+	}
+
+	return location.kind == IR_LOCATION_VALUE ? location.reg : IR_load_location(context, &location, node);
+}
+
+/**
+ * <p>
+ * Resolves the target of a read or write: a variable, a field or an
+ * array element. All other expressions are lowered into their value.
+ * </p>
+ * 
+ * @returns true if the target was resolved, else false (the problem is reported)
+ * 
+ * @param *context  Context of the lowering
+ * @param *node     Node of the target
+ * @param *location Receives the target
+ */
+int IR_resolve_location(struct IRContext *context, Node *node, struct IRLocation *location) {
+	switch (node->type) {
+	case _IDEN_NODE_:
+		if ((int)IR_resolve_variable(context, node, location) == false) {
+			return false;
+		}
+
+		return node->leftNode == NULL ? true : IR_resolve_elements(context, node->leftNode, location, node);
+	case _MEM_CLASS_ACC_NODE_:
+		return IR_resolve_member(context, node, location, false);
+	default: {
+		int value = IR_lower_expression(context, node);
+		*location = (struct IRLocation){IR_LOCATION_VALUE, IR_type_of(context, value), IR_reference_of(context, value), value, IR_NO_REGISTER, -1, false};
+		return value == IR_NO_REGISTER ? false : true;
+	}
+	}
+}
+
+/*
+Purpose: Resolve a name into a local, a field of the object of the method or a global (in this order)
+Return Type: int => true if the name was resolved, else false
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Identifier of the variable;
+		struct IRLocation *location => Receives the variable
+*/
+int IR_resolve_variable(struct IRContext *context, Node *node, struct IRLocation *location) {
+	int local = IR_find_local(context, node->value);
+
+	if (local != IR_NO_REGISTER) {
+		*location = (struct IRLocation){IR_LOCATION_LOCAL, IR_type_of(context, local), IR_reference_of(context, local), local, IR_NO_REGISTER, -1, false};
+		return true;
+	}
+
+	int field = context->classIndex < 0 ? -1 : IR_find_field(context, context->classIndex, node->value);
+
+	if (field >= 0) {
+		struct IRField *fieldEntry = &context->module->classes[context->classIndex].fields[field];
+		*location = (struct IRLocation){IR_LOCATION_FIELD, fieldEntry->type, fieldEntry->reference, 0, field, context->classIndex, false};
+		return fieldEntry->type == null ? false : true;
+	}
+
+	struct IRSymbol *symbol = IR_get_symbol(context, node->value);
+
+	if (symbol == NULL || symbol->kind != IR_SYMBOL_GLOBAL) {
+		(void)IR_report_unresolved(context, node);
+		return false;
+	}
+
+	struct IRGlobal *global = &context->module->globals[symbol->index];
+
+	if (global->type == null) {
+		(void)IR_report_unsupported(context, node, "Globals without a type, that are used before their declaration");
+		return false;
+	}
+
+	*location = (struct IRLocation){IR_LOCATION_GLOBAL, global->type, global->reference, IR_NO_REGISTER, symbol->index, -1, false};
+	return true;
+}
+
+/*
+Purpose: Resolve the element accesses behind an array ('arr[i][j]'), every access but the last one loads its array
+Return Type: int => true if the elements were resolved, else false
+Params: struct IRContext *context => Context of the lowering;
+		Node *access => First array access (the next one is the right node);
+		struct IRLocation *location => The array, receives the element;
+		Node *node => Node of the array (for the errors)
+*/
+int IR_resolve_elements(struct IRContext *context, Node *access, struct IRLocation *location, Node *node) {
+	for (; access != NULL; access = access->rightNode) {
+		if (access->type != _ARRAY_ACCESS_NODE_ || access->leftNode == NULL) {
+			(void)IR_report_unsupported(context, access, IR_get_construct_name(access->type));
+			return false;
+		}
+
+		int array = IR_load_location(context, location, node);
+
+		if (array == IR_NO_REGISTER) {
+			return false;
+		}
+
+		struct IRReference reference = IR_reference_of(context, array);
+
+		if (IR_type_of(context, array) != CLASS_REF || reference.dimension < 1) {
+			(void)IR_report_type_problem(context, node, "The value isn't an array");
+			return false;
+		}
+
+		int index = IR_lower_expression(context, access->leftNode);
+		index = index == IR_NO_REGISTER ? index : IR_convert(context, index, INTEGER, access->leftNode);
+
+		if (index == IR_NO_REGISTER) {
+			return false;
+		}
+
+		location->kind = IR_LOCATION_ELEMENT;
+		location->reg = array;
+		location->index = index;
+		location->classIndex = -1;
+		location->proven = access->provenIndex;
+		location->type = IR_get_element_type(reference, &location->reference);
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Resolves a member access ({@code a->next->value}, {@code a->get(1)},
+ * {@code this->data[i]}) into its last member.
+ * </p>
+ * 
+ * <p>
+ * Every member but the last one is loaded as the object of the next
+ * one, a method call is lowered into its result. An access of an
+ * enumerator ({@code Color->RED}) is its value.
+ * </p>
+ * 
+ * @returns true if the member was resolved, else false (the problem is reported)
+ * 
+ * @param *context      Context of the lowering
+ * @param *node         Node of the member access
+ * @param *location     Receives the last member
+ * @param asStatement   Whether the value is unused (a void method may end the access)
+ */
+int IR_resolve_member(struct IRContext *context, Node *node, struct IRLocation *location, int asStatement) {
+	//Layout: MEMCLASSACC [left: object] [right: '->' [left: member] [right: next '->']]
+	long long value = 0;
+	Node *base = node->leftNode;
+
+	if ((int)IR_get_enumerator(context, node, &value) == true) {
+		int reg = IR_emit_integer(context, INTEGER, value, node->line);
+		*location = (struct IRLocation){IR_LOCATION_VALUE, INTEGER, IR_NO_REFERENCE, reg, IR_NO_REGISTER, -1, false};
+		return true;
+	} else if (base == NULL) {
+		(void)IR_report_unsupported(context, node, IR_get_construct_name(node->type));
+		return false;
+	} else if ((int)IR_resolve_location(context, base, location) == false) {
+		return false;
+	}
+
+	for (Node *access = node->rightNode; access != NULL; access = access->rightNode) {
+		Node *member = access->leftNode;
+
+		if (access->type != _CLASS_ACCESS_NODE_ || member == NULL) {
+			(void)IR_report_unsupported(context, access, IR_get_construct_name(access->type));
+			return false;
+		}
+
+		int object = IR_load_location(context, location, access);
+
+		if (object == IR_NO_REGISTER) {
+			return false;
+		}
+
+		struct IRReference reference = IR_reference_of(context, object);
+
+		if (member->type == _FUNCTION_CALL_NODE_) {
+			int errors = context->errors;
+			int result = IR_lower_method_call(context, object, member, asStatement == true && access->rightNode == NULL ? true : false);
+			*location = (struct IRLocation){IR_LOCATION_VALUE, IR_type_of(context, result), IR_reference_of(context, result), result, IR_NO_REGISTER, -1, false};
+
+			if (context->errors > errors || (result == IR_NO_REGISTER && access->rightNode != NULL)) {
+				return false;
+			}
+
+			continue;
+		} else if (member->type != _IDEN_NODE_) {
+			(void)IR_report_unsupported(context, member, IR_get_construct_name(member->type));
+			return false;
+		} else if (IR_type_of(context, object) != CLASS_REF || reference.dimension != 0 || reference.classIndex < 0) {
+			(void)IR_report_type_problem(context, member, "The member is accessed on a value, that isn't an object");
+			return false;
+		}
+
+		int field = IR_find_field(context, reference.classIndex, member->value);
+
+		if (field < 0) {
+			(void)IR_report_unresolved(context, member);
+			return false;
+		}
+
+		struct IRField *fieldEntry = &context->module->classes[reference.classIndex].fields[field];
+		*location = (struct IRLocation){IR_LOCATION_FIELD, fieldEntry->type, fieldEntry->reference, object, field, reference.classIndex, false};
+
+		if (fieldEntry->type == null || (member->leftNode != NULL && (int)IR_resolve_elements(context, member->leftNode, location, member) == false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Load the value of a resolved target
+Return Type: int => Register with the value or IR_NO_REGISTER
+Params: struct IRContext *context => Context of the lowering;
+		struct IRLocation *location => The target;
+		Node *node => Node of the target (for the line)
+*/
+int IR_load_location(struct IRContext *context, struct IRLocation *location, Node *node) {
+	if (location->kind == IR_LOCATION_LOCAL || location->kind == IR_LOCATION_VALUE) {
+		return location->reg;
+	}
+
+	int dest = IR_add_typed_register(context->function, location->type, NULL, location->reference);
+
+	switch (location->kind) {
+	case IR_LOCATION_GLOBAL:
+		(void)IR_emit(context->function, IR_LOAD_GLOBAL, location->type, dest, location->index, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+		break;
+	case IR_LOCATION_FIELD: {
+		struct IRInstruction *instruction = IR_emit(context->function, IR_LOAD_FIELD, location->type, dest, location->reg, location->index, IR_NO_REGISTER, node->line);
+		instruction->value.integer = location->classIndex;
+		break;
+	}
+	default: {
+		struct IRInstruction *instruction = IR_emit(context->function, IR_LOAD_ELEMENT, location->type, dest, location->reg, location->index, IR_NO_REGISTER, node->line);
+		instruction->value.integer = location->proven;
+		break;
+	}
+	}
+
+	return dest;
+}
+
+/*
+Purpose: Store a value into a resolved target, the value is converted to the type of the target
+Return Type: void
+Params: struct IRContext *context => Context of the lowering;
+		struct IRLocation *location => The target;
+		int value => Register with the value;
+		Node *node => Node of the target (for the line and the errors)
+*/
+void IR_store_location(struct IRContext *context, struct IRLocation *location, int value, Node *node) {
+	if (value == IR_NO_REGISTER) {
+		return;
+	} else if (location->kind == IR_LOCATION_VALUE) {
+		(void)IR_report_type_problem(context, node, "The value can't be assigned");
+		return;
+	}
+
+	value = IR_convert(context, value, location->type, node);
+
+	if (value == IR_NO_REGISTER) {
+		return;
+	}
+
+	switch (location->kind) {
+	case IR_LOCATION_LOCAL:
+		(void)IR_emit(context->function, IR_MOVE, location->type, location->reg, value, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+		break;
+	case IR_LOCATION_GLOBAL:
+		(void)IR_emit(context->function, IR_STORE_GLOBAL, location->type, IR_NO_REGISTER, location->index, value, IR_NO_REGISTER, node->line);
+		break;
+	case IR_LOCATION_FIELD: {
+		struct IRInstruction *instruction = IR_emit(context->function, IR_STORE_FIELD, location->type, IR_NO_REGISTER, location->reg, location->index, value, node->line);
+		instruction->value.integer = location->classIndex;
+		break;
+	}
+	default: {
+		struct IRInstruction *instruction = IR_emit(context->function, IR_STORE_ELEMENT, location->type, IR_NO_REGISTER, location->reg, location->index, value, node->line);
+		instruction->value.integer = location->proven;
+		break;
+	}
+	}
+}
+
+/*
+Purpose: Find a field of a class by its name, the field of the class itself wins over the fields of its parents
+Return Type: int => Index of the field in the class or -1
+Params: struct IRContext *context => Context of the lowering;
+		int classIndex => The class;
+		char *name => Name of the field
+*/
+int IR_find_field(struct IRContext *context, int classIndex, char *name) {
+	struct IRClass *irClass = &context->module->classes[classIndex];
+
+	for (int owner = classIndex; owner >= 0; owner = context->module->classes[owner].parent) {
+		for (size_t i = 0; i < irClass->fieldCount; i++) {
+			if (irClass->fields[i].owner == owner && strcmp(irClass->fields[i].name, name) == 0) {
+				return (int)i;
+			}
+		}
+	}
+
+	return -1;
+}
+
+int IR_emit_integer(struct IRContext *context, enum VarType type, long long value, size_t line) {
+	int reg = IR_add_register(context->function, type, NULL);
+	struct IRInstruction *instruction = IR_emit(context->function, IR_CONST_INT, type, reg, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, line);
+	instruction->value.integer = value;
+	return reg;
+}
+
+/*
+Purpose: Emit the value of a variable without initializer (0, 0.0, false or "")
+Return Type: int => Register with the value
+Params: struct IRContext *context => Context of the lowering;
+		enum VarType type => Type of the value;
+		size_t line => Line of the declaration
+*/
+int IR_emit_default_value(struct IRContext *context, enum VarType type, size_t line) {
+	if (type == DOUBLE || type == FLOAT) {
+		int reg = IR_add_register(context->function, type, NULL);
+		struct IRInstruction *instruction = IR_emit(context->function, IR_CONST_FLOAT, type, reg, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, line);
+		instruction->value.floating = 0;
+		return reg;
+	} else if (type == STRING) {
+		int reg = IR_add_register(context->function, type, NULL);
+		(void)IR_emit(context->function, IR_CONST_STRING, type, reg, IR_add_string(context->module, ""), IR_NO_REGISTER, IR_NO_REGISTER, line);
+		return reg;
+	}
+
+	return IR_emit_integer(context, type, 0, line);
+}
+
+/**
+ * <p>
+ * Converts a register to another type. Numbers are converted with
+ * IR_CONVERT, all other types have to match.
+ * </p>
+ * 
+ * @returns The converted register (the same if the types match) or IR_NO_REGISTER
+ * 
+ * @param *context  Context of the lowering
+ * @param reg       Register to convert
+ * @param type      Target type
+ * @param *node     Node of the value (for the line and the errors)
+ */
+int IR_convert(struct IRContext *context, int reg, enum VarType type, Node *node) {
+	enum VarType from = IR_type_of(context, reg);
+
+	if (reg == IR_NO_REGISTER || from == type) {
+		return reg;
+	} else if ((int)IR_get_type_rank(from) == 0 || (int)IR_get_type_rank(type) == 0) {
+		(void)IR_report_type_problem(context, node, "The value can't be converted to the expected type");
+		return IR_NO_REGISTER;
+	}
+
+	int dest = IR_add_register(context->function, type, NULL);
+	(void)IR_emit(context->function, IR_CONVERT, type, dest, reg, IR_NO_REGISTER, IR_NO_REGISTER, node->line);
+	return dest;
+}
+
+/*
+Purpose: Find the register of a local variable of the current function (the innermost declaration wins)
+Return Type: int => Register of the variable or IR_NO_REGISTER
+Params: struct IRContext *context => Context of the lowering;
+		char *name => Name of the variable
+*/
+int IR_find_local(struct IRContext *context, char *name) {
+	for (size_t i = context->localCount; i > context->localBase; i--) {
+		if (strcmp(context->locals[i - 1].name, name) == 0) {
+			return context->locals[i - 1].reg;
+		}
+	}
+
+	return IR_NO_REGISTER;
+}
+
+void IR_push_local(struct IRContext *context, char *name, int reg) {
+	context->locals = (struct IRLocal*)IR_reserve(context->locals, &context->localCapacity, context->localCount, sizeof(struct IRLocal));
+	context->locals[context->localCount].name = name;
+	context->locals[context->localCount].reg = reg;
+	context->localCount++;
+}
+
+int IR_is_global_scope(struct IRContext *context) {
+	return context->function == context->module->functions[context->module->entryFunction] && context->scopeDepth == 0 ? true : false;
+}
+
+/*
+Purpose: Get the type of a type node (primitives, String, enums, classes and arrays of them)
+Return Type: enum VarType => The type or null, if the type can't be lowered (the problem is reported)
+Params: struct IRContext *context => Context of the lowering;
+		Node *typeNode => Node of the type;
+		int allowVoid => Whether void is allowed (return types);
+		struct IRReference *reference => Receives the object or array of a reference type
+*/
+enum VarType IR_get_declared_type(struct IRContext *context, Node *typeNode, int allowVoid, struct IRReference *reference) {
+	struct VarDec dec = SA_get_VarType(typeNode, false, context->table);
+	return IR_get_dec_type(context, typeNode, dec, allowVoid, reference);
+}
+
+/**
+ * <p>
+ * Gets the type of a declaration of the semantic analysis.
+ * </p>
+ * 
+ * <p>
+ * Enums hold the value of their enumerator, so they are ints. Objects
+ * and arrays are references (CLASS_REF), the reference describes their
+ * class or elements. Classes of included files aren't part of the
+ * module, so they can't be lowered.
+ * </p>
+ * 
+ * @returns The type or null, if the type can't be lowered (the problem is reported)
+ * 
+ * @param *context      Context of the lowering
+ * @param *node         Node of the declaration (for the errors)
+ * @param dec           The declared type
+ * @param allowVoid     Whether void is allowed (return types)
+ * @param *reference    Receives the object or array of a reference type
+ */
+enum VarType IR_get_dec_type(struct IRContext *context, Node *node, struct VarDec dec, int allowVoid, struct IRReference *reference) {
+	struct IRSymbol *symbol = dec.typeName == NULL ? NULL : IR_get_symbol(context, dec.typeName);
+	enum VarType type = null;
+	int classIndex = -1;
+	*reference = IR_NO_REFERENCE;
+
+	if (dec.type == VOID && dec.dimension == 0) {
+		type = allowVoid == true ? VOID : null;
+	} else if (dec.type == STRING || dec.type == BOOLEAN || (int)IR_get_type_rank(dec.type) > 0) {
+		type = dec.type;
+	} else if (dec.type == ENUM_REF || (symbol != NULL && symbol->kind == IR_SYMBOL_ENUM)) {
+		//Enums hold the value of their enumerator
+		type = INTEGER;
+	} else if (symbol != NULL && symbol->kind == IR_SYMBOL_CLASS) {
+		type = CLASS_REF;
+		classIndex = symbol->index;
+	}
+
+	if (type == null) {
+		(void)IR_report_unsupported(context, node, dec.type == CLASS_REF ? "Classes of included files" : "This type");
+		return null;
+	} else if (dec.dimension > 0) {
+		*reference = (struct IRReference){type, classIndex, dec.dimension};
+		return CLASS_REF;
+	} else if (type == CLASS_REF) {
+		*reference = (struct IRReference){CLASS_REF, classIndex, 0};
+	}
+
+	return type;
+}
+
+/*
+Purpose: Get the declared type of a variable, array or class instance (the dimensions of an array are counted)
+Return Type: enum VarType => The type or null, if the variable has no type or it can't be lowered (the problem is reported)
+Params: struct IRContext *context => Context of the lowering;
+		Node *node => Node of the declaration;
+		struct IRReference *reference => Receives the object or array of a reference type
+*/
+enum VarType IR_get_variable_type(struct IRContext *context, Node *node, struct IRReference *reference) {
+	//details: [type or NULL] [array dimensions...]
+	Node *typeNode = node->detailsCount > 0 && node->details[0] != NULL && node->details[0]->type == _VAR_TYPE_NODE_ ? node->details[0] : NULL;
+	int dimension = 0;
+	*reference = IR_NO_REFERENCE;
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		dimension += node->details[i] != NULL && node->details[i]->type == _ARRAY_DIM_NODE_ ? 1 : 0;
+	}
+
+	if (typeNode == NULL && node->rightNode != NULL && node->rightNode->type == _INHERITED_CLASS_NODE_
+		&& (node->type == _VAR_CLASS_INSTANCE_NODE_ || node->type == _CONST_CLASS_INSTANCE_NODE_)) {
+		//An instance without a type has the type of the created class
+		struct VarDec dec = {CLASS_REF, 0, node->rightNode->value, false};
+		return IR_get_dec_type(context, node->rightNode, dec, false, reference);
+	} else if (typeNode == NULL) {
+		return null;
+	}
+
+	struct VarDec dec = SA_get_VarType(typeNode, false, context->table);
+	dec.dimension += dimension;
+	return IR_get_dec_type(context, typeNode, dec, false, reference);
+}
+
+/*
+Purpose: Get the type of the elements of an array
+Return Type: enum VarType => Type of the elements (CLASS_REF for the arrays of the inner dimension and objects)
+Params: struct IRReference array => The array;
+		struct IRReference *element => Receives the reference of the elements
+*/
+enum VarType IR_get_element_type(struct IRReference array, struct IRReference *element) {
+	*element = IR_NO_REFERENCE;
+
+	if (array.dimension > 1) {
+		*element = (struct IRReference){array.elementType, array.classIndex, array.dimension - 1};
+		return CLASS_REF;
+	} else if (array.elementType == CLASS_REF) {
+		*element = (struct IRReference){CLASS_REF, array.classIndex, 0};
+	}
+
+	return array.elementType;
+}
+
+int IR_add_typed_register(struct IRFunction *function, enum VarType type, char *name, struct IRReference reference) {
+	int reg = IR_add_register(function, type, name);
+	function->registers[reg].reference = reference;
+	return reg;
+}
+
+struct IRReference IR_reference_of(struct IRContext *context, int reg) {
+	if (reg < 0 || (size_t)reg >= context->function->registerCount) {
+		return IR_NO_REFERENCE;
+	}
+
+	return context->function->registers[reg].reference;
+}
+
+/*
+Purpose: Check whether a value is in the range of an integral type
+Return Type: int => true = fits; false = doesn't fit
+Params: enum VarType type => Integral type (or boolean);
+		long long value => Value to check
+*/
+int IR_fits_type(enum VarType type, long long value) {
+	switch (type) {
+	case BOOLEAN:
+		return value == 0 || value == 1 ? true : false;
+	case CHAR:
+		return value >= CHAR_MIN && value <= CHAR_MAX ? true : false;
+	case SHORT:
+		return value >= SHRT_MIN && value <= SHRT_MAX ? true : false;
+	case INTEGER:
+		return value >= INT_MIN && value <= INT_MAX ? true : false;
+	default:
+		return true;
+	}
+}
+
+enum VarType IR_get_common_type(enum VarType first, enum VarType second) {
+	int firstRank = IR_get_type_rank(first);
+	int secondRank = IR_get_type_rank(second);
+
+	if (firstRank == 0 || secondRank == 0) {
+		return null;
+	}
+
+	return firstRank >= secondRank ? first : second;
+}
+
+/*
+Purpose: Get the rank of a number type, the operands of an operation are converted to the higher rank
+Return Type: int => The rank or 0, if the type isn't a number
+Params: enum VarType type => The type
+*/
+int IR_get_type_rank(enum VarType type) {
+	switch (type) {
+	case CHAR:
+		return 1;
+	case SHORT:
+		return 2;
+	case INTEGER:
+		return 3;
+	case LONG:
+		return 4;
+	case FLOAT:
+		return 5;
+	case DOUBLE:
+		return 6;
+	default:
+		return 0;
+	}
+}
+
+enum VarType IR_type_of(struct IRContext *context, int reg) {
+	if (reg < 0 || (size_t)reg >= context->function->registerCount) {
+		return null;
+	}
+
+	return context->function->registers[reg].type;
+}
+
+int IR_is_simple_identifier(Node *node) {
+	return node != NULL && node->type == _IDEN_NODE_ && node->value != NULL && node->leftNode == NULL
+		&& node->rightNode == NULL && node->detailsCount == 0 ? true : false;
+}
+
+void IR_report_unsupported(struct IRContext *context, Node *node, const char *construct) {
+	context->errors++;
+	(void)REPORT_DIAGNOSTIC(DIAG_IR_UNSUPPORTED, SEVERITY_ERROR, node->line, node->position, node->value == NULL ? 1 : strlen(node->value),
+		"IRUnsupportedException: %s can't be lowered into the IR yet at \"%s\"", construct, node->value == NULL ? "" : node->value);
+	(void)REPORT_DIAGNOSTIC_DETAILS("The intermediate representation doesn't cover all constructs of the language yet.", NULL);
+}
+
+void IR_report_unresolved(struct IRContext *context, Node *node) {
+	context->errors++;
+	(void)REPORT_DIAGNOSTIC(DIAG_IR_UNRESOLVED, SEVERITY_ERROR, node->line, node->position, node->value == NULL ? 1 : strlen(node->value),
+		"IRUnresolvedException: \"%s\" couldn't be resolved", node->value == NULL ? "" : node->value);
+	(void)REPORT_DIAGNOSTIC_DETAILS("Only variables and functions of the file can be used in the IR.", NULL);
+}
+
+void IR_report_type_problem(struct IRContext *context, Node *node, const char *problem) {
+	context->errors++;
+	(void)REPORT_DIAGNOSTIC(DIAG_IR_UNSUPPORTED, SEVERITY_ERROR, node->line, node->position, node->value == NULL ? 1 : strlen(node->value),
+		"IRTypeException: %s at \"%s\"", problem, node->value == NULL ? "" : node->value);
+}
+
+/*
+Purpose: Get a readable name of a construct, that can't be lowered
+Return Type: const char * => The name
+Params: enum NodeType type => Type of the node
+*/
+const char *IR_get_construct_name(enum NodeType type) {
+	switch (type) {
+	case _CLASS_NODE_:
+	case _CLASS_CONSTRUCTOR_NODE_:
+	case _INHERITED_CLASS_NODE_:
+	case _CONST_CLASS_INSTANCE_NODE_:
+	case _VAR_CLASS_INSTANCE_NODE_:
+	case _CLASS_ACCESS_NODE_:
+	case _MEM_CLASS_ACC_NODE_:
+	case _THIS_NODE_:
+	case _SUPER_STMT_NODE_:
+	case _SUPER_CONSRTUCTOR_CALL_NODE_:
+		return "Classes";
+	case _INTERFACE_NODE_:
+	case _INTERFACE_STMT_NODE_:
+		return "Interfaces";
+	case _ARRAY_NODE_:
+	case _ARRAY_VAR_NODE_:
+	case _ARRAY_CONST_NODE_:
+	case _ARRAY_ASSIGNMENT_NODE_:
+	case _ARRAY_CREATION_NODE_:
+	case _ARRAY_ACCESS_NODE_:
+		return "Arrays";
+	case _MEMBER_ACCESS_NODE_:
+		return "Member accesses";
+	case _CONDITIONAL_ASSIGNMENT_NODE_:
+	case _CONDITIONAL_VAR_NODE_:
+	case _CONDITIONAL_CONST_NODE_:
+		return "Conditional assignments";
+	case _TRY_NODE_:
+	case _CATCH_NODE_:
+	case _FINALLY_STMT_NODE_:
+		return "Try statements";
+	case _CHECK_STMT_NODE_:
+	case _IS_STMT_NODE_:
+		return "Check statements";
+	case _NULL_NODE_:
+		return "Null values";
+	case _POINTER_NODE_:
+	case _REFERENCE_NODE_:
+		return "Pointers and references";
+	case _EXPORT_NODE_:
+		return "Exports";
+	default:
+		return "This construct";
+	}
+}
+
+/*
+Purpose: Grow an array of the context, if it is full (aborts if no memory is left)
+Return Type: void * => The (new) array
+Params: void *array => The array;
+		size_t *capacity => Capacity of the array;
+		size_t count => Number of used entries;
+		size_t size => Size of an entry
+*/
+void *IR_reserve(void *array, size_t *capacity, size_t count, size_t size) {
+	if (count < *capacity) {
+		return array;
+	}
+
+	size_t newCapacity = *capacity < 8 ? 8 : *capacity * 2;
+	void *grown = realloc(array, newCapacity * size);
+
+	if (grown == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return array;
+	}
+
+	*capacity = newCapacity;
+	return grown;
+}
+
+void FREE_IR_CONTEXT(struct IRContext *context) {
+	(void)FREE_IR_MODULE(context->module);
+	(void)HM_free(context->symbols);
+	(void)free(context->functions);
+	(void)free(context->enums);
+
+	for (size_t i = 0; i < context->classCount; i++) {
+		(void)free(context->classes[i].constructors);
+	}
+
+	(void)free(context->classes);
+	(void)free(context->locals);
+	(void)free(context->loops);
+	(void)free(context->finallies);
+	(void)free(context);
+}
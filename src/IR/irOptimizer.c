@@ -0,0 +1,636 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/stats.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/irOptimizer.c} was created
+ * to run the optimizations on the verified IR.
+ *
+ * The passes rewrite the instructions in place, results, that aren't
+ * needed anymore, are removed afterwards and the blocks, that can't be
+ * reached, are dropped. The optimized module is verified again, so the
+ * VM and the code generation only get valid IR.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * Stream for the IR dump ({@code --dump-ir}), NULL if the IR
+ * shouldn't be dumped.
+ * </p>
+ */
+extern FILE *IR_DUMP;
+extern char *FILE_NAME;
+
+/**
+ * <p>
+ * Optimizes the module (see docs/optimizer.md).
+ * </p>
+ * 
+ * <p>
+ * The virtual calls of a single method are devirtualized and the
+ * small functions are inlined first, the objects, that don't leave
+ * their function, are replaced by their fields, then the constants are
+ * folded and propagated and the loops are optimized (the unrolled
+ * loops are folded again), then the unused results and the
+ * unreachable blocks are removed. At last the blocks are ordered,
+ * so the likely paths fall through. The optimized module
+ * is dumped ({@code --dump-ir}) and verified.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the optimization
+ * 
+ * @param *module   Module to optimize
+ */
+int OptimizeIR(struct IRModule *module) {
+	if (module == NULL) {
+		return PHASE_ABORTED;
+	}
+
+	jmp_buf recoveryPoint;
+
+	if (setjmp(recoveryPoint) != 0) {
+		return PHASE_ABORTED;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	size_t devirtualized = OPT_devirtualize_calls(module);
+	size_t inlined = OPT_inline_functions(module);
+	size_t replaced = OPT_replace_objects(module);
+	size_t folded = OPT_fold_constants(module);
+	size_t loops = OPT_optimize_loops(module);
+
+	if (loops > 0) {
+		folded += OPT_fold_constants(module);
+	}
+
+	size_t moved = 0;
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		(void)OPT_remove_dead_definitions(module->functions[i]);
+		(void)OPT_compact_function(module->functions[i]);
+		moved += OPT_layout_blocks(module->functions[i]);
+	}
+
+	(void)_init_error_recovery_point_(NULL);
+	(void)ST_count(COUNTER_DEVIRTUALIZED_CALLS, devirtualized);
+	(void)ST_count(COUNTER_INLINED_CALLS, inlined);
+	(void)ST_count(COUNTER_REPLACED_OBJECTS, replaced);
+	(void)ST_count(COUNTER_FOLDED_CONSTANTS, folded);
+	(void)ST_count(COUNTER_LOOP_OPTIMIZATIONS, loops);
+	(void)ST_count(COUNTER_MOVED_BLOCKS, moved);
+
+	if (IR_DUMP != NULL) {
+		(void)fprintf(IR_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    OPTIMIZED IR (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+		(void)IR_dump_module(IR_DUMP, module);
+	}
+
+	return (int)IR_verify_module(module) == 0 ? PHASE_SUCCESS : PHASE_ERRORS;
+}
+
+/**
+ * <p>
+ * Returns the register, that is written by the instruction.
+ * </p>
+ * 
+ * @returns The register or IR_NO_REGISTER
+ * 
+ * @param *instruction  Instruction to check
+ */
+int OPT_get_defined_register(struct IRInstruction *instruction) {
+	switch (instruction->opcode) {
+	case IR_NOP:
+	case IR_STORE_GLOBAL:
+	case IR_STORE_FIELD:
+	case IR_STORE_ELEMENT:
+	case IR_CHECK_NULL:
+	case IR_JUMP:
+	case IR_BRANCH:
+	case IR_SWITCH:
+	case IR_RETURN:
+	case IR_RESUME:
+		return IR_NO_REGISTER;
+	default:
+		return instruction->dest;
+	}
+}
+
+/**
+ * <p>
+ * Checks, if the instruction only computes its result, so it can be
+ * removed, if the result isn't read.
+ * </p>
+ * 
+ * <p>
+ * Calls and stores have side effects, an integer division (or modulo)
+ * can stop the program with a division by zero. The string operations
+ * only fail, if no memory is left, so they are removed as well (an
+ * append only changes its builder, that isn't read anymore). The same
+ * holds for a new object, but not for a new array (negative length)
+ * and the loads of fields and elements (null, index out of bounds).
+ * </p>
+ * 
+ * @returns 1 if the instruction has no side effects, else 0
+ * 
+ * @param *instruction  Instruction to check
+ */
+int OPT_is_pure(struct IRInstruction *instruction) {
+	switch (instruction->opcode) {
+	case IR_CONST_INT:
+	case IR_CONST_FLOAT:
+	case IR_CONST_STRING:
+	case IR_MOVE:
+	case IR_LOAD_GLOBAL:
+	case IR_ADD:
+	case IR_SUB:
+	case IR_MUL:
+	case IR_NEG:
+	case IR_SHL:
+	case IR_SHR:
+	case IR_BIT_AND:
+	case IR_BIT_OR:
+	case IR_BIT_XOR:
+	case IR_NOT:
+	case IR_EQ:
+	case IR_NE:
+	case IR_LT:
+	case IR_LE:
+	case IR_GT:
+	case IR_GE:
+	case IR_CONVERT:
+	case IR_CONCAT:
+	case IR_BUILDER:
+	case IR_APPEND:
+	case IR_NEW:
+		return true;
+	case IR_DIV:
+	case IR_MOD:
+		return instruction->type == DOUBLE || instruction->type == FLOAT ? true : false;
+	default:
+		return false;
+	}
+}
+
+/*
+Purpose: Get the registers, that are read by an instruction
+Return Type: int => Number of read registers
+Params: struct IRFunction *function => Function of the instruction (holds the call arguments);
+		struct IRInstruction *instruction => Instruction to check;
+		int **uses => Receives the array of the read registers;
+		int *buffer => Storage for up to three registers, if the instruction has no own array
+*/
+int OPT_get_uses(struct IRFunction *function, struct IRInstruction *instruction, int **uses, int *buffer) {
+	*uses = buffer;
+
+	switch (instruction->opcode) {
+	case IR_MOVE:
+	case IR_NEG:
+	case IR_NOT:
+	case IR_CONVERT:
+	case IR_BUILDER:
+	case IR_LOAD_FIELD:
+	case IR_CHECK_NULL:
+	case IR_BRANCH:
+	case IR_SWITCH:
+		buffer[0] = instruction->a;
+		return 1;
+	case IR_STORE_GLOBAL:
+		buffer[0] = instruction->b;
+		return 1;
+	case IR_RETURN:
+		buffer[0] = instruction->a;
+		return instruction->a != IR_NO_REGISTER ? 1 : 0;
+	case IR_CALL:
+	case IR_NEW_ARRAY:
+	case IR_CALL_VIRTUAL:
+		*uses = &function->arguments[instruction->b];
+		return instruction->c;
+	case IR_CONCAT:
+	case IR_APPEND:
+	case IR_LOAD_ELEMENT:
+		buffer[0] = instruction->a;
+		buffer[1] = instruction->b;
+		return 2;
+	case IR_STORE_FIELD:
+		buffer[0] = instruction->a;
+		buffer[1] = instruction->c;
+		return 2;
+	case IR_STORE_ELEMENT:
+		buffer[0] = instruction->a;
+		buffer[1] = instruction->b;
+		buffer[2] = instruction->c;
+		return 3;
+	default:
+		if (instruction->opcode >= IR_ADD && instruction->opcode <= IR_GE) {
+			buffer[0] = instruction->a;
+			buffer[1] = instruction->b;
+			return 2;
+		}
+
+		return 0;
+	}
+}
+
+/**
+ * <p>
+ * Replaces the pure instructions, whose results are never read, with
+ * {@code nop}.
+ * </p>
+ * 
+ * <p>
+ * A result is dead, if its register isn't live after the instruction,
+ * so a value, that is overwritten before it is read, is removed too.
+ * The registers, that are live in the landing pad, stay live before
+ * every instruction, that can raise a runtime error. The removed
+ * instructions can make their operands dead, so the liveness is
+ * computed again until nothing changes.
+ * </p>
+ * 
+ * @returns The number of removed instructions
+ * 
+ * @param *function     Function to clean up
+ */
+size_t OPT_remove_dead_definitions(struct IRFunction *function) {
+	size_t words = function->registerCount / 64 + 1;
+	size_t blockCount = function->blockCount;
+	uint64_t *liveIn = (uint64_t*)calloc(blockCount * words + 1, sizeof(uint64_t));
+	uint64_t *liveOut = (uint64_t*)calloc(blockCount * words + 1, sizeof(uint64_t));
+	uint64_t *live = (uint64_t*)calloc(words, sizeof(uint64_t));
+	size_t removed = 0;
+	int changed = true;
+	int buffer[3];
+	int *uses = NULL;
+
+	if (liveIn == NULL || liveOut == NULL || live == NULL) {
+		(void)free(liveIn);
+		(void)free(liveOut);
+		(void)free(live);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	while (changed == true) {
+		changed = false;
+		(void)OPT_compute_liveness(function, liveIn, liveOut, words);
+
+		for (size_t i = 0; i < blockCount; i++) {
+			struct IRBlock *block = &function->blocks[i];
+			(void)memcpy(live, &liveOut[i * words], words * sizeof(uint64_t));
+
+			for (size_t n = block->instructionCount; n-- > 0;) {
+				struct IRInstruction *instruction = &function->instructions[block->firstInstruction + n];
+				int definition = (int)OPT_get_defined_register(instruction);
+
+				if (definition >= 0 && (live[definition / 64] & ((uint64_t)1 << (definition % 64))) == 0
+					&& (int)OPT_is_pure(instruction) == true) {
+					instruction->opcode = IR_NOP;
+					instruction->dest = IR_NO_REGISTER;
+					instruction->a = IR_NO_REGISTER;
+					instruction->b = IR_NO_REGISTER;
+					instruction->c = IR_NO_REGISTER;
+					removed++;
+					changed = true;
+					continue;
+				}
+
+				if (definition >= 0) {
+					live[definition / 64] &= ~((uint64_t)1 << (definition % 64));
+				}
+
+				int useCount = (int)OPT_get_uses(function, instruction, &uses, buffer);
+
+				for (int u = 0; u < useCount; u++) {
+					live[uses[u] / 64] |= (uint64_t)1 << (uses[u] % 64);
+				}
+
+				for (size_t w = 0; block->handler >= 0 && w < words && (int)IR_can_raise(instruction) == true; w++) {
+					live[w] |= liveIn[(size_t)block->handler * words + w];
+				}
+			}
+		}
+	}
+
+	(void)free(liveIn);
+	(void)free(liveOut);
+	(void)free(live);
+	return removed;
+}
+
+/*
+Purpose: Compute the registers, that are live on entry and exit of every block (backwards dataflow), the registers of the landing pad are live in the whole block
+Return Type: void
+Params: struct IRFunction *function => Function to analyze;
+		uint64_t *liveIn => Receives the bitsets of the live registers on entry (words per block);
+		uint64_t *liveOut => Receives the bitsets of the live registers on exit;
+		size_t words => Number of words of a bitset
+*/
+void OPT_compute_liveness(struct IRFunction *function, uint64_t *liveIn, uint64_t *liveOut, size_t words) {
+	size_t blockCount = function->blockCount;
+	uint64_t *used = (uint64_t*)calloc(blockCount * words + 1, sizeof(uint64_t));
+	uint64_t *defined = (uint64_t*)calloc(blockCount * words + 1, sizeof(uint64_t));
+	int *successors = (int*)malloc((blockCount + 2) * sizeof(int));
+	int buffer[3];
+	int *uses = NULL;
+
+	if (used == NULL || defined == NULL || successors == NULL) {
+		(void)free(used);
+		(void)free(defined);
+		(void)free(successors);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	(void)memset(liveIn, 0, blockCount * words * sizeof(uint64_t));
+	(void)memset(liveOut, 0, blockCount * words * sizeof(uint64_t));
+
+	for (size_t i = 0; i < blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		uint64_t *blockUsed = &used[i * words];
+		uint64_t *blockDefined = &defined[i * words];
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[block->firstInstruction + n];
+			int useCount = (int)OPT_get_uses(function, instruction, &uses, buffer);
+			int definition = (int)OPT_get_defined_register(instruction);
+
+			for (int u = 0; u < useCount; u++) {
+				if ((blockDefined[uses[u] / 64] & ((uint64_t)1 << (uses[u] % 64))) == 0) {
+					blockUsed[uses[u] / 64] |= (uint64_t)1 << (uses[u] % 64);
+				}
+			}
+
+			if (definition >= 0) {
+				blockDefined[definition / 64] |= (uint64_t)1 << (definition % 64);
+			}
+		}
+	}
+
+	int changed = true;
+
+	while (changed == true) {
+		changed = false;
+
+		for (size_t i = blockCount; i-- > 0;) {
+			int handler = function->blocks[i].handler;
+			int count = (int)OPT_get_successors(function, i, successors);
+
+			for (size_t w = 0; w < words; w++) {
+				uint64_t out = 0;
+
+				for (int n = 0; n < count; n++) {
+					out |= liveIn[(size_t)successors[n] * words + w];
+				}
+
+				uint64_t in = used[i * words + w] | (out & ~defined[i * words + w]) | (handler >= 0 ? liveIn[(size_t)handler * words + w] : 0);
+
+				if (out != liveOut[i * words + w] || in != liveIn[i * words + w]) {
+					liveOut[i * words + w] = out;
+					liveIn[i * words + w] = in;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	(void)free(used);
+	(void)free(defined);
+	(void)free(successors);
+}
+
+/*
+Purpose: Get the blocks, that can follow a block (the targets of the terminator and the landing pad), every block is listed once
+Return Type: int => Number of successors
+Params: struct IRFunction *function => Function of the block;
+		size_t block => Block to check;
+		int *successors => Receives the blocks (room for the block count + 1)
+*/
+int OPT_get_successors(struct IRFunction *function, size_t block, int *successors) {
+	struct IRBlock *current = &function->blocks[block];
+	int count = 0;
+
+	if (current->instructionCount == 0) {
+		return 0;
+	}
+
+	struct IRInstruction *terminator = &function->instructions[current->firstInstruction + current->instructionCount - 1];
+	int buffer[3];
+	int *targets = NULL;
+	int targetCount = (int)IR_get_targets(function, terminator, &targets, buffer);
+
+	for (int i = 0; i <= targetCount; i++) {
+		int target = i < targetCount ? targets[i] : current->handler;
+		int known = target < 0;
+
+		for (int n = 0; n < count && known == false; n++) {
+			known = successors[n] == target;
+		}
+
+		if (known == false) {
+			successors[count++] = target;
+		}
+	}
+
+	return count;
+}
+
+/*
+Purpose: Store a copy of the blocks of a switch with the blocks replaced (for copied or inlined blocks)
+Return Type: int => Index of the copied default block or -1 if no memory is left
+Params: struct IRFunction *function => Function, that receives the copy;
+		struct IRFunction *source => Function of the switch (can be the same function);
+		struct IRInstruction *instruction => Switch to copy;
+		int *map => New blocks (indexed by the blocks of the source)
+*/
+int OPT_copy_cases(struct IRFunction *function, struct IRFunction *source, struct IRInstruction *instruction, int *map) {
+	int *blocks = (int*)malloc((size_t)(instruction->c + 1) * sizeof(int));
+
+	if (blocks == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return -1;
+	}
+
+	for (int n = 0; n <= instruction->c; n++) {
+		blocks[n] = map[source->cases[instruction->b + n]];
+	}
+
+	int first = (int)IR_add_cases(function, blocks, instruction->c + 1);
+	(void)free(blocks);
+	return first;
+}
+
+/**
+ * <p>
+ * Removes the {@code nop} instructions and the blocks, that can't be
+ * reached anymore (e.g. after a folded branch). Blocks, that are only
+ * reached by a jump, are merged into the jumping block, if both have
+ * the same landing pad.
+ * </p>
+ * 
+ * @param *function     Function to compact
+ */
+void OPT_compact_function(struct IRFunction *function) {
+	size_t count = 0;
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		size_t first = count;
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[block->firstInstruction + n];
+
+			if (instruction->opcode != IR_NOP) {
+				function->instructions[count++] = *instruction;
+			}
+		}
+
+		block->firstInstruction = first;
+		block->instructionCount = count - first;
+	}
+
+	function->instructionCount = count;
+	(void)IR_finish_function(function);
+	(void)OPT_merge_blocks(function);
+}
+
+/*
+Purpose: Append the blocks, that have a single predecessor ending with a jump to them, to that predecessor
+Return Type: void
+Params: struct IRFunction *function => Function with the blocks to merge (without unreachable blocks)
+*/
+void OPT_merge_blocks(struct IRFunction *function) {
+	size_t count = function->blockCount;
+	int *predecessors = (int*)calloc(count + 1, sizeof(int));
+	int *newIndex = (int*)malloc((count + 1) * sizeof(int));
+	struct IRBlock *blocks = (struct IRBlock*)malloc((count + 1) * sizeof(struct IRBlock));
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((function->instructionCount + 1) * sizeof(struct IRInstruction));
+
+	if (predecessors == NULL || newIndex == NULL || blocks == NULL || instructions == NULL) {
+		(void)free(predecessors);
+		(void)free(newIndex);
+		(void)free(blocks);
+		(void)free(instructions);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	//The entry block can't be merged into another block
+	predecessors[0]++;
+
+	for (size_t i = 0; i < count; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		struct IRInstruction *last = &function->instructions[block->firstInstruction + block->instructionCount - 1];
+		newIndex[i] = -1;
+
+		int buffer[3];
+		int *targets = NULL;
+		int targetCount = (int)IR_get_targets(function, last, &targets, buffer);
+
+		for (int n = 0; n < targetCount; n++) {
+			predecessors[targets[n]]++;
+		}
+
+		if (block->handler >= 0) {
+			predecessors[block->handler]++;
+		}
+	}
+
+	size_t blockCount = 0;
+	size_t instructionCount = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (newIndex[i] >= 0) {
+			continue;
+		}
+
+		int current = (int)i;
+		newIndex[current] = (int)blockCount;
+		blocks[blockCount].firstInstruction = instructionCount;
+		blocks[blockCount].handler = function->blocks[current].handler;
+		blocks[blockCount].frequency = function->blocks[current].frequency;
+
+		while (true) {
+			struct IRBlock *block = &function->blocks[current];
+			(void)memcpy(&instructions[instructionCount], &function->instructions[block->firstInstruction], block->instructionCount * sizeof(struct IRInstruction));
+			instructionCount += block->instructionCount;
+
+			struct IRInstruction *last = &instructions[instructionCount - 1];
+
+			if (last->opcode != IR_JUMP || predecessors[last->a] != 1 || newIndex[last->a] >= 0
+				|| function->blocks[last->a].handler != blocks[blockCount].handler) {
+				break;
+			}
+
+			//The jump is replaced by the instructions of the target
+			current = last->a;
+			newIndex[current] = (int)blockCount;
+			instructionCount--;
+		}
+
+		blocks[blockCount].instructionCount = instructionCount - blocks[blockCount].firstInstruction;
+		blockCount++;
+	}
+
+	for (size_t i = 0; i < instructionCount; i++) {
+		struct IRInstruction *instruction = &instructions[i];
+
+		if (instruction->opcode == IR_JUMP) {
+			instruction->a = newIndex[instruction->a];
+		} else if (instruction->opcode == IR_BRANCH) {
+			instruction->b = newIndex[instruction->b];
+			instruction->c = newIndex[instruction->c];
+		} else if (instruction->opcode == IR_SWITCH) {
+			for (int n = 0; n <= instruction->c; n++) {
+				function->cases[instruction->b + n] = newIndex[function->cases[instruction->b + n]];
+			}
+		}
+	}
+
+	for (size_t i = 0; i < blockCount; i++) {
+		blocks[i].handler = blocks[i].handler >= 0 ? newIndex[blocks[i].handler] : -1;
+	}
+
+	(void)free(function->instructions);
+	(void)free(function->blocks);
+	function->instructions = instructions;
+	function->instructionCount = instructionCount;
+	function->instructionCapacity = function->instructionCount + 1;
+	function->blocks = blocks;
+	function->blockCount = blockCount;
+	function->blockCapacity = count + 1;
+
+	(void)free(predecessors);
+	(void)free(newIndex);
+}
@@ -0,0 +1,1629 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/loopOptimizer.c} was created
+ * to optimize the loops of the IR.
+ *
+ * The loops are found by their back edges (a jump to a block, that
+ * dominates the jumping block). Loops with a single entry from outside
+ * (the preheader) get their invariant instructions hoisted into the
+ * preheader, the multiplications of an induction variable with a
+ * constant are replaced by an addition after each increment, small
+ * counted loops (known start, bound and step) are unrolled and strings,
+ * that are built by {@code s = s + x}, get a builder. Since the
+ * loops are taken from the blocks, {@code break} and {@code continue}
+ * are just other edges, that are kept by all transformations.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Maximum number of loops, that are transformed in a function by one transformation
+#define OPT_LOOP_LIMIT 64
+
+//Maximum number of instructions of an unrolled loop
+#define OPT_UNROLL_BUDGET 128
+
+//Loops with at most this number of iterations are unrolled completely
+#define OPT_UNROLL_FULL_TRIPS 16
+
+//Maximum number of iterations, that are counted to find the trip count
+#define OPT_UNROLL_TRIP_LIMIT 65536
+
+/**
+ * <p>
+ * A natural loop.
+ * </p>
+ *
+ * <p>
+ * {@code preheader} is the only block outside of the loop, that jumps
+ * to the header (-1 if there are several or if it branches),
+ * {@code latch} is the only block, that jumps back (-1 if there are
+ * several).
+ * </p>
+ */
+struct OPTLoop {
+	int header;
+	int preheader;
+	int latch;
+	uint64_t *blocks;
+};
+
+/**
+ * <p>
+ * An instruction, that is inserted into {@code block} before the
+ * instruction at {@code position} (old index), {@code order} keeps the
+ * insertions at the same position in their order.
+ * </p>
+ */
+struct OPTInsertion {
+	int block;
+	size_t position;
+	size_t order;
+	struct IRInstruction instruction;
+};
+
+/**
+ * <p>
+ * State of the loop optimization of a function.
+ * </p>
+ *
+ * <p>
+ * The loops and the dominators are found again after every change of
+ * the blocks. {@code definitions} counts the definitions of every
+ * register in the whole function.
+ * </p>
+ */
+struct OPTLoopContext {
+	struct IRModule *module;
+	struct IRFunction *function;
+
+	size_t blockWords;
+	uint64_t *dominators;
+	int *predecessors;
+	int *predecessorStart;
+
+	struct OPTLoop *loops;
+	size_t loopCount;
+	int *definitions;
+	size_t definitionCount;
+
+	struct OPTInsertion *insertions;
+	size_t insertionCount;
+	size_t insertionCapacity;
+};
+
+/**
+ * <p>
+ * An induction variable, that is only changed by adding (or
+ * subtracting) a constant, {@code step} is the sum of all increments in
+ * the loop.
+ * </p>
+ */
+struct OPTInductionVariable {
+	int reg;
+	int definitions;
+	long long step;
+};
+
+size_t OPT_optimize_function_loops(struct OPTLoopContext *context);
+size_t OPT_hoist_invariants(struct OPTLoopContext *context);
+size_t OPT_hoist_loop(struct OPTLoopContext *context, struct OPTLoop *loop, uint64_t *liveIn, int *definitions);
+int OPT_is_invariant(struct OPTLoopContext *context, struct OPTLoop *loop, struct IRInstruction *instruction, int *definitions, uint64_t *liveIn, int *stored, int hasCall);
+size_t OPT_reduce_strength(struct OPTLoopContext *context);
+size_t OPT_reduce_loop(struct OPTLoopContext *context, struct OPTLoop *loop);
+void OPT_replace_uses_in_block(struct OPTLoopContext *context, size_t index, int from, int to, int variable);
+int OPT_get_induction_variable(struct OPTLoopContext *context, struct OPTLoop *loop, int reg, struct OPTInductionVariable *variable);
+int OPT_get_increment(struct OPTLoopContext *context, size_t index, int reg, long long *step);
+size_t OPT_unroll_loops(struct OPTLoopContext *context);
+int OPT_unroll_loop(struct OPTLoopContext *context, struct OPTLoop *loop);
+int OPT_get_trip_count(struct OPTLoopContext *context, struct OPTLoop *loop, int *inside, int *outside, long long *trips);
+void OPT_copy_loop(struct OPTLoopContext *context, struct OPTLoop *loop, int factor, int inside, int outside, int exitEarly);
+size_t OPT_build_strings(struct OPTLoopContext *context);
+size_t OPT_build_loop_strings(struct OPTLoopContext *context, struct OPTLoop *loop);
+int OPT_is_built_string(struct OPTLoopContext *context, struct OPTLoop *loop, int reg);
+int OPT_is_string_update(struct OPTLoopContext *context, size_t index, size_t end, int reg);
+int OPT_is_update_temporary(struct IRFunction *function, int reg);
+void OPT_find_loops(struct OPTLoopContext *context);
+void OPT_compute_dominators(struct OPTLoopContext *context);
+void OPT_add_loop(struct OPTLoopContext *context, int header, int latch);
+void OPT_free_loops(struct OPTLoopContext *context);
+void OPT_count_definitions(struct OPTLoopContext *context);
+int OPT_get_constant(struct OPTLoopContext *context, int reg, long long *value);
+int OPT_find_definition(struct OPTLoopContext *context, int block, size_t end, int reg);
+int OPT_is_loop_block(struct OPTLoop *loop, int block);
+int OPT_is_induction_type(enum VarType type);
+size_t OPT_count_loop_instructions(struct OPTLoopContext *context, struct OPTLoop *loop);
+void OPT_insert(struct OPTLoopContext *context, int block, size_t position, struct IRInstruction instruction);
+void OPT_apply_insertions(struct OPTLoopContext *context);
+int OPT_compare_insertions(const void *first, const void *second);
+struct IRInstruction OPT_create_instruction(enum IROpcode opcode, enum VarType type, int dest, int a, int b, size_t line);
+
+/**
+ * <p>
+ * Optimizes the loops of all functions.
+ * </p>
+ * 
+ * <p>
+ * The constants have to be folded before, so the bounds of counted
+ * loops and the constant operands are known. The unrolled loops leave
+ * moves and unused compares behind, they are removed by the cleanup of
+ * the optimizer.
+ * </p>
+ * 
+ * @returns The number of hoisted instructions, reduced multiplications, unrolled loops and string builders
+ * 
+ * @param *module   Module to optimize
+ */
+size_t OPT_optimize_loops(struct IRModule *module) {
+	size_t optimized = 0;
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		struct OPTLoopContext context;
+		(void)memset(&context, 0, sizeof(struct OPTLoopContext));
+		context.module = module;
+		context.function = module->functions[i];
+		optimized += OPT_optimize_function_loops(&context);
+		(void)free(context.insertions);
+	}
+
+	return optimized;
+}
+
+/*
+Purpose: Run the loop transformations on a single function
+Return Type: size_t => Number of changes
+Params: struct OPTLoopContext *context => Context of the function
+*/
+size_t OPT_optimize_function_loops(struct OPTLoopContext *context) {
+	size_t optimized = OPT_hoist_invariants(context);
+	optimized += OPT_reduce_strength(context);
+	optimized += OPT_unroll_loops(context);
+	optimized += OPT_build_strings(context);
+	return optimized;
+}
+
+/**
+ * <p>
+ * Moves the instructions, whose operands aren't written in the loop,
+ * into the preheader.
+ * </p>
+ * 
+ * <p>
+ * An instruction is hoisted, if it is pure and can't fail (so it may
+ * run even if the loop doesn't), if it is the only definition of its
+ * register in the loop and if the register isn't live at the header
+ * (so no path reads an older value). Loads of globals are only hoisted
+ * out of loops without calls and stores of the global. The hoisted
+ * instructions make their users invariant, so the loops are visited
+ * again until nothing changes.
+ * </p>
+ * 
+ * @returns The number of hoisted instructions
+ * 
+ * @param *context  Context of the function
+ */
+size_t OPT_hoist_invariants(struct OPTLoopContext *context) {
+	struct IRFunction *function = context->function;
+	size_t hoisted = 0;
+
+	for (int round = 0; round < OPT_LOOP_LIMIT; round++) {
+		(void)OPT_find_loops(context);
+
+		if (context->loopCount == 0) {
+			(void)OPT_free_loops(context);
+			break;
+		}
+
+		size_t words = function->registerCount / 64 + 1;
+		uint64_t *liveIn = (uint64_t*)calloc(function->blockCount * words + 1, sizeof(uint64_t));
+		uint64_t *liveOut = (uint64_t*)calloc(function->blockCount * words + 1, sizeof(uint64_t));
+		int *definitions = (int*)calloc(function->registerCount + 1, sizeof(int));
+
+		if (liveIn == NULL || liveOut == NULL || definitions == NULL) {
+			(void)free(liveIn);
+			(void)free(liveOut);
+			(void)free(definitions);
+			(void)OPT_free_loops(context);
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			return hoisted;
+		}
+
+		(void)OPT_compute_liveness(function, liveIn, liveOut, words);
+		size_t count = 0;
+
+		for (size_t i = 0; i < context->loopCount; i++) {
+			if (context->loops[i].preheader >= 0) {
+				count += OPT_hoist_loop(context, &context->loops[i], &liveIn[context->loops[i].header * words], definitions);
+			}
+		}
+
+		(void)OPT_apply_insertions(context);
+		(void)free(liveIn);
+		(void)free(liveOut);
+		(void)free(definitions);
+		(void)OPT_free_loops(context);
+		hoisted += count;
+
+		if (count == 0) {
+			break;
+		}
+	}
+
+	return hoisted;
+}
+
+/*
+Purpose: Hoist the invariant instructions of a loop into its preheader
+Return Type: size_t => Number of hoisted instructions
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop to optimize;
+		uint64_t *liveIn => Registers, that are live at the header;
+		int *definitions => Storage for the number of definitions per register in the loop
+*/
+size_t OPT_hoist_loop(struct OPTLoopContext *context, struct OPTLoop *loop, uint64_t *liveIn, int *definitions) {
+	struct IRFunction *function = context->function;
+	int *stored = (int*)calloc(context->module->globalCount + 1, sizeof(int));
+	size_t terminator = function->blocks[loop->preheader].firstInstruction + function->blocks[loop->preheader].instructionCount - 1;
+	size_t hoisted = 0;
+	int hasCall = false;
+	int changed = true;
+
+	if (stored == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	(void)memset(definitions, 0, function->registerCount * sizeof(int));
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		if ((int)OPT_is_loop_block(loop, (int)i) == false) {
+			continue;
+		}
+
+		for (size_t n = 0; n < function->blocks[i].instructionCount; n++) {
+			struct IRInstruction *instruction = &function->instructions[function->blocks[i].firstInstruction + n];
+			int definition = (int)OPT_get_defined_register(instruction);
+
+			if (definition >= 0) {
+				definitions[definition]++;
+			}
+
+			if (instruction->opcode == IR_CALL || instruction->opcode == IR_CALL_VIRTUAL) {
+				hasCall = true;
+			} else if (instruction->opcode == IR_STORE_GLOBAL) {
+				stored[instruction->a] = true;
+			}
+		}
+	}
+
+	//Instructions of inner loops, that are already hoisted into their preheader, stay in this loop
+	for (size_t i = 0; i < context->insertionCount; i++) {
+		int definition = (int)OPT_get_defined_register(&context->insertions[i].instruction);
+
+		if (definition >= 0 && (int)OPT_is_loop_block(loop, context->insertions[i].block) == true) {
+			definitions[definition]++;
+		}
+	}
+
+	while (changed == true) {
+		changed = false;
+
+		for (size_t i = 0; i < function->blockCount; i++) {
+			if ((int)OPT_is_loop_block(loop, (int)i) == false) {
+				continue;
+			}
+
+			for (size_t n = 0; n < function->blocks[i].instructionCount; n++) {
+				struct IRInstruction *instruction = &function->instructions[function->blocks[i].firstInstruction + n];
+
+				if ((int)OPT_is_invariant(context, loop, instruction, definitions, liveIn, stored, hasCall) == false) {
+					continue;
+				}
+
+				(void)OPT_insert(context, loop->preheader, terminator, *instruction);
+				definitions[instruction->dest]--;
+				instruction->opcode = IR_NOP;
+				instruction->dest = IR_NO_REGISTER;
+				instruction->a = IR_NO_REGISTER;
+				instruction->b = IR_NO_REGISTER;
+				instruction->c = IR_NO_REGISTER;
+				hoisted++;
+				changed = true;
+			}
+		}
+	}
+
+	(void)free(stored);
+	return hoisted;
+}
+
+/*
+Purpose: Check if an instruction of a loop computes the same value in every iteration
+Return Type: int => true if the instruction can be hoisted, else false
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop of the instruction;
+		struct IRInstruction *instruction => Instruction to check;
+		int *definitions => Number of definitions per register in the loop;
+		uint64_t *liveIn => Registers, that are live at the header;
+		int *stored => Globals, that are stored in the loop;
+		int hasCall => true if the loop calls a function
+*/
+int OPT_is_invariant(struct OPTLoopContext *context, struct OPTLoop *loop, struct IRInstruction *instruction, int *definitions, uint64_t *liveIn, int *stored, int hasCall) {
+	int dest = instruction->dest;
+	int buffer[3];
+	int *uses = NULL;
+
+	if ((int)OPT_is_pure(instruction) == false || (int)IR_can_raise(instruction) == true || dest < 0 || definitions[dest] != 1
+		|| (liveIn[dest / 64] & ((uint64_t)1 << (dest % 64))) != 0) {
+		return false;
+	} else if (instruction->opcode == IR_LOAD_GLOBAL && (hasCall == true || stored[instruction->a] == true)) {
+		return false;
+	}
+
+	int useCount = (int)OPT_get_uses(context->function, instruction, &uses, buffer);
+
+	for (int i = 0; i < useCount; i++) {
+		if (definitions[uses[i]] > 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Replaces the multiplications of an induction variable with a
+ * constant by an addition.
+ * </p>
+ * 
+ * <p>
+ * For {@code t = i * k} a new register {@code r = i * k} is computed in
+ * the preheader and {@code r = r + step * k} is added after every
+ * increment of {@code i}, so {@code r} always holds the product. The
+ * multiplication becomes a move of {@code r}, the following reads of
+ * {@code t} in its block read {@code r} directly. All integral values
+ * wrap around with 64 bits, so the sums are always equal to the
+ * products.
+ * </p>
+ * 
+ * @returns The number of replaced multiplications
+ * 
+ * @param *context  Context of the function
+ */
+size_t OPT_reduce_strength(struct OPTLoopContext *context) {
+	size_t reduced = 0;
+
+	for (int round = 0; round < OPT_LOOP_LIMIT; round++) {
+		size_t count = 0;
+		(void)OPT_find_loops(context);
+		(void)OPT_count_definitions(context);
+
+		//The registers change with every loop, so only one loop is reduced at once
+		for (size_t i = 0; i < context->loopCount && count == 0; i++) {
+			if (context->loops[i].preheader >= 0) {
+				count = OPT_reduce_loop(context, &context->loops[i]);
+			}
+		}
+
+		(void)OPT_apply_insertions(context);
+		(void)OPT_free_loops(context);
+		reduced += count;
+
+		if (count == 0) {
+			break;
+		}
+	}
+
+	return reduced;
+}
+
+/*
+Purpose: Replace the multiplications of the induction variables of a loop
+Return Type: size_t => Number of replaced multiplications
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop to optimize
+*/
+size_t OPT_reduce_loop(struct OPTLoopContext *context, struct OPTLoop *loop) {
+	struct IRFunction *function = context->function;
+	size_t terminator = function->blocks[loop->preheader].firstInstruction + function->blocks[loop->preheader].instructionCount - 1;
+	size_t reduced = 0;
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		if ((int)OPT_is_loop_block(loop, (int)i) == false) {
+			continue;
+		}
+
+		for (size_t n = 0; n < function->blocks[i].instructionCount; n++) {
+			size_t index = function->blocks[i].firstInstruction + n;
+			struct IRInstruction *instruction = &function->instructions[index];
+			struct OPTInductionVariable variable;
+			long long factor = 0;
+
+			if (instruction->opcode != IR_MUL || (int)OPT_is_induction_type(instruction->type) == false) {
+				continue;
+			}
+
+			int reg = instruction->a;
+			int other = instruction->b;
+
+			if ((int)OPT_get_constant(context, other, &factor) == false) {
+				reg = instruction->b;
+				other = instruction->a;
+
+				if ((int)OPT_get_constant(context, other, &factor) == false) {
+					continue;
+				}
+			}
+
+			if (function->registers[reg].type != instruction->type || instruction->dest == reg
+				|| (int)OPT_get_induction_variable(context, loop, reg, &variable) == false) {
+				continue;
+			}
+
+			int product = IR_add_register(function, instruction->type, NULL);
+			int constant = IR_add_register(function, instruction->type, NULL);
+			size_t line = instruction->line;
+			struct IRInstruction value = OPT_create_instruction(IR_CONST_INT, instruction->type, constant, IR_NO_REGISTER, IR_NO_REGISTER, line);
+			value.value.integer = factor;
+			(void)OPT_insert(context, loop->preheader, terminator, value);
+			(void)OPT_insert(context, loop->preheader, terminator, OPT_create_instruction(IR_MUL, instruction->type, product, reg, constant, line));
+
+			//Every increment adds its step times the factor
+			for (size_t m = 0; m < function->blockCount; m++) {
+				if ((int)OPT_is_loop_block(loop, (int)m) == false) {
+					continue;
+				}
+
+				for (size_t k = 0; k < function->blocks[m].instructionCount; k++) {
+					size_t position = function->blocks[m].firstInstruction + k;
+					long long step = 0;
+
+					if (function->instructions[position].dest != reg || (int)OPT_get_increment(context, position, reg, &step) == false) {
+						continue;
+					}
+
+					int increment = IR_add_register(function, instruction->type, NULL);
+					value = OPT_create_instruction(IR_CONST_INT, instruction->type, increment, IR_NO_REGISTER, IR_NO_REGISTER, line);
+					value.value.integer = OPT_wrap_integer(instruction->type, (long long)((unsigned long long)step * (unsigned long long)factor));
+					(void)OPT_insert(context, loop->preheader, terminator, value);
+					(void)OPT_insert(context, (int)m, position + 1, OPT_create_instruction(IR_ADD, instruction->type, product, product, increment, line));
+				}
+			}
+
+			instruction->opcode = IR_MOVE;
+			instruction->a = product;
+			instruction->b = IR_NO_REGISTER;
+			(void)OPT_replace_uses_in_block(context, index, instruction->dest, product, reg);
+			reduced++;
+		}
+	}
+
+	return reduced;
+}
+
+/*
+Purpose: Replace the reads of a register after an instruction in its block, until one of the registers is written
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function;
+		size_t index => Position of the instruction, that copies {@code to} into {@code from};
+		int from => Register, whose reads are replaced;
+		int to => Register, that is read instead;
+		int variable => Induction variable ({@code to} is changed after its increments)
+*/
+void OPT_replace_uses_in_block(struct OPTLoopContext *context, size_t index, int from, int to, int variable) {
+	struct IRFunction *function = context->function;
+
+	for (size_t i = index + 1; i < function->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+
+		switch (instruction->opcode) {
+		case IR_MOVE:
+		case IR_NEG:
+		case IR_NOT:
+		case IR_CONVERT:
+		case IR_CHECK_NULL:
+		case IR_BRANCH:
+		case IR_SWITCH:
+		case IR_RETURN:
+			instruction->a = instruction->a == from ? to : instruction->a;
+			break;
+		case IR_STORE_GLOBAL:
+			instruction->b = instruction->b == from ? to : instruction->b;
+			break;
+		case IR_LOAD_FIELD:
+		case IR_STORE_FIELD:
+		case IR_LOAD_ELEMENT:
+		case IR_STORE_ELEMENT:
+			instruction->a = instruction->a == from ? to : instruction->a;
+			instruction->b = instruction->b == from && instruction->opcode != IR_LOAD_FIELD && instruction->opcode != IR_STORE_FIELD ? to : instruction->b;
+			instruction->c = instruction->c == from && (instruction->opcode == IR_STORE_FIELD || instruction->opcode == IR_STORE_ELEMENT) ? to : instruction->c;
+			break;
+		case IR_CALL:
+		case IR_NEW_ARRAY:
+		case IR_CALL_VIRTUAL:
+			for (int n = 0; n < instruction->c; n++) {
+				int *argument = &function->arguments[instruction->b + n];
+				*argument = *argument == from ? to : *argument;
+			}
+
+			break;
+		default:
+			if (instruction->opcode >= IR_ADD && instruction->opcode <= IR_GE) {
+				instruction->a = instruction->a == from ? to : instruction->a;
+				instruction->b = instruction->b == from ? to : instruction->b;
+			}
+
+			break;
+		}
+
+		int definition = (int)OPT_get_defined_register(instruction);
+
+		if ((int)IR_is_terminator(instruction->opcode) == true || definition == from
+			|| definition == to || definition == variable) {
+			return;
+		}
+	}
+}
+
+/*
+Purpose: Check if a register is only changed by adding constants in a loop
+Return Type: int => true if the register is an induction variable, else false
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop to check;
+		int reg => Register to check;
+		struct OPTInductionVariable *variable => Receives the definitions and the step per iteration
+*/
+int OPT_get_induction_variable(struct OPTLoopContext *context, struct OPTLoop *loop, int reg, struct OPTInductionVariable *variable) {
+	struct IRFunction *function = context->function;
+	variable->reg = reg;
+	variable->definitions = 0;
+	variable->step = 0;
+
+	if (reg < 0 || (int)OPT_is_induction_type(function->registers[reg].type) == false) {
+		return false;
+	}
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		if ((int)OPT_is_loop_block(loop, (int)i) == false) {
+			continue;
+		}
+
+		for (size_t n = 0; n < function->blocks[i].instructionCount; n++) {
+			size_t index = function->blocks[i].firstInstruction + n;
+			long long step = 0;
+
+			if ((int)OPT_get_defined_register(&function->instructions[index]) != reg) {
+				continue;
+			} else if ((int)OPT_get_increment(context, index, reg, &step) == false) {
+				return false;
+			}
+
+			variable->definitions++;
+			variable->step = (long long)((unsigned long long)variable->step + (unsigned long long)step);
+		}
+	}
+
+	return variable->definitions > 0 ? true : false;
+}
+
+/*
+Purpose: Check if an instruction adds a constant to a register ("r = add r, c" or "t = add r, c; r = move t")
+Return Type: int => true if the instruction is an increment, else false
+Params: struct OPTLoopContext *context => Context of the function;
+		size_t index => Position of the instruction, that writes the register;
+		int reg => Register, that is incremented;
+		long long *step => Receives the added value
+*/
+int OPT_get_increment(struct OPTLoopContext *context, size_t index, int reg, long long *step) {
+	struct IRFunction *function = context->function;
+	struct IRInstruction *instruction = &function->instructions[index];
+
+	//The generator writes variables by a move of the computed value
+	if (instruction->opcode == IR_MOVE && index > 0 && instruction->dest == reg) {
+		struct IRInstruction *previous = &function->instructions[index - 1];
+
+		if (previous->dest != instruction->a || (size_t)instruction->a >= context->definitionCount || context->definitions[instruction->a] != 1
+			|| (int)IR_is_terminator(previous->opcode) == true) {
+			return false;
+		}
+
+		instruction = previous;
+	}
+
+	if ((instruction->opcode != IR_ADD && instruction->opcode != IR_SUB)
+		|| instruction->a != reg || instruction->type != function->registers[reg].type
+		|| (int)OPT_get_constant(context, instruction->b, step) == false) {
+		return false;
+	}
+
+	if (instruction->opcode == IR_SUB) {
+		*step = (long long)(0 - (unsigned long long)*step);
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Unrolls the innermost counted loops.
+ * </p>
+ * 
+ * <p>
+ * A loop is counted, if its header branches on the compare of an
+ * induction variable with a constant bound, the variable has a constant
+ * value before the loop and a single increment in the latch. The number
+ * of iterations is computed, loops with up to OPT_UNROLL_FULL_TRIPS
+ * iterations are copied completely, the others are copied 8, 4 or 2
+ * times, if this divides the number of iterations. The copies jump into
+ * each other, only the header of the first copy keeps its condition.
+ * </p>
+ * 
+ * @returns The number of unrolled loops
+ * 
+ * @param *context  Context of the function
+ */
+size_t OPT_unroll_loops(struct OPTLoopContext *context) {
+	size_t unrolled = 0;
+
+	for (int round = 0; round < OPT_LOOP_LIMIT; round++) {
+		int changed = false;
+		(void)OPT_find_loops(context);
+		(void)OPT_count_definitions(context);
+
+		for (size_t i = 0; i < context->loopCount && changed == false; i++) {
+			changed = OPT_unroll_loop(context, &context->loops[i]);
+		}
+
+		(void)OPT_free_loops(context);
+
+		if (changed == false) {
+			break;
+		}
+
+		unrolled++;
+	}
+
+	return unrolled;
+}
+
+/*
+Purpose: Unroll a single loop, if it is an innermost counted loop, that is small enough
+Return Type: int => true if the loop was unrolled, else false
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop to unroll
+*/
+int OPT_unroll_loop(struct OPTLoopContext *context, struct OPTLoop *loop) {
+	struct IRFunction *function = context->function;
+	long long trips = 0;
+	int inside = 0;
+	int outside = 0;
+	int factor = 0;
+
+	//Only innermost loops are unrolled, the copies of inner loops would be unrolled again
+	for (size_t i = 0; i < context->loopCount; i++) {
+		if (context->loops[i].header != loop->header && (int)OPT_is_loop_block(loop, context->loops[i].header) == true) {
+			return false;
+		}
+	}
+
+	if ((int)OPT_get_trip_count(context, loop, &inside, &outside, &trips) == false || trips < 2) {
+		return false;
+	}
+
+	size_t size = OPT_count_loop_instructions(context, loop);
+
+	if (trips <= OPT_UNROLL_FULL_TRIPS && (size_t)trips * size <= OPT_UNROLL_BUDGET) {
+		factor = (int)trips;
+	} else {
+		for (int candidate = 8; candidate >= 2 && factor == 0; candidate /= 2) {
+			if (trips % candidate == 0 && (size_t)candidate * size <= OPT_UNROLL_BUDGET) {
+				factor = candidate;
+			}
+		}
+	}
+
+	if (factor == 0) {
+		return false;
+	}
+
+	//After all iterations the last copy can leave the loop directly, if the header only computes its condition
+	int exitEarly = factor == trips ? true : false;
+	struct IRBlock *header = &function->blocks[loop->header];
+	size_t words = function->registerCount / 64 + 1;
+	uint64_t *liveIn = (uint64_t*)calloc(function->blockCount * words + 1, sizeof(uint64_t));
+	uint64_t *liveOut = (uint64_t*)calloc(function->blockCount * words + 1, sizeof(uint64_t));
+
+	if (liveIn == NULL || liveOut == NULL) {
+		(void)free(liveIn);
+		(void)free(liveOut);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return false;
+	}
+
+	(void)OPT_compute_liveness(function, liveIn, liveOut, words);
+
+	for (size_t i = 0; exitEarly == true && i + 1 < header->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[header->firstInstruction + i];
+		int definition = (int)OPT_get_defined_register(instruction);
+
+		if ((int)OPT_is_pure(instruction) == false || (definition >= 0
+			&& (liveIn[outside * words + definition / 64] & ((uint64_t)1 << (definition % 64))) != 0)) {
+			exitEarly = false;
+		}
+	}
+
+	(void)free(liveIn);
+	(void)free(liveOut);
+	(void)OPT_copy_loop(context, loop, factor, inside, outside, exitEarly);
+	return true;
+}
+
+/*
+Purpose: Compute the number of iterations of a counted loop
+Return Type: int => true if the loop is counted, else false
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop to check;
+		int *inside => Receives the target of the header, that stays in the loop;
+		int *outside => Receives the target of the header, that leaves the loop;
+		long long *trips => Receives the number of iterations
+*/
+int OPT_get_trip_count(struct OPTLoopContext *context, struct OPTLoop *loop, int *inside, int *outside, long long *trips) {
+	struct IRFunction *function = context->function;
+
+	if (loop->preheader < 0 || loop->latch < 0 || loop->latch == loop->header) {
+		return false;
+	}
+
+	struct IRBlock *header = &function->blocks[loop->header];
+	struct IRInstruction *branch = &function->instructions[header->firstInstruction + header->instructionCount - 1];
+
+	if (branch->opcode != IR_BRANCH || (int)OPT_is_loop_block(loop, branch->b) == false
+		|| (int)OPT_is_loop_block(loop, branch->c) == true) {
+		return false;
+	}
+
+	int position = (int)OPT_find_definition(context, loop->header, header->instructionCount - 1, branch->a);
+
+	if (position < 0) {
+		return false;
+	}
+
+	struct IRInstruction *compare = &function->instructions[position];
+	enum IROpcode opcode = compare->opcode;
+	int reg = compare->a;
+	long long bound = 0;
+
+	if (opcode < IR_EQ || opcode > IR_GE) {
+		return false;
+	} else if ((int)OPT_get_constant(context, compare->b, &bound) == false) {
+		//"bound < i" is checked as "i > bound"
+		reg = compare->b;
+		opcode = opcode == IR_LT ? IR_GT : opcode == IR_GT ? IR_LT : opcode == IR_LE ? IR_GE : opcode == IR_GE ? IR_LE : opcode;
+
+		if ((int)OPT_get_constant(context, compare->a, &bound) == false) {
+			return false;
+		}
+	}
+
+	struct OPTInductionVariable variable;
+	long long start = 0;
+
+	if ((int)OPT_get_induction_variable(context, loop, reg, &variable) == false || variable.definitions != 1
+		|| variable.step == 0) {
+		return false;
+	}
+
+	//The increment has to be in the latch, so every iteration runs it exactly once
+	struct IRBlock *latch = &function->blocks[loop->latch];
+
+	struct IRInstruction *back = &function->instructions[latch->firstInstruction + latch->instructionCount - 1];
+
+	if (back->opcode != IR_JUMP || OPT_find_definition(context, loop->latch, latch->instructionCount, reg) < 0) {
+		return false;
+	}
+
+	struct IRBlock *preheader = &function->blocks[loop->preheader];
+	position = (int)OPT_find_definition(context, loop->preheader, preheader->instructionCount, reg);
+
+	if (position < 0 || function->instructions[position].opcode != IR_CONST_INT) {
+		return false;
+	}
+
+	start = function->instructions[position].value.integer;
+	*trips = 0;
+
+	while (*trips <= OPT_UNROLL_TRIP_LIMIT) {
+		int condition = false;
+
+		switch (opcode) {
+		case IR_EQ:
+			condition = start == bound;
+			break;
+		case IR_NE:
+			condition = start != bound;
+			break;
+		case IR_LT:
+			condition = start < bound;
+			break;
+		case IR_LE:
+			condition = start <= bound;
+			break;
+		case IR_GT:
+			condition = start > bound;
+			break;
+		default:
+			condition = start >= bound;
+			break;
+		}
+
+		if (condition == false) {
+			*inside = branch->b;
+			*outside = branch->c;
+			return true;
+		}
+
+		start = OPT_wrap_integer(function->registers[reg].type, (long long)((unsigned long long)start + (unsigned long long)variable.step));
+		(*trips)++;
+	}
+
+	return false;
+}
+
+/*
+Purpose: Emit the function again with the blocks of the loop copied
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function;
+		struct OPTLoop *loop => Loop to unroll;
+		int factor => Number of copies (including the loop itself);
+		int inside => Target of the header, that stays in the loop;
+		int outside => Target of the header, that leaves the loop;
+		int exitEarly => true if the last copy leaves the loop instead of jumping to the header
+*/
+void OPT_copy_loop(struct OPTLoopContext *context, struct OPTLoop *loop, int factor, int inside, int outside, int exitEarly) {
+	struct IRFunction *function = context->function;
+	size_t instructionCount = function->instructionCount;
+	size_t blockCount = function->blockCount;
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((instructionCount + 1) * sizeof(struct IRInstruction));
+	struct IRBlock *blocks = (struct IRBlock*)malloc((blockCount + 1) * sizeof(struct IRBlock));
+	int *copies = (int*)malloc((blockCount * factor + 1) * sizeof(int));
+
+	if (instructions == NULL || blocks == NULL || copies == NULL) {
+		(void)free(instructions);
+		(void)free(blocks);
+		(void)free(copies);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	(void)memcpy(instructions, function->instructions, instructionCount * sizeof(struct IRInstruction));
+	(void)memcpy(blocks, function->blocks, blockCount * sizeof(struct IRBlock));
+
+	//copies[k * blockCount + b] is the block of the k-th copy of the block b
+	for (int k = 0; k < factor; k++) {
+		for (size_t i = 0; i < blockCount; i++) {
+			copies[k * blockCount + i] = k == 0 || (int)OPT_is_loop_block(loop, (int)i) == false ? (int)i : IR_add_block(function);
+		}
+	}
+
+	function->instructionCount = 0;
+	function->currentBlock = -1;
+
+	for (int k = 0; k < factor; k++) {
+		for (size_t i = 0; i < blockCount; i++) {
+			int *map = &copies[k * blockCount];
+
+			if (k > 0 && (int)OPT_is_loop_block(loop, (int)i) == false) {
+				continue;
+			}
+
+			//A landing pad in the loop is copied as well
+			function->handler = blocks[i].handler >= 0 ? map[blocks[i].handler] : -1;
+			(void)IR_start_block(function, copies[k * blockCount + i]);
+
+			for (size_t n = 0; n < blocks[i].instructionCount; n++) {
+				struct IRInstruction instruction = instructions[blocks[i].firstInstruction + n];
+
+				//The other instructions of the loop are copied unchanged, all copies share the registers
+				if (instruction.opcode == IR_JUMP && (int)i == loop->latch && instruction.a == loop->header) {
+					instruction.a = k + 1 < factor ? copies[(k + 1) * blockCount + loop->header] : exitEarly == true ? outside : loop->header;
+				} else if (instruction.opcode == IR_JUMP && (int)OPT_is_loop_block(loop, (int)i) == true) {
+					instruction.a = map[instruction.a];
+				} else if (instruction.opcode == IR_BRANCH && k > 0 && (int)i == loop->header) {
+					instruction.opcode = IR_JUMP;
+					instruction.a = map[inside];
+					instruction.b = IR_NO_REGISTER;
+					instruction.c = IR_NO_REGISTER;
+				} else if (instruction.opcode == IR_BRANCH && (int)OPT_is_loop_block(loop, (int)i) == true) {
+					instruction.b = map[instruction.b];
+					instruction.c = map[instruction.c];
+				} else if (instruction.opcode == IR_SWITCH && k > 0) {
+					instruction.b = (int)OPT_copy_cases(function, function, &instruction, map);
+				}
+
+				struct IRInstruction *copy = IR_emit(function, instruction.opcode, instruction.type, instruction.dest, instruction.a, instruction.b, instruction.c, instruction.line);
+
+				if (copy != NULL) {
+					copy->value = instruction.value;
+					copy->origin = instruction.origin;
+				}
+			}
+		}
+	}
+
+	function->handler = -1;
+	(void)free(instructions);
+	(void)free(blocks);
+	(void)free(copies);
+	(void)IR_finish_function(function);
+	(void)OPT_compact_function(function);
+}
+
+/**
+ * <p>
+ * Replaces the concatenations of strings, that are built in a loop,
+ * by appends to a builder.
+ * </p>
+ * 
+ * <p>
+ * Every {@code s = s + x} copies the whole string, so building a string
+ * of n pieces takes quadratic time. A string variable, that is only
+ * read and written by such concatenations in a loop, gets a builder in
+ * the preheader (a copy of its value, see IR_BUILDER) and the
+ * concatenations append to it in place. No other register can hold the
+ * builder, while it's changed, since the variable isn't read by anything
+ * else in the loop. The outer loops are visited first, so a string, that
+ * is built by nested loops, gets a single builder.
+ * </p>
+ * 
+ * @returns The number of created builders
+ * 
+ * @param *context  Context of the function
+ */
+size_t OPT_build_strings(struct OPTLoopContext *context) {
+	size_t built = 0;
+	(void)OPT_find_loops(context);
+	(void)OPT_count_definitions(context);
+
+	int *visited = (int*)calloc(context->loopCount + 1, sizeof(int));
+
+	if (visited == NULL) {
+		(void)OPT_free_loops(context);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	//An outer loop holds all instructions of its inner loops
+	for (size_t round = 0; round < context->loopCount; round++) {
+		size_t largest = 0;
+		size_t size = 0;
+
+		for (size_t i = 0; i < context->loopCount; i++) {
+			size_t count = OPT_count_loop_instructions(context, &context->loops[i]);
+
+			if (visited[i] == false && count >= size) {
+				largest = i;
+				size = count;
+			}
+		}
+
+		visited[largest] = true;
+
+		if (context->loops[largest].preheader >= 0) {
+			built += OPT_build_loop_strings(context, &context->loops[largest]);
+		}
+	}
+
+	(void)OPT_apply_insertions(context);
+	(void)OPT_free_loops(context);
+	(void)free(visited);
+	return built;
+}
+
+/*
+Purpose: Give the strings, that are built by a loop, a builder and append to it
+Return Type: size_t => Number of created builders
+Params: struct OPTLoopContext *context => Context of the function (with the counted definitions);
+		struct OPTLoop *loop => Loop to optimize
+*/
+size_t OPT_build_loop_strings(struct OPTLoopContext *context, struct OPTLoop *loop) {
+	struct IRFunction *function = context->function;
+	size_t terminator = function->blocks[loop->preheader].firstInstruction + function->blocks[loop->preheader].instructionCount - 1;
+	size_t built = 0;
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		if ((int)OPT_is_loop_block(loop, (int)i) == false) {
+			continue;
+		}
+
+		size_t end = function->blocks[i].firstInstruction + function->blocks[i].instructionCount;
+
+		for (size_t index = function->blocks[i].firstInstruction; index < end; index++) {
+			int reg = function->instructions[index].a;
+
+			if ((int)OPT_is_string_update(context, index, end, reg) == false || (int)OPT_is_built_string(context, loop, reg) == false) {
+				continue;
+			}
+
+			//All updates of the variable in the loop append to the builder
+			for (size_t m = 0; m < function->blockCount; m++) {
+				size_t blockEnd = function->blocks[m].firstInstruction + function->blocks[m].instructionCount;
+
+				for (size_t k = function->blocks[m].firstInstruction; (int)OPT_is_loop_block(loop, (int)m) == true && k < blockEnd; k++) {
+					struct IRInstruction *update = &function->instructions[k];
+
+					if ((int)OPT_is_string_update(context, k, blockEnd, reg) == false) {
+						continue;
+					} else if (update->dest != reg) {
+						struct IRInstruction *move = &function->instructions[k + 1];
+						move->opcode = IR_NOP;
+						move->dest = IR_NO_REGISTER;
+						move->a = IR_NO_REGISTER;
+						move->b = IR_NO_REGISTER;
+						move->c = IR_NO_REGISTER;
+					}
+
+					update->opcode = IR_APPEND;
+					update->dest = reg;
+				}
+			}
+
+			(void)OPT_insert(context, loop->preheader, terminator, OPT_create_instruction(IR_BUILDER, STRING, reg, reg, IR_NO_REGISTER, function->instructions[index].line));
+			built++;
+		}
+	}
+
+	return built;
+}
+
+/*
+Purpose: Check if a string variable is only read and written by concatenations to itself (or appends) in a loop
+Return Type: int => true if the variable can be a builder in the loop, else false
+Params: struct OPTLoopContext *context => Context of the function (with the counted definitions);
+		struct OPTLoop *loop => Loop to check;
+		int reg => Register of the variable
+*/
+int OPT_is_built_string(struct OPTLoopContext *context, struct OPTLoop *loop, int reg) {
+	struct IRFunction *function = context->function;
+	int buffer[3];
+	int *uses = NULL;
+
+	if (reg < 0 || function->registers[reg].type != STRING) {
+		return false;
+	}
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		if ((int)OPT_is_loop_block(loop, (int)i) == false) {
+			continue;
+		}
+
+		size_t start = function->blocks[i].firstInstruction;
+		size_t end = start + function->blocks[i].instructionCount;
+
+		for (size_t index = start; index < end; index++) {
+			struct IRInstruction *instruction = &function->instructions[index];
+			int useCount = (int)OPT_get_uses(function, instruction, &uses, buffer);
+			int update = (int)OPT_is_string_update(context, index, end, reg);
+			int append = instruction->opcode == IR_APPEND && instruction->dest == reg && instruction->b != reg ? true : false;
+
+			//The move of "t = concat s, x; s = move t" belongs to the update
+			if (index > start && (int)OPT_is_string_update(context, index - 1, end, reg) == true && instruction->opcode == IR_MOVE) {
+				continue;
+			} else if (update == true || append == true) {
+				continue;
+			} else if ((int)OPT_get_defined_register(instruction) == reg) {
+				return false;
+			}
+
+			for (int n = 0; n < useCount; n++) {
+				if (uses[n] == reg) {
+					return false;
+				}
+			}
+		}
+	}
+
+	//Builders of inner loops, that aren't inserted yet, would read the variable
+	for (size_t i = 0; i < context->insertionCount; i++) {
+		struct IRInstruction *instruction = &context->insertions[i].instruction;
+
+		if ((int)OPT_is_loop_block(loop, context->insertions[i].block) == true && (instruction->a == reg || instruction->dest == reg)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Check if an instruction appends to a string variable ("s = concat s, x" or "t = concat s, x; s = move t")
+Return Type: int => true if the instruction is an update of the variable, else false
+Params: struct OPTLoopContext *context => Context of the function (with the counted definitions);
+		size_t index => Position of the concatenation;
+		size_t end => End of the block of the instruction;
+		int reg => Register of the variable
+*/
+int OPT_is_string_update(struct OPTLoopContext *context, size_t index, size_t end, int reg) {
+	struct IRFunction *function = context->function;
+	struct IRInstruction *instruction = &function->instructions[index];
+
+	if (instruction->opcode != IR_CONCAT || reg < 0 || instruction->a != reg || instruction->b == reg) {
+		return false;
+	} else if (instruction->dest == reg) {
+		return true;
+	}
+
+	//The generator writes variables by a move of the computed value
+	int temporary = instruction->dest;
+	struct IRInstruction *move = &function->instructions[index + 1];
+
+	if (index + 1 >= end || move->opcode != IR_MOVE || move->dest != reg || move->a != temporary) {
+		return false;
+	}
+
+	return OPT_is_update_temporary(function, temporary);
+}
+
+/*
+Purpose: Check if a register is only read by moves directly behind a concatenation into it (unrolled loops copy these pairs)
+Return Type: int => true if the register is only a temporary of the concatenations, else false
+Params: struct IRFunction *function => Function of the register;
+		int reg => Register to check
+*/
+int OPT_is_update_temporary(struct IRFunction *function, int reg) {
+	int buffer[3];
+	int *uses = NULL;
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+		int useCount = (int)OPT_get_uses(function, instruction, &uses, buffer);
+
+		for (int n = 0; n < useCount; n++) {
+			//The first instruction of a block follows a terminator
+			if (uses[n] == reg && (i == 0 || instruction->opcode != IR_MOVE
+				|| function->instructions[i - 1].opcode != IR_CONCAT || function->instructions[i - 1].dest != reg)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Find the natural loops of the function (the blocks, that reach a back edge without passing its header)
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function
+*/
+void OPT_find_loops(struct OPTLoopContext *context) {
+	struct IRFunction *function = context->function;
+	size_t blockCount = function->blockCount;
+
+	context->blockWords = blockCount / 64 + 1;
+	context->loops = (struct OPTLoop*)calloc(blockCount + 1, sizeof(struct OPTLoop));
+	context->loopCount = 0;
+	context->predecessorStart = (int*)calloc(blockCount + 2, sizeof(int));
+	int *successors = (int*)malloc((blockCount + 2) * sizeof(int));
+
+	if (context->loops == NULL || context->predecessorStart == NULL || successors == NULL) {
+		(void)free(successors);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < blockCount; i++) {
+		int count = (int)OPT_get_successors(function, i, successors);
+
+		for (int n = 0; n < count; n++) {
+			context->predecessorStart[successors[n] + 1]++;
+		}
+	}
+
+	for (size_t i = 0; i < blockCount; i++) {
+		context->predecessorStart[i + 1] += context->predecessorStart[i];
+	}
+
+	int *filled = (int*)calloc(blockCount + 1, sizeof(int));
+	context->predecessors = (int*)calloc(context->predecessorStart[blockCount] + 1, sizeof(int));
+
+	if (filled == NULL || context->predecessors == NULL) {
+		(void)free(filled);
+		(void)free(successors);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < blockCount; i++) {
+		int count = (int)OPT_get_successors(function, i, successors);
+
+		for (int n = 0; n < count; n++) {
+			context->predecessors[context->predecessorStart[successors[n]] + filled[successors[n]]++] = (int)i;
+		}
+	}
+
+	(void)free(filled);
+	(void)OPT_compute_dominators(context);
+
+	for (size_t i = 0; i < blockCount; i++) {
+		int count = (int)OPT_get_successors(function, i, successors);
+		uint64_t *dominators = &context->dominators[i * context->blockWords];
+
+		for (int n = 0; n < count; n++) {
+			if ((dominators[successors[n] / 64] & ((uint64_t)1 << (successors[n] % 64))) != 0) {
+				(void)OPT_add_loop(context, successors[n], (int)i);
+			}
+		}
+	}
+
+	(void)free(successors);
+
+	for (size_t i = 0; i < context->loopCount; i++) {
+		struct OPTLoop *loop = &context->loops[i];
+		int header = loop->header;
+		loop->preheader = -1;
+
+		for (int n = context->predecessorStart[header]; n < context->predecessorStart[header + 1]; n++) {
+			int predecessor = context->predecessors[n];
+
+			if ((int)OPT_is_loop_block(loop, predecessor) == true) {
+				continue;
+			}
+
+			//A block, that only reaches the header as its landing pad, isn't a preheader
+			struct IRBlock *block = &function->blocks[predecessor];
+			struct IRInstruction *last = &function->instructions[block->firstInstruction + block->instructionCount - 1];
+			int jumps = last->opcode == IR_JUMP && last->a == header;
+			loop->preheader = loop->preheader == -1 && jumps ? predecessor : -2;
+		}
+
+		loop->preheader = loop->preheader < 0 ? -1 : loop->preheader;
+	}
+}
+
+/*
+Purpose: Compute the dominators of every block (iterative dataflow over the bitsets)
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function (with the predecessors)
+*/
+void OPT_compute_dominators(struct OPTLoopContext *context) {
+	size_t blockCount = context->function->blockCount;
+	size_t words = context->blockWords;
+	int changed = true;
+
+	context->dominators = (uint64_t*)malloc((blockCount * words + 1) * sizeof(uint64_t));
+
+	if (context->dominators == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	(void)memset(context->dominators, 0xFF, blockCount * words * sizeof(uint64_t));
+	(void)memset(context->dominators, 0, words * sizeof(uint64_t));
+	context->dominators[0] = 1;
+
+	while (changed == true) {
+		changed = false;
+
+		for (size_t i = 1; i < blockCount; i++) {
+			uint64_t *dominators = &context->dominators[i * words];
+
+			for (size_t w = 0; w < words; w++) {
+				uint64_t value = ~(uint64_t)0;
+
+				for (int n = context->predecessorStart[i]; n < context->predecessorStart[i + 1]; n++) {
+					value &= context->dominators[context->predecessors[n] * words + w];
+				}
+
+				if (w == i / 64) {
+					value |= (uint64_t)1 << (i % 64);
+				}
+
+				if (value != dominators[w]) {
+					dominators[w] = value;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+Purpose: Add the blocks of a back edge to the loop of its header
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function;
+		int header => Target of the back edge;
+		int latch => Block, that jumps back
+*/
+void OPT_add_loop(struct OPTLoopContext *context, int header, int latch) {
+	struct OPTLoop *loop = NULL;
+
+	for (size_t i = 0; i < context->loopCount; i++) {
+		if (context->loops[i].header == header) {
+			loop = &context->loops[i];
+			loop->latch = -1;
+		}
+	}
+
+	if (loop == NULL) {
+		loop = &context->loops[context->loopCount++];
+		loop->header = header;
+		loop->latch = latch;
+		loop->blocks = (uint64_t*)calloc(context->blockWords, sizeof(uint64_t));
+
+		if (loop->blocks == NULL) {
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			return;
+		}
+
+		loop->blocks[header / 64] |= (uint64_t)1 << (header % 64);
+	}
+
+	int *stack = (int*)malloc((context->function->blockCount + 1) * sizeof(int));
+	int top = 0;
+
+	if (stack == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	if ((int)OPT_is_loop_block(loop, latch) == false) {
+		loop->blocks[latch / 64] |= (uint64_t)1 << (latch % 64);
+		stack[top++] = latch;
+	}
+
+	while (top > 0) {
+		int block = stack[--top];
+
+		for (int n = context->predecessorStart[block]; n < context->predecessorStart[block + 1]; n++) {
+			int predecessor = context->predecessors[n];
+
+			if ((int)OPT_is_loop_block(loop, predecessor) == false) {
+				loop->blocks[predecessor / 64] |= (uint64_t)1 << (predecessor % 64);
+				stack[top++] = predecessor;
+			}
+		}
+	}
+
+	(void)free(stack);
+}
+
+void OPT_free_loops(struct OPTLoopContext *context) {
+	for (size_t i = 0; context->loops != NULL && i < context->loopCount; i++) {
+		(void)free(context->loops[i].blocks);
+	}
+
+	(void)free(context->loops);
+	(void)free(context->dominators);
+	(void)free(context->predecessors);
+	(void)free(context->predecessorStart);
+	(void)free(context->definitions);
+	context->loops = NULL;
+	context->loopCount = 0;
+	context->dominators = NULL;
+	context->predecessors = NULL;
+	context->predecessorStart = NULL;
+	context->definitions = NULL;
+	context->definitionCount = 0;
+}
+
+/*
+Purpose: Count the definitions of every register in the whole function
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function
+*/
+void OPT_count_definitions(struct OPTLoopContext *context) {
+	struct IRFunction *function = context->function;
+	context->definitions = (int*)calloc(function->registerCount + 1, sizeof(int));
+	context->definitionCount = function->registerCount;
+
+	if (context->definitions == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		int definition = (int)OPT_get_defined_register(&function->instructions[i]);
+
+		if (definition >= 0) {
+			context->definitions[definition]++;
+		}
+	}
+}
+
+/*
+Purpose: Get the value of a register, that is only written once by a constant
+Return Type: int => true if the value is known, else false
+Params: struct OPTLoopContext *context => Context of the function (with the counted definitions);
+		int reg => Register to check;
+		long long *value => Receives the value
+*/
+int OPT_get_constant(struct OPTLoopContext *context, int reg, long long *value) {
+	struct IRFunction *function = context->function;
+
+	if (reg < 0 || context->definitions == NULL || (size_t)reg >= context->definitionCount || context->definitions[reg] != 1) {
+		return false;
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+
+		if (instruction->opcode == IR_CONST_INT && instruction->dest == reg) {
+			*value = instruction->value.integer;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+Purpose: Find the last definition of a register in a block before a position
+Return Type: int => Index of the instruction or -1
+Params: struct OPTLoopContext *context => Context of the function;
+		int block => Block to search;
+		size_t end => Number of instructions of the block to search;
+		int reg => Register, that is written
+*/
+int OPT_find_definition(struct OPTLoopContext *context, int block, size_t end, int reg) {
+	struct IRBlock *current = &context->function->blocks[block];
+
+	for (size_t i = end; i-- > 0;) {
+		if ((int)OPT_get_defined_register(&context->function->instructions[current->firstInstruction + i]) == reg) {
+			return (int)(current->firstInstruction + i);
+		}
+	}
+
+	return -1;
+}
+
+int OPT_is_loop_block(struct OPTLoop *loop, int block) {
+	return block >= 0 && (loop->blocks[block / 64] & ((uint64_t)1 << (block % 64))) != 0 ? true : false;
+}
+
+int OPT_is_induction_type(enum VarType type) {
+	return type == INTEGER || type == LONG ? true : false;
+}
+
+size_t OPT_count_loop_instructions(struct OPTLoopContext *context, struct OPTLoop *loop) {
+	size_t count = 0;
+
+	for (size_t i = 0; i < context->function->blockCount; i++) {
+		if ((int)OPT_is_loop_block(loop, (int)i) == true) {
+			count += context->function->blocks[i].instructionCount;
+		}
+	}
+
+	return count;
+}
+
+void OPT_insert(struct OPTLoopContext *context, int block, size_t position, struct IRInstruction instruction) {
+	if (context->insertionCount >= context->insertionCapacity) {
+		size_t capacity = context->insertionCapacity == 0 ? 16 : context->insertionCapacity * 2;
+		struct OPTInsertion *insertions = (struct OPTInsertion*)realloc(context->insertions, capacity * sizeof(struct OPTInsertion));
+
+		if (insertions == NULL) {
+			(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			return;
+		}
+
+		context->insertions = insertions;
+		context->insertionCapacity = capacity;
+	}
+
+	context->insertions[context->insertionCount].block = block;
+	context->insertions[context->insertionCount].position = position;
+	context->insertions[context->insertionCount].order = context->insertionCount;
+	context->insertions[context->insertionCount].instruction = instruction;
+	context->insertionCount++;
+}
+
+/*
+Purpose: Insert the collected instructions and drop the nops (the blocks keep their order)
+Return Type: void
+Params: struct OPTLoopContext *context => Context of the function
+*/
+void OPT_apply_insertions(struct OPTLoopContext *context) {
+	struct IRFunction *function = context->function;
+	size_t count = context->insertionCount;
+
+	if (count == 0) {
+		return;
+	}
+
+	size_t capacity = function->instructionCount + count + 1;
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc(capacity * sizeof(struct IRInstruction));
+	size_t next = 0;
+	size_t index = 0;
+
+	if (instructions == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	(void)qsort(context->insertions, count, sizeof(struct OPTInsertion), OPT_compare_insertions);
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+		size_t first = index;
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			size_t position = block->firstInstruction + n;
+			struct IRInstruction *instruction = &function->instructions[position];
+
+			while (next < count && context->insertions[next].position == position) {
+				instructions[index++] = context->insertions[next++].instruction;
+			}
+
+			//The hoisted instructions are left as nop
+			if (instruction->opcode == IR_NOP) {
+				continue;
+			}
+
+			instructions[index++] = *instruction;
+		}
+
+		block->firstInstruction = first;
+		block->instructionCount = index - first;
+	}
+
+	(void)free(function->instructions);
+	function->instructions = instructions;
+	function->instructionCount = index;
+	function->instructionCapacity = capacity;
+	context->insertionCount = 0;
+}
+
+int OPT_compare_insertions(const void *first, const void *second) {
+	const struct OPTInsertion *left = (const struct OPTInsertion*)first;
+	const struct OPTInsertion *right = (const struct OPTInsertion*)second;
+
+	if (left->position != right->position) {
+		return left->position < right->position ? -1 : 1;
+	}
+
+	return left->order < right->order ? -1 : left->order > right->order ? 1 : 0;
+}
+
+struct IRInstruction OPT_create_instruction(enum IROpcode opcode, enum VarType type, int dest, int a, int b, size_t line) {
+	struct IRInstruction instruction;
+	(void)memset(&instruction, 0, sizeof(struct IRInstruction));
+	instruction.opcode = opcode;
+	instruction.type = type;
+	instruction.dest = dest;
+	instruction.a = a;
+	instruction.b = b;
+	instruction.c = IR_NO_REGISTER;
+	instruction.line = line;
+	return instruction;
+}
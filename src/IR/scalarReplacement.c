@@ -0,0 +1,524 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+
+/**
+ * The subprogram {@code SPACE/src/IR/scalarReplacement.c} was created
+ * to replace the objects, that never leave their function, by their fields.
+ *
+ * After the constructors and the small methods are inlined, many objects
+ * are only created, read and written in a single function. Such an
+ * object gets a register for every accessed field instead of the
+ * allocation: {@code new} sets the registers to the default values, the
+ * loads and stores of the fields become moves and the null checks of
+ * the object are dropped. The constants and the moves are folded by the
+ * following passes.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * An object, that is replaced by its fields.
+ * </p>
+ *
+ * <p>
+ * {@code scalars} holds the register of every byte offset of the class,
+ * that starts an accessed field (-1 for the other offsets).
+ * </p>
+ */
+struct OPTObject {
+	int classIndex;
+	int *scalars;
+};
+
+size_t OPT_replace_function_objects(struct IRModule *module, struct IRFunction *function);
+void OPT_collect_aliases(struct IRFunction *function, int reg, char *aliases);
+int OPT_is_replaceable(struct IRModule *module, struct IRFunction *function, size_t creation, char *aliases);
+int OPT_is_scalar_field(struct IRModule *module, int classIndex, struct IRInstruction *instruction);
+int OPT_is_alias_live(struct IRFunction *function, size_t block, size_t position, char *aliases, uint64_t *liveIn, uint64_t *liveOut, size_t words);
+int OPT_get_scalar(struct IRModule *module, struct IRFunction *function, struct OPTObject *object, struct IRInstruction *instruction);
+void OPT_emit_scalar_objects(struct IRModule *module, struct IRFunction *function, struct OPTObject *objects, int *owners);
+
+/**
+ * <p>
+ * Replaces the objects of all functions, that never leave their
+ * function, by their fields.
+ * </p>
+ *
+ * <p>
+ * The small functions have to be inlined before, since an object, that
+ * is passed to a call, leaves the function.
+ * </p>
+ *
+ * @returns The number of replaced objects
+ *
+ * @param *module   Module to optimize
+ */
+size_t OPT_replace_objects(struct IRModule *module) {
+	size_t replaced = 0;
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		replaced += OPT_replace_function_objects(module, module->functions[i]);
+	}
+
+	return replaced;
+}
+
+/**
+ * <p>
+ * Replaces the objects of a single function by their fields.
+ * </p>
+ *
+ * <p>
+ * The registers, that hold an object, are its register of the
+ * {@code new} and the registers, that it's moved into. An object is
+ * replaced, if these registers are only written by the {@code new} and
+ * the moves, and only read by the moves, the null checks and the
+ * accesses of its fields (a stored value mustn't be the object itself).
+ * None of them may be read before the {@code new} ran, and none but the
+ * result of the {@code new} may be read after it ran again (it would
+ * hold the object of the previous run).
+ * </p>
+ *
+ * @returns The number of replaced objects
+ *
+ * @param *module       Module of the function
+ * @param *function     Function, that creates the objects
+ */
+size_t OPT_replace_function_objects(struct IRModule *module, struct IRFunction *function) {
+	size_t instructionCount = function->instructionCount;
+	size_t registerCount = function->registerCount;
+	size_t words = registerCount / 64 + 1;
+	size_t replaced = 0;
+	int creates = false;
+
+	for (size_t i = 0; i < instructionCount && creates == false; i++) {
+		creates = function->instructions[i].opcode == IR_NEW ? true : false;
+	}
+
+	if (creates == false || function->blockCount == 0) {
+		return 0;
+	}
+
+	uint64_t *liveIn = (uint64_t*)calloc(function->blockCount * words + 1, sizeof(uint64_t));
+	uint64_t *liveOut = (uint64_t*)calloc(function->blockCount * words + 1, sizeof(uint64_t));
+	char *aliases = (char*)calloc(registerCount + 1, sizeof(char));
+	int *owners = (int*)malloc((registerCount + 1) * sizeof(int));
+	struct OPTObject *objects = (struct OPTObject*)calloc(instructionCount + 1, sizeof(struct OPTObject));
+
+	if (liveIn == NULL || liveOut == NULL || aliases == NULL || owners == NULL || objects == NULL) {
+		(void)free(liveIn);
+		(void)free(liveOut);
+		(void)free(aliases);
+		(void)free(owners);
+		(void)free(objects);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return 0;
+	}
+
+	(void)OPT_compute_liveness(function, liveIn, liveOut, words);
+
+	for (size_t i = 0; i < registerCount; i++) {
+		owners[i] = -1;
+	}
+
+	for (size_t i = 0; i < function->blockCount; i++) {
+		struct IRBlock *block = &function->blocks[i];
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			size_t index = block->firstInstruction + n;
+			struct IRInstruction *instruction = &function->instructions[index];
+
+			if (instruction->opcode != IR_NEW || owners[instruction->dest] >= 0) {
+				continue;
+			}
+
+			(void)OPT_collect_aliases(function, instruction->dest, aliases);
+
+			//The result of the new itself is overwritten by it
+			aliases[instruction->dest] = false;
+			int live = (int)OPT_is_alias_live(function, i, n + 1, aliases, liveIn, liveOut, words);
+			aliases[instruction->dest] = true;
+
+			if (live == true || (int)OPT_is_alias_live(function, 0, 0, aliases, liveIn, liveOut, words) == true
+				|| (int)OPT_is_replaceable(module, function, index, aliases) == false) {
+				continue;
+			}
+
+			size_t size = module->classes[instruction->a].size;
+			int *scalars = (int*)malloc((size + 1) * sizeof(int));
+
+			if (scalars == NULL) {
+				(void)IO_BUFFER_RESERVATION_EXCEPTION();
+				break;
+			}
+
+			for (size_t offset = 0; offset <= size; offset++) {
+				scalars[offset] = -1;
+			}
+
+			for (size_t r = 0; r < registerCount; r++) {
+				owners[r] = aliases[r] == true ? (int)replaced : owners[r];
+			}
+
+			objects[replaced].classIndex = instruction->a;
+			objects[replaced].scalars = scalars;
+			replaced++;
+		}
+	}
+
+	if (replaced > 0) {
+		(void)OPT_emit_scalar_objects(module, function, objects, owners);
+	}
+
+	for (size_t i = 0; i < replaced; i++) {
+		(void)free(objects[i].scalars);
+	}
+
+	(void)free(liveIn);
+	(void)free(liveOut);
+	(void)free(aliases);
+	(void)free(owners);
+	(void)free(objects);
+	return replaced;
+}
+
+/*
+Purpose: Mark the register of a new and all registers, that it's moved into (also through other moves)
+Return Type: void
+Params: struct IRFunction *function => Function of the object;
+		int reg => Result of the new;
+		char *aliases => Receives the marks (one per register)
+*/
+void OPT_collect_aliases(struct IRFunction *function, int reg, char *aliases) {
+	int changed = true;
+	(void)memset(aliases, 0, function->registerCount * sizeof(char));
+	aliases[reg] = true;
+
+	while (changed == true) {
+		changed = false;
+
+		for (size_t i = 0; i < function->instructionCount; i++) {
+			struct IRInstruction *instruction = &function->instructions[i];
+
+			if (instruction->opcode == IR_MOVE && aliases[instruction->a] == true && aliases[instruction->dest] == false) {
+				aliases[instruction->dest] = true;
+				changed = true;
+			}
+		}
+	}
+}
+
+/*
+Purpose: Check if the registers of an object are only written by its new and moves and only read by moves, null checks and field accesses
+Return Type: int => true if the object can be replaced by its fields, else false
+Params: struct IRModule *module => Module with the classes;
+		struct IRFunction *function => Function of the object;
+		size_t creation => Index of the new;
+		char *aliases => Registers of the object
+*/
+int OPT_is_replaceable(struct IRModule *module, struct IRFunction *function, size_t creation, char *aliases) {
+	int classIndex = function->instructions[creation].a;
+	int buffer[3];
+	int *uses = NULL;
+
+	for (size_t i = 0; i < function->paramCount; i++) {
+		if (aliases[i] == true) {
+			return false;
+		}
+	}
+
+	for (size_t i = 0; i < function->instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+		int definition = (int)OPT_get_defined_register(instruction);
+
+		if (definition >= 0 && aliases[definition] == true && i != creation
+			&& (instruction->opcode != IR_MOVE || aliases[instruction->a] == false)) {
+			return false;
+		}
+
+		int useCount = (int)OPT_get_uses(function, instruction, &uses, buffer);
+
+		for (int u = 0; u < useCount; u++) {
+			if (aliases[uses[u]] == false) {
+				continue;
+			}
+
+			switch (instruction->opcode) {
+			case IR_MOVE:
+			case IR_CHECK_NULL:
+				break;
+			case IR_LOAD_FIELD:
+				if ((int)OPT_is_scalar_field(module, classIndex, instruction) == false) {
+					return false;
+				}
+
+				break;
+			case IR_STORE_FIELD:
+				if (aliases[instruction->c] == true || (int)OPT_is_scalar_field(module, classIndex, instruction) == false) {
+					return false;
+				}
+
+				break;
+			default:
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Check if a field access belongs to the class of the object and its field can be held in a register
+Return Type: int => true if the field can be replaced, else false
+Params: struct IRModule *module => Module with the classes;
+		int classIndex => Class of the object;
+		struct IRInstruction *instruction => Load or store of the field
+*/
+int OPT_is_scalar_field(struct IRModule *module, int classIndex, struct IRInstruction *instruction) {
+	int owner = (int)instruction->value.integer;
+
+	if ((int)IR_is_subclass(module, classIndex, owner) == false) {
+		return false;
+	}
+
+	//Strings default to null in an object, the registers have no null string
+	switch (module->classes[owner].fields[instruction->b].type) {
+	case INTEGER:
+	case LONG:
+	case SHORT:
+	case DOUBLE:
+	case FLOAT:
+	case CHAR:
+	case BOOLEAN:
+	case CLASS_REF:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/*
+Purpose: Check if a register of an object is live in front of an instruction (the liveness of the block is walked back from its end)
+Return Type: int => true if a marked register is live, else false
+Params: struct IRFunction *function => Function of the object;
+		size_t block => Block of the instruction;
+		size_t position => Position of the instruction in the block;
+		char *aliases => Registers of the object;
+		uint64_t *liveIn, *liveOut => Liveness of the blocks (see OPT_compute_liveness);
+		size_t words => Number of words of a bitset
+*/
+int OPT_is_alias_live(struct IRFunction *function, size_t block, size_t position, char *aliases, uint64_t *liveIn, uint64_t *liveOut, size_t words) {
+	struct IRBlock *current = &function->blocks[block];
+	uint64_t *live = (uint64_t*)malloc(words * sizeof(uint64_t));
+	int buffer[3];
+	int *uses = NULL;
+	int result = false;
+
+	if (live == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return true;
+	}
+
+	(void)memcpy(live, &liveOut[block * words], words * sizeof(uint64_t));
+
+	for (size_t n = current->instructionCount; n-- > position;) {
+		struct IRInstruction *instruction = &function->instructions[current->firstInstruction + n];
+		int definition = (int)OPT_get_defined_register(instruction);
+		int useCount = (int)OPT_get_uses(function, instruction, &uses, buffer);
+
+		if (definition >= 0) {
+			live[definition / 64] &= ~((uint64_t)1 << (definition % 64));
+		}
+
+		for (int u = 0; u < useCount; u++) {
+			live[uses[u] / 64] |= (uint64_t)1 << (uses[u] % 64);
+		}
+
+		for (size_t w = 0; current->handler >= 0 && w < words && (int)IR_can_raise(instruction) == true; w++) {
+			live[w] |= liveIn[(size_t)current->handler * words + w];
+		}
+	}
+
+	for (size_t i = 0; i < function->registerCount && result == false; i++) {
+		result = aliases[i] == true && (live[i / 64] & ((uint64_t)1 << (i % 64))) != 0 ? true : false;
+	}
+
+	(void)free(live);
+	return result;
+}
+
+/*
+Purpose: Get the register, that holds an accessed field of a replaced object (it's added on the first access)
+Return Type: int => The register of the field
+Params: struct IRModule *module => Module with the classes;
+		struct IRFunction *function => Function of the object;
+		struct OPTObject *object => The replaced object;
+		struct IRInstruction *instruction => Load or store of the field
+*/
+int OPT_get_scalar(struct IRModule *module, struct IRFunction *function, struct OPTObject *object, struct IRInstruction *instruction) {
+	struct IRField *field = &module->classes[instruction->value.integer].fields[instruction->b];
+
+	if (object->scalars[field->offset] < 0) {
+		int reg = IR_add_register(function, field->type, field->name);
+		function->registers[reg].reference = field->reference;
+		object->scalars[field->offset] = reg;
+	}
+
+	return object->scalars[field->offset];
+}
+
+/**
+ * <p>
+ * Emits the function again with the replaced objects.
+ * </p>
+ *
+ * <p>
+ * The {@code new} of a replaced object sets the registers of its
+ * fields to their default values (the fields of an object are zero),
+ * the loads and stores of the fields become moves. The moves between
+ * the registers of the object and its null checks are left out.
+ * </p>
+ *
+ * @param *module       Module with the classes
+ * @param *function     Function of the objects
+ * @param *objects      The replaced objects
+ * @param *owners       Replaced object of every register (-1 for the other registers)
+ */
+void OPT_emit_scalar_objects(struct IRModule *module, struct IRFunction *function, struct OPTObject *objects, int *owners) {
+	size_t instructionCount = function->instructionCount;
+	size_t blockCount = function->blockCount;
+	size_t registerCount = function->registerCount;
+	struct IRInstruction *instructions = (struct IRInstruction*)malloc((instructionCount + 1) * sizeof(struct IRInstruction));
+	struct IRBlock *blocks = (struct IRBlock*)malloc((blockCount + 1) * sizeof(struct IRBlock));
+
+	if (instructions == NULL || blocks == NULL) {
+		(void)free(instructions);
+		(void)free(blocks);
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	//Every accessed field gets its register, before the new sets them
+	for (size_t i = 0; i < instructionCount; i++) {
+		struct IRInstruction *instruction = &function->instructions[i];
+
+		if ((instruction->opcode == IR_LOAD_FIELD || instruction->opcode == IR_STORE_FIELD) && owners[instruction->a] >= 0) {
+			(void)OPT_get_scalar(module, function, &objects[owners[instruction->a]], instruction);
+		}
+	}
+
+	(void)memcpy(instructions, function->instructions, instructionCount * sizeof(struct IRInstruction));
+	(void)memcpy(blocks, function->blocks, blockCount * sizeof(struct IRBlock));
+	function->instructionCount = 0;
+	function->currentBlock = -1;
+
+	for (size_t i = 0; i < blockCount; i++) {
+		function->handler = blocks[i].handler;
+		(void)IR_start_block(function, (int)i);
+
+		for (size_t n = 0; n < blocks[i].instructionCount; n++) {
+			struct IRInstruction *instruction = &instructions[blocks[i].firstInstruction + n];
+			int owner = instruction->a >= 0 && (size_t)instruction->a < registerCount ? owners[instruction->a] : -1;
+			struct IRInstruction *copy = NULL;
+
+			switch (instruction->opcode) {
+			case IR_NEW:
+				owner = owners[instruction->dest];
+				break;
+			case IR_MOVE:
+			case IR_CHECK_NULL:
+			case IR_LOAD_FIELD:
+			case IR_STORE_FIELD:
+				break;
+			default:
+				owner = -1;
+				break;
+			}
+
+			if (owner < 0) {
+				copy = IR_emit(function, instruction->opcode, instruction->type, instruction->dest, instruction->a, instruction->b, instruction->c, instruction->line);
+
+				if (copy != NULL) {
+					copy->value = instruction->value;
+					copy->origin = instruction->origin;
+				}
+
+				continue;
+			}
+
+			struct OPTObject *object = &objects[owner];
+
+			switch (instruction->opcode) {
+			case IR_NEW:
+				for (size_t offset = 0; offset <= module->classes[object->classIndex].size; offset++) {
+					int reg = object->scalars[offset];
+
+					if (reg < 0) {
+						continue;
+					}
+
+					enum VarType type = function->registers[reg].type;
+					int floating = type == DOUBLE || type == FLOAT ? true : false;
+					copy = IR_emit(function, floating == true ? IR_CONST_FLOAT : IR_CONST_INT, type, reg, IR_NO_REGISTER, IR_NO_REGISTER, IR_NO_REGISTER, instruction->line);
+
+					if (copy != NULL && floating == true) {
+						copy->value.floating = 0;
+					}
+				}
+
+				break;
+			case IR_LOAD_FIELD:
+				copy = IR_emit(function, IR_MOVE, instruction->type, instruction->dest, OPT_get_scalar(module, function, object, instruction), IR_NO_REGISTER, IR_NO_REGISTER, instruction->line);
+				break;
+			case IR_STORE_FIELD:
+				copy = IR_emit(function, IR_MOVE, instruction->type, OPT_get_scalar(module, function, object, instruction), instruction->c, IR_NO_REGISTER, IR_NO_REGISTER, instruction->line);
+				break;
+			default:
+				//The moves between the registers of the object and its null checks
+				break;
+			}
+
+			if (copy != NULL && (instruction->opcode == IR_LOAD_FIELD || instruction->opcode == IR_STORE_FIELD)) {
+				copy->origin = instruction->origin;
+			}
+		}
+	}
+
+	function->handler = -1;
+	(void)free(instructions);
+	(void)free(blocks);
+
+	(void)IR_finish_function(function);
+}
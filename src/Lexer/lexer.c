@@ -23,10 +23,11 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
-#include <time.h>
 #include "../../headers/modules.h"
 #include "../../headers/errors.h"
 #include "../../headers/Token.h"
+#include "../../headers/lineindex.h"
+#include "../../headers/stats.h"
 
 /** 
  * The subprogram {@code SPACE/src/lexer.c} was created
@@ -56,6 +57,7 @@ int LX_token_clearance_check(TOKEN *token, size_t lineNumber);
 void LX_set_line_number(TOKEN *token, size_t lineNumber);
 int LX_is_reference_on_pointer(TOKEN *token, char **buffer, size_t currentSymbolIndex);
 
+void LX_add_new_line(size_t *lineNumber, size_t newlineIndex);
 int LX_skip_comment(char **input, const size_t currentIndex, size_t *lineNumber);
 int LX_write_string_in_token(TOKEN *token, char **input, const size_t currentInputIndex, const char crucialCharacter, size_t *lineNumber);
 int LX_skip_whitespaces(char **input, size_t currentInputIndex, size_t *lineNumber);
@@ -72,8 +74,7 @@ void LX_set_EOF_token(TOKEN *token);
 
 int LX_check_for_operator(char input);
 int LX_check_for_double_operator(char currentChar, char nextChar);
-void LX_print_result(TOKEN *tokens, size_t currenTokenIndex);
-void LX_print_cpu_time(float cpu_time_used);
+void LX_print_result(FILE *output, TOKEN *tokens, size_t currenTokenIndex);
 
 TOKENTYPES LX_fill_operator_type(char *value);
 TOKENTYPES LX_fill_condition_type(char *value);
@@ -181,6 +182,28 @@ int tokensreserved = 0;
  * </p>
  */
 TOKEN *TOKENS = NULL;
+
+/**
+ * <p>
+ * Line starts of the current buffer.
+ * </p>
+ * 
+ * <p><strong>Usage:</strong>
+ * The lexer adds every line start while counting the newlines, so
+ * all later phases can map a buffer offset to line and column
+ * with a binary search instead of rescanning the buffer.
+ * The index belongs to the caller of {@code Tokenize()}.
+ * </p>
+ */
+extern struct LineIndex *LINE_INDEX;
+
+/**
+ * <p>
+ * Stream for the token dump ({@code --dump-tokens}), NULL if
+ * the tokens shouldn't be dumped.
+ * </p>
+ */
+extern FILE *TOKEN_DUMP;
 extern char **BUFFER;
 extern char *FILE_NAME;
 
@@ -195,11 +218,31 @@ extern char *FILE_NAME;
  * but for identifiying double operators like '++' or '+=' etc. another
  * character is loaded.
  * </p>
- * @returns The final token array with all tokens
+ * @returns The final token array with all tokens (NULL if a fatal error occured)
  * 
  * @param **arrayOfIndividualTokenSizes     Sizes of the indiviual tokens
  */
 TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
+	jmp_buf recoveryPoint;
+
+	// A fatal lexer error returns here, so the caller gets NULL instead of a terminated process
+	if (setjmp(recoveryPoint) != 0) {
+		(void)FREE_TOKENS(TOKENS);
+		TOKENS = NULL;
+
+		// The diagnostics need all lines, so the rest of the buffer is indexed here
+		(void)FREE_LINE_INDEX(LINE_INDEX);
+		LINE_INDEX = CreateNewLineIndex(*BUFFER, BUFFER_LENGTH);
+		return NULL;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	LINE_INDEX = CreateNewLineIndex(NULL, BUFFER_LENGTH);
+
+	if (LINE_INDEX == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
 	// TOKEN defined in modules.h
 	TOKENS = (struct TOKEN*)calloc((TOKEN_LENGTH + 2), sizeof(struct TOKEN));
 	maxTokensLength = TOKEN_LENGTH + 1;
@@ -210,6 +253,7 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 		(void)IO_BUFFER_RESERVATION_EXCEPTION();
 	}
 
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, (TOKEN_LENGTH + 2) * sizeof(struct TOKEN));
 	(void)LX_set_token_value_to_awaited_size(&TOKENS, arrayOfIndividualTokenSizes);
 	tokensreserved = 1;
 	
@@ -219,13 +263,6 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 	size_t storageIndex = 0;
 	size_t storagePointer = 0;
 
-	// CLOCK FOR DEBUG PURPOSES ONLY!!
-	clock_t start, end;
-
-	if (LEXER_DISPLAY_USED_TIME == 1) {
-		start = (clock_t)clock();
-	}
-
 	size_t lineNumber = 0;
 
 	for (size_t i = 0; i < BUFFER_LENGTH; i++) {
@@ -388,20 +425,19 @@ TOKEN* Tokenize(int **arrayOfIndividualTokenSizes) {
 	maxTokensLength = storagePointer > maxTokensLength ? storagePointer : maxTokensLength;
 	storagePointer--;
 
-	// END CLOCK AND PRINT RESULT
-	if (LEXER_DISPLAY_USED_TIME == 1) {
-		end = (clock_t)clock();
-	}
+	(void)ST_count(COUNTER_TOKENS, storagePointer + 1);
+	(void)ST_count(COUNTER_LINES, lineNumber + 1);
 
-	if (LEXER_DEBUG_MODE == 1) {
-		(void)LX_print_result(TOKENS, storagePointer);
+	if (TOKEN_DUMP != NULL) {
+		(void)LX_print_result(TOKEN_DUMP, TOKENS, storagePointer);
 	}
 
-	if (LEXER_DISPLAY_USED_TIME == 1) {
+	if (LEXER_DEBUG_MODE == 1) {
+		(void)printf("\n>>>>>    Buffer successfully lexed    <<<<<\n");
 		(void)printf("Finished with %li tokens and %li lines in total.\n", storagePointer + 1, lineNumber + 1);
-		(void)LX_print_cpu_time(((double) (end - start)) / CLOCKS_PER_SEC);
 	}
 
+	(void)_init_error_recovery_point_(NULL);
 	return TOKENS;
 }
 
@@ -463,7 +499,7 @@ int LX_is_reference_on_pointer(TOKEN *token, char **buffer, size_t currentSymbol
 	}
 
 	if ((*buffer)[currentSymbolIndex + symbolsToSkip + 1] != ')') {
-		token->value = "";
+		token->value[0] = '\0';
 		return 0;
 	}
 
@@ -571,13 +607,17 @@ void LX_set_token_value_to_awaited_size(TOKEN **tokens, int **tokenLengthsArray)
 	if (*tokens != NULL && tokenLengthsArray != NULL) {
 		for (int i = 0; i < maxTokensLength; i++) {
 			// Calloc as much space as predicted; Tokens at i has the value length of tokenLengths at i
-			(*tokens)[i].value = (char*)calloc((*tokenLengthsArray)[i], sizeof(char));
-			(*tokens)[i].size = (*tokenLengthsArray)[i];
+			// (at least one character, the reserve token behind the last one is predicted with 0)
+			int size = (*tokenLengthsArray)[i] > 0 ? (*tokenLengthsArray)[i] : 1;
+			(*tokens)[i].value = (char*)calloc(size, sizeof(char));
+			(*tokens)[i].size = size;
 
 			// If the allocation of the memory should fail an error gets called
 			if ((*tokens)[i].value == NULL) {
 				(void)IO_BUFFER_RESERVATION_EXCEPTION();
 			}
+
+			(void)ST_count(COUNTER_BYTES_ALLOCATED, size);
 		}
 	}
 }
@@ -607,6 +647,7 @@ void LX_resize_tokens_value(TOKEN *token, size_t oldSize) {
 
 	token->value = newValue;
 	token->size = newSize;
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, newSize - oldSize);
 
 	// Set the new allocated memory to '0'
 	if (token->value != NULL) {
@@ -639,6 +680,20 @@ int LX_token_clearance_check(TOKEN *token, size_t lineNumber) {
 	return 0;
 }
 
+/**
+ * <p>
+ * Counts a newline and adds the start of the following line
+ * to the {@code LINE_INDEX}.
+ * </p>
+ * 
+ * @param *lineNumber   Pointer to the lineNumber
+ * @param newlineIndex  Index of the '\n' in the buffer
+ */
+void LX_add_new_line(size_t *lineNumber, size_t newlineIndex) {
+	(*lineNumber)++;
+	(void)LI_add_line_start(LINE_INDEX, newlineIndex + 1);
+}
+
 /**
  * <p>
  * Skips a comment.
@@ -665,7 +720,9 @@ int LX_skip_comment(char **input, const size_t currentIndex, size_t *lineNumber)
 		char currentCharacter = (*input)[currentIndex + jumpForward];
 		char nextCharacter = (*input)[currentIndex + jumpForward + 1];
 		//Check for '\n'
-		(*lineNumber) += (int)is_space(currentCharacter) == 2 ? 1 : 0;
+		if ((int)is_space(currentCharacter) == 2) {
+			(void)LX_add_new_line(lineNumber, currentIndex + jumpForward);
+		}
 
 		if (crucialChar == '*' && currentCharacter == '*' && nextCharacter == '/') {
 			jumpForward++;
@@ -716,7 +773,7 @@ int LX_write_string_in_token(TOKEN *token, char **input, const size_t currentInp
 			}
 
 			if ((int)is_space((*input)[currentInputIndex + jumpForward]) == 2) {
-				(*lineNumber)++;
+				(void)LX_add_new_line(lineNumber, currentInputIndex + jumpForward);
 			}
 
 			jumpForward++;
@@ -771,7 +828,7 @@ int LX_skip_whitespaces(char **input, size_t currentInputIndex, size_t *lineNumb
 		if (whitespaceChar == 0) {
 			break;
 		} else if (whitespaceChar == 2) {
-			(*lineNumber)++;
+			(void)LX_add_new_line(lineNumber, currentInputIndex + jumpForward);
 		}
 
 		jumpForward++;
@@ -908,6 +965,12 @@ void LX_write_default_operator_in_token(TOKEN *token, char currentChar, size_t l
 void LX_set_EOF_token(TOKEN *token) {
 	if (token != NULL) {
 		char *src = "$EOF$\0";
+
+		//The reserved value is replaced, so it's released first
+		if (token->value != NULL) {
+			(void)free(token->value);
+		}
+
 		token->value = (char*)calloc(sizeof(char), 7);
 
 		if (token->value == NULL) {
@@ -1120,27 +1183,27 @@ int LX_check_for_double_operator(char currentChar, char nextChar) {
 }
 
 /**
- * <p><strong>DEBUG ONLY!</strong>
- * This function prints the details of the lexer for the DEBUG_MODE = 1.
+ * <p>
+ * This function dumps the details of all tokens (--dump-tokens).
  * </p>
  * 
+ * @param *output               Stream to write to
  * @param *tokens               Tokens to print
  * @param currentTokenIndex     Size of the token array
  */
-void LX_print_result(TOKEN *tokens, size_t currenTokenIndex) {
+void LX_print_result(FILE *output, TOKEN *tokens, size_t currenTokenIndex) {
 	if (tokens != NULL) {
-		(void)printf("\n>>>>>>>>>>>>>>>>>>>>    LEXER    <<<<<<<<<<<<<<<<<<<<\n\n");
+		(void)fprintf(output, "\n>>>>>>>>>>>>>>>>>>>>    LEXER (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
 
 		for (size_t i = 0; i < currenTokenIndex + 2; i++) {
 			if (tokens[i].value == NULL) {
-				printf("Token: (NULL)\n");
+				(void)fprintf(output, "Token: (NULL)\n");
 				continue;
 			}
 
-			(void)printf("Token: %3lu | Type: %-2d | Size: %3li | Line: %3li | Start of TOKEN: %3li -> Token: %s\n", i, (int)tokens[i].type, tokens[i].size, tokens[i].line, tokens[i].tokenStart, tokens[i].value);
+			size_t column = LINE_INDEX != NULL ? LI_locate(LINE_INDEX, tokens[i].tokenStart).column : 0;
+			(void)fprintf(output, "Token: %3lu | Type: %-2d | Size: %3li | Line: %3li | Column: %3li | Start of TOKEN: %3li -> Token: %s\n", i, (int)tokens[i].type, tokens[i].size, tokens[i].line, column, tokens[i].tokenStart, tokens[i].value);
 		}
-
-		(void)printf("\n>>>>>    Buffer successfully lexed    <<<<<\n");
 	}
 }
 
@@ -1173,14 +1236,3 @@ TOKENTYPES LX_get_keyword_type(const char *value) {
 
 	return _IDENTIFIER_;
 }
-
-/**
- * <p><strong>DEBUG ONLY!</strong>
- * Prints out the totaly used time in seconds.
- * </p>
- * 
- * @param cpu_time_used     CPU time that was used to run the lexer module
- */
-void LX_print_cpu_time(float cpu_time_used) {
-	(void)printf("\nCPU time used for LEXING: %f seconds\n", cpu_time_used);
-}
\ No newline at end of file
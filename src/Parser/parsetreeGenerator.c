@@ -23,11 +23,11 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
-#include <time.h>
 #include "../../headers/modules.h"
 #include "../../headers/errors.h"
 #include "../../headers/parsetree.h"
 #include "../../headers/Token.h"
+#include "../../headers/stats.h"
 
 /** 
  * <p>
@@ -134,7 +134,6 @@ enum processDirection {
 
 ///// FUNCTIONS PROTOTYPES /////
 
-void PG_print_cpu_time(float cpu_time_used);
 NodeReport PG_create_runnable_tree(TOKEN **tokens, size_t startPos, enum RUNNABLE_TYPE type);
 NodeReport PG_get_report_based_on_token(TOKEN **tokens, size_t startPos, enum RUNNABLE_TYPE type);
 int PG_predict_function_call(TOKEN **tokens, size_t startPos);
@@ -226,7 +225,7 @@ Node *PG_create_modifier_node(TOKEN *token, int *skip);
 Node *PG_create_node(char *value, enum NodeType type, int line, int pos, int reservedValue);
 NodeReport PG_create_node_report(Node *topNode, int tokensToSkip);
 void PG_allocate_node_details(Node *node, size_t size);
-void PG_print_from_top_node(Node *topNode, int depth, int pos);
+void PG_print_from_top_node(FILE *output, Node *topNode, int depth, int pos);
 
 /**
  * <p>
@@ -234,6 +233,15 @@ void PG_print_from_top_node(Node *topNode, int depth, int pos);
  * </p>
 */
 extern size_t TOKEN_LENGTH;
+extern char *FILE_NAME;
+
+/**
+ * <p>
+ * Stream for the parsetree dump ({@code --dump-ast}), NULL if
+ * the tree shouldn't be dumped.
+ * </p>
+ */
+extern FILE *AST_DUMP;
 
 /**
  * <p>
@@ -244,60 +252,43 @@ extern size_t TOKEN_LENGTH;
  * @param TOKEN_LENGTH   Length of the token array
 */
 Node *GenerateParsetree(TOKEN **tokens) {
-	(void)printf("\n\n\n>>>>>>>>>>>>>>>>>>>>    PARSETREE    <<<<<<<<<<<<<<<<<<<<\n\n");
+	jmp_buf recoveryPoint;
 
-	if (tokens == NULL || TOKEN_LENGTH == 0) {
-		(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
+	//Nodes of an aborted generation can't be reached anymore and are lost
+	if (setjmp(recoveryPoint) != 0) {
+		return NULL;
 	}
 
-	printf("TOKEN_LENGTH: %li\n", TOKEN_LENGTH);
+	(void)_init_error_recovery_point_(&recoveryPoint);
 
-	// CLOCK FOR DEBUG PURPOSES ONLY!!
-	clock_t start, end;
+	if (PARSETREE_GENERATOR_DEBUG_MODE == 1) {
+		(void)printf("\n\n\n>>>>>>>>>>>>>>>>>>>>    PARSETREE    <<<<<<<<<<<<<<<<<<<<\n\n");
+	}
 
-	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == 1) {
-		start = (clock_t)clock();
+	if (tokens == NULL || TOKEN_LENGTH == 0) {
+		(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
 	}
 
 	//Tree generation process
 	NodeReport runnable = PG_create_runnable_tree(tokens, 0, Main);
-
-	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == 1) {
-		end = (clock_t)clock();            
-	}
 	
+	if (AST_DUMP != NULL && runnable.node != NULL) {
+		(void)fprintf(AST_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    PARSETREE (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+		(void)PG_print_from_top_node(AST_DUMP, runnable.node, 0, 0);
+	}
+
 	if (PARSETREE_GENERATOR_DEBUG_MODE == 1) {
 		if (runnable.node == NULL) {
-			printf("Something went wrong in the parsetree generation step.");
-		} else {
-			(void)PG_print_from_top_node(runnable.node, 0, 0);
+			(void)printf("Something went wrong in the parsetree generation step.\n");
 		}
-	}
-
-	if (PARSETREE_GENERATOR_DISPLAY_USED_TIME == 1) {
-		(void)PG_print_cpu_time(((double) (end - start)) / CLOCKS_PER_SEC);
-	}
 
-	if (runnable.node == NULL) {
-		printf("Something went wrong (PG)!\n");
+		(void)printf("\n\n\n>>>>>    Tokens converted to tree    <<<<<\n\n");
 	}
 
-	(void)printf("\n\n\n>>>>>    Tokens converted to tree    <<<<<\n\n");
-
+	(void)_init_error_recovery_point_(NULL);
 	return runnable.node;
 }
 
-/**
- * <p>
- * Prints the used CPU time of the measured time.
- * </p>
- * 
- * @param cpu_time_used Used CPU time
- */
-void PG_print_cpu_time(float cpu_time_used) {
-	(void)printf("\nCPU time used for PARSETREE GENERATION: %f seconds\n", cpu_time_used);
-}
-
 /**
  * <p>
  * Generates a subtree for a runnable / block statment.
@@ -369,9 +360,7 @@ NodeReport PG_create_runnable_tree(TOKEN **tokens, size_t startPos, enum RUNNABL
 
 				if (temp == NULL) {
 					(void)free(parentNode->details);
-					(void)FREE_MEMORY();
-					(void)printf("Something went wrong (runnable)!\n");
-					(void)exit(EXIT_FAILURE);
+					(void)PARSE_TREE_NODE_RESERVATION_EXCEPTION();
 				}
 
 				parentNode->details = temp;
@@ -584,7 +573,7 @@ NodeReport PG_create_else_if_statement_tree(TOKEN **tokens, size_t startPos) {
 
 	NodeReport chainedCondReport = PG_create_chained_condition_tree(tokens, startPos + 3, false);
 	node->leftNode = chainedCondReport.node;
-	skip += chainedCondReport.tokensToSkip + 4;
+	skip += chainedCondReport.tokensToSkip + 5;
 
 	NodeReport runnableReport = PG_create_runnable_tree(tokens, startPos + skip, InBlock);
 	node->rightNode = runnableReport.node;
@@ -869,17 +858,27 @@ NodeReport PG_create_simple_assignment_tree(TOKEN **tokens, size_t startPos) {
 		rRep = PG_create_condition_assignment_tree(tokens, startPos + skip);
 	} else if ((int)PG_predict_increment_or_decrement_assignment(tokens, startPos + skip) == true) {
 		rRep = PG_create_increment_decrement_tree(tokens, startPos);
-	//String assignment handling
-	} else if ((*tokens)[startPos + skip].type == _STRING_
-		|| (*tokens)[startPos + skip].type == _CHARACTER_ARRAY_) {
+	//String assignment handling (a string, that starts a term like '"a" + b', is part of the term)
+	} else if (((*tokens)[startPos + skip].type == _STRING_
+		|| (*tokens)[startPos + skip].type == _CHARACTER_ARRAY_)
+		&& (int)PG_is_calculation_operator(&(*tokens)[startPos + skip + 1]) == false) {
 		Node *node = PG_create_node((*tokens)[startPos + skip].value, _STRING_NODE_, (*tokens)[startPos + skip].line, (*tokens)[startPos + skip].tokenStart, false);
 		rRep = PG_create_node_report(node, 2);
+	//Object and array creation handling ("new Name(...)" or "new type[...]")
+	} else if ((*tokens)[startPos + skip].type == _KW_NEW_) {
+		if ((*tokens)[startPos + skip + 2].type == _OP_RIGHT_EDGE_BRACKET_) {
+			rRep = PG_create_array_creation_tree(tokens, startPos + skip + 1);
+			rRep.tokensToSkip++;
+		} else {
+			rRep = PG_create_class_instance_tree(tokens, startPos + skip);
+		}
 	//Null assignment handling
 	} else if ((*tokens)[startPos + skip].type == _KW_NULL_) {
 		Node *node = PG_create_node((*tokens)[startPos + skip].value, _NULL_NODE_, (*tokens)[startPos + skip].line, (*tokens)[startPos + skip].tokenStart, false);
 		rRep = PG_create_node_report(node, 2);
 	//Memeber access handling
-	} else if ((int)PG_predict_member_access(tokens, startPos, NONE) == true) {
+	} else if ((int)PG_predict_member_access(tokens, startPos, NONE) == true
+		&& (int)PG_is_member_access(tokens, startPos + skip) == true) {
 		rRep = PG_create_member_access_tree(tokens, startPos + skip, false);
 	} else {
 		int bounds = (int)PG_get_term_bounds(tokens, startPos + skip);
@@ -1702,6 +1701,7 @@ NodeReport PG_create_array_var_tree(TOKEN **tokens, size_t startPos) {
 		}
 		case _KW_NEW_:
 			rep = PG_create_array_creation_tree(tokens, startPos + skip + 2);
+			rep.tokensToSkip += 2;
 			break;
 		default: {
 			int termBounds = (int)PG_get_term_bounds(tokens, startPos + skip + 1);
@@ -1805,9 +1805,7 @@ NodeReport PG_create_array_init_tree(TOKEN **tokens, size_t startPos, int dim) {
 	char *name = (char*)calloc(dim + 2, size);
 
 	if (name == NULL) {
-		FREE_MEMORY();
-		printf("NAME ERROR!\n");
-		exit(EXIT_FAILURE);
+		(void)PARSE_TREE_INVALID_NODE_EXCEPTION("name = NULL");
 	}
 
 	//Automatic '\0' added
@@ -1825,7 +1823,7 @@ NodeReport PG_create_array_init_tree(TOKEN **tokens, size_t startPos, int dim) {
 		switch (currentToken->type) {
 		case _OP_RIGHT_BRACE_: {
 			NodeReport arrInitReport = PG_create_array_init_tree(tokens, startPos + jumper + 1, dim + 1);
-			jumper += arrInitReport.tokensToSkip + 1;
+			jumper += arrInitReport.tokensToSkip;
 			topNode->details[detailsPointer++] = arrInitReport.node;
 			break;
 		}
@@ -2532,9 +2530,7 @@ NodeReport PG_create_enum_tree(TOKEN **tokens, size_t startPos) {
 		}
 
 		if (argumentCount > enumNode->detailsCount) {
-			FREE_MEMORY();
-			printf("SIZE (enum) %li!\n", enumNode->detailsCount);
-			exit(EXIT_FAILURE);
+			(void)PARSE_TREE_INVALID_NODE_EXCEPTION("enum size");
 		}
 
 		token = &(*tokens)[startPos + skip + 1];
@@ -2557,9 +2553,7 @@ NodeReport PG_create_enum_tree(TOKEN **tokens, size_t startPos) {
 			char *value = (char*)calloc(24, sizeof(char));
 
 			if (value == NULL) {
-				FREE_MEMORY();
-				printf("VALUE = NULL! (enum)\n");
-				exit(EXIT_FAILURE);
+				(void)PARSE_TREE_INVALID_NODE_EXCEPTION("enum value = NULL");
 			}
 
 			(void)snprintf(value, 24, "%d", currentEnumeratorValue++);
@@ -2679,7 +2673,7 @@ NodeReport PG_create_function_call_tree(TOKEN **tokens, size_t startPos) {
 	TOKEN *token = &(*tokens)[startPos];
 	char *name = PG_get_identifier_by_index(token);
 	Node *functionCallNode = PG_create_node(name, _FUNCTION_CALL_NODE_, token->line, token->tokenStart, true);
-	int argumentSize = (int)PG_predict_argument_count(tokens, startPos + 1, true);
+	int argumentSize = (int)PG_predict_argument_count(tokens, startPos + 1, false);
 	(void)PG_allocate_node_details(functionCallNode, argumentSize);
 	size_t paramSize = (size_t)PG_add_params_to_node(functionCallNode, tokens, startPos + 2, 0, _NULL_);
 	paramSize = paramSize > 0 ? paramSize - 1 : paramSize;
@@ -2897,9 +2891,7 @@ size_t PG_get_size_till_next_semicolon(TOKEN **tokens, size_t startPos) {
  */
 void PG_allocate_node_details(Node *node, size_t size) {
 	if (node == NULL) {
-		(void)FREE_MEMORY();
-		(void)printf("NODE NULL\n");
-		(void)exit(EXIT_FAILURE);
+		(void)PARSE_TREE_INVALID_NODE_EXCEPTION("node = NULL");
 	}
 
 	Node **temp = NULL;
@@ -2908,18 +2900,20 @@ void PG_allocate_node_details(Node *node, size_t size) {
 	if (resize == false) {
 		temp = (Node**)calloc(size, sizeof(Node*));
 	} else {
-		temp = (Node**)realloc(node->details, sizeof(Node) * size);
-
-		for (int i = node->detailsCount; i < size; i++) {
-			node->details[i] = NULL;
-		}
+		temp = (Node**)realloc(node->details, sizeof(Node*) * size);
 	}
 
 	if (temp == NULL) {
 		(void)free(node->details);
-		(void)FREE_MEMORY();
-		(void)printf("DETAILS ERROR!\n");
-		(void)exit(EXIT_FAILURE);
+		(void)PARSE_TREE_NODE_RESERVATION_EXCEPTION();
+	}
+
+	for (size_t i = resize == true ? node->detailsCount : size; i < size; i++) {
+		temp[i] = NULL;
+	}
+
+	if (size > node->detailsCount) {
+		(void)ST_count(COUNTER_BYTES_ALLOCATED, (size - node->detailsCount) * sizeof(Node*));
 	}
 	
 	node->details = temp;
@@ -2929,55 +2923,56 @@ void PG_allocate_node_details(Node *node, size_t size) {
 /*
 Purpose: Print out a tree base on the nodes
 Return Type: void
-Params: Node *topNode => Pointer to the root node of the tree;
+Params: FILE *output => Stream to write to;
+		Node *topNode => Pointer to the root node of the tree;
 		int depth => The depth of the tree;
 		int pos => The position of the node (0 = Center, 1 = Left, 2 = Right)
 */
-void PG_print_from_top_node(Node *topNode, int depth, int pos) {
+void PG_print_from_top_node(FILE *output, Node *topNode, int depth, int pos) {
 	if (topNode == NULL || topNode->value == NULL) {
 		return;
 	}
 
 	for (int i = 0; i < depth; ++i) {
 		if (i + 1 == depth) {
-			(void)printf("+-- ");
+			(void)fprintf(output, "+-- ");
 		} else {
-			(void)printf("|   ");
+			(void)fprintf(output, "|   ");
 		}
 	}
 
 	if (pos == 0) {
-		(void)printf("C: %s -> %i\n", topNode->value, topNode->type);
+		(void)fprintf(output, "C: %s -> %i\n", topNode->value, topNode->type);
 	} else if (pos == 1) {
-		(void)printf("L: %s -> %i\n", topNode->value, topNode->type);
+		(void)fprintf(output, "L: %s -> %i\n", topNode->value, topNode->type);
 	} else {
-		(void)printf("R: %s -> %i\n", topNode->value, topNode->type);
+		(void)fprintf(output, "R: %s -> %i\n", topNode->value, topNode->type);
 	}
 
 	for (int i = 0; i < topNode->detailsCount; i++) {
 		if (topNode->details[i] != NULL) {
 			for (int n = 0; n < depth + 1; n++) {
 				if (n + 1 == depth + 1) {
-					(void)printf("+-- ");
+					(void)fprintf(output, "+-- ");
 				} else {
-					(void)printf("|   ");
+					(void)fprintf(output, "|   ");
 				}
 			}
 
-			(void)printf("(%s) detail: %s -> %i\n", topNode->value, topNode->details[i]->value, topNode->details[i]->type);
-			(void)PG_print_from_top_node(topNode->details[i]->leftNode, depth + 2, 1);
-			(void)PG_print_from_top_node(topNode->details[i]->rightNode, depth + 2, 2);
+			(void)fprintf(output, "(%s) detail: %s -> %i\n", topNode->value, topNode->details[i]->value, topNode->details[i]->type);
+			(void)PG_print_from_top_node(output, topNode->details[i]->leftNode, depth + 2, 1);
+			(void)PG_print_from_top_node(output, topNode->details[i]->rightNode, depth + 2, 2);
 
 			for (int n = 0; n < topNode->details[i]->detailsCount; n++) {
-				(void)PG_print_from_top_node(topNode->details[i]->details[n], depth + 2, 0);
+				(void)PG_print_from_top_node(output, topNode->details[i]->details[n], depth + 2, 0);
 			}
 		} else {
-			(void)printf("(%s) detail: NULL -> NULL\n", topNode->value);
+			(void)fprintf(output, "(%s) detail: NULL -> NULL\n", topNode->value);
 		}
 	}
 
-	(void)PG_print_from_top_node(topNode->leftNode, depth + 1, 1);
-	(void)PG_print_from_top_node(topNode->rightNode, depth + 1, 2);
+	(void)PG_print_from_top_node(output, topNode->leftNode, depth + 1, 1);
+	(void)PG_print_from_top_node(output, topNode->rightNode, depth + 1, 2);
 }
 
 /**
@@ -3142,6 +3137,13 @@ NodeReport PG_create_simple_term_node(TOKEN **tokens, size_t startPos, size_t bo
 		switch (currentToken->type) {
 		case _OP_RIGHT_BRACKET_: {
 			int bounds = PG_determine_bounds_for_capsulated_term(tokens, i);
+
+			//Arguments of a function call, the call is built from lastIdenPos
+			if (i > startPos && (*tokens)[i - 1].type == _IDENTIFIER_) {
+				i += bounds;
+				break;
+			}
+
 			NodeReport rep = PG_create_simple_term_node(tokens, i + 1, bounds);
 
 			if (cache == NULL) {
@@ -3277,8 +3279,9 @@ NodeReport PG_assign_processed_node_to_node(TOKEN **tokens, size_t startPos, int
 		report = PG_create_simple_term_node(tokens, startPos, bounds + 1);
 	} else if (startTok->type == _STRING_
 		|| startTok->type == _CHARACTER_ARRAY_) {
+		//Only the string itself, the operator behind it continues the term
 		Node *strNode = PG_create_node(startTok->value, _STRING_NODE_, startTok->line, startTok->tokenStart, false);
-		return PG_create_node_report(strNode, 2);
+		return PG_create_node_report(strNode, 1);
 	} else if (startTok->type == _KW_TRUE_
 		|| startTok->type == _KW_FALSE_) {
 		Node *boolNode = PG_create_node(startTok->value, _BOOL_NODE_, startTok->line, startTok->tokenStart, false);
@@ -3592,6 +3595,10 @@ int PG_is_member_access(TOKEN **tokens, size_t startPos) {
 			}
 		} else if ((int)is_end_indicator(currentToken) == true) {
 			return false;
+		} else if (skip > 0 && openBrackets == 0 && openEdgeBrackets == 0
+			&& ((int)PG_is_calculation_operator(currentToken) == true || (int)PG_is_condition_operator(currentToken->type) == true)) {
+			//The access belongs to a later operand (e.g. "cur" in "s + cur->value")
+			return false;
 		}
 
 		skip++;
@@ -3600,6 +3607,7 @@ int PG_is_member_access(TOKEN **tokens, size_t startPos) {
 	return false;
 }
 
+
 /**
  * <p>
  * This function limits the boundaries of a member access tree.
@@ -3787,15 +3795,25 @@ int PG_propagate_offset_by_direction(TOKEN **tokens, size_t startPos, enum proce
 int PG_back_shift_array_access(TOKEN **tokens, size_t startPos) {
 	int back = 0;
 	int openBrackets = 0;
+	int openEdgeBrackets = 0;
 
 	for (int i = startPos; i >= 0; i--) {
 		if (i <= 0) {
 			return 0;
 		} else if ((int)is_keyword(&(*tokens)[i]) == true) {
-			back = startPos - i;
+			//"this" and "super" belong to the access, other keywords (e.g. "is", "return") don't
+			int partOfAccess = (*tokens)[i].type == _KW_THIS_ || (*tokens)[i].type == _KW_SUPER_;
+			back = partOfAccess ? startPos - i : startPos - (i + 1);
+			break;
+		} else if (openBrackets == 0 && openEdgeBrackets == 0 && ((int)PG_is_calculation_operator(&(*tokens)[i]) == true
+			|| (int)PG_is_condition_operator((*tokens)[i].type) == true)) {
+			//The operand in front of the operator isn't part of the access (e.g. "s" in "s + cur->value")
+			back = startPos - (i + 1);
 			break;
 		}
 
+		openEdgeBrackets += (*tokens)[i].type == _OP_LEFT_EDGE_BRACKET_ ? 1 : (*tokens)[i].type == _OP_RIGHT_EDGE_BRACKET_ ? -1 : 0;
+
 		switch ((*tokens)[i].type) {
 			case _OP_SEMICOLON_:
 			case _OP_EQUALS_:
@@ -4024,9 +4042,7 @@ int PG_add_varType_definition(TOKEN **tokens, size_t startPos, Node *parentNode)
 		char *buffer = (char*)calloc(16, sizeof(char));
 
 		if (buffer == NULL) {
-			(void)FREE_MEMORY();
-			(void)printf("PG_BUFFER_NULL\n");
-			(void)exit(1);
+			(void)PARSE_TREE_NODE_RESERVATION_EXCEPTION();
 		}
 
 		int ret = (int)snprintf(buffer, 16 * sizeof(char), "%i", dimensions);
@@ -4121,6 +4137,8 @@ Node *PG_create_node(char *value, enum NodeType type, int line, int pos, int res
 	node->details = NULL;
 	node->detailsCount = 0;
 	node->reservedValue = reservedValue;
+	(void)ST_count(COUNTER_NODES, 1);
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, sizeof(Node));
 	return node;
 }
 
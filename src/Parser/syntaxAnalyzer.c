@@ -23,7 +23,6 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <ctype.h>
 #include <string.h>
 #include <stdlib.h>
-#include <time.h>
 #include "../../headers/Token.h"
 #include "../../headers/errors.h"
 
@@ -193,6 +192,12 @@ extern char *FILE_NAME;
  */
 extern size_t TOKEN_LENGTH;
 
+/**
+ * Panic mode state, reset on every ".CheckInput()"
+ */
+extern int panicModeOpenBraces;
+extern int panicModeLastStartPos;
+
 /**
  * <p>
  * Checks the token sequence received by the
@@ -203,17 +208,23 @@ extern size_t TOKEN_LENGTH;
  * @param tokens    Pointer the the tokens array from the lexer
 */
 int CheckInput(TOKEN **tokens) {
+	jmp_buf recoveryPoint;
+
+	if (setjmp(recoveryPoint) != 0) {
+		return PHASE_ABORTED;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+
 	if (tokens == NULL || TOKEN_LENGTH < 1) {
 		(void)PARSER_TOKEN_TRANSMISSION_EXCEPTION();
-		return -1;
+		return PHASE_ABORTED;
 	}
 
 	MAX_TOKEN_LENGTH = TOKEN_LENGTH;
-	clock_t start, end;
-
-	if (SYNTAX_ANALYZER_DISPLAY_USED_TIME == true) {
-		start = clock();
-	}
+	FILE_CONTAINS_ERRORS = false;
+	panicModeOpenBraces = 0;
+	panicModeLastStartPos = 0;
 
 	if (SYNTAX_ANALYZER_DEBUG_MODE == true) {
 		(void)printf("\n\n\n>>>>>>>>>>>>>>>>>>>>    SYNTAX ANALYZER    <<<<<<<<<<<<<<<<<<<<\n\n");
@@ -226,12 +237,8 @@ int CheckInput(TOKEN **tokens) {
 		(void)printf("\n>>>>>    Tokens successfully analyzed    <<<<<\n");
 	}
 
-	if (SYNTAX_ANALYZER_DISPLAY_USED_TIME == true) {
-		end = clock();
-		(void)printf("\nCPU time used for SYNTAX ANALYSIS: %f seconds\n", ((double) (end - start)) / CLOCKS_PER_SEC);   
-	}
-
-	return FILE_CONTAINS_ERRORS == false ? 0 : 1;
+	(void)_init_error_recovery_point_(NULL);
+	return FILE_CONTAINS_ERRORS == false ? PHASE_SUCCESS : PHASE_ERRORS;
 }
 
 int panicModeOpenBraces = 0;
@@ -1026,7 +1033,7 @@ SyntaxReport SA_is_for_statement(TOKEN **tokens, size_t startPos) {
 	if (isExpression.errorOccured == true) {
 		return isExpression;
 	}
-	printf("EXPR: %i\n", isExpression.tokensToSkip);
+
 	if ((*tokens)[startPos + skip].type != _OP_LEFT_BRACKET_) {
 		return SA_create_syntax_report(&(*tokens)[startPos + skip], 0, true, ")");
 	}
@@ -3749,58 +3756,6 @@ Params: TOKEN *errorToken => Token that caused the issue;
 void SA_throw_error(TOKEN *errorToken, char *expectedToken) {
 	FILE_CONTAINS_ERRORS = true;
 
-	if (BUFFER == NULL) {
-		(void)printf("Source code pointer = NULL!");
-		return;
-	}
-
-	int errorCharsAwayFromNL = 0;
-	size_t errorLine = errorToken->line + 1;
-
-	for (int i = errorToken->tokenStart; i > 0; i--, errorCharsAwayFromNL++) {
-		if ((*BUFFER)[i - 1] == '\n' || (*BUFFER)[i - 1] == '\0') {
-			break;
-		}
-	}
-
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf("SYNTAX ERROR occured on line ");
-	(void)printf(TEXT_COLOR_BLUE);
-	(void)printf(TEXT_UNDERLINE);
-	(void)printf("%li:%i", errorLine, errorCharsAwayFromNL);
-	(void)printf(TEXT_COLOR_RESET);
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf(" in \"%s\"\n", FILE_NAME);
-	
-	char buffer[32];
-	int tokPos = ((errorToken->tokenStart + 1) - errorCharsAwayFromNL);
-	int blankLength = (int)snprintf(buffer, 32, "%li : %i | ", errorLine, tokPos);
-	(void)printf("%s", buffer);
-	(void)printf(TEXT_COLOR_GRAY);
-
-	for (int i = errorToken->tokenStart - errorCharsAwayFromNL; i < BUFFER_LENGTH; i++) {
-		if ((*BUFFER)[i] == '\n' || (*BUFFER)[i] == '\0') {
-			break;
-		}
-
-		(void)printf("%c", (*BUFFER)[i]);
-	}
-
-	(void)printf("\n");
-	(void)printf(TEXT_COLOR_YELLOW);
-
-	for (int i = 0; i < blankLength + errorCharsAwayFromNL; i++) {
-		(void)printf(" ");
-	}
-
-	for (int i = 0; i < errorToken->size - 1; i++) {
-		(void)printf("^");
-	}
-
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf("\n");
-	(void)printf("    Unexpected token \"%s\",\n", errorToken->value);
-	(void)printf("    maybe replace with \"%s\".\n", expectedToken);
-	(void)printf("\n\n");
-	(void)printf(TEXT_COLOR_RESET);
+	(void)REPORT_DIAGNOSTIC(DIAG_SYNTAX_UNEXPECTED_TOKEN, SEVERITY_ERROR, errorToken->line, errorToken->tokenStart,
+		errorToken->size > 1 ? errorToken->size - 1 : 1, "Unexpected token \"%s\", maybe replace with \"%s\".", errorToken->value, expectedToken);
 }
\ No newline at end of file
@@ -0,0 +1,252 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/codegen.h"
+
+#ifndef _WIN32
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+/**
+ * The subprogram {@code SPACE/src/Runtime/runtime.c} was created
+ * to run the programs, that were translated into assembly
+ * ({@code space --emit-asm}).
+ *
+ * It is linked with the generated assembly, calls the entry function
+ * ({@code space_main}) and prints the values of the globals afterwards,
+ * like {@code space --run}. Runtime errors stop the program.
+ *
+ * The strings are plain C strings, the concatenations are never freed.
+ * A builder keeps its length and capacity in front of its chars, so it
+ * can be passed on like every other string.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+//Stack of the signal handler, the program's stack is full on an overflow
+#define RT_SIGNAL_STACK_SIZE (64 * 1024)
+
+/**
+ * <p>
+ * Header of a builder, the chars follow directly.
+ * </p>
+ */
+struct RTBuilder {
+	size_t length;
+	size_t capacity;
+	char chars[];
+};
+
+//Defined by the generated assembly
+extern struct CGGlobalEntry space_globals[];
+extern long long space_global_count;
+void space_main();
+
+void space_division_by_zero(const char *function, long long line);
+const char *space_string_concat(const char *a, const char *b);
+char *space_string_builder(const char *a);
+char *space_string_append(char *chars, const char *b);
+struct RTBuilder *RT_allocate_builder(struct RTBuilder *builder, size_t capacity);
+void RT_out_of_memory();
+void RT_install_signal_handler();
+void RT_print_globals(FILE *output);
+
+int main() {
+	(void)RT_install_signal_handler();
+	(void)space_main();
+	(void)RT_print_globals(stdout);
+	return EXIT_SUCCESS;
+}
+
+/**
+ * <p>
+ * Stops the program after an integer division by zero, it is called
+ * by the generated code.
+ * </p>
+ *
+ * @param *function Name of the function, that divided
+ * @param line      Line of the division
+ */
+void space_division_by_zero(const char *function, long long line) {
+	(void)fflush(stdout);
+	(void)fprintf(stderr, "RuntimeException: Division by zero in function \"%s\" (line %lld)\n", function, line);
+	(void)fprintf(stderr, "The program was stopped.\n");
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * <p>
+ * Concatenates two strings into a new string (NULL is the empty string).
+ * </p>
+ *
+ * @returns The concatenation
+ *
+ * @param *a    First string
+ * @param *b    Second string
+ */
+const char *space_string_concat(const char *a, const char *b) {
+	size_t left = a == NULL ? 0 : strlen(a);
+	size_t right = b == NULL ? 0 : strlen(b);
+	char *result = (char*)malloc(left + right + 1);
+
+	if (result == NULL) {
+		(void)RT_out_of_memory();
+	}
+
+	(void)memcpy(result, a == NULL ? "" : a, left);
+	(void)memcpy(result + left, b == NULL ? "" : b, right);
+	result[left + right] = '\0';
+	return result;
+}
+
+/**
+ * <p>
+ * Creates a builder with a copy of a string, the string isn't changed.
+ * </p>
+ *
+ * @returns The chars of the builder
+ *
+ * @param *a    String to copy
+ */
+char *space_string_builder(const char *a) {
+	size_t length = a == NULL ? 0 : strlen(a);
+	struct RTBuilder *builder = RT_allocate_builder(NULL, length * 2 > 64 ? length * 2 : 64);
+	(void)memcpy(builder->chars, a == NULL ? "" : a, length + 1);
+	builder->length = length;
+	return builder->chars;
+}
+
+/**
+ * <p>
+ * Appends a string to a builder, the builder doubles its capacity,
+ * if the string doesn't fit.
+ * </p>
+ *
+ * @returns The chars of the builder (they move, if the builder grew)
+ *
+ * @param *chars    Chars of a builder (see space_string_builder)
+ * @param *b        String to append
+ */
+char *space_string_append(char *chars, const char *b) {
+	struct RTBuilder *builder = (struct RTBuilder*)(chars - offsetof(struct RTBuilder, chars));
+	size_t added = b == NULL ? 0 : strlen(b);
+
+	if (builder->length + added > builder->capacity) {
+		builder = RT_allocate_builder(builder, (builder->length + added) * 2);
+	}
+
+	(void)memcpy(builder->chars + builder->length, b == NULL ? "" : b, added + 1);
+	builder->length += added;
+	return builder->chars;
+}
+
+/*
+Purpose: Allocate a builder or grow an existing one (stops the program, if no memory is left)
+Return Type: struct RTBuilder * => The builder with the new capacity
+Params: struct RTBuilder *builder => Builder to grow (NULL = new builder);
+		size_t capacity => Number of chars without the terminating 0
+*/
+struct RTBuilder *RT_allocate_builder(struct RTBuilder *builder, size_t capacity) {
+	struct RTBuilder *grown = (struct RTBuilder*)realloc(builder, sizeof(struct RTBuilder) + capacity + 1);
+
+	if (grown == NULL) {
+		(void)RT_out_of_memory();
+	}
+
+	grown->capacity = capacity;
+	return grown;
+}
+
+void RT_out_of_memory() {
+	(void)fflush(stdout);
+	(void)fprintf(stderr, "RuntimeException: Out of memory\n");
+	(void)fprintf(stderr, "The program was stopped.\n");
+	exit(EXIT_FAILURE);
+}
+
+#ifndef _WIN32
+void RT_signal_handler(int signal) {
+	const char *message = "RuntimeException: Stack overflow (or invalid memory access)\nThe program was stopped.\n";
+	(void)signal;
+	(void)!write(STDERR_FILENO, message, strlen(message));
+	_exit(EXIT_FAILURE);
+}
+#endif
+
+/*
+Purpose: Report a stack overflow instead of crashing silently (the handler runs on its own stack)
+Return Type: void
+*/
+void RT_install_signal_handler() {
+#ifndef _WIN32
+	static char signalStack[RT_SIGNAL_STACK_SIZE];
+	stack_t stack;
+	struct sigaction action;
+
+	(void)memset(&stack, 0, sizeof(stack_t));
+	(void)memset(&action, 0, sizeof(struct sigaction));
+	stack.ss_sp = signalStack;
+	stack.ss_size = sizeof(signalStack);
+	action.sa_handler = RT_signal_handler;
+	action.sa_flags = SA_ONSTACK;
+
+	if (sigaltstack(&stack, NULL) == 0) {
+		(void)sigaction(SIGSEGV, &action, NULL);
+	}
+#endif
+}
+
+/**
+ * <p>
+ * Writes the values of all globals.
+ * </p>
+ *
+ * @param *output   Stream to write to
+ */
+void RT_print_globals(FILE *output) {
+	for (long long i = 0; i < space_global_count; i++) {
+		struct CGGlobalEntry *global = &space_globals[i];
+		(void)fprintf(output, "%s:%s = ", global->name, global->type);
+
+		switch (global->kind) {
+		case CG_KIND_FLOATING:
+			(void)fprintf(output, "%g\n", *(double*)global->value);
+			break;
+		case CG_KIND_BOOLEAN:
+			(void)fprintf(output, "%s\n", *(long long*)global->value != 0 ? "true" : "false");
+			break;
+		case CG_KIND_CHAR:
+			(void)fprintf(output, "'%c'\n", (char)*(long long*)global->value);
+			break;
+		case CG_KIND_STRING:
+			(void)fprintf(output, "\"%s\"\n", *(const char**)global->value == NULL ? "" : *(const char**)global->value);
+			break;
+		default:
+			(void)fprintf(output, "%lld\n", *(long long*)global->value);
+			break;
+		}
+	}
+}
@@ -0,0 +1,804 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../../headers/modules.h"
+#include "../../headers/hashmap.h"
+#include "../../headers/list.h"
+#include "../../headers/parsetree.h"
+#include "../../headers/semantic.h"
+#include "../../headers/stats.h"
+
+/**
+ * The subprogram {@code SPACE/src/SemanticAnalysis/classLayout.c} was
+ * created to compute the runtime layout of the classes.
+ *
+ * After a successful analysis every class gets the offsets of its
+ * fields and its vtable, every interface a range of interface slots
+ * (see ClassLayout). The parents are laid out first, a subclass starts
+ * with the fields and the vtable of its parent. The own fields are
+ * ordered by their size (largest first), so the padding between them
+ * disappears. Overridden methods keep the slot of the parent.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Every object starts with the pointer to its vtable
+#define SA_VTABLE_POINTER_SIZE 8
+#define SA_OBJECT_ALIGNMENT 8
+
+/**
+ * <p>
+ * Gap between the fields, that can still take a smaller field.
+ * </p>
+ */
+struct LayoutHole {
+	size_t offset;
+	size_t size;
+};
+
+size_t SA_collect_layout_entries(SemanticTable *table, enum ScopeType first, enum ScopeType second, SemanticEntry ***entries);
+int SA_layout_class(SemanticTable *mainTable, SemanticTable *classTable, size_t depth);
+void SA_layout_fields(SemanticTable *mainTable, SemanticTable *classTable, struct ClassLayout *layout, struct ClassLayout *parentLayout);
+size_t SA_place_field(struct LayoutHole *holes, size_t *holeCount, size_t *end, size_t size);
+void SA_layout_methods(SemanticTable *classTable, struct ClassLayout *layout, struct ClassLayout *parentLayout);
+int SA_add_layout_interface(struct ClassLayout *layout, SemanticTable *interfaceTable);
+void SA_assign_interface_slots(SemanticEntry **entries, size_t count);
+void SA_fill_interface_slots(struct ClassLayout *layout);
+int SA_find_method_slot(struct ClassLayout *layout, SemanticEntry *method, size_t count);
+int SA_are_signatures_equal(SemanticEntry *first, SemanticEntry *second);
+SemanticTable *SA_get_layout_table(SemanticTable *mainTable, char *name, enum ScopeType type);
+size_t SA_get_field_size(SemanticTable *mainTable, struct VarDec dec, int *reference);
+size_t SA_align_offset(size_t offset, size_t alignment);
+int SA_compare_layout_fields(const void *first, const void *second);
+int SA_compare_field_offsets(const void *first, const void *second);
+int SA_compare_layout_entries(const void *first, const void *second);
+void SA_dump_class_layout(FILE *output, SemanticEntry *entry);
+void FREE_CLASS_LAYOUT(struct ClassLayout *layout);
+
+int SA_are_VarTypes_equal(struct VarDec type1, struct VarDec type2, int strict);
+char *SA_get_VarType_string(struct VarDec type);
+void THROW_MEMORY_RESERVATION_EXCEPTION(char *problemPosition);
+
+/**
+ * <p>
+ * Computes the layouts of all classes and interfaces of the analyzed
+ * file (see ClassLayout).
+ * </p>
+ *
+ * <p>
+ * A class, whose parent or interfaces are external (included files),
+ * doesn't get a layout, since the layout of the external class isn't
+ * known. The bytes of padding, that were saved by the reordering, are
+ * counted by {@code --stats} ({@code savedPadding}).
+ * </p>
+ *
+ * @param *mainTable    MAIN table of the analyzed file
+ */
+void SA_layout_classes(SemanticTable *mainTable) {
+	SemanticEntry **entries = NULL;
+	size_t count = (size_t)SA_collect_layout_entries(mainTable, CLASS, INTERFACE, &entries);
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i]->internalType != INTERFACE) {
+			continue;
+		}
+
+		SemanticTable *interfaceTable = (SemanticTable*)entries[i]->reference;
+		struct ClassLayout *layout = (struct ClassLayout*)calloc(1, sizeof(struct ClassLayout));
+
+		if (layout == NULL) {
+			(void)free(entries);
+			(void)THROW_MEMORY_RESERVATION_EXCEPTION("Interface_Layout");
+			return;
+		}
+
+		//The interface functions are held in the param list (in the order of their declaration)
+		layout->methods = (struct LayoutMethod*)calloc(interfaceTable->paramList->load + 1, sizeof(struct LayoutMethod));
+		interfaceTable->layout = layout;
+
+		if (layout->methods == NULL) {
+			(void)free(entries);
+			(void)THROW_MEMORY_RESERVATION_EXCEPTION("Interface_Layout");
+			return;
+		}
+
+		for (int n = 0; n < interfaceTable->paramList->load; n++) {
+			SemanticEntry *method = (SemanticEntry*)L_get_item(interfaceTable->paramList, n);
+
+			if (method != NULL && method->internalType == FUNCTION) {
+				layout->methods[layout->methodCount++] = (struct LayoutMethod){method, interfaceTable};
+			}
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i]->internalType == CLASS) {
+			(void)SA_layout_class(mainTable, (SemanticTable*)entries[i]->reference, count);
+		}
+	}
+
+	(void)SA_assign_interface_slots(entries, count);
+
+	for (size_t i = 0; i < count; i++) {
+		SemanticTable *table = (SemanticTable*)entries[i]->reference;
+
+		if (entries[i]->internalType == CLASS && table->layout != NULL) {
+			(void)SA_fill_interface_slots(table->layout);
+			(void)ST_count(COUNTER_SAVED_PADDING, table->layout->declaredSize - table->layout->size);
+		}
+	}
+
+	(void)free(entries);
+}
+
+/*
+Purpose: Collect the entries of two types from a table, in the order of their declaration
+Return Type: size_t => Number of collected entries
+Params: SemanticTable *table => Table to collect from;
+		enum ScopeType first => First type to collect;
+		enum ScopeType second => Second type to collect;
+		SemanticEntry ***entries => Receives the entries (has to be freed)
+*/
+size_t SA_collect_layout_entries(SemanticTable *table, enum ScopeType first, enum ScopeType second, SemanticEntry ***entries) {
+	size_t count = 0;
+	*entries = (SemanticEntry**)calloc(table->symbolTable->load + 1, sizeof(SemanticEntry*));
+
+	if (*entries == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("Class_Layout_Entries");
+		return 0;
+	}
+
+	for (int i = 0; i < table->symbolTable->capacity; i++) {
+		for (struct HashMapEntry *entry = table->symbolTable->entries[i]; entry != NULL; entry = entry->linkedEntry) {
+			SemanticEntry *semanticEntry = (SemanticEntry*)entry->value;
+
+			if (semanticEntry == NULL) {
+				continue;
+			} else if (semanticEntry->internalType != first && semanticEntry->internalType != second) {
+				continue;
+			} else if ((semanticEntry->internalType == CLASS || semanticEntry->internalType == INTERFACE) && semanticEntry->reference == NULL) {
+				continue;
+			}
+
+			(*entries)[count++] = semanticEntry;
+		}
+	}
+
+	(void)qsort(*entries, count, sizeof(SemanticEntry*), SA_compare_layout_entries);
+	return count;
+}
+
+/**
+ * <p>
+ * Computes the layout of a class after the layout of its parent.
+ * </p>
+ *
+ * @returns true if the class got a layout, else false
+ *
+ * @param *mainTable    MAIN table of the analyzed file
+ * @param *classTable   Table of the class
+ * @param depth         Number of parents, that may still be laid out (stops cycles)
+ */
+int SA_layout_class(SemanticTable *mainTable, SemanticTable *classTable, size_t depth) {
+	if (classTable->layout != NULL) {
+		return true;
+	} else if (depth == 0) {
+		return false;
+	}
+
+	SemanticTable *parentTable = NULL;
+	struct ClassLayout *layout = (struct ClassLayout*)calloc(1, sizeof(struct ClassLayout));
+
+	if (layout == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("Class_Layout");
+		return false;
+	}
+
+	for (int i = 0; i < classTable->paramList->load; i++) {
+		SemanticEntry *entry = (SemanticEntry*)L_get_item(classTable->paramList, i);
+
+		if (entry == NULL || entry->internalType != CLASS_INHERIT) {
+			continue;
+		}
+
+		parentTable = SA_get_layout_table(mainTable, entry->name, CLASS);
+
+		if (parentTable == NULL || (int)SA_layout_class(mainTable, parentTable, depth - 1) == false) {
+			(void)FREE_CLASS_LAYOUT(layout);
+			return false;
+		}
+	}
+
+	struct ClassLayout *parentLayout = parentTable == NULL ? NULL : parentTable->layout;
+	layout->parent = parentTable;
+
+	for (size_t i = 0; parentLayout != NULL && i < parentLayout->interfaceCount; i++) {
+		(void)SA_add_layout_interface(layout, parentLayout->interfaces[i]);
+	}
+
+	for (int i = 0; i < classTable->paramList->load; i++) {
+		SemanticEntry *entry = (SemanticEntry*)L_get_item(classTable->paramList, i);
+
+		if (entry == NULL || entry->internalType != CLASS_INTERFACE) {
+			continue;
+		}
+
+		SemanticTable *interfaceTable = SA_get_layout_table(mainTable, entry->name, INTERFACE);
+
+		if (interfaceTable == NULL || interfaceTable->layout == NULL) {
+			(void)FREE_CLASS_LAYOUT(layout);
+			return false;
+		}
+
+		(void)SA_add_layout_interface(layout, interfaceTable);
+	}
+
+	(void)SA_layout_fields(mainTable, classTable, layout, parentLayout);
+	(void)SA_layout_methods(classTable, layout, parentLayout);
+	classTable->layout = layout;
+	return true;
+}
+
+/**
+ * <p>
+ * Places the fields of a class behind the fields of its parent.
+ * </p>
+ *
+ * <p>
+ * The own fields are placed from the largest to the smallest (the
+ * references before the other fields of the same size), each one at the
+ * first offset, that is aligned to its size. A gap, that the alignment
+ * leaves open (e.g. behind the last field of the parent), is filled by
+ * the smaller fields.
+ * </p>
+ *
+ * <p>
+ * <strong>Example ({@code char a; long b; short c; int d}):</strong>
+ * ```
+ * declared:  vtable @0, a @8, b @16, c @24, d @28 => 32 bytes
+ * reordered: vtable @0, b @8, d @16, c @20, a @22 => 24 bytes
+ * ```
+ * </p>
+ *
+ * @param *mainTable        MAIN table of the analyzed file
+ * @param *classTable       Table of the class
+ * @param *layout           Layout to fill
+ * @param *parentLayout     Layout of the parent (NULL if the class has no parent)
+ */
+void SA_layout_fields(SemanticTable *mainTable, SemanticTable *classTable, struct ClassLayout *layout, struct ClassLayout *parentLayout) {
+	SemanticEntry **entries = NULL;
+	size_t count = (size_t)SA_collect_layout_entries(classTable, VARIABLE, CLASS_INSTANCE, &entries);
+	size_t inherited = parentLayout == NULL ? 0 : parentLayout->fieldCount;
+	layout->fields = (struct LayoutField*)calloc(inherited + count + 1, sizeof(struct LayoutField));
+	struct LayoutHole *holes = (struct LayoutHole*)calloc(count + 1, sizeof(struct LayoutHole));
+
+	if (layout->fields == NULL || holes == NULL) {
+		(void)free(entries);
+		(void)free(holes);
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("Class_Layout_Fields");
+		return;
+	}
+
+	if (inherited > 0) {
+		(void)memcpy(layout->fields, parentLayout->fields, inherited * sizeof(struct LayoutField));
+	}
+
+	size_t end = parentLayout == NULL ? SA_VTABLE_POINTER_SIZE : parentLayout->dataSize;
+	size_t declared = parentLayout == NULL ? SA_VTABLE_POINTER_SIZE : parentLayout->declaredSize;
+	struct LayoutField *own = &layout->fields[inherited];
+	size_t holeCount = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		own[i].entry = entries[i];
+		own[i].owner = classTable;
+		own[i].size = (size_t)SA_get_field_size(mainTable, entries[i]->dec, &own[i].reference);
+		declared = (size_t)SA_align_offset(declared, own[i].size) + own[i].size;
+	}
+
+	(void)qsort(own, count, sizeof(struct LayoutField), SA_compare_layout_fields);
+
+	for (size_t i = 0; i < count; i++) {
+		own[i].offset = (size_t)SA_place_field(holes, &holeCount, &end, own[i].size);
+	}
+
+	//Own fields can lie in the padding of the parent
+	layout->fieldCount = inherited + count;
+	(void)qsort(layout->fields, layout->fieldCount, sizeof(struct LayoutField), SA_compare_field_offsets);
+	layout->dataSize = end;
+	layout->size = (size_t)SA_align_offset(end, SA_OBJECT_ALIGNMENT);
+	layout->declaredSize = (size_t)SA_align_offset(declared, SA_OBJECT_ALIGNMENT);
+
+	//The declared order never beats the reordering, but the parent might have reused padding
+	layout->declaredSize = layout->declaredSize < layout->size ? layout->size : layout->declaredSize;
+	(void)free(entries);
+	(void)free(holes);
+}
+
+/*
+Purpose: Place a field into the first gap, that fits, or behind the last field
+Return Type: size_t => Offset of the field
+Params: struct LayoutHole *holes => Gaps between the placed fields;
+		size_t *holeCount => Number of gaps;
+		size_t *end => End of the last field;
+		size_t size => Size (and alignment) of the field
+*/
+size_t SA_place_field(struct LayoutHole *holes, size_t *holeCount, size_t *end, size_t size) {
+	for (size_t i = 0; i < *holeCount; i++) {
+		size_t offset = (size_t)SA_align_offset(holes[i].offset, size);
+
+		if (offset + size > holes[i].offset + holes[i].size) {
+			continue;
+		}
+
+		//The gap in front of the field is lost, the fields are placed from the largest to the smallest
+		holes[i].size = holes[i].offset + holes[i].size - offset - size;
+		holes[i].offset = offset + size;
+		return offset;
+	}
+
+	size_t offset = (size_t)SA_align_offset(*end, size);
+
+	if (offset > *end) {
+		holes[*holeCount].offset = *end;
+		holes[*holeCount].size = offset - *end;
+		(*holeCount)++;
+	}
+
+	*end = offset + size;
+	return offset;
+}
+
+/**
+ * <p>
+ * Builds the vtable of a class: the slots of the parent come first, a
+ * method with the same name and parameters as a method of the parent
+ * overrides it in its slot, all other methods are appended in the
+ * order of their declaration. Constructors are called directly and
+ * don't get a slot.
+ * </p>
+ *
+ * @param *classTable       Table of the class
+ * @param *layout           Layout to fill
+ * @param *parentLayout     Layout of the parent (NULL if the class has no parent)
+ */
+void SA_layout_methods(SemanticTable *classTable, struct ClassLayout *layout, struct ClassLayout *parentLayout) {
+	SemanticEntry **entries = NULL;
+	size_t count = (size_t)SA_collect_layout_entries(classTable, FUNCTION, FUNCTION, &entries);
+	size_t inherited = parentLayout == NULL ? 0 : parentLayout->methodCount;
+	layout->methods = (struct LayoutMethod*)calloc(inherited + count + 1, sizeof(struct LayoutMethod));
+
+	if (layout->methods == NULL) {
+		(void)free(entries);
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("Class_Layout_Methods");
+		return;
+	}
+
+	if (inherited > 0) {
+		(void)memcpy(layout->methods, parentLayout->methods, inherited * sizeof(struct LayoutMethod));
+	}
+
+	layout->methodCount = inherited;
+
+	for (size_t i = 0; i < count; i++) {
+		int slot = (int)SA_find_method_slot(layout, entries[i], inherited);
+
+		if (slot >= 0 && (int)SA_are_signatures_equal(layout->methods[slot].entry, entries[i]) == true) {
+			layout->methods[slot] = (struct LayoutMethod){entries[i], classTable};
+			continue;
+		}
+
+		layout->methods[layout->methodCount++] = (struct LayoutMethod){entries[i], classTable};
+	}
+
+	(void)free(entries);
+}
+
+/*
+Purpose: Add an interface to the implemented interfaces of a class (once)
+Return Type: int => true if the interface was added, false if it was already implemented
+Params: struct ClassLayout *layout => Layout of the class;
+		SemanticTable *interfaceTable => Table of the interface
+*/
+int SA_add_layout_interface(struct ClassLayout *layout, SemanticTable *interfaceTable) {
+	for (size_t i = 0; i < layout->interfaceCount; i++) {
+		if (layout->interfaces[i] == interfaceTable) {
+			return false;
+		}
+	}
+
+	SemanticTable **interfaces = (SemanticTable**)realloc(layout->interfaces, (layout->interfaceCount + 1) * sizeof(SemanticTable*));
+
+	if (interfaces == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("Class_Layout_Interfaces");
+		return false;
+	}
+
+	layout->interfaces = interfaces;
+	layout->interfaces[layout->interfaceCount++] = interfaceTable;
+	return true;
+}
+
+/**
+ * <p>
+ * Gives every interface the first of its interface slots.
+ * </p>
+ *
+ * <p>
+ * The interfaces are handled in the order of their declaration. An
+ * interface starts at slot 0 and is moved behind every interface, that
+ * was already placed and is implemented by the same class with an
+ * overlapping range. Interfaces, that are never implemented together,
+ * share their slots, so the interface slots of a class stay small.
+ * </p>
+ *
+ * @param **entries     Classes and interfaces of the file
+ * @param count         Number of entries
+ */
+void SA_assign_interface_slots(SemanticEntry **entries, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i]->internalType == INTERFACE) {
+			((SemanticTable*)entries[i]->reference)->layout->interfaceBase = SIZE_MAX;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (entries[i]->internalType != INTERFACE) {
+			continue;
+		}
+
+		SemanticTable *interfaceTable = (SemanticTable*)entries[i]->reference;
+		struct ClassLayout *interfaceLayout = interfaceTable->layout;
+		size_t base = 0;
+		int moved = true;
+
+		while (moved == true) {
+			moved = false;
+
+			for (size_t n = 0; n < count; n++) {
+				struct ClassLayout *layout = ((SemanticTable*)entries[n]->reference)->layout;
+				int implemented = false;
+
+				if (entries[n]->internalType != CLASS || layout == NULL) {
+					continue;
+				}
+
+				for (size_t k = 0; k < layout->interfaceCount; k++) {
+					implemented = layout->interfaces[k] == interfaceTable ? true : implemented;
+				}
+
+				for (size_t k = 0; implemented == true && k < layout->interfaceCount; k++) {
+					struct ClassLayout *other = layout->interfaces[k]->layout;
+
+					if (other == interfaceLayout || other->interfaceBase == SIZE_MAX) {
+						continue;
+					} else if (base < other->interfaceBase + other->methodCount && other->interfaceBase < base + interfaceLayout->methodCount) {
+						base = other->interfaceBase + other->methodCount;
+						moved = true;
+					}
+				}
+			}
+		}
+
+		interfaceLayout->interfaceBase = base;
+	}
+}
+
+/*
+Purpose: Fill the interface slots of a class with the slots of its vtable
+Return Type: void
+Params: struct ClassLayout *layout => Layout of the class (the interfaces have their slots)
+*/
+void SA_fill_interface_slots(struct ClassLayout *layout) {
+	size_t count = 0;
+
+	for (size_t i = 0; i < layout->interfaceCount; i++) {
+		struct ClassLayout *interfaceLayout = layout->interfaces[i]->layout;
+		size_t end = interfaceLayout->interfaceBase + interfaceLayout->methodCount;
+		count = end > count ? end : count;
+	}
+
+	layout->interfaceSlots = (int*)malloc((count + 1) * sizeof(int));
+	layout->interfaceSlotCount = count;
+
+	if (layout->interfaceSlots == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("Class_Layout_Interface_Slots");
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		layout->interfaceSlots[i] = -1;
+	}
+
+	for (size_t i = 0; i < layout->interfaceCount; i++) {
+		struct ClassLayout *interfaceLayout = layout->interfaces[i]->layout;
+
+		for (size_t n = 0; n < interfaceLayout->methodCount; n++) {
+			int slot = (int)SA_find_method_slot(layout, interfaceLayout->methods[n].entry, layout->methodCount);
+			layout->interfaceSlots[interfaceLayout->interfaceBase + n] = slot;
+		}
+	}
+}
+
+/*
+Purpose: Find the slot of a method in the vtable, a method with the same parameters is preferred
+Return Type: int => Slot of the method or -1 if no method has the name
+Params: struct ClassLayout *layout => Layout with the vtable;
+		SemanticEntry *method => Method to search for;
+		size_t count => Number of slots to search
+*/
+int SA_find_method_slot(struct ClassLayout *layout, SemanticEntry *method, size_t count) {
+	int slot = -1;
+
+	for (size_t i = 0; i < count; i++) {
+		if ((int)strcmp(layout->methods[i].entry->name, method->name) != 0) {
+			continue;
+		} else if ((int)SA_are_signatures_equal(layout->methods[i].entry, method) == true) {
+			return (int)i;
+		}
+
+		//The analysis only checks the names of interface functions
+		slot = slot < 0 ? (int)i : slot;
+	}
+
+	return slot;
+}
+
+/*
+Purpose: Check, if two functions have the same parameter types
+Return Type: int => true if the parameters are equal, else false
+Params: SemanticEntry *first => First function;
+		SemanticEntry *second => Second function
+*/
+int SA_are_signatures_equal(SemanticEntry *first, SemanticEntry *second) {
+	SemanticTable *firstTable = (SemanticTable*)first->reference;
+	SemanticTable *secondTable = (SemanticTable*)second->reference;
+
+	if (firstTable == NULL || secondTable == NULL) {
+		return firstTable == secondTable ? true : false;
+	} else if (firstTable->paramList->load != secondTable->paramList->load) {
+		return false;
+	}
+
+	for (int i = 0; i < firstTable->paramList->load; i++) {
+		SemanticEntry *firstParam = (SemanticEntry*)L_get_item(firstTable->paramList, i);
+		SemanticEntry *secondParam = (SemanticEntry*)L_get_item(secondTable->paramList, i);
+
+		if (firstParam == NULL || secondParam == NULL) {
+			return firstParam == secondParam ? true : false;
+		} else if ((int)SA_are_VarTypes_equal(firstParam->dec, secondParam->dec, true) == false) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Get the table of a class or interface of the analyzed file by its name
+Return Type: SemanticTable * => Table of the class or interface, NULL if it isn't defined in the file
+Params: SemanticTable *mainTable => MAIN table of the analyzed file;
+		char *name => Name of the class or interface;
+		enum ScopeType type => CLASS or INTERFACE
+*/
+SemanticTable *SA_get_layout_table(SemanticTable *mainTable, char *name, enum ScopeType type) {
+	struct HashMapEntry *entry = (struct HashMapEntry*)HM_get_entry(name, mainTable->symbolTable);
+
+	if (entry == NULL || entry->value == NULL) {
+		return NULL;
+	}
+
+	SemanticEntry *semanticEntry = (SemanticEntry*)entry->value;
+	return semanticEntry->internalType == type ? (SemanticTable*)semanticEntry->reference : NULL;
+}
+
+/*
+Purpose: Get the size (and alignment) of a field in bytes
+Return Type: size_t => Size of the field
+Params: SemanticTable *mainTable => MAIN table of the analyzed file;
+		struct VarDec dec => Type of the field;
+		int *reference => Receives, whether the field holds a pointer
+*/
+size_t SA_get_field_size(SemanticTable *mainTable, struct VarDec dec, int *reference) {
+	*reference = false;
+
+	if (dec.dimension == 0) {
+		switch (dec.type) {
+		case CHAR:
+		case BOOLEAN:
+			return 1;
+		case SHORT:
+			return 2;
+		case INTEGER:
+		case FLOAT:
+		case ENUM_REF:
+			return 4;
+		case LONG:
+		case DOUBLE:
+			return 8;
+		case CUSTOM:
+		case CLASS_REF: {
+			//Enumerators are stored as integers
+			struct HashMapEntry *entry = dec.typeName == NULL ? NULL : (struct HashMapEntry*)HM_get_entry(dec.typeName, mainTable->symbolTable);
+
+			if (entry != NULL && entry->value != NULL && ((SemanticEntry*)entry->value)->internalType == ENUM) {
+				return 4;
+			}
+
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	*reference = true;
+	return 8;
+}
+
+/*
+Purpose: Round an offset up to an alignment
+Return Type: size_t => Aligned offset
+Params: size_t offset => Offset to align;
+		size_t alignment => Alignment (power of two)
+*/
+size_t SA_align_offset(size_t offset, size_t alignment) {
+	return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+int SA_compare_layout_fields(const void *first, const void *second) {
+	const struct LayoutField *left = (const struct LayoutField*)first;
+	const struct LayoutField *right = (const struct LayoutField*)second;
+
+	if (left->size != right->size) {
+		return left->size > right->size ? -1 : 1;
+	} else if (left->reference != right->reference) {
+		return left->reference == true ? -1 : 1;
+	}
+
+	return SA_compare_layout_entries(&left->entry, &right->entry);
+}
+
+int SA_compare_field_offsets(const void *first, const void *second) {
+	const struct LayoutField *left = (const struct LayoutField*)first;
+	const struct LayoutField *right = (const struct LayoutField*)second;
+	return left->offset < right->offset ? -1 : left->offset > right->offset ? 1 : 0;
+}
+
+int SA_compare_layout_entries(const void *first, const void *second) {
+	const SemanticEntry *left = *(SemanticEntry *const*)first;
+	const SemanticEntry *right = *(SemanticEntry *const*)second;
+
+	if (left->line != right->line) {
+		return left->line < right->line ? -1 : 1;
+	}
+
+	return left->position < right->position ? -1 : left->position > right->position ? 1 : 0;
+}
+
+/**
+ * <p>
+ * Dumps the layouts of all classes and interfaces ({@code --dump-layout}).
+ * </p>
+ *
+ * <p>
+ * <strong>Layout:</strong>
+ * ```
+ * class Circle extends Base (32 bytes, 40 in declaration order)
+ *     @0      vtable
+ *     @8      id : LONG (Base)
+ *     ...
+ *     [0]     describe (Base)
+ *     [-1]    Shape.area => [1]
+ * ```
+ * </p>
+ *
+ * @param *output       Stream to write to
+ * @param *mainTable    MAIN table of the analyzed file
+ */
+void SA_dump_class_layouts(FILE *output, SemanticTable *mainTable) {
+	SemanticEntry **entries = NULL;
+	size_t count = (size_t)SA_collect_layout_entries(mainTable, CLASS, INTERFACE, &entries);
+
+	for (size_t i = 0; i < count; i++) {
+		(void)SA_dump_class_layout(output, entries[i]);
+	}
+
+	(void)free(entries);
+}
+
+void SA_dump_class_layout(FILE *output, SemanticEntry *entry) {
+	SemanticTable *table = (SemanticTable*)entry->reference;
+	struct ClassLayout *layout = table->layout;
+	char position[32];
+
+	if (entry->internalType == INTERFACE) {
+		(void)fprintf(output, "interface %s (slots %lu - %lu)\n", entry->name, (unsigned long)layout->interfaceBase,
+			(unsigned long)(layout->interfaceBase + layout->methodCount));
+
+		for (size_t i = 0; i < layout->methodCount; i++) {
+			(void)snprintf(position, sizeof(position), "[-%lu]", (unsigned long)(layout->interfaceBase + i + 1));
+			(void)fprintf(output, "    %-8s %s\n", position, layout->methods[i].entry->name);
+		}
+
+		(void)fprintf(output, "\n");
+		return;
+	} else if (layout == NULL) {
+		(void)fprintf(output, "class %s (no layout, the parent or an interface is external)\n\n", entry->name);
+		return;
+	}
+
+	(void)fprintf(output, "class %s%s%s (%lu bytes, %lu in declaration order)\n", entry->name, layout->parent == NULL ? "" : " extends ",
+		layout->parent == NULL ? "" : layout->parent->name, (unsigned long)layout->size, (unsigned long)layout->declaredSize);
+	(void)fprintf(output, "    %-8s vtable\n", "@0");
+
+	for (size_t i = 0; i < layout->fieldCount; i++) {
+		struct LayoutField *field = &layout->fields[i];
+		char *type = SA_get_VarType_string(field->entry->dec);
+		(void)snprintf(position, sizeof(position), "@%lu", (unsigned long)field->offset);
+		(void)fprintf(output, "    %-8s %s : %s (%s)\n", position, field->entry->name, type, field->owner->name);
+		(void)free(type);
+	}
+
+	for (size_t i = 0; i < layout->methodCount; i++) {
+		(void)snprintf(position, sizeof(position), "[%lu]", (unsigned long)i);
+		(void)fprintf(output, "    %-8s %s (%s)\n", position, layout->methods[i].entry->name, layout->methods[i].owner->name);
+	}
+
+	for (size_t i = 0; i < layout->interfaceCount; i++) {
+		struct ClassLayout *interfaceLayout = layout->interfaces[i]->layout;
+
+		for (size_t n = 0; n < interfaceLayout->methodCount; n++) {
+			size_t slot = interfaceLayout->interfaceBase + n;
+			(void)snprintf(position, sizeof(position), "[-%lu]", (unsigned long)(slot + 1));
+			(void)fprintf(output, "    %-8s %s.%s => [%i]\n", position, layout->interfaces[i]->name,
+				interfaceLayout->methods[n].entry->name, layout->interfaceSlots[slot]);
+		}
+	}
+
+	(void)fprintf(output, "\n");
+}
+
+/**
+ * <p>
+ * Frees a layout (the entries and tables belong to the symbol tables).
+ * </p>
+ *
+ * @param *layout   Layout to free
+ */
+void FREE_CLASS_LAYOUT(struct ClassLayout *layout) {
+	if (layout == NULL) {
+		return;
+	}
+
+	(void)free(layout->fields);
+	(void)free(layout->methods);
+	(void)free(layout->interfaces);
+	(void)free(layout->interfaceSlots);
+	(void)free(layout);
+}
@@ -22,6 +22,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <ctype.h>
 #include <time.h>
 #include "../../headers/modules.h"
@@ -30,6 +31,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "../../headers/list.h"
 #include "../../headers/parsetree.h"
 #include "../../headers/semantic.h"
+#include "../../headers/stats.h"
 
 /**
  * <p>
@@ -98,6 +100,116 @@ enum ExternalStatus {
 	NOT_AN_EXTERNAL
 };
 
+/**
+ * <p>
+ * Value of a condition, that is known without running the program.
+ * </p>
+ */
+enum ConstantCondition {
+	CONDITION_FALSE,
+	CONDITION_TRUE,
+	CONDITION_UNKNOWN
+};
+
+#define SA_MAX_KNOWN_DIMENSIONS 4
+#define SA_MAX_KNOWN_NAMES 512
+#define SA_INDEX_RANGE_LIMIT 2147483648LL
+
+/**
+ * <p>
+ * Kind of a name, that is visible while the array indices are checked.
+ * </p>
+ */
+enum KnownNameType {
+	KNOWN_SHADOWED,
+	KNOWN_VALUE,
+	KNOWN_ARRAY
+};
+
+/**
+ * <p>
+ * A declaration, of which the values (constants and loop counters) or the
+ * lengths (arrays, 0 if a dimension isn't known) are known at compile time.
+ * Other declarations only hide the outer declarations with the same name.
+ * </p>
+ */
+struct KnownName {
+	char *name;
+	enum KnownNameType type;
+	long long min;
+	long long max;
+	size_t lengths[SA_MAX_KNOWN_DIMENSIONS];
+};
+
+struct IndexRangeContext {
+	Node *scopeRoot;
+	struct HashMap *changes;
+	struct KnownName names[SA_MAX_KNOWN_NAMES];
+	size_t count;
+	size_t lost;
+};
+
+#define SA_MAX_ESCAPE_PARAMS 64
+#define SA_MAX_CLASS_DEPTH 32
+
+/**
+ * <p>
+ * Result of the escape analysis of a function, method or constructor. A
+ * parameter (or the instance of a method) escapes, if it might be
+ * reachable after the call returned.
+ * </p>
+ */
+struct EscapeSummary {
+	Node *function;
+	Node *classNode;
+	size_t paramCount;
+	unsigned long long escapingParams;
+	int thisEscapes;
+	//Index + 1 of the next function with the same name, 0 if there is none
+	size_t nextWithName;
+};
+
+struct EscapeClass {
+	Node *classNode;
+	size_t firstSummary;
+	size_t summaryCount;
+};
+
+/**
+ * <p>
+ * The maps hold the index of the first function with a name (the others
+ * are linked by the summaries) and the index of each class.
+ * </p>
+ */
+struct EscapeSummaries {
+	struct EscapeSummary *entries;
+	size_t count;
+	struct EscapeClass *classes;
+	size_t classCount;
+	struct HashMap *functionNames;
+	struct HashMap *classNames;
+};
+
+/**
+ * <p>
+ * Object, whose escape is searched: a name or {@code this} (name is NULL).
+ * Calls on an exact object (created with {@code new}) run the methods of
+ * its class, other objects might be instances of a subclass.
+ * </p>
+ */
+struct EscapeQuery {
+	char *name;
+	Node *classNode;
+	int exact;
+	Node *ownerClass;
+};
+
+enum EscapeCallType {
+	ESCAPE_FUNCTION_CALL,
+	ESCAPE_METHOD_CALL,
+	ESCAPE_CONSTRUCTOR_CALL
+};
+
 struct MemberAccessList {
 	size_t size;
 	Node **nodes;
@@ -146,6 +258,56 @@ struct varTypeLookup TYPE_LOOKUP[] = {
 
 void SA_init_globals();
 void SA_manage_runnable(Node *root, SemanticTable *table);
+void SA_eliminate_dead_code(Node *runnable, SemanticTable *table);
+void SA_drop_constant_false_branch(Node *runnable, size_t index);
+void SA_drop_unused_declaration(Node *declarationNode, SemanticTable *table);
+void SA_drop_statement(Node *statement);
+int SA_is_statement_terminating(Node **statements, size_t index);
+int SA_is_runnable_terminating(Node *runnable);
+int SA_contains_break(Node *node);
+enum ConstantCondition SA_evaluate_constant_condition(Node *condition);
+int SA_has_side_effects(Node *node);
+int SA_is_entry_private(SemanticEntry *entry, SemanticTable *table);
+void SA_record_uses(Node *node, SemanticTable *table);
+void SA_report_dead_code(enum DiagnosticCode code, Node *node, char *message, char *explanation, char *suggestion);
+void SA_check_array_bounds(Node *root);
+void SA_check_bounds_in_runnable(struct IndexRangeContext *context, Node *runnable);
+void SA_check_bounds_in_statement(struct IndexRangeContext *context, Node *statement);
+void SA_check_bounds_in_function(struct IndexRangeContext *context, Node *functionNode);
+void SA_check_bounds_in_for(struct IndexRangeContext *context, Node *forNode);
+void SA_check_bounds_in_expression(struct IndexRangeContext *context, Node *node);
+void SA_check_array_access(struct IndexRangeContext *context, Node *arrayNode);
+void SA_add_known_declaration(struct IndexRangeContext *context, Node *declarationNode);
+void SA_get_known_array_lengths(struct IndexRangeContext *context, Node *valueNode, size_t lengths[]);
+int SA_get_counter_range(struct IndexRangeContext *context, Node *forNode, long long *min, long long *max);
+long long SA_get_counter_step(struct IndexRangeContext *context, Node *stepNode, char *name);
+int SA_get_index_range(struct IndexRangeContext *context, Node *node, long long *min, long long *max);
+int SA_get_index_constant(struct IndexRangeContext *context, Node *node, long long *value);
+size_t SA_get_initializer_length(Node *list, size_t dimension);
+size_t SA_get_changed_dimension(struct IndexRangeContext *context, char *name);
+void SA_collect_changed_dimensions(Node *node, struct HashMap *changes);
+void SA_record_changed_dimension(Node *target, size_t offset, struct HashMap *changes);
+int SA_is_counter_assigned(Node *node, char *name);
+int SA_is_plain_identifier(Node *node, char *name);
+struct KnownName *SA_push_known_name(struct IndexRangeContext *context, char *name, enum KnownNameType type);
+struct KnownName *SA_get_known_name(struct IndexRangeContext *context, char *name);
+void SA_build_escape_summaries(Node *root);
+void SA_free_escape_summaries();
+void SA_mark_scoped_instances(Node *runnable, SemanticTable *table);
+int SA_does_escape(struct EscapeQuery *query, Node *node);
+int SA_does_member_access_escape(struct EscapeQuery *query, Node *accessor, int tracked);
+int SA_do_arguments_escape(struct EscapeQuery *query, Node *callNode, enum EscapeCallType type, Node *classNode, int exact);
+int SA_does_callee_escape(enum EscapeCallType type, Node *classNode, Node *ownerClass, char *name, size_t count, int argument, int exact);
+int SA_does_method_escape(Node *classNode, char *name, size_t count, int argument, int exact, int *found);
+int SA_does_constructor_escape(Node *classNode, size_t count, int argument, int depth);
+int SA_does_summary_escape(Node *classNode, int anyClass, char *name, int constructor, size_t count, int argument, int *found);
+int SA_is_escape_target(struct EscapeQuery *query, Node *node);
+Node *SA_get_escape_class(char *name);
+struct EscapeClass *SA_get_escape_class_entry(char *name);
+void SA_add_escape_name(struct HashMap *map, char *name, size_t index);
+Node *SA_get_parent_class(Node *classNode, int *unknown);
+Node *SA_get_escape_body(Node *function);
+Node *SA_get_escape_parameter(Node *function, size_t index);
 void SA_add_parameters_to_runnable_table(SemanticTable *scopeTable, struct ParamTransferObject *params);
 
 struct SemanticReport SA_evaluate_function_call(Node *topNode, SemanticEntry *functionEntry, SemanticTable *callScopeTable, SemanticTable *topNodeTable, enum FunctionCallType fnccType);
@@ -244,6 +406,11 @@ ExternalEntry *SA_create_external_entry(char *fileName, Node *node, enum Externa
 SemanticTable *SA_create_semantic_table(int paramCount, int symbolTableSize, SemanticTable *parent, enum ScopeType type, size_t line, size_t position);
 
 void FREE_TABLE(SemanticTable *rootTable);
+void SA_layout_classes(SemanticTable *mainTable);
+void SA_dump_class_layouts(FILE *output, SemanticTable *mainTable);
+void FREE_CLASS_LAYOUT(struct ClassLayout *layout);
+void SA_dump_symbol_table(FILE *output, SemanticTable *table, int depth);
+void SA_dump_symbol_entry(FILE *output, SemanticEntry *entry, int depth);
 
 struct SemanticReport SA_create_expected_got_report(struct VarDec expected, struct VarDec got, Node *errorNode);
 struct SemanticReport SA_create_already_defined_exception_report(char *collissionName, SemanticTable *currentTable, Node *node);
@@ -275,6 +442,22 @@ extern char *FILE_NAME;
 extern char **BUFFER;
 extern size_t BUFFER_LENGTH;
 
+/**
+ * <p>
+ * Stream for the symbol table dump ({@code --dump-symbols}), NULL if
+ * the tables shouldn't be dumped.
+ * </p>
+ */
+extern FILE *SYMBOL_DUMP;
+
+/**
+ * <p>
+ * Stream for the class layout dump ({@code --dump-layout}), NULL if
+ * the layouts shouldn't be dumped.
+ * </p>
+ */
+extern FILE *LAYOUT_DUMP;
+
 struct VarDec nullDec = {null, 0, NULL, false};
 struct VarDec externalDec = {EXTERNAL_RET, 0, NULL};
 struct ErrorContainer nullCont = {NULL, NULL, NULL};
@@ -289,6 +472,21 @@ struct SemanticReport nullRep;
 struct List *LIST_OF_EXTERNAL_ACCESSES = NULL;
 struct List *LIST_OF_SYMBOL_TABLES = NULL;
 
+/**
+ * <p>
+ * Number of errors thrown in the current analysis.
+ * </p>
+ */
+size_t SEMANTIC_ERROR_COUNT = 0;
+
+/**
+ * <p>
+ * Escape summaries of the functions, methods and constructors of the
+ * analyzed file, built before the runnables are checked.
+ * </p>
+ */
+struct EscapeSummaries ESCAPE_SUMMARIES = {NULL, 0, NULL, 0, NULL, NULL};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -302,205 +500,2012 @@ void DEBUG_print_from_top_node(Node *topNode, int depth, int pos) {
 		return;
 	}
 
-	for (int i = 0; i < depth; ++i) {
-		if (i + 1 == depth) {
-			(void)printf("+-- ");
-		} else {
-			(void)printf("|   ");
+	for (int i = 0; i < depth; ++i) {
+		if (i + 1 == depth) {
+			(void)printf("+-- ");
+		} else {
+			(void)printf("|   ");
+		}
+	}
+
+	if (pos == 0) {
+		(void)printf("C: %s -> %i\n", topNode->value, topNode->type);
+	} else if (pos == 1) {
+		(void)printf("L: %s -> %i\n", topNode->value, topNode->type);
+	} else {
+		(void)printf("R: %s -> %i\n", topNode->value, topNode->type);
+	}
+
+	for (int i = 0; i < topNode->detailsCount; i++) {
+		if (topNode->details[i] != NULL) {
+			for (int n = 0; n < depth + 1; n++) {
+				if (n + 1 == depth + 1) {
+					(void)printf("+-- ");
+				} else {
+					(void)printf("|   ");
+				}
+			}
+
+			(void)printf("(%s) detail: %s -> %i\n", topNode->value, topNode->details[i]->value, topNode->details[i]->type);
+			(void)DEBUG_print_from_top_node(topNode->details[i]->leftNode, depth + 2, 1);
+			(void)DEBUG_print_from_top_node(topNode->details[i]->rightNode, depth + 2, 2);
+
+			for (int n = 0; n < topNode->details[i]->detailsCount; n++) {
+				(void)DEBUG_print_from_top_node(topNode->details[i]->details[n], depth + 2, 0);
+			}
+		} else {
+			(void)printf("(%s) detail: NULL -> NULL\n", topNode->value);
+		}
+	}
+
+	(void)DEBUG_print_from_top_node(topNode->leftNode, depth + 1, 1);
+	(void)DEBUG_print_from_top_node(topNode->rightNode, depth + 1, 2);
+}
+
+/**
+ * <p>
+ * Dumps a symbol table and all tables of its entries (--dump-symbols).
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *table    Table to dump
+ * @param depth     Depth of the table (indentation)
+ */
+void SA_dump_symbol_table(FILE *output, SemanticTable *table, int depth) {
+	if (table == NULL) {
+		return;
+	}
+
+	(void)fprintf(output, "%*s[%s] %s (line %li)\n", depth * 4, "", SA_get_ScopeType_string(table->type),
+		table->name == NULL ? "" : table->name, table->line + 1);
+
+	if (table->paramList != NULL) {
+		for (int i = 0; i < table->paramList->load; i++) {
+			(void)fprintf(output, "%*s(param) ", depth * 4 + 4, "");
+			(void)SA_dump_symbol_entry(output, (SemanticEntry*)L_get_item(table->paramList, i), depth + 1);
+		}
+	}
+
+	for (int i = 0; table->symbolTable != NULL && i < table->symbolTable->capacity; i++) {
+		for (struct HashMapEntry *entry = table->symbolTable->entries[i]; entry != NULL; entry = entry->linkedEntry) {
+			(void)fprintf(output, "%*s", depth * 4 + 4, "");
+			(void)SA_dump_symbol_entry(output, (SemanticEntry*)entry->value, depth + 1);
+		}
+	}
+}
+
+void SA_dump_symbol_entry(FILE *output, SemanticEntry *entry, int depth) {
+	if (entry == NULL) {
+		(void)fprintf(output, "(null)\n");
+		return;
+	}
+
+	char *type = SA_get_VarType_string(entry->dec);
+	(void)fprintf(output, "%s : %s%s [%s] (line %li)%s\n", entry->name == NULL ? "(null)" : entry->name,
+		entry->dec.constant == true ? "const " : "", type,
+		SA_get_ScopeType_string(entry->internalType), entry->line + 1, entry->scoped == true ? " scoped" : "");
+
+	(void)free(type);
+
+	if (entry->reference != NULL && entry->internalType != VARIABLE) {
+		(void)SA_dump_symbol_table(output, (SemanticTable*)entry->reference, depth + 1);
+	}
+}
+
+void DEBUG_print_list(struct List *list, int flag) {
+	if (list == NULL) {
+		return;
+	}
+
+	printf("List@[%p]\n", (void*)list);
+	printf("List Capacity: %li\n", list->size);
+	printf("\n");
+
+	if (flag == 0) {
+		return;
+	}
+
+	printf("%-11s|%-23s|\n", "Index", "VALUES");
+	printf("-----------+-----------------------+\n");
+
+	for (int i = 0; i < list->size; i++) {
+		if (list->entries[i] == NULL) {
+			printf("%11i|%-23s|\n", i, "(null)");
+			continue;
+		}
+
+		ExternalEntry *e = (ExternalEntry*)list->entries[i];
+		printf("%11i|%-23s|\n", i, e->node->value);
+	}
+
+	return;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * <p>
+ * Runs the semantic analysis on the provided parsetree.
+ * </p>
+ * 
+ * <p>
+ * If the caller wants to keep the symbol tables (e.g. the language server
+ * answering lookups afterwards), a pointer has to be passed, which receives
+ * the MAIN table. Else the tables are freed right after the check.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the analysis
+ * 
+ * @param *root         Root node of the parsetree
+ * @param **mainTable   Receives the MAIN table (optional, can be NULL)
+ */
+int CheckSemantic(Node *root, SemanticTable **mainTable) {
+	jmp_buf recoveryPoint;
+
+	//The tables of an aborted analysis can't be reached anymore and are lost
+	if (setjmp(recoveryPoint) != 0) {
+		return PHASE_ABORTED;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	(void)SA_init_globals();
+
+	SemanticTable *table = SA_create_new_scope_table(root, MAIN, NULL, NULL, 0, 0);
+	(void)SA_build_escape_summaries(root);
+	(void)SA_manage_runnable(root, table);
+	(void)SA_free_escape_summaries();
+
+	//The indices and layouts can only be trusted, if all declarations were valid
+	if (SEMANTIC_ERROR_COUNT == 0) {
+		(void)SA_check_array_bounds(root);
+		(void)SA_layout_classes(table);
+	}
+
+	if (SYMBOL_DUMP != NULL) {
+		(void)fprintf(SYMBOL_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    SYMBOLS (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+		(void)SA_dump_symbol_table(SYMBOL_DUMP, table, 0);
+	}
+
+	if (LAYOUT_DUMP != NULL && SEMANTIC_ERROR_COUNT == 0) {
+		(void)fprintf(LAYOUT_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    LAYOUT (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+		(void)SA_dump_class_layouts(LAYOUT_DUMP, table);
+	}
+
+	if (mainTable != NULL) {
+		*mainTable = table;
+	} else {
+		(void)FREE_TABLE(table);
+	}
+
+	if (SEMANTIC_ANALYZER_DEBUG_MODE == 1) {
+		(void)printf(TEXT_COLOR_YELLOW "Total Externals: %li\n" TEXT_COLOR_RESET, LIST_OF_EXTERNAL_ACCESSES->load);
+		(void)DEBUG_print_list(LIST_OF_EXTERNAL_ACCESSES, true);
+	}
+	(void)_init_error_recovery_point_(NULL);
+	return SEMANTIC_ERROR_COUNT == 0 ? PHASE_SUCCESS : PHASE_ERRORS;
+}
+
+void SA_init_globals() {
+	nullRep = SA_create_semantic_report(nullDec, SUCCESS, NULL, NONE, nullCont);
+
+	//The analyzer can run multiple times in one process (language server)
+	if (LIST_OF_EXTERNAL_ACCESSES != NULL) {
+		for (int i = 0; i < LIST_OF_EXTERNAL_ACCESSES->load; i++) {
+			(void)free(LIST_OF_EXTERNAL_ACCESSES->entries[i]);
+		}
+
+		(void)FREE_LIST(LIST_OF_EXTERNAL_ACCESSES);
+	}
+
+	LIST_OF_EXTERNAL_ACCESSES = CreateNewList(16);
+	SEMANTIC_ERROR_COUNT = 0;
+}
+
+void SA_manage_runnable(Node *root, SemanticTable *table) {
+	if (SEMANTIC_ANALYZER_DEBUG_MODE == 1) {
+		(void)printf("Main instructions count: %li\n", root->detailsCount);
+	}
+	
+	for (int i = 0; i < root->detailsCount; i++) {
+		Node *currentNode = root->details[i];
+
+		if (currentNode == NULL) {
+			continue;
+		}
+
+		switch (currentNode->type) {
+		case _VAR_NODE_:
+		case _CONST_NODE_:
+			(void)SA_add_normal_variable_to_table(table, currentNode);
+			break;
+		case _CONDITIONAL_VAR_NODE_:
+		case _CONDITIONAL_CONST_NODE_:
+			(void)SA_add_conditional_variable_to_table(table, currentNode);
+			break;
+		case _FUNCTION_NODE_:
+			(void)SA_add_function_to_table(table, currentNode);
+			break;
+		case _CLASS_NODE_:
+			(void)SA_add_class_to_table(table, currentNode);
+			break;
+		case _VAR_CLASS_INSTANCE_NODE_:
+		case _CONST_CLASS_INSTANCE_NODE_:
+			(void)SA_add_instance_variable_to_table(table, currentNode);
+			break;
+		case _ARRAY_VAR_NODE_:
+		case _ARRAY_CONST_NODE_:
+			(void)SA_add_array_variable_to_table(table, currentNode);
+			break;
+		case _CLASS_CONSTRUCTOR_NODE_:
+			(void)SA_add_constructor_to_table(table, currentNode);
+			break;
+		case _ENUM_NODE_:
+			(void)SA_add_enum_to_table(table, currentNode);
+			break;
+		case _INCLUDE_NODE_:
+			(void)SA_add_include_to_table(table, currentNode);
+			break;
+		case _TRY_NODE_:
+			(void)SA_add_try_statement(table, currentNode, root, i);
+			break;
+		case _CATCH_NODE_:
+			(void)SA_add_catch_statement(table, currentNode, root, i);
+			break;
+		case _FINALLY_STMT_NODE_:
+			(void)SA_add_finally_statement(table, currentNode, root, i);
+			break;
+		case _WHILE_STMT_NODE_:
+		case _DO_STMT_NODE_:
+			(void)SA_add_while_or_do_to_table(table, currentNode);
+			break;
+		case _IF_STMT_NODE_:
+			(void)SA_add_if_to_table(table, currentNode);
+			break;
+		case _ELSE_IF_STMT_NODE_:
+			(void)SA_add_else_if_to_table(table, currentNode, root, i);
+			break;
+		case _ELSE_STMT_NODE_:
+			(void)SA_add_else_to_table(table, currentNode, root, i);
+			break;
+		case _CONTINUE_STMT_NODE_:
+		case _BREAK_STMT_NODE_:
+			(void)SA_check_break_or_continue_to_table(table, currentNode);
+			break;
+		case _RETURN_STMT_NODE_:
+			(void)SA_add_return_to_table(table, currentNode);
+			break;
+		case _FOR_STMT_NODE_:
+			(void)SA_add_for_to_table(table, currentNode);
+			break;
+		case _CHECK_STMT_NODE_:
+			(void)SA_add_check_to_table(table, currentNode);
+			break;
+		case _MEM_CLASS_ACC_NODE_:
+		case _FUNCTION_CALL_NODE_: {
+			struct SemanticReport rep = SA_evaluate_member_access(currentNode, table);
+		
+			if (rep.status == ERROR) {
+				(void)THROW_ASSIGNED_EXCEPTION(rep);
+			}
+		
+			break;
+		}
+		case _SUPER_STMT_NODE_:
+			(void)SA_add_super_statement_to_table(table, currentNode);
+			break;
+		case _INTERFACE_STMT_NODE_:
+			(void)SA_add_interface_to_table(table, currentNode);
+			break;
+		case _PLUS_EQUALS_NODE_:
+		case _MINUS_EQUALS_NODE_:
+    	case _EQUALS_NODE_:
+		case _MULTIPLY_EQUALS_NODE_:
+		case _DIVIDE_EQUALS_NODE_:
+		default:
+			//(void)SA_check_assignments(table, currentNode);
+			//The assignments aren't checked yet, so only their uses are recorded
+			(void)SA_record_uses(currentNode, table);
+			break;
+		}
+	}
+
+	(void)SA_eliminate_dead_code(root, table);
+	(void)SA_mark_scoped_instances(root, table);
+}
+
+/**
+ * <p>
+ * Drops the dead code of a runnable, after all of its statements were checked.
+ * </p>
+ * 
+ * <p>
+ * Statements after a return, break or continue (or after a statement, that
+ * always leaves the runnable), branches with a condition, that is always false,
+ * and private declarations, that are never used, are reported as warnings.
+ * Locals are treated as private, since they can't be reached from outside of
+ * their scope. The uses are counted, when the member accesses are checked.
+ * </p>
+ * 
+ * @param *runnable     Runnable, that was checked
+ * @param *table        Table of the runnable
+ */
+void SA_eliminate_dead_code(Node *runnable, SemanticTable *table) {
+	int terminated = false;
+	int reported = false;
+
+	for (size_t i = 0; i < runnable->detailsCount; i++) {
+		Node *statement = runnable->details[i];
+
+		if (statement == NULL || statement->type == _NULL_) {
+			continue;
+		} else if (terminated == true) {
+			//Only the first unreachable statement is reported
+			if (reported == false) {
+				char *msg = "Unreachable statement";
+				char *exp = "The statement follows a return, break or continue (or a statement, that always leaves the scope), so it is never executed.";
+				char *sugg = "Maybe remove the statement.";
+				(void)SA_report_dead_code(DIAG_SEMANTIC_UNREACHABLE_CODE, statement, msg, exp, sugg);
+				reported = true;
+			}
+
+			(void)SA_drop_statement(statement);
+			continue;
+		}
+
+		(void)SA_drop_constant_false_branch(runnable, i);
+		(void)SA_drop_unused_declaration(statement, table);
+		terminated = (int)SA_is_statement_terminating(runnable->details, i);
+	}
+}
+
+/*
+Purpose: Drop an if, else-if or while with a condition, that is always false
+Return Type: void
+Params: Node *runnable => Runnable, that holds the statement;
+		size_t index => Index of the statement in the runnable
+*/
+void SA_drop_constant_false_branch(Node *runnable, size_t index) {
+	Node *statement = runnable->details[index];
+
+	if (statement->type != _IF_STMT_NODE_
+		&& statement->type != _ELSE_IF_STMT_NODE_
+		&& statement->type != _WHILE_STMT_NODE_) {
+		return;
+	} else if ((enum ConstantCondition)SA_evaluate_constant_condition(statement->leftNode) != CONDITION_FALSE) {
+		return;
+	}
+
+	char *msg = "The condition is always false";
+	char *exp = "The runnable of the statement is never executed.";
+	char *sugg = "Maybe remove the statement or check the condition.";
+	(void)SA_report_dead_code(DIAG_SEMANTIC_CONSTANT_CONDITION, statement->leftNode, msg, exp, sugg);
+
+	Node *next = index + 1 < runnable->detailsCount ? runnable->details[index + 1] : NULL;
+
+	//The following else-if or else still needs the branch, only its runnable is dropped
+	if (statement->type == _WHILE_STMT_NODE_ || next == NULL
+		|| (next->type != _ELSE_IF_STMT_NODE_ && next->type != _ELSE_STMT_NODE_)) {
+		(void)SA_drop_statement(statement);
+		return;
+	} else if (statement->rightNode == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < statement->rightNode->detailsCount; i++) {
+		if (statement->rightNode->details[i] != NULL && statement->rightNode->details[i]->type != _NULL_) {
+			(void)SA_drop_statement(statement->rightNode->details[i]);
+		}
+	}
+}
+
+/*
+Purpose: Report and drop a private declaration (or a local), that is never used
+Return Type: void
+Params: Node *declarationNode => Statement, that might be a declaration;
+		SemanticTable *table => Table of the runnable, that holds the declaration
+*/
+void SA_drop_unused_declaration(Node *declarationNode, SemanticTable *table) {
+	char *kind = NULL;
+	int removable = false;
+
+	switch (declarationNode->type) {
+	case _VAR_NODE_:
+	case _CONST_NODE_:
+	case _CONDITIONAL_VAR_NODE_:
+	case _CONDITIONAL_CONST_NODE_:
+	case _ARRAY_VAR_NODE_:
+	case _ARRAY_CONST_NODE_:
+		//The value is still computed, if the computation has side effects
+		kind = "variable";
+		removable = (int)SA_has_side_effects(declarationNode->rightNode) == true ? false : true;
+		break;
+	case _VAR_CLASS_INSTANCE_NODE_:
+	case _CONST_CLASS_INSTANCE_NODE_:
+		kind = "instance";
+		break;
+	case _FUNCTION_NODE_:
+		kind = "function";
+		removable = true;
+		break;
+	default:
+		return;
+	}
+
+	SemanticEntry *entry = SA_get_entry_if_available(declarationNode->value, table).entry;
+
+	if (entry == NULL || entry->uses > 0 || (int)SA_is_entry_private(entry, table) == false) {
+		return;
+	}
+
+	size_t length = declarationNode->value != NULL ? strlen(declarationNode->value) : 1;
+	(void)REPORT_DIAGNOSTIC(DIAG_SEMANTIC_UNUSED_DECLARATION, SEVERITY_WARNING, declarationNode->line, declarationNode->position, length, "The %s \"%s\" is never used", kind, declarationNode->value);
+	(void)REPORT_DIAGNOSTIC_DETAILS("Private declarations and locals can't be used from outside of their scope.", "Maybe remove the declaration.");
+
+	if (removable == true) {
+		(void)SA_drop_statement(declarationNode);
+	}
+}
+
+/*
+Purpose: Drop a statement, the node stays in the parsetree (the tables still point into it), but isn't lowered
+Return Type: void
+Params: Node *statement => Statement to drop
+*/
+void SA_drop_statement(Node *statement) {
+	statement->type = _NULL_;
+	(void)ST_count(COUNTER_DEAD_STATEMENTS, 1);
+}
+
+/**
+ * <p>
+ * Checks if the control flow never continues after the statement.
+ * </p>
+ * 
+ * <p>
+ * This is the case for return, break and continue, an if chain, that ends
+ * with an else and leaves the runnable in every branch (checked at the
+ * else) and a loop with a condition, that is always true, without a break.
+ * </p>
+ * 
+ * @returns True if the statement leaves the runnable, else false
+ * 
+ * @param **statements  Statements of the runnable
+ * @param index         Index of the statement
+ */
+int SA_is_statement_terminating(Node **statements, size_t index) {
+	Node *statement = statements[index];
+
+	switch (statement->type) {
+	case _RETURN_STMT_NODE_:
+	case _BREAK_STMT_NODE_:
+	case _CONTINUE_STMT_NODE_:
+		return true;
+	case _RUNNABLE_NODE_:
+		return SA_is_runnable_terminating(statement);
+	case _WHILE_STMT_NODE_:
+	case _DO_STMT_NODE_:
+		return (enum ConstantCondition)SA_evaluate_constant_condition(statement->leftNode) == CONDITION_TRUE
+			&& (int)SA_contains_break(statement->rightNode) == false ? true : false;
+	case _ELSE_STMT_NODE_:
+		for (size_t i = index + 1; i > 0; i--) {
+			Node *branch = statements[i - 1];
+
+			if (branch == NULL || (int)SA_is_runnable_terminating(branch->rightNode) == false) {
+				return false;
+			} else if (branch->type == _IF_STMT_NODE_) {
+				return true;
+			} else if (branch->type != _ELSE_IF_STMT_NODE_ && branch->type != _ELSE_STMT_NODE_) {
+				return false;
+			}
+		}
+
+		return false;
+	default:
+		return false;
+	}
+}
+
+int SA_is_runnable_terminating(Node *runnable) {
+	if (runnable == NULL) {
+		return false;
+	}
+
+	for (size_t i = 0; i < runnable->detailsCount; i++) {
+		if (runnable->details[i] != NULL && runnable->details[i]->type != _NULL_
+			&& (int)SA_is_statement_terminating(runnable->details, i) == true) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+Purpose: Check if a break leaves the loop, that holds the node (breaks of inner loops are skipped)
+Return Type: int => true if a break was found, else false
+Params: Node *node => Node to search in
+*/
+int SA_contains_break(Node *node) {
+	if (node == NULL || node->type == _NULL_) {
+		return false;
+	}
+
+	switch (node->type) {
+	case _BREAK_STMT_NODE_:
+		return true;
+	case _WHILE_STMT_NODE_:
+	case _DO_STMT_NODE_:
+	case _FOR_STMT_NODE_:
+		return false;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		if ((int)SA_contains_break(node->details[i]) == true) {
+			return true;
+		}
+	}
+
+	return (int)SA_contains_break(node->leftNode) == true || (int)SA_contains_break(node->rightNode) == true ? true : false;
+}
+
+/**
+ * <p>
+ * Evaluates a condition, that only consists of the literals
+ * {@code true} and {@code false}.
+ * </p>
+ * 
+ * <p>
+ * Examples:
+ * ```
+ * false
+ * !true
+ * false and x > 2
+ * true == false
+ * ```
+ * </p>
+ * 
+ * @returns The value of the condition or CONDITION_UNKNOWN, if it depends on the program
+ * 
+ * @param *condition    Condition to evaluate
+ */
+enum ConstantCondition SA_evaluate_constant_condition(Node *condition) {
+	if (condition == NULL) {
+		return CONDITION_UNKNOWN;
+	}
+
+	switch (condition->type) {
+	case _BOOL_NODE_:
+		return (int)strcmp(condition->value, "true") == 0 ? CONDITION_TRUE : CONDITION_FALSE;
+	case _NOT_NODE_: {
+		enum ConstantCondition operand = SA_evaluate_constant_condition(condition->rightNode != NULL ? condition->rightNode : condition->leftNode);
+		return operand == CONDITION_UNKNOWN ? CONDITION_UNKNOWN : (operand == CONDITION_TRUE ? CONDITION_FALSE : CONDITION_TRUE);
+	}
+	case _AND_NODE_:
+	case _OR_NODE_: {
+		enum ConstantCondition left = SA_evaluate_constant_condition(condition->leftNode);
+		enum ConstantCondition right = SA_evaluate_constant_condition(condition->rightNode);
+		enum ConstantCondition decisive = condition->type == _AND_NODE_ ? CONDITION_FALSE : CONDITION_TRUE;
+
+		if (left == decisive || right == decisive) {
+			return decisive;
+		}
+
+		return left == CONDITION_UNKNOWN || right == CONDITION_UNKNOWN ? CONDITION_UNKNOWN : left;
+	}
+	case _EQUALS_CONDITION_NODE_:
+	case _NOT_EQUALS_CONDITION_NODE_: {
+		enum ConstantCondition left = SA_evaluate_constant_condition(condition->leftNode);
+		enum ConstantCondition right = SA_evaluate_constant_condition(condition->rightNode);
+
+		if (left == CONDITION_UNKNOWN || right == CONDITION_UNKNOWN) {
+			return CONDITION_UNKNOWN;
+		}
+
+		return (left == right) == (condition->type == _EQUALS_CONDITION_NODE_) ? CONDITION_TRUE : CONDITION_FALSE;
+	}
+	default:
+		return CONDITION_UNKNOWN;
+	}
+}
+
+/*
+Purpose: Check if the evaluation of an expression changes the state of the program (calls and increments)
+Return Type: int => true if the expression has side effects, else false
+Params: Node *node => Expression to check
+*/
+int SA_has_side_effects(Node *node) {
+	if (node == NULL) {
+		return false;
+	}
+
+	switch (node->type) {
+	case _FUNCTION_CALL_NODE_:
+	case _INCREMENT_ONE_NODE_:
+	case _DECREMENT_ONE_NODE_:
+	case _SIMPLE_INC_DEC_ASS_NODE_:
+		return true;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		if ((int)SA_has_side_effects(node->details[i]) == true) {
+			return true;
+		}
+	}
+
+	return (int)SA_has_side_effects(node->leftNode) == true || (int)SA_has_side_effects(node->rightNode) == true ? true : false;
+}
+
+/*
+Purpose: Check if an entry can only be used in the scope of its table
+Return Type: int => true if the entry is private or a local, else false
+Params: SemanticEntry *entry => Entry to check;
+		SemanticTable *table => Table, that holds the entry
+*/
+int SA_is_entry_private(SemanticEntry *entry, SemanticTable *table) {
+	if (entry->visibility == PRIVATE) {
+		return true;
+	}
+
+	switch (table->type) {
+	case MAIN:
+	case CLASS:
+	case INTERFACE:
+	case ENUM:
+		return false;
+	default:
+		return true;
+	}
+}
+
+/*
+Purpose: Count the uses of all identifiers in a statement, that isn't checked, every declaration with the name counts (e.g. "this->x" and a local "x")
+Return Type: void
+Params: Node *node => Node of the statement;
+		SemanticTable *table => Table of the runnable, that holds the statement
+*/
+void SA_record_uses(Node *node, SemanticTable *table) {
+	if (node == NULL) {
+		return;
+	} else if (node->value != NULL && (node->type == _IDEN_NODE_ || node->type == _FUNCTION_CALL_NODE_)) {
+		for (SemanticTable *scope = table; scope != NULL; scope = scope->parent) {
+			SemanticEntry *entry = SA_get_entry_if_available(node->value, scope).entry;
+
+			if (entry != NULL) {
+				entry->uses++;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		(void)SA_record_uses(node->details[i], table);
+	}
+
+	(void)SA_record_uses(node->leftNode, table);
+	(void)SA_record_uses(node->rightNode, table);
+}
+
+void SA_report_dead_code(enum DiagnosticCode code, Node *node, char *message, char *explanation, char *suggestion) {
+	size_t length = node->value != NULL ? strlen(node->value) : 1;
+	(void)REPORT_DIAGNOSTIC(code, SEVERITY_WARNING, node->line, node->position, length, "%s", message);
+	(void)REPORT_DIAGNOSTIC_DETAILS(explanation, suggestion);
+}
+
+/**
+ * <p>
+ * Checks the indices of the array accesses against the lengths of the
+ * arrays, that are known at compile time.
+ * </p>
+ * 
+ * <p>
+ * The lengths are known for arrays, that are created with constant sizes
+ * ({@code new int[10]}) or an initializer list and whose dimensions are
+ * never replaced. An index gets a range of values, if it only consists of
+ * number literals, {@code const} integers and counters of {@code for} loops
+ * with a constant start, bound and step, that aren't changed in the loop
+ * (combined by +, - and *). An index, that always lies within the array,
+ * doesn't need a bounds check (it's marked on the access and counted as
+ * provenIndices), an index, that always lies outside of the array, is
+ * reported as a warning.
+ * </p>
+ * 
+ * @param *root     Root of the parsetree (top level statements)
+ */
+void SA_check_array_bounds(Node *root) {
+	struct IndexRangeContext *context = (struct IndexRangeContext*)calloc(1, sizeof(struct IndexRangeContext));
+
+	if (context == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("IndexRangeContext");
+		return;
+	}
+
+	context->scopeRoot = root;
+	(void)SA_check_bounds_in_runnable(context, root);
+	(void)HM_free(context->changes);
+	(void)free(context);
+}
+
+void SA_check_bounds_in_runnable(struct IndexRangeContext *context, Node *runnable) {
+	size_t count = context->count;
+	size_t lost = context->lost;
+
+	for (size_t i = 0; i < runnable->detailsCount; i++) {
+		(void)SA_check_bounds_in_statement(context, runnable->details[i]);
+	}
+
+	//The declarations of the runnable aren't visible anymore
+	context->count = count;
+	context->lost = lost;
+}
+
+void SA_check_bounds_in_statement(struct IndexRangeContext *context, Node *statement) {
+	if (statement == NULL || statement->type == _NULL_) {
+		return;
+	}
+
+	switch (statement->type) {
+	case _CLASS_NODE_:
+	case _INTERFACE_STMT_NODE_:
+	case _ENUM_NODE_:
+		//The names in a class might be attributes, which every method can change
+		return;
+	case _FUNCTION_NODE_:
+		(void)SA_check_bounds_in_function(context, statement);
+		return;
+	case _FOR_STMT_NODE_:
+		(void)SA_check_bounds_in_for(context, statement);
+		return;
+	case _VAR_NODE_:
+	case _CONST_NODE_:
+	case _CONDITIONAL_VAR_NODE_:
+	case _CONDITIONAL_CONST_NODE_:
+	case _ARRAY_VAR_NODE_:
+	case _ARRAY_CONST_NODE_:
+	case _VAR_CLASS_INSTANCE_NODE_:
+	case _CONST_CLASS_INSTANCE_NODE_:
+		(void)SA_check_bounds_in_expression(context, statement->rightNode);
+		(void)SA_add_known_declaration(context, statement);
+		return;
+	default:
+		(void)SA_check_bounds_in_expression(context, statement);
+		return;
+	}
+}
+
+/*
+Purpose: Check the accesses of a function, the parameters hide the outer declarations with the same name
+Return Type: void
+Params: struct IndexRangeContext *context => Known names;
+		Node *functionNode => Function to check
+*/
+void SA_check_bounds_in_function(struct IndexRangeContext *context, Node *functionNode) {
+	Node *runnable = functionNode->detailsCount > 0 ? functionNode->details[functionNode->detailsCount - 1] : NULL;
+
+	if (runnable == NULL || runnable->type != _RUNNABLE_NODE_) {
+		return;
+	}
+
+	size_t count = context->count;
+	size_t lost = context->lost;
+	Node *scopeRoot = context->scopeRoot;
+	struct HashMap *changes = context->changes;
+
+	for (size_t i = 0; i + 1 < functionNode->detailsCount; i++) {
+		if (functionNode->details[i] != NULL) {
+			(void)SA_push_known_name(context, functionNode->details[i]->value, KNOWN_SHADOWED);
+		}
+	}
+
+	context->scopeRoot = runnable;
+	context->changes = NULL;
+	(void)SA_check_bounds_in_runnable(context, runnable);
+	(void)HM_free(context->changes);
+	context->scopeRoot = scopeRoot;
+	context->changes = changes;
+	context->count = count;
+	context->lost = lost;
+}
+
+/*
+Purpose: Check the accesses of a for loop, the counter gets its range only in the runnable of the loop
+Return Type: void
+Params: struct IndexRangeContext *context => Known names;
+		Node *forNode => Loop to check
+*/
+void SA_check_bounds_in_for(struct IndexRangeContext *context, Node *forNode) {
+	size_t count = context->count;
+	size_t lost = context->lost;
+	Node *counter = forNode->leftNode;
+	long long min = 0;
+	long long max = 0;
+	int known = (int)SA_get_counter_range(context, forNode, &min, &max);
+
+	if (counter != NULL) {
+		(void)SA_check_bounds_in_expression(context, counter->rightNode);
+		(void)SA_push_known_name(context, counter->value, KNOWN_SHADOWED);
+	}
+
+	//The condition and the step also see the value after the last iteration
+	for (size_t i = 0; i < forNode->detailsCount; i++) {
+		(void)SA_check_bounds_in_expression(context, forNode->details[i]);
+	}
+
+	if (known == true) {
+		struct KnownName *name = SA_push_known_name(context, counter->value, KNOWN_VALUE);
+
+		if (name != NULL) {
+			name->min = min;
+			name->max = max;
+		}
+	}
+
+	(void)SA_check_bounds_in_expression(context, forNode->rightNode);
+	context->count = count;
+	context->lost = lost;
+}
+
+void SA_check_bounds_in_expression(struct IndexRangeContext *context, Node *node) {
+	if (node == NULL || node->type == _NULL_) {
+		return;
+	}
+
+	switch (node->type) {
+	case _RUNNABLE_NODE_:
+		(void)SA_check_bounds_in_runnable(context, node);
+		return;
+	case _MEM_CLASS_ACC_NODE_:
+	case _CLASS_ACCESS_NODE_:
+		//Only the first name of a member access is a local or a global
+		(void)SA_check_bounds_in_expression(context, node->leftNode);
+		return;
+	case _IDEN_NODE_:
+		if (node->leftNode != NULL && node->leftNode->type == _ARRAY_ACCESS_NODE_) {
+			(void)SA_check_array_access(context, node);
+		}
+
+		break;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		(void)SA_check_bounds_in_expression(context, node->details[i]);
+	}
+
+	(void)SA_check_bounds_in_expression(context, node->leftNode);
+	(void)SA_check_bounds_in_expression(context, node->rightNode);
+}
+
+/*
+Purpose: Compare the indices of an access with the known lengths of the array (one index per dimension)
+Return Type: void
+Params: struct IndexRangeContext *context => Known names;
+		Node *arrayNode => Identifier of the array, that holds the accesses
+*/
+void SA_check_array_access(struct IndexRangeContext *context, Node *arrayNode) {
+	struct KnownName *array = SA_get_known_name(context, arrayNode->value);
+
+	if (array == NULL || array->type != KNOWN_ARRAY) {
+		return;
+	}
+
+	Node *access = arrayNode->leftNode;
+
+	for (size_t dimension = 0; dimension < SA_MAX_KNOWN_DIMENSIONS; dimension++) {
+		if (access == NULL || access->type != _ARRAY_ACCESS_NODE_) {
+			return;
+		}
+
+		long long length = (long long)array->lengths[dimension];
+		long long min = 0;
+		long long max = 0;
+
+		if (length == 0 || (int)SA_get_index_range(context, access->leftNode, &min, &max) == false) {
+			access = access->rightNode;
+			continue;
+		}
+
+		if (min >= 0 && max < length) {
+			access->provenIndex = true;
+			(void)ST_count(COUNTER_PROVEN_INDICES, 1);
+		} else if (max < 0 || min >= length) {
+			char explanation[DIAGNOSTIC_MAX_NOTE_LENGTH];
+
+			if (min == max) {
+				(void)snprintf(explanation, sizeof(explanation), "The dimension has a length of %lld, but the index is %lld.", length, min);
+			} else {
+				(void)snprintf(explanation, sizeof(explanation), "The dimension has a length of %lld, but the index is always between %lld and %lld.", length, min, max);
+			}
+
+			(void)REPORT_DIAGNOSTIC(DIAG_SEMANTIC_INDEX_OUT_OF_BOUNDS, SEVERITY_WARNING, arrayNode->line, arrayNode->position, strlen(arrayNode->value), "The index of \"%s\" is always out of bounds", arrayNode->value);
+			(void)REPORT_DIAGNOSTIC_DETAILS(explanation, "Maybe check the index or the size of the array.");
+		}
+
+		access = access->rightNode;
+	}
+}
+
+/*
+Purpose: Make a declaration visible, constants and arrays with known lengths keep their values
+Return Type: void
+Params: struct IndexRangeContext *context => Known names;
+		Node *declarationNode => Declaration to add
+*/
+void SA_add_known_declaration(struct IndexRangeContext *context, Node *declarationNode) {
+	long long value = 0;
+
+	if (declarationNode->type == _CONST_NODE_
+		&& (int)SA_get_index_constant(context, declarationNode->rightNode, &value) == true) {
+		struct KnownName *constant = SA_push_known_name(context, declarationNode->value, KNOWN_VALUE);
+
+		if (constant != NULL) {
+			constant->min = value;
+			constant->max = value;
+		}
+
+		return;
+	} else if (declarationNode->type != _ARRAY_VAR_NODE_ && declarationNode->type != _ARRAY_CONST_NODE_) {
+		(void)SA_push_known_name(context, declarationNode->value, KNOWN_SHADOWED);
+		return;
+	}
+
+	struct KnownName *array = SA_push_known_name(context, declarationNode->value, KNOWN_ARRAY);
+
+	if (array == NULL) {
+		return;
+	}
+
+	(void)SA_get_known_array_lengths(context, declarationNode->rightNode, array->lengths);
+	size_t changed = (size_t)SA_get_changed_dimension(context, declarationNode->value);
+
+	for (size_t i = changed; i < SA_MAX_KNOWN_DIMENSIONS; i++) {
+		array->lengths[i] = 0;
+	}
+}
+
+void SA_get_known_array_lengths(struct IndexRangeContext *context, Node *valueNode, size_t lengths[]) {
+	if (valueNode == NULL) {
+		return;
+	} else if (valueNode->type == _ARRAY_ASSIGNMENT_NODE_) {
+		for (size_t i = 0; i < SA_MAX_KNOWN_DIMENSIONS; i++) {
+			lengths[i] = (size_t)SA_get_initializer_length(valueNode, i);
+		}
+
+		return;
+	} else if (valueNode->type != _ARRAY_CREATION_NODE_) {
+		return;
+	}
+
+	for (size_t i = 0; i < valueNode->detailsCount && i < SA_MAX_KNOWN_DIMENSIONS; i++) {
+		long long length = 0;
+
+		if ((int)SA_get_index_constant(context, valueNode->details[i], &length) == true && length > 0) {
+			lengths[i] = (size_t)length;
+		}
+	}
+}
+
+/*
+Purpose: Get the number of elements of the lists in a dimension of an initializer list
+Return Type: size_t => Number of elements, 0 if the lists of the dimension have different lengths
+Params: Node *list => Initializer list;
+		size_t dimension => Dimension below the list
+*/
+size_t SA_get_initializer_length(Node *list, size_t dimension) {
+	if (list == NULL || list->type != _ARRAY_ASSIGNMENT_NODE_) {
+		return 0;
+	} else if (dimension == 0) {
+		return list->detailsCount;
+	}
+
+	size_t length = 0;
+
+	for (size_t i = 0; i < list->detailsCount; i++) {
+		size_t subLength = (size_t)SA_get_initializer_length(list->details[i], dimension - 1);
+
+		if (subLength == 0 || (i > 0 && subLength != length)) {
+			return 0;
+		}
+
+		length = subLength;
+	}
+
+	return length;
+}
+
+/**
+ * <p>
+ * Computes the values, that the counter of a for loop takes in the runnable.
+ * </p>
+ * 
+ * <p>
+ * The counter has to start at a constant, it is compared with a constant
+ * bound ({@code <, <=, >, >=}) and changed by a constant step towards the
+ * bound ({@code i++, i--, i += c, i -= c, i = i + c, i = i - c}). The
+ * runnable must not assign the counter.
+ * </p>
+ * 
+ * @returns True if the range is known, else false
+ * 
+ * @param *context      Known names
+ * @param *forNode      Loop of the counter
+ * @param *min          Smallest value of the counter
+ * @param *max          Biggest value of the counter
+ */
+int SA_get_counter_range(struct IndexRangeContext *context, Node *forNode, long long *min, long long *max) {
+	Node *counter = forNode->leftNode;
+
+	if (counter == NULL || counter->type != _VAR_NODE_ || forNode->detailsCount < 2 || forNode->details[0] == NULL) {
+		return false;
+	}
+
+	Node *condition = forNode->details[0];
+	long long start = 0;
+	long long bound = 0;
+	long long last = 0;
+
+	if ((int)SA_get_index_constant(context, counter->rightNode, &start) == false
+		|| (int)SA_is_plain_identifier(condition->leftNode, counter->value) == false
+		|| (int)SA_get_index_constant(context, condition->rightNode, &bound) == false) {
+		return false;
+	}
+
+	long long step = (long long)SA_get_counter_step(context, forNode->details[1], counter->value);
+
+	if (step == 0 || (int)SA_is_counter_assigned(forNode->rightNode, counter->value) == true) {
+		return false;
+	}
+
+	switch (condition->type) {
+	case _SMALLER_CONDITION_NODE_:
+		last = bound - 1;
+		break;
+	case _SMALLER_OR_EQUAL_CONDITION_NODE_:
+	case _GREATER_OR_EQUAL_CONDITION_NODE_:
+		last = bound;
+		break;
+	case _GREATER_CONDITION_NODE_:
+		last = bound + 1;
+		break;
+	default:
+		return false;
+	}
+
+	int upwards = condition->type == _SMALLER_CONDITION_NODE_ || condition->type == _SMALLER_OR_EQUAL_CONDITION_NODE_ ? true : false;
+
+	//A counter, that moves away from the bound, wraps around (loops without iterations are skipped)
+	if (upwards == true && step > 0 && last >= start) {
+		*min = start;
+		*max = start + (last - start) / step * step;
+		return true;
+	} else if (upwards == false && step < 0 && last <= start) {
+		*min = start - (start - last) / -step * -step;
+		*max = start;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+Purpose: Get the constant step of a for loop
+Return Type: long long => Value, that is added to the counter, 0 if it isn't constant
+Params: struct IndexRangeContext *context => Known names;
+		Node *stepNode => Step of the loop;
+		char *name => Name of the counter
+*/
+long long SA_get_counter_step(struct IndexRangeContext *context, Node *stepNode, char *name) {
+	long long step = 0;
+
+	if (stepNode == NULL) {
+		return 0;
+	}
+
+	switch (stepNode->type) {
+	case _SIMPLE_INC_DEC_ASS_NODE_:
+		if (stepNode->detailsCount == 0 || (int)SA_is_plain_identifier(stepNode->details[0], name) == false
+			|| stepNode->rightNode == NULL) {
+			return 0;
+		}
+
+		return stepNode->rightNode->type == _INCREMENT_ONE_NODE_ ? 1 : (stepNode->rightNode->type == _DECREMENT_ONE_NODE_ ? -1 : 0);
+	case _PLUS_EQUALS_NODE_:
+	case _MINUS_EQUALS_NODE_:
+		if ((int)SA_is_plain_identifier(stepNode->leftNode, name) == false
+			|| (int)SA_get_index_constant(context, stepNode->rightNode, &step) == false) {
+			return 0;
+		}
+
+		return stepNode->type == _PLUS_EQUALS_NODE_ ? step : -step;
+	case _EQUALS_NODE_: {
+		Node *term = stepNode->rightNode;
+
+		if ((int)SA_is_plain_identifier(stepNode->leftNode, name) == false || term == NULL
+			|| (term->type != _PLUS_NODE_ && term->type != _MINUS_NODE_)
+			|| (int)SA_is_plain_identifier(term->leftNode, name) == false
+			|| (int)SA_get_index_constant(context, term->rightNode, &step) == false) {
+			return 0;
+		}
+
+		return term->type == _PLUS_NODE_ ? step : -step;
+	}
+	default:
+		return 0;
+	}
+}
+
+/**
+ * <p>
+ * Computes the smallest and the biggest value of an index.
+ * </p>
+ * 
+ * <p>
+ * The values are limited to 32 bits, so the interval arithmetic can't
+ * overflow and the index can't wrap around at runtime.
+ * </p>
+ * 
+ * @returns True if the range is known, else false
+ * 
+ * @param *context      Known names
+ * @param *node         Index to evaluate
+ * @param *min          Smallest value of the index
+ * @param *max          Biggest value of the index
+ */
+int SA_get_index_range(struct IndexRangeContext *context, Node *node, long long *min, long long *max) {
+	if (node == NULL) {
+		return false;
+	}
+
+	switch (node->type) {
+	case _NUMBER_NODE_: {
+		char *end = NULL;
+		*min = strtoll(node->value, &end, 10);
+		*max = *min;
+
+		if (end == node->value || *end != '\0') {
+			return false;
+		}
+
+		break;
+	}
+	case _IDEN_NODE_: {
+		struct KnownName *known = node->leftNode == NULL && node->rightNode == NULL ? SA_get_known_name(context, node->value) : NULL;
+
+		if (known == NULL || known->type != KNOWN_VALUE) {
+			return false;
+		}
+
+		*min = known->min;
+		*max = known->max;
+		break;
+	}
+	case _PLUS_NODE_:
+	case _MINUS_NODE_:
+	case _MULTIPLY_NODE_: {
+		long long leftMin = 0;
+		long long leftMax = 0;
+		long long rightMin = 0;
+		long long rightMax = 0;
+
+		if ((int)SA_get_index_range(context, node->leftNode, &leftMin, &leftMax) == false
+			|| (int)SA_get_index_range(context, node->rightNode, &rightMin, &rightMax) == false) {
+			return false;
+		}
+
+		if (node->type == _PLUS_NODE_) {
+			*min = leftMin + rightMin;
+			*max = leftMax + rightMax;
+		} else if (node->type == _MINUS_NODE_) {
+			*min = leftMin - rightMax;
+			*max = leftMax - rightMin;
+		} else {
+			long long products[4] = {leftMin * rightMin, leftMin * rightMax, leftMax * rightMin, leftMax * rightMax};
+			*min = products[0];
+			*max = products[0];
+
+			for (int i = 1; i < 4; i++) {
+				*min = products[i] < *min ? products[i] : *min;
+				*max = products[i] > *max ? products[i] : *max;
+			}
+		}
+
+		break;
+	}
+	default:
+		return false;
+	}
+
+	return *min >= -SA_INDEX_RANGE_LIMIT && *max <= SA_INDEX_RANGE_LIMIT ? true : false;
+}
+
+int SA_get_index_constant(struct IndexRangeContext *context, Node *node, long long *value) {
+	long long max = 0;
+
+	if ((int)SA_get_index_range(context, node, value, &max) == false || *value != max) {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Gets the lowest dimension of an array, whose length might change in
+ * the scope of the array.
+ * </p>
+ * 
+ * <p>
+ * The changed dimensions of all names are collected in one pass over the
+ * scope (the top level statements or the function), when the first array
+ * of the scope is declared.
+ * </p>
+ * 
+ * @returns The lowest dimension, that might change, SA_MAX_KNOWN_DIMENSIONS if none
+ * 
+ * @param *context  Known names
+ * @param *name     Name of the array
+ */
+size_t SA_get_changed_dimension(struct IndexRangeContext *context, char *name) {
+	if (context->changes == NULL) {
+		context->changes = CreateNewHashMap(64);
+		(void)SA_collect_changed_dimensions(context->scopeRoot, context->changes);
+	}
+
+	struct HashMapEntry *entry = HM_get_entry(name, context->changes);
+	return entry != NULL ? *(size_t*)entry->value : SA_MAX_KNOWN_DIMENSIONS;
+}
+
+/**
+ * <p>
+ * Records the dimensions, that might be replaced in the node.
+ * </p>
+ * 
+ * <p>
+ * An assignment replaces the dimension of its last index ({@code a = ...}
+ * the whole array, {@code a[i] = ...} the second dimension). A read array
+ * (or sub array) might be passed on, so the dimensions below it can be
+ * replaced through the reference. Every name counts, even if it belongs to
+ * another declaration.
+ * </p>
+ * 
+ * @param *node     Node to search in
+ * @param *changes  Lowest changed dimension of every name
+ */
+void SA_collect_changed_dimensions(Node *node, struct HashMap *changes) {
+	if (node == NULL) {
+		return;
+	}
+
+	switch (node->type) {
+	case _IDEN_NODE_:
+		(void)SA_record_changed_dimension(node, 1, changes);
+		break;
+	case _EQUALS_NODE_:
+	case _PLUS_EQUALS_NODE_:
+	case _MINUS_EQUALS_NODE_:
+	case _MULTIPLY_EQUALS_NODE_:
+	case _DIVIDE_EQUALS_NODE_:
+		(void)SA_record_changed_dimension(node->leftNode, 0, changes);
+		break;
+	case _SIMPLE_INC_DEC_ASS_NODE_:
+	case _INCREMENT_ONE_NODE_:
+	case _DECREMENT_ONE_NODE_:
+		(void)SA_record_changed_dimension(node->leftNode, 0, changes);
+		(void)SA_record_changed_dimension(node->rightNode, 0, changes);
+		(void)SA_record_changed_dimension(node->detailsCount > 0 ? node->details[0] : NULL, 0, changes);
+		break;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		(void)SA_collect_changed_dimensions(node->details[i], changes);
+	}
+
+	(void)SA_collect_changed_dimensions(node->leftNode, changes);
+	(void)SA_collect_changed_dimensions(node->rightNode, changes);
+}
+
+/*
+Purpose: Record the dimension behind the indices of an identifier as changed (the offset is added)
+Return Type: void
+Params: Node *target => Identifier, that might be changed;
+		size_t offset => 0 for assignments, 1 for reads;
+		struct HashMap *changes => Lowest changed dimension of every name
+*/
+void SA_record_changed_dimension(Node *target, size_t offset, struct HashMap *changes) {
+	if (target == NULL || target->type != _IDEN_NODE_ || target->value == NULL) {
+		return;
+	}
+
+	size_t dimension = offset;
+
+	for (Node *access = target->leftNode; access != NULL && access->type == _ARRAY_ACCESS_NODE_; access = access->rightNode) {
+		dimension++;
+	}
+
+	struct HashMapEntry *entry = HM_get_entry(target->value, changes);
+
+	if (entry != NULL) {
+		size_t *changed = (size_t*)entry->value;
+		*changed = dimension < *changed ? dimension : *changed;
+		return;
+	}
+
+	size_t *changed = (size_t*)malloc(sizeof(size_t));
+
+	if (changed == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("ChangedDimension");
+		return;
+	}
+
+	*changed = dimension;
+	(void)HM_add_entry(target->value, changed, changes);
+}
+
+/*
+Purpose: Check if the counter of a loop is assigned, incremented or decremented in the node
+Return Type: int => true if the counter is changed, else false
+Params: Node *node => Node to search in;
+		char *name => Name of the counter
+*/
+int SA_is_counter_assigned(Node *node, char *name) {
+	if (node == NULL) {
+		return false;
+	}
+
+	switch (node->type) {
+	case _EQUALS_NODE_:
+	case _PLUS_EQUALS_NODE_:
+	case _MINUS_EQUALS_NODE_:
+	case _MULTIPLY_EQUALS_NODE_:
+	case _DIVIDE_EQUALS_NODE_:
+		if ((int)SA_is_plain_identifier(node->leftNode, name) == true) {
+			return true;
+		}
+
+		break;
+	case _SIMPLE_INC_DEC_ASS_NODE_:
+	case _INCREMENT_ONE_NODE_:
+	case _DECREMENT_ONE_NODE_:
+		if ((int)SA_is_plain_identifier(node->leftNode, name) == true
+			|| (int)SA_is_plain_identifier(node->rightNode, name) == true
+			|| (node->detailsCount > 0 && (int)SA_is_plain_identifier(node->details[0], name) == true)) {
+			return true;
+		}
+
+		break;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		if ((int)SA_is_counter_assigned(node->details[i], name) == true) {
+			return true;
+		}
+	}
+
+	return (int)SA_is_counter_assigned(node->leftNode, name) == true || (int)SA_is_counter_assigned(node->rightNode, name) == true ? true : false;
+}
+
+int SA_is_plain_identifier(Node *node, char *name) {
+	return node != NULL && node->type == _IDEN_NODE_ && node->leftNode == NULL
+		&& node->value != NULL && (int)strcmp(node->value, name) == 0 ? true : false;
+}
+
+/*
+Purpose: Add a name to the known names, it hides the outer names until its runnable ends
+Return Type: struct KnownName * => Added name, NULL if there is no space left
+Params: struct IndexRangeContext *context => Known names;
+		char *name => Name of the declaration;
+		enum KnownNameType type => Kind of the declaration
+*/
+struct KnownName *SA_push_known_name(struct IndexRangeContext *context, char *name, enum KnownNameType type) {
+	if (name == NULL) {
+		return NULL;
+	} else if (context->count >= SA_MAX_KNOWN_NAMES) {
+		//The outer names can't be hidden anymore, so none is trusted until the runnable ends
+		context->lost++;
+		return NULL;
+	}
+
+	struct KnownName *known = &context->names[context->count++];
+	(void)memset(known, 0, sizeof(struct KnownName));
+	known->name = name;
+	known->type = type;
+	return known;
+}
+
+struct KnownName *SA_get_known_name(struct IndexRangeContext *context, char *name) {
+	if (name == NULL || context->lost > 0) {
+		return NULL;
+	}
+
+	for (size_t i = context->count; i > 0; i--) {
+		if ((int)strcmp(context->names[i - 1].name, name) == 0) {
+			return &context->names[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Builds the escape summaries of all functions, methods and constructors
+ * of the file.
+ * </p>
+ * 
+ * <p>
+ * A parameter escapes, if it's returned, assigned, stored in an attribute
+ * or passed on to a call, where it escapes. The instance of a method
+ * escapes the same way through {@code this} (also by calling a method, that
+ * lets it escape). The summaries depend on each other, so they are computed
+ * until none changes anymore, starting with no escapes (recursive calls
+ * alone don't let a parameter escape).
+ * </p>
+ * 
+ * @param *root     Root of the parsetree (top level statements)
+ */
+void SA_build_escape_summaries(Node *root) {
+	(void)SA_free_escape_summaries();
+	size_t functions = 0;
+
+	for (size_t i = 0; i < root->detailsCount; i++) {
+		Node *statement = root->details[i];
+
+		if (statement == NULL) {
+			continue;
+		} else if (statement->type == _FUNCTION_NODE_) {
+			functions++;
+		} else if (statement->type == _CLASS_NODE_ && statement->rightNode != NULL) {
+			functions += statement->rightNode->detailsCount;
+			ESCAPE_SUMMARIES.classCount++;
+		}
+	}
+
+	ESCAPE_SUMMARIES.entries = (struct EscapeSummary*)calloc(functions + 1, sizeof(struct EscapeSummary));
+	ESCAPE_SUMMARIES.classes = (struct EscapeClass*)calloc(ESCAPE_SUMMARIES.classCount + 1, sizeof(struct EscapeClass));
+	ESCAPE_SUMMARIES.functionNames = CreateNewHashMap(functions * 2 + 1);
+	ESCAPE_SUMMARIES.classNames = CreateNewHashMap(ESCAPE_SUMMARIES.classCount * 2 + 1);
+	ESCAPE_SUMMARIES.classCount = 0;
+
+	if (ESCAPE_SUMMARIES.entries == NULL || ESCAPE_SUMMARIES.classes == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("EscapeSummaries");
+		return;
+	}
+
+	for (size_t i = 0; i < root->detailsCount; i++) {
+		Node *statement = root->details[i];
+
+		if (statement == NULL) {
+			continue;
+		} else if (statement->type == _FUNCTION_NODE_) {
+			(void)SA_add_escape_name(ESCAPE_SUMMARIES.functionNames, statement->value, ESCAPE_SUMMARIES.count);
+			ESCAPE_SUMMARIES.entries[ESCAPE_SUMMARIES.count++].function = statement;
+			continue;
+		} else if (statement->type != _CLASS_NODE_ || statement->rightNode == NULL) {
+			continue;
+		}
+
+		struct EscapeClass *escapeClass = &ESCAPE_SUMMARIES.classes[ESCAPE_SUMMARIES.classCount];
+		escapeClass->classNode = statement;
+		escapeClass->firstSummary = ESCAPE_SUMMARIES.count;
+		(void)SA_add_escape_name(ESCAPE_SUMMARIES.classNames, statement->value, ESCAPE_SUMMARIES.classCount++);
+
+		for (size_t j = 0; j < statement->rightNode->detailsCount; j++) {
+			Node *member = statement->rightNode->details[j];
+
+			if (member == NULL || (member->type != _FUNCTION_NODE_ && member->type != _CLASS_CONSTRUCTOR_NODE_)) {
+				continue;
+			} else if (member->type == _FUNCTION_NODE_) {
+				(void)SA_add_escape_name(ESCAPE_SUMMARIES.functionNames, member->value, ESCAPE_SUMMARIES.count);
+			}
+
+			ESCAPE_SUMMARIES.entries[ESCAPE_SUMMARIES.count].function = member;
+			ESCAPE_SUMMARIES.entries[ESCAPE_SUMMARIES.count++].classNode = statement;
+		}
+
+		escapeClass->summaryCount = ESCAPE_SUMMARIES.count - escapeClass->firstSummary;
+	}
+
+	for (size_t i = 0; i < ESCAPE_SUMMARIES.count; i++) {
+		struct EscapeSummary *summary = &ESCAPE_SUMMARIES.entries[i];
+
+		while (SA_get_escape_parameter(summary->function, summary->paramCount) != NULL) {
+			summary->paramCount++;
+		}
+	}
+
+	//Every other round runs backwards, so chains of calls settle in both orders
+	for (int changed = true, round = 0; changed == true; round++) {
+		changed = false;
+
+		for (size_t k = 0; k < ESCAPE_SUMMARIES.count; k++) {
+			size_t i = round % 2 == 0 ? k : ESCAPE_SUMMARIES.count - k - 1;
+			struct EscapeSummary *summary = &ESCAPE_SUMMARIES.entries[i];
+			Node *body = SA_get_escape_body(summary->function);
+			struct EscapeQuery thisQuery = {NULL, summary->classNode, false, summary->classNode};
+
+			if (summary->classNode != NULL && summary->thisEscapes == false
+				&& (int)SA_does_escape(&thisQuery, body) == true) {
+				summary->thisEscapes = true;
+				changed = true;
+			}
+
+			for (size_t j = 0; j < summary->paramCount && j < SA_MAX_ESCAPE_PARAMS; j++) {
+				Node *param = SA_get_escape_parameter(summary->function, j);
+				Node *type = param->detailsCount > 0 ? param->details[0] : NULL;
+				struct EscapeQuery paramQuery = {param->value, type != NULL ? SA_get_escape_class(type->value) : NULL, false, summary->classNode};
+
+				if ((summary->escapingParams & (1ULL << j)) == 0 && (int)SA_does_escape(&paramQuery, body) == true) {
+					summary->escapingParams |= 1ULL << j;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+Purpose: Add the index of a function or class to a map, functions with the same name are linked by their summaries
+Return Type: void
+Params: struct HashMap *map => Map to add the name to;
+		char *name => Name of the function or class;
+		size_t index => Index of the summary or class
+*/
+void SA_add_escape_name(struct HashMap *map, char *name, size_t index) {
+	if (map == NULL || name == NULL) {
+		return;
+	}
+
+	struct HashMapEntry *entry = HM_get_entry(name, map);
+
+	//The latest function with the name becomes the first one
+	if (entry != NULL) {
+		size_t *first = (size_t*)entry->value;
+		ESCAPE_SUMMARIES.entries[index].nextWithName = *first + 1;
+		*first = index;
+		return;
+	}
+
+	size_t *first = (size_t*)malloc(sizeof(size_t));
+
+	if (first == NULL) {
+		(void)THROW_MEMORY_RESERVATION_EXCEPTION("EscapeName");
+		return;
+	}
+
+	*first = index;
+	(void)HM_add_entry(name, first, map);
+}
+
+void SA_free_escape_summaries() {
+	(void)free(ESCAPE_SUMMARIES.entries);
+	(void)free(ESCAPE_SUMMARIES.classes);
+	(void)HM_free(ESCAPE_SUMMARIES.functionNames);
+	(void)HM_free(ESCAPE_SUMMARIES.classNames);
+	ESCAPE_SUMMARIES.entries = NULL;
+	ESCAPE_SUMMARIES.classes = NULL;
+	ESCAPE_SUMMARIES.functionNames = NULL;
+	ESCAPE_SUMMARIES.classNames = NULL;
+	ESCAPE_SUMMARIES.count = 0;
+	ESCAPE_SUMMARIES.classCount = 0;
+}
+
+/**
+ * <p>
+ * Marks the class instances of a runnable, that never leave it, as scoped.
+ * </p>
+ * 
+ * <p>
+ * Only locals, that are created with {@code new}, are checked. The
+ * instance must not escape through its constructor (or the attributes)
+ * and the following statements may only access its members, compare it
+ * and pass it to calls, where the parameter doesn't escape. A scoped
+ * instance can be allocated on the stack of the function (or replaced
+ * by its attributes), since it isn't reachable after the runnable ends.
+ * </p>
+ * 
+ * @param *runnable     Runnable, that was checked
+ * @param *table        Table of the runnable
+ */
+void SA_mark_scoped_instances(Node *runnable, SemanticTable *table) {
+	//The instances of the top level and the attributes are reachable from everywhere
+	if (table->type == MAIN || table->type == CLASS || ESCAPE_SUMMARIES.entries == NULL) {
+		return;
+	}
+
+	SemanticTable *classTable = SA_get_next_table_of_type(table, CLASS);
+	Node *ownerClass = classTable != NULL && classTable->type == CLASS ? SA_get_escape_class(classTable->name) : NULL;
+
+	for (size_t i = 0; i < runnable->detailsCount; i++) {
+		Node *declaration = runnable->details[i];
+
+		if (declaration == NULL
+			|| (declaration->type != _VAR_CLASS_INSTANCE_NODE_ && declaration->type != _CONST_CLASS_INSTANCE_NODE_)
+			|| declaration->rightNode == NULL || declaration->rightNode->type != _INHERITED_CLASS_NODE_) {
+			continue;
+		}
+
+		SemanticEntry *entry = SA_get_entry_if_available(declaration->value, table).entry;
+		Node *classNode = SA_get_escape_class(declaration->rightNode->value);
+		struct EscapeQuery query = {declaration->value, classNode, true, ownerClass};
+
+		//The constructor gets the instance as "this"
+		if (entry == NULL || (int)SA_does_constructor_escape(classNode, declaration->rightNode->detailsCount, -1, 0) == true) {
+			continue;
+		}
+
+		int escapes = false;
+
+		for (size_t j = i + 1; j < runnable->detailsCount && escapes == false; j++) {
+			escapes = (int)SA_does_escape(&query, runnable->details[j]);
+		}
+
+		if (escapes == false) {
+			entry->scoped = true;
+			(void)ST_count(COUNTER_SCOPED_INSTANCES, 1);
+		}
+	}
+}
+
+/*
+Purpose: Check if the searched object escapes in a node (each use, that isn't known to be safe, is an escape)
+Return Type: int => true if the object might escape, else false
+Params: struct EscapeQuery *query => Searched object;
+		Node *node => Node to search in
+*/
+int SA_does_escape(struct EscapeQuery *query, Node *node) {
+	if (node == NULL || node->type == _NULL_) {
+		return false;
+	} else if ((int)SA_is_escape_target(query, node) == true) {
+		return true;
+	}
+
+	switch (node->type) {
+	case _FUNCTION_NODE_:
+	case _CLASS_CONSTRUCTOR_NODE_:
+	case _CLASS_NODE_:
+		return false;
+	case _MEM_CLASS_ACC_NODE_:
+		if ((int)SA_is_escape_target(query, node->leftNode) == true) {
+			return SA_does_member_access_escape(query, node->rightNode, true);
+		}
+
+		return (int)SA_does_escape(query, node->leftNode) == true
+			|| (int)SA_does_member_access_escape(query, node->rightNode, false) == true ? true : false;
+	case _FUNCTION_CALL_NODE_:
+		//A call of a method in a class passes the instance
+		if (query->name == NULL && (int)SA_does_callee_escape(ESCAPE_FUNCTION_CALL, NULL, query->ownerClass, node->value, node->detailsCount, -1, false) == true) {
+			return true;
+		}
+
+		return SA_do_arguments_escape(query, node, ESCAPE_FUNCTION_CALL, NULL, false);
+	case _INHERITED_CLASS_NODE_:
+		return SA_do_arguments_escape(query, node, ESCAPE_CONSTRUCTOR_CALL, SA_get_escape_class(node->value), true);
+	case _EQUALS_NODE_:
+		//Assigning another object to the name doesn't change the searched object
+		if ((int)SA_is_escape_target(query, node->leftNode) == true) {
+			return SA_does_escape(query, node->rightNode);
+		}
+
+		break;
+	case _EQUALS_CONDITION_NODE_:
+	case _NOT_EQUALS_CONDITION_NODE_:
+		return ((int)SA_is_escape_target(query, node->leftNode) == false && (int)SA_does_escape(query, node->leftNode) == true)
+			|| ((int)SA_is_escape_target(query, node->rightNode) == false && (int)SA_does_escape(query, node->rightNode) == true) ? true : false;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < node->detailsCount; i++) {
+		if ((int)SA_does_escape(query, node->details[i]) == true) {
+			return true;
+		}
+	}
+
+	return (int)SA_does_escape(query, node->leftNode) == true || (int)SA_does_escape(query, node->rightNode) == true ? true : false;
+}
+
+/*
+Purpose: Check the members of a member access chain ("->" or "."), the first member belongs to the searched object, if it's tracked
+Return Type: int => true if the object might escape, else false
+Params: struct EscapeQuery *query => Searched object;
+		Node *accessor => Accessor of the member;
+		int tracked => true if the accessed object is the searched one
+*/
+int SA_does_member_access_escape(struct EscapeQuery *query, Node *accessor, int tracked) {
+	if (accessor == NULL || (accessor->type != _CLASS_ACCESS_NODE_ && accessor->type != _MEMBER_ACCESS_NODE_)) {
+		return SA_does_escape(query, accessor);
+	}
+
+	Node *member = accessor->leftNode;
+
+	if (member != NULL && member->type == _FUNCTION_CALL_NODE_) {
+		if (tracked == true && (int)SA_does_callee_escape(ESCAPE_METHOD_CALL, query->classNode, NULL, member->value, member->detailsCount, -1, query->exact) == true) {
+			return true;
+		} else if ((int)SA_do_arguments_escape(query, member, ESCAPE_METHOD_CALL, tracked == true ? query->classNode : NULL, query->exact) == true) {
+			return true;
+		}
+	} else if (member != NULL && (int)SA_does_escape(query, member->leftNode) == true) {
+		return true;
+	}
+
+	return SA_does_member_access_escape(query, accessor->rightNode, false);
+}
+
+/*
+Purpose: Check the arguments of a call, the searched object can be passed to a parameter, that doesn't escape
+Return Type: int => true if the object might escape, else false
+Params: struct EscapeQuery *query => Searched object;
+		Node *callNode => Call with the arguments as details;
+		enum EscapeCallType type => Kind of the call;
+		Node *classNode => Class of the called method or constructor;
+		int exact => true if the method is called on an exact object
+*/
+int SA_do_arguments_escape(struct EscapeQuery *query, Node *callNode, enum EscapeCallType type, Node *classNode, int exact) {
+	for (size_t i = 0; i < callNode->detailsCount; i++) {
+		Node *argument = callNode->details[i];
+
+		if ((int)SA_is_escape_target(query, argument) == false) {
+			if ((int)SA_does_escape(query, argument) == true) {
+				return true;
+			}
+		} else if ((int)SA_does_callee_escape(type, classNode, query->ownerClass, callNode->value, callNode->detailsCount, (int)i, exact) == true) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * <p>
+ * Checks if a parameter (or the instance) escapes in the called function.
+ * </p>
+ * 
+ * <p>
+ * A call without an object in a class can also call a method of the class.
+ * Calls, that can't be resolved in the file, let everything escape.
+ * </p>
+ * 
+ * @returns True if the parameter might escape, else false
+ * 
+ * @param type          Kind of the call
+ * @param *classNode    Class of the called method or constructor
+ * @param *ownerClass   Class, that holds the call
+ * @param *name         Name of the called function or method
+ * @param count         Number of arguments
+ * @param argument      Index of the parameter, -1 for the instance
+ * @param exact         true if the method is called on an exact object
+ */
+int SA_does_callee_escape(enum EscapeCallType type, Node *classNode, Node *ownerClass, char *name, size_t count, int argument, int exact) {
+	int found = false;
+	int escapes = false;
+
+	switch (type) {
+	case ESCAPE_CONSTRUCTOR_CALL:
+		return SA_does_constructor_escape(classNode, count, argument, 0);
+	case ESCAPE_METHOD_CALL:
+		escapes = (int)SA_does_method_escape(classNode, name, count, argument, exact, &found);
+		return escapes == true || found == false ? true : false;
+	default:
+		if (ownerClass != NULL) {
+			escapes = (int)SA_does_method_escape(ownerClass, name, count, argument, false, &found);
+
+			if (escapes == true || found == true) {
+				return escapes;
+			}
 		}
-	}
 
-	if (pos == 0) {
-		(void)printf("C: %s -> %i\n", topNode->value, topNode->type);
-	} else if (pos == 1) {
-		(void)printf("L: %s -> %i\n", topNode->value, topNode->type);
-	} else {
-		(void)printf("R: %s -> %i\n", topNode->value, topNode->type);
+		//Functions don't get an instance
+		if (argument < 0) {
+			return false;
+		}
+
+		escapes = (int)SA_does_summary_escape(NULL, false, name, false, count, argument, &found);
+		return escapes == true || found == false ? true : false;
 	}
+}
 
-	for (int i = 0; i < topNode->detailsCount; i++) {
-		if (topNode->details[i] != NULL) {
-			for (int n = 0; n < depth + 1; n++) {
-				if (n + 1 == depth + 1) {
-					(void)printf("+-- ");
-				} else {
-					(void)printf("|   ");
-				}
-			}
+/*
+Purpose: Check a method in a class and its parent classes, other objects than exact ones might run an override of any class
+Return Type: int => true if the parameter might escape (or the method is inherited from a class of another file), else false
+Params: Node *classNode => Class of the object;
+		char *name => Name of the method;
+		size_t count => Number of arguments;
+		int argument => Index of the parameter, -1 for the instance;
+		int exact => true if the object is an exact instance of the class;
+		int *found => Set if the method was found
+*/
+int SA_does_method_escape(Node *classNode, char *name, size_t count, int argument, int exact, int *found) {
+	Node *current = classNode;
+	*found = false;
 
-			(void)printf("(%s) detail: %s -> %i\n", topNode->value, topNode->details[i]->value, topNode->details[i]->type);
-			(void)DEBUG_print_from_top_node(topNode->details[i]->leftNode, depth + 2, 1);
-			(void)DEBUG_print_from_top_node(topNode->details[i]->rightNode, depth + 2, 2);
+	for (int depth = 0; current != NULL && *found == false; depth++) {
+		int unknown = false;
 
-			for (int n = 0; n < topNode->details[i]->detailsCount; n++) {
-				(void)DEBUG_print_from_top_node(topNode->details[i]->details[n], depth + 2, 0);
-			}
-		} else {
-			(void)printf("(%s) detail: NULL -> NULL\n", topNode->value);
+		if (depth >= SA_MAX_CLASS_DEPTH || (int)SA_does_summary_escape(current, false, name, false, count, argument, found) == true) {
+			return true;
+		}
+
+		Node *parent = SA_get_parent_class(current, &unknown);
+
+		if (*found == false && unknown == true) {
+			return true;
 		}
+
+		current = parent;
 	}
 
-	(void)DEBUG_print_from_top_node(topNode->leftNode, depth + 1, 1);
-	(void)DEBUG_print_from_top_node(topNode->rightNode, depth + 1, 2);
+	if (*found == true && exact == false) {
+		int overridden = false;
+		return SA_does_summary_escape(NULL, true, name, false, count, argument, &overridden);
+	}
+
+	return false;
 }
 
-void DEBUG_print_list(struct List *list, int flag) {
-	if (list == NULL) {
-		return;
+/*
+Purpose: Check the constructor of a class, the attributes and the parent classes also get the instance
+Return Type: int => true if the parameter might escape, else false
+Params: Node *classNode => Class of the created instance;
+		size_t count => Number of arguments (SIZE_MAX for all constructors);
+		int argument => Index of the parameter, -1 for the instance;
+		int depth => Number of checked child classes
+*/
+int SA_does_constructor_escape(Node *classNode, size_t count, int argument, int depth) {
+	if (classNode == NULL || depth >= SA_MAX_CLASS_DEPTH) {
+		return true;
 	}
 
-	printf("List@[%p]\n", (void*)list);
-	printf("List Capacity: %li\n", list->size);
-	printf("\n");
+	struct EscapeQuery query = {NULL, classNode, false, classNode};
+	int unknown = false;
+	int found = false;
+	Node *parent = SA_get_parent_class(classNode, &unknown);
 
-	if (flag == 0) {
-		return;
+	//The arguments of the super constructor aren't known
+	if (unknown == true || (parent != NULL && (argument >= 0 || (int)SA_does_constructor_escape(parent, SIZE_MAX, -1, depth + 1) == true))) {
+		return true;
+	} else if (argument < 0 && (int)SA_does_escape(&query, classNode->rightNode) == true) {
+		return true;
+	} else if ((int)SA_does_summary_escape(classNode, false, NULL, true, count, argument, &found) == true) {
+		return true;
 	}
 
-	printf("%-11s|%-23s|\n", "Index", "VALUES");
-	printf("-----------+-----------------------+\n");
+	//A class without constructors only has the default constructor
+	return found == false && count != 0 && count != SIZE_MAX ? true : false;
+}
 
-	for (int i = 0; i < list->size; i++) {
-		if (list->entries[i] == NULL) {
-			printf("%11i|%-23s|\n", i, "(null)");
+/*
+Purpose: Check the summaries of all matching functions (same name, class and number of parameters)
+Return Type: int => true if the parameter escapes in one of them, else false
+Params: Node *classNode => Class of the methods, NULL for functions;
+		int anyClass => true to check the methods of all classes;
+		char *name => Name of the function;
+		int constructor => true to check the constructors of the class;
+		size_t count => Number of arguments (SIZE_MAX for all);
+		int argument => Index of the parameter, -1 for the instance;
+		int *found => Set if a summary matched
+*/
+int SA_does_summary_escape(Node *classNode, int anyClass, char *name, int constructor, size_t count, int argument, int *found) {
+	struct EscapeClass *escapeClass = classNode != NULL && anyClass == false ? SA_get_escape_class_entry(classNode->value) : NULL;
+	struct HashMapEntry *nameEntry = escapeClass == NULL && name != NULL ? HM_get_entry(name, ESCAPE_SUMMARIES.functionNames) : NULL;
+	size_t next = escapeClass != NULL ? escapeClass->firstSummary + 1 : (nameEntry != NULL ? *(size_t*)nameEntry->value + 1 : 0);
+
+	//The methods of a class are in a row, the functions are linked by their names
+	for (size_t i = 0; next != 0; i++) {
+		struct EscapeSummary *summary = &ESCAPE_SUMMARIES.entries[next - 1];
+		Node *function = summary->function;
+
+		if (escapeClass != NULL) {
+			next = i + 1 < escapeClass->summaryCount ? next + 1 : 0;
+		} else {
+			next = summary->nextWithName;
+		}
+
+		if ((anyClass == true ? summary->classNode == NULL : summary->classNode != classNode)
+			|| (count != SIZE_MAX && summary->paramCount != count)) {
+			continue;
+		} else if (constructor == true ? function->type != _CLASS_CONSTRUCTOR_NODE_
+			: (function->type != _FUNCTION_NODE_ || name == NULL || function->value == NULL || (int)strcmp(function->value, name) != 0)) {
 			continue;
 		}
 
-		ExternalEntry *e = (ExternalEntry*)list->entries[i];
-		printf("%11i|%-23s|\n", i, e->node->value);
+		*found = true;
+
+		if (argument < 0 ? summary->thisEscapes == true
+			: (argument >= SA_MAX_ESCAPE_PARAMS || (summary->escapingParams & (1ULL << argument)) != 0)) {
+			return true;
+		}
 	}
 
-	return;
+	return false;
 }
 
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-int CheckSemantic(Node *root) {
-	(void)SA_init_globals();
+int SA_is_escape_target(struct EscapeQuery *query, Node *node) {
+	if (node == NULL) {
+		return false;
+	} else if (query->name == NULL) {
+		return node->type == _THIS_NODE_ ? true : false;
+	}
 
-	SemanticTable *mainTable = SA_create_new_scope_table(root, MAIN, NULL, NULL, 0, 0);
-	(void)SA_manage_runnable(root, mainTable);
-	(void)FREE_TABLE(mainTable);
-	printf(TEXT_COLOR_YELLOW "Total Externals: %li\n" TEXT_COLOR_RESET, LIST_OF_EXTERNAL_ACCESSES->load);
-	DEBUG_print_list(LIST_OF_EXTERNAL_ACCESSES, true);
-	return 0;
+	return node->type == _IDEN_NODE_ && node->leftNode == NULL && node->value != NULL
+		&& (int)strcmp(node->value, query->name) == 0 ? true : false;
 }
 
-void SA_init_globals() {
-	nullRep = SA_create_semantic_report(nullDec, SUCCESS, NULL, NONE, nullCont);
-	LIST_OF_EXTERNAL_ACCESSES = CreateNewList(16);
+Node *SA_get_escape_class(char *name) {
+	struct EscapeClass *escapeClass = SA_get_escape_class_entry(name);
+	return escapeClass != NULL ? escapeClass->classNode : NULL;
 }
 
-void SA_manage_runnable(Node *root, SemanticTable *table) {
-	printf("Main instructions count: %li\n", root->detailsCount);
-	
-	for (int i = 0; i < root->detailsCount; i++) {
-		Node *currentNode = root->details[i];
+struct EscapeClass *SA_get_escape_class_entry(char *name) {
+	if (name == NULL || ESCAPE_SUMMARIES.classNames == NULL) {
+		return NULL;
+	}
 
-		if (currentNode == NULL) {
-			continue;
-		}
+	struct HashMapEntry *entry = HM_get_entry(name, ESCAPE_SUMMARIES.classNames);
+	return entry != NULL ? &ESCAPE_SUMMARIES.classes[*(size_t*)entry->value] : NULL;
+}
 
-		switch (currentNode->type) {
-		case _VAR_NODE_:
-		case _CONST_NODE_:
-			(void)SA_add_normal_variable_to_table(table, currentNode);
-			break;
-		case _CONDITIONAL_VAR_NODE_:
-		case _CONDITIONAL_CONST_NODE_:
-			(void)SA_add_conditional_variable_to_table(table, currentNode);
-			break;
-		case _FUNCTION_NODE_:
-			(void)SA_add_function_to_table(table, currentNode);
-			break;
-		case _CLASS_NODE_:
-			(void)SA_add_class_to_table(table, currentNode);
-			break;
-		case _VAR_CLASS_INSTANCE_NODE_:
-		case _CONST_CLASS_INSTANCE_NODE_:
-			(void)SA_add_instance_variable_to_table(table, currentNode);
-			break;
-		case _ARRAY_VAR_NODE_:
-		case _ARRAY_CONST_NODE_:
-			(void)SA_add_array_variable_to_table(table, currentNode);
-			break;
-		case _CLASS_CONSTRUCTOR_NODE_:
-			(void)SA_add_constructor_to_table(table, currentNode);
-			break;
-		case _ENUM_NODE_:
-			(void)SA_add_enum_to_table(table, currentNode);
-			break;
-		case _INCLUDE_NODE_:
-			(void)SA_add_include_to_table(table, currentNode);
-			break;
-		case _TRY_NODE_:
-			(void)SA_add_try_statement(table, currentNode, root, i);
-			break;
-		case _CATCH_NODE_:
-			(void)SA_add_catch_statement(table, currentNode, root, i);
-			break;
-		case _FINALLY_STMT_NODE_:
-			(void)SA_add_finally_statement(table, currentNode, root, i);
-			break;
-		case _WHILE_STMT_NODE_:
-		case _DO_STMT_NODE_:
-			(void)SA_add_while_or_do_to_table(table, currentNode);
-			break;
-		case _IF_STMT_NODE_:
-			(void)SA_add_if_to_table(table, currentNode);
-			break;
-		case _ELSE_IF_STMT_NODE_:
-			(void)SA_add_else_if_to_table(table, currentNode, root, i);
-			break;
-		case _ELSE_STMT_NODE_:
-			(void)SA_add_else_to_table(table, currentNode, root, i);
-			break;
-		case _CONTINUE_STMT_NODE_:
-		case _BREAK_STMT_NODE_:
-			(void)SA_check_break_or_continue_to_table(table, currentNode);
-			break;
-		case _RETURN_STMT_NODE_:
-			(void)SA_add_return_to_table(table, currentNode);
-			break;
-		case _FOR_STMT_NODE_:
-			(void)SA_add_for_to_table(table, currentNode);
-			break;
-		case _CHECK_STMT_NODE_:
-			(void)SA_add_check_to_table(table, currentNode);
-			break;
-		case _MEM_CLASS_ACC_NODE_:
-		case _FUNCTION_CALL_NODE_: {
-			struct SemanticReport rep = SA_evaluate_member_access(currentNode, table);
-		
-			if (rep.status == ERROR) {
-				(void)THROW_ASSIGNED_EXCEPTION(rep);
-			}
-		
-			break;
+/*
+Purpose: Get the class, that a class extends
+Return Type: Node * => Parent class, NULL if there is none or it isn't in the file
+Params: Node *classNode => Class to check;
+		int *unknown => Set if the parent class isn't in the file
+*/
+Node *SA_get_parent_class(Node *classNode, int *unknown) {
+	for (size_t i = 0; i < classNode->detailsCount; i++) {
+		Node *inheritance = classNode->details[i];
+
+		if (inheritance != NULL && inheritance->type == _INHERITANCE_NODE_) {
+			Node *parent = SA_get_escape_class(inheritance->value);
+			*unknown = parent == NULL ? true : false;
+			return parent;
 		}
-		case _SUPER_STMT_NODE_:
-			(void)SA_add_super_statement_to_table(table, currentNode);
-			break;
-		case _INTERFACE_STMT_NODE_:
-			(void)SA_add_interface_to_table(table, currentNode);
-			break;
-		case _PLUS_EQUALS_NODE_:
-		case _MINUS_EQUALS_NODE_:
-    	case _EQUALS_NODE_:
-		case _MULTIPLY_EQUALS_NODE_:
-		case _DIVIDE_EQUALS_NODE_:
-		default:
-			//(void)SA_check_assignments(table, currentNode);
-			break;
+	}
+
+	return NULL;
+}
+
+Node *SA_get_escape_body(Node *function) {
+	if (function->type == _CLASS_CONSTRUCTOR_NODE_) {
+		return function->rightNode;
+	}
+
+	Node *last = function->detailsCount > 0 ? function->details[function->detailsCount - 1] : NULL;
+	return last != NULL && last->type == _RUNNABLE_NODE_ ? last : NULL;
+}
+
+/*
+Purpose: Get a parameter of a function or constructor
+Return Type: Node * => Parameter, NULL if there are fewer parameters
+Params: Node *function => Function or constructor;
+		size_t index => Index of the parameter
+*/
+Node *SA_get_escape_parameter(Node *function, size_t index) {
+	for (size_t i = 0; i < function->detailsCount; i++) {
+		Node *param = function->details[i];
+
+		if (param == NULL || (param->type != _IDEN_NODE_ && param->type != _PARAM_NODE_)) {
+			continue;
+		} else if (index-- == 0) {
+			return param;
 		}
 	}
+
+	return NULL;
 }
 
 /**
@@ -1509,16 +3514,22 @@ void SA_handle_check_statement_runnable(Node *runnableNode, SemanticTable *check
 			struct SemanticReport rep = SA_create_semantic_report(nullDec, ERROR, detailNode, STATEMENT_MISPLACEMENT_EXCEPTION, errCont);
 			(void)THROW_STATEMENT_MISPLACEMENT_EXEPTION(rep);
 			return;
-		} else if ((int)HM_contains_key(detailNode->leftNode->value, checkTable->symbolTable) == true) {
-			struct SemanticReport alreadyDefRep = SA_create_already_defined_exception_report(detailNode->leftNode->value, checkTable, detailNode->leftNode);
+		}
+
+		//Enumerators (Color->RED) are compared by their name
+		Node *valueNode = detailNode->leftNode;
+		char *key = valueNode->type == _MEM_CLASS_ACC_NODE_ && valueNode->rightNode != NULL
+			&& valueNode->rightNode->leftNode != NULL ? valueNode->rightNode->leftNode->value : valueNode->value;
+
+		if ((int)HM_contains_key(key, checkTable->symbolTable) == true) {
+			struct SemanticReport alreadyDefRep = SA_create_already_defined_exception_report(key, checkTable, valueNode);
 			(void)THROW_ALREADY_DEFINED_EXCEPTION(alreadyDefRep);
 			return;
-			continue;
 		}
 
 		SemanticTable *isTable = SA_create_new_scope_table(detailNode, IS, checkTable, NULL, detailNode->line, detailNode->position);
-		struct SemanticEntry *isEntry = SA_create_semantic_entry(detailNode->leftNode->value, nullDec, P_GLOBAL, IS, isTable, detailNode->line, detailNode->position);
-		(void)HM_add_entry(detailNode->leftNode->value, isEntry, checkTable->symbolTable);
+		struct SemanticEntry *isEntry = SA_create_semantic_entry(key, nullDec, P_GLOBAL, IS, isTable, detailNode->line, detailNode->position);
+		(void)HM_add_entry(key, isEntry, checkTable->symbolTable);
 		(void)SA_manage_runnable(detailNode->rightNode, isTable);
 	}
 }
@@ -1536,7 +3547,7 @@ void SA_create_checkable_error_message(struct SemanticReport memberAccessReport,
 	}
 
 	(void)snprintf(sugg, (length + 55 + 1) * sizeof(char), "Maybe convert the \"%s\" to a number, boolean or character.", type_str);
-	char *msg = "Check statements can only compare numbers, booleans and characters.";
+	char *msg = "Check statements can only compare numbers, booleans, characters and enums.";
 	struct ErrorContainer errCont = {msg, NULL, sugg};
 	struct SemanticReport rep = SA_create_semantic_report(nullDec, ERROR, checkableNode, NON_COMPARABLE_CHECK_EXCEPTION, errCont);
 	(void)free(type_str);
@@ -1546,6 +3557,11 @@ void SA_create_checkable_error_message(struct SemanticReport memberAccessReport,
 int SA_validate_checkable(struct SemanticReport memberAccessReport) {
 	int checkablesLen = sizeof(validCheckables) / sizeof(validCheckables[0]);
 
+	//Enumerators are numbers, the cases are checked by name
+	if (memberAccessReport.dec.type == ENUM_REF && memberAccessReport.dec.dimension == 0) {
+		return true;
+	}
+
 	for (int i = 0; i < checkablesLen; i++) {
 		if ((int)SA_are_VarTypes_equal(validCheckables[i], memberAccessReport.dec, true) == true) {
 			return true;
@@ -1788,6 +3804,14 @@ struct SemanticReport SA_evaluate_chained_condition(SemanticTable *table, Node *
 			struct ErrorContainer errCont = {msg, exp, sugg};
 			return SA_create_semantic_report(nullDec, ERROR, rootNode, NON_BOOLEAN_CHECK_EXCEPTION, errCont);
 		}
+	} else if (rootNode->type == _BOOL_NODE_) {
+		//A literal without a comparison (e.g. "while (true)")
+		struct VarDec expDec = {BOOLEAN, 0, NULL, false};
+		struct SemanticReport termRep = SA_evaluate_simple_term(expDec, rootNode, table);
+
+		if (termRep.status == ERROR) {
+			return termRep;
+		}
 	} else {
 		int checkablesLen = sizeof(validCheckables) / sizeof(validCheckables[0]);
 
@@ -2163,8 +4187,10 @@ struct SemanticReport SA_evaluate_term_side(struct VarDec expectedType, Node *no
 	default: break;
 	}
 
-	printf("EXP: %i | %i | %i | %s\n", expectedType.type, expectedType.dimension, expectedType.constant, expectedType.typeName == NULL ? "null" : expectedType.typeName);
-	printf("PRE: %i | %i | %i | %s\n", predictedType.type, predictedType.dimension, predictedType.constant, predictedType.typeName == NULL ? "null" : predictedType.typeName);
+	if (SEMANTIC_ANALYZER_DEBUG_MODE == 1) {
+		(void)printf("EXP: %i | %i | %i | %s\n", expectedType.type, expectedType.dimension, expectedType.constant, expectedType.typeName == NULL ? "null" : expectedType.typeName);
+		(void)printf("PRE: %i | %i | %i | %s\n", predictedType.type, predictedType.dimension, predictedType.constant, predictedType.typeName == NULL ? "null" : predictedType.typeName);
+	}
 
 	if (useReport == true) {
 		predictedType = tempRep.dec;
@@ -2265,7 +4291,10 @@ struct SemanticReport SA_evaluate_member_access(Node *topNode, SemanticTable *ta
 		rep = SA_check_restricted_member_access(topNode, table, topScope);
 	}
 
-	printf(">>>> >>>> >>>> EXIT! (%i)\n", rep.dec.type);
+	if (SEMANTIC_ANALYZER_DEBUG_MODE == 1) {
+		(void)printf(">>>> >>>> >>>> EXIT! (%i)\n", rep.dec.type);
+	}
+
 	return rep.status == ERROR ? rep : SA_create_semantic_report(rep.dec, SUCCESS, NULL, NONE, nullCont);
 }
 
@@ -2405,7 +4434,7 @@ struct SemanticReport SA_handle_inherited_functions_and_vars(SemanticTable **cur
 
 			if (classToSearch == NULL) {
 				continue;
-			} else if (classToSearch->internalType != EXT_CLASS_OR_INTERFACE) {
+			} else if (classToSearch->internalType != EXT_CLASS_OR_INTERFACE && classToSearch->internalType != CLASS_INHERIT) {
 				continue;
 			}
 			
@@ -2538,6 +4567,7 @@ struct SemanticReport SA_check_restricted_member_access(Node *node, SemanticTabl
 	}
 
 	retType = entry.entry->dec;
+	entry.entry->uses++;
 	
 	if (node->type == _FUNCTION_CALL_NODE_) {
 		struct SemanticReport rep = SA_evaluate_function_call(node, entry.entry, table, table, FNC_CALL);
@@ -2549,7 +4579,7 @@ struct SemanticReport SA_check_restricted_member_access(Node *node, SemanticTabl
 		retType = rep.dec;
 	}
 	
-	struct SemanticReport arrayRep = SA_handle_array_accesses(&retType, node, topScope);
+	struct SemanticReport arrayRep = SA_handle_array_accesses(&retType, node, table);
 
 	if (arrayRep.status == ERROR) {
 		return arrayRep;
@@ -2924,7 +4954,8 @@ struct SemanticReport SA_execute_access_type_checking(Node *cacheNode, SemanticT
 	}
 	
 	if (cacheNode->type == _CLASS_ACCESS_NODE_) {
-		if (currentScope->type != CLASS) {
+		//Enumerators are accessed like the members of a class (Color->RED)
+		if (currentScope->type != CLASS && currentScope->type != ENUM) {
 			char *msg = "Used \"->\" for non-class access instead of \".\".";
 			char *exp = "If you want to access a class externally, you have to use \"->\".";
 			char *sugg = "Maybe replace the \".\" with a \"->\".";
@@ -3806,8 +5837,8 @@ enum Visibility SA_get_visibility(Node *visibilityNode) {
 	if (visibilityNode == NULL) {
 		return P_GLOBAL;
 	} else if (visibilityNode->type != _MODIFIER_NODE_) {
-		printf("MODIFIER NODE IS INCORRECT!\n\n");
-		exit(EXIT_FAILURE);
+		(void)REPORT_DIAGNOSTIC(DIAG_PARSETREE_INVALID_NODE, SEVERITY_ERROR, visibilityNode->line, visibilityNode->position, 1, "Invalid modifier node.");
+		(void)ABORT_COMPILATION();
 	}
 
 	if ((int)strcmp("global", visibilityNode->value) == 0) {
@@ -3839,7 +5870,11 @@ struct SemanticReport SA_create_semantic_report(struct VarDec type, enum ErrorSt
 												struct ErrorContainer container) {
 	struct SemanticReport rep;
 	rep.dec = type;
-	printf(">>>> >>>> >>>> >>>> ERROR OCC: %i %i\n", status, errorType);
+
+	if (SEMANTIC_ANALYZER_DEBUG_MODE == 1) {
+		(void)printf(">>>> >>>> >>>> >>>> ERROR OCC: %i %i\n", status, errorType);
+	}
+
 	rep.status = status;
 	rep.errorNode = errorNode;
 	rep.errorType = errorType;
@@ -3951,6 +5986,8 @@ SemanticTable *SA_create_semantic_table(int paramCount, int symbolTableSize, Sem
 	table->type = type;
 	table->line = line;
 	table->position = position;
+	(void)ST_count(COUNTER_SCOPE_TABLES, 1);
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, sizeof(SemanticTable));
 	return table;
 }
 
@@ -3963,6 +6000,8 @@ void FREE_TABLE(SemanticTable *rootTable) {
 	}
 
 	(void)FREE_LIST(rootTable->paramList);
+	(void)FREE_CLASS_LAYOUT(rootTable->layout);
+	rootTable->layout = NULL;
 
 	for (int i = 0; i < rootTable->symbolTable->capacity; i++) {
 		if (rootTable->symbolTable->entries[i] == NULL) {
@@ -4079,10 +6118,9 @@ void THROW_ALREADY_DEFINED_EXCEPTION(struct SemanticReport rep) {
 }
 
 void THROW_MEMORY_RESERVATION_EXCEPTION(char *problemPosition) {
-	printf(TEXT_COLOR_RED "MemoryReservationException: at %s\n", problemPosition);
-	printf("Error was thrown while semantic analysis.\n");
-	printf("This error is an internal issue, please recompile.\n" TEXT_COLOR_RESET);
-	exit(EXIT_FAILURE);
+	(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "MemoryReservationException: at %s", problemPosition);
+	(void)REPORT_DIAGNOSTIC_DETAILS("Error was thrown while semantic analysis.", "This error is an internal issue, please recompile.");
+	(void)ABORT_COMPILATION();
 }
 
 /**
@@ -4094,74 +6132,25 @@ void THROW_MEMORY_RESERVATION_EXCEPTION(char *problemPosition) {
  * @param rep       Report to print
  */
 void THROW_EXCEPTION(char *message, struct SemanticReport rep) {
-	int charsInLine = 0;
-	int errorCharsAwayFromNL = 0;
 	struct Node *node = rep.errorNode;
+	struct ErrorContainer container = rep.container;
 
-	for (int i = node->position; i > 0; i--, errorCharsAwayFromNL++) {
-		if ((*BUFFER)[i - 1] == '\n' || (*BUFFER)[i - 1] == '\0') {
-			break;
-		}
-	}
-
-	for (int i = node->position - charsInLine; (*BUFFER)[i] != '\n' && (*BUFFER)[i] != '\0'; i++, charsInLine++);
-	charsInLine += errorCharsAwayFromNL;
+	SEMANTIC_ERROR_COUNT++;
 
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf("%s: at line ", message);
-	(void)printf(TEXT_UNDERLINE);
-	(void)printf(TEXT_COLOR_BLUE);
-	(void)printf("%li:%i", node->line + 1, errorCharsAwayFromNL);
-	(void)printf(TEXT_COLOR_RESET);
-	(void)printf(TEXT_COLOR_RED);
-	(void)printf(" from \"%s\"\n", FILE_NAME);
-	
-	if (rep.errorNode == NULL) {
-		(void)printf(TEXT_COLOR_RESET);
+	if (node == NULL) {
+		(void)REPORT_DIAGNOSTIC(DIAG_SEMANTIC + rep.errorType, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "%s", message);
 		return;
 	}
 
-	char firstFoldMeta[32];
-	int minSkip = (int)snprintf(firstFoldMeta, 32, "    at: ");
-	(void)printf("%s", firstFoldMeta);
-	(void)printf(TEXT_COLOR_GRAY);
-
-	for (int i = 0; i < charsInLine; i++) {
-		int pos = node->position - errorCharsAwayFromNL + i;
-		(void)printf("%c", (*BUFFER)[pos]);
-	}
-
-	(void)printf("\n");
-	(void)printf(TEXT_COLOR_RED);
-	int WSSP = node->position - errorCharsAwayFromNL;
-	int WSLen = node->position + minSkip;
-
-	for (int i = WSSP; i < WSLen; i++) {
-		(void)printf(" ");
-	}
-
-	(void)printf(TEXT_COLOR_YELLOW);
-
-	for (int i = 0; i < (int)strlen(node->value) && i < 1000; i++) {
-		(void)printf("^");
-	}
-
-	(void)printf("\n" TEXT_COLOR_RED);
-	struct ErrorContainer container = rep.container;
+	size_t length = node->value != NULL ? strlen(node->value) : 1;
 
 	if (container.description != NULL) {
-		(void)printf("    Error: %s\n", container.description);
-	}
-	
-	if (container.explanation != NULL) {
-		(void)printf("    Explanation: %s\n", container.explanation);
-	}
-
-	if (container.suggestion != NULL) {
-		(void)printf("    Suggestion: %s\n", container.suggestion);
+		(void)REPORT_DIAGNOSTIC(DIAG_SEMANTIC + rep.errorType, SEVERITY_ERROR, node->line, node->position, length, "%s: %s", message, container.description);
+	} else {
+		(void)REPORT_DIAGNOSTIC(DIAG_SEMANTIC + rep.errorType, SEVERITY_ERROR, node->line, node->position, length, "%s at \"%s\"", message, node->value != NULL ? node->value : "");
 	}
 
-	(void)printf(TEXT_COLOR_RESET);
+	(void)REPORT_DIAGNOSTIC_DETAILS(container.explanation, container.suggestion);
 }
 
 /**
@@ -4265,6 +6254,11 @@ char *SA_get_VarType_string(struct VarDec type) {
 		buffer = type.typeName;
 	}
 
+	//Types without a name (e.g. constructor parameters) are not in the lookup
+	if (buffer == NULL) {
+		buffer = "?";
+	}
+
 	char *string = (char*)calloc(size + 1, sizeof(char));
 	(void)strncpy(string, buffer, size);
 
@@ -4299,6 +6293,42 @@ char *SA_get_ScopeType_string(enum ScopeType type) {
 		return "CLASS";
 	case IF:
 		return "IF";
+	case MAIN:
+		return "MAIN";
+	case FUNCTION:
+		return "FUNCTION";
+	case ELSE:
+		return "ELSE";
+	case ELSE_IF:
+		return "ELSE_IF";
+	case CHECK:
+		return "CHECK";
+	case IS:
+		return "IS";
+	case FOR:
+		return "FOR";
+	case WHILE:
+		return "WHILE";
+	case DO:
+		return "DO";
+	case CLASS_INSTANCE:
+		return "CLASS_INSTANCE";
+	case CONSTRUCTOR:
+		return "CONSTRUCTOR";
+	case ENUM:
+		return "ENUM";
+	case ENUMERATOR:
+		return "ENUMERATOR";
+	case EXTERNAL:
+		return "EXTERNAL";
+	case TRY:
+		return "TRY";
+	case CATCH:
+		return "CATCH";
+	case FINALLY:
+		return "FINALLY";
+	case INTERFACE:
+		return "INTERFACE";
 	default: return "<REST>";
 	}
 }
\ No newline at end of file
@@ -0,0 +1,1122 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/parsetree.h"
+#include "../../headers/hashmap.h"
+#include "../../headers/list.h"
+#include "../../headers/semantic.h"
+#include "../../headers/json.h"
+#include "../../headers/lineindex.h"
+#include "../../headers/compiler.h"
+
+/**
+ * The subprogram {@code SPACE/src/Server/languageServer.c} was created
+ * to provide editor support over the Language Server Protocol.
+ *
+ * The server speaks JSON-RPC over stdin / stdout. A reader thread
+ * receives the messages and handles cancellations, while a single
+ * worker thread runs the compiler phases (the phases use global state
+ * and are therefore not reentrant).
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define LS_PARSE_ERROR -32700
+#define LS_INVALID_REQUEST -32600
+#define LS_METHOD_NOT_FOUND -32601
+#define LS_SERVER_NOT_INITIALIZED -32002
+#define LS_REQUEST_CANCELLED -32800
+
+#define LS_MAX_HEADER_LENGTH 1024
+
+char *SA_get_VarType_string(struct VarDec type);
+char *SA_get_ScopeType_string(enum ScopeType type);
+
+/**
+ * <p>
+ * An opened document with the results of its last analysis.
+ * </p>
+ */
+struct LSDocument {
+	char *uri;
+	char *text;
+	size_t length;
+	int version;
+
+	struct CompileResult *analysis;
+};
+
+struct LSQueueItem {
+	struct JsonValue *message;
+	struct LSQueueItem *next;
+};
+
+/**
+ * <p>
+ * State that is shared between the reader and the worker thread.
+ * </p>
+ *
+ * <p>
+ * The queue, the active request and the cancelled requests are guarded
+ * by the queueLock, the protocol output by the outputLock. Everything
+ * else (documents, compiler globals) is only touched by the worker thread.
+ * </p>
+ *
+ * <p>
+ * Only the cancellation of the active request is remembered (queued
+ * requests are answered right away), it is forgotten, when the worker
+ * is done with the request. So the cancelled requests hold at most one id.
+ * </p>
+ */
+struct LSServer {
+	FILE *protocolOut;
+	pthread_mutex_t outputLock;
+	pthread_mutex_t queueLock;
+	pthread_cond_t queueSignal;
+
+	struct LSQueueItem *queueHead;
+	struct LSQueueItem *queueTail;
+	struct HashMap *cancelledRequests;
+	//Key of the request, that the worker handles right now (NULL if none)
+	char *activeRequest;
+	int stopWorker;
+
+	struct HashMap *documents;
+	struct CompilerContext *compiler;
+	int initialized;
+	int shutdownRequested;
+};
+
+struct LSServer SERVER;
+
+struct JsonValue *LS_read_message(FILE *input);
+void LS_send_message(struct JsonBuffer *message);
+void LS_send_result(struct JsonValue *id, const char *result);
+void LS_send_error(struct JsonValue *id, int code, const char *message);
+char *LS_get_id_key(struct JsonValue *id);
+char *LS_get_method(struct JsonValue *message);
+char *LS_get_document_uri(struct JsonValue *message);
+
+void LS_enqueue_message(struct JsonValue *message);
+struct JsonValue *LS_dequeue_message();
+void LS_cancel_request(struct JsonValue *message);
+int LS_is_cancelled(struct JsonValue *id, int remove);
+int LS_is_superseded(char *uri);
+void *LS_worker(void *args);
+void LS_handle_message(struct JsonValue *message);
+
+void LS_handle_initialize(struct JsonValue *id);
+void LS_handle_did_open(struct JsonValue *params);
+void LS_handle_did_change(struct JsonValue *params);
+void LS_handle_did_close(struct JsonValue *params);
+void LS_handle_hover(struct JsonValue *id, struct JsonValue *params);
+void LS_handle_definition(struct JsonValue *id, struct JsonValue *params);
+
+struct LSDocument *LS_get_document(char *uri);
+struct LSDocument *LS_create_document(char *uri);
+void LS_set_document_text(struct LSDocument *document, char *text, int version);
+void LS_analyze_document(struct LSDocument *document);
+void LS_publish_diagnostics(struct LSDocument *document);
+size_t LS_get_offset(struct LSDocument *document, struct JsonValue *params);
+void LS_append_position(struct JsonBuffer *buffer, struct LSDocument *document, size_t position);
+void LS_append_range(struct JsonBuffer *buffer, struct LSDocument *document, size_t position, size_t length);
+
+TOKEN *LS_get_token_at(struct LSDocument *document, size_t offset);
+char *LS_get_symbol_name(TOKEN *token);
+SemanticEntry *LS_find_symbol(SemanticTable *table, char *name, size_t offset, size_t *bestPosition, SemanticEntry *best);
+
+void LS_free_analysis(struct LSDocument *document);
+void LS_free_documents();
+
+/**
+ * <p>
+ * Runs the compiler as a language server.
+ * </p>
+ *
+ * <p>
+ * The protocol is written on the original stdout, while the stdout of the
+ * process is redirected to stderr, so that the debug output of the
+ * compiler phases can't corrupt the message stream.
+ * </p>
+ *
+ * @returns 0 if the client requested a shutdown before exiting, else 1
+ */
+int RunLanguageServer() {
+	(void)fflush(stdout);
+	int protocolFd = (int)dup(STDOUT_FILENO);
+
+	if (protocolFd < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+		(void)IO_BUFFER_EXCEPTION("language server output");
+	}
+
+	SERVER.protocolOut = fdopen(protocolFd, "w");
+	SERVER.queueHead = NULL;
+	SERVER.queueTail = NULL;
+	SERVER.cancelledRequests = CreateNewHashMap(16);
+	SERVER.activeRequest = NULL;
+	SERVER.documents = CreateNewHashMap(16);
+	SERVER.compiler = CreateNewCompilerContext(NULL);
+	SERVER.stopWorker = false;
+	SERVER.initialized = false;
+	SERVER.shutdownRequested = false;
+	(void)pthread_mutex_init(&SERVER.outputLock, NULL);
+	(void)pthread_mutex_init(&SERVER.queueLock, NULL);
+	(void)pthread_cond_init(&SERVER.queueSignal, NULL);
+
+	pthread_t worker;
+
+	if (SERVER.protocolOut == NULL || pthread_create(&worker, NULL, LS_worker, NULL) != 0) {
+		(void)IO_BUFFER_EXCEPTION("language server");
+	}
+
+	while (true) {
+		struct JsonValue *message = LS_read_message(stdin);
+
+		if (message == NULL) {
+			break;
+		} else if (message->type != JSON_OBJECT) {
+			(void)LS_send_error(NULL, LS_PARSE_ERROR, "Invalid JSON-RPC message");
+			(void)JSON_free_value(message);
+			continue;
+		}
+
+		char *method = LS_get_method(message);
+
+		if (method != NULL && strcmp(method, "exit") == 0) {
+			(void)JSON_free_value(message);
+			break;
+		} else if (method != NULL && strcmp(method, "$/cancelRequest") == 0) {
+			(void)LS_cancel_request(message);
+			(void)JSON_free_value(message);
+			continue;
+		}
+
+		(void)LS_enqueue_message(message);
+	}
+
+	(void)pthread_mutex_lock(&SERVER.queueLock);
+	SERVER.stopWorker = true;
+	(void)pthread_cond_signal(&SERVER.queueSignal);
+	(void)pthread_mutex_unlock(&SERVER.queueLock);
+	(void)pthread_join(worker, NULL);
+
+	while (SERVER.queueHead != NULL) {
+		(void)JSON_free_value(LS_dequeue_message());
+	}
+
+	int exitCode = SERVER.shutdownRequested == true ? 0 : 1;
+
+	(void)LS_free_documents();
+	(void)FREE_COMPILER_CONTEXT(SERVER.compiler);
+	(void)HM_free(SERVER.cancelledRequests);
+	(void)fclose(SERVER.protocolOut);
+	(void)pthread_mutex_destroy(&SERVER.outputLock);
+	(void)pthread_mutex_destroy(&SERVER.queueLock);
+	(void)pthread_cond_destroy(&SERVER.queueSignal);
+	return exitCode;
+}
+
+/**
+ * <p>
+ * Reads a single message, that is framed by a "Content-Length" header.
+ * </p>
+ *
+ * @returns The parsed message (JSON_NULL if the body isn't valid JSON) or NULL at the end of the input
+ *
+ * @param *input    Stream to read from
+ */
+struct JsonValue *LS_read_message(FILE *input) {
+	char header[LS_MAX_HEADER_LENGTH];
+	long contentLength = -1;
+
+	while (fgets(header, LS_MAX_HEADER_LENGTH, input) != NULL) {
+		if (strcmp(header, "\r\n") == 0 || strcmp(header, "\n") == 0) {
+			if (contentLength < 0) {
+				continue;
+			}
+
+			char *content = (char*)calloc(contentLength + 1, sizeof(char));
+
+			if (content == NULL) {
+				(void)IO_BUFFER_RESERVATION_EXCEPTION();
+			}
+
+			if (fread(content, sizeof(char), contentLength, input) != (size_t)contentLength) {
+				(void)free(content);
+				return NULL;
+			}
+
+			struct JsonValue *message = JSON_parse(content, contentLength);
+			(void)free(content);
+
+			if (message == NULL) {
+				message = (struct JsonValue*)calloc(1, sizeof(struct JsonValue));
+
+				if (message == NULL) {
+					(void)IO_BUFFER_RESERVATION_EXCEPTION();
+				}
+
+				message->type = JSON_NULL;
+			}
+
+			return message;
+		} else if (strncmp(header, "Content-Length:", 15) == 0) {
+			contentLength = (long)strtol(header + 15, NULL, 10);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Writes the message with its header to the protocol output.
+ * </p>
+ *
+ * @param *message  JSON text of the message
+ */
+void LS_send_message(struct JsonBuffer *message) {
+	(void)pthread_mutex_lock(&SERVER.outputLock);
+	(void)fprintf(SERVER.protocolOut, "Content-Length: %lu\r\n\r\n", (unsigned long)message->length);
+	(void)fwrite(message->data, sizeof(char), message->length, SERVER.protocolOut);
+	(void)fflush(SERVER.protocolOut);
+	(void)pthread_mutex_unlock(&SERVER.outputLock);
+}
+
+/**
+ * <p>
+ * Sends a response with the given (already serialized) result.
+ * </p>
+ *
+ * @param *id       ID of the request
+ * @param *result   JSON text of the result
+ */
+void LS_send_result(struct JsonValue *id, const char *result) {
+	struct JsonBuffer *buffer = CreateNewJsonBuffer(64 + strlen(result));
+	(void)JSON_append_format(buffer, "{\"jsonrpc\":\"2.0\",\"id\":");
+	(void)JSON_append_value(buffer, id);
+	(void)JSON_append_format(buffer, ",\"result\":%s}", result);
+	(void)LS_send_message(buffer);
+	(void)JSON_free_buffer(buffer);
+}
+
+/**
+ * <p>
+ * Sends an error response.
+ * </p>
+ *
+ * @param *id       ID of the request (NULL for unknown ids)
+ * @param code      JSON-RPC error code
+ * @param *message  Error description
+ */
+void LS_send_error(struct JsonValue *id, int code, const char *message) {
+	struct JsonBuffer *buffer = CreateNewJsonBuffer(128);
+	(void)JSON_append_format(buffer, "{\"jsonrpc\":\"2.0\",\"id\":");
+	(void)JSON_append_value(buffer, id);
+	(void)JSON_append_format(buffer, ",\"error\":{\"code\":%i,\"message\":", code);
+	(void)JSON_append_string(buffer, message);
+	(void)JSON_append_format(buffer, "}}");
+	(void)LS_send_message(buffer);
+	(void)JSON_free_buffer(buffer);
+}
+
+/**
+ * <p>
+ * Serializes a request id, so it can be used as a HashMap key
+ * (ids can either be numbers or strings).
+ * </p>
+ *
+ * @returns The allocated key
+ *
+ * @param *id   ID to serialize
+ */
+char *LS_get_id_key(struct JsonValue *id) {
+	struct JsonBuffer *buffer = CreateNewJsonBuffer(16);
+	(void)JSON_append_value(buffer, id);
+	char *key = buffer->data;
+	(void)free(buffer);
+	return key;
+}
+
+char *LS_get_method(struct JsonValue *message) {
+	return JSON_get_string(message, "method");
+}
+
+/**
+ * <p>
+ * Gets the "params.textDocument.uri" of a message.
+ * </p>
+ *
+ * @returns The uri or NULL if the message has no document
+ *
+ * @param *message  Message to get the uri from
+ */
+char *LS_get_document_uri(struct JsonValue *message) {
+	struct JsonValue *params = JSON_get_member(message, "params");
+	return JSON_get_string(JSON_get_member(params, "textDocument"), "uri");
+}
+
+void LS_enqueue_message(struct JsonValue *message) {
+	struct LSQueueItem *item = (struct LSQueueItem*)calloc(1, sizeof(struct LSQueueItem));
+
+	if (item == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	item->message = message;
+	item->next = NULL;
+
+	(void)pthread_mutex_lock(&SERVER.queueLock);
+
+	if (SERVER.queueTail == NULL) {
+		SERVER.queueHead = item;
+	} else {
+		SERVER.queueTail->next = item;
+	}
+
+	SERVER.queueTail = item;
+	(void)pthread_cond_signal(&SERVER.queueSignal);
+	(void)pthread_mutex_unlock(&SERVER.queueLock);
+}
+
+/**
+ * <p>
+ * Removes the first message from the queue.
+ * </p>
+ *
+ * <p><strong>Note:</strong> The queueLock has to be held by the caller.</p>
+ *
+ * @returns The message or NULL if the queue is empty
+ */
+struct JsonValue *LS_dequeue_message() {
+	struct LSQueueItem *item = SERVER.queueHead;
+
+	if (item == NULL) {
+		return NULL;
+	}
+
+	SERVER.queueHead = item->next;
+
+	if (SERVER.queueHead == NULL) {
+		SERVER.queueTail = NULL;
+	}
+
+	struct JsonValue *message = item->message;
+	(void)free(item);
+	return message;
+}
+
+/**
+ * <p>
+ * Handles a "$/cancelRequest" on the reader thread.
+ * </p>
+ *
+ * <p>
+ * A request that is still queued gets removed and answered directly,
+ * otherwise the id is remembered, so that the worker can drop the
+ * request before or after processing it.
+ * </p>
+ *
+ * @param *message  The cancel notification
+ */
+void LS_cancel_request(struct JsonValue *message) {
+	struct JsonValue *id = JSON_get_member(JSON_get_member(message, "params"), "id");
+
+	if (id == NULL) {
+		return;
+	}
+
+	char *key = LS_get_id_key(id);
+	struct JsonValue *cancelled = NULL;
+
+	(void)pthread_mutex_lock(&SERVER.queueLock);
+
+	struct LSQueueItem *prev = NULL;
+
+	for (struct LSQueueItem *item = SERVER.queueHead; item != NULL; prev = item, item = item->next) {
+		struct JsonValue *itemId = JSON_get_member(item->message, "id");
+
+		if (itemId == NULL) {
+			continue;
+		}
+
+		char *itemKey = LS_get_id_key(itemId);
+		int matches = strcmp(itemKey, key) == 0 ? true : false;
+		(void)free(itemKey);
+
+		if (matches == false) {
+			continue;
+		}
+
+		if (prev == NULL) {
+			SERVER.queueHead = item->next;
+		} else {
+			prev->next = item->next;
+		}
+
+		if (SERVER.queueTail == item) {
+			SERVER.queueTail = prev;
+		}
+
+		cancelled = item->message;
+		(void)free(item);
+		break;
+	}
+
+	//Unknown and already answered requests are ignored
+	if (cancelled == NULL && SERVER.activeRequest != NULL && strcmp(SERVER.activeRequest, key) == 0
+		&& (int)HM_contains_key(key, SERVER.cancelledRequests) == false) {
+		//The key is stored as value as well, so the HashMap frees it
+		(void)HM_add_entry(key, key, SERVER.cancelledRequests);
+		key = NULL;
+	}
+
+	(void)pthread_mutex_unlock(&SERVER.queueLock);
+
+	if (cancelled != NULL) {
+		(void)LS_send_error(JSON_get_member(cancelled, "id"), LS_REQUEST_CANCELLED, "Request cancelled");
+		(void)JSON_free_value(cancelled);
+	}
+
+	if (key != NULL) {
+		(void)free(key);
+	}
+}
+
+/**
+ * <p>
+ * Checks if the request with the given id was cancelled.
+ * </p>
+ *
+ * @returns True if the request was cancelled, else false
+ *
+ * @param *id       ID of the request
+ * @param remove    Forget the cancellation after the check
+ */
+int LS_is_cancelled(struct JsonValue *id, int remove) {
+	char *key = LS_get_id_key(id);
+	int cancelled = false;
+
+	(void)pthread_mutex_lock(&SERVER.queueLock);
+	struct HashMapEntry *entry = HM_get_entry(key, SERVER.cancelledRequests);
+
+	if (entry != NULL) {
+		cancelled = true;
+
+		if (remove == true) {
+			(void)HM_remove_entry(entry, SERVER.cancelledRequests);
+		}
+	}
+
+	(void)pthread_mutex_unlock(&SERVER.queueLock);
+	(void)free(key);
+	return cancelled;
+}
+
+/**
+ * <p>
+ * Checks if a newer change or close of the document is already queued.
+ * In that case the analysis of the current change can be skipped, since
+ * the client always sends the full text.
+ * </p>
+ *
+ * @returns True if a newer message supersedes the current change
+ *
+ * @param *uri  URI of the changed document
+ */
+int LS_is_superseded(char *uri) {
+	int superseded = false;
+
+	(void)pthread_mutex_lock(&SERVER.queueLock);
+
+	for (struct LSQueueItem *item = SERVER.queueHead; item != NULL; item = item->next) {
+		char *method = LS_get_method(item->message);
+		char *itemUri = LS_get_document_uri(item->message);
+
+		if (method == NULL || itemUri == NULL || strcmp(itemUri, uri) != 0) {
+			continue;
+		}
+
+		if (strcmp(method, "textDocument/didChange") == 0
+			|| strcmp(method, "textDocument/didClose") == 0) {
+			superseded = true;
+			break;
+		}
+	}
+
+	(void)pthread_mutex_unlock(&SERVER.queueLock);
+	return superseded;
+}
+
+void *LS_worker(void *args) {
+	while (true) {
+		(void)pthread_mutex_lock(&SERVER.queueLock);
+
+		while (SERVER.queueHead == NULL && SERVER.stopWorker == false) {
+			(void)pthread_cond_wait(&SERVER.queueSignal, &SERVER.queueLock);
+		}
+
+		//Messages that arrived before "exit" (e.g. "shutdown") are still processed
+		if (SERVER.queueHead == NULL && SERVER.stopWorker == true) {
+			(void)pthread_mutex_unlock(&SERVER.queueLock);
+			break;
+		}
+
+		struct JsonValue *message = LS_dequeue_message();
+		struct JsonValue *id = JSON_get_member(message, "id");
+		SERVER.activeRequest = id == NULL ? NULL : LS_get_id_key(id);
+		(void)pthread_mutex_unlock(&SERVER.queueLock);
+
+		(void)LS_handle_message(message);
+
+		//A cancellation, that came after the answer, is dropped with the request
+		(void)pthread_mutex_lock(&SERVER.queueLock);
+
+		if (SERVER.activeRequest != NULL) {
+			struct HashMapEntry *entry = HM_get_entry(SERVER.activeRequest, SERVER.cancelledRequests);
+
+			if (entry != NULL) {
+				(void)HM_remove_entry(entry, SERVER.cancelledRequests);
+			}
+
+			(void)free(SERVER.activeRequest);
+			SERVER.activeRequest = NULL;
+		}
+
+		(void)pthread_mutex_unlock(&SERVER.queueLock);
+
+		(void)JSON_free_value(message);
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Dispatches a message to its handler.
+ * </p>
+ *
+ * <p>
+ * Requests that got cancelled are answered with a "RequestCancelled"
+ * error instead of their result. This is checked before and after
+ * processing.
+ * </p>
+ *
+ * @param *message  Message to handle
+ */
+void LS_handle_message(struct JsonValue *message) {
+	struct JsonValue *id = JSON_get_member(message, "id");
+	struct JsonValue *params = JSON_get_member(message, "params");
+	char *method = LS_get_method(message);
+
+	if (method == NULL) {
+		if (id != NULL) {
+			(void)LS_send_error(id, LS_INVALID_REQUEST, "Missing method");
+		}
+
+		return;
+	}
+
+	if (id != NULL && (int)LS_is_cancelled(id, true) == true) {
+		(void)LS_send_error(id, LS_REQUEST_CANCELLED, "Request cancelled");
+		return;
+	}
+
+	if (strcmp(method, "initialize") == 0) {
+		(void)LS_handle_initialize(id);
+		return;
+	} else if (SERVER.initialized == false) {
+		if (id != NULL) {
+			(void)LS_send_error(id, LS_SERVER_NOT_INITIALIZED, "Server not initialized");
+		}
+
+		return;
+	}
+
+	if (strcmp(method, "shutdown") == 0) {
+		SERVER.shutdownRequested = true;
+		(void)LS_send_result(id, "null");
+	} else if (strcmp(method, "textDocument/didOpen") == 0) {
+		(void)LS_handle_did_open(params);
+	} else if (strcmp(method, "textDocument/didChange") == 0) {
+		(void)LS_handle_did_change(params);
+	} else if (strcmp(method, "textDocument/didClose") == 0) {
+		(void)LS_handle_did_close(params);
+	} else if (strcmp(method, "textDocument/hover") == 0) {
+		(void)LS_handle_hover(id, params);
+	} else if (strcmp(method, "textDocument/definition") == 0) {
+		(void)LS_handle_definition(id, params);
+	} else if (id != NULL) {
+		(void)LS_send_error(id, LS_METHOD_NOT_FOUND, "Method not found");
+	}
+}
+
+void LS_handle_initialize(struct JsonValue *id) {
+	SERVER.initialized = true;
+	(void)LS_send_result(id,
+		"{\"capabilities\":{\"textDocumentSync\":1,\"hoverProvider\":true,\"definitionProvider\":true},"
+		"\"serverInfo\":{\"name\":\"space-lsp\",\"version\":\"0.0.1\"}}");
+}
+
+void LS_handle_did_open(struct JsonValue *params) {
+	struct JsonValue *textDocument = JSON_get_member(params, "textDocument");
+	char *uri = JSON_get_string(textDocument, "uri");
+	char *text = JSON_get_string(textDocument, "text");
+
+	if (uri == NULL || text == NULL) {
+		return;
+	}
+
+	struct LSDocument *document = LS_get_document(uri);
+
+	if (document == NULL) {
+		document = LS_create_document(uri);
+	}
+
+	(void)LS_set_document_text(document, text, (int)JSON_get_number(textDocument, "version", 0));
+	(void)LS_analyze_document(document);
+	(void)LS_publish_diagnostics(document);
+}
+
+/**
+ * <p>
+ * Handles a full text change of a document. If a newer change is
+ * already waiting in the queue, this change is skipped.
+ * </p>
+ *
+ * @param *params   Parameters of the notification
+ */
+void LS_handle_did_change(struct JsonValue *params) {
+	struct JsonValue *textDocument = JSON_get_member(params, "textDocument");
+	struct JsonValue *changes = JSON_get_member(params, "contentChanges");
+	char *uri = JSON_get_string(textDocument, "uri");
+
+	if (uri == NULL || changes == NULL || changes->type != JSON_ARRAY || changes->count == 0) {
+		return;
+	}
+
+	struct LSDocument *document = LS_get_document(uri);
+	char *text = JSON_get_string(changes->items[changes->count - 1], "text");
+
+	if (document == NULL || text == NULL || (int)LS_is_superseded(uri) == true) {
+		return;
+	}
+
+	(void)LS_set_document_text(document, text, (int)JSON_get_number(textDocument, "version", 0));
+	(void)LS_analyze_document(document);
+	(void)LS_publish_diagnostics(document);
+}
+
+void LS_handle_did_close(struct JsonValue *params) {
+	char *uri = JSON_get_string(JSON_get_member(params, "textDocument"), "uri");
+	struct HashMapEntry *entry = uri == NULL ? NULL : HM_get_entry(uri, SERVER.documents);
+
+	if (entry == NULL) {
+		return;
+	}
+
+	struct LSDocument *document = (struct LSDocument*)entry->value;
+	char *key = document->uri;
+
+	(void)LS_free_analysis(document);
+	(void)LS_publish_diagnostics(document);
+	(void)free(document->text);
+	(void)HM_remove_entry(entry, SERVER.documents);
+	(void)free(key);
+}
+
+/**
+ * <p>
+ * Answers a hover request with the declaration of the symbol
+ * under the cursor.
+ * </p>
+ *
+ * @param *id       ID of the request
+ * @param *params   Parameters of the request
+ */
+void LS_handle_hover(struct JsonValue *id, struct JsonValue *params) {
+	char *uri = JSON_get_string(JSON_get_member(params, "textDocument"), "uri");
+	struct LSDocument *document = uri == NULL ? NULL : LS_get_document(uri);
+	size_t offset = document == NULL ? 0 : LS_get_offset(document, params);
+	TOKEN *token = document == NULL ? NULL : LS_get_token_at(document, offset);
+	char *name = LS_get_symbol_name(token);
+	size_t bestPosition = 0;
+	SemanticEntry *entry = name == NULL || document->analysis->table == NULL ? NULL
+		: LS_find_symbol(document->analysis->table, name, offset, &bestPosition, NULL);
+
+	if ((int)LS_is_cancelled(id, true) == true) {
+		(void)LS_send_error(id, LS_REQUEST_CANCELLED, "Request cancelled");
+		return;
+	} else if (entry == NULL) {
+		(void)LS_send_result(id, "null");
+		return;
+	}
+
+	char *type = SA_get_VarType_string(entry->dec);
+	struct JsonBuffer *buffer = CreateNewJsonBuffer(128);
+	struct JsonBuffer *contents = CreateNewJsonBuffer(64);
+	(void)JSON_append_format(contents, "%s%s %s : %s", entry->dec.constant == true ? "const " : "",
+		SA_get_ScopeType_string(entry->internalType), entry->name, type);
+	(void)JSON_append_format(buffer, "{\"contents\":{\"kind\":\"plaintext\",\"value\":");
+	(void)JSON_append_string(buffer, contents->data);
+	(void)JSON_append_format(buffer, "},\"range\":");
+	(void)LS_append_range(buffer, document, token->tokenStart, strlen(token->value));
+	(void)JSON_append_format(buffer, "}");
+	(void)LS_send_result(id, buffer->data);
+
+	(void)free(type);
+	(void)JSON_free_buffer(contents);
+	(void)JSON_free_buffer(buffer);
+}
+
+/**
+ * <p>
+ * Answers a definition request with the location, where the symbol
+ * under the cursor is declared.
+ * </p>
+ *
+ * @param *id       ID of the request
+ * @param *params   Parameters of the request
+ */
+void LS_handle_definition(struct JsonValue *id, struct JsonValue *params) {
+	char *uri = JSON_get_string(JSON_get_member(params, "textDocument"), "uri");
+	struct LSDocument *document = uri == NULL ? NULL : LS_get_document(uri);
+	size_t offset = document == NULL ? 0 : LS_get_offset(document, params);
+	TOKEN *token = document == NULL ? NULL : LS_get_token_at(document, offset);
+	char *name = LS_get_symbol_name(token);
+	size_t bestPosition = 0;
+	SemanticEntry *entry = name == NULL || document->analysis->table == NULL ? NULL
+		: LS_find_symbol(document->analysis->table, name, offset, &bestPosition, NULL);
+
+	if ((int)LS_is_cancelled(id, true) == true) {
+		(void)LS_send_error(id, LS_REQUEST_CANCELLED, "Request cancelled");
+		return;
+	} else if (entry == NULL) {
+		(void)LS_send_result(id, "null");
+		return;
+	}
+
+	struct JsonBuffer *buffer = CreateNewJsonBuffer(128);
+	(void)JSON_append_format(buffer, "{\"uri\":");
+	(void)JSON_append_string(buffer, document->uri);
+	(void)JSON_append_format(buffer, ",\"range\":");
+	(void)LS_append_range(buffer, document, entry->position, strlen(entry->name));
+	(void)JSON_append_format(buffer, "}");
+	(void)LS_send_result(id, buffer->data);
+	(void)JSON_free_buffer(buffer);
+}
+
+struct LSDocument *LS_get_document(char *uri) {
+	struct HashMapEntry *entry = HM_get_entry(uri, SERVER.documents);
+	return entry == NULL ? NULL : (struct LSDocument*)entry->value;
+}
+
+struct LSDocument *LS_create_document(char *uri) {
+	struct LSDocument *document = (struct LSDocument*)calloc(1, sizeof(struct LSDocument));
+	size_t length = strlen(uri);
+
+	if (document == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	document->uri = (char*)calloc(length + 1, sizeof(char));
+
+	if (document->uri == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	(void)memcpy(document->uri, uri, length);
+	(void)HM_add_entry(document->uri, document, SERVER.documents);
+	return document;
+}
+
+void LS_set_document_text(struct LSDocument *document, char *text, int version) {
+	size_t length = strlen(text);
+	char *copy = (char*)calloc(length + 1, sizeof(char));
+
+	if (copy == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	(void)memcpy(copy, text, length);
+
+	if (document->text != NULL) {
+		(void)free(document->text);
+	}
+
+	document->text = copy;
+	document->length = length;
+	document->version = version;
+}
+
+/**
+ * <p>
+ * Runs the lexer, syntax analyzer, parsetree generator and semantic
+ * analyzer on the document and collects the reported errors.
+ * </p>
+ *
+ * <p>
+ * The parsetree is only generated if the syntax is free of errors.
+ * Fatal errors only stop the analysis of this document.
+ * The result of CompileBuffer() (tokens, parsetree and symbol tables) is
+ * kept for hover and definition requests until the next analysis.
+ * </p>
+ *
+ * @param *document     Document to analyze
+ */
+void LS_analyze_document(struct LSDocument *document) {
+	(void)LS_free_analysis(document);
+	document->analysis = CompileBuffer(SERVER.compiler, document->uri, document->text, document->length, NULL);
+}
+
+void LS_publish_diagnostics(struct LSDocument *document) {
+	struct JsonBuffer *buffer = CreateNewJsonBuffer(256);
+	(void)JSON_append_format(buffer, "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":");
+	(void)JSON_append_string(buffer, document->uri);
+	(void)JSON_append_format(buffer, ",\"version\":%i,\"diagnostics\":[", document->version);
+
+	struct DiagnosticSink *diagnostics = document->analysis == NULL ? NULL : document->analysis->diagnostics;
+	size_t count = diagnostics == NULL ? 0 : diagnostics->count;
+
+	for (size_t i = 0; i < count; i++) {
+		struct Diagnostic *diagnostic = &diagnostics->entries[i];
+		(void)JSON_append_format(buffer, "%s{\"range\":", i == 0 ? "" : ",");
+
+		if (diagnostic->position <= document->length) {
+			(void)LS_append_range(buffer, document, diagnostic->position, diagnostic->length == 0 ? 1 : diagnostic->length);
+		} else {
+			(void)JSON_append_format(buffer, "{\"start\":{\"line\":%lu,\"character\":0},\"end\":{\"line\":%lu,\"character\":0}}",
+				(unsigned long)diagnostic->line, (unsigned long)diagnostic->line);
+		}
+
+		(void)JSON_append_format(buffer, ",\"severity\":%i,\"code\":%i,\"source\":\"space\",\"message\":",
+			(int)diagnostic->severity + 1, (int)diagnostic->code);
+		(void)JSON_append_string(buffer, diagnostic->message);
+		(void)JSON_append_format(buffer, "}");
+	}
+
+	(void)JSON_append_format(buffer, "]}}");
+	(void)LS_send_message(buffer);
+	(void)JSON_free_buffer(buffer);
+}
+
+/**
+ * <p>
+ * Converts the "params.position" of a request into a buffer offset.
+ * </p>
+ *
+ * <p><strong>Note:</strong> Characters are counted in bytes, not in UTF-16 code units.</p>
+ *
+ * @returns The offset in the document text
+ */
+size_t LS_get_offset(struct LSDocument *document, struct JsonValue *params) {
+	struct JsonValue *position = JSON_get_member(params, "position");
+	size_t line = (size_t)JSON_get_number(position, "line", 0);
+	size_t character = (size_t)JSON_get_number(position, "character", 0);
+
+	struct LineIndex *lines = document->analysis == NULL ? NULL : document->analysis->lines;
+
+	if (lines == NULL || line >= lines->count) {
+		return document->length;
+	}
+
+	size_t offset = LI_get_line_start(lines, line) + character;
+	return offset > document->length ? document->length : offset;
+}
+
+void LS_append_position(struct JsonBuffer *buffer, struct LSDocument *document, size_t position) {
+	struct SourceLocation location = LI_locate(document->analysis->lines, position);
+	(void)JSON_append_format(buffer, "{\"line\":%lu,\"character\":%lu}",
+		(unsigned long)location.line, (unsigned long)location.column);
+}
+
+void LS_append_range(struct JsonBuffer *buffer, struct LSDocument *document, size_t position, size_t length) {
+	size_t end = position + length > document->length ? document->length : position + length;
+	(void)JSON_append_format(buffer, "{\"start\":");
+	(void)LS_append_position(buffer, document, position);
+	(void)JSON_append_format(buffer, ",\"end\":");
+	(void)LS_append_position(buffer, document, end);
+	(void)JSON_append_format(buffer, "}");
+}
+
+/**
+ * <p>
+ * Searches the token, that covers the given offset.
+ * </p>
+ *
+ * @returns The token or NULL if there's no token at the offset
+ *
+ * @param *document     Analyzed document
+ * @param offset        Offset in the document text
+ */
+TOKEN *LS_get_token_at(struct LSDocument *document, size_t offset) {
+	if (document->analysis == NULL || document->analysis->tokens == NULL) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < document->analysis->tokenCount; i++) {
+		TOKEN *token = &document->analysis->tokens[i];
+
+		if (token->value == NULL || token->type == __EOF__) {
+			continue;
+		}
+
+		size_t length = strlen(token->value);
+
+		if (offset >= token->tokenStart && offset <= token->tokenStart + length) {
+			return token;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * <p>
+ * Gets the name of the symbol a token refers to, pointers
+ * and references ("*a", "&a") refer to the variable itself.
+ * </p>
+ *
+ * @returns The name or NULL if the token isn't an identifier
+ */
+char *LS_get_symbol_name(TOKEN *token) {
+	if (token == NULL) {
+		return NULL;
+	}
+
+	switch (token->type) {
+	case _IDENTIFIER_:
+		return token->value;
+	case _POINTER_:
+	case _REFERENCE_:
+	case _REFERENCE_ON_POINTER_: {
+		char *name = token->value;
+
+		while (*name == '*' || *name == '&') {
+			name++;
+		}
+
+		return *name == '\0' ? NULL : name;
+	}
+	default:
+		return NULL;
+	}
+}
+
+/**
+ * <p>
+ * Searches the declaration of a symbol in the table tree.
+ * </p>
+ *
+ * <p>
+ * All tables are visited and the entry, that is declared in the innermost
+ * scope before the offset wins (the table with the highest position that
+ * isn't after the offset). If no declaration precedes the offset, any
+ * declaration with the name is taken (e.g. functions called before they're defined).
+ * </p>
+ *
+ * @returns The found entry or NULL
+ *
+ * @param *table            Table to search in
+ * @param *name             Name of the symbol
+ * @param offset            Offset of the usage
+ * @param *bestPosition     Position of the table of the current best match
+ * @param *best             Current best match
+ */
+SemanticEntry *LS_find_symbol(SemanticTable *table, char *name, size_t offset, size_t *bestPosition, SemanticEntry *best) {
+	if (table == NULL) {
+		return best;
+	}
+
+	int preceding = table->type == MAIN || table->position <= offset ? true : false;
+
+	if (table->paramList != NULL) {
+		for (size_t i = 0; i < table->paramList->load; i++) {
+			SemanticEntry *param = (SemanticEntry*)L_get_item(table->paramList, i);
+
+			if (param != NULL && param->name != NULL && strcmp(param->name, name) == 0
+				&& (best == NULL || (preceding == true && table->position >= *bestPosition))) {
+				best = param;
+				*bestPosition = table->position;
+			}
+		}
+	}
+
+	struct HashMap *map = table->symbolTable;
+
+	for (int i = 0; map != NULL && i < map->capacity; i++) {
+		for (struct HashMapEntry *entry = map->entries[i]; entry != NULL; entry = entry->linkedEntry) {
+			SemanticEntry *value = (SemanticEntry*)entry->value;
+
+			if (value == NULL) {
+				continue;
+			}
+
+			if (value->name != NULL && strcmp(value->name, name) == 0
+				&& (best == NULL || (preceding == true && table->position >= *bestPosition))) {
+				best = value;
+				*bestPosition = table->position;
+			}
+
+			if (value->reference != NULL && value->internalType != VARIABLE) {
+				best = LS_find_symbol((SemanticTable*)value->reference, name, offset, bestPosition, best);
+			}
+		}
+	}
+
+	return best;
+}
+
+/**
+ * <p>
+ * Frees the tokens, parsetree, symbol tables and
+ * diagnostics of the last analysis.
+ * </p>
+ */
+void LS_free_analysis(struct LSDocument *document) {
+	(void)FREE_COMPILE_RESULT(document->analysis);
+	document->analysis = NULL;
+}
+
+void LS_free_documents() {
+	for (int i = 0; i < SERVER.documents->capacity; i++) {
+		for (struct HashMapEntry *entry = SERVER.documents->entries[i]; entry != NULL; entry = entry->linkedEntry) {
+			struct LSDocument *document = (struct LSDocument*)entry->value;
+
+			(void)LS_free_analysis(document);
+			(void)free(document->text);
+			(void)free(document->uri);
+		}
+	}
+
+	(void)HM_free(SERVER.documents);
+}
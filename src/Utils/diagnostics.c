@@ -0,0 +1,523 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include "../../headers/diagnostics.h"
+#include "../../headers/modules.h"
+
+/**
+ * The subprogram {@code SPACE/src/Utils/diagnostics.c} was created
+ * to collect the errors and warnings of all compiler phases.
+ *
+ * Instead of terminating the process, every phase appends its
+ * diagnostics to a sink, which can be rendered or inspected later.
+ * The sink never holds more than {@code maxEntries} diagnostics.
+ *
+ * The renderer turns the collected diagnostics into text, JSON or
+ * SARIF. All output is built in one buffer and written at once.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * Creates a new, empty diagnostics sink.
+ * </p>
+ *
+ * @returns A pointer to the sink or NULL if it couldn't be allocated
+ *
+ * @param maxEntries    Maximum number of stored diagnostics (0 for the default)
+ */
+struct DiagnosticSink *CreateNewDiagnosticSink(size_t maxEntries) {
+	struct DiagnosticSink *sink = (struct DiagnosticSink*)calloc(1, sizeof(struct DiagnosticSink));
+
+	if (sink == NULL) {
+		(void)printf("ERROR on reserving diagnostics sink!\n");
+		return NULL;
+	}
+
+	sink->maxEntries = maxEntries == 0 ? DIAGNOSTIC_DEFAULT_MAX_ENTRIES : maxEntries;
+	return sink;
+}
+
+/**
+ * <p>
+ * Appends a diagnostic to the sink.
+ * </p>
+ *
+ * <p>
+ * The message is formatted like printf() and cut at DIAGNOSTIC_MAX_MESSAGE_LENGTH.
+ * If the sink is full, the diagnostic is only counted.
+ * </p>
+ *
+ * @param *sink         Sink to append to (ignored if NULL)
+ * @param code          Code of the diagnostic
+ * @param severity      Severity of the diagnostic
+ * @param *file         Name of the affected file
+ * @param line          Line of the problem (0-based)
+ * @param position      Offset in the source buffer or DIAGNOSTIC_NO_POSITION
+ * @param length        Length of the affected source span
+ * @param *format       Format of the message
+ */
+void DG_report(struct DiagnosticSink *sink, enum DiagnosticCode code, enum DiagnosticSeverity severity, const char *file, size_t line, size_t position, size_t length, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	(void)DG_vreport(sink, code, severity, file, line, position, length, format, args);
+	va_end(args);
+}
+
+void DG_vreport(struct DiagnosticSink *sink, enum DiagnosticCode code, enum DiagnosticSeverity severity, const char *file, size_t line, size_t position, size_t length, const char *format, va_list args) {
+	if (sink == NULL) {
+		return;
+	}
+
+	if (severity == SEVERITY_ERROR) {
+		sink->errors++;
+	} else if (severity == SEVERITY_WARNING) {
+		sink->warnings++;
+	}
+
+	sink->lastStored = false;
+
+	if (sink->count >= sink->maxEntries) {
+		sink->dropped++;
+		return;
+	}
+
+	if (sink->count >= sink->capacity) {
+		size_t newCapacity = sink->capacity == 0 ? 16 : sink->capacity * 2;
+		newCapacity = newCapacity > sink->maxEntries ? sink->maxEntries : newCapacity;
+		struct Diagnostic *entries = (struct Diagnostic*)realloc(sink->entries, newCapacity * sizeof(struct Diagnostic));
+
+		if (entries == NULL) {
+			sink->dropped++;
+			return;
+		}
+
+		sink->entries = entries;
+		sink->capacity = newCapacity;
+	}
+
+	struct Diagnostic *diagnostic = &sink->entries[sink->count++];
+	diagnostic->code = code;
+	diagnostic->severity = severity;
+	diagnostic->file = file;
+	diagnostic->line = line;
+	diagnostic->position = position;
+	diagnostic->length = length;
+	diagnostic->explanation[0] = '\0';
+	diagnostic->suggestion[0] = '\0';
+	(void)vsnprintf(diagnostic->message, DIAGNOSTIC_MAX_MESSAGE_LENGTH, format, args);
+	sink->lastStored = true;
+}
+
+/**
+ * <p>
+ * Attaches an explanation and a suggestion to the last reported diagnostic.
+ * </p>
+ *
+ * @param *sink         Sink of the diagnostic
+ * @param *explanation  Why the error occured (can be NULL)
+ * @param *suggestion   How to fix the error (can be NULL)
+ */
+void DG_set_details(struct DiagnosticSink *sink, const char *explanation, const char *suggestion) {
+	if (sink == NULL || sink->lastStored == false || sink->count == 0) {
+		return;
+	}
+
+	struct Diagnostic *diagnostic = &sink->entries[sink->count - 1];
+
+	if (explanation != NULL) {
+		(void)snprintf(diagnostic->explanation, DIAGNOSTIC_MAX_NOTE_LENGTH, "%s", explanation);
+	}
+
+	if (suggestion != NULL) {
+		(void)snprintf(diagnostic->suggestion, DIAGNOSTIC_MAX_NOTE_LENGTH, "%s", suggestion);
+	}
+}
+
+int DG_has_errors(struct DiagnosticSink *sink) {
+	return sink != NULL && sink->errors > 0 ? true : false;
+}
+
+/**
+ * <p>
+ * Removes all diagnostics and resets the counters,
+ * the reserved memory is kept for the next run.
+ * </p>
+ *
+ * @param *sink     Sink to clear
+ */
+void DG_clear(struct DiagnosticSink *sink) {
+	if (sink == NULL) {
+		return;
+	}
+
+	sink->count = 0;
+	sink->errors = 0;
+	sink->warnings = 0;
+	sink->dropped = 0;
+	sink->lastStored = false;
+}
+
+void FREE_DIAGNOSTIC_SINK(struct DiagnosticSink *sink) {
+	if (sink == NULL) {
+		return;
+	}
+
+	if (sink->entries != NULL) {
+		(void)free(sink->entries);
+		sink->entries = NULL;
+	}
+
+	(void)free(sink);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////     RENDERER     ///////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////
+
+void DG_render_text(struct DiagnosticRenderer *renderer, struct Diagnostic *diagnostic, struct LineIndex *lineIndex, const char *source);
+void DG_render_json(struct DiagnosticRenderer *renderer, struct Diagnostic *diagnostic, struct LineIndex *lineIndex);
+void DG_render_sarif(struct DiagnosticRenderer *renderer, struct Diagnostic *diagnostic, struct LineIndex *lineIndex);
+int DG_has_location(struct Diagnostic *diagnostic, struct LineIndex *lineIndex);
+char *DG_get_severity_string(enum DiagnosticSeverity severity);
+void DG_flush(struct DiagnosticRenderer *renderer);
+
+/**
+ * <p>
+ * Creates a renderer, that writes into the given stream.
+ * </p>
+ *
+ * <p>
+ * Text output is colored, if the stream is a terminal.
+ * </p>
+ *
+ * @returns A pointer to the renderer or NULL if it couldn't be allocated
+ *
+ * @param format    Output format
+ * @param *output   Stream to write to
+ */
+struct DiagnosticRenderer *CreateNewDiagnosticRenderer(enum DiagnosticFormat format, FILE *output) {
+	struct DiagnosticRenderer *renderer = (struct DiagnosticRenderer*)calloc(1, sizeof(struct DiagnosticRenderer));
+
+	if (renderer == NULL) {
+		(void)printf("ERROR on reserving diagnostics renderer!\n");
+		return NULL;
+	}
+
+	renderer->format = format;
+	renderer->output = output;
+	renderer->buffer = CreateNewJsonBuffer(4096);
+	renderer->colors = format == FORMAT_TEXT && isatty(fileno(output)) ? true : false;
+
+	if (format == FORMAT_JSON) {
+		(void)JSON_append_format(renderer->buffer, "{\"version\":1,\"diagnostics\":[");
+	} else if (format == FORMAT_SARIF) {
+		(void)JSON_append_format(renderer->buffer, "{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"version\":\"2.1.0\","
+			"\"runs\":[{\"tool\":{\"driver\":{\"name\":\"space\",\"version\":\"0.0.1\"}},\"results\":[");
+	}
+
+	return renderer;
+}
+
+/**
+ * <p>
+ * Converts a format name ("text", "json" or "sarif") into the format.
+ * </p>
+ *
+ * @returns True if the name is valid, else false
+ *
+ * @param *name     Name of the format
+ * @param *format   Receives the format
+ */
+int DG_parse_format(const char *name, enum DiagnosticFormat *format) {
+	if (strcmp(name, "text") == 0) {
+		*format = FORMAT_TEXT;
+	} else if (strcmp(name, "json") == 0) {
+		*format = FORMAT_JSON;
+	} else if (strcmp(name, "sarif") == 0) {
+		*format = FORMAT_SARIF;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Renders all diagnostics of the sink.
+ * </p>
+ *
+ * <p>
+ * The line index and the source have to belong to the file of the
+ * diagnostics, so the sink should be rendered (and cleared) before
+ * the next file is compiled.
+ * </p>
+ *
+ * @param *renderer     Renderer to use
+ * @param *sink         Diagnostics to render
+ * @param *lineIndex    Line index of the source (can be NULL)
+ * @param *source       Source of the file (can be NULL)
+ */
+void DG_render(struct DiagnosticRenderer *renderer, struct DiagnosticSink *sink, struct LineIndex *lineIndex, const char *source) {
+	if (renderer == NULL || sink == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < sink->count; i++) {
+		struct Diagnostic *diagnostic = &sink->entries[i];
+
+		switch (renderer->format) {
+		case FORMAT_TEXT:
+			(void)DG_render_text(renderer, diagnostic, lineIndex, source);
+			break;
+		case FORMAT_JSON:
+			(void)DG_render_json(renderer, diagnostic, lineIndex);
+			break;
+		case FORMAT_SARIF:
+			(void)DG_render_sarif(renderer, diagnostic, lineIndex);
+			break;
+		}
+
+		renderer->results++;
+	}
+
+	renderer->errors += sink->errors;
+	renderer->warnings += sink->warnings;
+	renderer->dropped += sink->dropped;
+
+	if (renderer->format == FORMAT_TEXT) {
+		if (sink->dropped > 0) {
+			(void)JSON_append_format(renderer->buffer, "... %lu more diagnostic(s) were not shown.\n\n", (unsigned long)sink->dropped);
+		}
+
+		(void)DG_flush(renderer);
+	}
+}
+
+int DG_has_location(struct Diagnostic *diagnostic, struct LineIndex *lineIndex) {
+	return lineIndex != NULL && diagnostic->position != DIAGNOSTIC_NO_POSITION
+		&& diagnostic->position <= lineIndex->length ? true : false;
+}
+
+char *DG_get_severity_string(enum DiagnosticSeverity severity) {
+	switch (severity) {
+	case SEVERITY_ERROR:
+		return "error";
+	case SEVERITY_WARNING:
+		return "warning";
+	default:
+		return "note";
+	}
+}
+
+/**
+ * <p>
+ * Renders a diagnostic as text with the affected source line:
+ * </p>
+ *
+ * <pre>
+ * error[SP0301]: Unexpected token ";"
+ *   --> prgm.txt:1:9
+ *  1 | var a = ;
+ *    |         ^
+ * </pre>
+ */
+void DG_render_text(struct DiagnosticRenderer *renderer, struct Diagnostic *diagnostic, struct LineIndex *lineIndex, const char *source) {
+	struct JsonBuffer *out = renderer->buffer;
+	char *color = diagnostic->severity == SEVERITY_ERROR ? TEXT_COLOR_RED
+		: diagnostic->severity == SEVERITY_WARNING ? TEXT_COLOR_YELLOW : TEXT_COLOR_BLUE;
+
+	(void)JSON_append_format(out, "%s%s[SP%04d]%s: %s\n", renderer->colors == true ? color : "",
+		DG_get_severity_string(diagnostic->severity), (int)diagnostic->code,
+		renderer->colors == true ? TEXT_COLOR_RESET : "", diagnostic->message);
+
+	if (DG_has_location(diagnostic, lineIndex) == false) {
+		(void)JSON_append_format(out, "  --> %s\n", diagnostic->file != NULL ? diagnostic->file : "<unknown>");
+	} else {
+		struct SourceLocation location = LI_locate(lineIndex, diagnostic->position);
+		size_t lineEnd = location.lineEnd;
+
+		if (source != NULL && lineEnd > location.lineStart && source[lineEnd - 1] == '\r') {
+			lineEnd--;
+		}
+
+		char lineNumber[32];
+		int gutter = (int)snprintf(lineNumber, sizeof(lineNumber), "%lu", (unsigned long)(location.line + 1));
+		(void)JSON_append_format(out, "%*s--> %s:%lu:%lu\n", gutter + 1, "", diagnostic->file != NULL ? diagnostic->file : "<unknown>",
+			(unsigned long)(location.line + 1), (unsigned long)(location.column + 1));
+
+		if (source != NULL) {
+			(void)JSON_append_format(out, " %s | ", lineNumber);
+			(void)JSON_append_raw(out, source + location.lineStart, lineEnd - location.lineStart);
+			(void)JSON_append_format(out, "\n %*s | ", gutter, "");
+
+			//Keep tabs, so that the marker lines up with the source
+			for (size_t i = location.lineStart; i < diagnostic->position && i < lineEnd; i++) {
+				(void)JSON_append_raw(out, source[i] == '\t' ? "\t" : " ", 1);
+			}
+
+			size_t markerLength = diagnostic->length == 0 ? 1 : diagnostic->length;
+
+			if (diagnostic->position + markerLength > lineEnd) {
+				markerLength = diagnostic->position < lineEnd ? lineEnd - diagnostic->position : 1;
+			}
+
+			(void)JSON_append_format(out, "%s", renderer->colors == true ? color : "");
+
+			for (size_t i = 0; i < markerLength; i++) {
+				(void)JSON_append_raw(out, "^", 1);
+			}
+
+			(void)JSON_append_format(out, "%s\n", renderer->colors == true ? TEXT_COLOR_RESET : "");
+		}
+	}
+
+	if (diagnostic->explanation[0] != '\0') {
+		(void)JSON_append_format(out, "    = explanation: %s\n", diagnostic->explanation);
+	}
+
+	if (diagnostic->suggestion[0] != '\0') {
+		(void)JSON_append_format(out, "    = suggestion: %s\n", diagnostic->suggestion);
+	}
+
+	(void)JSON_append_raw(out, "\n", 1);
+}
+
+void DG_render_json(struct DiagnosticRenderer *renderer, struct Diagnostic *diagnostic, struct LineIndex *lineIndex) {
+	struct JsonBuffer *out = renderer->buffer;
+
+	(void)JSON_append_format(out, "%s{\"code\":\"SP%04d\",\"severity\":\"%s\",\"file\":", renderer->results == 0 ? "" : ",",
+		(int)diagnostic->code, DG_get_severity_string(diagnostic->severity));
+	(void)JSON_append_string(out, diagnostic->file);
+
+	if (DG_has_location(diagnostic, lineIndex) == true) {
+		struct SourceLocation start = LI_locate(lineIndex, diagnostic->position);
+		struct SourceLocation end = LI_locate(lineIndex, diagnostic->position + diagnostic->length);
+		(void)JSON_append_format(out, ",\"offset\":%lu,\"length\":%lu,\"line\":%lu,\"column\":%lu,\"endLine\":%lu,\"endColumn\":%lu",
+			(unsigned long)diagnostic->position, (unsigned long)diagnostic->length,
+			(unsigned long)(start.line + 1), (unsigned long)(start.column + 1),
+			(unsigned long)(end.line + 1), (unsigned long)(end.column + 1));
+	}
+
+	(void)JSON_append_format(out, ",\"message\":");
+	(void)JSON_append_string(out, diagnostic->message);
+
+	if (diagnostic->explanation[0] != '\0') {
+		(void)JSON_append_format(out, ",\"explanation\":");
+		(void)JSON_append_string(out, diagnostic->explanation);
+	}
+
+	if (diagnostic->suggestion[0] != '\0') {
+		(void)JSON_append_format(out, ",\"suggestion\":");
+		(void)JSON_append_string(out, diagnostic->suggestion);
+	}
+
+	(void)JSON_append_raw(out, "}", 1);
+}
+
+/**
+ * <p>
+ * Renders a diagnostic as SARIF 2.1.0 result (lines and columns are 1-based).
+ * </p>
+ */
+void DG_render_sarif(struct DiagnosticRenderer *renderer, struct Diagnostic *diagnostic, struct LineIndex *lineIndex) {
+	struct JsonBuffer *out = renderer->buffer;
+
+	(void)JSON_append_format(out, "%s{\"ruleId\":\"SP%04d\",\"level\":\"%s\",\"message\":{\"text\":", renderer->results == 0 ? "" : ",",
+		(int)diagnostic->code, DG_get_severity_string(diagnostic->severity));
+	(void)JSON_append_string(out, diagnostic->message);
+	(void)JSON_append_format(out, "},\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":");
+	(void)JSON_append_string(out, diagnostic->file);
+	(void)JSON_append_raw(out, "}", 1);
+
+	if (DG_has_location(diagnostic, lineIndex) == true) {
+		struct SourceLocation start = LI_locate(lineIndex, diagnostic->position);
+		struct SourceLocation end = LI_locate(lineIndex, diagnostic->position + diagnostic->length);
+		(void)JSON_append_format(out, ",\"region\":{\"charOffset\":%lu,\"charLength\":%lu,\"startLine\":%lu,\"startColumn\":%lu,\"endLine\":%lu,\"endColumn\":%lu}",
+			(unsigned long)diagnostic->position, (unsigned long)diagnostic->length,
+			(unsigned long)(start.line + 1), (unsigned long)(start.column + 1),
+			(unsigned long)(end.line + 1), (unsigned long)(end.column + 1));
+	}
+
+	(void)JSON_append_format(out, "}}]");
+
+	if (diagnostic->suggestion[0] != '\0' || diagnostic->explanation[0] != '\0') {
+		(void)JSON_append_format(out, ",\"properties\":{\"explanation\":");
+		(void)JSON_append_string(out, diagnostic->explanation);
+		(void)JSON_append_format(out, ",\"suggestion\":");
+		(void)JSON_append_string(out, diagnostic->suggestion);
+		(void)JSON_append_raw(out, "}", 1);
+	}
+
+	(void)JSON_append_raw(out, "}", 1);
+}
+
+void DG_flush(struct DiagnosticRenderer *renderer) {
+	if (renderer->buffer->length == 0) {
+		return;
+	}
+
+	(void)fwrite(renderer->buffer->data, sizeof(char), renderer->buffer->length, renderer->output);
+	(void)fflush(renderer->output);
+	(void)JSON_clear_buffer(renderer->buffer);
+}
+
+/**
+ * <p>
+ * Closes the JSON / SARIF document and writes all remaining output.
+ * </p>
+ *
+ * @param *renderer     Renderer to finish
+ */
+void DG_finish_rendering(struct DiagnosticRenderer *renderer) {
+	if (renderer == NULL) {
+		return;
+	}
+
+	if (renderer->format == FORMAT_JSON) {
+		(void)JSON_append_format(renderer->buffer, "],\"errors\":%lu,\"warnings\":%lu,\"dropped\":%lu}\n",
+			(unsigned long)renderer->errors, (unsigned long)renderer->warnings, (unsigned long)renderer->dropped);
+	} else if (renderer->format == FORMAT_SARIF) {
+		(void)JSON_append_format(renderer->buffer, "]}]}\n");
+	}
+
+	(void)DG_flush(renderer);
+}
+
+void FREE_DIAGNOSTIC_RENDERER(struct DiagnosticRenderer *renderer) {
+	if (renderer == NULL) {
+		return;
+	}
+
+	(void)JSON_free_buffer(renderer->buffer);
+	(void)free(renderer);
+}
@@ -26,6 +26,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "../../headers/hashmap.h"
 #include "../../headers/modules.h"
 #include "../../headers/errors.h"
+#include "../../headers/stats.h"
 
 /** 
  * The subprogram {@code SPACE/src/hashmap.c} was created
@@ -102,6 +103,7 @@ struct HashMap *CreateNewHashMap(int initCapacity) {
 		exit(0);
 	}
 
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, sizeof(struct HashMap) + primeCap * sizeof(struct HashMapEntry));
 	return map;
 }
 
@@ -138,7 +140,7 @@ void HM_print_map(struct HashMap *map, int withList) {
 
 		while (temp != NULL) {
 			if ((int)strlen(linksString) == 0) {
-				(void)strncpy(linksString, key, 256);
+				(void)strncpy(linksString, key, sizeof(linksString) - 1);
 			}
 
 			int size = sizeof(linksString) - strlen(linksString) - 1;
@@ -242,6 +244,7 @@ void HM_add_entry_to_linked_list(struct HashMapEntry *entry, struct HashMap *map
 
 		temp->linkedEntry = entry;
 		map->collissions++;
+		(void)ST_count(COUNTER_HASHMAP_COLLISIONS, 1);
 	}
 }
 
@@ -268,6 +271,7 @@ struct HashMapEntry *HM_create_new_entry(char *key, void *value) {
 
 	entry->key = key;
 	entry->value = value;
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, sizeof(struct HashMapEntry));
 	return entry;
 }
 
@@ -306,6 +310,7 @@ struct HashMapEntry *HM_get_entry(char *key, struct HashMap *map) {
 		return NULL;
 	}
 	
+	(void)ST_count(COUNTER_HASHMAP_LOOKUPS, 1);
 	int hashPos = (int)HM_get_position_based_on_hash(key, map->capacity);
 	struct HashMapEntry *temp = map->entries[hashPos];
 	
@@ -358,12 +363,17 @@ int HM_contains_key(char *key, struct HashMap *map) {
  */
 void HM_remove_entry(struct HashMapEntry *entry, struct HashMap *map) {
 	int hashPos = (int)HM_get_position_based_on_hash(entry->key, map->capacity);
-	struct HashMapEntry *prevEntry = map->entries[hashPos];
+	struct HashMapEntry *prevEntry = NULL;
 	struct HashMapEntry *temp = map->entries[hashPos];
 
 	while (temp != NULL) {
 		if ((int)strcmp(temp->key, entry->key) == 0) {
-			prevEntry->linkedEntry = temp->linkedEntry;
+			if (prevEntry == NULL) {
+				map->entries[hashPos] = temp->linkedEntry;
+			} else {
+				prevEntry->linkedEntry = temp->linkedEntry;
+			}
+
 			(void)HM_free_entry(temp, false);
 			map->load--;
 			break;
@@ -401,6 +411,8 @@ void HM_resize_hashmap(struct HashMap *map, int newCapacity) {
 	
 	map->collissions = 0;
 	map->resizes++;
+	(void)ST_count(COUNTER_HASHMAP_RESIZES, 1);
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, newCapacity * sizeof(struct HashMapEntry));
 	map->capacity = newCapacity;
 
 	//Re-init old entries
@@ -0,0 +1,678 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "../../headers/json.h"
+#include "../../headers/errors.h"
+
+/**
+ * The subprogram {@code SPACE/src/Utils/json.c} was created
+ * to provide a minimal JSON reader and writer for the machine
+ * readable interfaces of the compiler (language server, reports).
+ *
+ * The reader builds a small DOM out of {@code JsonValue}s, the
+ * writer appends escaped JSON text into a {@code JsonBuffer}.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * Maximum nesting depth the parser accepts, deeper documents are
+ * rejected instead of exhausting the stack.
+ * </p>
+ */
+#define JSON_MAX_DEPTH 128
+
+struct JsonCursor {
+	const char *text;
+	size_t length;
+	size_t position;
+	int depth;
+};
+
+struct JsonValue *JSON_parse_value(struct JsonCursor *cursor);
+struct JsonValue *JSON_parse_object(struct JsonCursor *cursor);
+struct JsonValue *JSON_parse_array(struct JsonCursor *cursor);
+char *JSON_parse_string(struct JsonCursor *cursor);
+struct JsonValue *JSON_parse_number(struct JsonCursor *cursor);
+int JSON_parse_literal(struct JsonCursor *cursor, const char *literal);
+void JSON_skip_whitespaces(struct JsonCursor *cursor);
+int JSON_add_child(struct JsonValue *parent, char *key, struct JsonValue *child);
+struct JsonValue *JSON_create_value(enum JsonType type);
+void JSON_ensure_capacity(struct JsonBuffer *buffer, size_t additional);
+int JSON_append_utf8(char *out, size_t *outLength, unsigned int codePoint);
+int JSON_read_hex4(struct JsonCursor *cursor, unsigned int *result);
+
+/**
+ * <p>
+ * Parses the provided text into a JSON DOM.
+ * </p>
+ *
+ * @returns
+ * <ul>
+ * <li>The parsed root value
+ * <li>NULL - If the text is not valid JSON
+ * </ul>
+ *
+ * @param *text     Text to parse
+ * @param length    Length of the text
+ */
+struct JsonValue *JSON_parse(const char *text, size_t length) {
+	if (text == NULL) {
+		return NULL;
+	}
+
+	struct JsonCursor cursor = {text, length, 0, 0};
+	struct JsonValue *value = JSON_parse_value(&cursor);
+	(void)JSON_skip_whitespaces(&cursor);
+
+	if (value != NULL && cursor.position != cursor.length) {
+		(void)JSON_free_value(value);
+		return NULL;
+	}
+
+	return value;
+}
+
+struct JsonValue *JSON_parse_value(struct JsonCursor *cursor) {
+	(void)JSON_skip_whitespaces(cursor);
+
+	if (cursor->position >= cursor->length || cursor->depth > JSON_MAX_DEPTH) {
+		return NULL;
+	}
+
+	char current = cursor->text[cursor->position];
+
+	switch (current) {
+	case '{':
+		return JSON_parse_object(cursor);
+	case '[':
+		return JSON_parse_array(cursor);
+	case '"': {
+		char *string = JSON_parse_string(cursor);
+
+		if (string == NULL) {
+			return NULL;
+		}
+
+		struct JsonValue *value = JSON_create_value(JSON_STRING);
+		value->string = string;
+		return value;
+	}
+	case 't':
+	case 'f': {
+		int isTrue = current == 't';
+
+		if ((int)JSON_parse_literal(cursor, isTrue ? "true" : "false") == false) {
+			return NULL;
+		}
+
+		struct JsonValue *value = JSON_create_value(JSON_BOOLEAN);
+		value->boolean = isTrue;
+		return value;
+	}
+	case 'n':
+		if ((int)JSON_parse_literal(cursor, "null") == false) {
+			return NULL;
+		}
+
+		return JSON_create_value(JSON_NULL);
+	default:
+		return JSON_parse_number(cursor);
+	}
+}
+
+struct JsonValue *JSON_parse_object(struct JsonCursor *cursor) {
+	struct JsonValue *object = JSON_create_value(JSON_OBJECT);
+	cursor->position++;
+	cursor->depth++;
+	(void)JSON_skip_whitespaces(cursor);
+
+	if (cursor->position < cursor->length && cursor->text[cursor->position] == '}') {
+		cursor->position++;
+		cursor->depth--;
+		return object;
+	}
+
+	while (cursor->position < cursor->length) {
+		(void)JSON_skip_whitespaces(cursor);
+
+		if (cursor->position >= cursor->length || cursor->text[cursor->position] != '"') {
+			break;
+		}
+
+		char *key = JSON_parse_string(cursor);
+		(void)JSON_skip_whitespaces(cursor);
+
+		if (key == NULL || cursor->position >= cursor->length
+			|| cursor->text[cursor->position] != ':') {
+			(void)free(key);
+			break;
+		}
+
+		cursor->position++;
+		struct JsonValue *child = JSON_parse_value(cursor);
+
+		if (child == NULL || (int)JSON_add_child(object, key, child) == false) {
+			(void)free(key);
+			(void)JSON_free_value(child);
+			break;
+		}
+
+		(void)JSON_skip_whitespaces(cursor);
+
+		if (cursor->position >= cursor->length) {
+			break;
+		}
+
+		char separator = cursor->text[cursor->position++];
+
+		if (separator == '}') {
+			cursor->depth--;
+			return object;
+		} else if (separator != ',') {
+			break;
+		}
+	}
+
+	(void)JSON_free_value(object);
+	return NULL;
+}
+
+struct JsonValue *JSON_parse_array(struct JsonCursor *cursor) {
+	struct JsonValue *array = JSON_create_value(JSON_ARRAY);
+	cursor->position++;
+	cursor->depth++;
+	(void)JSON_skip_whitespaces(cursor);
+
+	if (cursor->position < cursor->length && cursor->text[cursor->position] == ']') {
+		cursor->position++;
+		cursor->depth--;
+		return array;
+	}
+
+	while (cursor->position < cursor->length) {
+		struct JsonValue *child = JSON_parse_value(cursor);
+
+		if (child == NULL || (int)JSON_add_child(array, NULL, child) == false) {
+			(void)JSON_free_value(child);
+			break;
+		}
+
+		(void)JSON_skip_whitespaces(cursor);
+
+		if (cursor->position >= cursor->length) {
+			break;
+		}
+
+		char separator = cursor->text[cursor->position++];
+
+		if (separator == ']') {
+			cursor->depth--;
+			return array;
+		} else if (separator != ',') {
+			break;
+		}
+	}
+
+	(void)JSON_free_value(array);
+	return NULL;
+}
+
+/**
+ * <p>
+ * Parses a quoted string at the cursor and resolves all escape
+ * sequences (including `\uXXXX` surrogate pairs) into UTF-8.
+ * </p>
+ *
+ * @returns The unescaped string (heap) or NULL on error
+ *
+ * @param *cursor   Cursor pointing to the opening quote
+ */
+char *JSON_parse_string(struct JsonCursor *cursor) {
+	size_t start = ++cursor->position;
+	size_t end = start;
+
+	while (end < cursor->length && cursor->text[end] != '"') {
+		end += cursor->text[end] == '\\' ? 2 : 1;
+	}
+
+	if (end >= cursor->length) {
+		return NULL;
+	}
+
+	//Unescaped output is never longer than the escaped input
+	char *string = (char*)calloc(end - start + 1, sizeof(char));
+	size_t outLength = 0;
+
+	if (string == NULL) {
+		return NULL;
+	}
+
+	while (cursor->position < end) {
+		char current = cursor->text[cursor->position++];
+
+		if (current != '\\') {
+			string[outLength++] = current;
+			continue;
+		}
+
+		char escaped = cursor->text[cursor->position++];
+
+		switch (escaped) {
+		case 'b': string[outLength++] = '\b'; break;
+		case 'f': string[outLength++] = '\f'; break;
+		case 'n': string[outLength++] = '\n'; break;
+		case 'r': string[outLength++] = '\r'; break;
+		case 't': string[outLength++] = '\t'; break;
+		case 'u': {
+			unsigned int codePoint = 0;
+
+			if ((int)JSON_read_hex4(cursor, &codePoint) == false) {
+				(void)free(string);
+				return NULL;
+			}
+
+			if (codePoint >= 0xD800 && codePoint <= 0xDBFF
+				&& cursor->position + 1 < end
+				&& cursor->text[cursor->position] == '\\'
+				&& cursor->text[cursor->position + 1] == 'u') {
+				unsigned int lowSurrogate = 0;
+				cursor->position += 2;
+
+				if ((int)JSON_read_hex4(cursor, &lowSurrogate) == false) {
+					(void)free(string);
+					return NULL;
+				}
+
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+			}
+
+			(void)JSON_append_utf8(string, &outLength, codePoint);
+			break;
+		}
+		default:
+			string[outLength++] = escaped;
+			break;
+		}
+	}
+
+	cursor->position = end + 1;
+	string[outLength] = '\0';
+	return string;
+}
+
+int JSON_read_hex4(struct JsonCursor *cursor, unsigned int *result) {
+	if (cursor->position + 4 > cursor->length) {
+		return false;
+	}
+
+	unsigned int value = 0;
+
+	for (int i = 0; i < 4; i++) {
+		char digit = cursor->text[cursor->position++];
+		value <<= 4;
+
+		if (digit >= '0' && digit <= '9') {
+			value |= (unsigned int)(digit - '0');
+		} else if (digit >= 'a' && digit <= 'f') {
+			value |= (unsigned int)(digit - 'a' + 10);
+		} else if (digit >= 'A' && digit <= 'F') {
+			value |= (unsigned int)(digit - 'A' + 10);
+		} else {
+			return false;
+		}
+	}
+
+	*result = value;
+	return true;
+}
+
+/**
+ * <p>
+ * Writes the UTF-8 encoding of a code point into out. Since a
+ * `\uXXXX` sequence has 6 characters (12 for a surrogate pair)
+ * the encoding always fits into the space of the escape.
+ * </p>
+ */
+int JSON_append_utf8(char *out, size_t *outLength, unsigned int codePoint) {
+	if (codePoint < 0x80) {
+		out[(*outLength)++] = (char)codePoint;
+	} else if (codePoint < 0x800) {
+		out[(*outLength)++] = (char)(0xC0 | (codePoint >> 6));
+		out[(*outLength)++] = (char)(0x80 | (codePoint & 0x3F));
+	} else if (codePoint < 0x10000) {
+		out[(*outLength)++] = (char)(0xE0 | (codePoint >> 12));
+		out[(*outLength)++] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+		out[(*outLength)++] = (char)(0x80 | (codePoint & 0x3F));
+	} else {
+		out[(*outLength)++] = (char)(0xF0 | (codePoint >> 18));
+		out[(*outLength)++] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+		out[(*outLength)++] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+		out[(*outLength)++] = (char)(0x80 | (codePoint & 0x3F));
+	}
+
+	return true;
+}
+
+struct JsonValue *JSON_parse_number(struct JsonCursor *cursor) {
+	const char *start = cursor->text + cursor->position;
+	char *end = NULL;
+	double number = strtod(start, &end);
+
+	if (end == start || (size_t)(end - cursor->text) > cursor->length) {
+		return NULL;
+	}
+
+	cursor->position += (size_t)(end - start);
+	struct JsonValue *value = JSON_create_value(JSON_NUMBER);
+	value->number = number;
+	return value;
+}
+
+int JSON_parse_literal(struct JsonCursor *cursor, const char *literal) {
+	size_t literalLength = strlen(literal);
+
+	if (cursor->position + literalLength > cursor->length
+		|| strncmp(cursor->text + cursor->position, literal, literalLength) != 0) {
+		return false;
+	}
+
+	cursor->position += literalLength;
+	return true;
+}
+
+void JSON_skip_whitespaces(struct JsonCursor *cursor) {
+	while (cursor->position < cursor->length) {
+		char current = cursor->text[cursor->position];
+
+		if (current != ' ' && current != '\t' && current != '\n' && current != '\r') {
+			break;
+		}
+
+		cursor->position++;
+	}
+}
+
+int JSON_add_child(struct JsonValue *parent, char *key, struct JsonValue *child) {
+	struct JsonValue **items = (struct JsonValue**)realloc(parent->items, sizeof(struct JsonValue*) * (parent->count + 1));
+
+	if (items == NULL) {
+		return false;
+	}
+
+	parent->items = items;
+
+	if (parent->type == JSON_OBJECT) {
+		char **keys = (char**)realloc(parent->keys, sizeof(char*) * (parent->count + 1));
+
+		if (keys == NULL) {
+			return false;
+		}
+
+		parent->keys = keys;
+		parent->keys[parent->count] = key;
+	}
+
+	parent->items[parent->count++] = child;
+	return true;
+}
+
+struct JsonValue *JSON_create_value(enum JsonType type) {
+	struct JsonValue *value = (struct JsonValue*)calloc(1, sizeof(struct JsonValue));
+
+	if (value == NULL) {
+		(void)printf("Couldn't allocate space for JSON value!\n");
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	value->type = type;
+	return value;
+}
+
+/**
+ * <p>
+ * Returns the member of an object with the given name.
+ * </p>
+ *
+ * @returns The member or NULL, if the object is not an object or has no such member
+ *
+ * @param *object   Object to search in
+ * @param *key      Name of the member
+ */
+struct JsonValue *JSON_get_member(struct JsonValue *object, const char *key) {
+	if (object == NULL || object->type != JSON_OBJECT) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < object->count; i++) {
+		if ((int)strcmp(object->keys[i], key) == 0) {
+			return object->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+char *JSON_get_string(struct JsonValue *object, const char *key) {
+	struct JsonValue *member = JSON_get_member(object, key);
+	return member != NULL && member->type == JSON_STRING ? member->string : NULL;
+}
+
+double JSON_get_number(struct JsonValue *object, const char *key, double fallback) {
+	struct JsonValue *member = JSON_get_member(object, key);
+	return member != NULL && member->type == JSON_NUMBER ? member->number : fallback;
+}
+
+void JSON_free_value(struct JsonValue *value) {
+	if (value == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < value->count; i++) {
+		(void)JSON_free_value(value->items[i]);
+
+		if (value->keys != NULL) {
+			(void)free(value->keys[i]);
+		}
+	}
+
+	(void)free(value->items);
+	(void)free(value->keys);
+	(void)free(value->string);
+	(void)free(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////     WRITER     ///////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////
+
+struct JsonBuffer *CreateNewJsonBuffer(size_t initialCapacity) {
+	initialCapacity = initialCapacity < 64 ? 64 : initialCapacity;
+	struct JsonBuffer *buffer = (struct JsonBuffer*)calloc(1, sizeof(struct JsonBuffer));
+
+	if (buffer == NULL) {
+		(void)printf("ERROR on reserving JSON buffer!\n");
+		return NULL;
+	}
+
+	buffer->data = (char*)calloc(initialCapacity, sizeof(char));
+	buffer->capacity = initialCapacity;
+	buffer->length = 0;
+	return buffer;
+}
+
+void JSON_ensure_capacity(struct JsonBuffer *buffer, size_t additional) {
+	if (buffer->length + additional + 1 <= buffer->capacity) {
+		return;
+	}
+
+	size_t newCapacity = buffer->capacity * 2;
+
+	while (newCapacity < buffer->length + additional + 1) {
+		newCapacity *= 2;
+	}
+
+	char *data = (char*)realloc(buffer->data, newCapacity);
+
+	if (data == NULL) {
+		(void)printf("ERROR on resizing JSON buffer!\n");
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+	}
+
+	buffer->data = data;
+	buffer->capacity = newCapacity;
+}
+
+void JSON_append_raw(struct JsonBuffer *buffer, const char *text, size_t length) {
+	(void)JSON_ensure_capacity(buffer, length);
+	(void)memcpy(buffer->data + buffer->length, text, length);
+	buffer->length += length;
+	buffer->data[buffer->length] = '\0';
+}
+
+void JSON_append_format(struct JsonBuffer *buffer, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	va_list copy;
+	va_copy(copy, args);
+	int required = vsnprintf(NULL, 0, format, copy);
+	va_end(copy);
+
+	if (required > 0) {
+		(void)JSON_ensure_capacity(buffer, (size_t)required);
+		(void)vsnprintf(buffer->data + buffer->length, (size_t)required + 1, format, args);
+		buffer->length += (size_t)required;
+	}
+
+	va_end(args);
+}
+
+/**
+ * <p>
+ * Appends the text as a quoted and escaped JSON string.
+ * NULL is written as `null`.
+ * </p>
+ *
+ * @param *buffer   Buffer to write into
+ * @param *text     Text to escape
+ */
+void JSON_append_string(struct JsonBuffer *buffer, const char *text) {
+	if (text == NULL) {
+		(void)JSON_append_raw(buffer, "null", 4);
+		return;
+	}
+
+	(void)JSON_append_raw(buffer, "\"", 1);
+	size_t runStart = 0;
+	size_t i = 0;
+
+	for (; text[i] != '\0'; i++) {
+		unsigned char current = (unsigned char)text[i];
+
+		if (current != '"' && current != '\\' && current >= 0x20) {
+			continue;
+		}
+
+		(void)JSON_append_raw(buffer, text + runStart, i - runStart);
+		runStart = i + 1;
+
+		switch (current) {
+		case '"': (void)JSON_append_raw(buffer, "\\\"", 2); break;
+		case '\\': (void)JSON_append_raw(buffer, "\\\\", 2); break;
+		case '\n': (void)JSON_append_raw(buffer, "\\n", 2); break;
+		case '\r': (void)JSON_append_raw(buffer, "\\r", 2); break;
+		case '\t': (void)JSON_append_raw(buffer, "\\t", 2); break;
+		default: (void)JSON_append_format(buffer, "\\u%04x", current); break;
+		}
+	}
+
+	(void)JSON_append_raw(buffer, text + runStart, i - runStart);
+	(void)JSON_append_raw(buffer, "\"", 1);
+}
+
+/**
+ * <p>
+ * Serializes a parsed value back into JSON text.
+ * </p>
+ */
+void JSON_append_value(struct JsonBuffer *buffer, struct JsonValue *value) {
+	if (value == NULL) {
+		(void)JSON_append_raw(buffer, "null", 4);
+		return;
+	}
+
+	switch (value->type) {
+	case JSON_NULL:
+		(void)JSON_append_raw(buffer, "null", 4);
+		break;
+	case JSON_BOOLEAN:
+		(void)JSON_append_format(buffer, "%s", value->boolean ? "true" : "false");
+		break;
+	case JSON_NUMBER:
+		(void)JSON_append_format(buffer, "%.17g", value->number);
+		break;
+	case JSON_STRING:
+		(void)JSON_append_string(buffer, value->string);
+		break;
+	case JSON_ARRAY:
+	case JSON_OBJECT:
+		(void)JSON_append_raw(buffer, value->type == JSON_ARRAY ? "[" : "{", 1);
+
+		for (size_t i = 0; i < value->count; i++) {
+			if (i > 0) {
+				(void)JSON_append_raw(buffer, ",", 1);
+			}
+
+			if (value->type == JSON_OBJECT) {
+				(void)JSON_append_string(buffer, value->keys[i]);
+				(void)JSON_append_raw(buffer, ":", 1);
+			}
+
+			(void)JSON_append_value(buffer, value->items[i]);
+		}
+
+		(void)JSON_append_raw(buffer, value->type == JSON_ARRAY ? "]" : "}", 1);
+		break;
+	}
+}
+
+void JSON_clear_buffer(struct JsonBuffer *buffer) {
+	buffer->length = 0;
+	buffer->data[0] = '\0';
+}
+
+void JSON_free_buffer(struct JsonBuffer *buffer) {
+	if (buffer == NULL) {
+		return;
+	}
+
+	(void)free(buffer->data);
+	(void)free(buffer);
+}
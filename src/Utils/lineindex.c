@@ -0,0 +1,178 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/lineindex.h"
+
+/**
+ * The subprogram {@code SPACE/src/Utils/lineindex.c} was created
+ * to map buffer offsets to lines and columns.
+ *
+ * The index stores the offset of every line start, so a lookup
+ * is a binary search instead of a rescan of the source.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+/**
+ * <p>
+ * Creates the line index of the provided buffer.
+ * </p>
+ *
+ * <p>
+ * If the buffer is NULL, the index only holds the first line and
+ * the remaining line starts have to be added with {@code LI_add_line_start()}.
+ * </p>
+ *
+ * @returns A pointer to the index or NULL if it couldn't be allocated
+ *
+ * @param *buffer   Source to index
+ * @param length    Length of the source
+ */
+struct LineIndex *CreateNewLineIndex(const char *buffer, size_t length) {
+	struct LineIndex *index = (struct LineIndex*)calloc(1, sizeof(struct LineIndex));
+
+	if (index == NULL) {
+		(void)printf("ERROR on reserving line index!\n");
+		return NULL;
+	}
+
+	//Without a buffer the lines are added later, so about one line per 32 characters is reserved
+	size_t lines = buffer == NULL ? length / 32 + 1 : 1;
+
+	for (size_t i = 0; buffer != NULL && i < length; i++) {
+		if (buffer[i] == '\n') {
+			lines++;
+		}
+	}
+
+	index->starts = (size_t*)calloc(lines, sizeof(size_t));
+
+	if (index->starts == NULL) {
+		(void)printf("ERROR on reserving line index!\n");
+		(void)free(index);
+		return NULL;
+	}
+
+	index->capacity = lines;
+	index->count = 1;
+	index->length = length;
+
+	for (size_t i = 0; buffer != NULL && i < length; i++) {
+		if (buffer[i] == '\n') {
+			index->starts[index->count++] = i + 1;
+		}
+	}
+
+	return index;
+}
+
+/**
+ * <p>
+ * Appends the start of the next line (the offset after a newline).
+ * </p>
+ *
+ * @param *index    Index to append to
+ * @param offset    Offset of the line start
+ */
+void LI_add_line_start(struct LineIndex *index, size_t offset) {
+	if (index->count >= index->capacity) {
+		size_t newCapacity = index->capacity * 2;
+		size_t *temp = (size_t*)realloc(index->starts, newCapacity * sizeof(size_t));
+
+		if (temp == NULL) {
+			(void)printf("ERROR on resizing line index!\n");
+			return;
+		}
+
+		index->starts = temp;
+		index->capacity = newCapacity;
+	}
+
+	index->starts[index->count++] = offset;
+}
+
+/**
+ * <p>
+ * Gets the 0-based line of an offset (binary search).
+ * </p>
+ *
+ * @returns The line of the offset
+ *
+ * @param *index    Index of the source
+ * @param offset    Offset in the source (offsets after the end map to the last line)
+ */
+size_t LI_get_line(struct LineIndex *index, size_t offset) {
+	size_t low = 0;
+	size_t high = index->count;
+
+	while (high - low > 1) {
+		size_t mid = low + (high - low) / 2;
+
+		if (index->starts[mid] <= offset) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+size_t LI_get_line_start(struct LineIndex *index, size_t line) {
+	return line < index->count ? index->starts[line] : index->length;
+}
+
+/**
+ * <p>
+ * Gets line, column and the line slice of an offset.
+ * </p>
+ *
+ * @returns The location of the offset
+ *
+ * @param *index    Index of the source
+ * @param offset    Offset in the source
+ */
+struct SourceLocation LI_locate(struct LineIndex *index, size_t offset) {
+	struct SourceLocation location;
+	offset = offset > index->length ? index->length : offset;
+	location.line = LI_get_line(index, offset);
+	location.lineStart = index->starts[location.line];
+	location.column = offset - location.lineStart;
+	location.lineEnd = location.line + 1 < index->count ? index->starts[location.line + 1] - 1 : index->length;
+	return location;
+}
+
+void FREE_LINE_INDEX(struct LineIndex *index) {
+	if (index == NULL) {
+		return;
+	}
+
+	if (index->starts != NULL) {
+		(void)free(index->starts);
+		index->starts = NULL;
+	}
+
+	(void)free(index);
+}
@@ -25,6 +25,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <string.h>
 #include "../../headers/list.h"
 #include "../../headers/modules.h"
+#include "../../headers/stats.h"
 
 /** 
  * The subprogram {@code SPACE/src/list.c} was created
@@ -67,6 +68,7 @@ struct List *CreateNewList(int initialCapacity) {
 	list->entries = (void**)calloc(initialCapacity, sizeof(void*));
 	list->size = initialCapacity;
 	list->load = 0;
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, sizeof(struct List) + initialCapacity * sizeof(void*));
 	return list;
 }
 
@@ -116,6 +118,7 @@ void L_resize_list(struct List *list) {
 	}
 
 	(void)memset(list->entries + list->size, 0, list->size);
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, (newSize - list->size) * sizeof(void*));
 	list->size = newSize;
 }
 
@@ -0,0 +1,226 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../headers/stats.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/**
+ * The subprogram {@code SPACE/src/Utils/stats.c} was created
+ * to measure the compiler phases (--stats / --time-report).
+ *
+ * Every phase records its monotonic wall time and its CPU time,
+ * the data structures count their work (tokens, nodes, hash map
+ * lookups etc.). The numbers of all compiled files are summed up
+ * and written as table or as JSON.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+_Thread_local struct CompilerStats STATS;
+
+const char *STATS_PHASE_NAMES[STATS_PHASES] = {
+	"input", "lexer", "syntax", "parsetree", "semantic", "ir", "optimize", "profile", "bytecode", "codegen", "run"
+};
+
+const char *STATS_COUNTER_NAMES[STATS_COUNTERS] = {
+	"files", "sourceBytes", "lines", "tokens", "nodes", "hashMapLookups",
+	"hashMapCollisions", "hashMapResizes", "scopeTables", "deadStatements", "provenIndices",
+	"scopedInstances", "savedPadding", "irInstructions", "jumpTables", "devirtualizedCalls", "inlinedCalls", "replacedObjects", "foldedConstants", "loopOptimizations", "movedBlocks", "vmInstructions", "jitFunctions", "deoptimizations", "collections", "asmInstructions", "spills", "bytesAllocated"
+};
+
+double ST_get_cpu_time();
+
+void ST_reset() {
+	(void)memset(&STATS, 0, sizeof(struct CompilerStats));
+}
+
+/**
+ * <p>
+ * Starts the time measurement of a phase.
+ * </p>
+ *
+ * @param phase     Phase to measure
+ */
+void ST_start_phase(enum StatsPhase phase) {
+	STATS.phases[phase].wallStart = ST_get_wall_time();
+	STATS.phases[phase].cpuStart = ST_get_cpu_time();
+}
+
+/**
+ * <p>
+ * Stops the time measurement of a phase and adds the
+ * elapsed time to the phase.
+ * </p>
+ *
+ * @param phase     Phase to stop
+ */
+void ST_end_phase(enum StatsPhase phase) {
+	struct PhaseTime *time = &STATS.phases[phase];
+	time->wallTime += ST_get_wall_time() - time->wallStart;
+	time->cpuTime += ST_get_cpu_time() - time->cpuStart;
+	time->runs++;
+}
+
+void ST_count(enum StatsCounter counter, size_t amount) {
+	STATS.counters[counter] += amount;
+}
+
+double ST_get_wall_time() {
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+double ST_get_cpu_time() {
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/**
+ * <p>
+ * Gets the peak resident set size of the process.
+ * </p>
+ *
+ * @returns The peak RSS in bytes (0 if it isn't available)
+ */
+size_t ST_get_peak_rss() {
+#ifdef _WIN32
+	return 0;
+#else
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+
+#ifdef __APPLE__
+	return (size_t)usage.ru_maxrss;
+#else
+	return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+/**
+ * <p>
+ * Converts a format name ("table" or "json") into the format.
+ * </p>
+ *
+ * @returns True if the name is valid, else false
+ *
+ * @param *name     Name of the format
+ * @param *format   Receives the format
+ */
+int ST_parse_format(const char *name, enum StatsFormat *format) {
+	if (strcmp(name, "table") == 0) {
+		*format = STATS_FORMAT_TABLE;
+	} else if (strcmp(name, "json") == 0) {
+		*format = STATS_FORMAT_JSON;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * <p>
+ * Writes the collected times (and counters) into the stream.
+ * </p>
+ *
+ * @param *output       Stream to write to
+ * @param format        Table or JSON
+ * @param withCounters  True if the counters should be written as well
+ */
+void ST_write_report(FILE *output, enum StatsFormat format, int withCounters) {
+	double totalWall = 0;
+	double totalCpu = 0;
+
+	for (int i = 0; i < STATS_PHASES; i++) {
+		totalWall += STATS.phases[i].wallTime;
+		totalCpu += STATS.phases[i].cpuTime;
+	}
+
+	if (format == STATS_FORMAT_JSON) {
+		(void)fprintf(output, "{\"phases\":{");
+
+		for (int i = 0; i < STATS_PHASES; i++) {
+			struct PhaseTime *time = &STATS.phases[i];
+			(void)fprintf(output, "%s\"%s\":{\"wallSeconds\":%.9f,\"cpuSeconds\":%.9f,\"runs\":%lu}", i == 0 ? "" : ",",
+				STATS_PHASE_NAMES[i], time->wallTime, time->cpuTime, (unsigned long)time->runs);
+		}
+
+		(void)fprintf(output, "},\"totalWallSeconds\":%.9f,\"totalCpuSeconds\":%.9f", totalWall, totalCpu);
+
+		if (withCounters == true) {
+			(void)fprintf(output, ",\"counters\":{");
+
+			for (int i = 0; i < STATS_COUNTERS; i++) {
+				(void)fprintf(output, "%s\"%s\":%lu", i == 0 ? "" : ",", STATS_COUNTER_NAMES[i], (unsigned long)STATS.counters[i]);
+			}
+
+			(void)fprintf(output, ",\"peakRssBytes\":%lu}", (unsigned long)ST_get_peak_rss());
+		}
+
+		(void)fprintf(output, "}\n");
+		return;
+	}
+
+	(void)fprintf(output, "\n%-12s|%14s|%14s|%8s|\n", "Phase", "Wall (ms)", "CPU (ms)", "Share");
+	(void)fprintf(output, "------------+--------------+--------------+--------+\n");
+
+	for (int i = 0; i < STATS_PHASES; i++) {
+		struct PhaseTime *time = &STATS.phases[i];
+		double share = totalWall > 0 ? time->wallTime / totalWall * 100 : 0;
+		(void)fprintf(output, "%-12s|%14.3f|%14.3f|%7.1f%%|\n", STATS_PHASE_NAMES[i], time->wallTime * 1000, time->cpuTime * 1000, share);
+	}
+
+	(void)fprintf(output, "------------+--------------+--------------+--------+\n");
+	(void)fprintf(output, "%-12s|%14.3f|%14.3f|%8s|\n", "total", totalWall * 1000, totalCpu * 1000, "");
+
+	if (withCounters == false) {
+		return;
+	}
+
+	(void)fprintf(output, "\n%-20s|%16s|\n", "Counter", "Value");
+	(void)fprintf(output, "--------------------+----------------+\n");
+
+	for (int i = 0; i < STATS_COUNTERS; i++) {
+		(void)fprintf(output, "%-20s|%16lu|\n", STATS_COUNTER_NAMES[i], (unsigned long)STATS.counters[i]);
+	}
+
+	(void)fprintf(output, "%-20s|%16lu|\n", "peakRssBytes", (unsigned long)ST_get_peak_rss());
+
+	if (totalWall > 0) {
+		(void)fprintf(output, "%-20s|%16.0f|\n", "tokensPerSecond", STATS.counters[COUNTER_TOKENS] / totalWall);
+	}
+}
@@ -0,0 +1,1095 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <setjmp.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/stats.h"
+#include "../../headers/ir.h"
+#include "../../headers/vm.h"
+
+/**
+ * The subprogram {@code SPACE/src/VM/bytecode.c} was created
+ * to translate the IR into the bytecode of the virtual machine.
+ *
+ * Every IR instruction becomes (at most) two register instructions,
+ * the opcode is chosen by the types of the operands, so the interpreter
+ * doesn't have to look at any type at runtime. Jumps into the following
+ * block are dropped, branches with a following target become conditional
+ * jumps. Large integers, floating values and strings are put into the
+ * constant pool of the function, the long string literals lie in one
+ * segment of the program. The blocks with a landing pad form the
+ * exception table of the function. The classes keep their fields and
+ * vtables, the references among the fields become the map, that the
+ * collections use for the instances.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+extern FILE *BYTECODE_DUMP;
+extern char *FILE_NAME;
+
+const char *VM_OPCODE_NAMES[VM_OPCODES] = {
+	"load_int", "load_const", "move", "load_global", "store_global",
+	"add_int", "sub_int", "mul_int", "div_int", "mod_int", "neg_int",
+	"add_int32", "sub_int32", "mul_int32",
+	"shl", "shr", "bit_and", "bit_or", "bit_xor", "not",
+	"add_double", "sub_double", "mul_double", "div_double", "mod_double", "neg_double",
+	"eq_int", "ne_int", "lt_int", "le_int", "gt_int", "ge_int",
+	"eq_double", "ne_double", "lt_double", "le_double", "gt_double", "ge_double",
+	"int_to_double", "double_to_int", "to_int", "to_short", "to_char", "to_float",
+	"concat", "builder", "append",
+	"new", "new_array",
+	"load_field", "load_field_i", "load_field_s", "load_field_c", "load_field_f",
+	"store_field", "store_field_i", "store_field_s", "store_field_c", "store_field_f", "store_ref",
+	"load_element", "load_elem_u", "store_element", "store_elem_u", "check_null",
+	"call", "call_virtual", "call_iface", "jump", "jump_if_true", "jump_if_false", "branch", "switch", "ret", "ret_void",
+	"resume", "count"
+};
+
+void VM_create_string_segment(struct VMProgram *program, struct IRModule *module);
+void VM_translate_class(struct IRClass *source, struct VMClass *vmClass);
+int VM_translate_function(struct VMProgram *program, struct IRFunction *source, struct VMFunction *function, int profiled);
+void VM_translate_instruction(struct VMProgram *program, struct IRFunction *source, struct VMFunction *function, struct IRInstruction *instruction, int nextBlock);
+void VM_emit_wrap(struct VMFunction *function, enum VarType type, int dest, size_t line);
+void VM_translate_conversion(struct VMFunction *function, enum VarType from, enum VarType to, int dest, int reg, size_t line);
+enum VMOpcode VM_get_field_opcode(struct VMField *field, enum VMOpcode base);
+void VM_patch_jump_targets(struct VMFunction *function, size_t *blockStarts);
+void VM_build_exception_table(struct IRFunction *source, struct VMFunction *function, size_t *blockStarts);
+void VM_emit(struct VMFunction *function, enum VMOpcode opcode, int dest, int a, int b, int c, size_t line);
+int VM_add_constant(struct VMFunction *function, union VMValue value, enum VarType type);
+int VM_is_floating_type(enum VarType type);
+void *VM_allocate(size_t count, size_t size);
+void VM_grow(void **array, size_t *capacity, size_t count, size_t size);
+void VM_dump_function(FILE *output, struct VMProgram *program, struct VMFunction *function);
+void VM_dump_instruction(FILE *output, struct VMProgram *program, struct VMFunction *function, size_t index);
+void VM_dump_class(FILE *output, struct VMProgram *program, struct VMClass *vmClass);
+void VM_dump_arguments(FILE *output, struct VMFunction *function, struct VMInstruction *instruction);
+void FREE_VM_FUNCTION(struct VMFunction *function);
+
+/**
+ * <p>
+ * This is the entrypoint of the bytecode generation.
+ * </p>
+ * 
+ * <p>
+ * The module has to be verified (see IR_verify_module), the program
+ * doesn't reference the module, so it can be freed afterwards.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the generation
+ * 
+ * @param *module   Verified IR of the program
+ * @param **program Receives the program (NULL if the translation failed)
+ */
+int GenerateBytecode(struct IRModule *module, struct VMProgram **program) {
+	return VM_generate_program(module, program, false);
+}
+
+/**
+ * <p>
+ * Translates a module into a program.
+ * </p>
+ * 
+ * <p>
+ * A profiled program starts every block with a {@code count}
+ * instruction, that counts the executions of the IR block (see
+ * ProfileIR). It isn't dumped ({@code --dump-bytecode}), since only
+ * the program without counters is run. Its functions are never
+ * compiled (see jit.c), every block runs its {@code count}.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the generation
+ * 
+ * @param *module   Verified IR of the program
+ * @param **program Receives the program (NULL if the translation failed)
+ * @param profiled  Whether the blocks count their executions
+ */
+int VM_generate_program(struct IRModule *module, struct VMProgram **program, int profiled) {
+	*program = NULL;
+
+	if (module == NULL || module->entryFunction < 0) {
+		return PHASE_ABORTED;
+	}
+
+	struct VMProgram *result = (struct VMProgram*)calloc(1, sizeof(struct VMProgram));
+	jmp_buf recoveryPoint;
+
+	if (result == NULL) {
+		(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "An error occured while trying to allocate memory.");
+		return PHASE_ABORTED;
+	}
+
+	if (setjmp(recoveryPoint) != 0) {
+		(void)FREE_VM_PROGRAM(result);
+		return PHASE_ABORTED;
+	}
+
+	(void)_init_error_recovery_point_(&recoveryPoint);
+	result->entryFunction = module->entryFunction;
+	result->jit = profiled == true ? false : VM_JIT_SUPPORTED;
+	result->strings = (union VMValue*)VM_allocate(module->stringCount, sizeof(union VMValue));
+	result->globals = (struct VMGlobal*)VM_allocate(module->globalCount, sizeof(struct VMGlobal));
+	result->functions = (struct VMFunction*)VM_allocate(module->functionCount, sizeof(struct VMFunction));
+	result->classes = (struct VMClass*)VM_allocate(module->classCount, sizeof(struct VMClass));
+
+	(void)VM_create_string_segment(result, module);
+
+	for (size_t i = 0; i < module->classCount; i++) {
+		result->classCount++;
+		(void)VM_translate_class(&module->classes[i], &result->classes[i]);
+	}
+
+	for (size_t i = 0; i < module->globalCount; i++) {
+		result->globals[i].name = (char*)VM_allocate(strlen(module->globals[i].name) + 1, sizeof(char));
+		result->globals[i].type = module->globals[i].type;
+		result->globalCount++;
+		(void)strcpy(result->globals[i].name, module->globals[i].name);
+	}
+
+	for (size_t i = 0; i < module->functionCount; i++) {
+		result->functionCount++;
+		(void)VM_translate_function(result, module->functions[i], &result->functions[i], profiled);
+	}
+
+	(void)_init_error_recovery_point_(NULL);
+	*program = result;
+
+	if (BYTECODE_DUMP != NULL && profiled == false) {
+		(void)fprintf(BYTECODE_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    BYTECODE (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+		(void)VM_dump_program(BYTECODE_DUMP, result);
+	}
+
+	return PHASE_SUCCESS;
+}
+
+/*
+Purpose: Create the values of the string literals, the long ones are placed into a single segment
+Return Type: void
+Params: struct VMProgram *program => Program, that receives the strings;
+		struct IRModule *module => Module with the literals
+*/
+void VM_create_string_segment(struct VMProgram *program, struct IRModule *module) {
+	for (size_t i = 0; i < module->stringCount; i++) {
+		size_t length = strlen(module->strings[i]);
+
+		if (length > VM_SMALL_STRING_LENGTH) {
+			program->stringSegmentSize += VM_OBJECT_SIZE(VM_FLAT_STRING_SLOTS(length));
+		}
+	}
+
+	if (program->stringSegmentSize > 0) {
+		program->stringSegment = (unsigned char*)VM_allocate(program->stringSegmentSize, sizeof(unsigned char));
+	}
+
+	size_t offset = 0;
+
+	for (size_t i = 0; i < module->stringCount; i++) {
+		size_t length = strlen(module->strings[i]);
+		program->stringCount++;
+
+		if (length <= VM_SMALL_STRING_LENGTH) {
+			program->strings[i] = VM_create_small_string(module->strings[i], length);
+			continue;
+		}
+
+		//Literals are never collected, the objects only have the layout of flat strings
+		struct VMObject *object = (struct VMObject*)(program->stringSegment + offset);
+		object->slotCount = (unsigned int)VM_FLAT_STRING_SLOTS(length);
+		object->classId = -1;
+		(void)VM_init_flat_string(object, module->strings[i], length);
+		program->strings[i].object = object;
+		offset += VM_OBJECT_SIZE(object->slotCount);
+	}
+}
+
+/**
+ * <p>
+ * Translates a class: the fields keep the offsets of the layout (behind
+ * the pointer to the vtable, which the header of the object replaces),
+ * the slots of the reference fields are collected for the collections.
+ * </p>
+ * 
+ * @param *source   IR class to translate
+ * @param *vmClass  Class to fill
+ */
+void VM_translate_class(struct IRClass *source, struct VMClass *vmClass) {
+	size_t size = source->size > VM_LAYOUT_HEADER_SIZE ? source->size - VM_LAYOUT_HEADER_SIZE : 0;
+	vmClass->name = (char*)VM_allocate(strlen(source->name) + 1, sizeof(char));
+	(void)strcpy(vmClass->name, source->name);
+	vmClass->isInterface = source->isInterface;
+	vmClass->interfaceBase = source->interfaceBase;
+	vmClass->slotCount = (size + sizeof(union VMValue) - 1) / sizeof(union VMValue);
+	vmClass->fields = (struct VMField*)VM_allocate(source->fieldCount, sizeof(struct VMField));
+	vmClass->fieldCount = source->fieldCount;
+	vmClass->referenceSlots = (int*)VM_allocate(source->fieldCount, sizeof(int));
+	vmClass->vtable = (int*)VM_allocate(source->methodCount, sizeof(int));
+	vmClass->interfaceSlots = (int*)VM_allocate(source->interfaceSlotCount, sizeof(int));
+
+	for (size_t i = 0; i < source->fieldCount; i++) {
+		struct VMField *field = &vmClass->fields[i];
+		field->offset = source->fields[i].offset - VM_LAYOUT_HEADER_SIZE;
+		field->size = source->fields[i].size;
+		field->type = source->fields[i].type;
+
+		if ((int)VM_is_reference_type(field->type) == true) {
+			vmClass->referenceSlots[vmClass->referenceCount++] = (int)(field->offset / sizeof(union VMValue));
+		}
+	}
+
+	//The methods of an interface have no function
+	if (source->isInterface == false && source->methodCount > 0) {
+		vmClass->methodCount = source->methodCount;
+		(void)memcpy(vmClass->vtable, source->methods, source->methodCount * sizeof(int));
+	}
+
+	vmClass->interfaceSlotCount = source->interfaceSlotCount;
+
+	if (source->interfaceSlotCount > 0) {
+		(void)memcpy(vmClass->interfaceSlots, source->interfaceSlots, source->interfaceSlotCount * sizeof(int));
+	}
+}
+
+/**
+ * <p>
+ * Translates the blocks of an IR function in their layout order.
+ * </p>
+ * 
+ * <p>
+ * The jumps are emitted with the block numbers as targets, they are
+ * replaced by the code indices, once all blocks are placed. The same
+ * holds for the landing pads of the exception table.
+ * </p>
+ * 
+ * @returns True, if the function was translated
+ * 
+ * @param *program      Program, that receives the function
+ * @param *source       IR function to translate
+ * @param *function     Function to fill
+ * @param profiled      Whether the blocks count their executions
+ */
+int VM_translate_function(struct VMProgram *program, struct IRFunction *source, struct VMFunction *function, int profiled) {
+	function->name = (char*)VM_allocate(strlen(source->name) + 1, sizeof(char));
+	(void)strcpy(function->name, source->name);
+	function->returnType = source->returnType;
+	function->paramCount = source->paramCount;
+	function->registerCount = (int)source->registerCount;
+
+	if (source->argumentCount > 0) {
+		function->arguments = (int*)VM_allocate(source->argumentCount, sizeof(int));
+		function->argumentCount = source->argumentCount;
+		(void)memcpy(function->arguments, source->arguments, source->argumentCount * sizeof(int));
+	}
+
+	//The types of the registers come from the typed locals, so they give the stack map
+	for (size_t i = 0; i < source->registerCount; i++) {
+		if ((int)VM_is_reference_type(source->registers[i].type) == true) {
+			function->referenceCount++;
+		}
+	}
+
+	if (function->referenceCount > 0) {
+		function->references = (int*)VM_allocate((size_t)function->referenceCount, sizeof(int));
+
+		for (size_t i = 0, n = 0; i < source->registerCount; i++) {
+			if ((int)VM_is_reference_type(source->registers[i].type) == true) {
+				function->references[n++] = (int)i;
+			}
+		}
+	}
+
+	size_t *blockStarts = (size_t*)VM_allocate(source->blockCount + 1, sizeof(size_t));
+
+	if (profiled == true) {
+		function->blockCounts = (size_t*)VM_allocate(source->blockCount, sizeof(size_t));
+		function->blockCount = source->blockCount;
+	}
+
+	for (size_t i = 0; i < source->blockCount; i++) {
+		struct IRBlock *block = &source->blocks[i];
+		blockStarts[i] = function->codeLength;
+
+		if (profiled == true) {
+			(void)VM_emit(function, VM_COUNT, 0, (int)i, 0, 0, block->instructionCount > 0 ? source->instructions[block->firstInstruction].line : 0);
+		}
+
+		for (size_t n = 0; n < block->instructionCount; n++) {
+			struct IRInstruction *instruction = &source->instructions[block->firstInstruction + n];
+			size_t start = function->codeLength;
+			(void)VM_translate_instruction(program, source, function, instruction, (int)i + 1);
+
+			//An inlined instruction reports the function, that it was inlined from
+			for (size_t k = start; k < function->codeLength && instruction->origin >= 0; k++) {
+				function->origins[k] = instruction->origin;
+			}
+		}
+	}
+
+	blockStarts[source->blockCount] = function->codeLength;
+	(void)VM_patch_jump_targets(function, blockStarts);
+	(void)VM_build_exception_table(source, function, blockStarts);
+	(void)free(blockStarts);
+	return true;
+}
+
+/*
+Purpose: Translate a single IR instruction into the bytecode
+Return Type: void
+Params: struct VMProgram *program => Program with the strings;
+		struct IRFunction *source => Function of the instruction;
+		struct VMFunction *function => Function, that receives the bytecode;
+		struct IRInstruction *instruction => Instruction to translate;
+		int nextBlock => Block, that follows the block of the instruction
+*/
+void VM_translate_instruction(struct VMProgram *program, struct IRFunction *source, struct VMFunction *function, struct IRInstruction *instruction, int nextBlock) {
+	size_t line = instruction->line;
+	int dest = instruction->dest;
+	int a = instruction->a;
+	int b = instruction->b;
+	enum VarType operandType = a >= 0 && (size_t)a < source->registerCount ? source->registers[a].type : null;
+	int floating = (int)VM_is_floating_type(instruction->type);
+	union VMValue value;
+
+	switch (instruction->opcode) {
+	case IR_NOP:
+		break;
+	case IR_CONST_INT:
+		if (instruction->value.integer >= INT_MIN && instruction->value.integer <= INT_MAX) {
+			(void)VM_emit(function, VM_LOAD_INT, dest, (int)instruction->value.integer, 0, 0, line);
+			break;
+		}
+
+		value.integer = instruction->value.integer;
+		(void)VM_emit(function, VM_LOAD_CONST, dest, VM_add_constant(function, value, instruction->type), 0, 0, line);
+		break;
+	case IR_CONST_FLOAT:
+		value.floating = instruction->type == FLOAT ? (double)(float)instruction->value.floating : instruction->value.floating;
+		(void)VM_emit(function, VM_LOAD_CONST, dest, VM_add_constant(function, value, instruction->type), 0, 0, line);
+		break;
+	case IR_CONST_STRING:
+		(void)VM_emit(function, VM_LOAD_CONST, dest, VM_add_constant(function, program->strings[a], STRING), 0, 0, line);
+		break;
+	case IR_MOVE:
+		(void)VM_emit(function, VM_MOVE, dest, a, 0, 0, line);
+		break;
+	case IR_LOAD_GLOBAL:
+		(void)VM_emit(function, VM_LOAD_GLOBAL, dest, a, 0, 0, line);
+		break;
+	case IR_STORE_GLOBAL:
+		(void)VM_emit(function, VM_STORE_GLOBAL, 0, a, b, 0, line);
+		break;
+	case IR_ADD:
+	case IR_SUB:
+	case IR_MUL:
+	case IR_DIV:
+	case IR_MOD:
+		//The most frequent operations on int are cut by the instruction itself
+		if (instruction->type == INTEGER && instruction->opcode <= IR_MUL) {
+			(void)VM_emit(function, VM_ADD_INT32 + (instruction->opcode - IR_ADD), dest, a, b, 0, line);
+			break;
+		}
+
+		(void)VM_emit(function, (floating == true ? VM_ADD_DOUBLE : VM_ADD_INT) + (instruction->opcode - IR_ADD), dest, a, b, 0, line);
+
+		//A remainder is always smaller than the divisor, so it doesn't have to wrap
+		if (instruction->type == FLOAT) {
+			(void)VM_emit(function, VM_TO_FLOAT, dest, dest, 0, 0, line);
+		} else if (instruction->opcode != IR_MOD) {
+			(void)VM_emit_wrap(function, instruction->type, dest, line);
+		}
+
+		break;
+	case IR_NEG:
+		(void)VM_emit(function, floating == true ? VM_NEG_DOUBLE : VM_NEG_INT, dest, a, 0, 0, line);
+		(void)VM_emit_wrap(function, instruction->type, dest, line);
+		break;
+	case IR_SHL:
+		(void)VM_emit(function, VM_SHL, dest, a, b, 0, line);
+		(void)VM_emit_wrap(function, instruction->type, dest, line);
+		break;
+	case IR_SHR:
+	case IR_BIT_AND:
+	case IR_BIT_OR:
+	case IR_BIT_XOR:
+	case IR_NOT:
+		(void)VM_emit(function, VM_SHL + (instruction->opcode - IR_SHL), dest, a, b, 0, line);
+		break;
+	case IR_EQ:
+	case IR_NE:
+	case IR_LT:
+	case IR_LE:
+	case IR_GT:
+	case IR_GE: {
+		enum VMOpcode first = VM_is_floating_type(operandType) == true ? VM_EQ_DOUBLE : VM_EQ_INT;
+		(void)VM_emit(function, first + (instruction->opcode - IR_EQ), dest, a, b, 0, line);
+		break;
+	}
+	case IR_CONVERT:
+		(void)VM_translate_conversion(function, operandType, instruction->type, dest, a, line);
+		break;
+	case IR_CONCAT:
+		(void)VM_emit(function, VM_CONCAT, dest, a, b, 0, line);
+		break;
+	case IR_BUILDER:
+		(void)VM_emit(function, VM_BUILDER, dest, a, 0, 0, line);
+		break;
+	case IR_APPEND:
+		(void)VM_emit(function, VM_APPEND, dest, a, b, 0, line);
+		break;
+	case IR_NEW:
+		(void)VM_emit(function, VM_NEW, dest, a, 0, 0, line);
+		break;
+	case IR_NEW_ARRAY:
+		(void)VM_emit(function, VM_NEW_ARRAY, dest, (int)source->registers[dest].reference.elementType, b, instruction->c, line);
+		break;
+	case IR_LOAD_FIELD: {
+		struct VMField *field = &program->classes[instruction->value.integer].fields[b];
+		(void)VM_emit(function, VM_get_field_opcode(field, VM_LOAD_FIELD), dest, a, (int)field->offset, 0, line);
+		break;
+	}
+	case IR_STORE_FIELD: {
+		struct VMField *field = &program->classes[instruction->value.integer].fields[b];
+		(void)VM_emit(function, VM_get_field_opcode(field, VM_STORE_FIELD), 0, a, (int)field->offset, instruction->c, line);
+		break;
+	}
+	case IR_LOAD_ELEMENT:
+		(void)VM_emit(function, instruction->value.integer == true ? VM_LOAD_ELEMENT_UNCHECKED : VM_LOAD_ELEMENT, dest, a, b, 0, line);
+		break;
+	case IR_STORE_ELEMENT:
+		(void)VM_emit(function, instruction->value.integer == true ? VM_STORE_ELEMENT_UNCHECKED : VM_STORE_ELEMENT, 0, a, b, instruction->c, line);
+		break;
+	case IR_CALL:
+		(void)VM_emit(function, VM_CALL, dest, a, b, instruction->c, line);
+		break;
+	case IR_CALL_VIRTUAL: {
+		//An interface method is looked up in the flat numbering of all interface methods
+		struct VMClass *vmClass = &program->classes[instruction->value.integer];
+
+		if (vmClass->isInterface == true) {
+			(void)VM_emit(function, VM_CALL_INTERFACE, dest, (int)vmClass->interfaceBase + a, b, instruction->c, line);
+		} else {
+			(void)VM_emit(function, VM_CALL_VIRTUAL, dest, a, b, instruction->c, line);
+		}
+
+		break;
+	}
+	case IR_CHECK_NULL:
+		(void)VM_emit(function, VM_CHECK_NULL, 0, a, 0, 0, line);
+		break;
+	case IR_JUMP:
+		if (a != nextBlock) {
+			(void)VM_emit(function, VM_JUMP, 0, a, 0, 0, line);
+		}
+
+		break;
+	case IR_BRANCH:
+		if (b == nextBlock) {
+			(void)VM_emit(function, VM_JUMP_IF_FALSE, 0, a, instruction->c, 0, line);
+		} else if (instruction->c == nextBlock) {
+			(void)VM_emit(function, VM_JUMP_IF_TRUE, 0, a, b, 0, line);
+		} else {
+			(void)VM_emit(function, VM_BRANCH, 0, a, b, instruction->c, line);
+		}
+
+		break;
+	case IR_SWITCH: {
+		//The blocks are copied and patched like the other jump targets
+		int first = (int)function->caseCount;
+
+		for (int i = 0; i <= instruction->c; i++) {
+			(void)VM_grow((void**)&function->cases, &function->caseCapacity, function->caseCount, sizeof(int));
+			function->cases[function->caseCount++] = source->cases[b + i];
+		}
+
+		value.integer = instruction->value.integer;
+		(void)VM_emit(function, VM_SWITCH, VM_add_constant(function, value, LONG), a, first, instruction->c, line);
+		break;
+	}
+	case IR_RETURN:
+		(void)VM_emit(function, a == IR_NO_REGISTER ? VM_RETURN_VOID : VM_RETURN, 0, a, 0, 0, line);
+		break;
+	case IR_RESUME:
+		(void)VM_emit(function, VM_RESUME, 0, 0, 0, 0, line);
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+Purpose: Get the load or store of a field, that accesses the bytes of the field with its type
+Return Type: enum VMOpcode => The opcode
+Params: struct VMField *field => The accessed field;
+		enum VMOpcode base => VM_LOAD_FIELD or VM_STORE_FIELD
+*/
+enum VMOpcode VM_get_field_opcode(struct VMField *field, enum VMOpcode base) {
+	int load = base == VM_LOAD_FIELD ? true : false;
+
+	if ((int)VM_is_reference_type(field->type) == true) {
+		//The references of the fields aren't the leading slots, so they need their own barrier
+		return load == true ? VM_LOAD_FIELD : VM_STORE_FIELD_REF;
+	}
+
+	switch (field->size) {
+	case 1:
+		return load == true ? VM_LOAD_FIELD_CHAR : VM_STORE_FIELD_CHAR;
+	case 2:
+		return load == true ? VM_LOAD_FIELD_SHORT : VM_STORE_FIELD_SHORT;
+	case 4:
+		if (field->type == FLOAT) {
+			return load == true ? VM_LOAD_FIELD_FLOAT : VM_STORE_FIELD_FLOAT;
+		}
+
+		return load == true ? VM_LOAD_FIELD_INT : VM_STORE_FIELD_INT;
+	default:
+		return base;
+	}
+}
+
+/*
+Purpose: Emit the cut of an int, short or char result to its width, so the arithmetic wraps around like the fields, that hold the type
+Return Type: void
+Params: struct VMFunction *function => Function, that receives the bytecode;
+		enum VarType type => Type of the result;
+		int dest => Register of the result;
+		size_t line => Line of the operation
+*/
+void VM_emit_wrap(struct VMFunction *function, enum VarType type, int dest, size_t line) {
+	switch (type) {
+	case INTEGER:
+		(void)VM_emit(function, VM_TO_INT, dest, dest, 0, 0, line);
+		break;
+	case SHORT:
+		(void)VM_emit(function, VM_TO_SHORT, dest, dest, 0, 0, line);
+		break;
+	case CHAR:
+		(void)VM_emit(function, VM_TO_CHAR, dest, dest, 0, 0, line);
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+Purpose: Emit the conversion of a number into another numeric type
+Return Type: void
+Params: struct VMFunction *function => Function, that receives the bytecode;
+		enum VarType from => Type of the value;
+		enum VarType to => Type to convert to;
+		int dest => Register of the result;
+		int reg => Register of the value;
+		size_t line => Line of the conversion
+*/
+void VM_translate_conversion(struct VMFunction *function, enum VarType from, enum VarType to, int dest, int reg, size_t line) {
+	enum VMOpcode opcode = VM_MOVE;
+
+	if ((int)VM_is_floating_type(to) == true) {
+		if ((int)VM_is_floating_type(from) == false) {
+			(void)VM_emit(function, VM_INT_TO_DOUBLE, dest, reg, 0, 0, line);
+			reg = dest;
+			from = DOUBLE;
+		}
+
+		opcode = to == FLOAT && from == DOUBLE ? VM_TO_FLOAT : VM_MOVE;
+	} else {
+		if ((int)VM_is_floating_type(from) == true) {
+			(void)VM_emit(function, VM_DOUBLE_TO_INT, dest, reg, 0, 0, line);
+			reg = dest;
+			from = LONG;
+		}
+
+		switch (to) {
+		case INTEGER:
+			opcode = from == LONG ? VM_TO_INT : VM_MOVE;
+			break;
+		case SHORT:
+			opcode = from == LONG || from == INTEGER ? VM_TO_SHORT : VM_MOVE;
+			break;
+		case CHAR:
+			opcode = from != CHAR ? VM_TO_CHAR : VM_MOVE;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (opcode != VM_MOVE || reg != dest) {
+		(void)VM_emit(function, opcode, dest, reg, 0, 0, line);
+	}
+}
+
+/**
+ * <p>
+ * Replaces the block numbers of the jumps by the index of the
+ * block's first instruction.
+ * </p>
+ * 
+ * @param *function     Function with the translated code
+ * @param *blockStarts  Code index of every block
+ */
+void VM_patch_jump_targets(struct VMFunction *function, size_t *blockStarts) {
+	for (size_t i = 0; i < function->codeLength; i++) {
+		struct VMInstruction *instruction = &function->code[i];
+
+		switch (instruction->opcode) {
+		case VM_JUMP:
+			instruction->a = (int)blockStarts[instruction->a];
+			break;
+		case VM_BRANCH:
+			instruction->c = (int)blockStarts[instruction->c];
+			instruction->b = (int)blockStarts[instruction->b];
+			break;
+		case VM_JUMP_IF_TRUE:
+		case VM_JUMP_IF_FALSE:
+			instruction->b = (int)blockStarts[instruction->b];
+			break;
+		case VM_SWITCH:
+			for (int n = 0; n <= instruction->c; n++) {
+				function->cases[instruction->b + n] = (int)blockStarts[function->cases[instruction->b + n]];
+			}
+
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/**
+ * <p>
+ * Creates the exception table of a function from the landing pads of
+ * its blocks. Following blocks with the same landing pad share one
+ * range, blocks without code don't get a range.
+ * </p>
+ * 
+ * @param *source       IR function with the landing pads
+ * @param *function     Function with the translated code
+ * @param *blockStarts  Code index of every block (and the end of the code)
+ */
+void VM_build_exception_table(struct IRFunction *source, struct VMFunction *function, size_t *blockStarts) {
+	size_t capacity = 0;
+
+	for (size_t i = 0; i < source->blockCount; i++) {
+		int handler = source->blocks[i].handler;
+
+		if (handler < 0 || blockStarts[i] == blockStarts[i + 1]) {
+			continue;
+		}
+
+		struct VMExceptionRange *last = function->exceptionRangeCount > 0 ? &function->exceptionRanges[function->exceptionRangeCount - 1] : NULL;
+
+		if (last != NULL && last->end == blockStarts[i] && last->landingPad == blockStarts[handler]) {
+			last->end = blockStarts[i + 1];
+			continue;
+		}
+
+		(void)VM_grow((void**)&function->exceptionRanges, &capacity, function->exceptionRangeCount, sizeof(struct VMExceptionRange));
+		function->exceptionRanges[function->exceptionRangeCount].start = blockStarts[i];
+		function->exceptionRanges[function->exceptionRangeCount].end = blockStarts[i + 1];
+		function->exceptionRanges[function->exceptionRangeCount].landingPad = blockStarts[handler];
+		function->exceptionRangeCount++;
+	}
+}
+
+void VM_emit(struct VMFunction *function, enum VMOpcode opcode, int dest, int a, int b, int c, size_t line) {
+	size_t capacity = function->codeCapacity;
+	size_t originCapacity = function->codeCapacity;
+	(void)VM_grow((void**)&function->code, &function->codeCapacity, function->codeLength, sizeof(struct VMInstruction));
+	(void)VM_grow((void**)&function->lines, &capacity, function->codeLength, sizeof(size_t));
+	(void)VM_grow((void**)&function->origins, &originCapacity, function->codeLength, sizeof(int));
+
+	struct VMInstruction *instruction = &function->code[function->codeLength];
+	instruction->handler = NULL;
+	instruction->opcode = opcode;
+	instruction->dest = dest;
+	instruction->a = a;
+	instruction->b = b;
+	instruction->c = c;
+	function->origins[function->codeLength] = -1;
+	function->lines[function->codeLength++] = line;
+}
+
+/**
+ * <p>
+ * Adds a constant to the pool of a function, equal constants
+ * share one entry.
+ * </p>
+ * 
+ * @returns The index of the constant
+ * 
+ * @param *function     Function, that owns the pool
+ * @param value         Value of the constant
+ * @param type          Type of the constant
+ */
+int VM_add_constant(struct VMFunction *function, union VMValue value, enum VarType type) {
+	for (size_t i = 0; i < function->constantCount; i++) {
+		if (function->constantTypes[i] == type && memcmp(&function->constants[i], &value, sizeof(union VMValue)) == 0) {
+			return (int)i;
+		}
+	}
+
+	size_t capacity = function->constantCapacity;
+	(void)VM_grow((void**)&function->constants, &function->constantCapacity, function->constantCount, sizeof(union VMValue));
+	(void)VM_grow((void**)&function->constantTypes, &capacity, function->constantCount, sizeof(enum VarType));
+	function->constants[function->constantCount] = value;
+	function->constantTypes[function->constantCount] = type;
+	return (int)function->constantCount++;
+}
+
+int VM_is_floating_type(enum VarType type) {
+	return type == DOUBLE || type == FLOAT ? true : false;
+}
+
+/*
+Purpose: Check if the values of a type are references, which the garbage collector has to visit
+Return Type: int => true if the type is a reference type, else false
+Params: enum VarType type => Type to check
+*/
+int VM_is_reference_type(enum VarType type) {
+	switch (type) {
+	case STRING:
+	case CUSTOM:
+	case CLASS_REF:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void *VM_allocate(size_t count, size_t size) {
+	void *memory = calloc(count == 0 ? 1 : count, size);
+
+	if (memory == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return NULL;
+	}
+
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, count * size);
+	return memory;
+}
+
+void VM_grow(void **array, size_t *capacity, size_t count, size_t size) {
+	if (count < *capacity) {
+		return;
+	}
+
+	size_t newCapacity = *capacity < 16 ? 16 : *capacity * 2;
+	void *grown = realloc(*array, newCapacity * size);
+
+	if (grown == NULL) {
+		(void)IO_BUFFER_RESERVATION_EXCEPTION();
+		return;
+	}
+
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, (newCapacity - *capacity) * size);
+	*array = grown;
+	*capacity = newCapacity;
+}
+
+size_t VM_count_instructions(struct VMProgram *program) {
+	size_t count = 0;
+
+	for (size_t i = 0; program != NULL && i < program->functionCount; i++) {
+		count += program->functions[i].codeLength;
+	}
+
+	return count;
+}
+
+/**
+ * <p>
+ * Writes the bytecode of a program in a readable form.
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *program  Program to dump
+ */
+void VM_dump_program(FILE *output, struct VMProgram *program) {
+	if (output == NULL || program == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < program->classCount; i++) {
+		(void)VM_dump_class(output, program, &program->classes[i]);
+	}
+
+	for (size_t i = 0; i < program->globalCount; i++) {
+		(void)fprintf(output, "global @%lu:%s %s\n", (unsigned long)i, IR_get_type_name(program->globals[i].type), program->globals[i].name);
+	}
+
+	for (size_t i = 0; i < program->functionCount; i++) {
+		(void)fprintf(output, "\n");
+		(void)VM_dump_function(output, program, &program->functions[i]);
+	}
+}
+
+void VM_dump_class(FILE *output, struct VMProgram *program, struct VMClass *vmClass) {
+	if (vmClass->isInterface == true) {
+		(void)fprintf(output, "interface %s\n", vmClass->name);
+		return;
+	}
+
+	(void)fprintf(output, "class %s (%lu slots)\n", vmClass->name, (unsigned long)vmClass->slotCount);
+
+	for (size_t i = 0; i < vmClass->fieldCount; i++) {
+		struct VMField *field = &vmClass->fields[i];
+		(void)fprintf(output, "    field .%lu @%lu:%s\n", (unsigned long)i, (unsigned long)field->offset, IR_get_type_name(field->type));
+	}
+
+	if (vmClass->referenceCount > 0) {
+		(void)fprintf(output, "    ; references");
+
+		for (size_t i = 0; i < vmClass->referenceCount; i++) {
+			(void)fprintf(output, "%s s%i", i > 0 ? "," : "", vmClass->referenceSlots[i]);
+		}
+
+		(void)fprintf(output, "\n");
+	}
+
+	for (size_t i = 0; i < vmClass->methodCount; i++) {
+		(void)fprintf(output, "    vtable [%lu] %s\n", (unsigned long)i, program->functions[vmClass->vtable[i]].name);
+	}
+
+	for (size_t i = 0; i < vmClass->interfaceSlotCount; i++) {
+		if (vmClass->interfaceSlots[i] >= 0) {
+			(void)fprintf(output, "    interface [%lu] -> [%i]\n", (unsigned long)i, vmClass->interfaceSlots[i]);
+		}
+	}
+}
+
+void VM_dump_function(FILE *output, struct VMProgram *program, struct VMFunction *function) {
+	(void)fprintf(output, "fn %s (%i params, %i registers) -> %s\n", function->name, function->paramCount,
+		function->registerCount, IR_get_type_name(function->returnType));
+
+	if (function->referenceCount > 0) {
+		(void)fprintf(output, "    ; references");
+
+		for (int i = 0; i < function->referenceCount; i++) {
+			(void)fprintf(output, "%s r%i", i > 0 ? "," : "", function->references[i]);
+		}
+
+		(void)fprintf(output, "\n");
+	}
+
+	for (size_t i = 0; i < function->exceptionRangeCount; i++) {
+		struct VMExceptionRange *range = &function->exceptionRanges[i];
+		(void)fprintf(output, "    ; unwind %04lu..%04lu -> %04lu\n", (unsigned long)range->start,
+			(unsigned long)(range->end - 1), (unsigned long)range->landingPad);
+	}
+
+	for (size_t i = 0; i < function->constantCount; i++) {
+		union VMValue *constant = &function->constants[i];
+		(void)fprintf(output, "    #%lu:%s ", (unsigned long)i, IR_get_type_name(function->constantTypes[i]));
+
+		if (function->constantTypes[i] == STRING) {
+			(void)fprintf(output, "\"");
+			(void)VM_write_string(output, *constant);
+			(void)fprintf(output, "\"\n");
+		} else if ((int)VM_is_floating_type(function->constantTypes[i]) == true) {
+			(void)fprintf(output, "%g\n", constant->floating);
+		} else {
+			(void)fprintf(output, "%lld\n", constant->integer);
+		}
+	}
+
+	for (size_t i = 0; i < function->codeLength; i++) {
+		(void)VM_dump_instruction(output, program, function, i);
+	}
+}
+
+void VM_dump_instruction(FILE *output, struct VMProgram *program, struct VMFunction *function, size_t index) {
+	struct VMInstruction *instruction = &function->code[index];
+	(void)fprintf(output, "    %04lu  %-14s", (unsigned long)index, VM_OPCODE_NAMES[instruction->opcode]);
+
+	switch (instruction->opcode) {
+	case VM_LOAD_INT:
+		(void)fprintf(output, "r%i, %i", instruction->dest, instruction->a);
+		break;
+	case VM_LOAD_CONST:
+		(void)fprintf(output, "r%i, #%i", instruction->dest, instruction->a);
+		break;
+	case VM_LOAD_GLOBAL:
+		(void)fprintf(output, "r%i, @%i", instruction->dest, instruction->a);
+		break;
+	case VM_STORE_GLOBAL:
+		(void)fprintf(output, "@%i, r%i", instruction->a, instruction->b);
+		break;
+	case VM_CALL:
+	case VM_CALL_VIRTUAL:
+	case VM_CALL_INTERFACE:
+		if (instruction->dest != IR_NO_REGISTER) {
+			(void)fprintf(output, "r%i, ", instruction->dest);
+		}
+
+		if (instruction->opcode == VM_CALL) {
+			(void)fprintf(output, "%s", program->functions[instruction->a].name);
+		} else {
+			(void)fprintf(output, "%s[%i]", instruction->opcode == VM_CALL_VIRTUAL ? "vtable" : "interface", instruction->a);
+		}
+
+		(void)VM_dump_arguments(output, function, instruction);
+		break;
+	case VM_NEW:
+		(void)fprintf(output, "r%i, %s", instruction->dest, program->classes[instruction->a].name);
+		break;
+	case VM_NEW_ARRAY:
+		(void)fprintf(output, "r%i, %s", instruction->dest, IR_get_type_name((enum VarType)instruction->a));
+		(void)VM_dump_arguments(output, function, instruction);
+		break;
+	case VM_LOAD_FIELD:
+	case VM_LOAD_FIELD_INT:
+	case VM_LOAD_FIELD_SHORT:
+	case VM_LOAD_FIELD_CHAR:
+	case VM_LOAD_FIELD_FLOAT:
+		(void)fprintf(output, "r%i, r%i.@%i", instruction->dest, instruction->a, instruction->b);
+		break;
+	case VM_STORE_FIELD:
+	case VM_STORE_FIELD_INT:
+	case VM_STORE_FIELD_SHORT:
+	case VM_STORE_FIELD_CHAR:
+	case VM_STORE_FIELD_FLOAT:
+	case VM_STORE_FIELD_REF:
+		(void)fprintf(output, "r%i.@%i, r%i", instruction->a, instruction->b, instruction->c);
+		break;
+	case VM_LOAD_ELEMENT:
+	case VM_LOAD_ELEMENT_UNCHECKED:
+		(void)fprintf(output, "r%i, r%i[r%i]", instruction->dest, instruction->a, instruction->b);
+		break;
+	case VM_STORE_ELEMENT:
+	case VM_STORE_ELEMENT_UNCHECKED:
+		(void)fprintf(output, "r%i[r%i], r%i", instruction->a, instruction->b, instruction->c);
+		break;
+	case VM_CHECK_NULL:
+		(void)fprintf(output, "r%i", instruction->a);
+		break;
+	case VM_JUMP:
+		(void)fprintf(output, "%04i", instruction->a);
+		break;
+	case VM_JUMP_IF_TRUE:
+	case VM_JUMP_IF_FALSE:
+		(void)fprintf(output, "r%i, %04i", instruction->a, instruction->b);
+		break;
+	case VM_BRANCH:
+		(void)fprintf(output, "r%i, %04i, %04i", instruction->a, instruction->b, instruction->c);
+		break;
+	case VM_SWITCH:
+		(void)fprintf(output, "r%i, #%i, %04i [", instruction->a, instruction->dest, function->cases[instruction->b]);
+
+		for (int i = 1; i <= instruction->c; i++) {
+			(void)fprintf(output, "%s%04i", i > 1 ? ", " : "", function->cases[instruction->b + i]);
+		}
+
+		(void)fprintf(output, "]");
+		break;
+	case VM_RETURN:
+		(void)fprintf(output, "r%i", instruction->a);
+		break;
+	case VM_RETURN_VOID:
+	case VM_RESUME:
+		break;
+	case VM_COUNT:
+		(void)fprintf(output, "b%i", instruction->a);
+		break;
+	case VM_MOVE:
+	case VM_NEG_INT:
+	case VM_NOT:
+	case VM_NEG_DOUBLE:
+	case VM_INT_TO_DOUBLE:
+	case VM_DOUBLE_TO_INT:
+	case VM_TO_INT:
+	case VM_TO_SHORT:
+	case VM_TO_CHAR:
+	case VM_TO_FLOAT:
+	case VM_BUILDER:
+		(void)fprintf(output, "r%i, r%i", instruction->dest, instruction->a);
+		break;
+	default:
+		(void)fprintf(output, "r%i, r%i, r%i", instruction->dest, instruction->a, instruction->b);
+		break;
+	}
+
+	(void)fprintf(output, "\n");
+}
+
+//Writes the argument registers of a call, the lengths of a new array are written as dimensions
+void VM_dump_arguments(FILE *output, struct VMFunction *function, struct VMInstruction *instruction) {
+	int dimensions = instruction->opcode == VM_NEW_ARRAY ? true : false;
+	(void)fprintf(output, "%s", dimensions == true ? "" : "(");
+
+	for (int i = 0; i < instruction->c; i++) {
+		int reg = function->arguments[instruction->b + i];
+		(void)fprintf(output, dimensions == true ? "[r%i]" : i > 0 ? ", r%i" : "r%i", reg);
+	}
+
+	(void)fprintf(output, "%s", dimensions == true ? "" : ")");
+}
+
+void FREE_VM_PROGRAM(struct VMProgram *program) {
+	if (program == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < program->functionCount; i++) {
+		(void)FREE_VM_FUNCTION(&program->functions[i]);
+	}
+
+	for (size_t i = 0; i < program->globalCount; i++) {
+		(void)free(program->globals[i].name);
+	}
+
+	for (size_t i = 0; i < program->classCount; i++) {
+		(void)free(program->classes[i].name);
+		(void)free(program->classes[i].referenceSlots);
+		(void)free(program->classes[i].fields);
+		(void)free(program->classes[i].vtable);
+		(void)free(program->classes[i].interfaceSlots);
+	}
+
+	(void)free(program->classes);
+	(void)free(program->functions);
+	(void)free(program->globals);
+	(void)free(program->strings);
+	(void)free(program->stringSegment);
+	(void)free(program);
+}
+
+void FREE_VM_FUNCTION(struct VMFunction *function) {
+	(void)VM_jit_invalidate(function);
+	(void)free(function->name);
+	(void)free(function->code);
+	(void)free(function->lines);
+	(void)free(function->origins);
+	(void)free(function->constants);
+	(void)free(function->constantTypes);
+	(void)free(function->arguments);
+	(void)free(function->cases);
+	(void)free(function->references);
+	(void)free(function->exceptionRanges);
+	(void)free(function->blockCounts);
+}
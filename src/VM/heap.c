@@ -0,0 +1,664 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/stats.h"
+#include "../../headers/vm.h"
+
+/**
+ * The subprogram {@code SPACE/src/VM/heap.c} was created
+ * to manage the memory of the objects of a running program.
+ *
+ * The heap is generational: objects are bump-allocated in a small
+ * nursery, most of them die there. A minor collection copies the
+ * survivors into the old generation (Cheney scan), so its pause only
+ * depends on the surviving objects. The old generation is collected by
+ * mark-compact (sliding, the order of the objects is kept) and grows
+ * until the maximum size of the heap is reached.
+ *
+ * The collector is precise: only the reference registers of the stack
+ * maps, the reference globals, the registered roots and the reference
+ * slots of the objects are visited. References, that don't point into
+ * the heap (e.g. the string literals and the small strings), are skipped.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+enum VMRootAction {
+	ROOT_EVACUATE,
+	ROOT_MARK,
+	ROOT_UPDATE
+};
+
+int VM_collect_minor(struct VMHeap *heap);
+int VM_collect_major(struct VMHeap *heap, size_t required);
+int VM_reserve_old(struct VMHeap *heap, size_t required);
+int VM_visit_roots(struct VMHeap *heap, enum VMRootAction action);
+int VM_visit_references(struct VMHeap *heap, struct VMObject *object, enum VMRootAction action);
+int VM_visit_slot(struct VMHeap *heap, union VMValue *slot, enum VMRootAction action);
+int VM_push_mark(struct VMHeap *heap, struct VMObject *object);
+int VM_remember(struct VMHeap *heap, struct VMObject *object);
+int VM_has_young_references(struct VMHeap *heap, struct VMObject *object);
+struct VMClass *VM_get_object_class(struct VMHeap *heap, struct VMObject *object);
+int VM_is_young(struct VMHeap *heap, struct VMObject *object);
+int VM_is_old(struct VMHeap *heap, struct VMObject *object);
+void VM_init_object(struct VMObject *object, size_t slotCount, size_t referenceCount);
+void VM_record_pause(struct VMHeap *heap, double start);
+
+/**
+ * <p>
+ * Creates an empty heap.
+ * </p>
+ *
+ * <p>
+ * Only the nursery is allocated, the old generation is created by the
+ * first collection.
+ * </p>
+ *
+ * @returns The heap or NULL, if no memory is left
+ *
+ * @param maxSize   Upper bound of the nursery and the old generation (in bytes)
+ */
+struct VMHeap *CreateNewVMHeap(size_t maxSize) {
+	struct VMHeap *heap = (struct VMHeap*)calloc(1, sizeof(struct VMHeap));
+
+	if (heap == NULL || maxSize < VM_NURSERY_SIZE * 2) {
+		(void)free(heap);
+		return NULL;
+	}
+
+	heap->nurserySize = VM_NURSERY_SIZE;
+	heap->nursery = (unsigned char*)malloc(heap->nurserySize);
+	heap->maxSize = maxSize;
+
+	if (heap->nursery == NULL) {
+		(void)FREE_VM_HEAP(heap);
+		return NULL;
+	}
+
+	(void)ST_count(COUNTER_BYTES_ALLOCATED, sizeof(struct VMHeap) + heap->nurserySize);
+	return heap;
+}
+
+/**
+ * <p>
+ * Allocates a new object with zeroed slots.
+ * </p>
+ *
+ * <p>
+ * The allocation is a safepoint: if the nursery is full, a minor
+ * collection runs first, so every reference of the caller has to be
+ * reachable from a root (and is updated by the collection).
+ * </p>
+ *
+ * @returns The object or NULL, if the heap reached its maximum size
+ *
+ * @param *heap             Heap to allocate in
+ * @param slotCount         Number of slots
+ * @param referenceCount    Number of leading slots, that hold references
+ */
+struct VMObject *VM_heap_allocate(struct VMHeap *heap, size_t slotCount, size_t referenceCount) {
+	size_t size = VM_OBJECT_SIZE(slotCount);
+	struct VMObject *object = NULL;
+
+	if (referenceCount > slotCount || slotCount > 0xFFFFFFFFUL) {
+		return NULL;
+	}
+
+	//Large objects would fill the nursery and be copied anyway
+	if (size > VM_LARGE_OBJECT_SIZE) {
+		if (heap->oldSize - heap->oldTop < size) {
+			double start = ST_get_wall_time();
+			int reserved = VM_collect_major(heap, size);
+			(void)VM_record_pause(heap, start);
+
+			if (reserved == false) {
+				return NULL;
+			}
+		}
+
+		object = (struct VMObject*)(heap->old + heap->oldTop);
+		heap->oldTop += size;
+	} else {
+		if (heap->nurseryTop + size > heap->nurserySize && (int)VM_collect_garbage(heap, false) == false) {
+			return NULL;
+		}
+
+		object = (struct VMObject*)(heap->nursery + heap->nurseryTop);
+		heap->nurseryTop += size;
+	}
+
+	heap->allocatedBytes += size;
+	(void)VM_init_object(object, slotCount, referenceCount);
+	return object;
+}
+
+/**
+ * <p>
+ * Allocates an object on the heap of a machine, the heap is created
+ * by the first allocation.
+ * </p>
+ *
+ * <p>
+ * The interpreter has to set the active frame before, so the stack
+ * maps of all frames are visited.
+ * </p>
+ *
+ * @returns The object or NULL, if no memory is left
+ *
+ * @param *machine          Machine, that runs the program
+ * @param slotCount         Number of slots
+ * @param referenceCount    Number of leading slots, that hold references
+ */
+struct VMObject *VM_allocate_object(struct VirtualMachine *machine, size_t slotCount, size_t referenceCount) {
+	if (machine->heap == NULL) {
+		machine->heap = CreateNewVMHeap(VM_MAX_HEAP_SIZE);
+
+		if (machine->heap == NULL) {
+			return NULL;
+		}
+
+		machine->heap->machine = machine;
+	}
+
+	return VM_heap_allocate(machine->heap, slotCount, referenceCount);
+}
+
+void VM_init_object(struct VMObject *object, size_t slotCount, size_t referenceCount) {
+	(void)memset(object, 0, VM_OBJECT_SIZE(slotCount));
+	object->slotCount = (unsigned int)slotCount;
+	object->referenceCount = (unsigned int)referenceCount;
+	object->classId = -1;
+}
+
+/**
+ * <p>
+ * Writes a slot of an object (write barrier).
+ * </p>
+ *
+ * <p>
+ * An old object, that gets a reference into the nursery, is remembered,
+ * so the next minor collection treats its slots as roots.
+ * </p>
+ *
+ * @returns True if the value was written, false if the remembered set can't grow
+ *
+ * @param *heap     Heap of the object
+ * @param *object   Object to write
+ * @param slot      Index of the slot
+ * @param value     Value to write
+ */
+int VM_heap_write(struct VMHeap *heap, struct VMObject *object, size_t slot, union VMValue value) {
+	if (slot < object->referenceCount && (int)VM_write_barrier(heap, object, value.object) == false) {
+		return false;
+	}
+
+	object->slots[slot] = value;
+	return true;
+}
+
+/**
+ * <p>
+ * Remembers an old object, that gets a reference into the nursery.
+ * It has to run in front of every write of a reference, that doesn't
+ * go through VM_heap_write (e.g. the reference fields of a class).
+ * </p>
+ *
+ * @returns True if the write can happen, false if the remembered set can't grow
+ *
+ * @param *heap     Heap of the object
+ * @param *object   Object, that is written
+ * @param *value    Reference, that is written
+ */
+int VM_write_barrier(struct VMHeap *heap, struct VMObject *object, struct VMObject *value) {
+	if ((object->flags & VM_OBJECT_REMEMBERED) == 0 && (int)VM_is_young(heap, value) == true
+		&& (int)VM_is_old(heap, object) == true) {
+		return VM_remember(heap, object);
+	}
+
+	return true;
+}
+
+int VM_remember(struct VMHeap *heap, struct VMObject *object) {
+	if (heap->rememberedCount >= heap->rememberedCapacity) {
+		size_t capacity = heap->rememberedCapacity < 64 ? 64 : heap->rememberedCapacity * 2;
+		struct VMObject **remembered = (struct VMObject**)realloc(heap->remembered, capacity * sizeof(struct VMObject*));
+
+		if (remembered == NULL) {
+			return false;
+		}
+
+		heap->remembered = remembered;
+		heap->rememberedCapacity = capacity;
+	}
+
+	object->flags |= VM_OBJECT_REMEMBERED;
+	heap->remembered[heap->rememberedCount++] = object;
+	return true;
+}
+
+/**
+ * <p>
+ * Registers a value outside of the VM as root, the collections
+ * update the reference in it.
+ * </p>
+ *
+ * @returns True if the root was registered, else false
+ *
+ * @param *heap     Heap of the referenced object
+ * @param *root     Value, that holds the reference
+ */
+int VM_heap_push_root(struct VMHeap *heap, union VMValue *root) {
+	if (heap->rootCount >= heap->rootCapacity) {
+		size_t capacity = heap->rootCapacity < 64 ? 64 : heap->rootCapacity * 2;
+		union VMValue **roots = (union VMValue**)realloc(heap->roots, capacity * sizeof(union VMValue*));
+
+		if (roots == NULL) {
+			return false;
+		}
+
+		heap->roots = roots;
+		heap->rootCapacity = capacity;
+	}
+
+	heap->roots[heap->rootCount++] = root;
+	return true;
+}
+
+void VM_heap_pop_roots(struct VMHeap *heap, size_t count) {
+	heap->rootCount = count < heap->rootCount ? heap->rootCount - count : 0;
+}
+
+/**
+ * <p>
+ * Runs a collection and measures its pause.
+ * </p>
+ *
+ * <p>
+ * A minor collection empties the nursery, if the old generation has no
+ * space for the survivors, it's collected first. A full collection also
+ * compacts the old generation.
+ * </p>
+ *
+ * @returns True if the nursery is empty afterwards, false if the heap reached its maximum size
+ *
+ * @param *heap     Heap to collect
+ * @param full      True to collect the old generation as well
+ */
+int VM_collect_garbage(struct VMHeap *heap, int full) {
+	double start = ST_get_wall_time();
+	int collected = full == true ? VM_collect_major(heap, heap->nurseryTop) : true;
+
+	if (collected == true) {
+		collected = VM_collect_minor(heap);
+	}
+
+	(void)VM_record_pause(heap, start);
+	return collected;
+}
+
+void VM_record_pause(struct VMHeap *heap, double start) {
+	double pause = ST_get_wall_time() - start;
+	heap->pauseTime += pause;
+	heap->maxPause = pause > heap->maxPause ? pause : heap->maxPause;
+	(void)ST_count(COUNTER_COLLECTIONS, 1);
+}
+
+/*
+Purpose: Copy all reachable objects of the nursery into the old generation
+Return Type: int => true if the nursery was emptied, else false
+Params: struct VMHeap *heap => Heap to collect
+*/
+int VM_collect_minor(struct VMHeap *heap) {
+	//In the worst case every object of the nursery survives
+	if ((int)VM_reserve_old(heap, heap->nurseryTop) == false) {
+		return false;
+	}
+
+	size_t scan = heap->oldTop;
+	(void)VM_visit_roots(heap, ROOT_EVACUATE);
+
+	for (size_t i = 0; i < heap->rememberedCount; i++) {
+		heap->remembered[i]->flags &= ~VM_OBJECT_REMEMBERED;
+		(void)VM_visit_references(heap, heap->remembered[i], ROOT_EVACUATE);
+	}
+
+	//The copied objects are the queue of the breadth-first search (Cheney)
+	while (scan < heap->oldTop) {
+		struct VMObject *object = (struct VMObject*)(heap->old + scan);
+		(void)VM_visit_references(heap, object, ROOT_EVACUATE);
+		scan += VM_OBJECT_SIZE(object->slotCount);
+	}
+
+	heap->rememberedCount = 0;
+	heap->nurseryTop = 0;
+	heap->minorCollections++;
+	return true;
+}
+
+int VM_reserve_old(struct VMHeap *heap, size_t required) {
+	if (heap->oldSize - heap->oldTop >= required) {
+		return true;
+	}
+
+	return VM_collect_major(heap, required);
+}
+
+/**
+ * <p>
+ * Collects the old generation with mark-compact.
+ * </p>
+ *
+ * <p>
+ * The objects of the nursery aren't moved, but they are marked as well,
+ * since they can hold the only reference to an old object. The live
+ * objects slide to the start of the old generation (or into a larger
+ * one, if less than half of it would be free afterwards):
+ * 1. Mark all objects, that are reachable from the roots
+ * 2. Compute the new address of every marked old object
+ * 3. Update the references in the roots and the marked objects
+ * 4. Move the objects and rebuild the remembered set
+ * </p>
+ *
+ * @returns True if `required` bytes are free afterwards, false if the heap reached its maximum size
+ *
+ * @param *heap         Heap to collect
+ * @param required      Bytes, that have to be free in the old generation
+ */
+int VM_collect_major(struct VMHeap *heap, size_t required) {
+	size_t live = 0;
+	heap->markCount = 0;
+
+	if ((int)VM_visit_roots(heap, ROOT_MARK) == false) {
+		return false;
+	}
+
+	while (heap->markCount > 0) {
+		struct VMObject *object = heap->markStack[--heap->markCount];
+
+		if ((int)VM_visit_references(heap, object, ROOT_MARK) == false) {
+			return false;
+		}
+	}
+
+	for (size_t offset = 0; offset < heap->oldTop;) {
+		struct VMObject *object = (struct VMObject*)(heap->old + offset);
+		size_t size = VM_OBJECT_SIZE(object->slotCount);
+		live += (object->flags & VM_OBJECT_MARKED) != 0 ? size : 0;
+		offset += size;
+	}
+
+	size_t maxOldSize = heap->maxSize - heap->nurserySize;
+	size_t newSize = heap->oldSize;
+
+	if (live + required > newSize / 2) {
+		newSize = (live + required) * 2 > VM_OLD_GENERATION_SIZE ? (live + required) * 2 : VM_OLD_GENERATION_SIZE;
+		newSize = newSize > maxOldSize ? maxOldSize : newSize;
+	}
+
+	//The marks are removed by the compaction, so it runs even if the space isn't enough
+	int enough = live + required <= newSize ? true : false;
+	unsigned char *target = newSize != heap->oldSize ? (unsigned char*)malloc(newSize) : heap->old;
+
+	if (target == NULL) {
+		target = heap->old;
+		newSize = heap->oldSize;
+		enough = live + required <= newSize ? true : false;
+	}
+
+	size_t newTop = 0;
+
+	for (size_t offset = 0; offset < heap->oldTop;) {
+		struct VMObject *object = (struct VMObject*)(heap->old + offset);
+
+		if ((object->flags & VM_OBJECT_MARKED) != 0) {
+			object->forward = (struct VMObject*)(target + newTop);
+			newTop += VM_OBJECT_SIZE(object->slotCount);
+		}
+
+		offset += VM_OBJECT_SIZE(object->slotCount);
+	}
+
+	(void)VM_visit_roots(heap, ROOT_UPDATE);
+
+	for (size_t offset = 0; offset < heap->oldTop;) {
+		struct VMObject *object = (struct VMObject*)(heap->old + offset);
+
+		if ((object->flags & VM_OBJECT_MARKED) != 0) {
+			(void)VM_visit_references(heap, object, ROOT_UPDATE);
+		}
+
+		offset += VM_OBJECT_SIZE(object->slotCount);
+	}
+
+	for (size_t offset = 0; offset < heap->nurseryTop;) {
+		struct VMObject *object = (struct VMObject*)(heap->nursery + offset);
+
+		if ((object->flags & VM_OBJECT_MARKED) != 0) {
+			(void)VM_visit_references(heap, object, ROOT_UPDATE);
+			object->flags &= ~VM_OBJECT_MARKED;
+		}
+
+		offset += VM_OBJECT_SIZE(object->slotCount);
+	}
+
+	//The new addresses are never behind the old ones, so sliding doesn't overwrite unmoved objects
+	for (size_t offset = 0; offset < heap->oldTop;) {
+		struct VMObject *object = (struct VMObject*)(heap->old + offset);
+		size_t size = VM_OBJECT_SIZE(object->slotCount);
+
+		if ((object->flags & VM_OBJECT_MARKED) != 0) {
+			struct VMObject *moved = object->forward;
+			(void)memmove(moved, object, size);
+			moved->forward = NULL;
+			moved->flags &= ~(VM_OBJECT_MARKED | VM_OBJECT_REMEMBERED);
+		}
+
+		offset += size;
+	}
+
+	if (target != heap->old) {
+		(void)ST_count(COUNTER_BYTES_ALLOCATED, newSize);
+		(void)free(heap->old);
+		heap->old = target;
+		heap->oldSize = newSize;
+	}
+
+	heap->oldTop = newTop;
+	heap->rememberedCount = 0;
+	heap->majorCollections++;
+
+	for (size_t offset = 0; offset < heap->oldTop;) {
+		struct VMObject *object = (struct VMObject*)(heap->old + offset);
+
+		if ((int)VM_has_young_references(heap, object) == true && (int)VM_remember(heap, object) == false) {
+			return false;
+		}
+
+		offset += VM_OBJECT_SIZE(object->slotCount);
+	}
+
+	return enough;
+}
+
+/*
+Purpose: Visit all roots: the reference registers of the active frames, the reference globals and the registered roots
+Return Type: int => false if a marked object can't be pushed, else true
+Params: struct VMHeap *heap => Heap, whose roots are visited;
+		enum VMRootAction action => What is done with the references
+*/
+int VM_visit_roots(struct VMHeap *heap, enum VMRootAction action) {
+	struct VirtualMachine *machine = heap->machine;
+
+	for (size_t i = 0; i < heap->rootCount; i++) {
+		if ((int)VM_visit_slot(heap, heap->roots[i], action) == false) {
+			return false;
+		}
+	}
+
+	if (machine == NULL) {
+		return true;
+	}
+
+	for (size_t i = 0; i < machine->program->globalCount; i++) {
+		if ((int)VM_is_reference_type(machine->program->globals[i].type) == true
+			&& (int)VM_visit_slot(heap, &machine->globals[i], action) == false) {
+			return false;
+		}
+	}
+
+	//The registers of a function keep their type, so one stack map fits all safepoints
+	for (struct VMFrame *frame = machine->frames; machine->activeFrame != NULL && frame <= machine->activeFrame; frame++) {
+		for (int i = 0; i < frame->function->referenceCount; i++) {
+			if ((int)VM_visit_slot(heap, &frame->registers[frame->function->references[i]], action) == false) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+int VM_visit_references(struct VMHeap *heap, struct VMObject *object, enum VMRootAction action) {
+	struct VMClass *vmClass = VM_get_object_class(heap, object);
+	size_t count = vmClass != NULL ? vmClass->referenceCount : object->referenceCount;
+
+	for (size_t i = 0; i < count; i++) {
+		size_t slot = vmClass != NULL ? (size_t)vmClass->referenceSlots[i] : i;
+
+		if ((int)VM_visit_slot(heap, &object->slots[slot], action) == false) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+Purpose: Evacuate, mark or update the object, that a slot references
+Return Type: int => false if a marked object can't be pushed, else true
+Params: struct VMHeap *heap => Heap of the object;
+		union VMValue *slot => Slot with the reference;
+		enum VMRootAction action => What is done with the reference
+*/
+int VM_visit_slot(struct VMHeap *heap, union VMValue *slot, enum VMRootAction action) {
+	struct VMObject *object = slot->object;
+
+	switch (action) {
+	case ROOT_EVACUATE:
+		if ((int)VM_is_young(heap, object) == false) {
+			return true;
+		} else if (object->forward == NULL) {
+			size_t size = VM_OBJECT_SIZE(object->slotCount);
+			struct VMObject *copy = (struct VMObject*)(heap->old + heap->oldTop);
+			(void)memcpy(copy, object, size);
+			copy->flags &= ~(VM_OBJECT_MARKED | VM_OBJECT_REMEMBERED);
+			object->forward = copy;
+			heap->oldTop += size;
+			heap->promotedBytes += size;
+		}
+
+		slot->object = object->forward;
+		return true;
+	case ROOT_MARK:
+		if (((int)VM_is_young(heap, object) == false && (int)VM_is_old(heap, object) == false)
+			|| (object->flags & VM_OBJECT_MARKED) != 0) {
+			return true;
+		}
+
+		object->flags |= VM_OBJECT_MARKED;
+		return VM_push_mark(heap, object);
+	default:
+		if ((int)VM_is_old(heap, object) == true) {
+			slot->object = object->forward;
+		}
+
+		return true;
+	}
+}
+
+int VM_push_mark(struct VMHeap *heap, struct VMObject *object) {
+	if (heap->markCount >= heap->markCapacity) {
+		size_t capacity = heap->markCapacity < 256 ? 256 : heap->markCapacity * 2;
+		struct VMObject **markStack = (struct VMObject**)realloc(heap->markStack, capacity * sizeof(struct VMObject*));
+
+		if (markStack == NULL) {
+			return false;
+		}
+
+		heap->markStack = markStack;
+		heap->markCapacity = capacity;
+	}
+
+	heap->markStack[heap->markCount++] = object;
+	return true;
+}
+
+int VM_has_young_references(struct VMHeap *heap, struct VMObject *object) {
+	struct VMClass *vmClass = VM_get_object_class(heap, object);
+	size_t count = vmClass != NULL ? vmClass->referenceCount : object->referenceCount;
+
+	for (size_t i = 0; i < count; i++) {
+		size_t slot = vmClass != NULL ? (size_t)vmClass->referenceSlots[i] : i;
+
+		if ((int)VM_is_young(heap, object->slots[slot].object) == true) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//Instances of classes are only created by a machine (see VM_create_object)
+struct VMClass *VM_get_object_class(struct VMHeap *heap, struct VMObject *object) {
+	return object->classId >= 0 && heap->machine != NULL ? &heap->machine->program->classes[object->classId] : NULL;
+}
+
+//Small strings have the lowest bit set, objects are aligned
+int VM_is_young(struct VMHeap *heap, struct VMObject *object) {
+	unsigned char *address = (unsigned char*)object;
+	return object != NULL && ((size_t)address & 1) == 0 && address >= heap->nursery && address < heap->nursery + heap->nurseryTop ? true : false;
+}
+
+int VM_is_old(struct VMHeap *heap, struct VMObject *object) {
+	unsigned char *address = (unsigned char*)object;
+	return object != NULL && ((size_t)address & 1) == 0 && heap->old != NULL && address >= heap->old && address < heap->old + heap->oldTop ? true : false;
+}
+
+void FREE_VM_HEAP(struct VMHeap *heap) {
+	if (heap == NULL) {
+		return;
+	}
+
+	(void)free(heap->nursery);
+	(void)free(heap->old);
+	(void)free(heap->remembered);
+	(void)free(heap->roots);
+	(void)free(heap->markStack);
+	(void)free(heap);
+}
@@ -0,0 +1,970 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "../../headers/modules.h"
+#include "../../headers/stats.h"
+#include "../../headers/vm.h"
+
+#if VM_JIT_SUPPORTED == 1
+#include <sys/mman.h>
+#endif
+
+/**
+ * The subprogram {@code SPACE/src/VM/jit.c} was created
+ * to compile hot functions of a running program into machine code.
+ *
+ * The baseline JIT translates the bytecode of a function instruction by
+ * instruction into x86-64 code, there is no register allocation: the
+ * registers of the frame stay in the stack of the VM ([rbx + 8 * r]),
+ * the globals in their array ([r14 + 8 * g]). So the interpreter and the
+ * compiled code see the same state at every instruction, the code can
+ * leave at any instruction and be entered at its entries:
+ * - The compiled code can be entered at the start of the function (call),
+ *   behind a call (return) and at the targets of the jumps (the jumps
+ *   backwards replace a running loop, on-stack replacement).
+ * - Between the entries rax and xmm0 keep the last written register, so
+ *   it isn't loaded again by the next instruction. The stack is always
+ *   written, the interpreter sees every result.
+ * - Instructions, that call, return, allocate or raise, aren't compiled.
+ *   The code returns the index of such an instruction and the interpreter
+ *   continues there, so the compiled code never calls out, never
+ *   allocates and never holds a reference across a safepoint.
+ * - Compiled instructions guard the uncommon cases (a division by zero,
+ *   a conversion, that saturates, a null receiver) and leave the compiled
+ *   code in front of the instruction (deoptimization). A function, that
+ *   deoptimizes too often, is invalidated and only interpreted afterwards.
+ *
+ * Compiled code:
+ * ```
+ * long long code(union VMValue *registers, union VMValue *globals, const void *entry)
+ * ```
+ * returns the index of the instruction, that the interpreter executes next.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Registers of the x86-64 code (the numbers of the encoding)
+#define JIT_RAX 0
+#define JIT_RCX 1
+#define JIT_RBX 3
+#define JIT_R14 6
+
+//Size of an exit (mov eax, index; jmp epilogue)
+#define JIT_EXIT_SIZE 10
+
+//Compiled instructions, that have to follow an entry, so entering the code is faster than interpreting them
+#define JIT_MIN_RUN 4
+
+/**
+ * <p>
+ * Machine code of a function, while it's generated.
+ * </p>
+ *
+ * <p>
+ * Jumps are emitted with a placeholder, that is patched, once the
+ * entries of all instructions are known. A patch holds the position of
+ * the 32 bit displacement, the position, that it's relative to, and the
+ * index of the target instruction.
+ * </p>
+ */
+struct VMJitBuffer {
+	unsigned char *bytes;
+	size_t length;
+	size_t capacity;
+
+	size_t *patches;
+	size_t patchCount;
+	size_t patchCapacity;
+
+	//Registers of the VM, whose values are still held by rax and xmm0 (-1 = none)
+	int integerCache;
+	int doubleCache;
+
+	int failed;
+};
+
+int VM_jit_can_compile(enum VMOpcode opcode);
+void VM_jit_translate_instruction(struct VMJitBuffer *buffer, struct VMFunction *function, size_t index, size_t epilogue);
+void VM_jit_translate_double_comparison(struct VMJitBuffer *buffer, struct VMInstruction *instruction);
+void VM_jit_translate_division(struct VMJitBuffer *buffer, struct VMInstruction *instruction, size_t index, size_t epilogue);
+void VM_jit_translate_switch(struct VMJitBuffer *buffer, struct VMFunction *function, struct VMInstruction *instruction);
+int VM_jit_get_operation(enum VMOpcode opcode);
+void VM_jit_emit(struct VMJitBuffer *buffer, int count, ...);
+void VM_jit_emit_int(struct VMJitBuffer *buffer, long long value, int size);
+void VM_jit_emit_operand(struct VMJitBuffer *buffer, int reg, int base, int slot);
+void VM_jit_emit_load(struct VMJitBuffer *buffer, int reg, int slot);
+void VM_jit_emit_store(struct VMJitBuffer *buffer, int reg, int slot);
+void VM_jit_emit_load_double(struct VMJitBuffer *buffer, int slot);
+void VM_jit_emit_store_double(struct VMJitBuffer *buffer, int slot);
+void VM_jit_forget(struct VMJitBuffer *buffer, int slot);
+void VM_jit_emit_exit(struct VMJitBuffer *buffer, size_t index, size_t epilogue);
+void VM_jit_emit_target(struct VMJitBuffer *buffer, size_t base, int target);
+int VM_jit_patch_targets(struct VMJitBuffer *buffer, size_t *entries, size_t count);
+unsigned char *VM_jit_find_entries(struct VMFunction *function);
+size_t VM_jit_drop_entries(struct VMFunction *function, size_t *entries, unsigned char *isEntry);
+size_t VM_jit_get_run(size_t *runs, size_t index, int target);
+
+/**
+ * <p>
+ * Compiles a function into machine code.
+ * </p>
+ *
+ * <p>
+ * The code is written into a new mapping, that is executable, but not
+ * writable anymore, once the code is in place. A function, that can't
+ * be compiled (no JIT on this platform, no memory left), stays in the
+ * interpreter and is never compiled again.
+ * </p>
+ *
+ * @returns True if the function was compiled, else false
+ *
+ * @param *function Function to compile
+ */
+int VM_jit_compile(struct VMFunction *function) {
+	function->jitState = VM_JIT_FAILED;
+
+#if VM_JIT_SUPPORTED == 1
+	struct VMJitBuffer buffer = {0};
+	buffer.integerCache = -1;
+	buffer.doubleCache = -1;
+	size_t *entries = (size_t*)calloc(function->codeLength + 1, sizeof(size_t));
+	unsigned char *isEntry = VM_jit_find_entries(function);
+
+	if (entries == NULL || isEntry == NULL) {
+		(void)free(entries);
+		(void)free(isEntry);
+		return false;
+	}
+
+	//push rbx; push r14; mov rbx, rdi; mov r14, rsi; jmp rdx
+	(void)VM_jit_emit(&buffer, 11, 0x53, 0x41, 0x56, 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF6, 0xFF, 0xE2);
+
+	//pop r14; pop rbx; ret (rax holds the index of the next instruction)
+	size_t epilogue = buffer.length;
+	(void)VM_jit_emit(&buffer, 4, 0x41, 0x5E, 0x5B, 0xC3);
+
+	for (size_t i = 0; i < function->codeLength; i++) {
+		//The code, that jumps to an entry, holds other values in rax and xmm0
+		if (isEntry[i] == true) {
+			(void)VM_jit_forget(&buffer, -1);
+		}
+
+		entries[i] = buffer.length;
+		(void)VM_jit_translate_instruction(&buffer, function, i, epilogue);
+	}
+
+	//The last instruction leaves the function, this is never reached
+	entries[function->codeLength] = buffer.length;
+	(void)VM_jit_emit_exit(&buffer, function->codeLength, epilogue);
+
+	//A function without a worthwhile entry (e.g. a small recursion) would only pay for the checks
+	if (buffer.failed == true || (int)VM_jit_patch_targets(&buffer, entries, function->codeLength) == false
+		|| VM_jit_drop_entries(function, entries, isEntry) == 0) {
+		(void)free(buffer.bytes);
+		(void)free(buffer.patches);
+		(void)free(entries);
+		(void)free(isEntry);
+		return false;
+	}
+
+	void *code = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (code != MAP_FAILED) {
+		(void)memcpy(code, buffer.bytes, buffer.length);
+
+		if (mprotect(code, buffer.length, PROT_READ | PROT_EXEC) != 0) {
+			(void)munmap(code, buffer.length);
+			code = MAP_FAILED;
+		}
+	}
+
+	(void)free(buffer.bytes);
+	(void)free(buffer.patches);
+	(void)free(isEntry);
+
+	if (code == MAP_FAILED) {
+		(void)free(entries);
+		return false;
+	}
+
+	function->nativeCode = (unsigned char*)code;
+	function->nativeSize = buffer.length;
+	function->nativeEntries = entries;
+	function->jitState = VM_JIT_COMPILED;
+	(void)ST_count(COUNTER_JIT_FUNCTIONS, 1);
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * <p>
+ * Runs the compiled code of a function from an instruction on.
+ * </p>
+ *
+ * <p>
+ * The code runs, until it reaches an instruction, that isn't compiled,
+ * or a guard fails. A failed guard is a deoptimization, after
+ * `VM_JIT_MAX_DEOPTIMIZATIONS` of them the code is invalidated.
+ * </p>
+ *
+ * @returns The index of the instruction, that the interpreter executes next
+ *
+ * @param *function     Compiled function
+ * @param *registers    Registers of the frame
+ * @param *globals      Globals of the machine
+ * @param index         Instruction to start with (its entry isn't 0)
+ */
+size_t VM_jit_execute(struct VMFunction *function, union VMValue *registers, union VMValue *globals, size_t index) {
+#if VM_JIT_SUPPORTED == 1
+	long long (*code)(union VMValue *registers, union VMValue *globals, const void *entry) = NULL;
+	void *address = function->nativeCode;
+
+	//ISO C has no cast from data into function pointers
+	(void)memcpy(&code, &address, sizeof(code));
+	size_t next = (size_t)code(registers, globals, function->nativeCode + function->nativeEntries[index]);
+
+	if (next < function->codeLength && (int)VM_jit_can_compile(function->code[next].opcode) == true) {
+		(void)ST_count(COUNTER_DEOPTIMIZATIONS, 1);
+
+		if (++function->deoptimizations > VM_JIT_MAX_DEOPTIMIZATIONS) {
+			(void)VM_jit_invalidate(function);
+		}
+	}
+
+	return next;
+#else
+	(void)function;
+	(void)registers;
+	(void)globals;
+	return index;
+#endif
+}
+
+/**
+ * <p>
+ * Drops the compiled code of a function, the function is only
+ * interpreted afterwards.
+ * </p>
+ *
+ * <p>
+ * The frames of the function don't point into the code (they hold the
+ * index of their instruction), so they simply continue in the
+ * interpreter. The only assumptions of the code are its guards, so it's
+ * dropped, when they fail too often. The class hierarchy is no
+ * assumption: the program is complete, when it's translated, so the
+ * devirtualized calls of the IR stay valid, and the virtual calls
+ * aren't compiled.
+ * </p>
+ *
+ * @param *function Function, whose code is dropped
+ */
+void VM_jit_invalidate(struct VMFunction *function) {
+#if VM_JIT_SUPPORTED == 1
+	if (function->nativeCode != NULL) {
+		(void)munmap(function->nativeCode, function->nativeSize);
+	}
+#endif
+
+	(void)free(function->nativeEntries);
+	function->nativeCode = NULL;
+	function->nativeSize = 0;
+	function->nativeEntries = NULL;
+	function->jitState = function->jitState == VM_JIT_COMPILED ? VM_JIT_INVALIDATED : function->jitState;
+}
+
+/*
+Purpose: Check whether an opcode is translated into machine code (else the compiled code leaves in front of it)
+Return Type: int => True if the opcode is compiled, else false
+Params: enum VMOpcode opcode => Opcode to check
+*/
+int VM_jit_can_compile(enum VMOpcode opcode) {
+	switch (opcode) {
+	case VM_MOD_DOUBLE:
+	case VM_CONCAT:
+	case VM_BUILDER:
+	case VM_APPEND:
+	case VM_NEW:
+	case VM_NEW_ARRAY:
+	case VM_LOAD_FIELD:
+	case VM_LOAD_FIELD_INT:
+	case VM_LOAD_FIELD_SHORT:
+	case VM_LOAD_FIELD_CHAR:
+	case VM_LOAD_FIELD_FLOAT:
+	case VM_STORE_FIELD:
+	case VM_STORE_FIELD_INT:
+	case VM_STORE_FIELD_SHORT:
+	case VM_STORE_FIELD_CHAR:
+	case VM_STORE_FIELD_FLOAT:
+	case VM_STORE_FIELD_REF:
+	case VM_LOAD_ELEMENT:
+	case VM_LOAD_ELEMENT_UNCHECKED:
+	case VM_STORE_ELEMENT:
+	case VM_STORE_ELEMENT_UNCHECKED:
+	case VM_CALL:
+	case VM_CALL_VIRTUAL:
+	case VM_CALL_INTERFACE:
+	case VM_RETURN:
+	case VM_RETURN_VOID:
+	case VM_RESUME:
+	case VM_COUNT:
+	case VM_OPCODES:
+		return false;
+	default:
+		return true;
+	}
+}
+
+/*
+Purpose: Translate a single instruction, registers are read from and written into the stack of the VM
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the code;
+		struct VMFunction *function => Function of the instruction;
+		size_t index => Index of the instruction;
+		size_t epilogue => Position of the epilogue
+*/
+void VM_jit_translate_instruction(struct VMJitBuffer *buffer, struct VMFunction *function, size_t index, size_t epilogue) {
+	struct VMInstruction *instruction = &function->code[index];
+
+	switch (instruction->opcode) {
+	case VM_LOAD_INT:
+		//mov qword [dest], imm32 (sign extended)
+		(void)VM_jit_emit(buffer, 2, 0x48, 0xC7);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->dest);
+		(void)VM_jit_emit_int(buffer, instruction->a, 4);
+		(void)VM_jit_forget(buffer, instruction->dest);
+		break;
+	case VM_LOAD_CONST:
+		//The constants (and the string literals) never move
+		(void)VM_jit_emit(buffer, 2, 0x48, 0xB8);
+		(void)VM_jit_emit_int(buffer, function->constants[instruction->a].integer, 8);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_MOVE:
+		//A floating result is moved out of xmm0 directly
+		if (buffer->doubleCache == instruction->a && buffer->integerCache != instruction->a) {
+			(void)VM_jit_emit_store_double(buffer, instruction->dest);
+			break;
+		}
+
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_LOAD_GLOBAL:
+		(void)VM_jit_emit(buffer, 2, 0x49, 0x8B);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_R14, instruction->a);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_STORE_GLOBAL:
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->b);
+		(void)VM_jit_emit(buffer, 2, 0x49, 0x89);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_R14, instruction->a);
+		break;
+	case VM_ADD_INT:
+	case VM_SUB_INT:
+	case VM_BIT_AND:
+	case VM_BIT_OR:
+	case VM_BIT_XOR:
+		//op rax, [b] wraps around like the interpreter
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+		(void)VM_jit_emit(buffer, 2, 0x48, VM_jit_get_operation(instruction->opcode));
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->b);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_MUL_INT:
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+		(void)VM_jit_emit(buffer, 3, 0x48, 0x0F, 0xAF);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->b);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_ADD_INT32:
+	case VM_SUB_INT32:
+	case VM_MUL_INT32:
+		//op eax, dword [b]; movsxd rax, eax
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+
+		if (instruction->opcode == VM_MUL_INT32) {
+			(void)VM_jit_emit(buffer, 2, 0x0F, 0xAF);
+		} else {
+			(void)VM_jit_emit(buffer, 1, VM_jit_get_operation(instruction->opcode));
+		}
+
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->b);
+		(void)VM_jit_emit(buffer, 3, 0x48, 0x63, 0xC0);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_DIV_INT:
+	case VM_MOD_INT:
+		(void)VM_jit_translate_division(buffer, instruction, index, epilogue);
+		break;
+	case VM_CHECK_NULL:
+		//mov rcx, [a]; test rcx, rcx; jnz over the exit, the interpreter raises the error
+		(void)VM_jit_emit_load(buffer, JIT_RCX, instruction->a);
+		(void)VM_jit_emit(buffer, 5, 0x48, 0x85, 0xC9, 0x75, JIT_EXIT_SIZE);
+		(void)VM_jit_emit_exit(buffer, index, epilogue);
+		break;
+	case VM_NEG_INT:
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+		(void)VM_jit_emit(buffer, 3, 0x48, 0xF7, 0xD8);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_SHL:
+	case VM_SHR:
+		//The shifts of x86-64 mask the count with 63 themselves
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+		(void)VM_jit_emit_load(buffer, JIT_RCX, instruction->b);
+		(void)VM_jit_emit(buffer, 3, 0x48, 0xD3, instruction->opcode == VM_SHL ? 0xE0 : 0xF8);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_NOT:
+		//xor eax, eax; cmp qword [a], 0; sete al
+		(void)VM_jit_emit(buffer, 4, 0x31, 0xC0, 0x48, 0x83);
+		(void)VM_jit_emit_operand(buffer, 7, JIT_RBX, instruction->a);
+		(void)VM_jit_emit(buffer, 4, 0x00, 0x0F, 0x94, 0xC0);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_ADD_DOUBLE:
+	case VM_SUB_DOUBLE:
+	case VM_MUL_DOUBLE:
+	case VM_DIV_DOUBLE:
+		//movsd xmm0, [a]; op xmm0, [b]; movsd [dest], xmm0
+		(void)VM_jit_emit_load_double(buffer, instruction->a);
+		(void)VM_jit_emit(buffer, 3, 0xF2, 0x0F, VM_jit_get_operation(instruction->opcode));
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->b);
+		(void)VM_jit_emit_store_double(buffer, instruction->dest);
+		break;
+	case VM_NEG_DOUBLE:
+		//btc rax, 63 flips the sign
+		(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+		(void)VM_jit_emit(buffer, 5, 0x48, 0x0F, 0xBA, 0xF8, 0x3F);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_EQ_INT:
+	case VM_NE_INT:
+	case VM_LT_INT:
+	case VM_LE_INT:
+	case VM_GT_INT:
+	case VM_GE_INT:
+		//mov rcx, [a]; xor eax, eax; cmp rcx, [b]; setcc al
+		(void)VM_jit_emit_load(buffer, JIT_RCX, instruction->a);
+		(void)VM_jit_emit(buffer, 4, 0x31, 0xC0, 0x48, 0x3B);
+		(void)VM_jit_emit_operand(buffer, JIT_RCX, JIT_RBX, instruction->b);
+		(void)VM_jit_emit(buffer, 3, 0x0F, VM_jit_get_operation(instruction->opcode), 0xC0);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_EQ_DOUBLE:
+	case VM_NE_DOUBLE:
+	case VM_LT_DOUBLE:
+	case VM_LE_DOUBLE:
+	case VM_GT_DOUBLE:
+	case VM_GE_DOUBLE:
+		(void)VM_jit_translate_double_comparison(buffer, instruction);
+		break;
+	case VM_INT_TO_DOUBLE:
+		//cvtsi2sd xmm0, qword [a]
+		(void)VM_jit_emit(buffer, 4, 0xF2, 0x48, 0x0F, 0x2A);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->a);
+		(void)VM_jit_emit_store_double(buffer, instruction->dest);
+		break;
+	case VM_DOUBLE_TO_INT:
+		//cvttsd2si returns 0x8000000000000000 for NaN and values out of the range, the interpreter saturates them
+		(void)VM_jit_emit(buffer, 4, 0xF2, 0x48, 0x0F, 0x2C);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->a);
+		(void)VM_jit_emit(buffer, 2, 0x48, 0xB9);
+		(void)VM_jit_emit_int(buffer, (long long)(-9223372036854775807LL - 1), 8);
+		(void)VM_jit_emit(buffer, 5, 0x48, 0x39, 0xC8, 0x75, JIT_EXIT_SIZE);
+		(void)VM_jit_emit_exit(buffer, index, epilogue);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_TO_INT:
+	case VM_TO_SHORT:
+	case VM_TO_CHAR:
+		//movsxd / movsx rax, (dword / word / byte) [a]
+		if (instruction->opcode == VM_TO_INT) {
+			(void)VM_jit_emit(buffer, 2, 0x48, 0x63);
+		} else {
+			(void)VM_jit_emit(buffer, 3, 0x48, 0x0F, instruction->opcode == VM_TO_SHORT ? 0xBF : 0xBE);
+		}
+
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->a);
+		(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+		break;
+	case VM_TO_FLOAT:
+		//cvtsd2ss xmm0, [a]; cvtss2sd xmm0, xmm0
+		(void)VM_jit_emit(buffer, 3, 0xF2, 0x0F, 0x5A);
+		(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, instruction->a);
+		(void)VM_jit_emit(buffer, 4, 0xF3, 0x0F, 0x5A, 0xC0);
+		(void)VM_jit_emit_store_double(buffer, instruction->dest);
+		break;
+	case VM_JUMP:
+		(void)VM_jit_emit(buffer, 1, 0xE9);
+		(void)VM_jit_emit_target(buffer, buffer->length + 4, instruction->a);
+		(void)VM_jit_forget(buffer, -1);
+		break;
+	case VM_JUMP_IF_TRUE:
+	case VM_JUMP_IF_FALSE:
+	case VM_BRANCH:
+		//cmp qword [a], 0; jne / je b (the next instruction follows)
+		(void)VM_jit_emit(buffer, 2, 0x48, 0x83);
+		(void)VM_jit_emit_operand(buffer, 7, JIT_RBX, instruction->a);
+		(void)VM_jit_emit(buffer, 3, 0x00, 0x0F, instruction->opcode == VM_JUMP_IF_FALSE ? 0x84 : 0x85);
+		(void)VM_jit_emit_target(buffer, buffer->length + 4, instruction->b);
+
+		if (instruction->opcode == VM_BRANCH) {
+			(void)VM_jit_emit(buffer, 1, 0xE9);
+			(void)VM_jit_emit_target(buffer, buffer->length + 4, instruction->c);
+			(void)VM_jit_forget(buffer, -1);
+		}
+
+		break;
+	case VM_SWITCH:
+		(void)VM_jit_translate_switch(buffer, function, instruction);
+		(void)VM_jit_forget(buffer, -1);
+		break;
+	default:
+		(void)VM_jit_emit_exit(buffer, index, epilogue);
+		(void)VM_jit_forget(buffer, -1);
+		break;
+	}
+}
+
+/*
+Purpose: Translate a comparison of two floating values, NaN is unordered like in the interpreter
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the code;
+		struct VMInstruction *instruction => Comparison
+*/
+void VM_jit_translate_double_comparison(struct VMJitBuffer *buffer, struct VMInstruction *instruction) {
+	enum VMOpcode opcode = instruction->opcode;
+
+	//a < b is compared as b > a, so unordered operands are false for all of them (seta / setae)
+	int swap = opcode == VM_LT_DOUBLE || opcode == VM_LE_DOUBLE ? true : false;
+
+	//xor eax, eax; xor ecx, ecx (in front of the comparison, they change the flags)
+	(void)VM_jit_emit(buffer, 4, 0x31, 0xC0, 0x31, 0xC9);
+	(void)VM_jit_emit_load_double(buffer, swap == true ? instruction->b : instruction->a);
+	(void)VM_jit_emit(buffer, 3, 0x66, 0x0F, 0x2E);
+	(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, swap == true ? instruction->a : instruction->b);
+
+	if (opcode == VM_EQ_DOUBLE) {
+		//sete al; setnp cl; and eax, ecx
+		(void)VM_jit_emit(buffer, 8, 0x0F, 0x94, 0xC0, 0x0F, 0x9B, 0xC1, 0x21, 0xC8);
+	} else if (opcode == VM_NE_DOUBLE) {
+		//setne al; setp cl; or eax, ecx
+		(void)VM_jit_emit(buffer, 8, 0x0F, 0x95, 0xC0, 0x0F, 0x9A, 0xC1, 0x09, 0xC8);
+	} else {
+		(void)VM_jit_emit(buffer, 3, 0x0F, opcode == VM_LT_DOUBLE || opcode == VM_GT_DOUBLE ? 0x97 : 0x93, 0xC0);
+	}
+
+	(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+}
+
+/*
+Purpose: Translate an integer division or modulo, a division by zero leaves the compiled code
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the code;
+		struct VMInstruction *instruction => Division or modulo;
+		size_t index => Index of the instruction;
+		size_t epilogue => Position of the epilogue
+*/
+void VM_jit_translate_division(struct VMJitBuffer *buffer, struct VMInstruction *instruction, size_t index, size_t epilogue) {
+	int modulo = instruction->opcode == VM_MOD_INT ? true : false;
+
+	//mov rcx, [b]; test rcx, rcx; jnz over the exit
+	(void)VM_jit_emit_load(buffer, JIT_RCX, instruction->b);
+	(void)VM_jit_emit(buffer, 5, 0x48, 0x85, 0xC9, 0x75, JIT_EXIT_SIZE);
+	(void)VM_jit_emit_exit(buffer, index, epilogue);
+	(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+
+	//cmp rcx, -1; jne idiv (LLONG_MIN / -1 would trap, -1 negates like in the interpreter)
+	(void)VM_jit_emit(buffer, 6, 0x48, 0x83, 0xF9, 0xFF, 0x75, modulo == true ? 0x04 : 0x05);
+
+	if (modulo == true) {
+		//xor eax, eax; jmp store; cqo; idiv rcx; mov rax, rdx
+		(void)VM_jit_emit(buffer, 12, 0x31, 0xC0, 0xEB, 0x08, 0x48, 0x99, 0x48, 0xF7, 0xF9, 0x48, 0x89, 0xD0);
+	} else {
+		//neg rax; jmp store; cqo; idiv rcx
+		(void)VM_jit_emit(buffer, 10, 0x48, 0xF7, 0xD8, 0xEB, 0x05, 0x48, 0x99, 0x48, 0xF7, 0xF9);
+	}
+
+	(void)VM_jit_emit_store(buffer, JIT_RAX, instruction->dest);
+}
+
+/*
+Purpose: Translate a switch into a bounds check and a table of relative targets
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the code;
+		struct VMFunction *function => Function with the cases;
+		struct VMInstruction *instruction => Switch
+*/
+void VM_jit_translate_switch(struct VMJitBuffer *buffer, struct VMFunction *function, struct VMInstruction *instruction) {
+	//mov rax, [a]; mov rcx, first; sub rax, rcx; cmp rax, count; jae default
+	(void)VM_jit_emit_load(buffer, JIT_RAX, instruction->a);
+	(void)VM_jit_emit(buffer, 2, 0x48, 0xB9);
+	(void)VM_jit_emit_int(buffer, function->constants[instruction->dest].integer, 8);
+	(void)VM_jit_emit(buffer, 5, 0x48, 0x29, 0xC8, 0x48, 0x3D);
+	(void)VM_jit_emit_int(buffer, instruction->c, 4);
+	(void)VM_jit_emit(buffer, 2, 0x0F, 0x83);
+	(void)VM_jit_emit_target(buffer, buffer->length + 4, function->cases[instruction->b]);
+
+	//lea rcx, [rip + table]; movsxd rax, [rcx + rax * 4]; add rax, rcx; jmp rax
+	(void)VM_jit_emit(buffer, 7, 0x48, 0x8D, 0x0D, 0x09, 0x00, 0x00, 0x00);
+	(void)VM_jit_emit(buffer, 9, 0x48, 0x63, 0x04, 0x81, 0x48, 0x01, 0xC8, 0xFF, 0xE0);
+	size_t table = buffer->length;
+
+	for (int i = 0; i < instruction->c; i++) {
+		(void)VM_jit_emit_target(buffer, table, function->cases[instruction->b + 1 + i]);
+	}
+}
+
+/*
+Purpose: Get the byte of an opcode, that differs between the instructions of a group
+Return Type: int => The opcode byte of x86-64 (the operation or the condition of setcc)
+Params: enum VMOpcode opcode => Opcode of the bytecode
+*/
+int VM_jit_get_operation(enum VMOpcode opcode) {
+	switch (opcode) {
+	case VM_ADD_INT: return 0x03;
+	case VM_SUB_INT: return 0x2B;
+	case VM_ADD_INT32: return 0x03;
+	case VM_SUB_INT32: return 0x2B;
+	case VM_BIT_AND: return 0x23;
+	case VM_BIT_OR: return 0x0B;
+	case VM_BIT_XOR: return 0x33;
+	case VM_ADD_DOUBLE: return 0x58;
+	case VM_SUB_DOUBLE: return 0x5C;
+	case VM_MUL_DOUBLE: return 0x59;
+	case VM_DIV_DOUBLE: return 0x5E;
+	case VM_EQ_INT: return 0x94;
+	case VM_NE_INT: return 0x95;
+	case VM_LT_INT: return 0x9C;
+	case VM_LE_INT: return 0x9E;
+	case VM_GT_INT: return 0x9F;
+	case VM_GE_INT: return 0x9D;
+	default: return 0x90;
+	}
+}
+
+/*
+Purpose: Append bytes to the code, the buffer grows by doubling
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the bytes;
+		int count => Number of bytes;
+		... => Bytes (as int)
+*/
+void VM_jit_emit(struct VMJitBuffer *buffer, int count, ...) {
+	if (buffer->length + (size_t)count > buffer->capacity) {
+		size_t capacity = buffer->capacity == 0 ? 256 : buffer->capacity * 2;
+		unsigned char *bytes = (unsigned char*)realloc(buffer->bytes, capacity);
+
+		if (bytes == NULL) {
+			buffer->failed = true;
+			return;
+		}
+
+		buffer->bytes = bytes;
+		buffer->capacity = capacity;
+	}
+
+	va_list arguments;
+	va_start(arguments, count);
+
+	for (int i = 0; i < count; i++) {
+		buffer->bytes[buffer->length++] = (unsigned char)va_arg(arguments, int);
+	}
+
+	va_end(arguments);
+}
+
+/*
+Purpose: Append an immediate value (little endian)
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the value;
+		long long value => Value;
+		int size => Number of bytes (4 or 8)
+*/
+void VM_jit_emit_int(struct VMJitBuffer *buffer, long long value, int size) {
+	for (int i = 0; i < size; i++) {
+		(void)VM_jit_emit(buffer, 1, (int)(((unsigned long long)value >> (8 * i)) & 0xFF));
+	}
+}
+
+/*
+Purpose: Append the memory operand [base + 8 * slot] (ModRM with a 32 bit displacement)
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the operand;
+		int reg => Register (or opcode extension) of the instruction;
+		int base => JIT_RBX (registers) or JIT_R14 (globals, needs REX.B);
+		int slot => Index of the value
+*/
+void VM_jit_emit_operand(struct VMJitBuffer *buffer, int reg, int base, int slot) {
+	(void)VM_jit_emit(buffer, 1, 0x80 | (reg << 3) | base);
+	(void)VM_jit_emit_int(buffer, (long long)slot * (long long)sizeof(union VMValue), 4);
+}
+
+/*
+Purpose: Load a register of the VM into rax or rcx, rax isn't loaded again, if it still holds the register
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the load;
+		int reg => JIT_RAX or JIT_RCX;
+		int slot => Register of the VM
+*/
+void VM_jit_emit_load(struct VMJitBuffer *buffer, int reg, int slot) {
+	if (reg == JIT_RAX && buffer->integerCache == slot) {
+		return;
+	}
+
+	(void)VM_jit_emit(buffer, 2, 0x48, 0x8B);
+	(void)VM_jit_emit_operand(buffer, reg, JIT_RBX, slot);
+	buffer->integerCache = reg == JIT_RAX ? slot : buffer->integerCache;
+}
+
+/*
+Purpose: Store rax into a register of the VM (every instruction, that writes rax, ends with it)
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the store;
+		int reg => JIT_RAX;
+		int slot => Register of the VM
+*/
+void VM_jit_emit_store(struct VMJitBuffer *buffer, int reg, int slot) {
+	(void)VM_jit_emit(buffer, 2, 0x48, 0x89);
+	(void)VM_jit_emit_operand(buffer, reg, JIT_RBX, slot);
+	(void)VM_jit_forget(buffer, slot);
+	buffer->integerCache = slot;
+}
+
+void VM_jit_emit_load_double(struct VMJitBuffer *buffer, int slot) {
+	if (buffer->doubleCache == slot) {
+		return;
+	}
+
+	(void)VM_jit_emit(buffer, 3, 0xF2, 0x0F, 0x10);
+	(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, slot);
+	buffer->doubleCache = slot;
+}
+
+void VM_jit_emit_store_double(struct VMJitBuffer *buffer, int slot) {
+	(void)VM_jit_emit(buffer, 3, 0xF2, 0x0F, 0x11);
+	(void)VM_jit_emit_operand(buffer, JIT_RAX, JIT_RBX, slot);
+	(void)VM_jit_forget(buffer, slot);
+	buffer->doubleCache = slot;
+}
+
+/*
+Purpose: Forget, that rax or xmm0 hold a register of the VM, since it's written (or all of them at an entry)
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer with the cached registers;
+		int slot => Written register of the VM, -1 for all
+*/
+void VM_jit_forget(struct VMJitBuffer *buffer, int slot) {
+	buffer->integerCache = slot == -1 || buffer->integerCache == slot ? -1 : buffer->integerCache;
+	buffer->doubleCache = slot == -1 || buffer->doubleCache == slot ? -1 : buffer->doubleCache;
+}
+
+/*
+Purpose: Append an exit, that returns the index of an instruction to the interpreter
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the exit;
+		size_t index => Instruction, that the interpreter executes next;
+		size_t epilogue => Position of the epilogue
+*/
+void VM_jit_emit_exit(struct VMJitBuffer *buffer, size_t index, size_t epilogue) {
+	(void)VM_jit_emit(buffer, 1, 0xB8);
+	(void)VM_jit_emit_int(buffer, (long long)index, 4);
+	(void)VM_jit_emit(buffer, 1, 0xE9);
+	(void)VM_jit_emit_int(buffer, (long long)epilogue - (long long)(buffer->length + 4), 4);
+}
+
+/*
+Purpose: Append a 32 bit displacement to an instruction, that is patched by VM_jit_patch_targets
+Return Type: void
+Params: struct VMJitBuffer *buffer => Buffer, that receives the displacement;
+		size_t base => Position, that the displacement is relative to;
+		int target => Index of the target instruction
+*/
+void VM_jit_emit_target(struct VMJitBuffer *buffer, size_t base, int target) {
+	if (buffer->patchCount + 3 > buffer->patchCapacity) {
+		size_t capacity = buffer->patchCapacity == 0 ? 48 : buffer->patchCapacity * 2;
+		size_t *patches = (size_t*)realloc(buffer->patches, capacity * sizeof(size_t));
+
+		if (patches == NULL) {
+			buffer->failed = true;
+			return;
+		}
+
+		buffer->patches = patches;
+		buffer->patchCapacity = capacity;
+	}
+
+	buffer->patches[buffer->patchCount++] = buffer->length;
+	buffer->patches[buffer->patchCount++] = base;
+	buffer->patches[buffer->patchCount++] = (size_t)target;
+	(void)VM_jit_emit_int(buffer, 0, 4);
+}
+
+/*
+Purpose: Write the displacements of all jumps, once the entries of the instructions are known
+Return Type: int => True if all targets are instructions of the function, else false
+Params: struct VMJitBuffer *buffer => Buffer with the code;
+		size_t *entries => Position of every instruction;
+		size_t count => Number of instructions
+*/
+int VM_jit_patch_targets(struct VMJitBuffer *buffer, size_t *entries, size_t count) {
+	size_t end = buffer->length;
+
+	for (size_t i = 0; i < buffer->patchCount; i += 3) {
+		size_t position = buffer->patches[i];
+		size_t target = buffer->patches[i + 2];
+
+		if (target >= count) {
+			return false;
+		}
+
+		long long displacement = (long long)entries[target] - (long long)buffer->patches[i + 1];
+		buffer->length = position;
+		(void)VM_jit_emit_int(buffer, displacement, 4);
+	}
+
+	buffer->length = end;
+	return true;
+}
+
+/*
+Purpose: Mark the instructions, where the compiled code can be entered: the start, the targets of the jumps and the returns of the calls
+Return Type: unsigned char * => True for every entry (NULL, if no memory is left)
+Params: struct VMFunction *function => Function to compile
+*/
+unsigned char *VM_jit_find_entries(struct VMFunction *function) {
+	unsigned char *isEntry = (unsigned char*)calloc(function->codeLength + 1, sizeof(unsigned char));
+
+	if (isEntry == NULL) {
+		return NULL;
+	}
+
+	isEntry[0] = true;
+
+	for (size_t i = 0; i < function->codeLength; i++) {
+		struct VMInstruction *instruction = &function->code[i];
+
+		switch (instruction->opcode) {
+		case VM_CALL:
+		case VM_CALL_VIRTUAL:
+		case VM_CALL_INTERFACE:
+			isEntry[i + 1] = true;
+			break;
+		case VM_JUMP:
+			isEntry[instruction->a] = true;
+			break;
+		case VM_JUMP_IF_TRUE:
+		case VM_JUMP_IF_FALSE:
+			isEntry[instruction->b] = true;
+			break;
+		case VM_BRANCH:
+			isEntry[instruction->b] = true;
+			isEntry[instruction->c] = true;
+			break;
+		case VM_SWITCH:
+			for (int n = 0; n <= instruction->c; n++) {
+				isEntry[function->cases[instruction->b + n]] = true;
+			}
+
+			break;
+		default:
+			break;
+		}
+	}
+
+	return isEntry;
+}
+
+/*
+Purpose: Remove the positions of the instructions, that aren't entries or behind which the compiled code leaves again after a few instructions (entering would cost more than it saves)
+Return Type: size_t => Number of the kept entries (0, if no memory is left)
+Params: struct VMFunction *function => Compiled function;
+		size_t *entries => Position of every instruction, the dropped ones become 0;
+		unsigned char *isEntry => Entries of the function (see VM_jit_find_entries)
+*/
+size_t VM_jit_drop_entries(struct VMFunction *function, size_t *entries, unsigned char *isEntry) {
+	//Compiled instructions, that follow an instruction at least (on the shorter path of a branch)
+	size_t *runs = (size_t*)calloc(function->codeLength + 1, sizeof(size_t));
+	size_t kept = 0;
+
+	if (runs == NULL) {
+		return 0;
+	}
+
+	for (size_t i = function->codeLength; i-- > 0;) {
+		struct VMInstruction *instruction = &function->code[i];
+		size_t next = 0;
+
+		switch (instruction->opcode) {
+		case VM_JUMP:
+			next = VM_jit_get_run(runs, i, instruction->a);
+			break;
+		case VM_JUMP_IF_TRUE:
+		case VM_JUMP_IF_FALSE:
+			next = VM_jit_get_run(runs, i, (int)i + 1);
+			next = next < VM_jit_get_run(runs, i, instruction->b) ? next : VM_jit_get_run(runs, i, instruction->b);
+			break;
+		case VM_BRANCH:
+			next = VM_jit_get_run(runs, i, instruction->b);
+			next = next < VM_jit_get_run(runs, i, instruction->c) ? next : VM_jit_get_run(runs, i, instruction->c);
+			break;
+		case VM_SWITCH:
+			next = JIT_MIN_RUN;
+			break;
+		default:
+			next = VM_jit_get_run(runs, i, (int)i + 1);
+			break;
+		}
+
+		runs[i] = (int)VM_jit_can_compile(instruction->opcode) == true ? next + 1 : 0;
+
+		if (isEntry[i] == false || runs[i] < JIT_MIN_RUN) {
+			entries[i] = 0;
+		} else {
+			kept++;
+		}
+	}
+
+	(void)free(runs);
+	return kept;
+}
+
+/*
+Purpose: Get the run of a successor, a jump backwards stays in a compiled loop
+Return Type: size_t => Number of compiled instructions behind the successor
+Params: size_t *runs => Runs of the following instructions;
+		size_t index => Index of the jumping instruction;
+		int target => Index of the successor
+*/
+size_t VM_jit_get_run(size_t *runs, size_t index, int target) {
+	return (size_t)target > index ? runs[target] : JIT_MIN_RUN;
+}
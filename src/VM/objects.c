@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/vm.h"
+
+/**
+ * The subprogram {@code SPACE/src/VM/objects.c} was created
+ * to create the objects and arrays of a running program.
+ *
+ * An object holds one slot for every field of its class (see VMClass),
+ * an array one slot for every element. The elements of a
+ * multidimensional array are arrays, that are allocated together with
+ * it, so a {@code new int[2][3]} creates three arrays. The new slots
+ * are zeroed, which is 0, 0.0, false, null and the empty string.
+ *
+ * Like the string operations every function reads the created objects
+ * through roots, since an allocation can move them.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+/**
+ * <p>
+ * Creates a new object of a class.
+ * </p>
+ *
+ * @returns True if the object was created, false if no memory is left
+ *
+ * @param *machine  Machine, that runs the program (the active frame has to be set)
+ * @param classId   Index of the class in the program
+ * @param *result   Receives the object
+ */
+int VM_create_object(struct VirtualMachine *machine, int classId, union VMValue *result) {
+	struct VMClass *vmClass = &machine->program->classes[classId];
+	struct VMObject *object = VM_allocate_object(machine, vmClass->slotCount, 0);
+
+	if (object == NULL) {
+		return false;
+	}
+
+	object->classId = classId;
+	result->object = object;
+	return true;
+}
+
+/**
+ * <p>
+ * Creates a new array and the arrays of its inner dimensions.
+ * </p>
+ *
+ * <p>
+ * The lengths have to be checked by the caller (none is negative). The
+ * array is a root, while its elements are created, so the collections,
+ * that they trigger, keep it.
+ * </p>
+ *
+ * @returns True if the array was created, false if no memory is left
+ *
+ * @param *machine      Machine, that runs the program (the active frame has to be set)
+ * @param *registers    Registers of the running frame
+ * @param *lengths      Registers with the length of every dimension (outermost first)
+ * @param count         Number of dimensions
+ * @param elementType   Type of the innermost elements
+ * @param *result       Receives the array
+ */
+int VM_create_array(struct VirtualMachine *machine, union VMValue *registers, int *lengths, int count, enum VarType elementType, union VMValue *result) {
+	size_t length = (size_t)registers[lengths[0]].integer;
+	int references = count > 1 || (int)VM_is_reference_type(elementType) == true ? true : false;
+	union VMValue array = {0};
+	array.object = VM_allocate_object(machine, length, references == true ? length : 0);
+
+	if (array.object == NULL) {
+		return false;
+	} else if (count == 1) {
+		*result = array;
+		return true;
+	} else if ((int)VM_heap_push_root(machine->heap, &array) == false) {
+		return false;
+	}
+
+	for (size_t i = 0; i < length; i++) {
+		union VMValue element = {0};
+
+		if ((int)VM_create_array(machine, registers, lengths + 1, count - 1, elementType, &element) == false
+			|| (int)VM_heap_write(machine->heap, array.object, i, element) == false) {
+			(void)VM_heap_pop_roots(machine->heap, 1);
+			return false;
+		}
+	}
+
+	(void)VM_heap_pop_roots(machine->heap, 1);
+	*result = array;
+	return true;
+}
@@ -0,0 +1,357 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../headers/modules.h"
+#include "../../headers/vm.h"
+
+/**
+ * The subprogram {@code SPACE/src/VM/strings.c} was created
+ * to represent the strings of a running program.
+ *
+ * A string value is one of:
+ * - a small string: up to 7 chars in the value itself, the lowest byte
+ *   holds the tag (bit 0) and the length, the chars follow
+ * - a flat string: an object without references, slot 0 holds the
+ *   length, the chars (with a terminating 0) follow in the next slots
+ * - a rope: an object with the two concatenated strings as references,
+ *   followed by the length and the depth of the rope
+ * - NULL: the empty string (cleared registers)
+ *
+ * Long concatenations become ropes, so a concatenation doesn't copy its
+ * operands. The chars of a rope are only collected, once it's written
+ * or too deep. A builder is a flat string with spare space, that is
+ * appended in place (see IR_BUILDER), it grows by doubling.
+ *
+ * Every operation allocates at most once and reads its operands through
+ * the registers after the allocation, since a collection moves them.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+#define VM_ROPE_SLOTS 4
+
+int VM_is_rope(union VMValue value);
+size_t VM_get_rope_depth(union VMValue value);
+size_t VM_get_builder_capacity(struct VMObject *object);
+size_t VM_walk_string(union VMValue value, char *buffer, FILE *output);
+struct VMObject *VM_allocate_flat_string(struct VirtualMachine *machine, size_t capacity);
+
+/**
+ * <p>
+ * Creates a small string, the chars are held in the value itself.
+ * </p>
+ *
+ * @returns The small string
+ *
+ * @param *chars    Chars of the string
+ * @param length    Number of chars (at most VM_SMALL_STRING_LENGTH)
+ */
+union VMValue VM_create_small_string(const char *chars, size_t length) {
+	unsigned long long bits = 1 | (unsigned long long)length << 1;
+	union VMValue value;
+
+	for (size_t i = 0; i < length; i++) {
+		bits |= (unsigned long long)(unsigned char)chars[i] << (8 * (i + 1));
+	}
+
+	value.integer = (long long)bits;
+	return value;
+}
+
+int VM_is_small_string(union VMValue value) {
+	return (value.integer & 1) != 0 ? true : false;
+}
+
+int VM_is_rope(union VMValue value) {
+	return (int)VM_is_small_string(value) == false && value.object != NULL && value.object->referenceCount == 2 ? true : false;
+}
+
+/*
+Purpose: Write the length and the chars into a flat string with enough slots
+Return Type: void
+Params: struct VMObject *object => Object with VM_FLAT_STRING_SLOTS(length) slots or more;
+		const char *chars => Chars of the string;
+		size_t length => Number of chars
+*/
+void VM_init_flat_string(struct VMObject *object, const char *chars, size_t length) {
+	object->slots[0].integer = (long long)length;
+	(void)memcpy(&object->slots[1], chars, length);
+	((char*)&object->slots[1])[length] = '\0';
+}
+
+size_t VM_string_length(union VMValue value) {
+	if ((int)VM_is_small_string(value) == true) {
+		return (size_t)(value.integer >> 1) & 7;
+	} else if (value.object == NULL) {
+		return 0;
+	}
+
+	return (size_t)value.object->slots[(int)VM_is_rope(value) == true ? 2 : 0].integer;
+}
+
+size_t VM_get_rope_depth(union VMValue value) {
+	return (int)VM_is_rope(value) == true ? (size_t)value.object->slots[3].integer : 0;
+}
+
+size_t VM_get_builder_capacity(struct VMObject *object) {
+	return (object->slotCount - 1) * sizeof(union VMValue) - 1;
+}
+
+/**
+ * <p>
+ * Copies the chars of a string into a buffer and terminates them.
+ * </p>
+ *
+ * @returns The number of copied chars
+ *
+ * @param value     String to copy
+ * @param *buffer   Buffer with space for the chars and the terminating 0
+ */
+size_t VM_copy_string(union VMValue value, char *buffer) {
+	size_t length = VM_walk_string(value, buffer, NULL);
+	buffer[length] = '\0';
+	return length;
+}
+
+/**
+ * <p>
+ * Writes the chars of a string, ropes are written piece by piece.
+ * </p>
+ *
+ * @param *output   Stream to write to
+ * @param value     String to write
+ */
+void VM_write_string(FILE *output, union VMValue value) {
+	(void)VM_walk_string(value, NULL, output);
+}
+
+/*
+Purpose: Visit the pieces of a string from the left to the right
+Return Type: size_t => Number of chars of the string
+Params: union VMValue value => String to visit;
+		char *buffer => Receives the chars (can be NULL);
+		FILE *output => Receives the chars (can be NULL)
+*/
+size_t VM_walk_string(union VMValue value, char *buffer, FILE *output) {
+	//Every level of a rope leaves at most its right side on the stack
+	union VMValue pending[VM_MAX_ROPE_DEPTH + 2];
+	size_t pendingCount = 0;
+	size_t length = 0;
+	pending[pendingCount++] = value;
+
+	while (pendingCount > 0) {
+		union VMValue current = pending[--pendingCount];
+		size_t pieceLength = VM_string_length(current);
+		char small[VM_SMALL_STRING_LENGTH + 1];
+		const char *chars = small;
+
+		if (pieceLength == 0) {
+			continue;
+		} else if ((int)VM_is_rope(current) == true) {
+			pending[pendingCount++] = current.object->slots[1];
+			pending[pendingCount++] = current.object->slots[0];
+			continue;
+		} else if ((int)VM_is_small_string(current) == true) {
+			for (size_t i = 0; i < pieceLength; i++) {
+				small[i] = (char)((unsigned long long)current.integer >> (8 * (i + 1)));
+			}
+		} else {
+			chars = (const char*)&current.object->slots[1];
+		}
+
+		if (buffer != NULL) {
+			(void)memcpy(buffer + length, chars, pieceLength);
+		}
+
+		if (output != NULL) {
+			(void)fwrite(chars, 1, pieceLength, output);
+		}
+
+		length += pieceLength;
+	}
+
+	return length;
+}
+
+/**
+ * <p>
+ * Concatenates two strings.
+ * </p>
+ *
+ * <p>
+ * Short results become small strings or flat copies, long ones ropes,
+ * that reference both operands. A rope, that would get deeper than
+ * VM_MAX_ROPE_DEPTH, is flattened instead, so the walks over a rope stay
+ * bounded and the pieces of strings, that are built in a loop without a
+ * builder, are collected once in a while.
+ * </p>
+ *
+ * @returns True if the result was written, false if the heap is full
+ *
+ * @param *machine  Machine, that runs the program (with the active frame set)
+ * @param *a        Register with the first string
+ * @param *b        Register with the second string
+ * @param *result   Register, that receives the concatenation (can be a or b)
+ */
+int VM_concat_strings(struct VirtualMachine *machine, union VMValue *a, union VMValue *b, union VMValue *result) {
+	size_t left = VM_string_length(*a);
+	size_t right = VM_string_length(*b);
+	size_t length = left + right;
+	size_t depth = VM_get_rope_depth(*a) > VM_get_rope_depth(*b) ? VM_get_rope_depth(*a) : VM_get_rope_depth(*b);
+
+	if (right == 0 || left == 0) {
+		*result = right == 0 ? *a : *b;
+		return true;
+	} else if (length <= VM_SMALL_STRING_LENGTH) {
+		char chars[VM_SMALL_STRING_LENGTH + 1];
+		(void)VM_walk_string(*a, chars, NULL);
+		(void)VM_walk_string(*b, chars + left, NULL);
+		*result = VM_create_small_string(chars, length);
+		return true;
+	}
+
+	struct VMObject *object = NULL;
+
+	if (length >= VM_ROPE_MIN_LENGTH && depth < VM_MAX_ROPE_DEPTH) {
+		object = VM_allocate_object(machine, VM_ROPE_SLOTS, 2);
+
+		if (object == NULL) {
+			return false;
+		}
+
+		object->slots[0] = *a;
+		object->slots[1] = *b;
+		object->slots[2].integer = (long long)length;
+		object->slots[3].integer = (long long)depth + 1;
+	} else {
+		object = VM_allocate_flat_string(machine, length);
+
+		if (object == NULL) {
+			return false;
+		}
+
+		char *chars = (char*)&object->slots[1];
+		(void)VM_walk_string(*a, chars, NULL);
+		(void)VM_walk_string(*b, chars + left, NULL);
+		chars[length] = '\0';
+		object->slots[0].integer = (long long)length;
+	}
+
+	result->object = object;
+	return true;
+}
+
+/**
+ * <p>
+ * Creates a builder with a copy of a string.
+ * </p>
+ *
+ * <p>
+ * The builder has space for at least twice the chars of the string, so
+ * the following appends don't allocate. The string itself is never
+ * changed, other registers can still hold it.
+ * </p>
+ *
+ * @returns True if the builder was written, false if the heap is full
+ *
+ * @param *machine  Machine, that runs the program (with the active frame set)
+ * @param *a        Register with the string
+ * @param *result   Register, that receives the builder (can be a)
+ */
+int VM_create_builder(struct VirtualMachine *machine, union VMValue *a, union VMValue *result) {
+	size_t length = VM_string_length(*a);
+	struct VMObject *object = VM_allocate_flat_string(machine, length * 2 > VM_ROPE_MIN_LENGTH ? length * 2 : VM_ROPE_MIN_LENGTH);
+
+	if (object == NULL) {
+		return false;
+	}
+
+	object->flags |= VM_OBJECT_BUILDER;
+	object->slots[0].integer = (long long)VM_copy_string(*a, (char*)&object->slots[1]);
+	result->object = object;
+	return true;
+}
+
+/**
+ * <p>
+ * Appends a string to a builder.
+ * </p>
+ *
+ * <p>
+ * The chars are written behind the chars of the builder, if it has
+ * enough space left. Otherwise a builder with twice the size replaces
+ * it (the old one is collected). A string, that isn't a builder, is
+ * copied into a new builder first.
+ * </p>
+ *
+ * @returns True if the string was appended, false if the heap is full
+ *
+ * @param *machine  Machine, that runs the program (with the active frame set)
+ * @param *builder  Register with the builder, the only register, that holds it
+ * @param *b        Register with the string to append
+ */
+int VM_append_string(struct VirtualMachine *machine, union VMValue *builder, union VMValue *b) {
+	size_t length = VM_string_length(*builder);
+	size_t added = VM_string_length(*b);
+	struct VMObject *object = builder->object;
+
+	if ((int)VM_is_small_string(*builder) == false && object != NULL && (object->flags & VM_OBJECT_BUILDER) != 0
+		&& VM_get_builder_capacity(object) >= length + added) {
+		(void)VM_copy_string(*b, (char*)&object->slots[1] + length);
+		object->slots[0].integer = (long long)(length + added);
+		return true;
+	}
+
+	object = VM_allocate_flat_string(machine, (length + added) * 2 > VM_ROPE_MIN_LENGTH ? (length + added) * 2 : VM_ROPE_MIN_LENGTH);
+
+	if (object == NULL) {
+		return false;
+	}
+
+	char *chars = (char*)&object->slots[1];
+	(void)VM_walk_string(*builder, chars, NULL);
+	(void)VM_copy_string(*b, chars + length);
+	object->flags |= VM_OBJECT_BUILDER;
+	object->slots[0].integer = (long long)(length + added);
+	builder->object = object;
+	return true;
+}
+
+/*
+Purpose: Allocate a flat string with space for a number of chars (and the terminating 0)
+Return Type: struct VMObject * => The string or NULL, if the heap is full
+Params: struct VirtualMachine *machine => Machine, that runs the program;
+		size_t capacity => Number of chars
+*/
+struct VMObject *VM_allocate_flat_string(struct VirtualMachine *machine, size_t capacity) {
+	if (capacity >= VM_MAX_HEAP_SIZE) {
+		return NULL;
+	}
+
+	return VM_allocate_object(machine, VM_FLAT_STRING_SLOTS(capacity), 0);
+}
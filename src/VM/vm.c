@@ -0,0 +1,994 @@
+/////////////////////////////////////////////////////////////
+///////////////////////    LICENSE    ///////////////////////
+/////////////////////////////////////////////////////////////
+/*
+The SPACE-Language compiler compiles an input file into a runnable program.
+Copyright (C) 2024  Lukas Nian En Lampl
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../../headers/modules.h"
+#include "../../headers/errors.h"
+#include "../../headers/stats.h"
+#include "../../headers/ir.h"
+#include "../../headers/optimizer.h"
+#include "../../headers/vm.h"
+#include "../../headers/lineindex.h"
+
+/**
+ * The subprogram {@code SPACE/src/VM/vm.c} was created
+ * to execute the bytecode of a program.
+ *
+ * The interpreter is direct-threaded: every instruction holds the
+ * address of its handler and every handler jumps straight to the
+ * handler of the next instruction (computed goto), so there is no
+ * central dispatch branch. The registers of all frames lie on one
+ * preallocated stack, a call only moves the register window.
+ * A runtime error unwinds the frames until an exception table
+ * (see VMExceptionRange) holds the raising instruction.
+ *
+ * Calls and jumps backwards count, how hot a function is. A hot
+ * function is compiled into machine code (see jit.c), which runs on the
+ * same registers: it's entered by its calls, by the returns into it and
+ * by the jumps backwards of a running loop, and it hands the
+ * instructions, that it doesn't compile, back to the interpreter.
+ *
+ * @version 1.0     18.10.2026
+ * @author Lukas Nian En Lampl
+*/
+
+#define true 1
+#define false 0
+
+//Stream for the IR dump (--dump-ir) of the profiled module
+extern FILE *IR_DUMP;
+extern char *FILE_NAME;
+extern char **BUFFER;
+extern struct LineIndex *LINE_INDEX;
+
+#if VM_THREADED_DISPATCH == 1
+#define VM_CASE(opcode) VM_LABEL_##opcode:
+#define VM_DISPATCH() do { executed++; goto *pc->handler; } while (0)
+#else
+#define VM_CASE(opcode) case opcode:
+#define VM_DISPATCH() do { executed++; goto VM_LABEL_DISPATCH; } while (0)
+#endif
+
+#define VM_NEXT() do { pc++; VM_DISPATCH(); } while (0)
+
+//A jump backwards ends an iteration of a loop, so it counts towards the compilation of the function
+#define VM_JUMP_TO(target) do { struct VMInstruction *next = (target); \
+	if (next <= pc && jit == true) { pc = next; goto VM_LABEL_BACK_EDGE; } \
+	pc = next; VM_DISPATCH(); } while (0)
+
+//Registers of the running instruction
+#define R_DEST registers[pc->dest]
+#define R_A registers[pc->a]
+#define R_B registers[pc->b]
+
+//Field at a byte of the slots of an object (see VMClass)
+#define VM_FIELD(object, offset, type) (*(type*)((char*)(object)->slots + (offset)))
+
+//Integer arithmetic wraps around (like the unsigned arithmetic of C)
+#define VM_WRAP(a, operator, b) ((long long)((unsigned long long)(a) operator (unsigned long long)(b)))
+
+long long VM_double_to_integer(double value);
+void VM_report_runtime_error(enum DiagnosticCode code, struct VMProgram *program, struct VMFunction *function, struct VMInstruction *pc, const char *problem);
+const char *VM_get_runtime_error_name(enum DiagnosticCode code);
+
+/**
+ * <p>
+ * Creates a virtual machine for a program.
+ * </p>
+ * 
+ * <p>
+ * The stack and the frames are allocated once, so the calls of the
+ * program don't allocate anything.
+ * </p>
+ * 
+ * @returns The virtual machine or NULL, if no memory is left
+ * 
+ * @param *program  Program to execute
+ */
+struct VirtualMachine *CreateNewVirtualMachine(struct VMProgram *program) {
+	struct VirtualMachine *machine = (struct VirtualMachine*)calloc(1, sizeof(struct VirtualMachine));
+
+	if (machine == NULL) {
+		return NULL;
+	}
+
+	machine->program = program;
+	machine->stackSize = VM_STACK_SIZE;
+	machine->maxFrames = VM_MAX_FRAMES;
+	machine->globals = (union VMValue*)calloc(program->globalCount == 0 ? 1 : program->globalCount, sizeof(union VMValue));
+	machine->stack = (union VMValue*)calloc(machine->stackSize, sizeof(union VMValue));
+	machine->frames = (struct VMFrame*)calloc(machine->maxFrames, sizeof(struct VMFrame));
+
+	if (machine->globals == NULL || machine->stack == NULL || machine->frames == NULL) {
+		(void)FREE_VIRTUAL_MACHINE(machine);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < program->globalCount; i++) {
+		if (program->globals[i].type == STRING) {
+			machine->globals[i] = VM_create_small_string("", 0);
+		}
+	}
+
+	return machine;
+}
+
+//The handler addresses (&&label) and `goto *` are GNU extensions
+#if VM_THREADED_DISPATCH == 1
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+/**
+ * <p>
+ * Executes the entry function of the program.
+ * </p>
+ * 
+ * <p>
+ * On the first run the handler addresses are written into the
+ * instructions (threaded code). A runtime error (e.g. a division by zero)
+ * continues at the landing pad of the innermost try statement, that
+ * encloses the raising instruction or one of the active calls. Without
+ * such a try statement it is reported as diagnostic and stops the program.
+ * </p>
+ * 
+ * <p>
+ * If the program has the JIT turned on, hot functions are compiled and
+ * run as machine code, until they reach an instruction, that is left to
+ * the interpreter (a call, a return, a string operation or a failed
+ * guard). Only the interpreted instructions are counted.
+ * </p>
+ * 
+ * @returns PHASE_SUCCESS if the program finished, PHASE_ERRORS on a runtime error
+ * 
+ * @param *machine  Virtual machine with the program
+ * @param *result   Receives the return value of the entry function (can be NULL)
+ */
+int VM_run(struct VirtualMachine *machine, union VMValue *result) {
+	struct VMProgram *program = machine->program;
+
+#if VM_THREADED_DISPATCH == 1
+	static const void *handlers[VM_OPCODES] = {
+		&&VM_LABEL_VM_LOAD_INT, &&VM_LABEL_VM_LOAD_CONST, &&VM_LABEL_VM_MOVE, &&VM_LABEL_VM_LOAD_GLOBAL, &&VM_LABEL_VM_STORE_GLOBAL,
+		&&VM_LABEL_VM_ADD_INT, &&VM_LABEL_VM_SUB_INT, &&VM_LABEL_VM_MUL_INT, &&VM_LABEL_VM_DIV_INT, &&VM_LABEL_VM_MOD_INT, &&VM_LABEL_VM_NEG_INT,
+		&&VM_LABEL_VM_ADD_INT32, &&VM_LABEL_VM_SUB_INT32, &&VM_LABEL_VM_MUL_INT32,
+		&&VM_LABEL_VM_SHL, &&VM_LABEL_VM_SHR, &&VM_LABEL_VM_BIT_AND, &&VM_LABEL_VM_BIT_OR, &&VM_LABEL_VM_BIT_XOR, &&VM_LABEL_VM_NOT,
+		&&VM_LABEL_VM_ADD_DOUBLE, &&VM_LABEL_VM_SUB_DOUBLE, &&VM_LABEL_VM_MUL_DOUBLE, &&VM_LABEL_VM_DIV_DOUBLE, &&VM_LABEL_VM_MOD_DOUBLE, &&VM_LABEL_VM_NEG_DOUBLE,
+		&&VM_LABEL_VM_EQ_INT, &&VM_LABEL_VM_NE_INT, &&VM_LABEL_VM_LT_INT, &&VM_LABEL_VM_LE_INT, &&VM_LABEL_VM_GT_INT, &&VM_LABEL_VM_GE_INT,
+		&&VM_LABEL_VM_EQ_DOUBLE, &&VM_LABEL_VM_NE_DOUBLE, &&VM_LABEL_VM_LT_DOUBLE, &&VM_LABEL_VM_LE_DOUBLE, &&VM_LABEL_VM_GT_DOUBLE, &&VM_LABEL_VM_GE_DOUBLE,
+		&&VM_LABEL_VM_INT_TO_DOUBLE, &&VM_LABEL_VM_DOUBLE_TO_INT, &&VM_LABEL_VM_TO_INT, &&VM_LABEL_VM_TO_SHORT, &&VM_LABEL_VM_TO_CHAR, &&VM_LABEL_VM_TO_FLOAT,
+		&&VM_LABEL_VM_CONCAT, &&VM_LABEL_VM_BUILDER, &&VM_LABEL_VM_APPEND,
+		&&VM_LABEL_VM_NEW, &&VM_LABEL_VM_NEW_ARRAY,
+		&&VM_LABEL_VM_LOAD_FIELD, &&VM_LABEL_VM_LOAD_FIELD_INT, &&VM_LABEL_VM_LOAD_FIELD_SHORT, &&VM_LABEL_VM_LOAD_FIELD_CHAR, &&VM_LABEL_VM_LOAD_FIELD_FLOAT,
+		&&VM_LABEL_VM_STORE_FIELD, &&VM_LABEL_VM_STORE_FIELD_INT, &&VM_LABEL_VM_STORE_FIELD_SHORT, &&VM_LABEL_VM_STORE_FIELD_CHAR, &&VM_LABEL_VM_STORE_FIELD_FLOAT,
+		&&VM_LABEL_VM_STORE_FIELD_REF,
+		&&VM_LABEL_VM_LOAD_ELEMENT, &&VM_LABEL_VM_LOAD_ELEMENT_UNCHECKED, &&VM_LABEL_VM_STORE_ELEMENT, &&VM_LABEL_VM_STORE_ELEMENT_UNCHECKED,
+		&&VM_LABEL_VM_CHECK_NULL,
+		&&VM_LABEL_VM_CALL, &&VM_LABEL_VM_CALL_VIRTUAL, &&VM_LABEL_VM_CALL_INTERFACE, &&VM_LABEL_VM_JUMP, &&VM_LABEL_VM_JUMP_IF_TRUE, &&VM_LABEL_VM_JUMP_IF_FALSE, &&VM_LABEL_VM_BRANCH, &&VM_LABEL_VM_SWITCH, &&VM_LABEL_VM_RETURN, &&VM_LABEL_VM_RETURN_VOID,
+		&&VM_LABEL_VM_RESUME, &&VM_LABEL_VM_COUNT
+	};
+
+	if (program->threaded == false) {
+		for (size_t i = 0; i < program->functionCount; i++) {
+			struct VMFunction *function = &program->functions[i];
+
+			for (size_t n = 0; n < function->codeLength; n++) {
+				function->code[n].handler = handlers[function->code[n].opcode];
+			}
+		}
+
+		program->threaded = true;
+	}
+#endif
+
+	struct VMFunction *function = &program->functions[program->entryFunction];
+	struct VMFrame *frame = machine->frames;
+	struct VMFrame *lastFrame = machine->frames + machine->maxFrames - 1;
+	union VMValue *stackEnd = machine->stack + machine->stackSize;
+	union VMValue *globals = machine->globals;
+	union VMValue *registers = machine->stack;
+	union VMValue *constants = function->constants;
+	struct VMInstruction *pc = function->code;
+	union VMValue value = {0};
+	struct VMFunction *callee = NULL;
+	struct VMObject *object = NULL;
+	size_t executed = 0;
+	int jit = program->jit;
+
+	//Last raised runtime error, a resume raises it again
+	enum DiagnosticCode error = DIAG_VM_DIVISION_BY_ZERO;
+	struct VMFunction *errorFunction = function;
+	struct VMInstruction *errorPc = pc;
+
+	if (function->codeLength == 0) {
+		return PHASE_SUCCESS;
+	} else if (registers + function->registerCount > stackEnd) {
+		//There is no frame to unwind yet
+		(void)VM_report_runtime_error(DIAG_VM_STACK_OVERFLOW, program, function, pc, "Stack overflow");
+		return PHASE_ERRORS;
+	}
+
+	frame->function = function;
+	frame->returnAddress = NULL;
+	frame->registers = registers;
+	frame->result = IR_NO_REGISTER;
+
+	for (int i = 0; i < function->referenceCount; i++) {
+		registers[function->references[i]].object = NULL;
+	}
+
+	VM_DISPATCH();
+
+#if VM_THREADED_DISPATCH == 0
+VM_LABEL_DISPATCH:
+	switch (pc->opcode) {
+#endif
+	VM_CASE(VM_LOAD_INT)
+		R_DEST.integer = pc->a;
+		VM_NEXT();
+	VM_CASE(VM_LOAD_CONST)
+		R_DEST = constants[pc->a];
+		VM_NEXT();
+	VM_CASE(VM_MOVE)
+		R_DEST = R_A;
+		VM_NEXT();
+	VM_CASE(VM_LOAD_GLOBAL)
+		R_DEST = globals[pc->a];
+		VM_NEXT();
+	VM_CASE(VM_STORE_GLOBAL)
+		globals[pc->a] = R_B;
+		VM_NEXT();
+	VM_CASE(VM_ADD_INT)
+		R_DEST.integer = VM_WRAP(R_A.integer, +, R_B.integer);
+		VM_NEXT();
+	VM_CASE(VM_SUB_INT)
+		R_DEST.integer = VM_WRAP(R_A.integer, -, R_B.integer);
+		VM_NEXT();
+	VM_CASE(VM_MUL_INT)
+		R_DEST.integer = VM_WRAP(R_A.integer, *, R_B.integer);
+		VM_NEXT();
+	VM_CASE(VM_DIV_INT)
+		if (R_B.integer == 0) {
+			goto VM_LABEL_DIVISION_BY_ZERO;
+		}
+
+		//LLONG_MIN / -1 overflows, so -1 is handled as negation
+		R_DEST.integer = R_B.integer == -1 ? VM_WRAP(0, -, R_A.integer) : R_A.integer / R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_MOD_INT)
+		if (R_B.integer == 0) {
+			goto VM_LABEL_DIVISION_BY_ZERO;
+		}
+
+		R_DEST.integer = R_B.integer == -1 ? 0 : R_A.integer % R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_NEG_INT)
+		R_DEST.integer = VM_WRAP(0, -, R_A.integer);
+		VM_NEXT();
+	VM_CASE(VM_ADD_INT32)
+		R_DEST.integer = (int)VM_WRAP(R_A.integer, +, R_B.integer);
+		VM_NEXT();
+	VM_CASE(VM_SUB_INT32)
+		R_DEST.integer = (int)VM_WRAP(R_A.integer, -, R_B.integer);
+		VM_NEXT();
+	VM_CASE(VM_MUL_INT32)
+		R_DEST.integer = (int)VM_WRAP(R_A.integer, *, R_B.integer);
+		VM_NEXT();
+	VM_CASE(VM_SHL)
+		R_DEST.integer = (long long)((unsigned long long)R_A.integer << (R_B.integer & 63));
+		VM_NEXT();
+	VM_CASE(VM_SHR)
+		R_DEST.integer = R_A.integer >> (R_B.integer & 63);
+		VM_NEXT();
+	VM_CASE(VM_BIT_AND)
+		R_DEST.integer = R_A.integer & R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_BIT_OR)
+		R_DEST.integer = R_A.integer | R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_BIT_XOR)
+		R_DEST.integer = R_A.integer ^ R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_NOT)
+		R_DEST.integer = R_A.integer == 0;
+		VM_NEXT();
+	VM_CASE(VM_ADD_DOUBLE)
+		R_DEST.floating = R_A.floating + R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_SUB_DOUBLE)
+		R_DEST.floating = R_A.floating - R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_MUL_DOUBLE)
+		R_DEST.floating = R_A.floating * R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_DIV_DOUBLE)
+		R_DEST.floating = R_A.floating / R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_MOD_DOUBLE)
+		R_DEST.floating = fmod(R_A.floating, R_B.floating);
+		VM_NEXT();
+	VM_CASE(VM_NEG_DOUBLE)
+		R_DEST.floating = -R_A.floating;
+		VM_NEXT();
+	VM_CASE(VM_EQ_INT)
+		R_DEST.integer = R_A.integer == R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_NE_INT)
+		R_DEST.integer = R_A.integer != R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_LT_INT)
+		R_DEST.integer = R_A.integer < R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_LE_INT)
+		R_DEST.integer = R_A.integer <= R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_GT_INT)
+		R_DEST.integer = R_A.integer > R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_GE_INT)
+		R_DEST.integer = R_A.integer >= R_B.integer;
+		VM_NEXT();
+	VM_CASE(VM_EQ_DOUBLE)
+		R_DEST.integer = R_A.floating == R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_NE_DOUBLE)
+		R_DEST.integer = R_A.floating != R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_LT_DOUBLE)
+		R_DEST.integer = R_A.floating < R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_LE_DOUBLE)
+		R_DEST.integer = R_A.floating <= R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_GT_DOUBLE)
+		R_DEST.integer = R_A.floating > R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_GE_DOUBLE)
+		R_DEST.integer = R_A.floating >= R_B.floating;
+		VM_NEXT();
+	VM_CASE(VM_INT_TO_DOUBLE)
+		R_DEST.floating = (double)R_A.integer;
+		VM_NEXT();
+	VM_CASE(VM_DOUBLE_TO_INT)
+		R_DEST.integer = VM_double_to_integer(R_A.floating);
+		VM_NEXT();
+	VM_CASE(VM_TO_INT)
+		R_DEST.integer = (int)R_A.integer;
+		VM_NEXT();
+	VM_CASE(VM_TO_SHORT)
+		R_DEST.integer = (short)R_A.integer;
+		VM_NEXT();
+	VM_CASE(VM_TO_CHAR)
+		R_DEST.integer = (char)R_A.integer;
+		VM_NEXT();
+	VM_CASE(VM_TO_FLOAT)
+		R_DEST.floating = (double)(float)R_A.floating;
+		VM_NEXT();
+	VM_CASE(VM_CONCAT)
+		//The heap visits the frames up to the active one
+		machine->activeFrame = frame;
+
+		if ((int)VM_concat_strings(machine, &R_A, &R_B, &R_DEST) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_BUILDER)
+		machine->activeFrame = frame;
+
+		if ((int)VM_create_builder(machine, &R_A, &R_DEST) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_APPEND)
+		machine->activeFrame = frame;
+
+		if ((int)VM_append_string(machine, &R_DEST, &R_B) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_NEW)
+		machine->activeFrame = frame;
+
+		if ((int)VM_create_object(machine, pc->a, &R_DEST) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_NEW_ARRAY)
+		for (int i = 0; i < pc->c; i++) {
+			if (registers[function->arguments[pc->b + i]].integer < 0) {
+				goto VM_LABEL_NEGATIVE_ARRAY_LENGTH;
+			}
+		}
+
+		machine->activeFrame = frame;
+
+		if ((int)VM_create_array(machine, registers, function->arguments + pc->b, pc->c, (enum VarType)pc->a, &R_DEST) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_LOAD_FIELD)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		R_DEST = VM_FIELD(R_A.object, pc->b, union VMValue);
+		VM_NEXT();
+	VM_CASE(VM_LOAD_FIELD_INT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		R_DEST.integer = VM_FIELD(R_A.object, pc->b, int);
+		VM_NEXT();
+	VM_CASE(VM_LOAD_FIELD_SHORT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		R_DEST.integer = VM_FIELD(R_A.object, pc->b, short);
+		VM_NEXT();
+	VM_CASE(VM_LOAD_FIELD_CHAR)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		R_DEST.integer = VM_FIELD(R_A.object, pc->b, char);
+		VM_NEXT();
+	VM_CASE(VM_LOAD_FIELD_FLOAT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		R_DEST.floating = (double)VM_FIELD(R_A.object, pc->b, float);
+		VM_NEXT();
+	VM_CASE(VM_STORE_FIELD)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		VM_FIELD(R_A.object, pc->b, union VMValue) = registers[pc->c];
+		VM_NEXT();
+	VM_CASE(VM_STORE_FIELD_INT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		VM_FIELD(R_A.object, pc->b, int) = (int)registers[pc->c].integer;
+		VM_NEXT();
+	VM_CASE(VM_STORE_FIELD_SHORT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		VM_FIELD(R_A.object, pc->b, short) = (short)registers[pc->c].integer;
+		VM_NEXT();
+	VM_CASE(VM_STORE_FIELD_CHAR)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		VM_FIELD(R_A.object, pc->b, char) = (char)registers[pc->c].integer;
+		VM_NEXT();
+	VM_CASE(VM_STORE_FIELD_FLOAT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		VM_FIELD(R_A.object, pc->b, float) = (float)registers[pc->c].floating;
+		VM_NEXT();
+	VM_CASE(VM_STORE_FIELD_REF)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		} else if ((int)VM_write_barrier(machine->heap, R_A.object, registers[pc->c].object) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_FIELD(R_A.object, pc->b, union VMValue) = registers[pc->c];
+		VM_NEXT();
+	VM_CASE(VM_LOAD_ELEMENT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		} else if ((unsigned long long)R_B.integer >= R_A.object->slotCount) {
+			goto VM_LABEL_INDEX_OUT_OF_BOUNDS;
+		}
+
+		R_DEST = R_A.object->slots[R_B.integer];
+		VM_NEXT();
+	VM_CASE(VM_LOAD_ELEMENT_UNCHECKED)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		R_DEST = R_A.object->slots[R_B.integer];
+		VM_NEXT();
+	VM_CASE(VM_STORE_ELEMENT)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		} else if ((unsigned long long)R_B.integer >= R_A.object->slotCount) {
+			goto VM_LABEL_INDEX_OUT_OF_BOUNDS;
+		} else if ((int)VM_heap_write(machine->heap, R_A.object, (size_t)R_B.integer, registers[pc->c]) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_STORE_ELEMENT_UNCHECKED)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		} else if ((int)VM_heap_write(machine->heap, R_A.object, (size_t)R_B.integer, registers[pc->c]) == false) {
+			goto VM_LABEL_OUT_OF_MEMORY;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_CHECK_NULL)
+		if (R_A.object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		VM_NEXT();
+	VM_CASE(VM_CALL_VIRTUAL)
+		//The receiver is the first argument
+		object = registers[function->arguments[pc->b]].object;
+
+		if (object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		callee = &program->functions[program->classes[object->classId].vtable[pc->a]];
+		goto VM_LABEL_CALL;
+	VM_CASE(VM_CALL_INTERFACE)
+		object = registers[function->arguments[pc->b]].object;
+
+		if (object == NULL) {
+			goto VM_LABEL_NULL_REFERENCE;
+		}
+
+		callee = &program->functions[program->classes[object->classId].vtable[program->classes[object->classId].interfaceSlots[pc->a]]];
+		goto VM_LABEL_CALL;
+	VM_CASE(VM_CALL)
+		callee = &program->functions[pc->a];
+
+VM_LABEL_CALL: {
+		union VMValue *calleeRegisters = registers + function->registerCount;
+
+		if (frame == lastFrame || calleeRegisters + callee->registerCount > stackEnd) {
+			goto VM_LABEL_STACK_OVERFLOW;
+		}
+
+		//Reference registers can hold stale values of former frames, the collector would follow them
+		for (int i = 0; i < callee->referenceCount; i++) {
+			calleeRegisters[callee->references[i]].object = NULL;
+		}
+
+		for (int i = 0; i < pc->c; i++) {
+			calleeRegisters[i] = registers[function->arguments[pc->b + i]];
+		}
+
+		frame->returnAddress = pc + 1;
+		frame++;
+		frame->function = callee;
+		frame->registers = calleeRegisters;
+		frame->result = pc->dest;
+		function = callee;
+		registers = calleeRegisters;
+		constants = callee->constants;
+		pc = callee->code;
+
+		if (jit == true && (callee->jitState == VM_JIT_COMPILED || ++callee->calls == VM_JIT_CALL_THRESHOLD)) {
+			goto VM_LABEL_TIER_UP;
+		}
+
+		VM_DISPATCH();
+	}
+	VM_CASE(VM_JUMP)
+		VM_JUMP_TO(function->code + pc->a);
+	VM_CASE(VM_JUMP_IF_TRUE)
+		VM_JUMP_TO(R_A.integer != 0 ? function->code + pc->b : pc + 1);
+	VM_CASE(VM_JUMP_IF_FALSE)
+		VM_JUMP_TO(R_A.integer == 0 ? function->code + pc->b : pc + 1);
+	VM_CASE(VM_BRANCH)
+		VM_JUMP_TO(function->code + (R_A.integer != 0 ? pc->b : pc->c));
+	VM_CASE(VM_SWITCH) {
+		//A value below the first case wraps around and is too large as well
+		unsigned long long index = (unsigned long long)R_A.integer - (unsigned long long)constants[pc->dest].integer;
+		pc = function->code + function->cases[pc->b + (index < (unsigned long long)pc->c ? (int)index + 1 : 0)];
+		VM_DISPATCH();
+	}
+	VM_CASE(VM_RETURN)
+		value = R_A;
+		goto VM_LABEL_LEAVE;
+	VM_CASE(VM_RETURN_VOID)
+		value.integer = 0;
+		goto VM_LABEL_LEAVE;
+	VM_CASE(VM_RESUME)
+		goto VM_LABEL_UNWIND;
+	VM_CASE(VM_COUNT)
+		function->blockCounts[pc->a]++;
+		VM_NEXT();
+#if VM_THREADED_DISPATCH == 0
+	default:
+		goto VM_LABEL_LEAVE;
+	}
+#endif
+
+VM_LABEL_LEAVE:
+	if (frame == machine->frames) {
+		if (result != NULL) {
+			*result = value;
+		}
+
+		machine->executedInstructions += executed;
+		return PHASE_SUCCESS;
+	} else {
+		int target = frame->result;
+		frame--;
+		function = frame->function;
+		registers = frame->registers;
+		constants = function->constants;
+		pc = frame->returnAddress;
+
+		if (target != IR_NO_REGISTER) {
+			registers[target] = value;
+		}
+
+		if (jit == true && function->jitState == VM_JIT_COMPILED) {
+			goto VM_LABEL_TIER_UP;
+		}
+
+		VM_DISPATCH();
+	}
+
+VM_LABEL_BACK_EDGE:
+	if (function->jitState != VM_JIT_COMPILED && ++function->backEdges != VM_JIT_BACK_EDGE_THRESHOLD) {
+		VM_DISPATCH();
+	}
+
+	//The compiled code continues at the instruction of pc (on-stack replacement inside of a loop)
+VM_LABEL_TIER_UP:
+	if (function->jitState == VM_JIT_INTERPRETED) {
+		(void)VM_jit_compile(function);
+	}
+
+	if (function->jitState == VM_JIT_COMPILED && function->nativeEntries[pc - function->code] != 0) {
+		pc = function->code + VM_jit_execute(function, registers, globals, (size_t)(pc - function->code));
+	}
+
+	VM_DISPATCH();
+
+VM_LABEL_DIVISION_BY_ZERO:
+	error = DIAG_VM_DIVISION_BY_ZERO;
+	errorFunction = function;
+	errorPc = pc;
+	goto VM_LABEL_UNWIND;
+
+VM_LABEL_STACK_OVERFLOW:
+	error = DIAG_VM_STACK_OVERFLOW;
+	errorFunction = function;
+	errorPc = pc;
+	goto VM_LABEL_UNWIND;
+
+VM_LABEL_OUT_OF_MEMORY:
+	error = DIAG_VM_OUT_OF_MEMORY;
+	errorFunction = function;
+	errorPc = pc;
+	goto VM_LABEL_UNWIND;
+
+VM_LABEL_NULL_REFERENCE:
+	error = DIAG_VM_NULL_REFERENCE;
+	errorFunction = function;
+	errorPc = pc;
+	goto VM_LABEL_UNWIND;
+
+VM_LABEL_INDEX_OUT_OF_BOUNDS:
+	error = DIAG_VM_INDEX_OUT_OF_BOUNDS;
+	errorFunction = function;
+	errorPc = pc;
+	goto VM_LABEL_UNWIND;
+
+VM_LABEL_NEGATIVE_ARRAY_LENGTH:
+	error = DIAG_VM_NEGATIVE_ARRAY_LENGTH;
+	errorFunction = function;
+	errorPc = pc;
+	goto VM_LABEL_UNWIND;
+
+VM_LABEL_UNWIND:
+	//The exception tables are only searched on an error, the normal path doesn't pay for them
+	for (;;) {
+		size_t index = (size_t)(pc - function->code);
+
+		for (size_t i = 0; i < function->exceptionRangeCount; i++) {
+			struct VMExceptionRange *range = &function->exceptionRanges[i];
+
+			if (index >= range->start && index < range->end) {
+				pc = function->code + range->landingPad;
+				VM_DISPATCH();
+			}
+		}
+
+		if (frame == machine->frames) {
+			break;
+		}
+
+		//The caller is still at its call instruction
+		frame--;
+		function = frame->function;
+		registers = frame->registers;
+		constants = function->constants;
+		pc = frame->returnAddress - 1;
+	}
+
+	(void)VM_report_runtime_error(error, program, errorFunction, errorPc, VM_get_runtime_error_name(error));
+	machine->executedInstructions += executed;
+	return PHASE_ERRORS;
+}
+
+#if VM_THREADED_DISPATCH == 1
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * <p>
+ * Converts a floating value into an integer, values out of the range
+ * are saturated and NaN becomes 0 (the C cast would be undefined).
+ * </p>
+ * 
+ * @returns The converted value
+ * 
+ * @param value     Value to convert
+ */
+long long VM_double_to_integer(double value) {
+	if (value != value) {
+		return 0;
+	} else if (value >= 9223372036854775807.0) {
+		return 9223372036854775807LL;
+	} else if (value <= -9223372036854775808.0) {
+		return -9223372036854775807LL - 1;
+	}
+
+	return (long long)value;
+}
+
+/**
+ * <p>
+ * Reports a runtime error at the source line of an instruction (see
+ * {@code VMFunction.lines}).
+ * </p>
+ * 
+ * <p>
+ * The error marks the line without its indentation, like the errors
+ * of the compilation mark a token. Without the index of the source
+ * (e.g. a program, that outlived its compilation) only the file is
+ * shown.
+ * </p>
+ * 
+ * @param code          Code of the runtime error
+ * @param *program      Program, that is executed
+ * @param *function     Function of the failed instruction
+ * @param *pc           Failed instruction
+ * @param *problem      Description of the problem
+ */
+void VM_report_runtime_error(enum DiagnosticCode code, struct VMProgram *program, struct VMFunction *function, struct VMInstruction *pc, const char *problem) {
+	size_t index = (size_t)(pc - function->code);
+	size_t line = index < function->codeLength ? function->lines[index] : 0;
+	int origin = index < function->codeLength ? function->origins[index] : -1;
+	size_t position = DIAGNOSTIC_NO_POSITION;
+	size_t length = 0;
+
+	if (LINE_INDEX != NULL && BUFFER != NULL && *BUFFER != NULL && index < function->codeLength && line < LINE_INDEX->count) {
+		struct SourceLocation location = LI_locate(LINE_INDEX, LI_get_line_start(LINE_INDEX, line));
+		size_t end = location.lineEnd;
+		position = location.lineStart;
+
+		while (position < end && ((*BUFFER)[position] == ' ' || (*BUFFER)[position] == '\t')) {
+			position++;
+		}
+
+		while (end > position && ((*BUFFER)[end - 1] == ' ' || (*BUFFER)[end - 1] == '\t' || (*BUFFER)[end - 1] == '\r')) {
+			end--;
+		}
+
+		length = end - position;
+	}
+
+	(void)REPORT_DIAGNOSTIC(code, SEVERITY_ERROR, line, position, length,
+		"VMRuntimeException: %s in function \"%s\"", problem, origin >= 0 ? program->functions[origin].name : function->name);
+	(void)REPORT_DIAGNOSTIC_DETAILS("The program was stopped.", NULL);
+}
+
+const char *VM_get_runtime_error_name(enum DiagnosticCode code) {
+	switch (code) {
+	case DIAG_VM_STACK_OVERFLOW:
+		return "Stack overflow";
+	case DIAG_VM_OUT_OF_MEMORY:
+		return "Out of memory";
+	case DIAG_VM_NULL_REFERENCE:
+		return "Null reference";
+	case DIAG_VM_INDEX_OUT_OF_BOUNDS:
+		return "Index out of bounds";
+	case DIAG_VM_NEGATIVE_ARRAY_LENGTH:
+		return "Negative array length";
+	default:
+		return "Division by zero";
+	}
+}
+
+/**
+ * <p>
+ * Writes the values of all globals.
+ * </p>
+ * 
+ * @param *output   Stream to write to
+ * @param *machine  Virtual machine, that ran the program
+ */
+void VM_dump_globals(FILE *output, struct VirtualMachine *machine) {
+	struct VMProgram *program = machine->program;
+
+	for (size_t i = 0; i < program->globalCount; i++) {
+		struct VMGlobal *global = &program->globals[i];
+		union VMValue *value = &machine->globals[i];
+		(void)fprintf(output, "%s:%s = ", global->name, IR_get_type_name(global->type));
+
+		switch (global->type) {
+		case DOUBLE:
+		case FLOAT:
+			(void)fprintf(output, "%g\n", value->floating);
+			break;
+		case BOOLEAN:
+			(void)fprintf(output, "%s\n", value->integer != 0 ? "true" : "false");
+			break;
+		case CHAR:
+			(void)fprintf(output, "'%c'\n", (char)value->integer);
+			break;
+		case STRING:
+			(void)fprintf(output, "\"");
+			(void)VM_write_string(output, *value);
+			(void)fprintf(output, "\"\n");
+			break;
+		case CLASS_REF:
+			//Objects are written with their class, arrays with their length
+			if (value->object == NULL) {
+				(void)fprintf(output, "null\n");
+			} else if (value->object->classId >= 0) {
+				(void)fprintf(output, "<%s>\n", program->classes[value->object->classId].name);
+			} else {
+				(void)fprintf(output, "[%u]\n", value->object->slotCount);
+			}
+
+			break;
+		default:
+			(void)fprintf(output, "%lld\n", value->integer);
+			break;
+		}
+	}
+}
+
+/**
+ * <p>
+ * Runs the entry function of a program in a new virtual machine.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the run
+ * 
+ * @param *program  Program to run
+ * @param *output   Receives the values of the globals after the run (NULL = no output)
+ */
+int RunProgram(struct VMProgram *program, FILE *output) {
+	struct VirtualMachine *machine = CreateNewVirtualMachine(program);
+
+	if (machine == NULL) {
+		(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "An error occured while trying to allocate memory.");
+		return PHASE_ABORTED;
+	}
+
+	int status = VM_run(machine, NULL);
+	(void)ST_count(COUNTER_VM_INSTRUCTIONS, machine->executedInstructions);
+
+	if (output != NULL && status == PHASE_SUCCESS) {
+		(void)VM_dump_globals(output, machine);
+	}
+
+	(void)FREE_VIRTUAL_MACHINE(machine);
+	return status;
+}
+
+/**
+ * <p>
+ * Runs the module once and orders its blocks by the counted executions
+ * ({@code --profile}).
+ * </p>
+ * 
+ * <p>
+ * The module is translated into a program, that counts the executions
+ * of every block (see VM_COUNT). After the run the counts become the
+ * frequencies of the blocks and the blocks are ordered again (see
+ * OPT_layout_blocks), so the taken paths fall through and the module
+ * is dumped again ({@code --dump-ir}). The globals of the run aren't
+ * written. A runtime error stops the compilation, the
+ * program would fail in the same way.
+ * </p>
+ * 
+ * @returns The PhaseStatus of the run
+ * 
+ * @param *module   Verified IR of the program
+ */
+int ProfileIR(struct IRModule *module) {
+	struct VMProgram *program = NULL;
+	int status = VM_generate_program(module, &program, true);
+
+	if (status != PHASE_SUCCESS) {
+		return status;
+	}
+
+	//The instructions of the run aren't counted (see RunProgram)
+	struct VirtualMachine *machine = CreateNewVirtualMachine(program);
+
+	if (machine == NULL) {
+		(void)FREE_VM_PROGRAM(program);
+		(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "An error occured while trying to allocate memory.");
+		return PHASE_ABORTED;
+	}
+
+	status = VM_run(machine, NULL);
+	(void)FREE_VIRTUAL_MACHINE(machine);
+
+	if (status == PHASE_SUCCESS) {
+		size_t moved = 0;
+
+		for (size_t i = 0; i < module->functionCount; i++) {
+			struct IRFunction *function = module->functions[i];
+
+			for (size_t n = 0; n < function->blockCount; n++) {
+				function->blocks[n].frequency = program->functions[i].blockCounts[n];
+			}
+
+			moved += OPT_layout_blocks(function);
+		}
+
+		(void)ST_count(COUNTER_MOVED_BLOCKS, moved);
+
+		if (IR_DUMP != NULL) {
+			(void)fprintf(IR_DUMP, "\n>>>>>>>>>>>>>>>>>>>>    PROFILED IR (%s)    <<<<<<<<<<<<<<<<<<<<\n\n", FILE_NAME);
+			(void)IR_dump_module(IR_DUMP, module);
+		}
+	}
+
+	(void)FREE_VM_PROGRAM(program);
+	return status;
+}
+
+void FREE_VIRTUAL_MACHINE(struct VirtualMachine *machine) {
+	if (machine == NULL) {
+		return;
+	}
+
+	(void)free(machine->globals);
+	(void)free(machine->stack);
+	(void)free(machine->frames);
+	(void)FREE_VM_HEAP(machine->heap);
+	(void)free(machine);
+}
@@ -23,6 +23,8 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
+#include <stdarg.h>
+#include <setjmp.h>
 #include "../headers/modules.h"
 #include "../headers/errors.h"
 #include "../headers/list.h"
@@ -73,6 +75,78 @@ void _init_error_token_size_cache_(int **arrayOfIndividualTokenSizes) {
 void _init_error_tree_cache_(struct Node **root) {
 	rootNode = (*root);
 }
+
+/*
+Purpose: Set the sink, that collects the diagnostics of all phases (NULL to disable collecting)
+Return Type: void
+Params: struct DiagnosticSink *sink => Sink for the diagnostics
+*/
+struct DiagnosticSink *diagnosticSink = NULL;
+
+void _init_error_diagnostic_sink_(struct DiagnosticSink *sink) {
+	diagnosticSink = sink;
+}
+
+/*
+Purpose: Set the point to which a fatal error returns (NULL to terminate the process instead)
+Return Type: void
+Params: jmp_buf *recoveryPoint => Point set with setjmp() by the running phase
+*/
+jmp_buf *errorRecoveryPoint = NULL;
+
+void _init_error_recovery_point_(jmp_buf *recoveryPoint) {
+	errorRecoveryPoint = recoveryPoint;
+}
+
+/*
+Purpose: Append a diagnostic of the current file (FILE_NAME) to the diagnostics sink
+Return Type: void
+Params: enum DiagnosticCode code => Code of the error; enum DiagnosticSeverity severity => Severity;
+		size_t line => Line of the error; size_t position => Offset in the buffer (or DIAGNOSTIC_NO_POSITION);
+		size_t length => Length of the erroneous symbol; const char *format, ... => Message
+*/
+void REPORT_DIAGNOSTIC(enum DiagnosticCode code, enum DiagnosticSeverity severity, size_t line, size_t position, size_t length, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+
+	if (diagnosticSink == NULL) {
+		(void)printf("%s: ", FILE_NAME != NULL ? FILE_NAME : "<unknown>");
+		(void)vprintf(format, args);
+		(void)printf("\n");
+	} else {
+		(void)DG_vreport(diagnosticSink, code, severity, FILE_NAME, line, position, length, format, args);
+	}
+
+	va_end(args);
+}
+
+/*
+Purpose: Attach an explanation and a suggestion to the last reported diagnostic
+Return Type: void
+Params: const char *explanation => Why the error occured (can be NULL);
+		const char *suggestion => How to fix the error (can be NULL)
+*/
+void REPORT_DIAGNOSTIC_DETAILS(const char *explanation, const char *suggestion) {
+	(void)DG_set_details(diagnosticSink, explanation, suggestion);
+}
+
+/*
+Purpose: Stop the current phase after a fatal error. If the phase set a recovery point, the phase
+		returns with a status code, else the memory is freed and the process terminates
+Return Type: void
+Params: void
+*/
+void ABORT_COMPILATION() {
+	if (errorRecoveryPoint != NULL) {
+		jmp_buf *target = errorRecoveryPoint;
+		errorRecoveryPoint = NULL;
+		(void)longjmp(*target, 1);
+	}
+
+	(void)FREE_MEMORY();
+	(void)exit(EXIT_FAILURE);
+}
+
 /*
 Purpose: Throw an IO exception
 Return Type: void
@@ -80,12 +154,9 @@ Params: char *source -> Which part of the compiler has Problems; char *file -> F
 		that are affected by the error (file name) 
 */
 void IO_FILE_EXCEPTION(char *Source, char *file) {
-	(void)printf("\nIOException at %s file: %s\n", file, Source);
-	(void)printf("File: NULL => Can't processes NULL!");
+	(void)REPORT_DIAGNOSTIC(DIAG_IO_FILE, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "IOException at %s file: %s", file, Source);
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -94,11 +165,9 @@ Return Type: void
 Params: char *Step -> Part of the compiler, which has a buffer overflow
 */
 void IO_BUFFER_EXCEPTION(char *Step) {
-	(void)printf("BufferException: Buffer out of bounds at %s.\n", Step);
+	(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "BufferException: Buffer out of bounds at %s.", Step);
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -107,11 +176,9 @@ Return Type: void
 Params: void
 */
 void IO_BUFFER_RESERVATION_EXCEPTION() {
-	(void)printf("An error occured while trying to allocate memory.\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_IO_BUFFER_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "An error occured while trying to allocate memory.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -120,11 +187,9 @@ Return Type: void
 Params: void
 */
 void IO_FILE_CLOSING_EXCEPTION() {
-	(void)printf("Unable to close the file.");
+	(void)REPORT_DIAGNOSTIC(DIAG_IO_FILE_CLOSING, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Unable to close the file.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -135,95 +200,10 @@ Params: char **input -> Source code; int pos -> position of error;
 		the error was found
 */
 void LEXER_UNEXPECTED_SYMBOL_EXCEPTION(char **input, int pos, int maxBackPos, int line) {
-	char *errormsg = "Unexpected symbol has been found in the input.";
-	(void)printf("\n%s\n", errormsg);
-	(void)printf("At line: %i : position: %i of the input\n", line + 1, pos);
+	(void)REPORT_DIAGNOSTIC(DIAG_LEXER_UNEXPECTED_SYMBOL, SEVERITY_ERROR, line, pos, 1, "Unexpected symbol '%c' has been found in the input.", (*input)[pos]);
+	(void)REPORT_DIAGNOSTIC_DETAILS("The symbol is not part of any token of the language.", "Remove the symbol or put it into a string.");
 
-	int back = 0, forward = 0, backSpace = 0, forSpace = 0;
-
-	for (int i = pos; (*input)[i] != '\0'; i--) {
-		if ((*input)[i] == ';' || (*input)[i] == '}') {
-			back--;
-			break;
-		}
-
-		if ((*input)[i] == ' ' && backSpace == 0) {
-			backSpace = back;
-		}
-
-		if (is_space((*input)[i]) && (*input)[i] != ' ') {
-			back--;
-			break;
-		}
-
-		if ((*input)[i] == ' ' && (*input)[i - 1] == ' ') {
-			back--;
-			break;
-		}
-
-		back++;
-	}
-
-	for (int i = pos; (*input)[i] != '\0'; i++) {
-		if ((*input)[i] == ';' || (*input)[i] == '}') {
-			forward++;
-			break;
-		}
-
-		if ((*input)[i] == ' ' && forSpace == 0) {
-			forSpace = forward;
-		}
-
-		if (is_space((*input)[i]) > 0 && (*input)[i] != ' ') {
-			break;
-		}
-
-		if ((*input)[i] == ' ' && (*input)[i + 1] == ' ') {
-			break;
-		}
-
-		forward++;
-	}
-
-	if (forward + back + 2 < strlen(errormsg)) {
-		for (int i = 0; i < strlen(errormsg); i++) {
-			(void)printf("-");
-		}
-	} else {
-		for (int i = 0; i < (forward + back + 2); i++) {
-			(void)printf("-");
-		}
-	}
-
-	(void)printf("\n %-3i|\t", (line + 1));
-
-	for (int i = back; i > 0; i--) {
-		(void)printf("%c", (*input)[pos - i]);
-	}
-
-	(void)printf("%c", (*input)[pos]);
-
-	for (int i = 0; i < forward; i++) {
-		(void)printf("%c", (*input)[pos + i]);
-	}
-
-	(void)printf("\n %3c|\t", ' ');
-
-	for (int i = 0; i < (back - backSpace); i++) {
-		(void)printf(" ");
-	}
-
-	for (int i = 0; i < (forSpace + backSpace + 1); i++) {
-		if (((pos + backSpace) - i) == pos) {
-			(void)printf("^");
-		} else {
-			(void)printf("=");
-		}
-	}
-
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -232,12 +212,9 @@ Return Type: void
 Params: void
 */
 void LEXER_NULL_TOKEN_EXCEPTION() {
-	(void)printf("An fatal error occured while trying to assign the file content into tokens.\n");
-	(void)printf("More data than tokens are available.\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_LEXER_NULL_TOKEN, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "More data than tokens are available.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -246,11 +223,9 @@ Returny Type: void
 Params: void
 */
 void LEXER_UNFINISHED_POINTER_EXCEPTION() {
-	(void)printf("Unfinished or invalid pointer declaration");
+	(void)REPORT_DIAGNOSTIC(DIAG_LEXER_UNFINISHED_POINTER, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Unfinished or invalid pointer declaration.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -259,11 +234,9 @@ Returny Type: void
 Params: void
 */
 void LEXER_NULL_TOKEN_VALUE_EXCEPTION() {
-	(void)printf("Token with value NULL detected => Cannot process NULL.\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_LEXER_NULL_TOKEN_VALUE, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Token with value NULL detected.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -272,11 +245,9 @@ Returny Type: void
 Params: void
 */
 void LEXER_TOKEN_ERROR_EXCEPTION() {
-	(void)printf("NULL token found => Cannot process NULL Token.");
+	(void)REPORT_DIAGNOSTIC(DIAG_LEXER_TOKEN_ERROR, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "NULL token found.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -285,12 +256,9 @@ Return Type: void
 Params: void
 */
 void PARSER_TOKEN_TRANSMISSION_EXCEPTION() {
-	(void)printf("An fatal error occured while transmitting the tokens to the parsing section.\n");
-	(void)printf("Tokens = NULL, NULL can't be processed.");
+	(void)REPORT_DIAGNOSTIC(DIAG_PARSER_TOKEN_TRANSMISSION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Tokens couldn't be transmitted to the parsing section.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -299,12 +267,9 @@ Return Type: void
 Params: void
 */
 void PARSER_RULE_RESERVATION_EXCEPTION() {
-	(void)printf("An error occured while reservating memory for the Grammar rule.\n");
-	(void)printf("*Pointer NULL, NULL can't be processed.");
+	(void)REPORT_DIAGNOSTIC(DIAG_PARSER_RULE_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Memory for the grammar rule couldn't be reserved.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -313,11 +278,9 @@ Return Type: void
 Params: void
 */
 void PARSER_RULE_FILE_CORRUPTION_EXCEPTION() {
-	(void)printf("The parser rule file is corrupted and can't be processed anymore.\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_PARSER_RULE_FILE_CORRUPTION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "The parser rule file is corrupted.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -326,12 +289,9 @@ Return Type: void
 Params: void
 */
 void PARSER_RULE_TRANSMISSION_EXCEPTION() {
-	(void)printf("An fatal error occured while transmitting the rules to the parsing section.\n");
-	(void)printf("GrammarRules = NULL, NULL can't be processed.");
+	(void)REPORT_DIAGNOSTIC(DIAG_PARSER_RULE_TRANSMISSION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Rules couldn't be transmitted to the parsing section.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -340,11 +300,9 @@ Return Type: void
 Params: void
 */
 void LIST_OVERFLOW_EXCEPTION() {
-	(void)printf("Too much data was pushed into the list, can't process more than LIST_SIZE\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_LIST_OVERFLOW, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Too much data was pushed into the list.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -353,11 +311,9 @@ Return Type: void
 Params: void
 */
 void LIST_UNDERFLOW_EXCEPTION() {
-	(void)printf("Can't access to data at position NULL in the list.\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_LIST_UNDERFLOW, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Can't access data at position NULL in the list.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -368,57 +324,10 @@ Params: char **input => Source code;
 		size_t lineNumber => Line number of the string start;
 */
 void LEXER_UNFINISHED_STRING_EXCEPTION(char **input, size_t errorPos, size_t lineNumber) {
-	(void)printf("Unfinished string at end of file. (%s)\n", FILE_NAME);
-	(void)printf("-----------------------------------------------------\n");
-
-	char buffer[32];
-	int charPosition = 0;
-	int printPosition = errorPos;
-
-	for (int i = errorPos; i > 0; i--) {
-		if ((*input)[i] == '\n' || (i - 1) <= 0) {
-			printPosition = i - 1;
-			charPosition++;
-			break;
-		}
-
-		charPosition++;
-	}
-
-	int msgLength = (int)snprintf(buffer, 32, "%li : %i | ", (lineNumber + 1), charPosition);
-	(void)printf("%s", buffer);
-
-	for (int i = printPosition; (*input)[i] != '\0'; i++) {
-		(void)printf("%c", (*input)[i]);
-
-		if ((*input)[i + 1] == '\n' || (*input)[i + 1] == '\0') {
-			(void)printf("\n");
-			break;
-		}
-	}
-
-	for (int i = 0; i < msgLength; i++) {
-		(void)printf(" ");
-	}
-
-	for (int i = printPosition; (*input)[i] != '\0'; i++) {
-		if (i >= errorPos) {
-			(void)printf("^");
-		} else {
-			(void)printf("~");
-		}
-
-		if ((*input)[i + 1] == '\n' || (*input)[i + 1] == '\0') {
-			(void)printf("\n");
-			break;
-		}
-	}
-
-	(void)printf("-----------------------------------------------------\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_LEXER_UNFINISHED_STRING, SEVERITY_ERROR, lineNumber, errorPos, 1, "Unfinished string at end of file.");
+	(void)REPORT_DIAGNOSTIC_DETAILS("The string starts here, but is never closed.", "Close the string with a '\"'.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -428,12 +337,9 @@ Params: char *value => Problem token;
 		char *awaited => Expected token
 */
 void SYNTAX_MISMATCH_EXCEPTION(char *value, char *awaited) {
-	(void)printf("Terminated compile process due to rule mismatch!\n");
-	(void)printf("Problem: \"%s\", awaited \"%s\"\n", value, awaited);
+	(void)REPORT_DIAGNOSTIC(DIAG_SYNTAX_MISMATCH, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Problem: \"%s\", awaited \"%s\"", value, awaited);
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*
@@ -442,19 +348,26 @@ Return Type: void
 Params: void
 */
 void SYNTAX_ANALYSIS_TOKEN_NULL_EXCEPTION() {
-	(void)printf("Terminated compile process due to token NULL, NULL can't be processed!\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_SYNTAX_TOKEN_NULL, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Token NULL, NULL can't be processed.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
+}
+
+/*
+Purpose: Throw an error, if the parsetree generator reaches a node it can't process
+Return Type: void
+Params: char *problem => Description of the invalid node
+*/
+void PARSE_TREE_INVALID_NODE_EXCEPTION(char *problem) {
+	(void)REPORT_DIAGNOSTIC(DIAG_PARSETREE_INVALID_NODE, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Invalid parsetree node: %s", problem);
+
+	(void)ABORT_COMPILATION();
 }
 
 void PARSE_TREE_NODE_RESERVATION_EXCEPTION() {
-	(void)printf("Terminated parsetree generation due to memory reservation exception!\n");
+	(void)REPORT_DIAGNOSTIC(DIAG_PARSETREE_NODE_RESERVATION, SEVERITY_ERROR, 0, DIAGNOSTIC_NO_POSITION, 0, "Memory for a parsetree node couldn't be reserved.");
 
-	if ((int)FREE_MEMORY() == true) {
-		(void)exit(EXIT_SUCCESS);
-	}
+	(void)ABORT_COMPILATION();
 }
 
 /*